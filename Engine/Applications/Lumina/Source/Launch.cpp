@@ -8,6 +8,7 @@
 #include <exception>
 #include "Config/Config.h"
 #include "Core/CommandLine/CommandLine.h"
+#include "FileSystem/PakFile.h"
 
 using namespace Lumina;
 
@@ -22,6 +23,15 @@ int GuardedMain(int ArgC, char** ArgV)  // NOLINT(misc-use-internal-linkage)
         FCommandLine Parsed{ArgC, ArgV};
         GCommandLine = &Parsed;
         
+        // "pak <SourceDirectory> <Archive.lpak> [--nocompress]" cooks a directory into an archive and exits.
+        const TVector<FFixedString>& Positional = Parsed.GetPositionalArgs();
+        if (Positional.size() == 3 && Positional[0] == "pak")
+        {
+            const bool bPacked = VFS::Pak::WriteArchive(Positional[1], Positional[2], !Parsed.Has("nocompress"));
+            GCommandLine = nullptr;
+            return bPacked ? 0 : 1;
+        }
+        
         FApplication Application{};
         GApp = &Application;
         
@@ -471,6 +471,13 @@ namespace Lumina::Reflection
 
 			Stream += "\t);\n";
 
+			for (const FMetadataPair& Data : Type->Metadata)
+			{
+				if (bIsStructure && Data.Key == "Component")
+				{
+					Stream += "\t::Lumina::Meta::RegisterComponentAccessorsLua<" + Type->Namespace + "::" + Type->DisplayName + ">(State);\n";
+				}
+			}
 		}
 
 		Stream += "}\n";
@@ -1077,6 +1077,20 @@ namespace Lumina
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "|");
             ImGui::SameLine();
             ImGui::Text("Memory Usage: %s", ImGuiX::FormatSize(MemoryUsage).c_str());
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "|");
+            ImGui::SameLine();
+            ImGui::Text("GC Step: %.3f ms", Context.GetLastGCStepTime() * 1000.0);
+            
+            if (ImGui::CollapsingHeader("Memory By Script"))
+            {
+                for (const Scripting::FScriptMemoryStats& Stats : Context.GetMemoryStats())
+                {
+                    const ImVec4 Color = Stats.bOverSoftLimit ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
+                    ImGui::TextColored(Color, "%s: %s (Peak %s)", Stats.Path.IsNone() ? "Engine" : Stats.Path.c_str(),
+                        ImGuiX::FormatSize(Stats.Bytes).c_str(), ImGuiX::FormatSize(Stats.PeakBytes).c_str());
+                }
+            }
             
             ImGui::Separator();
             
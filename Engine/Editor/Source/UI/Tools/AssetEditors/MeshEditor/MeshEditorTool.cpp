@@ -64,10 +64,16 @@ namespace Lumina
     
                 // Geometry counts
                 PropertyRow("Vertices", eastl::to_string(Resource.GetNumVertices()));
-                PropertyRow("Triangles", eastl::to_string(Resource.Indices.size() / 3));
+                PropertyRow("Triangles", eastl::to_string(Resource.GetLODNumIndices(0) / 3));
                 PropertyRow("Indices", eastl::to_string(Resource.Indices.size()));
                 PropertyRow("Shadow Indices", eastl::to_string(Resource.ShadowIndices.size()));
                 PropertyRow("Surfaces", eastl::to_string(Resource.GetNumSurfaces()));
+                PropertyRow("Meshlets", eastl::to_string(Resource.Meshlets.size()));
+                
+                for (uint32 LOD = 1; LOD < Resource.GetNumLODs(); ++LOD)
+                {
+                    PropertyRow(("LOD" + eastl::to_string(LOD) + " Triangles").c_str(), eastl::to_string(Resource.GetLODNumIndices(LOD) / 3));
+                }
                 
                 ImGui::TableNextRow();
                 ImGui::TableSetColumnIndex(0);
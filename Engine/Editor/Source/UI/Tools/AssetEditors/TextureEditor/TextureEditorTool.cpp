@@ -1,6 +1,7 @@
 ﻿#include "TextureEditorTool.h"
 
 #include "Assets/AssetTypes/Textures/Texture.h"
+#include "Assets/AssetTypes/Textures/TextureStreaming.h"
 #include "Core/Object/Cast.h"
 #include "Core/Object/Package/Package.h"
 #include "Core/Object/Package/Thumbnail/PackageThumbnail.h"
@@ -25,7 +26,15 @@ namespace Lumina
                 return;
             }
 
-            ImTextureID TextureID = GRenderManager->GetImGuiRenderer()->GetOrCreateImTexture(Texture->TextureResource->RHIImage, FTextureSubresourceSet(CurrentMipLevel, 1, 0, 1));
+            // Streamed textures get every mip while previewed, mips that are not in yet show the finest resident one.
+            if (Texture->IsStreamed())
+            {
+                FTextureStreamingManager::Get().RequestMip(Texture->GetStreamingHandle(), 0);
+            }
+
+            const int32 ResidentMip = Texture->GetResidentMip();
+            const uint32 PreviewMip = (uint32)(glm::max(CurrentMipLevel, ResidentMip) - ResidentMip);
+            ImTextureID TextureID = GRenderManager->GetImGuiRenderer()->GetOrCreateImTexture(Texture->TextureResource->RHIImage, FTextureSubresourceSet(PreviewMip, 1, 0, 1));
 
             const FRHIImageDesc& ImageDesc = Texture->TextureResource->ImageDescription;
             ImVec2 WindowSize = ImGui::GetContentRegionAvail();
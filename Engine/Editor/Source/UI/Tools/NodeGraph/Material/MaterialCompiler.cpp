@@ -756,6 +756,28 @@ namespace Lumina
         RegisterNodeOutput(OwningNode, AValue.Type, EComponentMask::RGBA);
     }
 
+    void FMaterialCompiler::DeriveNormalZ(CMaterialInput* A)
+    {
+        FString OwningNode = A->GetOwningNode()->GetNodeFullName();
+
+        FInputValue AValue = GetTypedInputValue(A, "vec2(0.5, 0.5)");
+        if (AValue.ComponentCount < 2)
+        {
+            FError Error;
+            Error.ErrorName = "Invalid Type";
+            Error.ErrorDescription = "Derive Normal Z requires at least a vec2 input";
+            Error.ErrorNode = A->GetOwningNode<CMaterialGraphNode>();
+            AddError(Error);
+
+            AValue.Value = "vec2(0.5, 0.5)";
+        }
+
+        // The input is packed to [0, 1] like the texture it came from, Z is rebuilt on the unit sphere and packed back.
+        ShaderChunks.append("vec2 " + OwningNode + "_XY = (" + AValue.Value + ").xy * 2.0 - 1.0;\n");
+        ShaderChunks.append("vec3 " + OwningNode + " = vec3(" + OwningNode + "_XY, sqrt(clamp(1.0 - dot(" + OwningNode + "_XY, " + OwningNode + "_XY), 0.0, 1.0))) * 0.5 + 0.5;\n");
+        RegisterNodeOutput(OwningNode, EMaterialValueType::Float3, EComponentMask::RGB);
+    }
+
     void FMaterialCompiler::Distance(CMaterialInput* A, CMaterialInput* B)
     {
         FString OwningNode = A->GetOwningNode()->GetNodeFullName();
@@ -118,6 +118,7 @@ namespace Lumina
         // Vector operations
         void Saturate(CMaterialInput* A, CMaterialInput* B);
         void Normalize(CMaterialInput* A, CMaterialInput* B);
+        void DeriveNormalZ(CMaterialInput* A);
         void Distance(CMaterialInput* A, CMaterialInput* B);
         void Abs(CMaterialInput* A, CMaterialInput* B);
 
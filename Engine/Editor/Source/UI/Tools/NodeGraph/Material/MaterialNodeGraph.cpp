@@ -96,6 +96,7 @@ namespace Lumina
         RegisterGraphNode(CMaterialExpression_SmoothStep::StaticClass());
         RegisterGraphNode(CMaterialExpression_Saturate::StaticClass());
         RegisterGraphNode(CMaterialExpression_Normalize::StaticClass());
+        RegisterGraphNode(CMaterialExpression_DeriveNormalZ::StaticClass());
         RegisterGraphNode(CMaterialExpression_Distance::StaticClass());
         RegisterGraphNode(CMaterialExpression_Abs::StaticClass());
 
@@ -692,6 +692,20 @@ namespace Lumina
         Compiler.Normalize(A, B);
     }
 
+    void CMaterialExpression_DeriveNormalZ::BuildNode()
+    {
+        Super::BuildNode();
+
+        A = Cast<CMaterialInput>(CreatePin(CMaterialInput::StaticClass(), "XY", ENodePinDirection::Input, EMaterialInputType::Float2));
+        A->SetPinName("XY");
+        A->SetIndex(0);
+    }
+
+    void CMaterialExpression_DeriveNormalZ::GenerateDefinition(FMaterialCompiler& Compiler)
+    {
+        Compiler.DeriveNormalZ(A);
+    }
+
     void CMaterialExpression_Distance::BuildNode()
     {
         Super::BuildNode();
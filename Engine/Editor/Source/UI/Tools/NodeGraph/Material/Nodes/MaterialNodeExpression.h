@@ -113,6 +113,24 @@ namespace Lumina
         
     };
 
+    /** Rebuilds blue for two channel (BC5) normal maps, the output stays packed like an RGB normal map. */
+    REFLECT()
+    class CMaterialExpression_DeriveNormalZ : public CMaterialExpression_Math
+    {
+        GENERATED_BODY()
+        
+    public:
+        
+        
+        void BuildNode() override;
+
+        FString GetNodeDisplayName() const override { return "Derive Normal Z"; }
+        void* GetNodeDefaultValue() override { return nullptr; }
+        uint32 GenerateExpression(FMaterialCompiler& Compiler) override { return 0; }
+        void GenerateDefinition(FMaterialCompiler& Compiler) override;
+        
+    };
+
     REFLECT()
     class CMaterialExpression_Distance : public CMaterialExpression_Math
     {
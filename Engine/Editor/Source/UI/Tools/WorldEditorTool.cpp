@@ -1,7 +1,9 @@
 ﻿#include "WorldEditorTool.h"
+#include <chrono>
 #include <glm/gtx/string_cast.hpp>
 #include "EditorToolContext.h"
 #include "Assets/AssetRegistry/AssetRegistry.h"
+#include "Assets/AssetTypes/Textures/TextureStreaming.h"
 #include "Components/EditorEntityTags.h"
 #include "Config/Config.h"
 #include "Core/Console/ConsoleVariable.h"
@@ -334,11 +336,24 @@ namespace Lumina
             ImGuiX::Text("Vertices:  {:L}", Stats.NumVertices);
             ImGuiX::Text("Triangles: {:L}", Stats.NumTriangles);
             ImGuiX::Text("Instances: {:L}", Stats.NumInstances);
+            ImGuiX::Text("Reduced LOD: {:L}", Stats.NumReducedLODs);
         
             ImGui::SeparatorText("Draw Calls");
             ImGuiX::Text("Batches:   {:L}", Stats.NumBatches);
             ImGuiX::Text("Draws:     {:L}", Stats.NumDraws);
             ImGuiX::Text("Materials: {:L}", Stats.NumMaterials);
+
+            ImGui::SeparatorText("Culling");
+            ImGuiX::Text("Occluders: {:L}", Stats.NumOccluders);
+            ImGuiX::Text("Occluded:  {:L}", Stats.NumOcclusionCulled);
+            ImGuiX::Text("Meshlets:  {:L} / {:L}", Stats.NumMeshletsCulled, Stats.NumMeshlets);
+
+            const FTextureStreamingStats StreamingStats = FTextureStreamingManager::Get().GetStats();
+            ImGui::SeparatorText("Texture Streaming");
+            ImGuiX::Text("Textures:  {:L}", StreamingStats.NumTextures);
+            ImGuiX::Text("Resident:  {:.1f} / {:.1f} MB", StreamingStats.ResidentBytes / (1024.0 * 1024.0), StreamingStats.PoolSizeBytes / (1024.0 * 1024.0));
+            ImGuiX::Text("Wanted:    {:.1f} MB", StreamingStats.WantedBytes / (1024.0 * 1024.0));
+            ImGuiX::Text("In Flight: {:L}", StreamingStats.NumInFlight);
             
             ImGui::EndMenu();
         }
@@ -1832,6 +1847,8 @@ namespace Lumina
         {
             bGamePreviewRunning = true;
             
+            const auto Start = std::chrono::high_resolution_clock::now();
+            
             World->SetActive(false);
             ProxyWorld = World;
             
@@ -1839,6 +1856,10 @@ namespace Lumina
             World->InitializeWorld(EWorldType::Game);
             World->SimulateWorld();
             
+            // Duplication alone is logged by DuplicateWorld, this covers everything until the first PIE frame can run.
+            const std::chrono::duration<double, std::milli> Latency = std::chrono::high_resolution_clock::now() - Start;
+            LOG_INFO("Play in editor started in {:.3f} ms", Latency.count());
+            
             OutlinerListView.ClearTree();
             OutlinerListView.MarkTreeDirty();
             
@@ -51,6 +51,8 @@ const uint LIGHT_FLAG_CASTSHADOW       = BIT(3);
 #define INSTANCE_FLAG_SELECTED          BIT(2)
 #define INSTANCE_FLAG_CAST_SHADOW       BIT(3)
 #define INSTANCE_FLAG_RECEIVE_SHADOW    BIT(4)
+#define INSTANCE_FLAG_OCCLUDED          BIT(5)
+#define INSTANCE_FLAG_SHADOW_ONLY       BIT(6)
 
 //////////////////////////////////////////////////////////
 
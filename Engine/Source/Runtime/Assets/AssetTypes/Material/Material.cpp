@@ -2,6 +2,7 @@
 #include "Material.h"
 
 #include "Assets/AssetTypes/Textures/Texture.h"
+#include "Assets/AssetTypes/Textures/TextureStreaming.h"
 #include "Core/Engine/Engine.h"
 #include "Core/Templates/AsBytes.h"
 #include "Paths/Paths.h"
@@ -82,6 +83,7 @@ namespace Lumina
             TBitFlags<ERHIShaderType> Visibility;
             Visibility.SetMultipleFlags(ERHIShaderType::Vertex, ERHIShaderType::Fragment);
             GRenderContext->CreateBindingSetAndLayout(Visibility, 0, SetDesc, BindingLayout, BindingSet);
+            UpdateTextureImages(BoundImages);
             
             CommandList->Close();
             GRenderContext->ExecuteCommandList(CommandList);
@@ -165,6 +167,19 @@ namespace Lumina
 
     FRHIBindingSet* CMaterial::GetBindingSet() const
     {
+        if (BindingSet && UpdateTextureImages(BoundImages))
+        {
+            FBindingSetDesc SetDesc;
+            SetDesc.AddItem(FBindingSetItem::BufferCBV(0, UniformBuffer));
+
+            for (size_t i = 0; i < BoundImages.size(); ++i)
+            {
+                SetDesc.AddItem(FBindingSetItem::TextureSRV((uint32)i + 1, BoundImages[i]));
+            }
+
+            BindingSet = GRenderContext->CreateBindingSet(SetDesc, BindingLayout);
+        }
+        
         return BindingSet;
     }
 
@@ -193,6 +208,33 @@ namespace Lumina
         return DefaultMaterial;
     }
 
+    void CMaterial::RequestTextureScreenSize(float ScreenPixels) const
+    {
+        FTextureStreamingManager& StreamingManager = FTextureStreamingManager::Get();
+        for (CTexture* Texture : Textures)
+        {
+            if (IsValid(Texture) && Texture->IsStreamed())
+            {
+                StreamingManager.RequestScreenSize(Texture->GetStreamingHandle(), ScreenPixels);
+            }
+        }
+    }
+
+    bool CMaterial::UpdateTextureImages(TVector<FRHIImage*>& InOutImages) const
+    {
+        bool bChanged = InOutImages.size() != Textures.size();
+        InOutImages.resize(Textures.size());
+
+        for (size_t i = 0; i < Textures.size(); ++i)
+        {
+            FRHIImage* Image = Textures[i]->GetRHIRef();
+            bChanged |= InOutImages[i] != Image;
+            InOutImages[i] = Image;
+        }
+
+        return bChanged;
+    }
+
     void CMaterial::CreateDefaultMaterial()
     {
         IShaderCompiler* ShaderCompiler = GRenderContext->GetShaderCompiler();
@@ -39,8 +39,12 @@ namespace Lumina
         FRHIBindingLayout* GetBindingLayout() const override;
         FRHIVertexShader* GetVertexShader(EVertexFormat Format) const override;
         FRHIPixelShader* GetPixelShader() const override;
+        void RequestTextureScreenSize(float ScreenPixels) const override;
         static CMaterial* GetDefaultMaterial();
 
+        /** Refreshes InOutImages with the current image of every texture, returns true when any of them changed. */
+        bool UpdateTextureImages(TVector<FRHIImage*>& InOutImages) const;
+
         static void CreateDefaultMaterial();
 
         EMaterialType GetMaterialType() const override { return MaterialType; }
@@ -76,7 +80,10 @@ namespace Lumina
         FRHIPixelShaderRef                      PixelShader;
         FRHIBufferRef                           UniformBuffer;
         FRHIBindingLayoutRef                    BindingLayout;
-        FRHIBindingSetRef                       BindingSet;
+
+        /** Rebuilt when a streamed texture swaps its image. */
+        mutable FRHIBindingSetRef               BindingSet;
+        mutable TVector<FRHIImage*>             BoundImages;
 
         static CMaterial* DefaultMaterial;
     };
@@ -93,6 +93,19 @@ namespace Lumina
 
     FRHIBindingSet* CMaterialInstance::GetBindingSet() const
     {
+        if (BindingSet && Material->UpdateTextureImages(BoundImages))
+        {
+            FBindingSetDesc SetDesc;
+            SetDesc.AddItem(FBindingSetItem::BufferCBV(0, UniformBuffer));
+
+            for (size_t i = 0; i < BoundImages.size(); ++i)
+            {
+                SetDesc.AddItem(FBindingSetItem::TextureSRV((uint32)i + 1, BoundImages[i]));
+            }
+
+            BindingSet = GRenderContext->CreateBindingSet(SetDesc, Material->BindingLayout);
+        }
+        
         return BindingSet;
     }
 
@@ -111,6 +124,14 @@ namespace Lumina
         return Material->GetPixelShader();
     }
 
+    void CMaterialInstance::RequestTextureScreenSize(float ScreenPixels) const
+    {
+        if (Material)
+        {
+            Material->RequestTextureScreenSize(ScreenPixels);
+        }
+    }
+
     void CMaterialInstance::PostLoad()
     {
         if (Material)
@@ -134,7 +155,7 @@ namespace Lumina
             {
                 FRHIImageRef Image = Material->Textures[i]->GetRHIRef();
                 
-                SetDesc.AddItem(FBindingSetItem::TextureSRV((uint32)i, Image));
+                SetDesc.AddItem(FBindingSetItem::TextureSRV((uint32)i + 1, Image));
             }
 
             FRHICommandListRef CommandList = GRenderContext->CreateCommandList(FCommandListInfo::Graphics());
@@ -149,6 +170,7 @@ namespace Lumina
             GRenderContext->ExecuteCommandList(CommandList);
             
             BindingSet = GRenderContext->CreateBindingSet(SetDesc, Material->BindingLayout);
+            Material->UpdateTextureImages(BoundImages);
 
         }
     }
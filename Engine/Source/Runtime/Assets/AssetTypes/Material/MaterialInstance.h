@@ -29,6 +29,7 @@ namespace Lumina
         FRHIBindingLayout* GetBindingLayout() const override;
         FRHIVertexShader* GetVertexShader(EVertexFormat Format) const override;
         FRHIPixelShader* GetPixelShader() const override;
+        void RequestTextureScreenSize(float ScreenPixels) const override;
 
         void PostLoad() override;
 
@@ -39,6 +40,7 @@ namespace Lumina
         TVector<FMaterialParameter>             Parameters;
         FMaterialUniforms                       MaterialUniforms;
         FRHIBufferRef                           UniformBuffer;
-        FRHIBindingSetRef                       BindingSet;
+        mutable FRHIBindingSetRef               BindingSet;
+        mutable TVector<FRHIImage*>             BoundImages;
     };
 }
@@ -40,6 +40,9 @@ namespace Lumina
         virtual FRHIVertexShader* GetVertexShader(EVertexFormat Format) const { return nullptr; }
         virtual FRHIPixelShader* GetPixelShader() const { return nullptr; }
 
+        /** Reports that a primitive drawn with this material covers ScreenPixels across, so its streamed textures keep enough mips. */
+        virtual void RequestTextureScreenSize(float ScreenPixels) const { }
+
         virtual EMaterialType GetMaterialType() const { return EMaterialType::None; };
 
         virtual bool DoesCastShadows() const { return false; }
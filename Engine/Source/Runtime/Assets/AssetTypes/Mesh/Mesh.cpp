@@ -3,6 +3,8 @@
 #include "Assets/AssetTypes/Material/Material.h"
 #include "assets/assettypes/material/materialinstance.h"
 #include "Core/Object/Cast.h"
+#include "Core/Math/Hash/Hash.h"
+#include "Physics/Physics.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RHIGlobals.h"
 #include "Renderer/Vertex.h"
@@ -26,6 +28,7 @@ namespace Lumina
     {
         GenerateBoundingBox();
         GenerateGPUBuffers();
+        UpdateCollisionHash();
     }
 
     CMaterialInterface* CMesh::GetMaterialAtSlot(size_t Slot) const
@@ -55,6 +58,7 @@ namespace Lumina
         MeshResources = eastl::move(NewResource);
         GenerateBoundingBox();
         GenerateGPUBuffers();
+        UpdateCollisionHash();
     }
 
     bool CMesh::IsReadyForRender() const
@@ -96,6 +100,38 @@ namespace Lumina
         }
     }
 
+    void CMesh::CookCollision()
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        // Skinned meshes deform away from their bind pose, a static collider would not follow them.
+        if (MeshResources->bSkinnedMesh)
+        {
+            return;
+        }
+        
+        Physics::IPhysicsContext* PhysicsContext = Physics::GetPhysicsContext();
+        PhysicsContext->CookMeshCollision(*MeshResources, Physics::ECollisionMeshType::TriangleMesh, MeshResources->CookedTriangleMesh);
+        PhysicsContext->CookMeshCollision(*MeshResources, Physics::ECollisionMeshType::ConvexHull, MeshResources->CookedConvexHull);
+        UpdateCollisionHash();
+    }
+
+    void CMesh::UpdateCollisionHash()
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        size_t Seed = 0;
+        eastl::visit([&](const auto& Vertices)
+        {
+            Hash::HashCombine(Seed, Hash::XXHash::GetHash64(Vertices.data(), Vertices.size() * sizeof(Vertices[0])));
+        }, MeshResources->Vertices);
+        
+        Hash::HashCombine(Seed, Hash::XXHash::GetHash64(MeshResources->Indices.data(), MeshResources->Indices.size() * sizeof(uint32)));
+        Hash::HashCombine(Seed, Hash::XXHash::GetHash64(MeshResources->CookedTriangleMesh.data(), MeshResources->CookedTriangleMesh.size()));
+        Hash::HashCombine(Seed, Hash::XXHash::GetHash64(MeshResources->CookedConvexHull.data(), MeshResources->CookedConvexHull.size()));
+        CollisionHash = Seed;
+    }
+
     void CMesh::GenerateGPUBuffers()
     {
         FRHICommandListRef CommandList = GRenderContext->CreateCommandList(FCommandListInfo::Graphics());
@@ -32,6 +32,9 @@ namespace Lumina
 
         void GenerateBoundingBox();
         void GenerateGPUBuffers();
+        
+        /** Cooks the triangle mesh and convex hull colliders into the resource so loading restores them instead of building. */
+        void CookCollision();
 
         uint32 GetNumMaterials() const { return (uint32)Materials.size(); }
         CMaterialInterface* GetMaterialAtSlot(size_t Slot) const;
@@ -42,6 +45,9 @@ namespace Lumina
 
         void SetMeshResource(TUniquePtr<FMeshResource>&& NewResource);
         
+        /** Hash of the geometry and cooked collision, changes whenever a reimport or recook gives the mesh different collision. */
+        FORCEINLINE uint64 GetCollisionHash() const { return CollisionHash; }
+        
         FORCEINLINE const FMeshResource::FMeshBuffers& GetMeshBuffers() const { return MeshResources->MeshBuffers; }
         FORCEINLINE const FRHIBufferRef& GetVertexBuffer() const { return MeshResources->MeshBuffers.VertexBuffer; }
         FORCEINLINE const FRHIBufferRef& GetIndexBuffer() const { return MeshResources->MeshBuffers.IndexBuffer; }
@@ -72,7 +78,10 @@ namespace Lumina
         
     private:
         
+        void UpdateCollisionHash();
+        
         TUniquePtr<FMeshResource> MeshResources;
+        uint64 CollisionHash = 0;
     };
 
 
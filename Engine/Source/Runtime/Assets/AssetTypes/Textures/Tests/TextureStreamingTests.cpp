@@ -0,0 +1,283 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Assets/AssetTypes/Textures/TextureStreaming.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Records what the manager asks for, loads only finish when the test says so. */
+        class FFakeStreamingBackend : public ITextureStreamingBackend
+        {
+        public:
+
+            struct FCall
+            {
+                uint32  Handle;
+                uint8   Mip;
+            };
+
+            void RequestMips(uint32 Handle, CTexture*, uint8 FirstMip) override
+            {
+                Requests.push_back({ Handle, FirstMip });
+            }
+
+            void EvictMips(uint32 Handle, CTexture*, uint8 FirstMip) override
+            {
+                Evictions.push_back({ Handle, FirstMip });
+            }
+
+            void PollCompleted(TVector<FTextureStreamingCompletion>& OutCompleted) override
+            {
+                OutCompleted.insert(OutCompleted.end(), Completed.begin(), Completed.end());
+                Completed.clear();
+            }
+
+            void Flush() override { }
+
+            /** A failed load reports the mip that was resident before it. */
+            void Finish(uint32 Handle, uint8 ResidentMip)
+            {
+                Completed.push_back(FTextureStreamingCompletion{ Handle, ResidentMip });
+            }
+
+            TVector<FCall>                          Requests;
+            TVector<FCall>                          Evictions;
+            TVector<FTextureStreamingCompletion>    Completed;
+        };
+
+        /** A square RGBA8 texture of Size texels, mips from MinResidentMip down always resident. */
+        FStreamingTextureDesc MakeDesc(uint32 Size, uint8 MinResidentMip, uint8 ResidentMip)
+        {
+            FStreamingTextureDesc Desc;
+            Desc.Width = Size;
+            Desc.Height = Size;
+            Desc.MinResidentMip = MinResidentMip;
+            Desc.ResidentMip = ResidentMip;
+            for (uint32 MipSize = Size; ; MipSize >>= 1)
+            {
+                Desc.MipSizes.push_back((uint64)MipSize * MipSize * 4);
+                if (MipSize == 1)
+                {
+                    break;
+                }
+            }
+            return Desc;
+        }
+
+        /** Bytes of mip FirstMip and every coarser one. */
+        uint64 BytesFromMip(const FStreamingTextureDesc& Desc, uint8 FirstMip)
+        {
+            uint64 Bytes = 0;
+            for (size_t Mip = FirstMip; Mip < Desc.MipSizes.size(); ++Mip)
+            {
+                Bytes += Desc.MipSizes[Mip];
+            }
+            return Bytes;
+        }
+
+        FTextureStreamingSettings MakeSettings(uint64 PoolSizeBytes, uint32 MaxInFlight = 8)
+        {
+            FTextureStreamingSettings Settings;
+            Settings.PoolSizeBytes = PoolSizeBytes;
+            Settings.MaxInFlight = MaxInFlight;
+            return Settings;
+        }
+
+        constexpr uint32 TextureSize = 256;
+        constexpr uint8 TailMip = 4;
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.TextureStreaming.RequestsScreenSizedMips")
+    {
+        FFakeStreamingBackend Backend;
+        FTextureStreamingManager Manager(&Backend);
+        const FStreamingTextureDesc Desc = MakeDesc(TextureSize, TailMip, TailMip);
+        const FTextureStreamingSettings Settings = MakeSettings(1ull << 30);
+
+        const uint32 Handle = Manager.RegisterTexture(nullptr, Desc);
+        TEST_CHECK(Manager.GetResidentMip(Handle) == TailMip);
+
+        // A quarter of the texture's size on screen wants the mip two levels down.
+        Manager.RequestScreenSize(Handle, TextureSize / 4.0f);
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Requests.size() == 1);
+        TEST_CHECK(Backend.Requests[0].Handle == Handle && Backend.Requests[0].Mip == 2);
+        TEST_CHECK(Manager.GetStats().NumRequested == 1 && Manager.GetStats().NumInFlight == 1);
+
+        // Nothing is issued twice while the load is in flight.
+        Manager.RequestScreenSize(Handle, TextureSize / 4.0f);
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Requests.size() == 1);
+
+        Backend.Finish(Handle, 2);
+        Manager.RequestScreenSize(Handle, (float)TextureSize);
+        Manager.Update(Settings);
+        TEST_CHECK(Manager.GetResidentMip(Handle) == 2);
+        TEST_CHECK(Backend.Requests.size() == 2 && Backend.Requests[1].Mip == 0);
+        TEST_CHECK(Backend.Evictions.empty());
+
+        // The largest request of the frame wins.
+        Backend.Finish(Handle, 0);
+        Manager.RequestScreenSize(Handle, 8.0f);
+        Manager.RequestScreenSize(Handle, (float)TextureSize);
+        Manager.Update(Settings);
+        TEST_CHECK(Manager.GetResidentMip(Handle) == 0);
+        TEST_CHECK(Manager.GetStats().ResidentBytes == BytesFromMip(Desc, 0));
+        TEST_CHECK(Backend.Requests.size() == 2 && Backend.Evictions.empty());
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.TextureStreaming.EvictsUnseenTexturesForBudget")
+    {
+        FFakeStreamingBackend Backend;
+        FTextureStreamingManager Manager(&Backend);
+        const FStreamingTextureDesc Full = MakeDesc(TextureSize, TailMip, 0);
+        const FStreamingTextureDesc Tail = MakeDesc(TextureSize, TailMip, TailMip);
+
+        // Room for one texture at full detail and the other's resident tail.
+        const FTextureStreamingSettings Settings = MakeSettings(BytesFromMip(Full, 0) + BytesFromMip(Full, TailMip));
+
+        const uint32 Seen = Manager.RegisterTexture(nullptr, Tail);
+        const uint32 Unseen = Manager.RegisterTexture(nullptr, Full);
+
+        // Unseen textures keep their mips for as long as nothing else needs the memory.
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Evictions.empty() && Backend.Requests.empty());
+        TEST_CHECK(Manager.GetResidentMip(Unseen) == 0);
+
+        Manager.RequestMip(Seen, 0);
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Evictions.size() == 1);
+        TEST_CHECK(Backend.Evictions[0].Handle == Unseen && Backend.Evictions[0].Mip == TailMip);
+        TEST_CHECK(Backend.Requests.size() == 1);
+        TEST_CHECK(Backend.Requests[0].Handle == Seen && Backend.Requests[0].Mip == 0);
+        TEST_CHECK(Manager.GetResidentMip(Unseen) == TailMip);
+        TEST_CHECK(Manager.GetStats().NumEvicted == 1);
+
+        // A lowered pool is honored before anything loads, textures not drawn this frame drop to their resident tail.
+        Backend.Finish(Seen, 0);
+        Manager.Update(MakeSettings(0));
+        TEST_CHECK(Manager.GetResidentMip(Seen) == TailMip);
+        TEST_CHECK(Backend.Evictions.size() == 2 && Backend.Evictions[1].Handle == Seen);
+        TEST_CHECK(Manager.GetStats().ResidentBytes == 2 * BytesFromMip(Full, TailMip));
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.TextureStreaming.SettlesForCoarserMip")
+    {
+        FFakeStreamingBackend Backend;
+        FTextureStreamingManager Manager(&Backend);
+        const FStreamingTextureDesc Desc = MakeDesc(TextureSize, TailMip, TailMip);
+
+        const uint32 Handle = Manager.RegisterTexture(nullptr, Desc);
+        Manager.RequestMip(Handle, 0);
+        Manager.Update(MakeSettings(BytesFromMip(Desc, 1)));
+
+        TEST_CHECK(Backend.Requests.size() == 1 && Backend.Requests[0].Mip == 1);
+
+        // Nothing fits past the tail at all, the load waits.
+        FFakeStreamingBackend TightBackend;
+        FTextureStreamingManager Tight(&TightBackend);
+        const uint32 TightHandle = Tight.RegisterTexture(nullptr, Desc);
+        Tight.RequestMip(TightHandle, 0);
+        Tight.Update(MakeSettings(BytesFromMip(Desc, TailMip)));
+
+        TEST_CHECK(TightBackend.Requests.empty());
+        TEST_CHECK(Tight.GetStats().NumDeferred == 1);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.TextureStreaming.FailedLoadsAreNotRetried")
+    {
+        FFakeStreamingBackend Backend;
+        FTextureStreamingManager Manager(&Backend);
+        const FTextureStreamingSettings Settings = MakeSettings(1ull << 30);
+
+        const uint32 Handle = Manager.RegisterTexture(nullptr, MakeDesc(TextureSize, TailMip, TailMip));
+        Manager.RequestMip(Handle, 0);
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Requests.size() == 1);
+
+        Backend.Finish(Handle, TailMip);
+        for (uint32 Frame = 0; Frame < 3; ++Frame)
+        {
+            Manager.RequestMip(Handle, 0);
+            Manager.Update(Settings);
+        }
+
+        TEST_CHECK(Backend.Requests.size() == 1);
+        TEST_CHECK(Manager.GetResidentMip(Handle) == TailMip);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.TextureStreaming.HandlesReuseAfterLateCompletion")
+    {
+        FFakeStreamingBackend Backend;
+        FTextureStreamingManager Manager(&Backend);
+        const FTextureStreamingSettings Settings = MakeSettings(1ull << 30);
+        const FStreamingTextureDesc Desc = MakeDesc(TextureSize, TailMip, TailMip);
+
+        const uint32 Old = Manager.RegisterTexture(nullptr, Desc);
+        Manager.RequestMip(Old, 0);
+        Manager.Update(Settings);
+        Manager.UnregisterTexture(Old);
+
+        // The slot stays taken while its load is in flight.
+        const uint32 Other = Manager.RegisterTexture(nullptr, Desc);
+        TEST_CHECK(Other != Old);
+
+        Backend.Finish(Old, 0);
+        Manager.Update(Settings);
+        TEST_CHECK(Manager.GetStats().NumTextures == 1);
+
+        const uint32 Reused = Manager.RegisterTexture(nullptr, Desc);
+        TEST_CHECK(Reused == Old);
+        TEST_CHECK(Manager.GetResidentMip(Reused) == TailMip);
+
+        // A stray completion for a slot without a load in flight is ignored.
+        Backend.Finish(Reused, 0);
+        Manager.Update(Settings);
+        TEST_CHECK(Manager.GetResidentMip(Reused) == TailMip);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.TextureStreaming.LimitsLoadsInFlight")
+    {
+        FFakeStreamingBackend Backend;
+        FTextureStreamingManager Manager(&Backend);
+        const FTextureStreamingSettings Settings = MakeSettings(1ull << 30, 3);
+        const FStreamingTextureDesc Desc = MakeDesc(TextureSize, TailMip, TailMip);
+
+        TVector<uint32> Handles;
+        for (uint32 i = 0; i < 10; ++i)
+        {
+            Handles.push_back(Manager.RegisterTexture(nullptr, Desc));
+        }
+
+        auto RequestAll = [&]
+        {
+            for (uint32 Handle : Handles)
+            {
+                Manager.RequestMip(Handle, 0);
+            }
+        };
+
+        RequestAll();
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Requests.size() == 3);
+        TEST_CHECK(Manager.GetStats().NumInFlight == 3 && Manager.GetStats().NumDeferred == 7);
+
+        RequestAll();
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Requests.size() == 3);
+
+        for (const FFakeStreamingBackend::FCall& Request : Backend.Requests)
+        {
+            Backend.Finish(Request.Handle, Request.Mip);
+        }
+        RequestAll();
+        Manager.Update(Settings);
+        TEST_CHECK(Backend.Requests.size() == 6);
+    }
+}
+
+#endif
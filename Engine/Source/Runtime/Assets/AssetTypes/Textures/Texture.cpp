@@ -1,11 +1,18 @@
 #include "pch.h"
 #include "Texture.h"
+#include "TextureStreaming.h"
+#include "Core/Console/ConsoleVariable.h"
 #include "Core/Object/Class.h"
+#include "Core/Object/Package/Package.h"
+#include "Core/Profiler/Profile.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RHIGlobals.h"
 
 namespace Lumina
 {
+    static TConsoleVar CVarTextureStreaming("r.TextureStreaming", true, "Loads the finer mips of textures saved with bulk data on demand instead of keeping every mip resident.");
+    static TConsoleVar CVarTextureStreamingMinResidentSize("r.TextureStreaming.MinResidentSize", 128, "Mips of streamed textures at or below this size are loaded with the texture and never evicted.");
+
     void CTexture::Serialize(FArchive& Ar)
     {
         Super::Serialize(Ar);
@@ -14,8 +21,22 @@ namespace Lumina
         {
             TextureResource = MakeUnique<FTextureResource>();
         }
-        
+
+        // Streamed mips are not held in memory, bring them back so the saved package is complete.
+        const bool bRestoreMips = Ar.IsWriting() && IsStreamed();
+        if (bRestoreMips)
+        {
+            // Loads in flight still read the old layout of the file the package saver is about to rewrite.
+            FTextureStreamingManager::Get().Flush();
+            LoadBulkMips(0, (uint8)TextureResource->Mips.size());
+        }
+
         Ar << *TextureResource.get();
+
+        if (bRestoreMips)
+        {
+            ReleaseBulkMips();
+        }
     }
 
     void CTexture::PreLoad()
@@ -28,19 +49,160 @@ namespace Lumina
 
     void CTexture::PostLoad()
     {
-        TextureResource->RHIImage = GRenderContext->CreateImage(TextureResource->ImageDescription);
+        const FRHIImageDesc& Desc = TextureResource->ImageDescription;
+        const uint8 NumMips = (uint8)TextureResource->Mips.size();
+
+        bool bCanStream = CVarTextureStreaming.GetValue() && GetPackage() != nullptr && GetPackage()->BulkDataOffset != INDEX_NONE;
+        bCanStream &= Desc.Dimension == EImageDimension::Texture2D && Desc.ArraySize == 1 && Desc.Depth == 1 && NumMips > 1;
+        for (const FTextureResource::FMip& Mip : TextureResource->Mips)
+        {
+            bCanStream &= Mip.BulkOffset != INDEX_NONE;
+        }
+
+        // Textures that cannot stream keep every mip, the resident tail of streamed ones starts at the first small enough mip.
+        uint8 FirstMip = 0;
+        if (bCanStream)
+        {
+            const uint32 MinResidentSize = (uint32)glm::max(CVarTextureStreamingMinResidentSize.GetValue(), 1);
+            FirstMip = NumMips - 1;
+            for (uint8 i = 0; i < NumMips; ++i)
+            {
+                if (glm::max(TextureResource->Mips[i].Width, TextureResource->Mips[i].Height) <= MinResidentSize)
+                {
+                    FirstMip = i;
+                    break;
+                }
+            }
+        }
+
+        if (!LoadBulkMips(FirstMip, NumMips))
+        {
+            LOG_ERROR("Failed to read the mips of texture {} from its package", GetName());
+            return;
+        }
+
+        FRHIImageDesc ResidentDesc = Desc;
+        ResidentDesc.Extent = glm::uvec2(TextureResource->Mips[FirstMip].Width, TextureResource->Mips[FirstMip].Height);
+        ResidentDesc.NumMips = NumMips - FirstMip;
+
+        TextureResource->RHIImage = GRenderContext->CreateImage(ResidentDesc);
+        ResidentMip = FirstMip;
 
         FRHICommandListRef TransferCommandList = GRenderContext->CreateCommandList(FCommandListInfo::Compute());
         TransferCommandList->Open();
-        
-        for (uint8 i = 0; i < TextureResource->Mips.size(); ++i)
+
+        for (uint8 i = FirstMip; i < NumMips; ++i)
         {
             FTextureResource::FMip& Mip = TextureResource->Mips[i];
             const uint32 RowPitch = Mip.RowPitch;
-            TransferCommandList->WriteImage(TextureResource->RHIImage, 0, i, Mip.Pixels.data(), RowPitch, 1);
+            TransferCommandList->WriteImage(TextureResource->RHIImage, 0, i - FirstMip, Mip.Pixels.data(), RowPitch, 1);
+        }
+
+        TransferCommandList->Close();
+        GRenderContext->ExecuteCommandList(TransferCommandList, ECommandQueue::Compute);
+
+        if (!bCanStream)
+        {
+            return;
+        }
+
+        ReleaseBulkMips();
+
+        FStreamingTextureDesc StreamingDesc;
+        StreamingDesc.Width             = Desc.Extent.x;
+        StreamingDesc.Height            = Desc.Extent.y;
+        StreamingDesc.MinResidentMip    = FirstMip;
+        StreamingDesc.ResidentMip       = FirstMip;
+        for (const FTextureResource::FMip& Mip : TextureResource->Mips)
+        {
+            StreamingDesc.MipSizes.push_back(Mip.GetSizeBytes());
+        }
+
+        StreamingHandle = FTextureStreamingManager::Get().RegisterTexture(this, StreamingDesc);
+    }
+
+    void CTexture::OnDestroy()
+    {
+        if (IsStreamed())
+        {
+            FTextureStreamingManager::Get().UnregisterTexture(StreamingHandle);
+            StreamingHandle = (uint32)INDEX_NONE;
+        }
+
+        Super::OnDestroy();
+    }
+
+    void CTexture::StreamMips(uint8 FirstMip, const TVector<TVector<uint8>>& LoadedMips)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const uint8 NumMips = (uint8)TextureResource->Mips.size();
+        if (FirstMip == ResidentMip || FirstMip >= NumMips)
+        {
+            return;
+        }
+
+        ASSERT(FirstMip > ResidentMip || LoadedMips.size() == (size_t)(ResidentMip - FirstMip));
+
+        FRHIImageDesc Desc = TextureResource->RHIImage->GetDescription();
+        Desc.Extent = glm::uvec2(TextureResource->Mips[FirstMip].Width, TextureResource->Mips[FirstMip].Height);
+        Desc.NumMips = NumMips - FirstMip;
+
+        FRHIImageRef NewImage = GRenderContext->CreateImage(Desc);
+
+        FRHICommandListRef TransferCommandList = GRenderContext->CreateCommandList(FCommandListInfo::Compute());
+        TransferCommandList->Open();
+
+        // The old image stays alive until the command buffers still sampling it have retired.
+        for (uint8 i = glm::max(FirstMip, ResidentMip); i < NumMips; ++i)
+        {
+            const FTextureResource::FMip& Mip = TextureResource->Mips[i];
+            const FTextureSlice SrcSlice = FTextureSlice().SetMipLevel(i - ResidentMip).SetSize(Mip.Width, Mip.Height, 1);
+            const FTextureSlice DstSlice = FTextureSlice().SetMipLevel(i - FirstMip).SetSize(Mip.Width, Mip.Height, 1);
+            TransferCommandList->CopyImage(TextureResource->RHIImage, SrcSlice, NewImage, DstSlice);
+        }
+
+        for (uint8 i = FirstMip; i < ResidentMip; ++i)
+        {
+            const FTextureResource::FMip& Mip = TextureResource->Mips[i];
+            TransferCommandList->WriteImage(NewImage, 0, i - FirstMip, LoadedMips[i - FirstMip].data(), Mip.RowPitch, 1);
         }
 
         TransferCommandList->Close();
-        GRenderContext->ExecuteCommandList(TransferCommandList, ECommandQueue::Compute);   
+        GRenderContext->ExecuteCommandList(TransferCommandList, ECommandQueue::Compute);
+
+        TextureResource->RHIImage = NewImage;
+        ResidentMip = FirstMip;
+    }
+
+    bool CTexture::LoadBulkMips(uint8 FirstMip, uint8 EndMip)
+    {
+        for (uint8 i = FirstMip; i < EndMip; ++i)
+        {
+            FTextureResource::FMip& Mip = TextureResource->Mips[i];
+            if (!Mip.Pixels.empty() || Mip.BulkOffset == INDEX_NONE)
+            {
+                continue;
+            }
+
+            if (GetPackage() == nullptr || !GetPackage()->ReadBulkData(Mip.BulkOffset, Mip.BulkSize, Mip.Pixels))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void CTexture::ReleaseBulkMips()
+    {
+        for (FTextureResource::FMip& Mip : TextureResource->Mips)
+        {
+            if (Mip.BulkOffset != INDEX_NONE)
+            {
+                Mip.Pixels.clear();
+                Mip.Pixels.shrink_to_fit();
+            }
+        }
     }
 }
@@ -21,14 +21,34 @@ namespace Lumina
         void Serialize(FArchive& Ar) override;
         void PreLoad() override;
         void PostLoad() override;
+        void OnDestroy() override;
         bool IsAsset() const override { return true; }
 
 
         FORCEINLINE FRHIImage* GetRHIRef() const { return TextureResource.get() ? TextureResource->RHIImage : nullptr; }
         FTextureResource* GetTextureResource() const { return TextureResource.get(); }
         uint8 GetNumMips() const { return TextureResource.get() ? TextureResource->Mips.size() : 0u; }
+
+        /** Streamed textures keep only the mips from GetResidentMip() onward on the GPU, the image's mip 0 is that mip. */
+        bool IsStreamed() const { return StreamingHandle != (uint32)INDEX_NONE; }
+        uint32 GetStreamingHandle() const { return StreamingHandle; }
+        uint8 GetResidentMip() const { return ResidentMip; }
+
+        /**
+         * Recreates the image with FirstMip as its finest mip. LoadedMips holds the pixels of the mips from FirstMip
+         * up to the current resident mip and is empty when dropping mips, the mips already on the GPU are copied over.
+         */
+        void StreamMips(uint8 FirstMip, const TVector<TVector<uint8>>& LoadedMips);
         
         
         TUniquePtr<FTextureResource> TextureResource;
+
+    private:
+
+        bool LoadBulkMips(uint8 FirstMip, uint8 EndMip);
+        void ReleaseBulkMips();
+
+        uint32  StreamingHandle = (uint32)INDEX_NONE;
+        uint8   ResidentMip = 0;
     };
 }
@@ -0,0 +1,465 @@
+#include "pch.h"
+#include "TextureStreaming.h"
+
+#include "Texture.h"
+#include "Core/Console/ConsoleVariable.h"
+#include "Core/Object/ObjectHandleTyped.h"
+#include "Core/Object/Package/Package.h"
+#include "Core/Profiler/Profile.h"
+#include "Core/Threading/Atomic.h"
+#include "FileSystem/FileSystem.h"
+#include "EASTL/sort.h"
+#include "Memory/SmartPtr.h"
+#include "TaskSystem/TaskSystem.h"
+
+namespace Lumina
+{
+    static TConsoleVar CVarTextureStreamingPoolSize("r.TextureStreaming.PoolSizeMB", 512, "Most megabytes the mips of streamed textures may take, loads wait or settle for coarser mips past it.");
+    static TConsoleVar CVarTextureStreamingMaxInFlight("r.TextureStreaming.MaxInFlight", 8, "Most textures with mip loads running on the task system at once.");
+    static TConsoleVar CVarTextureStreamingMipBias("r.TextureStreaming.MipBias", 0.0f, "Added to the mip each texture wants from its screen size, positive values trade sharpness for memory.");
+
+    namespace
+    {
+        /** Reads requested mips from the package bulk data on the task system, the image swap happens on the main thread when polled. */
+        class FPackageTextureStreamingBackend : public ITextureStreamingBackend
+        {
+        public:
+
+            void RequestMips(uint32 Handle, CTexture* Texture, uint8 FirstMip) override
+            {
+                TSharedPtr<FMipLoad> Load = MakeShared<FMipLoad>();
+                Load->Handle        = Handle;
+                Load->Texture       = Texture;
+                Load->FirstMip      = FirstMip;
+                Load->ResidentMip   = Texture->GetResidentMip();
+
+                // The read only touches the file, the package and the texture may both be gone by the time it runs.
+                const CPackage* Package = Texture->GetPackage();
+                const FTextureResource* Resource = Texture->GetTextureResource();
+                Load->PackagePath = Package->GetPackagePath();
+                for (uint8 Mip = FirstMip; Mip < Load->ResidentMip; ++Mip)
+                {
+                    Load->Ranges.emplace_back(Package->BulkDataOffset + Resource->Mips[Mip].BulkOffset, Resource->Mips[Mip].BulkSize);
+                }
+                Load->Pixels.resize(Load->Ranges.size());
+
+                NumInFlight.fetch_add(1, std::memory_order_relaxed);
+
+                Task::AsyncTask(1, 1, [this, Load](uint32, uint32, uint32)
+                {
+                    LUMINA_PROFILE_SECTION("Stream Texture Mips");
+
+                    for (size_t i = 0; i < Load->Ranges.size() && !Load->bFailed; ++i)
+                    {
+                        const int64 Size = Load->Ranges[i].second;
+                        Load->bFailed = !VFS::ReadFileRange(Load->Pixels[i], Load->PackagePath, Load->Ranges[i].first, Size) || (int64)Load->Pixels[i].size() != Size;
+                    }
+
+                    {
+                        FScopeLock Lock(FinishedMutex);
+                        Finished.push_back(Load);
+                    }
+
+                    NumInFlight.fetch_sub(1, std::memory_order_release);
+                    NumInFlight.notify_all();
+                }, ETaskPriority::Low);
+            }
+
+            void EvictMips(uint32 Handle, CTexture* Texture, uint8 FirstMip) override
+            {
+                Texture->StreamMips(FirstMip, {});
+            }
+
+            void PollCompleted(TVector<FTextureStreamingCompletion>& OutCompleted) override
+            {
+                TVector<TSharedPtr<FMipLoad>> Loads;
+                {
+                    FScopeLock Lock(FinishedMutex);
+                    Loads.swap(Finished);
+                }
+
+                for (const TSharedPtr<FMipLoad>& Load : Loads)
+                {
+                    uint8 ResidentMip = Load->ResidentMip;
+                    if (CTexture* Texture = Load->Texture.Get())
+                    {
+                        if (Load->bFailed)
+                        {
+                            LOG_WARN("Failed to stream mips {} to {} of texture {}", Load->FirstMip, Load->ResidentMip - 1, Texture->GetName());
+                        }
+                        else
+                        {
+                            Texture->StreamMips(Load->FirstMip, Load->Pixels);
+                            ResidentMip = Load->FirstMip;
+                        }
+                    }
+
+                    OutCompleted.push_back(FTextureStreamingCompletion{ Load->Handle, ResidentMip });
+                }
+            }
+
+            void Flush() override
+            {
+                int32 Count;
+                while ((Count = NumInFlight.load(std::memory_order_acquire)) != 0)
+                {
+                    NumInFlight.wait(Count, std::memory_order_acquire);
+                }
+            }
+
+        private:
+
+            struct FMipLoad
+            {
+                uint32                              Handle = 0;
+                TWeakObjectPtr<CTexture>            Texture;
+                FFixedString                        PackagePath;
+                uint8                               FirstMip = 0;
+                uint8                               ResidentMip = 0;
+                TVector<eastl::pair<int64, int64>>  Ranges;
+                TVector<TVector<uint8>>             Pixels;
+                bool                                bFailed = false;
+            };
+
+            FMutex                              FinishedMutex;
+            TVector<TSharedPtr<FMipLoad>>       Finished;
+            TAtomic<int32>                      NumInFlight{0};
+        };
+    }
+
+    FTextureStreamingManager::FTextureStreamingManager(ITextureStreamingBackend* InBackend)
+        : Backend(InBackend)
+    {
+    }
+
+    FTextureStreamingManager& FTextureStreamingManager::Get()
+    {
+        static FPackageTextureStreamingBackend PackageBackend;
+        static FTextureStreamingManager Instance(&PackageBackend);
+        return Instance;
+    }
+
+    uint32 FTextureStreamingManager::RegisterTexture(CTexture* Texture, const FStreamingTextureDesc& Desc)
+    {
+        ASSERT(!Desc.MipSizes.empty());
+
+        FScopeLock Lock(Mutex);
+
+        uint32 Handle;
+        if (!FreeHandles.empty())
+        {
+            Handle = FreeHandles.back();
+            FreeHandles.pop_back();
+        }
+        else
+        {
+            Handle = (uint32)Textures.size();
+            Textures.emplace_back();
+        }
+
+        const uint8 NumMips = (uint8)Desc.MipSizes.size();
+
+        FStreamingTexture& Streaming = Textures[Handle];
+        Streaming = FStreamingTexture();
+        Streaming.Texture           = Texture;
+        Streaming.Size              = glm::max(Desc.Width, Desc.Height);
+        Streaming.MinResidentMip    = glm::min<uint8>(Desc.MinResidentMip, NumMips - 1);
+        Streaming.ResidentMip       = glm::min(Desc.ResidentMip, Streaming.MinResidentMip);
+        Streaming.RequestedMip      = Streaming.MinResidentMip;
+        Streaming.bRegistered       = true;
+
+        Streaming.BytesFromMip.resize(NumMips);
+        uint64 Bytes = 0;
+        for (int32 Mip = NumMips - 1; Mip >= 0; --Mip)
+        {
+            Bytes += Desc.MipSizes[Mip];
+            Streaming.BytesFromMip[Mip] = Bytes;
+        }
+
+        return Handle;
+    }
+
+    void FTextureStreamingManager::UnregisterTexture(uint32 Handle)
+    {
+        FScopeLock Lock(Mutex);
+
+        if (Handle >= Textures.size() || !Textures[Handle].bRegistered)
+        {
+            return;
+        }
+
+        FStreamingTexture& Streaming = Textures[Handle];
+        Streaming.bRegistered = false;
+        Streaming.Texture = nullptr;
+
+        // A slot with a load in flight is only reused once the backend reports it, so the late completion cannot land on a new texture.
+        if (!Streaming.bPending)
+        {
+            FreeSlot(Handle);
+        }
+    }
+
+    void FTextureStreamingManager::RequestScreenSize(uint32 Handle, float ScreenPixels)
+    {
+        FScopeLock Lock(Mutex);
+
+        if (Handle >= Textures.size() || !Textures[Handle].bRegistered)
+        {
+            return;
+        }
+
+        // Assumes the texture spans the primitive once, each halving of the screen size drops a mip.
+        FStreamingTexture& Streaming = Textures[Handle];
+        const float TexelsPerPixel  = (float)Streaming.Size / glm::max(ScreenPixels, 1.0f);
+        const float Level           = glm::log2(glm::max(TexelsPerPixel, 1.0f)) + MipBias;
+        const int32 Mip             = glm::clamp((int32)glm::floor(Level), 0, (int32)Streaming.MinResidentMip);
+
+        RecordRequest(Streaming, (uint8)Mip);
+    }
+
+    void FTextureStreamingManager::RequestMip(uint32 Handle, uint8 Mip)
+    {
+        FScopeLock Lock(Mutex);
+
+        if (Handle >= Textures.size() || !Textures[Handle].bRegistered)
+        {
+            return;
+        }
+
+        FStreamingTexture& Streaming = Textures[Handle];
+        RecordRequest(Streaming, glm::min(Mip, Streaming.MinResidentMip));
+    }
+
+    void FTextureStreamingManager::Update()
+    {
+        FTextureStreamingSettings Settings;
+        Settings.PoolSizeBytes  = (uint64)glm::max(CVarTextureStreamingPoolSize.GetValue(), 0) << 20;
+        Settings.MaxInFlight    = (uint32)glm::max(CVarTextureStreamingMaxInFlight.GetValue(), 1);
+        Settings.MipBias        = CVarTextureStreamingMipBias.GetValue();
+
+        Update(Settings);
+    }
+
+    void FTextureStreamingManager::Update(const FTextureStreamingSettings& Settings)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        FScopeLock Lock(Mutex);
+
+        MipBias = Settings.MipBias;
+        ApplyCompletions();
+
+        struct FLoadCandidate
+        {
+            uint32  Handle;
+            uint8   MissingMips;
+            uint8   WantedMip;
+
+            /** The queue pops the texture furthest from the detail it wants, then the one wanting the finest mip. */
+            bool operator < (const FLoadCandidate& Other) const
+            {
+                if (MissingMips != Other.MissingMips)
+                {
+                    return MissingMips < Other.MissingMips;
+                }
+                return WantedMip > Other.WantedMip;
+            }
+        };
+
+        FTextureStreamingStats NewStats;
+        NewStats.PoolSizeBytes = Settings.PoolSizeBytes;
+
+        TPriorityQueue<FLoadCandidate> LoadQueue;
+        TVector<uint32> EvictionCandidates;
+        TVector<uint8> WantedMips(Textures.size(), 0);
+        uint64 CommittedBytes = 0;
+
+        for (uint32 Handle = 0; Handle < (uint32)Textures.size(); ++Handle)
+        {
+            const FStreamingTexture& Streaming = Textures[Handle];
+            if (!Streaming.bRegistered)
+            {
+                continue;
+            }
+
+            // Textures nobody drew this frame only want their resident tail, their surplus is the first to go when memory runs out.
+            const uint8 WantedMip = Streaming.RequestFrame == Frame ? Streaming.RequestedMip : Streaming.MinResidentMip;
+            WantedMips[Handle] = WantedMip;
+
+            NewStats.NumTextures++;
+            NewStats.NumInFlight    += Streaming.bPending;
+            NewStats.ResidentBytes  += Streaming.BytesFromMip[Streaming.ResidentMip];
+            NewStats.WantedBytes    += Streaming.BytesFromMip[WantedMip];
+            CommittedBytes          += Streaming.BytesFromMip[Streaming.GetCommittedMip()];
+
+            if (Streaming.bPending)
+            {
+                continue;
+            }
+
+            if (WantedMip < Streaming.ResidentMip && !Streaming.bFailed)
+            {
+                LoadQueue.push(FLoadCandidate{ Handle, (uint8)(Streaming.ResidentMip - WantedMip), WantedMip });
+            }
+            else if (WantedMip > Streaming.ResidentMip)
+            {
+                EvictionCandidates.push_back(Handle);
+            }
+        }
+
+        // Least recently seen first, the largest surplus first among textures seen on the same frame.
+        eastl::sort(EvictionCandidates.begin(), EvictionCandidates.end(), [&](uint32 A, uint32 B)
+        {
+            const FStreamingTexture& TextureA = Textures[A];
+            const FStreamingTexture& TextureB = Textures[B];
+            if (TextureA.RequestFrame != TextureB.RequestFrame)
+            {
+                return TextureA.RequestFrame < TextureB.RequestFrame;
+            }
+            return TextureA.BytesFromMip[TextureA.ResidentMip] - TextureA.BytesFromMip[WantedMips[A]] >
+                   TextureB.BytesFromMip[TextureB.ResidentMip] - TextureB.BytesFromMip[WantedMips[B]];
+        });
+
+        size_t NextEviction = 0;
+        auto EvictUntil = [&](uint64 Limit)
+        {
+            while (CommittedBytes > Limit && NextEviction < EvictionCandidates.size())
+            {
+                const uint32 Handle = EvictionCandidates[NextEviction++];
+                FStreamingTexture& Streaming = Textures[Handle];
+                const uint8 WantedMip = WantedMips[Handle];
+
+                CommittedBytes -= Streaming.BytesFromMip[Streaming.ResidentMip] - Streaming.BytesFromMip[WantedMip];
+                NewStats.ResidentBytes -= Streaming.BytesFromMip[Streaming.ResidentMip] - Streaming.BytesFromMip[WantedMip];
+
+                Backend->EvictMips(Handle, Streaming.Texture, WantedMip);
+                Streaming.ResidentMip = WantedMip;
+                NewStats.NumEvicted++;
+            }
+        };
+
+        // A lowered pool size is honored before anything new is loaded.
+        EvictUntil(Settings.PoolSizeBytes);
+
+        while (!LoadQueue.empty() && NewStats.NumInFlight < Settings.MaxInFlight)
+        {
+            const FLoadCandidate Candidate = LoadQueue.top();
+            LoadQueue.pop();
+
+            FStreamingTexture& Streaming = Textures[Candidate.Handle];
+            const uint64 CurrentBytes = Streaming.BytesFromMip[Streaming.ResidentMip];
+            auto ExtraBytes = [&](uint8 Mip) { return Streaming.BytesFromMip[Mip] - CurrentBytes; };
+
+            const uint64 WantedExtra = ExtraBytes(Candidate.WantedMip);
+            if (CommittedBytes + WantedExtra > Settings.PoolSizeBytes)
+            {
+                EvictUntil(Settings.PoolSizeBytes > WantedExtra ? Settings.PoolSizeBytes - WantedExtra : 0);
+            }
+
+            // Settle for the finest mip that still fits when the surplus of other textures was not enough.
+            uint8 TargetMip = Candidate.WantedMip;
+            while (TargetMip < Streaming.ResidentMip && CommittedBytes + ExtraBytes(TargetMip) > Settings.PoolSizeBytes)
+            {
+                ++TargetMip;
+            }
+
+            if (TargetMip == Streaming.ResidentMip)
+            {
+                NewStats.NumDeferred++;
+                continue;
+            }
+
+            Backend->RequestMips(Candidate.Handle, Streaming.Texture, TargetMip);
+            Streaming.bPending = true;
+            Streaming.PendingMip = TargetMip;
+            CommittedBytes += ExtraBytes(TargetMip);
+
+            NewStats.NumInFlight++;
+            NewStats.NumRequested++;
+        }
+
+        NewStats.NumDeferred += (uint32)LoadQueue.size();
+
+        Stats = NewStats;
+        Frame++;
+    }
+
+    void FTextureStreamingManager::Flush()
+    {
+        LUMINA_PROFILE_SCOPE();
+        Backend->Flush();
+    }
+
+    void FTextureStreamingManager::Shutdown()
+    {
+        FScopeLock Lock(Mutex);
+
+        Backend->Flush();
+
+        Completions.clear();
+        Backend->PollCompleted(Completions);
+        Completions.clear();
+
+        Textures.clear();
+        FreeHandles.clear();
+        Stats = FTextureStreamingStats();
+    }
+
+    uint8 FTextureStreamingManager::GetResidentMip(uint32 Handle) const
+    {
+        FScopeLock Lock(Mutex);
+        return Handle < Textures.size() ? Textures[Handle].ResidentMip : 0;
+    }
+
+    FTextureStreamingStats FTextureStreamingManager::GetStats() const
+    {
+        FScopeLock Lock(Mutex);
+        return Stats;
+    }
+
+    void FTextureStreamingManager::RecordRequest(FStreamingTexture& Texture, uint8 Mip) const
+    {
+        if (Texture.RequestFrame != Frame)
+        {
+            Texture.RequestFrame = Frame;
+            Texture.RequestedMip = Mip;
+        }
+        else
+        {
+            Texture.RequestedMip = glm::min(Texture.RequestedMip, Mip);
+        }
+    }
+
+    void FTextureStreamingManager::ApplyCompletions()
+    {
+        Completions.clear();
+        Backend->PollCompleted(Completions);
+
+        for (const FTextureStreamingCompletion& Completion : Completions)
+        {
+            if (Completion.Handle >= Textures.size() || !Textures[Completion.Handle].bPending)
+            {
+                continue;
+            }
+
+            FStreamingTexture& Streaming = Textures[Completion.Handle];
+            Streaming.bPending = false;
+
+            if (!Streaming.bRegistered)
+            {
+                FreeSlot(Completion.Handle);
+                continue;
+            }
+
+            // A failed load leaves the resident mips untouched and is not retried.
+            Streaming.bFailed = Completion.ResidentMip > Streaming.PendingMip;
+            Streaming.ResidentMip = Completion.ResidentMip;
+        }
+    }
+
+    void FTextureStreamingManager::FreeSlot(uint32 Handle)
+    {
+        Textures[Handle] = FStreamingTexture();
+        FreeHandles.push_back(Handle);
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "Core/Threading/Thread.h"
+#include "Platform/GenericPlatform.h"
+
+namespace Lumina
+{
+    class CTexture;
+
+    /** What the streaming manager needs to know about a texture when it is registered. */
+    struct FStreamingTextureDesc
+    {
+        /** GPU bytes of each mip, finest first. */
+        TFixedVector<uint64, 16>    MipSizes;
+
+        uint32                      Width = 1;
+        uint32                      Height = 1;
+
+        /** Mips from this one down are uploaded at load and never evicted. */
+        uint8                       MinResidentMip = 0;
+
+        /** First mip on the GPU when the texture is registered. */
+        uint8                       ResidentMip = 0;
+    };
+
+    struct FTextureStreamingCompletion
+    {
+        uint32  Handle = 0;
+
+        /** First mip resident once the request finished, unchanged from before the request when it failed. */
+        uint8   ResidentMip = 0;
+    };
+
+    /**
+     * Moves mips in and out of memory on behalf of the streaming manager, which only decides what should be resident.
+     * The engine backend reads mips from the package bulk data on the task system, tests can record the calls instead.
+     */
+    class ITextureStreamingBackend
+    {
+    public:
+
+        virtual ~ITextureStreamingBackend() = default;
+
+        /** Starts loading every mip from FirstMip up to the ones already resident, the result is reported through PollCompleted. */
+        virtual void RequestMips(uint32 Handle, CTexture* Texture, uint8 FirstMip) = 0;
+
+        /** Drops every mip in front of FirstMip, done by the time the call returns. */
+        virtual void EvictMips(uint32 Handle, CTexture* Texture, uint8 FirstMip) = 0;
+
+        /** Appends the requests that finished since the last call. */
+        virtual void PollCompleted(TVector<FTextureStreamingCompletion>& OutCompleted) = 0;
+
+        /** Blocks until no request is in flight. */
+        virtual void Flush() = 0;
+    };
+
+    struct FTextureStreamingSettings
+    {
+        uint64  PoolSizeBytes = 512ull << 20;
+        uint32  MaxInFlight = 8;
+
+        /** Added to every wanted mip, positive values trade sharpness for memory. */
+        float   MipBias = 0.0f;
+    };
+
+    struct FTextureStreamingStats
+    {
+        uint32  NumTextures = 0;
+        uint32  NumInFlight = 0;
+        uint64  ResidentBytes = 0;
+        uint64  WantedBytes = 0;
+        uint64  PoolSizeBytes = 0;
+
+        /** Counted over the last update. */
+        uint32  NumRequested = 0;
+        uint32  NumEvicted = 0;
+        uint32  NumDeferred = 0;
+    };
+
+    /**
+     * Keeps the mips of streamed textures resident according to how large they were seen on screen.
+     * Every frame the renderer reports the projected size of the primitives using each texture, Update then
+     * loads the missing mips of the textures most short of detail first while keeping the resident and in
+     * flight bytes under the pool size, evicting the surplus mips of the least recently seen textures to make room.
+     */
+    class RUNTIME_API FTextureStreamingManager
+    {
+    public:
+
+        explicit FTextureStreamingManager(ITextureStreamingBackend* InBackend);
+
+        FTextureStreamingManager(const FTextureStreamingManager&) = delete;
+        FTextureStreamingManager& operator=(const FTextureStreamingManager&) = delete;
+
+        /** The engine wide manager, backed by the package bulk data reader. */
+        static FTextureStreamingManager& Get();
+
+        /** Returns the handle the texture reports its usage with, safe to call from any thread. */
+        uint32 RegisterTexture(CTexture* Texture, const FStreamingTextureDesc& Desc);
+        void UnregisterTexture(uint32 Handle);
+
+        /** Records a primitive covering this many pixels across that samples the texture this frame. */
+        void RequestScreenSize(uint32 Handle, float ScreenPixels);
+
+        /** Records an explicit mip wanted this frame, for views that do not go through the renderer. */
+        void RequestMip(uint32 Handle, uint8 Mip);
+
+        /** Applies finished loads, then issues new loads and evictions. Called once per frame on the main thread. */
+        void Update();
+        void Update(const FTextureStreamingSettings& Settings);
+
+        /** Waits for the loads in flight, their results are applied by the next Update. Needed before a package they read from is rewritten. */
+        void Flush();
+
+        /** Waits for the requests in flight and forgets every texture. */
+        void Shutdown();
+
+        uint8 GetResidentMip(uint32 Handle) const;
+        FTextureStreamingStats GetStats() const;
+
+    private:
+
+        struct FStreamingTexture
+        {
+            CTexture*                   Texture = nullptr;
+
+            /** BytesFromMip[i] is the size of mips i and coarser, what the texture costs with mip i resident. */
+            TFixedVector<uint64, 16>    BytesFromMip;
+
+            uint32                      Size = 1;
+            uint64                      RequestFrame = 0;
+            uint8                       MinResidentMip = 0;
+            uint8                       ResidentMip = 0;
+            uint8                       PendingMip = 0;
+            uint8                       RequestedMip = 0;
+            bool                        bRegistered = false;
+            bool                        bPending = false;
+            bool                        bFailed = false;
+
+            /** First mip the memory accounting charges for, loads count as soon as they are issued. */
+            uint8 GetCommittedMip() const { return bPending ? PendingMip : ResidentMip; }
+        };
+
+        void RecordRequest(FStreamingTexture& Texture, uint8 Mip) const;
+        void ApplyCompletions();
+        void FreeSlot(uint32 Handle);
+
+        ITextureStreamingBackend*           Backend = nullptr;
+        mutable FMutex                      Mutex;
+
+        TVector<FStreamingTexture>          Textures;
+        TVector<uint32>                     FreeHandles;
+        TVector<FTextureStreamingCompletion> Completions;
+
+        uint64                              Frame = 1;
+        float                               MipBias = 0.0f;
+        FTextureStreamingStats              Stats;
+    };
+}
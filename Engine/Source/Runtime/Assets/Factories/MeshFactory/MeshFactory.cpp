@@ -189,6 +189,10 @@ namespace Lumina
                 "Optimize vertex cache locality and reduce overdraw for better rendering performance", 
                 Options.bOptimize);
             
+            AddCheckboxRow(LE_ICON_LAYERS, "Generate LODs", 
+                "Simplify each mesh into a chain of lower detail levels, picked at runtime by screen size", 
+                Options.bGenerateLODs);
+            
             AddSectionHeader("Animation");
             
             AddCheckboxRow(LE_ICON_ANIMATION, "Import Animations", 
@@ -238,7 +242,7 @@ namespace Lumina
             ImGui::Spacing();
     
             ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(10, 6));
-            if (ImGui::BeginTable("ImportMeshStats", 6, 
+            if (ImGui::BeginTable("ImportMeshStats", 7, 
                 ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | 
                 ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY, ImVec2(0, 150)))
             {
@@ -246,6 +250,7 @@ namespace Lumina
                 ImGui::TableSetupColumn("Vertices", ImGuiTableColumnFlags_WidthFixed, 80);
                 ImGui::TableSetupColumn("Indices", ImGuiTableColumnFlags_WidthFixed, 80);
                 ImGui::TableSetupColumn("Surfaces", ImGuiTableColumnFlags_WidthFixed, 80);
+                ImGui::TableSetupColumn("LODs", ImGuiTableColumnFlags_WidthFixed, 80);
                 ImGui::TableSetupColumn("Overdraw", ImGuiTableColumnFlags_WidthFixed, 80);
                 ImGui::TableSetupColumn("V-Fetch", ImGuiTableColumnFlags_WidthFixed, 80);
                 
@@ -277,12 +282,13 @@ namespace Lumina
                     SetColoredColumnWithColor(1, VertexColor,  "{0}", ImGuiX::FormatSize(Resource.GetNumVertices()));
                     SetColoredColumn(2, "{0}", ImGuiX::FormatSize(Resource.Indices.size()));
                     SetColoredColumn(3, "{0}", Resource.GeometrySurfaces.size());
+                    SetColoredColumn(4, "{0}", Resource.GetNumLODs());
                     
                     ImVec4 OverdrawColor = Overdraw.overdraw > 2.0f ? ImVec4(1,0.5f,0.5f,1) : ImVec4(0.8f,0.8f,0.8f,1);
-                    SetColoredColumnWithColor(4, OverdrawColor, "{:.2f}", Overdraw.overdraw);
+                    SetColoredColumnWithColor(5, OverdrawColor, "{:.2f}", Overdraw.overdraw);
                     
                     ImVec4 FetchColor = VertexFetch.overfetch > 2.0f ? ImVec4(1,0.5f,0.5f,1) : ImVec4(0.8f,0.8f,0.8f,1);
-                    SetColoredColumnWithColor(5, FetchColor, "{:.2f}", VertexFetch.overfetch);
+                    SetColoredColumnWithColor(6, FetchColor, "{:.2f}", VertexFetch.overfetch);
                 };
     
                 for (size_t i = 0; i < ImportedData->Resources.size(); ++i)
@@ -689,6 +695,7 @@ namespace Lumina
             
                 NewMesh->SetFlag(OF_NeedsPostLoad);
                 NewMesh->MeshResources = Move(MeshResource);
+                NewMesh->CookCollision();
             
                 CPackage* NewPackage = NewMesh->GetPackage();
                 CPackage::SavePackage(NewPackage, NewPackage->GetPackagePath());
@@ -7,10 +7,7 @@
 #include "Core/Object/Package/Thumbnail/PackageThumbnail.h"
 #include "Paths/Paths.h"
 #include "Platform/Filesystem/FileHelper.h"
-#include "Renderer/RenderContext.h"
-#include "Renderer/RendererUtils.h"
 #include "Renderer/RenderTypes.h"
-#include "Renderer/RHIGlobals.h"
 #include "Tools/Import/ImportHelpers.h"
 
 namespace Lumina
@@ -20,26 +17,16 @@ namespace Lumina
         return NewObject<CTexture>(Package, Name);
     }
     
-    static void CreatePackageThumbnail(CTexture* Texture)
+    static void CreatePackageThumbnail(CTexture* Texture, const Import::Textures::FTextureImportResult& Image)
     {
-        FRHICommandListRef CommandList = GRenderContext->CreateCommandList(FCommandListInfo::Graphics());
-        CommandList->Open();
-    
-        FRHIStagingImageRef StagingImage = GRenderContext->CreateStagingImage(Texture->TextureResource->ImageDescription, ERHIAccess::HostRead);
-        CommandList->CopyImage(Texture->TextureResource->RHIImage, FTextureSlice(), StagingImage, FTextureSlice());
-    
-        CommandList->Close();
-        GRenderContext->ExecuteCommandList(CommandList);
-    
-        size_t RowPitch = 0;
-        void* MappedMemory = GRenderContext->MapStagingTexture(StagingImage, FTextureSlice(), ERHIAccess::HostRead, &RowPitch);
-        if (!MappedMemory)
-        {
-            return;
-        }
-    
-        const uint32 SourceWidth  = Texture->TextureResource->RHIImage->GetDescription().Extent.x;
-        const uint32 SourceHeight = Texture->TextureResource->RHIImage->GetDescription().Extent.y;
+        TVector<uint8> SourcePixels;
+        Import::Textures::ConvertToRGBA8(Image, SourcePixels);
+
+        constexpr size_t BytesPerPixel = 4;
+        const size_t RowPitch = Image.Dimensions.x * BytesPerPixel;
+        
+        const uint32 SourceWidth  = Image.Dimensions.x;
+        const uint32 SourceHeight = Image.Dimensions.y;
         
         CPackage* AssetPackage = Texture->GetPackage();
     
@@ -49,12 +36,11 @@ namespace Lumina
         AssetPackage->GetPackageThumbnail()->ImageWidth = ThumbWidth;
         AssetPackage->GetPackageThumbnail()->ImageHeight = ThumbHeight;
 
-        constexpr size_t BytesPerPixel = 4;
         constexpr size_t TotalBytes = ThumbWidth * ThumbHeight * BytesPerPixel;
         
         AssetPackage->GetPackageThumbnail()->ImageData.resize(TotalBytes);
         
-        const uint8* SourceData = static_cast<const uint8*>(MappedMemory);
+        const uint8* SourceData = SourcePixels.data();
         uint8* DestData = AssetPackage->GetPackageThumbnail()->ImageData.data();
         
         const float ScaleX = static_cast<float>(SourceWidth) / ThumbWidth;
@@ -93,8 +79,6 @@ namespace Lumina
                 }
             }
         }
-        
-        GRenderContext->UnMapStagingTexture(StagingImage);
     }
     
     void CTextureFactory::TryImport(const FFixedString& RawPath, const FFixedString& DestinationPath, const eastl::any& ImportSettings)
@@ -112,117 +96,26 @@ namespace Lumina
         }
 
         const Import::Textures::FTextureImportResult& Result = MaybeResult.value();
-        
-        TVector<uint8> Pixels = Result.Pixels;
-        
-        FRHIImageDesc ImageDescription;
-        ImageDescription.Format                                 = Result.Format;
-        ImageDescription.Extent                                 = Result.Dimensions;
-        ImageDescription.Flags                                  .SetMultipleFlags(EImageCreateFlags::ShaderResource, EImageCreateFlags::Storage);
-        ImageDescription.NumMips                                = (uint8)RenderUtils::CalculateMipCount(ImageDescription.Extent.x, ImageDescription.Extent.y);
-        ImageDescription.InitialState                           = EResourceStates::ShaderResource;
-        ImageDescription.bKeepInitialState                      = true;
-        NewTexture->TextureResource->ImageDescription           = ImageDescription;
-
-        NewTexture->TextureResource->Mips.resize(ImageDescription.NumMips);
-
-        FRHIImageRef RHIImage = GRenderContext->CreateImage(ImageDescription);
-        NewTexture->TextureResource->RHIImage = RHIImage;
 
-        uint32 BytesPerBlock = RHI::Format::BytesPerBlock(ImageDescription.Format);
-        const uint32 BaseWidth = ImageDescription.Extent.x;
-        const uint32 BaseRowPitch = BaseWidth * BytesPerBlock;
-
-        FRHIStagingImageRef StagingImage = GRenderContext->CreateStagingImage(RHIImage->GetDescription(), ERHIAccess::HostRead);
-
-        // Generate the base mip.
-        FRHICommandListRef CommandList = GRenderContext->CreateCommandList(FCommandListInfo::Compute());
-        CommandList->Open();
-        
-        CommandList->WriteImage(RHIImage, 0, 0, Pixels.data(), BaseRowPitch, 1);
-        CommandList->CopyImage(RHIImage, FTextureSlice(), StagingImage, FTextureSlice());
-        
-        for (uint8 i = 1; i < ImageDescription.NumMips; ++i)
+        Import::Textures::FTextureImportOptions Options;
+        if (const Import::Textures::FTextureImportOptions* RequestedOptions = eastl::any_cast<Import::Textures::FTextureImportOptions>(&ImportSettings))
         {
-            LUMINA_PROFILE_SECTION_COLORED("Process Mip", tracy::Color::Yellow4);
-
-            FRHIComputeShaderRef ComputeShader = FShaderLibrary::GetComputeShader("GenMipmaps.comp");
-        
-            FBindingSetDesc SetDesc;
-            SetDesc.AddItem(FBindingSetItem::TextureSRV(0, RHIImage, nullptr, RHIImage->GetFormat(), FTextureSubresourceSet(i - 1, 1, 0, 1)));
-            SetDesc.AddItem(FBindingSetItem::TextureUAV(1, RHIImage, RHIImage->GetFormat(), FTextureSubresourceSet(i, 1, 0, 1)));
-
-            FRHIBindingSetRef Set;
-            FRHIBindingLayoutRef Layout;
-            TBitFlags<ERHIShaderType> Visibility;
-            Visibility.SetFlag(ERHIShaderType::Compute);
-            GRenderContext->CreateBindingSetAndLayout(Visibility, 0, SetDesc, Layout, Set);
-        
-            FComputePipelineDesc PipelineDesc;
-            PipelineDesc.AddBindingLayout(Layout);
-            PipelineDesc.CS = ComputeShader;
-            PipelineDesc.DebugName = "Gen Mip Maps";
-        
-            FRHIComputePipelineRef Pipeline = GRenderContext->CreateComputePipeline(PipelineDesc);
-        
-            FComputeState State;
-            State.AddBindingSet(Set);
-            State.SetPipeline(Pipeline);
-        
-            CommandList->SetComputeState(State);
-            
-            uint32 LevelWidth  = std::max(RenderUtils::GetMipDim(RHIImage->GetSizeX(), i), 1u);
-            uint32 LevelHeight = std::max(RenderUtils::GetMipDim(RHIImage->GetSizeY(), i), 1u);
-            
-            glm::vec2 TexelSize = glm::vec2(1.0f / float(LevelWidth), 1.0f / float(LevelHeight));
-        
-            uint32_t GroupsX = RenderUtils::GetGroupCount(LevelWidth, 32);
-            uint32_t GroupsY = RenderUtils::GetGroupCount(LevelHeight, 32);
-            uint32_t GroupsZ = 1;
-        
-            CommandList->SetPushConstants(&TexelSize, sizeof(glm::vec2));
-            CommandList->Dispatch(GroupsX, GroupsY, GroupsZ);
-
-            CommandList->CopyImage(RHIImage, FTextureSlice().SetMipLevel(i), StagingImage, FTextureSlice().SetMipLevel(i));
+            Options = *RequestedOptions;
         }
-        
-        CommandList->Close();
-        GRenderContext->ExecuteCommandList(CommandList, ECommandQueue::Compute);
-        
-        for (uint8 i = 0; i < ImageDescription.NumMips; ++i)
-        {
-            FTextureResource::FMip& Mip = NewTexture->TextureResource->Mips[i];
-            
-            size_t RowPitch = 0;
-            void* MappedMemory = GRenderContext->MapStagingTexture(StagingImage, FTextureSlice().SetMipLevel(i), ERHIAccess::HostRead, &RowPitch);
-            if (!MappedMemory)
-            {
-                continue;
-            }
-
-            const uint32 Width  = RenderUtils::GetMipDim(RHIImage->GetDescription().Extent.x, i);
-            const uint32 Height = RenderUtils::GetMipDim(RHIImage->GetDescription().Extent.y, i);
-
-            Mip.Width       = Width;
-            Mip.Height      = Height;
-            Mip.RowPitch    = RowPitch;
-            Mip.Depth       = 1;
-            Mip.SlicePitch  = 1;
-            
 
-            Mip.Pixels.resize(RowPitch * Height);
-            uint8* Dst = Mip.Pixels.data();
-            uint8* Src = (uint8*)MappedMemory;
-
-            for (uint32 Y = 0; Y < Height; ++Y)
-            {
-                Memory::Memcpy(Dst + Y * RowPitch, Src + Y * RowPitch, RowPitch);
-            }
+        const Import::Textures::ETextureImportType Type = Import::Textures::ResolveTextureType(RawPath, Result, Options.Type);
+        if (!Import::Textures::BuildTextureMips(Result, Type, Options, *NewTexture->TextureResource))
+        {
+            NewTexture->ForceDestroyNow();
+            return;
         }
 
-        GRenderContext->UnMapStagingTexture(StagingImage);
+        FRHIImageDesc& ImageDescription                         = NewTexture->TextureResource->ImageDescription;
+        ImageDescription.Flags                                  .SetFlag(EImageCreateFlags::ShaderResource);
+        ImageDescription.InitialState                           = EResourceStates::ShaderResource;
+        ImageDescription.bKeepInitialState                      = true;
         
-        CreatePackageThumbnail(NewTexture);
+        CreatePackageThumbnail(NewTexture, Result);
 
         CPackage* NewPackage = NewTexture->GetPackage();
         CPackage::SavePackage(NewPackage, NewPackage->GetPackagePath());
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Application.h"
 #include "Assets/AssetManager/AssetManager.h"
+#include "Core/Automation/AutomationTest.h"
 #include "Core/CommandLine/CommandLine.h"
 #include "Core/Module/ModuleManager.h"
 #include "Core/Windows/Window.h"
@@ -31,6 +32,19 @@ namespace Lumina
 
         EventProcessor.RegisterEventHandler(&FInputProcessor::Get());
         
+#if WITH_AUTOMATION_TESTS
+        // "--RunTests=<Filter>" runs the matching automation tests against the initialized engine and exits with their result.
+        if (TOptional<FFixedString> TestFilter = GCommandLine->Get("RunTests"))
+        {
+            const uint32 NumFailed = Automation::FTestRegistry::Get().Run(TestFilter.value());
+            
+            GEngine->Shutdown();
+            Shutdown();
+            
+            return NumFailed == 0 ? 0 : 1;
+        }
+#endif
+        
         //---------------------------------------------------------------
         // Core application loop.
         //--------------------------------------------------------------
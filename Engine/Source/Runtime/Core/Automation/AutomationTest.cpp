@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "AutomationTest.h"
+
+#include "EASTL/sort.h"
+#include "FileSystem/FileSystem.h"
+
+namespace Lumina::Automation
+{
+    bool FTestContext::Check(bool bCondition, const char* Expression, const char* File, int32 Line)
+    {
+        if (!bCondition)
+        {
+            ++NumFailures;
+            LOG_ERROR("[{}] Check failed: {} ({}:{})", Name, Expression, File, Line);
+        }
+        return bCondition;
+    }
+
+    FFixedString WriteScratchFile(FStringView FileName, FStringView Contents)
+    {
+        constexpr const char* ScratchDirectory = "/Engine/Cache/Automation";
+        VFS::CreateDir(ScratchDirectory);
+
+        FFixedString Path(ScratchDirectory);
+        Path.append("/");
+        Path.append(FileName.begin(), FileName.end());
+        
+        if (!VFS::WriteFile(Path, Contents))
+        {
+            LOG_ERROR("Automation - Failed to write scratch file {}", Path);
+        }
+        return Path;
+    }
+
+    FTestRegistry& FTestRegistry::Get()
+    {
+        static FTestRegistry Registry;
+        return Registry;
+    }
+
+    void FTestRegistry::Register(const char* Name, FTestFunction Function)
+    {
+        Tests.push_back(FTest{ Name, Function });
+    }
+
+    uint32 FTestRegistry::Run(FStringView Filter)
+    {
+        FFixedString LowerFilter(Filter.begin(), Filter.end());
+        LowerFilter.make_lower();
+        const bool bRunAll = LowerFilter.empty() || LowerFilter == "all";
+
+        eastl::sort(Tests.begin(), Tests.end(), [](const FTest& A, const FTest& B)
+        {
+            return strcmp(A.Name, B.Name) < 0;
+        });
+
+        uint32 NumRun = 0;
+        uint32 NumFailed = 0;
+        for (const FTest& Test : Tests)
+        {
+            FFixedString LowerName(Test.Name);
+            LowerName.make_lower();
+            if (!bRunAll && LowerName.find(LowerFilter.c_str()) == FFixedString::npos)
+            {
+                continue;
+            }
+
+            LOG_INFO("[{}] Running", Test.Name);
+
+            FTestContext Context;
+            Context.Name = Test.Name;
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            Test.Function(Context);
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            ++NumRun;
+            if (Context.GetNumFailures() != 0)
+            {
+                ++NumFailed;
+                LOG_ERROR("[{}] Failed with {} failed checks ({:.2f} ms)", Test.Name, Context.GetNumFailures(), Duration.count());
+            }
+            else
+            {
+                LOG_INFO("[{}] Passed ({:.2f} ms)", Test.Name, Duration.count());
+            }
+        }
+
+        LOG_INFO("Automation: {} of {} tests passed", NumRun - NumFailed, NumRun);
+        return NumFailed;
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/String.h"
+#include "Core/LuminaMacros.h"
+#include "Core/Console/ConsoleVariable.h"
+
+#ifndef WITH_AUTOMATION_TESTS
+    #define WITH_AUTOMATION_TESTS 0
+#endif
+
+namespace Lumina::Automation
+{
+    /** Handed to every test. A failed check is logged with its location and fails the test, the test keeps running. */
+    class RUNTIME_API FTestContext
+    {
+    public:
+
+        bool Check(bool bCondition, const char* Expression, const char* File, int32 Line);
+
+        const char* GetName() const { return Name; }
+        uint32 GetNumFailures() const { return NumFailures; }
+
+    private:
+
+        friend class FTestRegistry;
+
+        const char*     Name = nullptr;
+        uint32          NumFailures = 0;
+    };
+
+    using FTestFunction = void(*)(FTestContext&);
+
+    /**
+     * Tests register themselves at static initialization and are run after the engine initialized, with --RunTests=<Filter>.
+     * Benchmarks are plain tests that log their timings, named "Benchmark.*" so a filter can leave them out.
+     */
+    class RUNTIME_API FTestRegistry
+    {
+    public:
+
+        static FTestRegistry& Get();
+
+        void Register(const char* Name, FTestFunction Function);
+
+        /** Runs every test whose name contains Filter, ignoring case. An empty filter or "all" runs everything. Returns the number of tests that failed. */
+        uint32 Run(FStringView Filter);
+
+    private:
+
+        struct FTest
+        {
+            const char*     Name;
+            FTestFunction   Function;
+        };
+
+        TVector<FTest> Tests;
+    };
+
+    /** Writes Contents to a scratch file under the engine cache and returns its virtual path, for tests that need a file on disk. */
+    RUNTIME_API FFixedString WriteScratchFile(FStringView FileName, FStringView Contents);
+
+    /** Overrides a console variable for the length of a scope, the value it had before is put back afterwards. */
+    template<ValidConsoleVarType T>
+    class TScopedConsoleVariable
+    {
+    public:
+
+        TScopedConsoleVariable(FStringView InName, const T& Value)
+            : Name(InName)
+            , PreviousValue(FConsoleRegistry::Get().GetAs<T>(InName))
+        {
+            Set(Value);
+        }
+
+        ~TScopedConsoleVariable()
+        {
+            Set(PreviousValue);
+        }
+
+        LE_NO_COPYMOVE(TScopedConsoleVariable);
+
+        void Set(const T& Value) { FConsoleRegistry::Get().SetAs<T>(Name, Value); }
+
+    private:
+
+        FStringView     Name;
+        T               PreviousValue;
+    };
+
+    struct FTestRegistrar
+    {
+        FTestRegistrar(const char* Name, FTestFunction Function)
+        {
+            FTestRegistry::Get().Register(Name, Function);
+        }
+    };
+}
+
+#define LUMINA_AUTOMATION_TEST(Name) LUMINA_AUTOMATION_TEST_IMPL(Name, CAT(AutomationTest_, __LINE__))
+
+#define LUMINA_AUTOMATION_TEST_IMPL(Name, Function) \
+    static void Function(::Lumina::Automation::FTestContext& Test); \
+    static const ::Lumina::Automation::FTestRegistrar CAT(Function, _Registrar)(Name, &Function); \
+    static void Function(::Lumina::Automation::FTestContext& Test)
+
+#define TEST_CHECK(Expression) Test.Check(static_cast<bool>(Expression), #Expression, __FILE__, __LINE__)
@@ -1,6 +1,7 @@
 ﻿#include "pch.h"
 #include "Engine.h"
 #include "Assets/AssetRegistry/AssetRegistry.h"
+#include "Assets/AssetTypes/Textures/TextureStreaming.h"
 #include "Audio/AudioContext.h"
 #include "Config/Config.h"
 #include "Core/Application/Application.h"
@@ -45,6 +46,7 @@ namespace Lumina
         //-------------------------------------------------------------------------
         
         VFS::Mount<VFS::FNativeFileSystem>("/Engine", Paths::GetEngineDirectory());
+        VFS::MountPaks("/Engine", Paths::Combine(Paths::GetEngineDirectory(), "Paks"));
         
         FCoreDelegates::OnPreEngineInit.BroadcastAndClear();
         
@@ -92,6 +94,7 @@ namespace Lumina
         Memory::Delete(GWorldManager);
 		GWorldManager = nullptr;
         
+        FTextureStreamingManager::Get().Shutdown();
         ShutdownCObjectSystem();
         
         EngineViewport.SafeRelease();
@@ -133,6 +136,8 @@ namespace Lumina
                 MainThread::ProcessQueue();
                 
                 GRenderManager->FrameStart(UpdateContext);
+                
+                FTextureStreamingManager::Get().Update();
 
                 #if USING(WITH_EDITOR)
                 DeveloperToolUI->StartFrame(UpdateContext);
@@ -226,6 +231,7 @@ namespace Lumina
                 GRenderManager->FrameEnd(UpdateContext, RenderGraph);
                 
                 Scripting::FScriptingContext::Get().ProcessDeferredActions();
+                Scripting::FScriptingContext::Get().StepGC();
 
                 OnUpdateStage(UpdateContext);
 
@@ -309,6 +315,7 @@ namespace Lumina
         
         VFS::Mount<VFS::FNativeFileSystem>("/Game", GameDir);
         VFS::Mount<VFS::FNativeFileSystem>("/Config", ConfigDir);
+        VFS::MountPaks("/Game", Paths::Combine(ProjectPath, "Paks"));
 
         GConfig->LoadPath("/Config");
         
@@ -14,7 +14,7 @@ namespace Lumina
         enum ESide { LEFT = 0, RIGHT = 1, TOP = 2, BOTTOM = 3, BACK = 4, FRONT = 5, NUM = 6};
         TArray<glm::vec4, NUM> Planes;
 
-        NODISCARD bool IsInside(const glm::vec3& Point)
+        NODISCARD bool IsInside(const glm::vec3& Point) const
         {
             LUMINA_PROFILE_SCOPE();
             
@@ -30,7 +30,7 @@ namespace Lumina
             return true;
         }
 
-        NODISCARD bool IsInside(const FAABB& aabb)
+        NODISCARD bool IsInside(const FAABB& aabb) const
         {
             LUMINA_PROFILE_SCOPE();
 
@@ -55,6 +55,28 @@ namespace Lumina
             return true;
         }
 
+        /** Extracts the six normalized planes of a view projection matrix, works for standard and reverse depth alike. */
+        static FFrustum FromViewProjection(const glm::mat4& Matrix)
+        {
+            FFrustum Frustum = {};
+            for (int i = 0; i < 4; ++i)
+            {
+                Frustum.Planes[LEFT][i]     = Matrix[i].w + Matrix[i].x;
+                Frustum.Planes[RIGHT][i]    = Matrix[i].w - Matrix[i].x;
+                Frustum.Planes[TOP][i]      = Matrix[i].w - Matrix[i].y;
+                Frustum.Planes[BOTTOM][i]   = Matrix[i].w + Matrix[i].y;
+                Frustum.Planes[BACK][i]     = Matrix[i].w + Matrix[i].z;
+                Frustum.Planes[FRONT][i]    = Matrix[i].w - Matrix[i].z;
+            }
+
+            for (int i = 0; i < NUM; i++)
+            {
+                Frustum.Planes[i] /= glm::length(glm::vec3(Frustum.Planes[i]));
+            }
+
+            return Frustum;
+        }
+
         static void ComputeFrustumCorners(const glm::mat4& ViewProjection, glm::vec3 OutCorners[8])
         {
             LUMINA_PROFILE_SCOPE();
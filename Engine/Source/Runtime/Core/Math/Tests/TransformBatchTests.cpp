@@ -0,0 +1,263 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Core/Math/AABB.h"
+#include "Core/Math/Transform.h"
+#include "Core/Math/TransformBatch.h"
+#include <glm/gtx/component_wise.hpp>
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Batch sizes around the 4 and 8 wide lanes, so every remainder path runs. */
+        constexpr size_t BatchSizes[] = { 1, 3, 4, 7, 8, 9, 17, 64 };
+
+        /** Small deterministic generator, the kernels are compared on the same inputs every run. */
+        struct FRandomStream
+        {
+            uint32 State = 0x9E3779B9u;
+
+            float Range(float Min, float Max)
+            {
+                State = State * 1664525u + 1013904223u;
+                return Min + (Max - Min) * static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+            }
+
+            glm::vec3 Vector(float Min, float Max)
+            {
+                return glm::vec3(Range(Min, Max), Range(Min, Max), Range(Min, Max));
+            }
+        };
+
+        /** Random transforms with the edge cases mixed in: identity, zero and negative scale, large and tiny translation. */
+        TVector<FTransform> MakeTransforms(size_t Num)
+        {
+            FRandomStream Random;
+            TVector<FTransform> Transforms(Num);
+            for (size_t i = 0; i < Num; ++i)
+            {
+                FTransform& Transform = Transforms[i];
+                switch (i % 6)
+                {
+                    case 0: Transform = FTransform(); break;
+                    case 1: Transform.Scale = glm::vec3(0.0f, Random.Range(0.1f, 2.0f), 0.0f); break;
+                    case 2: Transform.Scale = glm::vec3(-1.0f, Random.Range(0.1f, 2.0f), -Random.Range(0.1f, 2.0f)); break;
+                    case 3: Transform.Location = Random.Vector(-1e5f, 1e5f); break;
+                    case 4: Transform.Location = Random.Vector(-1e-4f, 1e-4f); break;
+                    default: Transform.Location = Random.Vector(-100.0f, 100.0f); Transform.Scale = Random.Vector(0.01f, 10.0f); break;
+                }
+
+                if (i % 6 != 0)
+                {
+                    Transform.Rotation = glm::normalize(glm::quat(Random.Range(-1.0f, 1.0f), Random.Vector(-1.0f, 1.0f)));
+                }
+            }
+            return Transforms;
+        }
+
+        /** Relative to the largest element, a term near zero may still carry the rounding of the large ones summed into it. */
+        constexpr float Epsilon = 1e-5f;
+
+        bool NearlyEqual(const glm::vec3& A, const glm::vec3& B)
+        {
+            const float Scale = glm::max(1.0f, glm::max(glm::compMax(glm::abs(A)), glm::compMax(glm::abs(B))));
+            return glm::all(glm::lessThanEqual(glm::abs(A - B), glm::vec3(Epsilon * Scale)));
+        }
+
+        bool NearlyEqual(const glm::mat4& A, const glm::mat4& B)
+        {
+            float Scale = 1.0f;
+            for (glm::length_t Column = 0; Column < 4; ++Column)
+            {
+                Scale = glm::max(Scale, glm::max(glm::compMax(glm::abs(A[Column])), glm::compMax(glm::abs(B[Column]))));
+            }
+
+            for (glm::length_t Column = 0; Column < 4; ++Column)
+            {
+                if (!glm::all(glm::lessThanEqual(glm::abs(A[Column] - B[Column]), glm::vec4(Epsilon * Scale))))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /** Runs Func once on the scalar kernels and once on the kernels picked for this CPU. */
+        template<typename TFunc>
+        void ForEachTransformPath(TFunc&& Func)
+        {
+            ForEachConsoleToggle("Core.SIMDTransforms", [&](bool)
+            {
+                Func(Math::GetSIMDPathName(Math::GetTransformBatchPath()));
+            });
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Core.Math.TransformBatch.ComposeMatchesGLM")
+    {
+        ForEachTransformPath([&](const char*)
+        {
+            for (size_t Num : BatchSizes)
+            {
+                const TVector<FTransform> Transforms = MakeTransforms(Num);
+
+                TVector<glm::vec3> Locations, Scales;
+                TVector<glm::quat> Rotations;
+                for (const FTransform& Transform : Transforms)
+                {
+                    Locations.push_back(Transform.Location);
+                    Rotations.push_back(Transform.Rotation);
+                    Scales.push_back(Transform.Scale);
+                }
+
+                TVector<glm::mat4> Matrices(Num);
+                Math::ComposeTransforms(Locations.data(), Rotations.data(), Scales.data(), Matrices.data(), Num);
+
+                uint32 NumMismatched = 0;
+                for (size_t i = 0; i < Num; ++i)
+                {
+                    NumMismatched += !NearlyEqual(Matrices[i], Transforms[i].GetMatrix());
+                }
+                TEST_CHECK(NumMismatched == 0);
+            }
+        });
+    }
+
+    LUMINA_AUTOMATION_TEST("Core.Math.TransformBatch.MultiplyMatchesGLM")
+    {
+        ForEachTransformPath([&](const char*)
+        {
+            for (size_t Num : BatchSizes)
+            {
+                const TVector<FTransform> Transforms = MakeTransforms(Num * 2);
+
+                TVector<glm::mat4> Parents, Children, Expected;
+                for (size_t i = 0; i < Num; ++i)
+                {
+                    Parents.push_back(Transforms[i].GetMatrix());
+                    Children.push_back(Transforms[Num + i].GetMatrix());
+                    Expected.push_back(Parents.back() * Children.back());
+                }
+
+                TVector<glm::mat4> Matrices(Num);
+                Math::MultiplyMatrices(Parents.data(), Children.data(), Matrices.data(), Num);
+
+                // The transform system multiplies in place, onto the children.
+                Math::MultiplyMatrices(Parents.data(), Children.data(), Children.data(), Num);
+
+                uint32 NumMismatched = 0;
+                for (size_t i = 0; i < Num; ++i)
+                {
+                    NumMismatched += !NearlyEqual(Matrices[i], Expected[i]);
+                    NumMismatched += !NearlyEqual(Children[i], Expected[i]);
+                }
+                TEST_CHECK(NumMismatched == 0);
+            }
+        });
+    }
+
+    LUMINA_AUTOMATION_TEST("Core.Math.TransformBatch.AABBsMatchGLM")
+    {
+        ForEachTransformPath([&](const char*)
+        {
+            for (size_t Num : BatchSizes)
+            {
+                const TVector<FTransform> Transforms = MakeTransforms(Num);
+
+                FRandomStream Random;
+                TVector<FAABB> Boxes;
+                TVector<glm::mat4> Matrices;
+                for (size_t i = 0; i < Num; ++i)
+                {
+                    // Flat and point boxes are as valid as solid ones.
+                    const glm::vec3 Min = Random.Vector(-10.0f, 10.0f);
+                    const glm::vec3 Extent = (i % 3 == 0) ? glm::vec3(0.0f) : (i % 3 == 1) ? glm::vec3(Random.Range(0.0f, 5.0f), 0.0f, 1.0f) : Random.Vector(0.0f, 5.0f);
+                    Boxes.emplace_back(Min, Min + Extent);
+                    Matrices.push_back(Transforms[i].GetMatrix());
+                }
+
+                TVector<FAABB> WorldBoxes(Num);
+                Math::TransformAABBs(Boxes.data(), Matrices.data(), WorldBoxes.data(), Num);
+
+                uint32 NumMismatched = 0;
+                for (size_t i = 0; i < Num; ++i)
+                {
+                    const FAABB Expected = Boxes[i].ToWorld(Matrices[i]);
+                    NumMismatched += !NearlyEqual(WorldBoxes[i].Min, Expected.Min) || !NearlyEqual(WorldBoxes[i].Max, Expected.Max);
+                }
+
+                // Aliased in place, the way the render scene resolves its bounds.
+                Math::TransformAABBs(Boxes.data(), Matrices.data(), Boxes.data(), Num);
+                for (size_t i = 0; i < Num; ++i)
+                {
+                    NumMismatched += !NearlyEqual(Boxes[i].Min, WorldBoxes[i].Min) || !NearlyEqual(Boxes[i].Max, WorldBoxes[i].Max);
+                }
+                TEST_CHECK(NumMismatched == 0);
+            }
+        });
+    }
+
+    // Compose, parent multiply and bounds of 100k transforms, the glm path against the scalar and SIMD kernels.
+    LUMINA_AUTOMATION_TEST("Benchmark.Core.TransformBatch")
+    {
+        constexpr size_t Num = 100'000;
+        constexpr uint32 NumRuns = 10;
+
+        const TVector<FTransform> Transforms = MakeTransforms(Num);
+        const glm::mat4 Parent = Transforms[Num / 2].GetMatrix();
+        const FAABB LocalBox(glm::vec3(-1.0f), glm::vec3(1.0f));
+
+        TVector<glm::vec3> Locations, Scales;
+        TVector<glm::quat> Rotations;
+        for (const FTransform& Transform : Transforms)
+        {
+            Locations.push_back(Transform.Location);
+            Rotations.push_back(Transform.Rotation);
+            Scales.push_back(Transform.Scale);
+        }
+
+        const TVector<glm::mat4> Parents(Num, Parent);
+        const TVector<FAABB> LocalBoxes(Num, LocalBox);
+        TVector<glm::mat4> Matrices(Num);
+        TVector<FAABB> Boxes(Num);
+
+        auto Time = [&](const char* Label, auto&& Func)
+        {
+            const auto Start = std::chrono::high_resolution_clock::now();
+            for (uint32 Run = 0; Run < NumRuns; ++Run)
+            {
+                Func();
+            }
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            LOG_INFO("[{}] {} transforms, {}: {:.3f} ms", Test.GetName(), Num, Label, Duration.count() / NumRuns);
+        };
+
+        Time("glm", [&]
+        {
+            for (size_t i = 0; i < Num; ++i)
+            {
+                Matrices[i] = Parent * Transforms[i].GetMatrix();
+                Boxes[i] = LocalBox.ToWorld(Matrices[i]);
+            }
+        });
+        const glm::mat4 Reference = Matrices[Num - 1];
+
+        ForEachTransformPath([&](const char* PathName)
+        {
+            Time(PathName, [&]
+            {
+                Math::ComposeTransforms(Locations.data(), Rotations.data(), Scales.data(), Matrices.data(), Num);
+                Math::MultiplyMatrices(Parents.data(), Matrices.data(), Matrices.data(), Num);
+                Math::TransformAABBs(LocalBoxes.data(), Matrices.data(), Boxes.data(), Num);
+            });
+
+            TEST_CHECK(NearlyEqual(Matrices[Num - 1], Reference));
+        });
+    }
+}
+
+#endif
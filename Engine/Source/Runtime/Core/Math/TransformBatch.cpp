@@ -0,0 +1,456 @@
+#include "pch.h"
+#include "TransformBatch.h"
+#include "AABB.h"
+#include "Core/Console/ConsoleVariable.h"
+
+#if defined(LUMINA_PLATFORM_CPU_X86_64)
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define LUMINA_TARGET_AVX2
+    #else
+        #include <cpuid.h>
+        #define LUMINA_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+namespace Lumina::Math
+{
+    static TConsoleVar CVarSIMDTransforms("Core.SIMDTransforms", true, "Use the SIMD batched transform kernels, disable to fall back to the scalar path for comparison.");
+
+    namespace
+    {
+        //========================================================================================================================
+        // Scalar
+        //========================================================================================================================
+
+        FORCEINLINE void ComposeTransformScalar(const glm::vec3& T, const glm::quat& Q, const glm::vec3& S, glm::mat4& Out)
+        {
+            const float XX = Q.x * Q.x, YY = Q.y * Q.y, ZZ = Q.z * Q.z;
+            const float XY = Q.x * Q.y, XZ = Q.x * Q.z, YZ = Q.y * Q.z;
+            const float WX = Q.w * Q.x, WY = Q.w * Q.y, WZ = Q.w * Q.z;
+
+            Out[0] = glm::vec4((1.0f - 2.0f * (YY + ZZ)) * S.x, 2.0f * (XY + WZ) * S.x, 2.0f * (XZ - WY) * S.x, 0.0f);
+            Out[1] = glm::vec4(2.0f * (XY - WZ) * S.y, (1.0f - 2.0f * (XX + ZZ)) * S.y, 2.0f * (YZ + WX) * S.y, 0.0f);
+            Out[2] = glm::vec4(2.0f * (XZ + WY) * S.z, 2.0f * (YZ - WX) * S.z, (1.0f - 2.0f * (XX + YY)) * S.z, 0.0f);
+            Out[3] = glm::vec4(T, 1.0f);
+        }
+
+        FORCEINLINE void TransformAABBScalar(const FAABB& Box, const glm::mat4& M, FAABB& Out)
+        {
+            const glm::vec3 Center = (Box.Min + Box.Max) * 0.5f;
+            const glm::vec3 Extent = (Box.Max - Box.Min) * 0.5f;
+
+            const glm::vec3 NewCenter = glm::vec3(M[0]) * Center.x + glm::vec3(M[1]) * Center.y + glm::vec3(M[2]) * Center.z + glm::vec3(M[3]);
+            const glm::vec3 NewExtent = glm::abs(glm::vec3(M[0])) * Extent.x + glm::abs(glm::vec3(M[1])) * Extent.y + glm::abs(glm::vec3(M[2])) * Extent.z;
+
+            Out = FAABB(NewCenter - NewExtent, NewCenter + NewExtent);
+        }
+
+        void ComposeTransforms_Scalar(const glm::vec3* Locations, const glm::quat* Rotations, const glm::vec3* Scales, glm::mat4* OutMatrices, size_t Num)
+        {
+            for (size_t i = 0; i < Num; ++i)
+            {
+                ComposeTransformScalar(Locations[i], Rotations[i], Scales[i], OutMatrices[i]);
+            }
+        }
+
+        void MultiplyMatrices_Scalar(const glm::mat4* Parents, const glm::mat4* Children, glm::mat4* OutMatrices, size_t Num)
+        {
+            for (size_t i = 0; i < Num; ++i)
+            {
+                OutMatrices[i] = Parents[i] * Children[i];
+            }
+        }
+
+        void TransformAABBs_Scalar(const FAABB* Boxes, const glm::mat4* Matrices, FAABB* OutBoxes, size_t Num)
+        {
+            for (size_t i = 0; i < Num; ++i)
+            {
+                TransformAABBScalar(Boxes[i], Matrices[i], OutBoxes[i]);
+            }
+        }
+
+        #if defined(LUMINA_PLATFORM_CPU_X86_64)
+
+        //========================================================================================================================
+        // SSE
+        //========================================================================================================================
+
+        /** Rotation and scale columns for four transforms, lane N belongs to transform N. */
+        struct FComposeLanesSSE
+        {
+            __m128 C0[3], C1[3], C2[3], T[3];
+        };
+
+        FORCEINLINE void BuildComposeLanesSSE(const glm::vec3* L, const glm::quat* Q, const glm::vec3* S, FComposeLanesSSE& Lanes)
+        {
+            const __m128 X  = _mm_setr_ps(Q[0].x, Q[1].x, Q[2].x, Q[3].x);
+            const __m128 Y  = _mm_setr_ps(Q[0].y, Q[1].y, Q[2].y, Q[3].y);
+            const __m128 Z  = _mm_setr_ps(Q[0].z, Q[1].z, Q[2].z, Q[3].z);
+            const __m128 W  = _mm_setr_ps(Q[0].w, Q[1].w, Q[2].w, Q[3].w);
+            const __m128 SX = _mm_setr_ps(S[0].x, S[1].x, S[2].x, S[3].x);
+            const __m128 SY = _mm_setr_ps(S[0].y, S[1].y, S[2].y, S[3].y);
+            const __m128 SZ = _mm_setr_ps(S[0].z, S[1].z, S[2].z, S[3].z);
+
+            const __m128 One = _mm_set1_ps(1.0f);
+            const __m128 Two = _mm_set1_ps(2.0f);
+
+            const __m128 XX = _mm_mul_ps(X, X), YY = _mm_mul_ps(Y, Y), ZZ = _mm_mul_ps(Z, Z);
+            const __m128 XY = _mm_mul_ps(X, Y), XZ = _mm_mul_ps(X, Z), YZ = _mm_mul_ps(Y, Z);
+            const __m128 WX = _mm_mul_ps(W, X), WY = _mm_mul_ps(W, Y), WZ = _mm_mul_ps(W, Z);
+
+            Lanes.C0[0] = _mm_mul_ps(_mm_sub_ps(One, _mm_mul_ps(Two, _mm_add_ps(YY, ZZ))), SX);
+            Lanes.C0[1] = _mm_mul_ps(_mm_mul_ps(Two, _mm_add_ps(XY, WZ)), SX);
+            Lanes.C0[2] = _mm_mul_ps(_mm_mul_ps(Two, _mm_sub_ps(XZ, WY)), SX);
+
+            Lanes.C1[0] = _mm_mul_ps(_mm_mul_ps(Two, _mm_sub_ps(XY, WZ)), SY);
+            Lanes.C1[1] = _mm_mul_ps(_mm_sub_ps(One, _mm_mul_ps(Two, _mm_add_ps(XX, ZZ))), SY);
+            Lanes.C1[2] = _mm_mul_ps(_mm_mul_ps(Two, _mm_add_ps(YZ, WX)), SY);
+
+            Lanes.C2[0] = _mm_mul_ps(_mm_mul_ps(Two, _mm_add_ps(XZ, WY)), SZ);
+            Lanes.C2[1] = _mm_mul_ps(_mm_mul_ps(Two, _mm_sub_ps(YZ, WX)), SZ);
+            Lanes.C2[2] = _mm_mul_ps(_mm_sub_ps(One, _mm_mul_ps(Two, _mm_add_ps(XX, YY))), SZ);
+
+            Lanes.T[0] = _mm_setr_ps(L[0].x, L[1].x, L[2].x, L[3].x);
+            Lanes.T[1] = _mm_setr_ps(L[0].y, L[1].y, L[2].y, L[3].y);
+            Lanes.T[2] = _mm_setr_ps(L[0].z, L[1].z, L[2].z, L[3].z);
+        }
+
+        /** Transposes one column of four transforms from lane form back into four matrices. */
+        FORCEINLINE void StoreColumnSSE(const __m128 (&Column)[3], __m128 Fourth, glm::mat4* Out, int ColumnIndex)
+        {
+            __m128 R0 = Column[0], R1 = Column[1], R2 = Column[2], R3 = Fourth;
+            _MM_TRANSPOSE4_PS(R0, R1, R2, R3);
+
+            _mm_storeu_ps(&Out[0][ColumnIndex].x, R0);
+            _mm_storeu_ps(&Out[1][ColumnIndex].x, R1);
+            _mm_storeu_ps(&Out[2][ColumnIndex].x, R2);
+            _mm_storeu_ps(&Out[3][ColumnIndex].x, R3);
+        }
+
+        FORCEINLINE void StoreComposeLanesSSE(const FComposeLanesSSE& Lanes, glm::mat4* Out)
+        {
+            StoreColumnSSE(Lanes.C0, _mm_setzero_ps(), Out, 0);
+            StoreColumnSSE(Lanes.C1, _mm_setzero_ps(), Out, 1);
+            StoreColumnSSE(Lanes.C2, _mm_setzero_ps(), Out, 2);
+            StoreColumnSSE(Lanes.T, _mm_set1_ps(1.0f), Out, 3);
+        }
+
+        void ComposeTransforms_SSE(const glm::vec3* Locations, const glm::quat* Rotations, const glm::vec3* Scales, glm::mat4* OutMatrices, size_t Num)
+        {
+            size_t i = 0;
+            for (; i + 4 <= Num; i += 4)
+            {
+                FComposeLanesSSE Lanes;
+                BuildComposeLanesSSE(Locations + i, Rotations + i, Scales + i, Lanes);
+                StoreComposeLanesSSE(Lanes, OutMatrices + i);
+            }
+
+            ComposeTransforms_Scalar(Locations + i, Rotations + i, Scales + i, OutMatrices + i, Num - i);
+        }
+
+        void MultiplyMatrices_SSE(const glm::mat4* Parents, const glm::mat4* Children, glm::mat4* OutMatrices, size_t Num)
+        {
+            for (size_t i = 0; i < Num; ++i)
+            {
+                const __m128 P0 = _mm_loadu_ps(&Parents[i][0].x);
+                const __m128 P1 = _mm_loadu_ps(&Parents[i][1].x);
+                const __m128 P2 = _mm_loadu_ps(&Parents[i][2].x);
+                const __m128 P3 = _mm_loadu_ps(&Parents[i][3].x);
+
+                for (int Column = 0; Column < 4; ++Column)
+                {
+                    const __m128 C = _mm_loadu_ps(&Children[i][Column].x);
+
+                    __m128 R = _mm_mul_ps(P0, _mm_shuffle_ps(C, C, _MM_SHUFFLE(0, 0, 0, 0)));
+                    R = _mm_add_ps(R, _mm_mul_ps(P1, _mm_shuffle_ps(C, C, _MM_SHUFFLE(1, 1, 1, 1))));
+                    R = _mm_add_ps(R, _mm_mul_ps(P2, _mm_shuffle_ps(C, C, _MM_SHUFFLE(2, 2, 2, 2))));
+                    R = _mm_add_ps(R, _mm_mul_ps(P3, _mm_shuffle_ps(C, C, _MM_SHUFFLE(3, 3, 3, 3))));
+
+                    _mm_storeu_ps(&OutMatrices[i][Column].x, R);
+                }
+            }
+        }
+
+        FORCEINLINE void StoreAABBSSE(__m128 Min, __m128 Max, FAABB& Out)
+        {
+            alignas(16) float MinValues[4];
+            alignas(16) float MaxValues[4];
+            _mm_store_ps(MinValues, Min);
+            _mm_store_ps(MaxValues, Max);
+
+            Out.Min = glm::vec3(MinValues[0], MinValues[1], MinValues[2]);
+            Out.Max = glm::vec3(MaxValues[0], MaxValues[1], MaxValues[2]);
+        }
+
+        void TransformAABBs_SSE(const FAABB* Boxes, const glm::mat4* Matrices, FAABB* OutBoxes, size_t Num)
+        {
+            const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            const __m128 Half = _mm_set1_ps(0.5f);
+
+            for (size_t i = 0; i < Num; ++i)
+            {
+                const FAABB& Box = Boxes[i];
+                const __m128 Min = _mm_setr_ps(Box.Min.x, Box.Min.y, Box.Min.z, 0.0f);
+                const __m128 Max = _mm_setr_ps(Box.Max.x, Box.Max.y, Box.Max.z, 0.0f);
+                const __m128 Center = _mm_mul_ps(_mm_add_ps(Min, Max), Half);
+                const __m128 Extent = _mm_mul_ps(_mm_sub_ps(Max, Min), Half);
+
+                const __m128 M0 = _mm_loadu_ps(&Matrices[i][0].x);
+                const __m128 M1 = _mm_loadu_ps(&Matrices[i][1].x);
+                const __m128 M2 = _mm_loadu_ps(&Matrices[i][2].x);
+                const __m128 M3 = _mm_loadu_ps(&Matrices[i][3].x);
+
+                __m128 NewCenter = _mm_add_ps(M3, _mm_mul_ps(M0, _mm_shuffle_ps(Center, Center, _MM_SHUFFLE(0, 0, 0, 0))));
+                NewCenter = _mm_add_ps(NewCenter, _mm_mul_ps(M1, _mm_shuffle_ps(Center, Center, _MM_SHUFFLE(1, 1, 1, 1))));
+                NewCenter = _mm_add_ps(NewCenter, _mm_mul_ps(M2, _mm_shuffle_ps(Center, Center, _MM_SHUFFLE(2, 2, 2, 2))));
+
+                __m128 NewExtent = _mm_mul_ps(_mm_and_ps(M0, AbsMask), _mm_shuffle_ps(Extent, Extent, _MM_SHUFFLE(0, 0, 0, 0)));
+                NewExtent = _mm_add_ps(NewExtent, _mm_mul_ps(_mm_and_ps(M1, AbsMask), _mm_shuffle_ps(Extent, Extent, _MM_SHUFFLE(1, 1, 1, 1))));
+                NewExtent = _mm_add_ps(NewExtent, _mm_mul_ps(_mm_and_ps(M2, AbsMask), _mm_shuffle_ps(Extent, Extent, _MM_SHUFFLE(2, 2, 2, 2))));
+
+                StoreAABBSSE(_mm_sub_ps(NewCenter, NewExtent), _mm_add_ps(NewCenter, NewExtent), OutBoxes[i]);
+            }
+        }
+
+        //========================================================================================================================
+        // AVX2
+        //========================================================================================================================
+
+        LUMINA_TARGET_AVX2 void ComposeTransforms_AVX2(const glm::vec3* Locations, const glm::quat* Rotations, const glm::vec3* Scales, glm::mat4* OutMatrices, size_t Num)
+        {
+            size_t i = 0;
+            for (; i + 8 <= Num; i += 8)
+            {
+                const glm::quat* Q = Rotations + i;
+                const glm::vec3* S = Scales + i;
+                const glm::vec3* L = Locations + i;
+
+                const __m256 X  = _mm256_setr_ps(Q[0].x, Q[1].x, Q[2].x, Q[3].x, Q[4].x, Q[5].x, Q[6].x, Q[7].x);
+                const __m256 Y  = _mm256_setr_ps(Q[0].y, Q[1].y, Q[2].y, Q[3].y, Q[4].y, Q[5].y, Q[6].y, Q[7].y);
+                const __m256 Z  = _mm256_setr_ps(Q[0].z, Q[1].z, Q[2].z, Q[3].z, Q[4].z, Q[5].z, Q[6].z, Q[7].z);
+                const __m256 W  = _mm256_setr_ps(Q[0].w, Q[1].w, Q[2].w, Q[3].w, Q[4].w, Q[5].w, Q[6].w, Q[7].w);
+                const __m256 SX = _mm256_setr_ps(S[0].x, S[1].x, S[2].x, S[3].x, S[4].x, S[5].x, S[6].x, S[7].x);
+                const __m256 SY = _mm256_setr_ps(S[0].y, S[1].y, S[2].y, S[3].y, S[4].y, S[5].y, S[6].y, S[7].y);
+                const __m256 SZ = _mm256_setr_ps(S[0].z, S[1].z, S[2].z, S[3].z, S[4].z, S[5].z, S[6].z, S[7].z);
+
+                const __m256 One = _mm256_set1_ps(1.0f);
+                const __m256 Two = _mm256_set1_ps(2.0f);
+
+                const __m256 XX = _mm256_mul_ps(X, X), YY = _mm256_mul_ps(Y, Y), ZZ = _mm256_mul_ps(Z, Z);
+                const __m256 XY = _mm256_mul_ps(X, Y), XZ = _mm256_mul_ps(X, Z), YZ = _mm256_mul_ps(Y, Z);
+                const __m256 WX = _mm256_mul_ps(W, X), WY = _mm256_mul_ps(W, Y), WZ = _mm256_mul_ps(W, Z);
+
+                const __m256 Columns[4][3] =
+                {
+                    {
+                        _mm256_mul_ps(_mm256_sub_ps(One, _mm256_mul_ps(Two, _mm256_add_ps(YY, ZZ))), SX),
+                        _mm256_mul_ps(_mm256_mul_ps(Two, _mm256_add_ps(XY, WZ)), SX),
+                        _mm256_mul_ps(_mm256_mul_ps(Two, _mm256_sub_ps(XZ, WY)), SX),
+                    },
+                    {
+                        _mm256_mul_ps(_mm256_mul_ps(Two, _mm256_sub_ps(XY, WZ)), SY),
+                        _mm256_mul_ps(_mm256_sub_ps(One, _mm256_mul_ps(Two, _mm256_add_ps(XX, ZZ))), SY),
+                        _mm256_mul_ps(_mm256_mul_ps(Two, _mm256_add_ps(YZ, WX)), SY),
+                    },
+                    {
+                        _mm256_mul_ps(_mm256_mul_ps(Two, _mm256_add_ps(XZ, WY)), SZ),
+                        _mm256_mul_ps(_mm256_mul_ps(Two, _mm256_sub_ps(YZ, WX)), SZ),
+                        _mm256_mul_ps(_mm256_sub_ps(One, _mm256_mul_ps(Two, _mm256_add_ps(XX, YY))), SZ),
+                    },
+                    {
+                        _mm256_setr_ps(L[0].x, L[1].x, L[2].x, L[3].x, L[4].x, L[5].x, L[6].x, L[7].x),
+                        _mm256_setr_ps(L[0].y, L[1].y, L[2].y, L[3].y, L[4].y, L[5].y, L[6].y, L[7].y),
+                        _mm256_setr_ps(L[0].z, L[1].z, L[2].z, L[3].z, L[4].z, L[5].z, L[6].z, L[7].z),
+                    },
+                };
+
+                // Each 128-bit half holds four transforms, transpose them out with the SSE path.
+                for (int Column = 0; Column < 4; ++Column)
+                {
+                    const __m128 Fourth = Column == 3 ? _mm_set1_ps(1.0f) : _mm_setzero_ps();
+
+                    const __m128 Low[3]  = { _mm256_castps256_ps128(Columns[Column][0]), _mm256_castps256_ps128(Columns[Column][1]), _mm256_castps256_ps128(Columns[Column][2]) };
+                    const __m128 High[3] = { _mm256_extractf128_ps(Columns[Column][0], 1), _mm256_extractf128_ps(Columns[Column][1], 1), _mm256_extractf128_ps(Columns[Column][2], 1) };
+
+                    StoreColumnSSE(Low, Fourth, OutMatrices + i, Column);
+                    StoreColumnSSE(High, Fourth, OutMatrices + i + 4, Column);
+                }
+            }
+
+            ComposeTransforms_SSE(Locations + i, Rotations + i, Scales + i, OutMatrices + i, Num - i);
+        }
+
+        LUMINA_TARGET_AVX2 void MultiplyMatrices_AVX2(const glm::mat4* Parents, const glm::mat4* Children, glm::mat4* OutMatrices, size_t Num)
+        {
+            for (size_t i = 0; i < Num; ++i)
+            {
+                // Both halves hold the same parent column, so two child columns are resolved per multiply.
+                const __m256 P0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&Parents[i][0].x));
+                const __m256 P1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&Parents[i][1].x));
+                const __m256 P2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&Parents[i][2].x));
+                const __m256 P3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&Parents[i][3].x));
+
+                for (int Column = 0; Column < 4; Column += 2)
+                {
+                    const __m256 C = _mm256_loadu_ps(&Children[i][Column].x);
+
+                    __m256 R = _mm256_mul_ps(P0, _mm256_shuffle_ps(C, C, _MM_SHUFFLE(0, 0, 0, 0)));
+                    R = _mm256_add_ps(R, _mm256_mul_ps(P1, _mm256_shuffle_ps(C, C, _MM_SHUFFLE(1, 1, 1, 1))));
+                    R = _mm256_add_ps(R, _mm256_mul_ps(P2, _mm256_shuffle_ps(C, C, _MM_SHUFFLE(2, 2, 2, 2))));
+                    R = _mm256_add_ps(R, _mm256_mul_ps(P3, _mm256_shuffle_ps(C, C, _MM_SHUFFLE(3, 3, 3, 3))));
+
+                    _mm256_storeu_ps(&OutMatrices[i][Column].x, R);
+                }
+            }
+        }
+
+        FORCEINLINE LUMINA_TARGET_AVX2 __m256 LoadColumnPairAVX2(const glm::vec4& A, const glm::vec4& B)
+        {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&A.x)), _mm_loadu_ps(&B.x), 1);
+        }
+
+        LUMINA_TARGET_AVX2 void TransformAABBs_AVX2(const FAABB* Boxes, const glm::mat4* Matrices, FAABB* OutBoxes, size_t Num)
+        {
+            const __m256 AbsMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            const __m256 Half = _mm256_set1_ps(0.5f);
+
+            size_t i = 0;
+            for (; i + 2 <= Num; i += 2)
+            {
+                const FAABB& A = Boxes[i];
+                const FAABB& B = Boxes[i + 1];
+
+                const __m256 Min = _mm256_setr_ps(A.Min.x, A.Min.y, A.Min.z, 0.0f, B.Min.x, B.Min.y, B.Min.z, 0.0f);
+                const __m256 Max = _mm256_setr_ps(A.Max.x, A.Max.y, A.Max.z, 0.0f, B.Max.x, B.Max.y, B.Max.z, 0.0f);
+                const __m256 Center = _mm256_mul_ps(_mm256_add_ps(Min, Max), Half);
+                const __m256 Extent = _mm256_mul_ps(_mm256_sub_ps(Max, Min), Half);
+
+                const __m256 M0 = LoadColumnPairAVX2(Matrices[i][0], Matrices[i + 1][0]);
+                const __m256 M1 = LoadColumnPairAVX2(Matrices[i][1], Matrices[i + 1][1]);
+                const __m256 M2 = LoadColumnPairAVX2(Matrices[i][2], Matrices[i + 1][2]);
+                const __m256 M3 = LoadColumnPairAVX2(Matrices[i][3], Matrices[i + 1][3]);
+
+                __m256 NewCenter = _mm256_add_ps(M3, _mm256_mul_ps(M0, _mm256_shuffle_ps(Center, Center, _MM_SHUFFLE(0, 0, 0, 0))));
+                NewCenter = _mm256_add_ps(NewCenter, _mm256_mul_ps(M1, _mm256_shuffle_ps(Center, Center, _MM_SHUFFLE(1, 1, 1, 1))));
+                NewCenter = _mm256_add_ps(NewCenter, _mm256_mul_ps(M2, _mm256_shuffle_ps(Center, Center, _MM_SHUFFLE(2, 2, 2, 2))));
+
+                __m256 NewExtent = _mm256_mul_ps(_mm256_and_ps(M0, AbsMask), _mm256_shuffle_ps(Extent, Extent, _MM_SHUFFLE(0, 0, 0, 0)));
+                NewExtent = _mm256_add_ps(NewExtent, _mm256_mul_ps(_mm256_and_ps(M1, AbsMask), _mm256_shuffle_ps(Extent, Extent, _MM_SHUFFLE(1, 1, 1, 1))));
+                NewExtent = _mm256_add_ps(NewExtent, _mm256_mul_ps(_mm256_and_ps(M2, AbsMask), _mm256_shuffle_ps(Extent, Extent, _MM_SHUFFLE(2, 2, 2, 2))));
+
+                const __m256 NewMin = _mm256_sub_ps(NewCenter, NewExtent);
+                const __m256 NewMax = _mm256_add_ps(NewCenter, NewExtent);
+
+                StoreAABBSSE(_mm256_castps256_ps128(NewMin), _mm256_castps256_ps128(NewMax), OutBoxes[i]);
+                StoreAABBSSE(_mm256_extractf128_ps(NewMin, 1), _mm256_extractf128_ps(NewMax, 1), OutBoxes[i + 1]);
+            }
+
+            TransformAABBs_SSE(Boxes + i, Matrices + i, OutBoxes + i, Num - i);
+        }
+
+        //========================================================================================================================
+        // Feature detection
+        //========================================================================================================================
+
+        bool IsAVX2Supported()
+        {
+            uint32 Leaf1[4] = {};
+            uint32 Leaf7[4] = {};
+
+            #if defined(_MSC_VER)
+            __cpuid(reinterpret_cast<int*>(Leaf1), 1);
+            __cpuidex(reinterpret_cast<int*>(Leaf7), 7, 0);
+            #else
+            __get_cpuid_count(1, 0, &Leaf1[0], &Leaf1[1], &Leaf1[2], &Leaf1[3]);
+            __get_cpuid_count(7, 0, &Leaf7[0], &Leaf7[1], &Leaf7[2], &Leaf7[3]);
+            #endif
+
+            const bool bOSXSave = (Leaf1[2] & (1u << 27)) != 0;
+            const bool bAVX     = (Leaf1[2] & (1u << 28)) != 0;
+            const bool bAVX2    = (Leaf7[1] & (1u << 5)) != 0;
+
+            if (!bOSXSave || !bAVX || !bAVX2)
+            {
+                return false;
+            }
+
+            // The OS must also preserve the YMM registers across context switches.
+            #if defined(_MSC_VER)
+            const uint64 XCR0 = _xgetbv(0);
+            #else
+            uint32 XCR0Low = 0, XCR0High = 0;
+            __asm__ volatile("xgetbv" : "=a"(XCR0Low), "=d"(XCR0High) : "c"(0));
+            const uint64 XCR0 = (static_cast<uint64>(XCR0High) << 32) | XCR0Low;
+            #endif
+
+            return (XCR0 & 0x6) == 0x6;
+        }
+
+        #endif
+
+        struct FTransformKernels
+        {
+            ESIMDPath Path;
+            void (*Compose)(const glm::vec3*, const glm::quat*, const glm::vec3*, glm::mat4*, size_t);
+            void (*Multiply)(const glm::mat4*, const glm::mat4*, glm::mat4*, size_t);
+            void (*AABBs)(const FAABB*, const glm::mat4*, FAABB*, size_t);
+        };
+
+        constexpr FTransformKernels ScalarKernels = { ESIMDPath::Scalar, &ComposeTransforms_Scalar, &MultiplyMatrices_Scalar, &TransformAABBs_Scalar };
+
+        FTransformKernels SelectKernels()
+        {
+            #if defined(LUMINA_PLATFORM_CPU_X86_64)
+            if (IsAVX2Supported())
+            {
+                return { ESIMDPath::AVX2, &ComposeTransforms_AVX2, &MultiplyMatrices_AVX2, &TransformAABBs_AVX2 };
+            }
+
+            // SSE2 is part of the x86-64 baseline.
+            return { ESIMDPath::SSE, &ComposeTransforms_SSE, &MultiplyMatrices_SSE, &TransformAABBs_SSE };
+            #else
+            return ScalarKernels;
+            #endif
+        }
+
+        const FTransformKernels& GetKernels()
+        {
+            static const FTransformKernels Kernels = SelectKernels();
+            return CVarSIMDTransforms.GetValue() ? Kernels : ScalarKernels;
+        }
+    }
+
+    ESIMDPath GetTransformBatchPath()
+    {
+        return GetKernels().Path;
+    }
+
+    const char* GetSIMDPathName(ESIMDPath Path)
+    {
+        switch (Path)
+        {
+            case ESIMDPath::Scalar: return "Scalar";
+            case ESIMDPath::SSE:    return "SSE";
+            case ESIMDPath::AVX2:   return "AVX2";
+        }
+
+        return "Unknown";
+    }
+
+    void ComposeTransforms(const glm::vec3* Locations, const glm::quat* Rotations, const glm::vec3* Scales, glm::mat4* OutMatrices, size_t Num)
+    {
+        GetKernels().Compose(Locations, Rotations, Scales, OutMatrices, Num);
+    }
+
+    void MultiplyMatrices(const glm::mat4* Parents, const glm::mat4* Children, glm::mat4* OutMatrices, size_t Num)
+    {
+        GetKernels().Multiply(Parents, Children, OutMatrices, Num);
+    }
+
+    void TransformAABBs(const FAABB* Boxes, const glm::mat4* Matrices, FAABB* OutBoxes, size_t Num)
+    {
+        GetKernels().AABBs(Boxes, Matrices, OutBoxes, Num);
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "Platform/GenericPlatform.h"
+
+namespace Lumina
+{
+    struct FAABB;
+}
+
+namespace Lumina::Math
+{
+    enum class ESIMDPath : uint8
+    {
+        Scalar,
+        SSE,
+        AVX2,
+    };
+
+    /** The instruction set the batched transform kernels dispatch to, detected once from the CPU. */
+    RUNTIME_API ESIMDPath GetTransformBatchPath();
+    RUNTIME_API const char* GetSIMDPathName(ESIMDPath Path);
+
+    /**
+     * Composes Num translation, rotation and scale streams into matrices, equivalent to FTransform::GetMatrix().
+     * The streams are kept separate so callers can gather them from SoA or AoS storage alike.
+     */
+    RUNTIME_API void ComposeTransforms(const glm::vec3* Locations, const glm::quat* Rotations, const glm::vec3* Scales, glm::mat4* OutMatrices, size_t Num);
+
+    /** OutMatrices[i] = Parents[i] * Children[i]. The output may alias either input. */
+    RUNTIME_API void MultiplyMatrices(const glm::mat4* Parents, const glm::mat4* Children, glm::mat4* OutMatrices, size_t Num);
+
+    /** Transforms Num local boxes by their affine matrix, equivalent to FAABB::ToWorld(). The output may alias the input. */
+    RUNTIME_API void TransformAABBs(const FAABB* Boxes, const glm::mat4* Matrices, FAABB* OutBoxes, size_t Num);
+}
@@ -19,6 +19,26 @@ namespace Lumina
 {
     IMPLEMENT_INTRINSIC_CLASS(CPackage, CObject, RUNTIME_API)
 
+    /** Reads everything in front of the bulk data region, which is left on disk and read on demand. */
+    static bool ReadPackageFile(TVector<uint8>& OutBinary, FStringView Path)
+    {
+        if (!VFS::ReadFileRange(OutBinary, Path, 0, sizeof(FPackageHeader)))
+        {
+            return false;
+        }
+
+        FPackageHeader Header;
+        FMemoryReader HeaderReader(OutBinary);
+        HeaderReader << Header;
+
+        if (HeaderReader.HasError() || Header.Tag != PACKAGE_FILE_TAG || Header.BulkDataOffset == INDEX_NONE)
+        {
+            return VFS::ReadFile(OutBinary, Path);
+        }
+
+        return VFS::ReadFileRange(OutBinary, Path, 0, Header.BulkDataOffset);
+    }
+
 
     FObjectExport::FObjectExport(CObject* InObject)
     {
@@ -311,7 +331,7 @@ namespace Lumina
         auto Start = std::chrono::high_resolution_clock::now();
 
         TVector<uint8> FileBinary;
-        if (VFS::ReadFile(FileBinary, Path))
+        if (ReadPackageFile(FileBinary, Path))
         {
             Package->CreateLoader(FileBinary);
         
@@ -322,6 +342,9 @@ namespace Lumina
 
             if (PackageHeader.Tag == PACKAGE_FILE_TAG)
             {
+                Reader.SetVersion(FPackageFileVersion(static_cast<ELuminaEngineVersion>(PackageHeader.Version)));
+                Package->BulkDataOffset = PackageHeader.BulkDataOffset;
+                
                 Reader.Seek(PackageHeader.ImportTableOffset);
                 Reader << Package->ImportTable;
         
@@ -367,7 +390,7 @@ namespace Lumina
         
         FPackageHeader Header;
         Header.Tag = PACKAGE_FILE_TAG;
-        Header.Version = 1;
+        Header.Version = GPackageFileLuminaVersion.FileVersion;
 
         // Skip the header until we've built the tables.
         Writer.Seek(sizeof(FPackageHeader));
@@ -384,23 +407,33 @@ namespace Lumina
 
         Header.ThumbnailDataOffset = Writer.Tell();
         Package->GetPackageThumbnail()->Serialize(Writer);
+
+        TVector<uint8> BulkData = Writer.GetBulkData();
+        Header.BulkDataOffset = Writer.Tell();
+        if (!BulkData.empty())
+        {
+            Writer.Serialize(BulkData.data(), static_cast<int64>(BulkData.size()));
+        }
         
         Writer.Seek(0);
         Writer << Header;
-
-        // Reload the package loader to match the new file binary.
-        Package->CreateLoader(FileBinary);
         
         if(!VFS::WriteFile(Path, FileBinary))
         {
             LOG_ERROR("Failed to save package: {}", Path);
         }
         
-        LOG_INFO("Saved Package: \"{}\" - ( [{}] Exports | [{}] Imports | [{:.2f}] KiB)",
+        LOG_INFO("Saved Package: \"{}\" - ( [{}] Exports | [{}] Imports | [{:.2f}] KiB | [{:.2f}] KiB Bulk)",
             Package->GetName(),
             Package->ExportTable.size(),
             Package->ImportTable.size(),
-            static_cast<double>(FileBinary.size()) / 1024.0);
+            static_cast<double>(FileBinary.size()) / 1024.0,
+            static_cast<double>(BulkData.size()) / 1024.0);
+
+        // Reload the package loader to match the new file binary, the bulk region stays on disk like it does after a load.
+        FileBinary.resize(Header.BulkDataOffset);
+        Package->CreateLoader(FileBinary);
+        Package->BulkDataOffset = Header.BulkDataOffset;
 
         Package->ClearDirty();
         
@@ -414,6 +447,21 @@ namespace Lumina
         Loader = MakeUnique<FPackageLoader>(HeapData, FileBinary.size(), this);
     }
 
+    bool CPackage::ReadBulkData(int64 Offset, int64 Size, TVector<uint8>& OutBytes) const
+    {
+        if (BulkDataOffset == INDEX_NONE || Offset < 0 || Size <= 0)
+        {
+            return false;
+        }
+        
+        if (!VFS::ReadFileRange(OutBytes, GetPackagePath(), BulkDataOffset + Offset, Size))
+        {
+            return false;
+        }
+
+        return static_cast<int64>(OutBytes.size()) == Size;
+    }
+
     FPackageLoader* CPackage::GetLoader() const
     {
         return (FPackageLoader*)Loader.get();
@@ -102,6 +102,9 @@ namespace Lumina
         /** Byte offset from the file start to the thumbnail */
         int64 ThumbnailDataOffset;
 
+        /** Byte offset from the file start to the bulk data region, INDEX_NONE for packages saved without one */
+        int64 BulkDataOffset;
+
         friend FArchive& operator << (FArchive& Ar, FPackageHeader& Data)
         {
             Ar << Data.Tag;
@@ -113,6 +116,15 @@ namespace Lumina
             Ar << Data.ObjectDataOffset;
             Ar << Data.ThumbnailDataOffset;
 
+            if (Data.Version >= static_cast<int32>(ELuminaEngineVersion::PACKAGE_BULK_DATA))
+            {
+                Ar << Data.BulkDataOffset;
+            }
+            else if (Ar.IsReading())
+            {
+                Data.BulkDataOffset = INDEX_NONE;
+            }
+
             return Ar;
         }
     };
@@ -283,6 +295,12 @@ namespace Lumina
         
         RUNTIME_API NODISCARD CObject* IndexToObject(const FObjectPackageIndex& Index);
 
+        /**
+         * Reads a range of the bulk data region straight from the package file, safe to call from any thread.
+         * Offset is relative to the start of the region, as returned by FArchive::WriteBulkData.
+         */
+        RUNTIME_API bool ReadBulkData(int64 Offset, int64 Size, TVector<uint8>& OutBytes) const;
+
         /** Returns the thumbnail data for this package */
         RUNTIME_API NODISCARD FPackageThumbnail* GetPackageThumbnail();
 
@@ -307,6 +325,9 @@ namespace Lumina
         TVector<FObjectExport>           ExportTable;
         
         int64       ExportIndex = 0;
+
+        /** Where the bulk data region starts in the package file, it is never part of the loader. */
+        int64       BulkDataOffset = INDEX_NONE;
         
     private:
         
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Lumina.h"
 #include "Containers/Name.h"
 #include "Containers/String.h"
 #include "Core/Object/ObjectHandle.h"
@@ -68,6 +69,16 @@ namespace Lumina
         {
             return GPackageFileLuminaVersion;
         }
+
+        /** Version of the data being serialized, archives reading older files set it so newer fields can be skipped. */
+        FORCEINLINE void SetVersion(FPackageFileVersion InVersion) { ArVersion = InVersion; }
+        FORCEINLINE FPackageFileVersion GetVersion() const { return ArVersion; }
+    
+        /**
+         * Stores data in a region kept apart from the serialized stream so it can later be read on its own.
+         * Returns the offset within that region, or INDEX_NONE when the archive has no such region and the data must be serialized inline.
+         */
+        virtual int64 WriteBulkData(const void* Data, int64 Size) { return INDEX_NONE; }
     
         /** Returns the maximum size of data that this archive is allowed to serialize. */
         FORCEINLINE size_t GetMaxSerializeSize() const { return ArMaxSerializeSize; }
@@ -344,6 +355,7 @@ namespace Lumina
     private:
 
         TBitFlags<EArchiverFlags> Flags;
+        FPackageFileVersion ArVersion = FPackageFileVersion(ELuminaEngineVersion::AUTOMATIC_VERSION);
         uint8 bHasError:1 = false;
         size_t ArMaxSerializeSize = INT32_MAX;
 
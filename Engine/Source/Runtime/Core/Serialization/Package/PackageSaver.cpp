@@ -123,4 +123,13 @@ namespace Lumina
         
         return *this;
     }
+
+    int64 FPackageSaver::WriteBulkData(const void* Data, int64 Size)
+    {
+        const int64 BulkOffset = static_cast<int64>(BulkData.size());
+        const uint8* Bytes = static_cast<const uint8*>(Data);
+        BulkData.insert(BulkData.end(), Bytes, Bytes + Size);
+        
+        return BulkOffset;
+    }
 }
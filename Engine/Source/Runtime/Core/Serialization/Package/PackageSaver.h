@@ -70,9 +70,15 @@ namespace Lumina
         virtual FArchive& operator<<(CObject*& Value) override;
         virtual FArchive& operator<<(FObjectHandle& Value) override;
 
+        int64 WriteBulkData(const void* Data, int64 Size) override;
+
+        /** Appended after the thumbnail once every export is written. */
+        const TVector<uint8>& GetBulkData() const { return BulkData; }
+
     private:
 
         CPackage*                   Package;
+        TVector<uint8>              BulkData;
         THashMap<CObject*, uint32>  ObjectToIndexMap;
         uint32                      CurrentImportIndex = 0;
     };
@@ -9,6 +9,18 @@ enum class ELuminaEngineVersion : uint32
 {
 	INITIAL_VERSION = 1000,
 
+	/** Meshes serialize their simplified LOD chain after the surfaces. */
+	MESH_LOD_CHAIN,
+
+	/** Mesh surfaces reference their meshlets, stored after the LOD chain. */
+	MESH_MESHLETS,
+
+	/** Packages end with a bulk data region, texture mips are stored there so they can be read one at a time. */
+	PACKAGE_BULK_DATA,
+
+	/** Static meshes carry Jolt triangle mesh and convex hull shapes cooked at import. */
+	MESH_COOKED_COLLISION,
+
 
 	AUTOMATIC_VERSION_PLUS_ONE,
 	AUTOMATIC_VERSION = AUTOMATIC_VERSION_PLUS_ONE - 1
@@ -27,6 +39,11 @@ struct FPackageFileVersion
 		return FileVersion >= static_cast<int32>(Version);
 	}
 
+	bool operator <(ELuminaEngineVersion Version) const
+	{
+		return FileVersion < static_cast<int32>(Version);
+	}
+
 
 public:
 
@@ -59,6 +59,11 @@ namespace Lumina::VFS
         return eastl::visit([&](auto& fs) { return fs.ReadFile(OutString, Path); }, Storage);
     }
 
+    bool FFileSystem::ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size)
+    {
+        return eastl::visit([&](auto& fs) { return fs.ReadFileRange(Result, Path, Offset, Size); }, Storage);
+    }
+
     bool FFileSystem::WriteFile(FStringView Path, FStringView Data)
     {
         return eastl::visit([&](auto& fs) { return fs.WriteFile(Path, Data); }, Storage);
@@ -133,6 +138,15 @@ namespace Lumina::VFS
     {
         return eastl::visit([](const auto& fs) { return fs.GetBasePath(); }, Storage);
     }
+
+    FFixedString FFileSystem::ResolveNativePath(FStringView Path) const
+    {
+        if (const FNativeFileSystem* Native = eastl::get_if<FNativeFileSystem>(&Storage))
+        {
+            return Native->ResolveVirtualPath(Path);
+        }
+        return {};
+    }
     
     FStringView Extension(FStringView Path)
     {
@@ -197,7 +211,15 @@ namespace Lumina::VFS
 
     FFixedString ResolvePath(FStringView Path)
     {
-        return {};
+        // Paks have no files on disk, the path resolves through the highest priority loose file system of the alias.
+        FFixedString Result;
+        Detail::VisitFileSystems(Path, [&](FFileSystem& FS)
+        {
+            Result = FS.ResolveNativePath(Path);
+            return !Result.empty();
+        });
+        
+        return Result;
     }
 
     bool CreateDir(FStringView Path)
@@ -289,6 +311,24 @@ namespace Lumina::VFS
         return VisitResult;   
     }
 
+    bool ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size)
+    {
+        bool VisitResult = Detail::VisitFileSystems(Path, [&](FFileSystem& FS)
+        {
+            if (FS.Exists(Path))
+            {
+                if (FS.ReadFileRange(Result, Path, Offset, Size))
+                {
+                    return true;
+                }
+            }
+            
+            return false;
+        });
+        
+        return VisitResult;
+    }
+
     bool WriteFile(FStringView Path, FStringView Data)
     {
         bool VisitResult = Detail::VisitFileSystems(Path, [&](FFileSystem& FS)
@@ -332,17 +372,32 @@ namespace Lumina::VFS
     
     void DirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback)
     {
+        // Overlays such as paks can hold the same path as the loose files below them, only the first one visited is reported.
+        THashSet<FFixedString> Visited;
         Detail::VisitFileSystems(Path, [&](const FFileSystem& FS)
         {
-            FS.DirectoryIterator(Path, Callback);
+            FS.DirectoryIterator(Path, [&](const FFileInfo& Info)
+            {
+                if (Visited.insert(Info.VirtualPath).second)
+                {
+                    Callback(Info);
+                }
+            });
         });
     }
 
     void RecursiveDirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback)
     {
+        THashSet<FFixedString> Visited;
         Detail::VisitFileSystems(Path, [&](const FFileSystem& FS)
         {
-            FS.RecursiveDirectoryIterator(Path, Callback);
+            FS.RecursiveDirectoryIterator(Path, [&](const FFileInfo& Info)
+            {
+                if (Visited.insert(Info.VirtualPath).second)
+                {
+                    Callback(Info);
+                }
+            });
         });
     }
 
@@ -430,7 +485,15 @@ namespace Lumina::VFS
     FFileSystem& Detail::AddFileSystemImpl(const FFixedString& Alias, FFileSystem&& System)
     {
         FFixedString Normalized = Paths::Normalize(Alias);
-        return FileSystemStorage[Normalized].emplace_back(Move(System));
+        TVector<FFileSystem>& FileSystems = FileSystemStorage[Normalized];
+        
+        // Kept sorted by ascending priority, visiting in reverse then tries the highest priority and latest mount first.
+        auto It = eastl::upper_bound(FileSystems.begin(), FileSystems.end(), System.GetPriority(), [](int32 Priority, const FFileSystem& FS)
+        {
+            return Priority < FS.GetPriority();
+        });
+        
+        return *FileSystems.insert(It, Move(System));
     }
 
     TVector<FFileSystem>* Detail::GetFileSystems(const FFixedString& Alias)
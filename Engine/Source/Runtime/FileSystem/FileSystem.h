@@ -2,6 +2,7 @@
 
 #include "FileInfo.h"
 #include "NativeFileSystem.h"
+#include "PakFileSystem.h"
 #include "Containers/Function.h"
 #include "Containers/Name.h"
 #include "Containers/String.h"
@@ -18,6 +19,7 @@ namespace Lumina::VFS
     {
         { FS.ReadFile(OutBytes, Path) }                         -> Concept::TSameAs<bool>;
         { FS.ReadFile(OutStr, Path) }                           -> Concept::TSameAs<bool>;
+        { FS.ReadFileRange(OutBytes, Path, 0ull, 0ull) }        -> Concept::TSameAs<bool>;
         { FS.WriteFile(Path, Path) }                            -> Concept::TSameAs<bool>;
         { FS.WriteFile(Path, Data) }                            -> Concept::TSameAs<bool>;
         { FS.IsEmpty(Path) }                                    -> Concept::TSameAs<bool>;
@@ -45,6 +47,7 @@ namespace Lumina::VFS
         
         bool ReadFile(TVector<uint8>& Result, FStringView Path);
         bool ReadFile(FString& OutString, FStringView Path);
+        bool ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size);
         bool WriteFile(FStringView Path, FStringView Data);
         bool WriteFile(FStringView Path, TSpan<const uint8> Data);
         bool Exists(FStringView Path) const;
@@ -61,16 +64,23 @@ namespace Lumina::VFS
         
         FStringView GetAliasPath() const;
         FStringView GetBasePath() const;
+        int32 GetPriority() const { return Priority; }
+        
+        /** Where Path lives on disk, empty for file systems that are not backed by loose files. */
+        FFixedString ResolveNativePath(FStringView Path) const;
         
     private:
         
-        TVariant<FNativeFileSystem> Storage;
+        TVariant<FNativeFileSystem, FPakFileSystem> Storage;
+        
+        /** File systems of an alias are searched from the highest priority down, the latest mount first among equals. */
+        int32 Priority = 0;
         
         ////
         
         template<CFileSystem T, typename... TArgs>
         requires(eastl::is_nothrow_constructible_v<T, FFixedString, TArgs...>)
-        friend T& Mount(const FFixedString& Alias, TArgs&&... Args);
+        friend T& MountWithPriority(int32 Priority, const FFixedString& Alias, TArgs&&... Args);
     };
     
     static void Initialize();
@@ -84,15 +94,23 @@ namespace Lumina::VFS
     
     template<CFileSystem T, typename... TArgs>
     requires(eastl::is_nothrow_constructible_v<T, FFixedString, TArgs...>)
-    T& Mount(const FFixedString& Alias, TArgs&&... Args)
+    T& MountWithPriority(int32 Priority, const FFixedString& Alias, TArgs&&... Args)
     {
         T TypeT(Alias, Forward<TArgs>(Args)...);
         FFileSystem FS(TypeT);
+        FS.Priority = Priority;
         
         FFileSystem& Result = Detail::AddFileSystemImpl(Alias, Move(FS));
         return eastl::get<T>(Result.Storage);
     }
     
+    template<CFileSystem T, typename... TArgs>
+    requires(eastl::is_nothrow_constructible_v<T, FFixedString, TArgs...>)
+    T& Mount(const FFixedString& Alias, TArgs&&... Args)
+    {
+        return MountWithPriority<T>(0, Alias, Forward<TArgs>(Args)...);
+    }
+    
     RUNTIME_API void DirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback);
     RUNTIME_API void RecursiveDirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback);
 
@@ -116,6 +134,9 @@ namespace Lumina::VFS
     
     RUNTIME_API bool ReadFile(TVector<uint8>& Result, FStringView Path);
     RUNTIME_API bool ReadFile(FString& OutString, FStringView Path);
+    
+    /** Reads Size bytes starting at Offset, clamped to the end of the file. */
+    RUNTIME_API bool ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size);
     RUNTIME_API bool WriteFile(FStringView Path, FStringView Data);
     RUNTIME_API bool WriteFile(FStringView Path, TSpan<const uint8> Data);
     
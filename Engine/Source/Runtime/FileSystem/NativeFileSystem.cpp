@@ -66,6 +66,44 @@ namespace Lumina::VFS
         return true;
     }
 
+    bool FNativeFileSystem::ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size)
+    {
+        FFixedString FullPath = ResolveVirtualPath(Path);
+        
+        Result.clear();
+
+        std::ifstream File(FullPath.data(), std::ios::binary | std::ios::ate);
+        if (!File)
+        {
+            return false;
+        }
+
+        const std::streamsize FileSize = File.tellg();
+        if (FileSize < 0 || Offset > static_cast<uint64>(FileSize))
+        {
+            return false;
+        }
+
+        // Ranges running past the end are clamped, callers needing every byte check the result size.
+        const uint64 ReadSize = eastl::min<uint64>(Size, static_cast<uint64>(FileSize) - Offset);
+        if (ReadSize == 0)
+        {
+            return true;
+        }
+
+        File.seekg(static_cast<std::streamoff>(Offset), std::ios::beg);
+
+        Result.resize(static_cast<size_t>(ReadSize));
+
+        if (!File.read(reinterpret_cast<char*>(Result.data()), static_cast<std::streamsize>(ReadSize)))
+        {
+            Result.clear();
+            return false;
+        }
+
+        return true;
+    }
+
 
     bool FNativeFileSystem::ReadFile(FString& OutString, FStringView Path)
     {
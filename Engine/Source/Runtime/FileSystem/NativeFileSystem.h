@@ -17,6 +17,7 @@ namespace Lumina::VFS
         
         bool ReadFile(TVector<uint8>& Result, FStringView Path);
         bool ReadFile(FString& OutString, FStringView Path);
+        bool ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size);
         
         bool WriteFile(FStringView Path, FStringView Data);
         bool WriteFile(FStringView Path, TSpan<const uint8> Data);
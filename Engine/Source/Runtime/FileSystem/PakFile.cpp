@@ -0,0 +1,196 @@
+#include "pch.h"
+#include "PakFile.h"
+#include <fstream>
+
+#include "Containers/Array.h"
+#include "Core/Math/Hash/Hash.h"
+
+#include "zstd.h"
+
+namespace Lumina::VFS::Pak
+{
+    namespace
+    {
+        /** Packing happens offline, so spend the time on a high level, decompression speed barely depends on it. */
+        constexpr int CompressionLevel = 19;
+
+        struct FCompressionContext
+        {
+            FCompressionContext() : Handle(ZSTD_createCCtx()) { }
+            ~FCompressionContext() { ZSTD_freeCCtx(Handle); }
+
+            ZSTD_CCtx* Handle;
+        };
+
+        /** Compresses Raw into Out, returns false when the result would not be smaller than the input. */
+        bool CompressBlock(ZSTD_CCtx* Context, const uint8* Raw, size_t RawSize, TVector<uint8>& Out)
+        {
+            Out.resize(ZSTD_compressBound(RawSize));
+            const size_t CompressedSize = ZSTD_compressCCtx(Context, Out.data(), Out.size(), Raw, RawSize, CompressionLevel);
+            if (ZSTD_isError(CompressedSize) || CompressedSize >= RawSize)
+            {
+                return false;
+            }
+
+            Out.resize(CompressedSize);
+            return true;
+        }
+    }
+
+    uint64 HashPath(FStringView Path)
+    {
+        FFixedString Lower(Path.begin(), Path.end());
+        eastl::replace(Lower.begin(), Lower.end(), '\\', '/');
+        Lower.make_lower();
+
+        return Hash::XXHash::GetHash64(Lower.data(), Lower.size());
+    }
+
+    bool WriteArchive(FStringView SourceDirectory, FStringView ArchivePath, bool bCompress)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const std::filesystem::path SourcePath(SourceDirectory.begin(), SourceDirectory.end());
+        if (!std::filesystem::is_directory(SourcePath))
+        {
+            LOG_ERROR("Pak source {} is not a directory", SourceDirectory);
+            return false;
+        }
+
+        struct FSourceFile
+        {
+            std::filesystem::path   Path;
+            FFixedString            RelativePath;
+            uint64                  PathHash;
+        };
+
+        TVector<FSourceFile> Files;
+        for (const auto& Itr : std::filesystem::recursive_directory_iterator(SourcePath))
+        {
+            if (!Itr.is_regular_file())
+            {
+                continue;
+            }
+
+            std::string Relative = "/" + std::filesystem::relative(Itr.path(), SourcePath).generic_string();
+            FFixedString RelativePath(Relative.data(), Relative.size());
+            Files.push_back(FSourceFile{ Itr.path(), RelativePath, HashPath(RelativePath) });
+        }
+
+        eastl::sort(Files.begin(), Files.end(), [](const FSourceFile& A, const FSourceFile& B)
+        {
+            return A.PathHash < B.PathHash;
+        });
+
+        for (size_t i = 1; i < Files.size(); ++i)
+        {
+            if (Files[i].PathHash == Files[i - 1].PathHash)
+            {
+                LOG_ERROR("Pak paths {} and {} collide", Files[i - 1].RelativePath, Files[i].RelativePath);
+                return false;
+            }
+        }
+
+        std::ofstream Archive(std::filesystem::path(ArchivePath.begin(), ArchivePath.end()), std::ios::binary | std::ios::trunc);
+        if (!Archive)
+        {
+            LOG_ERROR("Failed to open pak {} for writing", ArchivePath);
+            return false;
+        }
+
+        FPakHeader Header   = {};
+        Header.Magic        = Magic;
+        Header.Version      = Version;
+        Header.BlockSize    = BlockSize;
+        Header.NumEntries   = static_cast<uint32>(Files.size());
+        Archive.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+        TVector<FPakEntry> Entries;
+        TVector<FPakBlock> Blocks;
+        FString PathStrings;
+        TVector<uint8> Contents;
+        TVector<uint8> Compressed;
+        FCompressionContext Context;
+
+        uint64 Offset = sizeof(FPakHeader);
+        uint64 RawBytes = 0;
+        bool bSuccess = true;
+
+        for (const FSourceFile& File : Files)
+        {
+            std::ifstream Input(File.Path, std::ios::binary | std::ios::ate);
+            const std::streamsize Size = Input ? static_cast<std::streamsize>(Input.tellg()) : -1;
+            Contents.resize(static_cast<size_t>(eastl::max<std::streamsize>(Size, 0)));
+            if (Size < 0 || !Input.seekg(0, std::ios::beg) || (Size > 0 && !Input.read(reinterpret_cast<char*>(Contents.data()), Size)))
+            {
+                LOG_ERROR("Failed to read {} while packing", File.RelativePath);
+                bSuccess = false;
+                break;
+            }
+
+            FPakEntry& Entry    = Entries.emplace_back();
+            Entry.PathHash      = File.PathHash;
+            Entry.Size          = Contents.size();
+            Entry.FirstBlock    = Blocks.size();
+            Entry.PathOffset    = static_cast<uint32>(PathStrings.size());
+            Entry.PathLength    = static_cast<uint32>(File.RelativePath.size());
+            PathStrings.append(File.RelativePath.begin(), File.RelativePath.end());
+
+            for (uint64 BlockStart = 0; BlockStart < Contents.size(); BlockStart += BlockSize)
+            {
+                const size_t RawSize = static_cast<size_t>(eastl::min<uint64>(BlockSize, Contents.size() - BlockStart));
+                const uint8* Raw = Contents.data() + BlockStart;
+
+                // Blocks that do not shrink are stored as they are and copied straight out of the mapping when read.
+                FPakBlock& Block = Blocks.emplace_back();
+                Block.Offset = Offset;
+                if (bCompress && CompressBlock(Context.Handle, Raw, RawSize, Compressed))
+                {
+                    Block.StoredSize    = static_cast<uint32>(Compressed.size());
+                    Block.Flags         = EBlockFlags::Zstd;
+                    Archive.write(reinterpret_cast<const char*>(Compressed.data()), static_cast<std::streamsize>(Compressed.size()));
+                }
+                else
+                {
+                    Block.StoredSize    = static_cast<uint32>(RawSize);
+                    Block.Flags         = EBlockFlags::None;
+                    Archive.write(reinterpret_cast<const char*>(Raw), static_cast<std::streamsize>(RawSize));
+                }
+
+                Offset += Block.StoredSize;
+            }
+
+            RawBytes += Contents.size();
+        }
+
+        if (!bSuccess)
+        {
+            return false;
+        }
+
+        Header.NumBlocks        = Blocks.size();
+        Header.BlockTableOffset = Offset;
+        Archive.write(reinterpret_cast<const char*>(Blocks.data()), static_cast<std::streamsize>(Blocks.size() * sizeof(FPakBlock)));
+
+        Header.IndexOffset      = Header.BlockTableOffset + Blocks.size() * sizeof(FPakBlock);
+        Archive.write(reinterpret_cast<const char*>(Entries.data()), static_cast<std::streamsize>(Entries.size() * sizeof(FPakEntry)));
+
+        Header.PathsOffset      = Header.IndexOffset + Entries.size() * sizeof(FPakEntry);
+        Header.PathsSize        = PathStrings.size();
+        Archive.write(PathStrings.data(), static_cast<std::streamsize>(PathStrings.size()));
+
+        Archive.seekp(0, std::ios::beg);
+        Archive.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+        if (!Archive.good())
+        {
+            LOG_ERROR("Failed to write pak {}", ArchivePath);
+            return false;
+        }
+
+        LOG_INFO("Packed {} files into {} - ( [{:.2f}] MiB Raw | [{:.2f}] MiB Stored | [{}] Blocks )", Files.size(), ArchivePath,
+            static_cast<double>(RawBytes) / (1024.0 * 1024.0), static_cast<double>(Offset - sizeof(FPakHeader)) / (1024.0 * 1024.0), Blocks.size());
+
+        return true;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Containers/String.h"
+#include "Platform/GenericPlatform.h"
+
+/**
+ * Pak archives pack a directory tree into one file read through a memory mapping.
+ *
+ *   [FPakHeader] [entry data] [FPakBlock table] [FPakEntry index] [path strings]
+ *
+ * Entry data is split in blocks of BlockSize bytes, each zstd compressed on its own or kept raw when that does not
+ * save anything, so a range read only decompresses the blocks it touches. The index is sorted by path hash.
+ */
+namespace Lumina::VFS::Pak
+{
+    constexpr uint32 Magic          = 0x4B50414C; // "LAPK"
+    constexpr uint32 Version        = 2;
+    constexpr uint32 BlockSize      = 64 * 1024;
+
+    enum class EBlockFlags : uint32
+    {
+        None        = 0,
+        Zstd        = 1 << 0,
+    };
+
+    struct FPakHeader
+    {
+        uint32  Magic;
+        uint32  Version;
+        uint32  BlockSize;
+        uint32  NumEntries;
+        uint64  NumBlocks;
+        uint64  BlockTableOffset;
+        uint64  IndexOffset;
+        uint64  PathsOffset;
+        uint64  PathsSize;
+    };
+
+    struct FPakBlock
+    {
+        uint64      Offset;
+        uint32      StoredSize;
+        EBlockFlags Flags;
+    };
+
+    struct FPakEntry
+    {
+        uint64  PathHash;
+        uint64  Size;
+        uint64  FirstBlock;
+        uint32  PathOffset;
+        uint32  PathLength;
+    };
+
+    static_assert(sizeof(FPakHeader) == 56 && sizeof(FPakBlock) == 16 && sizeof(FPakEntry) == 32, "Pak structures are written as they are laid out in memory.");
+
+    /** Paths are stored relative to the packed directory with a leading slash, hashed without regard to case. */
+    RUNTIME_API uint64 HashPath(FStringView Path);
+
+    /** Packs every file under SourceDirectory into a new archive at ArchivePath. */
+    RUNTIME_API bool WriteArchive(FStringView SourceDirectory, FStringView ArchivePath, bool bCompress = true);
+}
@@ -0,0 +1,525 @@
+#include "pch.h"
+#include "PakFileSystem.h"
+
+#include "FileInfo.h"
+#include "FileSystem.h"
+#include "Core/Profiler/Profile.h"
+#include "Memory/Memcpy.h"
+#include "Paths/Paths.h"
+#include "zstd.h"
+
+namespace Lumina::VFS
+{
+    namespace
+    {
+        struct FThreadDecompressor
+        {
+            FThreadDecompressor() : Handle(ZSTD_createDCtx()) { }
+            ~FThreadDecompressor() { ZSTD_freeDCtx(Handle); }
+
+            ZSTD_DCtx* Handle;
+        };
+
+        ZSTD_DCtx* GetDecompressor()
+        {
+            static thread_local FThreadDecompressor Decompressor;
+            return Decompressor.Handle;
+        }
+
+        bool EqualsIgnoreCase(FStringView A, FStringView B)
+        {
+            if (A.size() != B.size())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < A.size(); ++i)
+            {
+                const char CharA = A[i] == '\\' ? '/' : A[i];
+                const char CharB = B[i] == '\\' ? '/' : B[i];
+                if (eastl::CharToLower(CharA) != eastl::CharToLower(CharB))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /** True when Count elements of ElementSize bytes starting at Offset end inside Limit, without overflowing on hostile values. */
+        bool FitsIn(uint64 Offset, uint64 Count, uint64 ElementSize, uint64 Limit)
+        {
+            return Count <= Limit / ElementSize && Offset <= Limit - Count * ElementSize;
+        }
+
+        uint64 GetNumBlocks(const Pak::FPakEntry& Entry, uint64 BlockSize)
+        {
+            return Entry.Size / BlockSize + (Entry.Size % BlockSize != 0);
+        }
+
+        /**
+         * Checks every offset and size the reads trust before the archive is mounted, returns why it was rejected or nullptr.
+         * Reads still bound what they touch, this catches truncated and corrupt archives once instead of on the first unlucky read.
+         */
+        const char* ValidateArchive(const uint8* Data, uint64 FileSize)
+        {
+            if (FileSize < sizeof(Pak::FPakHeader))
+            {
+                return "file is smaller than the header";
+            }
+
+            const Pak::FPakHeader& Header = *reinterpret_cast<const Pak::FPakHeader*>(Data);
+            if (Header.Magic != Pak::Magic)
+            {
+                return "bad magic";
+            }
+
+            if (Header.Version != Pak::Version)
+            {
+                return "unsupported version";
+            }
+
+            if (Header.BlockSize == 0)
+            {
+                return "zero block size";
+            }
+
+            if (Header.BlockTableOffset < sizeof(Pak::FPakHeader) || !FitsIn(Header.BlockTableOffset, Header.NumBlocks, sizeof(Pak::FPakBlock), FileSize))
+            {
+                return "block table out of bounds";
+            }
+
+            if (Header.IndexOffset < sizeof(Pak::FPakHeader) || !FitsIn(Header.IndexOffset, Header.NumEntries, sizeof(Pak::FPakEntry), FileSize))
+            {
+                return "index out of bounds";
+            }
+
+            if (Header.PathsOffset < sizeof(Pak::FPakHeader) || !FitsIn(Header.PathsOffset, Header.PathsSize, 1, FileSize))
+            {
+                return "path strings out of bounds";
+            }
+
+            const Pak::FPakBlock* Blocks = reinterpret_cast<const Pak::FPakBlock*>(Data + Header.BlockTableOffset);
+            for (uint64 i = 0; i < Header.NumBlocks; ++i)
+            {
+                const Pak::FPakBlock& Block = Blocks[i];
+                if (Block.Flags != Pak::EBlockFlags::None && Block.Flags != Pak::EBlockFlags::Zstd)
+                {
+                    return "unknown block flags";
+                }
+
+                if (Block.Offset < sizeof(Pak::FPakHeader) || !FitsIn(Block.Offset, Block.StoredSize, 1, FileSize))
+                {
+                    return "block data out of bounds";
+                }
+            }
+
+            const Pak::FPakEntry* Entries = reinterpret_cast<const Pak::FPakEntry*>(Data + Header.IndexOffset);
+            for (uint32 i = 0; i < Header.NumEntries; ++i)
+            {
+                const Pak::FPakEntry& Entry = Entries[i];
+
+                // Lookups binary search the index, a duplicate or out of order hash would hide entries.
+                if (i > 0 && Entries[i - 1].PathHash >= Entry.PathHash)
+                {
+                    return "index not sorted by path hash";
+                }
+
+                if (!FitsIn(Entry.PathOffset, Entry.PathLength, 1, Header.PathsSize))
+                {
+                    return "entry path out of bounds";
+                }
+
+                const uint64 NumEntryBlocks = GetNumBlocks(Entry, Header.BlockSize);
+                if (Entry.FirstBlock > Header.NumBlocks || NumEntryBlocks > Header.NumBlocks - Entry.FirstBlock)
+                {
+                    return "entry blocks out of bounds";
+                }
+
+                // Raw blocks are copied straight out of the mapping, they must hold every byte of the entry they cover.
+                for (uint64 BlockIndex = 0; BlockIndex < NumEntryBlocks; ++BlockIndex)
+                {
+                    const Pak::FPakBlock& Block = Blocks[Entry.FirstBlock + BlockIndex];
+                    const uint64 BlockRawSize = eastl::min<uint64>(Header.BlockSize, Entry.Size - BlockIndex * Header.BlockSize);
+                    if (Block.Flags == Pak::EBlockFlags::None && Block.StoredSize != BlockRawSize)
+                    {
+                        return "raw block size does not match the entry";
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+    }
+
+    FPakFileSystem::FPakFileSystem(const FFixedString& InAliasPath, FStringView InArchivePath) noexcept
+        : AliasPath(Paths::Normalize(InAliasPath))
+        , ArchivePath(Paths::Normalize(InArchivePath))
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        TSharedPtr<FMappedFile> Mapping = MakeShared<FMappedFile>();
+        if (!Mapping->Open(ArchivePath))
+        {
+            LOG_ERROR("Failed to map pak {}", ArchivePath);
+            return;
+        }
+
+        const uint8* Data = Mapping->GetData();
+        const uint64 FileSize = Mapping->GetSize();
+        if (const char* Error = ValidateArchive(Data, FileSize))
+        {
+            LOG_ERROR("{} is not a valid pak archive: {}", ArchivePath, Error);
+            return;
+        }
+
+        const Pak::FPakHeader* PakHeader = reinterpret_cast<const Pak::FPakHeader*>(Data);
+
+        Archive     = Mapping;
+        Header      = PakHeader;
+        Blocks      = reinterpret_cast<const Pak::FPakBlock*>(Data + PakHeader->BlockTableOffset);
+        Entries     = reinterpret_cast<const Pak::FPakEntry*>(Data + PakHeader->IndexOffset);
+        PathStrings = reinterpret_cast<const char*>(Data + PakHeader->PathsOffset);
+        NumEntries  = PakHeader->NumEntries;
+
+        // The root and every parent of an entry count as directories.
+        Directories.insert(Pak::HashPath(""));
+        for (uint32 i = 0; i < NumEntries; ++i)
+        {
+            FStringView EntryPath = GetEntryPath(Entries[i]);
+            for (size_t Slash = EntryPath.find_last_of('/'); Slash != 0 && Slash != FStringView::npos; Slash = EntryPath.find_last_of('/', Slash - 1))
+            {
+                if (!Directories.insert(Pak::HashPath(EntryPath.substr(0, Slash))).second)
+                {
+                    break;
+                }
+            }
+        }
+
+        LOG_INFO("Mounted pak {} at {} - ( [{}] Files | [{}] Blocks )", ArchivePath, AliasPath, NumEntries, Header->NumBlocks);
+    }
+
+    bool FPakFileSystem::ReadFile(TVector<uint8>& Result, FStringView Path)
+    {
+        Result.clear();
+
+        const Pak::FPakEntry* Entry = FindEntry(Path);
+        if (Entry == nullptr)
+        {
+            return false;
+        }
+
+        Result.resize(static_cast<size_t>(Entry->Size));
+        if (!ReadEntry(*Entry, 0, Entry->Size, Result.data()))
+        {
+            Result.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool FPakFileSystem::ReadFile(FString& OutString, FStringView Path)
+    {
+        OutString.clear();
+
+        const Pak::FPakEntry* Entry = FindEntry(Path);
+        if (Entry == nullptr)
+        {
+            return false;
+        }
+
+        OutString.resize(static_cast<size_t>(Entry->Size));
+        if (!ReadEntry(*Entry, 0, Entry->Size, reinterpret_cast<uint8*>(OutString.data())))
+        {
+            OutString.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool FPakFileSystem::ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size)
+    {
+        Result.clear();
+
+        const Pak::FPakEntry* Entry = FindEntry(Path);
+        if (Entry == nullptr || Offset > Entry->Size)
+        {
+            return false;
+        }
+
+        const uint64 ReadSize = eastl::min<uint64>(Size, Entry->Size - Offset);
+        Result.resize(static_cast<size_t>(ReadSize));
+        if (!ReadEntry(*Entry, Offset, ReadSize, Result.data()))
+        {
+            Result.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool FPakFileSystem::Exists(FStringView Path) const
+    {
+        return FindEntry(Path) != nullptr || IsDirectory(Path);
+    }
+
+    bool FPakFileSystem::IsDirectory(FStringView Path) const
+    {
+        if (!IsValid() || !Path.starts_with(AliasPath))
+        {
+            return false;
+        }
+
+        FStringView Relative = ToArchivePath(Path);
+        if (Relative.ends_with('/'))
+        {
+            Relative.remove_suffix(1);
+        }
+
+        return Directories.find(Pak::HashPath(Relative)) != Directories.end();
+    }
+
+    size_t FPakFileSystem::Size(FStringView Path) const
+    {
+        const Pak::FPakEntry* Entry = FindEntry(Path);
+        return Entry != nullptr ? static_cast<size_t>(Entry->Size) : 0;
+    }
+
+    bool FPakFileSystem::IsEmpty(FStringView Path) const
+    {
+        if (const Pak::FPakEntry* Entry = FindEntry(Path))
+        {
+            return Entry->Size == 0;
+        }
+
+        bool bEmpty = true;
+        ForEachChild(Path, false, [&](FStringView, bool)
+        {
+            bEmpty = false;
+        });
+
+        return bEmpty;
+    }
+
+    void FPakFileSystem::DirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback) const
+    {
+        ForEachChild(Path, false, [&](FStringView ChildPath, bool bDirectory)
+        {
+            Callback(MakeFileInfo(ChildPath, bDirectory));
+        });
+    }
+
+    void FPakFileSystem::RecursiveDirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback) const
+    {
+        ForEachChild(Path, true, [&](FStringView ChildPath, bool bDirectory)
+        {
+            Callback(MakeFileInfo(ChildPath, bDirectory));
+        });
+    }
+
+    FFileInfo FPakFileSystem::MakeFileInfo(FStringView ChildPath, bool bDirectory) const
+    {
+        FStringView Name = ChildPath.substr(ChildPath.find_last_of('/') + 1);
+
+        FFileInfo FileInfo;
+        FileInfo.Name.assign(Name.data(), Name.size());
+        FileInfo.VirtualPath    = AliasPath;
+        FileInfo.VirtualPath.append(ChildPath.begin(), ChildPath.end());
+        FileInfo.PathSource     = ArchivePath;
+        FileInfo.LastModifyTime = 0;
+        FileInfo.Flags          = EFileFlags::ReadOnly | (bDirectory ? EFileFlags::Directory : EFileFlags::File);
+
+        if (IsLuaAsset(Name))
+        {
+            FileInfo.Flags |= EFileFlags::LuaFile;
+        }
+        
+        if (IsLuminaAsset(Name))
+        {
+            FileInfo.Flags |= EFileFlags::LAssetFile;
+        }
+
+        return FileInfo;
+    }
+
+    FStringView FPakFileSystem::ToArchivePath(FStringView Path) const
+    {
+        return Path.substr(AliasPath.length());
+    }
+
+    FStringView FPakFileSystem::GetEntryPath(const Pak::FPakEntry& Entry) const
+    {
+        return FStringView(PathStrings + Entry.PathOffset, Entry.PathLength);
+    }
+
+    const Pak::FPakEntry* FPakFileSystem::FindEntry(FStringView Path) const
+    {
+        if (!IsValid() || !Path.starts_with(AliasPath))
+        {
+            return nullptr;
+        }
+
+        const FStringView Relative = ToArchivePath(Path);
+        const uint64 PathHash = Pak::HashPath(Relative);
+
+        const Pak::FPakEntry* End = Entries + NumEntries;
+        const Pak::FPakEntry* It = eastl::lower_bound(Entries, End, PathHash, [](const Pak::FPakEntry& Entry, uint64 Hash)
+        {
+            return Entry.PathHash < Hash;
+        });
+
+        // The writer rejects colliding hashes, the path compare only guards against lookups of paths that are not packed.
+        if (It == End || It->PathHash != PathHash || !EqualsIgnoreCase(GetEntryPath(*It), Relative))
+        {
+            return nullptr;
+        }
+
+        return It;
+    }
+
+    bool FPakFileSystem::ReadEntry(const Pak::FPakEntry& Entry, uint64 Offset, uint64 Size, uint8* Dest) const
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const uint8* Data = Archive->GetData();
+        const uint64 BlockSize = Header->BlockSize;
+        TVector<uint8> Scratch;
+
+        for (uint64 Position = Offset; Position < Offset + Size;)
+        {
+            const uint64 BlockIndex = Position / BlockSize;
+            const uint64 BlockStart = BlockIndex * BlockSize;
+            const uint64 BlockRawSize = eastl::min<uint64>(BlockSize, Entry.Size - BlockStart);
+            const uint64 CopyStart = Position - BlockStart;
+            const uint64 CopySize = eastl::min<uint64>(BlockRawSize - CopyStart, Offset + Size - Position);
+
+            if (Entry.FirstBlock + BlockIndex >= Header->NumBlocks)
+            {
+                return false;
+            }
+
+            const Pak::FPakBlock& Block = Blocks[Entry.FirstBlock + BlockIndex];
+            if (!FitsIn(Block.Offset, Block.StoredSize, 1, Archive->GetSize()))
+            {
+                return false;
+            }
+
+            const uint8* Stored = Data + Block.Offset;
+            if (Block.Flags == Pak::EBlockFlags::None)
+            {
+                if (CopyStart + CopySize > Block.StoredSize)
+                {
+                    return false;
+                }
+
+                Memory::Memcpy(Dest, Stored + CopyStart, CopySize);
+            }
+            else if (Block.Flags == Pak::EBlockFlags::Zstd)
+            {
+                // Whole blocks decompress straight into the destination, partial ones go through scratch memory.
+                const bool bWholeBlock = CopyStart == 0 && CopySize == BlockRawSize;
+                uint8* Decompressed = Dest;
+                if (!bWholeBlock)
+                {
+                    Scratch.resize(static_cast<size_t>(BlockRawSize));
+                    Decompressed = Scratch.data();
+                }
+
+                const size_t ActualSize = ZSTD_decompressDCtx(GetDecompressor(), Decompressed, static_cast<size_t>(BlockRawSize), Stored, Block.StoredSize);
+                if (ZSTD_isError(ActualSize) || ActualSize != BlockRawSize)
+                {
+                    LOG_ERROR("Corrupt block {} in pak {}", Entry.FirstBlock + BlockIndex, ArchivePath);
+                    return false;
+                }
+
+                if (!bWholeBlock)
+                {
+                    Memory::Memcpy(Dest, Decompressed + CopyStart, CopySize);
+                }
+            }
+            else
+            {
+                LOG_ERROR("Unknown flags on block {} in pak {}", Entry.FirstBlock + BlockIndex, ArchivePath);
+                return false;
+            }
+
+            Dest += CopySize;
+            Position += CopySize;
+        }
+
+        return true;
+    }
+
+    template<typename TFunc>
+    void FPakFileSystem::ForEachChild(FStringView Path, bool bRecursive, TFunc&& Func) const
+    {
+        if (!IsDirectory(Path))
+        {
+            return;
+        }
+
+        FFixedString Prefix(ToArchivePath(Path).begin(), ToArchivePath(Path).end());
+        if (!Prefix.ends_with("/"))
+        {
+            Prefix.push_back('/');
+        }
+
+        // Directories only exist through the entries below them, each one is reported once at its first entry.
+        THashSet<uint64> ReportedDirectories;
+        for (uint32 i = 0; i < NumEntries; ++i)
+        {
+            FStringView EntryPath = GetEntryPath(Entries[i]);
+            if (EntryPath.size() <= Prefix.size() || !EqualsIgnoreCase(EntryPath.substr(0, Prefix.size()), Prefix))
+            {
+                continue;
+            }
+
+            for (size_t Slash = EntryPath.find('/', Prefix.size()); Slash != FStringView::npos; Slash = EntryPath.find('/', Slash + 1))
+            {
+                FStringView DirectoryPath = EntryPath.substr(0, Slash);
+                if (ReportedDirectories.insert(Pak::HashPath(DirectoryPath)).second)
+                {
+                    Func(DirectoryPath, true);
+                }
+
+                if (!bRecursive)
+                {
+                    break;
+                }
+            }
+
+            if (bRecursive || EntryPath.find('/', Prefix.size()) == FStringView::npos)
+            {
+                Func(EntryPath, false);
+            }
+        }
+    }
+
+    void MountPaks(const FFixedString& Alias, FStringView Directory)
+    {
+        const std::filesystem::path DirectoryPath(Directory.begin(), Directory.end());
+        if (!std::filesystem::is_directory(DirectoryPath))
+        {
+            return;
+        }
+
+        TVector<FFixedString> Archives;
+        for (const auto& Itr : std::filesystem::directory_iterator(DirectoryPath))
+        {
+            if (Itr.is_regular_file() && Itr.path().extension() == ".lpak")
+            {
+                std::string ArchivePath = Itr.path().generic_string();
+                Archives.emplace_back(ArchivePath.data(), ArchivePath.size());
+            }
+        }
+
+        eastl::sort(Archives.begin(), Archives.end());
+
+        for (const FFixedString& ArchivePath : Archives)
+        {
+            MountWithPriority<FPakFileSystem>(PakMountPriority, Alias, ArchivePath);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "PakFile.h"
+#include "Containers/Array.h"
+#include "Containers/Function.h"
+#include "Containers/String.h"
+#include "Memory/SmartPtr.h"
+#include "Platform/Filesystem/MappedFile.h"
+
+namespace Lumina::VFS
+{
+    struct FFileInfo;
+
+    /** Paks mount above the loose files of the same alias so shipped content wins over stale files left on disk. */
+    constexpr int32 PakMountPriority = 100;
+
+    /**
+     * Read only file system over a pak archive. Lookups binary search the mapped index by path hash,
+     * reads copy or decompress only the blocks they touch and are safe from any thread.
+     */
+    class RUNTIME_API FPakFileSystem
+    {
+    public:
+        FPakFileSystem(const FFixedString& InAliasPath, FStringView InArchivePath) noexcept;
+
+        bool IsValid() const { return Archive != nullptr; }
+        uint32 GetNumEntries() const { return NumEntries; }
+
+        bool ReadFile(TVector<uint8>& Result, FStringView Path);
+        bool ReadFile(FString& OutString, FStringView Path);
+        bool ReadFileRange(TVector<uint8>& Result, FStringView Path, uint64 Offset, uint64 Size);
+
+        bool WriteFile(FStringView Path, FStringView Data) { return false; }
+        bool WriteFile(FStringView Path, TSpan<const uint8> Data) { return false; }
+
+        bool Exists(FStringView Path) const;
+        bool IsDirectory(FStringView Path) const;
+        size_t Size(FStringView Path) const;
+
+        bool CreateDir(FStringView Path) const { return false; }
+        bool Remove(FStringView Path) const { return false; }
+        bool RemoveAll(FStringView Path) const { return false; }
+        bool Rename(FStringView Old, FStringView New) const { return false; }
+
+        bool IsEmpty(FStringView Path) const;
+
+        void PlatformOpen(FStringView Path) const { }
+
+        void DirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback) const;
+        void RecursiveDirectoryIterator(FStringView Path, const TFunction<void(const FFileInfo&)>& Callback) const;
+
+        FStringView GetAliasPath() const { return AliasPath; }
+        FStringView GetBasePath() const { return ArchivePath; }
+
+    private:
+
+        FStringView ToArchivePath(FStringView Path) const;
+        FStringView GetEntryPath(const Pak::FPakEntry& Entry) const;
+        const Pak::FPakEntry* FindEntry(FStringView Path) const;
+        FFileInfo MakeFileInfo(FStringView ChildPath, bool bDirectory) const;
+
+        /** Copies Size bytes of the entry starting at Offset into Dest, decompressing the blocks the range overlaps. */
+        bool ReadEntry(const Pak::FPakEntry& Entry, uint64 Offset, uint64 Size, uint8* Dest) const;
+
+        template<typename TFunc>
+        void ForEachChild(FStringView Path, bool bRecursive, TFunc&& Func) const;
+
+        FFixedString                AliasPath;
+        FFixedString                ArchivePath;
+
+        /** Shared so the mapping survives the copies the mount makes, the index points straight into it. */
+        TSharedPtr<FMappedFile>     Archive;
+        const Pak::FPakHeader*      Header = nullptr;
+        const Pak::FPakBlock*       Blocks = nullptr;
+        const Pak::FPakEntry*       Entries = nullptr;
+        const char*                 PathStrings = nullptr;
+        uint32                      NumEntries = 0;
+
+        /** Hashes of every directory holding an entry, the archive only stores files. */
+        THashSet<uint64>            Directories;
+    };
+
+    /** Mounts every .lpak file of Directory at Alias in name order, so later archives patch earlier ones. */
+    RUNTIME_API void MountPaks(const FFixedString& Alias, FStringView Directory);
+}
@@ -0,0 +1,353 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include <fstream>
+
+#include "FileSystem/FileInfo.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/PakFileSystem.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        struct FSourceFile
+        {
+            FFixedString    Path;
+            TVector<uint8>  Contents;
+        };
+
+        /** Text like content that zstd shrinks, so packed archives mix compressed and raw blocks. */
+        TVector<uint8> MakeCompressible(size_t Size, uint32 Seed)
+        {
+            static constexpr char Words[][8] = { "local ", "entity ", "= ", "end\n", "mesh ", "0.5, ", "if ", "then\n" };
+
+            TVector<uint8> Contents;
+            Contents.reserve(Size);
+            uint32 State = Seed;
+            while (Contents.size() < Size)
+            {
+                State = State * 1664525u + 1013904223u;
+                const char* Word = Words[State >> 29];
+                Contents.insert(Contents.end(), Word, Word + strlen(Word));
+            }
+            Contents.resize(Size);
+            return Contents;
+        }
+
+        TVector<uint8> MakeIncompressible(size_t Size, uint32 Seed)
+        {
+            TVector<uint8> Contents(Size);
+            uint32 State = Seed;
+            for (uint8& Byte : Contents)
+            {
+                State = State * 1664525u + 1013904223u;
+                Byte = static_cast<uint8>(State >> 24);
+            }
+            return Contents;
+        }
+
+        /** Writes the files under a fresh scratch directory and returns its path on disk. */
+        FFixedString WriteSourceTree(FStringView Name, const TVector<FSourceFile>& Files)
+        {
+            FFixedString Root("/Engine/Cache/Automation/");
+            Root.append(Name.begin(), Name.end());
+            VFS::RemoveAll(Root);
+            VFS::CreateDir(Root);
+            Root = VFS::ResolvePath(Root);
+
+            for (const FSourceFile& File : Files)
+            {
+                const std::filesystem::path Path = std::filesystem::path(Root.c_str()) / std::filesystem::path(File.Path.c_str() + 1);
+                std::filesystem::create_directories(Path.parent_path());
+
+                std::ofstream Output(Path, std::ios::binary | std::ios::trunc);
+                Output.write(reinterpret_cast<const char*>(File.Contents.data()), static_cast<std::streamsize>(File.Contents.size()));
+            }
+
+            return Root;
+        }
+
+        FFixedString GetScratchPath(FStringView FileName)
+        {
+            FFixedString Path = VFS::ResolvePath("/Engine/Cache/Automation");
+            Path.append("/");
+            Path.append(FileName.begin(), FileName.end());
+            return Path;
+        }
+
+        FFixedString MakePakPath(FStringView Path)
+        {
+            FFixedString Result("/PakTest");
+            Result.append(Path.begin(), Path.end());
+            return Result;
+        }
+
+        TVector<uint8> ReadBytes(FStringView Path)
+        {
+            std::ifstream Input(std::filesystem::path(Path.begin(), Path.end()), std::ios::binary);
+            return TVector<uint8>(std::istreambuf_iterator<char>(Input), std::istreambuf_iterator<char>());
+        }
+
+        void WriteBytes(FStringView Path, const TVector<uint8>& Bytes)
+        {
+            std::ofstream Output(std::filesystem::path(Path.begin(), Path.end()), std::ios::binary | std::ios::trunc);
+            Output.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+        }
+
+        /** Block boundaries, an empty file and nested directories, compressible and not. */
+        TVector<FSourceFile> MakeRoundTripFiles()
+        {
+            constexpr size_t BlockSize = Pak::BlockSize;
+
+            TVector<FSourceFile> Files;
+            Files.push_back({ "/Empty.txt", {} });
+            Files.push_back({ "/Small.lua", MakeCompressible(300, 1) });
+            Files.push_back({ "/Blocks/Exact.bin", MakeCompressible(BlockSize, 2) });
+            Files.push_back({ "/Blocks/OneOver.bin", MakeCompressible(BlockSize + 1, 3) });
+            Files.push_back({ "/Blocks/Many.bin", MakeCompressible(BlockSize * 3 + BlockSize / 2, 4) });
+            Files.push_back({ "/Blocks/Noise.bin", MakeIncompressible(BlockSize * 2 + 17, 5) });
+            Files.push_back({ "/Content/Meshes/Deep/Rock.lasset", MakeCompressible(5'000, 6) });
+            Files.push_back({ "/Content/Meshes/Tree.lasset", MakeIncompressible(700, 7) });
+            return Files;
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("FileSystem.Pak.RoundTrip")
+    {
+        const TVector<FSourceFile> Files = MakeRoundTripFiles();
+        const FFixedString SourceRoot = WriteSourceTree("PakRoundTrip", Files);
+
+        for (const bool bCompress : { true, false })
+        {
+            const FFixedString ArchivePath = GetScratchPath(bCompress ? "RoundTripCompressed.lpak" : "RoundTripRaw.lpak");
+            TEST_CHECK(Pak::WriteArchive(SourceRoot, ArchivePath, bCompress));
+
+            VFS::FPakFileSystem Pak("/PakTest", ArchivePath);
+            TEST_CHECK(Pak.IsValid());
+            TEST_CHECK(Pak.GetNumEntries() == Files.size());
+
+            uint32 NumMismatched = 0;
+            for (const FSourceFile& File : Files)
+            {
+                const FFixedString Path = MakePakPath(File.Path);
+
+                TVector<uint8> Bytes;
+                NumMismatched += !Pak.ReadFile(Bytes, Path) || Bytes != File.Contents;
+
+                FString String;
+                NumMismatched += !Pak.ReadFile(String, Path) || String != FString(reinterpret_cast<const char*>(File.Contents.data()), File.Contents.size());
+
+                NumMismatched += !Pak.Exists(Path) || Pak.IsDirectory(Path) || Pak.Size(Path) != File.Contents.size();
+
+                // Ranges straddling every block boundary, each one decompressing only part of a block.
+                for (uint64 Boundary = Pak::BlockSize; Boundary < File.Contents.size(); Boundary += Pak::BlockSize)
+                {
+                    const uint64 Offset = Boundary - 10;
+                    NumMismatched += !Pak.ReadFileRange(Bytes, Path, Offset, 20);
+                    NumMismatched += Bytes.size() != 20 || !eastl::equal(Bytes.begin(), Bytes.end(), File.Contents.begin() + Offset);
+                }
+
+                // Ranges running past the end are clamped, ranges starting past it fail.
+                NumMismatched += !Pak.ReadFileRange(Bytes, Path, File.Contents.size() / 2, ~0ull);
+                NumMismatched += Bytes.size() != File.Contents.size() - File.Contents.size() / 2;
+                NumMismatched += !eastl::equal(Bytes.begin(), Bytes.end(), File.Contents.begin() + File.Contents.size() / 2);
+                NumMismatched += Pak.ReadFileRange(Bytes, Path, File.Contents.size() + 1, 1) || !Bytes.empty();
+            }
+            TEST_CHECK(NumMismatched == 0);
+
+            // Lookups ignore case and separators, like the loose file system on Windows.
+            TEST_CHECK(Pak.Exists("/PakTest/content/meshes/TREE.lasset"));
+            TEST_CHECK(Pak.Exists("/PakTest/Content\\Meshes\\Tree.lasset"));
+
+            TEST_CHECK(Pak.IsDirectory("/PakTest/Content/Meshes"));
+            TEST_CHECK(Pak.IsDirectory("/PakTest/Content/Meshes/"));
+            TEST_CHECK(!Pak.IsDirectory("/PakTest/Content/Textures"));
+            TEST_CHECK(Pak.IsEmpty("/PakTest/Empty.txt"));
+            TEST_CHECK(!Pak.IsEmpty("/PakTest/Content"));
+
+            TVector<uint8> Missing = { 1, 2, 3 };
+            TEST_CHECK(!Pak.ReadFile(Missing, "/PakTest/Missing.txt") && Missing.empty());
+            FString MissingString = "stale";
+            TEST_CHECK(!Pak.ReadFile(MissingString, "/PakTest/Missing.txt") && MissingString.empty());
+            TEST_CHECK(!Pak.Exists("/Other/Small.lua"));
+
+            TVector<FString> Children;
+            Pak.DirectoryIterator("/PakTest/Content/Meshes", [&](const VFS::FFileInfo& Info)
+            {
+                Children.push_back(Info.Name);
+                NumMismatched += !EnumHasAnyFlags(Info.Flags, VFS::EFileFlags::ReadOnly);
+            });
+            eastl::sort(Children.begin(), Children.end());
+            TEST_CHECK(Children.size() == 2 && Children[0] == "Deep" && Children[1] == "Tree.lasset");
+
+            uint32 NumRecursive = 0;
+            Pak.RecursiveDirectoryIterator("/PakTest/Content", [&](const VFS::FFileInfo&) { ++NumRecursive; });
+            TEST_CHECK(NumRecursive == 4);
+            TEST_CHECK(NumMismatched == 0);
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("FileSystem.Pak.RejectsCorruptArchives")
+    {
+        const TVector<FSourceFile> Files = MakeRoundTripFiles();
+        const FFixedString SourceRoot = WriteSourceTree("PakCorrupt", Files);
+        const FFixedString ArchivePath = GetScratchPath("Corrupt.lpak");
+        TEST_CHECK(Pak::WriteArchive(SourceRoot, ArchivePath, true));
+
+        const TVector<uint8> Valid = ReadBytes(ArchivePath);
+        TEST_CHECK(Valid.size() > sizeof(Pak::FPakHeader));
+
+        Pak::FPakHeader Header;
+        Memory::Memcpy(&Header, Valid.data(), sizeof(Header));
+
+        auto FindBlock = [&](Pak::EBlockFlags Flags)
+        {
+            for (uint64 i = 0; i < Header.NumBlocks; ++i)
+            {
+                Pak::FPakBlock Block;
+                Memory::Memcpy(&Block, Valid.data() + Header.BlockTableOffset + i * sizeof(Block), sizeof(Block));
+                if (Block.Flags == Flags)
+                {
+                    return Header.BlockTableOffset + i * sizeof(Block);
+                }
+            }
+            return 0ull;
+        };
+
+        const uint64 RawBlock = FindBlock(Pak::EBlockFlags::None);
+        const uint64 ZstdBlock = FindBlock(Pak::EBlockFlags::Zstd);
+        TEST_CHECK(RawBlock != 0 && ZstdBlock != 0);
+
+        auto IsMountable = [&](const char* Name, auto&& Corrupt)
+        {
+            TVector<uint8> Bytes = Valid;
+            Corrupt(Bytes);
+
+            const FFixedString Path = GetScratchPath(Name);
+            WriteBytes(Path, Bytes);
+            return VFS::FPakFileSystem("/PakTest", Path).IsValid();
+        };
+
+        auto Patch = [](TVector<uint8>& Bytes, uint64 Offset, auto Value)
+        {
+            Memory::Memcpy(Bytes.data() + Offset, &Value, sizeof(Value));
+        };
+
+        TEST_CHECK(IsMountable("Untouched.lpak", [](TVector<uint8>&) {}));
+        TEST_CHECK(!IsMountable("Truncated.lpak", [](TVector<uint8>& Bytes) { Bytes.resize(Bytes.size() - 1); }));
+        TEST_CHECK(!IsMountable("HeaderOnly.lpak", [](TVector<uint8>& Bytes) { Bytes.resize(sizeof(Pak::FPakHeader) - 1); }));
+        TEST_CHECK(!IsMountable("BadMagic.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, offsetof(Pak::FPakHeader, Magic), 0u); }));
+        TEST_CHECK(!IsMountable("ZeroBlockSize.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, offsetof(Pak::FPakHeader, BlockSize), 0u); }));
+        TEST_CHECK(!IsMountable("HugeBlockCount.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, offsetof(Pak::FPakHeader, NumBlocks), ~0ull / sizeof(Pak::FPakBlock) + 2); }));
+        TEST_CHECK(!IsMountable("WrappingIndex.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, offsetof(Pak::FPakHeader, IndexOffset), ~0ull - 8); }));
+        TEST_CHECK(!IsMountable("HugePaths.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, offsetof(Pak::FPakHeader, PathsSize), Header.PathsSize + 1); }));
+
+        // The first entry's fields, the index is written right after the block table.
+        const uint64 Entry = Header.IndexOffset;
+        TEST_CHECK(!IsMountable("EntryPathOffset.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, Entry + offsetof(Pak::FPakEntry, PathOffset), (uint32)Header.PathsSize); }));
+        TEST_CHECK(!IsMountable("EntryPathLength.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, Entry + offsetof(Pak::FPakEntry, PathLength), ~0u); }));
+        TEST_CHECK(!IsMountable("EntryFirstBlock.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, Entry + offsetof(Pak::FPakEntry, FirstBlock), ~0ull); }));
+        TEST_CHECK(!IsMountable("EntrySize.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, Entry + offsetof(Pak::FPakEntry, Size), ~0ull); }));
+        TEST_CHECK(!IsMountable("UnsortedIndex.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, Entry + offsetof(Pak::FPakEntry, PathHash), ~0ull); }));
+
+        TEST_CHECK(!IsMountable("UnknownFlags.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, ZstdBlock + offsetof(Pak::FPakBlock, Flags), 7u); }));
+        TEST_CHECK(!IsMountable("ShortRawBlock.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, RawBlock + offsetof(Pak::FPakBlock, StoredSize), 1u); }));
+        TEST_CHECK(!IsMountable("BlockPastEnd.lpak", [&](TVector<uint8>& Bytes) { Patch(Bytes, ZstdBlock + offsetof(Pak::FPakBlock, Offset), (uint64)Bytes.size()); }));
+
+        // Compressed data is only checked when it is read, a broken frame fails the read and leaves nothing behind.
+        Pak::FPakBlock Block;
+        Memory::Memcpy(&Block, Valid.data() + ZstdBlock, sizeof(Block));
+        TVector<uint8> Broken = Valid;
+        Memory::Memzero(Broken.data() + Block.Offset, eastl::min<uint64>(Block.StoredSize, 8));
+
+        const FFixedString BrokenPath = GetScratchPath("BrokenFrame.lpak");
+        WriteBytes(BrokenPath, Broken);
+        VFS::FPakFileSystem Pak("/PakTest", BrokenPath);
+        TEST_CHECK(Pak.IsValid());
+
+        uint32 NumFailed = 0;
+        for (const FSourceFile& File : Files)
+        {
+            FString String = "stale";
+            TVector<uint8> Bytes = { 1 };
+            const FFixedString Path = MakePakPath(File.Path);
+            if (!Pak.ReadFile(String, Path))
+            {
+                ++NumFailed;
+                TEST_CHECK(String.empty());
+                TEST_CHECK(!Pak.ReadFile(Bytes, Path) && Bytes.empty());
+            }
+        }
+        TEST_CHECK(NumFailed == 1);
+    }
+
+    // 10k small files, the way a packaged project's scripts and assets are laid out: packing, mounting,
+    // then looking up and reading every file from the pak against reading the loose files.
+    LUMINA_AUTOMATION_TEST("Benchmark.FileSystem.Pak10kFiles")
+    {
+        constexpr uint32 NumFiles = 10'000;
+        constexpr uint32 NumDirectories = 100;
+
+        TVector<FSourceFile> Files;
+        Files.reserve(NumFiles);
+        for (uint32 i = 0; i < NumFiles; ++i)
+        {
+            FFixedString Path;
+            Path.sprintf("/Dir%03u/File%05u.lua", i % NumDirectories, i);
+            Files.push_back({ Path, MakeCompressible(200 + (i * 7919u) % 8'000, i + 1) });
+        }
+
+        const FFixedString SourceRoot = WriteSourceTree("Pak10k", Files);
+        const FFixedString ArchivePath = GetScratchPath("Pak10k.lpak");
+
+        auto Time = [](auto&& Func)
+        {
+            const auto Start = std::chrono::high_resolution_clock::now();
+            Func();
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+            return Duration.count();
+        };
+
+        bool bWritten = false;
+        const double PackMs = Time([&] { bWritten = Pak::WriteArchive(SourceRoot, ArchivePath, true); });
+        TEST_CHECK(bWritten);
+
+        TOptional<VFS::FPakFileSystem> Pak;
+        const double MountMs = Time([&] { Pak.emplace("/PakTest", ArchivePath); });
+        TEST_CHECK(Pak->IsValid() && Pak->GetNumEntries() == NumFiles);
+
+        uint32 NumMismatched = 0;
+        uint64 NumBytes = 0;
+        TVector<uint8> Bytes;
+        const double PakReadMs = Time([&]
+        {
+            for (const FSourceFile& File : Files)
+            {
+                NumMismatched += !Pak->ReadFile(Bytes, MakePakPath(File.Path)) || Bytes.size() != File.Contents.size();
+                NumBytes += Bytes.size();
+            }
+        });
+
+        VFS::FNativeFileSystem Loose("/LooseTest", SourceRoot);
+        const double LooseReadMs = Time([&]
+        {
+            for (const FSourceFile& File : Files)
+            {
+                FFixedString Path("/LooseTest");
+                Path.append(File.Path.begin(), File.Path.end());
+                NumMismatched += !Loose.ReadFile(Bytes, Path) || Bytes.size() != File.Contents.size();
+            }
+        });
+
+        TEST_CHECK(NumMismatched == 0);
+
+        LOG_INFO("[{}] {} files, {:.2f} MiB: pack {:.1f} ms, mount {:.3f} ms, pak reads {:.1f} ms, loose reads {:.1f} ms, archive {:.2f} MiB",
+            Test.GetName(), NumFiles, static_cast<double>(NumBytes) / (1024.0 * 1024.0), PackMs, MountMs, PakReadMs, LooseReadMs,
+            static_cast<double>(std::filesystem::file_size(ArchivePath.c_str())) / (1024.0 * 1024.0));
+    }
+}
+
+#endif
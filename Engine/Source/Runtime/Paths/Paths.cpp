@@ -15,6 +15,7 @@ namespace Lumina::Paths
         const char* EngineConfigDirectoryName       = "EngineConfigDirectory";
         const char* EngineInstallDirectoryName      = "EngineInstallDirectory";
         const char* EngineDirectoryName             = "EngineDirectory";
+        const char* EngineCacheDirectoryName        = "EngineCacheDirectory";
 
     }
 
@@ -30,6 +31,7 @@ namespace Lumina::Paths
         CachedDirectories[EngineFontDirectoryName]      = GetEngineResourceDirectory() + "/Fonts";
         CachedDirectories[EngineContentDirectoryName]   = GetEngineResourceDirectory() + "/Content";
         CachedDirectories[EngineShadersDirectoryName]   = GetEngineResourceDirectory() + "/Shaders";
+        CachedDirectories[EngineCacheDirectoryName]     = GetEngineDirectory() + "/Cache";
         
     }
 
@@ -161,6 +163,11 @@ namespace Lumina::Paths
         return CachedDirectories[EngineShadersDirectoryName];
     }
 
+    const FString& GetEngineCacheDirectory()
+    {
+        return CachedDirectories[EngineCacheDirectoryName];
+    }
+
     FString Parent(FStringView Path, bool bRemoveTrailingSlash)
     {
         auto data = Path.data();
@@ -59,6 +59,9 @@ namespace Lumina::Paths
     /** Gets the path to the engine's shaders */
     RUNTIME_API const FString& GetEngineShadersDirectory();
     
+    /** Gets the directory for locally generated data, such as compiled shaders. Safe to delete. */
+    RUNTIME_API const FString& GetEngineCacheDirectory();
+    
     /** Gets the engine installation directory (one level above the engine binary). */
     RUNTIME_API const FString& GetEngineInstallDirectory();
 
@@ -0,0 +1,124 @@
+#include "pch.h"
+#include "JoltCooking.h"
+
+#include <Jolt/Physics/Collision/Shape/ConvexHullShape.h>
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+
+#include "JoltStreams.h"
+#include "Core/Profiler/Profile.h"
+#include "Renderer/MeshData.h"
+
+namespace Lumina::Physics::JoltCooking
+{
+    namespace
+    {
+        /** Jolt's binary state is only readable by the build that wrote it, the version id also covers precision and feature flags. */
+        constexpr uint64 CookedFormatID = JPH_VERSION_ID;
+    }
+
+    JPH::ShapeRefC CreateMeshShape(const FMeshResource& Mesh, ECollisionMeshType Type)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        JPH::ShapeSettings::ShapeResult Result;
+        if (Type == ECollisionMeshType::TriangleMesh)
+        {
+            JPH::VertexList Vertices;
+            eastl::visit([&](const auto& Source)
+            {
+                Vertices.reserve(Source.size());
+                for (const auto& Vertex : Source)
+                {
+                    Vertices.emplace_back(Vertex.Position.x, Vertex.Position.y, Vertex.Position.z);
+                }
+            }, Mesh.Vertices);
+
+            // Only the full detail surfaces, the simplified levels share the index buffer after them.
+            JPH::IndexedTriangleList Triangles;
+            Triangles.reserve(Mesh.GetLODNumIndices(0) / 3);
+            for (const FGeometrySurface& Surface : Mesh.GeometrySurfaces)
+            {
+                for (uint32 i = 0; i + 2 < Surface.IndexCount; i += 3)
+                {
+                    const uint32* Triangle = Mesh.Indices.data() + Surface.StartIndex + i;
+                    Triangles.emplace_back(Triangle[0], Triangle[1], Triangle[2]);
+                }
+            }
+
+            JPH::MeshShapeSettings Settings(Move(Vertices), Move(Triangles));
+            Settings.SetEmbedded();
+            Result = Settings.Create();
+        }
+        else
+        {
+            JPH::Array<JPH::Vec3> Points;
+            eastl::visit([&](const auto& Source)
+            {
+                Points.reserve(Source.size());
+                for (const auto& Vertex : Source)
+                {
+                    Points.emplace_back(Vertex.Position.x, Vertex.Position.y, Vertex.Position.z);
+                }
+            }, Mesh.Vertices);
+
+            JPH::ConvexHullShapeSettings Settings(Points);
+            Settings.SetEmbedded();
+            Result = Settings.Create();
+        }
+
+        if (Result.HasError())
+        {
+            LOG_ERROR("Failed to build collision for mesh {} - {}", Mesh.Name.c_str(), Result.GetError());
+            return nullptr;
+        }
+
+        return Result.Get();
+    }
+
+    bool SaveShape(const JPH::Shape* Shape, TVector<uint8>& OutData)
+    {
+        OutData.clear();
+        if (Shape == nullptr)
+        {
+            return false;
+        }
+
+        FJoltVectorStreamOut Stream(OutData);
+        Stream.Write(CookedFormatID);
+
+        JPH::Shape::ShapeToIDMap ShapeMap;
+        JPH::Shape::MaterialToIDMap MaterialMap;
+        Shape->SaveWithChildren(Stream, ShapeMap, MaterialMap);
+
+        return true;
+    }
+
+    JPH::ShapeRefC RestoreShape(TSpan<const uint8> Data)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        if (Data.empty())
+        {
+            return nullptr;
+        }
+
+        FJoltSpanStreamIn Stream(Data);
+
+        uint64 FormatID = 0;
+        Stream.Read(FormatID);
+        if (Stream.IsFailed() || FormatID != CookedFormatID)
+        {
+            return nullptr;
+        }
+
+        JPH::Shape::IDToShapeMap ShapeMap;
+        JPH::Shape::IDToMaterialMap MaterialMap;
+        JPH::Shape::ShapeResult Result = JPH::Shape::sRestoreWithChildren(Stream, ShapeMap, MaterialMap);
+        if (Result.HasError() || Stream.IsFailed())
+        {
+            return nullptr;
+        }
+
+        return Result.Get();
+    }
+}
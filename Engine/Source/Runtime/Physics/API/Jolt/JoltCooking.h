@@ -0,0 +1,18 @@
+#pragma once
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include "Containers/Array.h"
+#include "Physics/Physics.h"
+
+namespace Lumina::Physics::JoltCooking
+{
+    /** Builds the shape from the mesh's full detail surfaces, the BVH and hull construction here is what cooking saves at load. */
+    JPH::ShapeRefC CreateMeshShape(const FMeshResource& Mesh, ECollisionMeshType Type);
+
+    /** Writes the shape, its children and materials behind a header naming the Jolt build that wrote them. */
+    bool SaveShape(const JPH::Shape* Shape, TVector<uint8>& OutData);
+
+    /** Returns null for empty data or data written by a different Jolt build, the caller cooks again from the mesh. */
+    JPH::ShapeRefC RestoreShape(TSpan<const uint8> Data);
+}
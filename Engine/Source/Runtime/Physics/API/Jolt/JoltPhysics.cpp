@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "JoltPhysics.h"
 
+#include "JoltCooking.h"
 #include "JoltPhysicsScene.h"
 #include "Core/Threading/Thread.h"
 #include "Jolt/RegisterTypes.h"
@@ -144,6 +145,14 @@ namespace Lumina::Physics
         return MakeUnique<FJoltPhysicsScene>(World);
     }
 
+    bool FJoltPhysicsContext::CookMeshCollision(const FMeshResource& Mesh, ECollisionMeshType Type, TVector<uint8>& OutData)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        JPH::ShapeRefC Shape = JoltCooking::CreateMeshShape(Mesh, Type);
+        return JoltCooking::SaveShape(Shape, OutData);
+    }
+
     JPH::JobSystemThreadPool* FJoltPhysicsContext::GetThreadPool()
     {
         return JoltData->JobThreadPool.get();
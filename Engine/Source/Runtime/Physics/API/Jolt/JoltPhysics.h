@@ -45,6 +45,7 @@ namespace Lumina::Physics
         void Initialize() override;
         void Shutdown() override;
         TUniquePtr<IPhysicsScene> CreatePhysicsScene(CWorld* World) override;
+        bool CookMeshCollision(const FMeshResource& Mesh, ECollisionMeshType Type, TVector<uint8>& OutData) override;
 
         static JPH::JobSystemThreadPool* GetThreadPool();
 		static FJoltDebugRenderer* GetDebugRenderer();
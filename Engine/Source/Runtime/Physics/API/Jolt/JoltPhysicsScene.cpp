@@ -7,20 +7,25 @@
 
 #include <algorithm>
 #include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
 #include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 #include <Jolt/Physics/Collision/RayCast.h>
 #include <Jolt/Physics/Collision/ShapeCast.h>
 #include <Jolt/Renderer/DebugRendererSimple.h>
 
+#include "JoltCooking.h"
 #include "JoltPhysics.h"
 #include "JoltUtils.h"
+#include "Assets/AssetTypes/Mesh/StaticMesh/StaticMesh.h"
 #include "Core/Console/ConsoleVariable.h"
 #include "Core/Profiler/Profile.h"
 #include "Core/Utils/Defer.h"
 #include "Jolt/Physics/Body/BodyCreationSettings.h"
 #include "Jolt/Physics/Collision/Shape/BoxShape.h"
+#include "Jolt/Physics/Collision/Shape/ScaledShape.h"
 #include "Jolt/Physics/Collision/Shape/SphereShape.h"
 #include "Renderer/RendererUtils.h"
+#include "TaskSystem/TaskSystem.h"
 #include "World/World.h"
 #include "World/Entity/Components/CharacterComponent.h"
 #include "World/Entity/Components/CharacterControllerComponent.h"
@@ -56,7 +61,31 @@ namespace Lumina::Physics
 
         return Layers::NON_MOVING;
     }
-    
+
+    /** Triangle meshes have no volume to derive mass from, they can be moved but never simulated. */
+    constexpr EBodyType GetSupportedBodyType(EBodyType BodyType, bool bTriangleMesh)
+    {
+        return bTriangleMesh && BodyType == EBodyType::Dynamic ? EBodyType::Kinematic : BodyType;
+    }
+
+    /** Batches smaller than this are built inline, for a single runtime spawn the task dispatch costs more than the work. */
+    constexpr uint32 MinParallelBodies = 32;
+
+    template<typename TFunc>
+    void ForEachIndex(uint32 Num, bool bParallel, TFunc&& Func)
+    {
+        if (bParallel)
+        {
+            Task::ParallelFor(Num, Forward<TFunc>(Func));
+            return;
+        }
+
+        for (uint32 i = 0; i < Num; ++i)
+        {
+            Func(i);
+        }
+    }
+
     class FObjectVsBroadPhaseLayerFilterImpl : public JPH::ObjectVsBroadPhaseLayerFilter
     {
     public:
@@ -92,9 +121,213 @@ namespace Lumina::Physics
         }
     };
 
+    static TConsoleVar CVarPhysicsMaxBodies("Physics.MaxBodies", 131072, "Rigid bodies a physics scene has room for, read when a world creates its scene. Body pairs and contacts scale with it.");
+    static TConsoleVar CVarPhysicsParallelBodyCreation("Physics.ParallelBodyCreation", true, "Builds the shapes and creation settings of large rigid body batches on the task system.");
+    static TConsoleVar CVarPhysicsParallelQueries("Physics.ParallelQueries", true, "Runs batched ray casts, sphere sweeps and overlaps on the task system.");
+    static TConsoleVar CVarPhysicsActiveBodySync("Physics.ActiveBodySync", true, "Syncs transforms from Jolt's active body list only, rather than checking every rigid body for activity each frame.");
+    static TConsoleVar CVarPhysicsInterpolation("Physics.Interpolation", true, "Blends rigid body transforms between the last two fixed physics steps so motion stays smooth at any frame rate.");
+    static TConsoleVar CVarPhysicsSnapshotFrames("Physics.Snapshot.Frames", 0, "Physics updates whose state is kept for rewinding with RestoreSnapshot, 0 disables recording.");
+    static TConsoleVar CVarPhysicsSnapshotKeyframeInterval("Physics.Snapshot.KeyframeInterval", 30, "Every n-th snapshot is stored in full, the ones between only keep the bytes that changed.");
+
     static FObjectLayerPairFilterImpl GObjectVsObjectLayerFilter;
     static FObjectVsBroadPhaseLayerFilterImpl GObjectVsBroadPhaseLayerFilter;
 
+    class FIgnoreBodiesFilter : public JPH::BodyFilter
+    {
+    public:
+        FIgnoreBodiesFilter(TSpan<const int64> InIgnoreBodies)
+        {
+            eastl::transform(
+                InIgnoreBodies.begin(), 
+                InIgnoreBodies.end(),
+                eastl::insert_iterator(IgnoreBodies, IgnoreBodies.end()),
+                [](const int64& Body) { return Body; }
+            );
+        }
+        
+        bool ShouldCollide(const JPH::BodyID& inBodyID) const override
+        {
+            return IgnoreBodies.find(inBodyID.GetIndexAndSequenceNumber()) == IgnoreBodies.end();
+        }
+
+        TFixedHashSet<int64, 4> IgnoreBodies;
+    };
+
+    /** Closest hit of a single ray, safe to call from any thread while the physics system is not updating. */
+    static bool CastSingleRay(const JPH::NarrowPhaseQuery& Query, const JPH::BodyLockInterface& LockInterface, const FRayCastSettings& Settings, FRayResult& OutResult)
+    {
+        JPH::Vec3 JPHStart  = JoltUtils::ToJPHVec3(Settings.Start);
+        JPH::Vec3 JPHEnd    = JoltUtils::ToJPHVec3(Settings.End);
+        JPH::Vec3 Direction = JPHEnd - JPHStart;
+        
+        if (Direction.Length() < LE_SMALL_NUMBER)
+        {
+            return false;
+        }
+        
+        JPH::RRayCast Ray;
+        Ray.mOrigin = JPHStart;
+        Ray.mDirection = Direction;
+        
+        FIgnoreBodiesFilter IgnoreFilter{Settings.IgnoreBodies};
+        
+        JPH::RayCastResult Hit;
+        if (!Query.CastRay(Ray, Hit, {}, {}, IgnoreFilter))
+        {
+            return false;
+        }
+        
+        const JPH::Body* Body = LockInterface.TryGetBody(Hit.mBodyID);
+        if (!Body)
+        {
+            return false;
+        }
+        
+        JPH::Vec3 SurfaceNormal = Body->GetWorldSpaceSurfaceNormal(Hit.mSubShapeID2, Ray.GetPointOnRay(Hit.mFraction));
+        
+        OutResult = FRayResult
+        {
+            .BodyID     = Hit.mBodyID.GetIndexAndSequenceNumber(),
+            .Entity     = static_cast<uint32>(Body->GetUserData()),
+            .Start      = Settings.Start,
+            .End        = Settings.End,
+            .Location   = JoltUtils::FromJPHRVec3(Ray.GetPointOnRay(Hit.mFraction)),
+            .Normal     = glm::normalize(JoltUtils::FromJPHVec3(SurfaceNormal)),
+            .Fraction   = Hit.mFraction
+        };
+        
+        return true;
+    }
+
+    /** Appends every hit of a sphere sweep to OutHits, closest first. */
+    static void SweepSingleSphere(const JPH::NarrowPhaseQuery& Query, const JPH::BodyLockInterface& LockInterface, const FSphereCastSettings& Settings, TVector<FRayResult>& OutHits)
+    {
+        JPH::RVec3 JPHStart = JoltUtils::ToJPHRVec3(Settings.Start);
+        JPH::Vec3 Direction = JoltUtils::ToJPHRVec3(Settings.End) - JPHStart;
+        
+        JPH::SphereShape QuerySphere(Settings.Radius);
+        QuerySphere.SetEmbedded();
+        
+        JPH::RShapeCast ShapeCast = JPH::RShapeCast::sFromWorldTransform(&QuerySphere, JPH::Vec3::sReplicate(1.0f), JPH::RMat44::sTranslation(JPHStart), Direction);
+        
+        JPH::ShapeCastSettings ShapeSettings;
+        ShapeSettings.mBackFaceModeTriangles    = JPH::EBackFaceMode::CollideWithBackFaces;
+        ShapeSettings.mBackFaceModeConvex       = JPH::EBackFaceMode::CollideWithBackFaces;
+        ShapeSettings.mReturnDeepestPoint       = false;
+        
+        FIgnoreBodiesFilter IgnoreFilter{Settings.IgnoreBodies};
+        JPH::AllHitCollisionCollector<JPH::CastShapeCollector> Collector;
+        Query.CastShape(ShapeCast, ShapeSettings, JPH::RVec3::sZero(), Collector, {}, {}, IgnoreFilter);
+        
+        Collector.Sort();
+        for (const JPH::ShapeCastResult& Hit : Collector.mHits)
+        {
+            const JPH::Body* Body = LockInterface.TryGetBody(Hit.mBodyID2);
+            if (!Body)
+            {
+                continue;
+            }
+            
+            OutHits.push_back(FRayResult
+            {
+                .BodyID     = Hit.mBodyID2.GetIndexAndSequenceNumber(),
+                .Entity     = static_cast<uint32>(Body->GetUserData()),
+                .Start      = Settings.Start,
+                .End        = Settings.End,
+                .Location   = JoltUtils::FromJPHVec3(Hit.mContactPointOn2),
+                .Normal     = glm::normalize(JoltUtils::FromJPHVec3(Hit.mPenetrationAxis)),
+                .Fraction   = Hit.mFraction
+            });
+        }
+    }
+
+    /** Appends every body touching a sphere to OutHits. */
+    static void OverlapSingleSphere(const JPH::NarrowPhaseQuery& Query, const JPH::BodyLockInterface& LockInterface, const FSphereOverlapSettings& Settings, TVector<FRayResult>& OutHits)
+    {
+        JPH::SphereShape QuerySphere(Settings.Radius);
+        QuerySphere.SetEmbedded();
+        
+        JPH::CollideShapeSettings CollideSettings;
+        CollideSettings.mBackFaceMode = JPH::EBackFaceMode::CollideWithBackFaces;
+        
+        FIgnoreBodiesFilter IgnoreFilter{Settings.IgnoreBodies};
+        JPH::AllHitCollisionCollector<JPH::CollideShapeCollector> Collector;
+        Query.CollideShape(&QuerySphere, JPH::Vec3::sReplicate(1.0f), JPH::RMat44::sTranslation(JoltUtils::ToJPHRVec3(Settings.Center)), CollideSettings, JPH::RVec3::sZero(), Collector, {}, {}, IgnoreFilter);
+        
+        for (const JPH::CollideShapeResult& Hit : Collector.mHits)
+        {
+            const JPH::Body* Body = LockInterface.TryGetBody(Hit.mBodyID2);
+            if (!Body)
+            {
+                continue;
+            }
+            
+            OutHits.push_back(FRayResult
+            {
+                .BodyID     = Hit.mBodyID2.GetIndexAndSequenceNumber(),
+                .Entity     = static_cast<uint32>(Body->GetUserData()),
+                .Start      = Settings.Center,
+                .End        = Settings.Center,
+                .Location   = JoltUtils::FromJPHVec3(Hit.mContactPointOn2),
+                .Normal     = glm::normalize(JoltUtils::FromJPHVec3(Hit.mPenetrationAxis)),
+                .Fraction   = 0.0f
+            });
+        }
+    }
+
+    /**
+     * Runs a query per descriptor that may hit any number of bodies. Queries go out in fixed blocks that each fill their own
+     * hit list, the lists are then joined in query order so the output does not depend on which worker ran what.
+     */
+    template<typename TSettings, typename TQueryFunc>
+    static void RunMultiHitBatch(TSpan<const TSettings> Queries, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges, TQueryFunc&& QueryFunc)
+    {
+        ASSERT(Ranges.size() >= Queries.size());
+        
+        Hits.clear();
+        
+        const uint32 NumQueries = static_cast<uint32>(Queries.size());
+        if (NumQueries == 0)
+        {
+            return;
+        }
+        
+        constexpr uint32 QueriesPerBlock = 64;
+        const uint32 NumBlocks = (NumQueries + QueriesPerBlock - 1) / QueriesPerBlock;
+        
+        TVector<TVector<FRayResult>> BlockHits(NumBlocks);
+        ForEachIndex(NumBlocks, CVarPhysicsParallelQueries.GetValue(), [&](uint32 Block)
+        {
+            TVector<FRayResult>& LocalHits = BlockHits[Block];
+            const uint32 End = eastl::min(NumQueries, (Block + 1) * QueriesPerBlock);
+            for (uint32 i = Block * QueriesPerBlock; i < End; ++i)
+            {
+                Ranges[i].Offset = static_cast<uint32>(LocalHits.size());
+                QueryFunc(Queries[i], LocalHits);
+                Ranges[i].Count = static_cast<uint32>(LocalHits.size()) - Ranges[i].Offset;
+            }
+        });
+        
+        size_t NumHits = 0;
+        for (const TVector<FRayResult>& LocalHits : BlockHits)
+        {
+            NumHits += LocalHits.size();
+        }
+        
+        Hits.reserve(NumHits);
+        for (uint32 Block = 0; Block < NumBlocks; ++Block)
+        {
+            const uint32 BlockOffset = static_cast<uint32>(Hits.size());
+            const uint32 End = eastl::min(NumQueries, (Block + 1) * QueriesPerBlock);
+            for (uint32 i = Block * QueriesPerBlock; i < End; ++i)
+            {
+                Ranges[i].Offset += BlockOffset;
+            }
+            
+            Hits.insert(Hits.end(), BlockHits[Block].begin(), BlockHits[Block].end());
+        }
+    }
+
 
     void FJoltContactListener::OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings)
     {
@@ -126,7 +359,9 @@ namespace Lumina::Physics
         JoltSystem = MakeUnique<JPH::PhysicsSystem>();
         JoltInterfaceLayer = MakeUnique<FLayerInterfaceImpl>();
         
-        JoltSystem->Init(65536, 0, 131072, 262144, *JoltInterfaceLayer, GObjectVsBroadPhaseLayerFilter, GObjectVsObjectLayerFilter);
+        // Pairs and contacts keep the ratio to bodies the old fixed limits of 65536, 131072 and 262144 had.
+        const uint32 MaxBodies = static_cast<uint32>(eastl::clamp(CVarPhysicsMaxBodies.GetValue(), 1024, static_cast<int32>(JPH::BodyID::cMaxBodyIndex) + 1));
+        JoltSystem->Init(MaxBodies, 0, MaxBodies * 2, MaxBodies * 4, *JoltInterfaceLayer, GObjectVsBroadPhaseLayerFilter, GObjectVsObjectLayerFilter);
         JoltSystem->SetGravity(JPH::Vec3Arg(0.0f, GEarthGravity, 0.0f));
 
         JPH::PhysicsSettings JoltSettings;
@@ -136,10 +371,15 @@ namespace Lumina::Physics
         ContactListener = MakeUnique<FJoltContactListener>(Dispatcher, &JoltSystem->GetBodyLockInterfaceNoLock());
         JoltSystem->SetContactListener(ContactListener.get());
         
+        ActivationListener = MakeUnique<FJoltActivationListener>();
+        JoltSystem->SetBodyActivationListener(ActivationListener.get());
+        
         FEntityRegistry& Registry = World->GetEntityRegistry();
         
         Registry.on_construct<SSphereColliderComponent>().connect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
         Registry.on_construct<SBoxColliderComponent>().connect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
+        Registry.on_construct<SMeshColliderComponent>().connect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
+        Registry.on_construct<SConvexHullColliderComponent>().connect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
     }
 
     FJoltPhysicsScene::~FJoltPhysicsScene()
@@ -148,6 +388,8 @@ namespace Lumina::Physics
 
         Registry.on_construct<SSphereColliderComponent>().disconnect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
         Registry.on_construct<SBoxColliderComponent>().disconnect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
+        Registry.on_construct<SMeshColliderComponent>().disconnect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
+        Registry.on_construct<SConvexHullColliderComponent>().disconnect<&entt::registry::emplace_or_replace<SRigidBodyComponent>>();
     }
 
     void FJoltPhysicsScene::PreUpdate()
@@ -162,6 +404,11 @@ namespace Lumina::Physics
         auto BodySyncView = Registry.view<SRigidBodyComponent, STransformComponent, FNeedsTransformUpdate>();
         BodySyncView.each([&](const SRigidBodyComponent& BodyComponent, const STransformComponent& TransformComponent, const FNeedsTransformUpdate& Update)
         {
+            if (Update.bFromPhysics)
+            {
+                return;
+            }
+            
             JPH::BodyID BodyID = JPH::BodyID(BodyComponent.BodyID);
 
             JPH::BodyLockRead Lock(LockInterface, BodyID);
@@ -169,8 +416,22 @@ namespace Lumina::Physics
             {
                 const JPH::Body& Body = Lock.GetBody();
                 
-                JPH::RVec3 Location = JoltUtils::ToJPHRVec3(TransformComponent.GetLocation());
-                JPH::Quat Rotation = JoltUtils::ToJPHQuat(TransformComponent.GetRotation());
+                glm::vec3 TargetLocation = TransformComponent.GetLocation();
+                glm::quat TargetRotation = TransformComponent.GetRotation();
+                
+                // An interpolated transform trails its body by up to one step. Teleports go exactly where they were asked to,
+                // other writes are applied as an offset from what was rendered. So is a flag on a transform nobody changed, it
+                // still holds the blended pose and pushing it as is would move the body back there.
+                auto Rendered = RenderedPoses.find(BodyComponent.BodyID);
+                const bool bUnchanged = Rendered != RenderedPoses.end() && TargetLocation == Rendered->second.Location && TargetRotation == Rendered->second.Rotation;
+                if (Rendered != RenderedPoses.end() && (Update.MoveMode != EMoveMode::Teleport || bUnchanged))
+                {
+                    TargetLocation = glm::vec3(JoltUtils::FromJPHRVec3(Body.GetPosition())) + (TargetLocation - Rendered->second.Location);
+                    TargetRotation = glm::normalize(TargetRotation * glm::inverse(Rendered->second.Rotation) * JoltUtils::FromJPHQuat(Body.GetRotation()));
+                }
+                
+                JPH::RVec3 Location = JoltUtils::ToJPHRVec3(TargetLocation);
+                JPH::Quat Rotation = JoltUtils::ToJPHQuat(TargetRotation);
                 JPH::EActivation Activation = Update.bActivate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
                 
                 if (Body.IsStatic())
@@ -255,20 +516,35 @@ namespace Lumina::Physics
         if (CollisionSteps > 0)
         {
             PreUpdate();
-
-            JoltSystem->Update(static_cast<float>(FixedTimeStep), CollisionSteps, &Allocator, FJoltPhysicsContext::GetThreadPool());
-        
-            PostUpdate();
             
-            Accumulator -= static_cast<double>(CollisionSteps) * FixedTimeStep;
-        
-            // Clamp accumulator if we hit max steps
+            // Clamp accumulator if we hit max steps, at most one step is left over afterwards.
             if (CollisionSteps >= MaxSteps)
             {
-                Accumulator = std::min(Accumulator, FixedTimeStep);
+                Accumulator = std::min(Accumulator, static_cast<double>(CollisionSteps + 1) * FixedTimeStep);
+            }
+            
+            // Every step advances exactly FixedTimeStep and is recorded on its own, so any simulation frame can be restored.
+            const double FrameAccumulator = Accumulator;
+            for (int Step = 1; Step <= CollisionSteps; ++Step)
+            {
+                // The poses before the last step are kept for interpolation.
+                if (Step == CollisionSteps)
+                {
+                    CapturePreviousPoses();
+                }
+                
+                JoltSystem->Update(static_cast<float>(FixedTimeStep), 1, &Allocator, FJoltPhysicsContext::GetThreadPool());
+                
+                Accumulator = FrameAccumulator - static_cast<double>(Step) * FixedTimeStep;
+                ++SimulationFrame;
+                RecordSnapshot();
             }
+        
+            PostUpdate();
         }
         
+        InterpolationAlpha = std::clamp(Accumulator / FixedTimeStep, 0.0, 1.0);
+        
         SyncTransforms();
         
         FJoltPhysicsContext::GetDebugRenderer()->NextFrame();
@@ -280,10 +556,8 @@ namespace Lumina::Physics
         
         auto View = Registry.view<SRigidBodyComponent>();
         
-        View.each([&] (entt::entity EntityID, SRigidBodyComponent&)
-        {
-            OnRigidBodyComponentConstructed(Registry, EntityID);
-        });
+        TVector<entt::entity> Entities(View.begin(), View.end());
+        CreateRigidBodies(Registry, Entities);
 
         auto CharacterView = Registry.view<SCharacterPhysicsComponent>();
         
@@ -292,8 +566,6 @@ namespace Lumina::Physics
             OnCharacterComponentConstructed(Registry, EntityID);
         });
         
-        JoltSystem->OptimizeBroadPhase();
-        
         Registry.on_construct<SCharacterPhysicsComponent>().connect<&FJoltPhysicsScene::OnCharacterComponentConstructed>(this);
         Registry.on_destroy<SCharacterPhysicsComponent>().connect<&FJoltPhysicsScene::OnCharacterComponentDestroyed>(this);
 
@@ -301,6 +573,9 @@ namespace Lumina::Physics
         Registry.on_construct<SRigidBodyComponent>().connect<&FJoltPhysicsScene::OnRigidBodyComponentConstructed>(this);
         Registry.on_destroy<SRigidBodyComponent>().connect<&FJoltPhysicsScene::OnRigidBodyComponentDestroyed>(this);
         
+        Registry.on_update<SMeshColliderComponent>().connect<&FJoltPhysicsScene::OnMeshColliderComponentUpdated>(this);
+        Registry.on_update<SConvexHullColliderComponent>().connect<&FJoltPhysicsScene::OnMeshColliderComponentUpdated>(this);
+        
         entt::dispatcher& Dispatcher = World->GetEntityRegistry().ctx().get<entt::dispatcher&>();
         Dispatcher.sink<SImpulseEvent>().connect<&FJoltPhysicsScene::OnImpulseEvent>(this);
         Dispatcher.sink<SForceEvent>().connect<&FJoltPhysicsScene::OnForceEvent>(this);
@@ -323,6 +598,9 @@ namespace Lumina::Physics
         Registry.on_construct<SRigidBodyComponent>().disconnect<&FJoltPhysicsScene::OnRigidBodyComponentConstructed>(this);
         Registry.on_destroy<SRigidBodyComponent>().disconnect<&FJoltPhysicsScene::OnRigidBodyComponentDestroyed>(this);
         
+        Registry.on_update<SMeshColliderComponent>().disconnect<&FJoltPhysicsScene::OnMeshColliderComponentUpdated>(this);
+        Registry.on_update<SConvexHullColliderComponent>().disconnect<&FJoltPhysicsScene::OnMeshColliderComponentUpdated>(this);
+        
         entt::dispatcher& Dispatcher = World->GetEntityRegistry().ctx().get<entt::dispatcher&>();
         Dispatcher.sink<SImpulseEvent>().disconnect<&FJoltPhysicsScene::OnImpulseEvent>(this);
         Dispatcher.sink<SForceEvent>().disconnect<&FJoltPhysicsScene::OnForceEvent>(this);
@@ -336,11 +614,30 @@ namespace Lumina::Physics
         
         
 
+        JPH::BodyInterface& BodyInterface = JoltSystem->GetBodyInterface();
+        
+        JPH::BodyIDVector BodyIDs;
         auto View = Registry.view<SRigidBodyComponent>();
-        View.each([&] (entt::entity EntityID, SRigidBodyComponent&)
+        View.each([&] (SRigidBodyComponent& RigidBodyComponent)
         {
-            OnRigidBodyComponentDestroyed(Registry, EntityID); 
+            JPH::BodyID BodyID(RigidBodyComponent.BodyID);
+            if (!BodyID.IsInvalid() && BodyInterface.IsAdded(BodyID))
+            {
+                BodyIDs.push_back(BodyID);
+            }
         });
+        
+        if (!BodyIDs.empty())
+        {
+            BodyInterface.RemoveBodies(BodyIDs.data(), static_cast<int>(BodyIDs.size()));
+            BodyInterface.DestroyBodies(BodyIDs.data(), static_cast<int>(BodyIDs.size()));
+        }
+        
+        ShapeCache.clear();
+        PreviousPoses.clear();
+        RenderedPoses.clear();
+        Snapshots.Clear();
+        SimulationFrame = 0;
     }
 
     void FJoltPhysicsScene::ActivateBody(uint32 BodyID)
@@ -358,7 +655,19 @@ namespace Lumina::Physics
     void FJoltPhysicsScene::ChangeBodyMotionType(uint32 BodyID, EBodyType NewType)
     {
         JPH::BodyInterface& BodyInterface = JoltSystem->GetBodyInterface();
-        BodyInterface.SetMotionType(JPH::BodyID(BodyID), JoltUtils::ToJoltMotionType(NewType), JPH::EActivation::Activate);
+        
+        // Scaled meshes wrap the shared shape, the mesh is the inner one.
+        JPH::ShapeRefC Shape = BodyInterface.GetShape(JPH::BodyID(BodyID));
+        if (Shape != nullptr && Shape->GetSubType() == JPH::EShapeSubType::Scaled)
+        {
+            Shape = static_cast<const JPH::ScaledShape*>(Shape.GetPtr())->GetInnerShape();
+        }
+        
+        const bool bTriangleMesh = Shape != nullptr && Shape->GetSubType() == JPH::EShapeSubType::Mesh;
+        BodyInterface.SetMotionType(JPH::BodyID(BodyID), JoltUtils::ToJoltMotionType(GetSupportedBodyType(NewType, bTriangleMesh)), JPH::EActivation::Activate);
+        
+        // Motion type is configuration rather than state, an older snapshot would be read with the wrong layout.
+        Snapshots.Clear();
     }
 
     void FJoltPhysicsScene::SyncTransforms()
@@ -368,23 +677,83 @@ namespace Lumina::Physics
         const JPH::BodyLockInterfaceNoLock& LockInterface = JoltSystem->GetBodyLockInterfaceNoLock();
         entt::registry& Registry = World->GetEntityRegistry();
 
-        auto View = Registry.view<SRigidBodyComponent, STransformComponent>();
-        View.each([&](entt::entity EntityID, const SRigidBodyComponent& BodyComponent, STransformComponent& TransformComponent)
+        const bool bInterpolate = CVarPhysicsInterpolation.GetValue();
+        const float Alpha = static_cast<float>(InterpolationAlpha);
+        
+        RenderedPoses.clear();
+
+        // The body user data holds its entity, set when the body is created.
+        auto SyncBody = [&](const JPH::BodyID& BodyID, bool bBlend)
         {
-            const JPH::Body* Body = LockInterface.TryGetBody(JPH::BodyID(BodyComponent.BodyID));
-            if (Body == nullptr || !Body->IsActive())
+            const JPH::Body* Body = LockInterface.TryGetBody(BodyID);
+            if (Body == nullptr)
+            {
+                return;
+            }
+            
+            entt::entity EntityID = static_cast<entt::entity>(Body->GetUserData());
+            if (!Registry.valid(EntityID))
+            {
+                return;
+            }
+            
+            // Character inner bodies are active bodies too, they are synced from their character below.
+            const SRigidBodyComponent* BodyComponent = Registry.try_get<SRigidBodyComponent>(EntityID);
+            STransformComponent* TransformComponent = Registry.try_get<STransformComponent>(EntityID);
+            if (BodyComponent == nullptr || TransformComponent == nullptr || BodyComponent->BodyID != BodyID.GetIndexAndSequenceNumber())
             {
                 return;
             }
             
-            JPH::RVec3 Pos = Body->GetPosition();
-            JPH::Quat Rot = Body->GetRotation();
+            glm::vec3 Location = JoltUtils::FromJPHRVec3(Body->GetPosition());
+            glm::quat Rotation = JoltUtils::FromJPHQuat(Body->GetRotation());
+            
+            // Only the rendered transform is blended, the body itself stays at the latest step.
+            if (bBlend)
+            {
+                auto It = PreviousPoses.find(BodyID.GetIndexAndSequenceNumber());
+                if (It != PreviousPoses.end())
+                {
+                    Location = glm::mix(It->second.Location, Location, Alpha);
+                    Rotation = glm::slerp(It->second.Rotation, Rotation, Alpha);
+                    RenderedPoses[BodyID.GetIndexAndSequenceNumber()] = FBodyPose{ .Location = Location, .Rotation = Rotation };
+                }
+            }
         
-            TransformComponent.SetLocation(JoltUtils::FromJPHRVec3(Pos));
-            TransformComponent.SetRotation(JoltUtils::FromJPHQuat(Rot));
+            TransformComponent->SetLocation(Location);
+            TransformComponent->SetRotation(Rotation);
             
-            Registry.emplace_or_replace<FNeedsTransformUpdate>(EntityID);
-        });
+            Registry.emplace_or_replace<FNeedsTransformUpdate>(EntityID, FNeedsTransformUpdate{ .bFromPhysics = true });
+        };
+        
+        // Only bodies that moved are visited, sleeping ones were synced once more as they fell asleep.
+        if (CVarPhysicsActiveBodySync.GetValue())
+        {
+            const uint32 NumActiveBodies = JoltSystem->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+            const JPH::BodyID* ActiveBodies = JoltSystem->GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody);
+            for (uint32 i = 0; i < NumActiveBodies; ++i)
+            {
+                SyncBody(ActiveBodies[i], bInterpolate);
+            }
+        }
+        else
+        {
+            Registry.view<SRigidBodyComponent, STransformComponent>().each([&](const SRigidBodyComponent& BodyComponent, const STransformComponent&)
+            {
+                const JPH::BodyID BodyID(BodyComponent.BodyID);
+                const JPH::Body* Body = LockInterface.TryGetBody(BodyID);
+                if (Body != nullptr && Body->IsActive())
+                {
+                    SyncBody(BodyID, bInterpolate);
+                }
+            });
+        }
+        
+        ActivationListener->ConsumeDeactivatedBodies(DeactivatedBodies);
+        for (const JPH::BodyID& BodyID : DeactivatedBodies)
+        {
+            SyncBody(BodyID, false);
+        }
 
         auto CharacterView = Registry.view<SCharacterPhysicsComponent, STransformComponent>();
         CharacterView.each([&](entt::entity Entity, const SCharacterPhysicsComponent& CharacterComponent, STransformComponent& TransformComponent)
@@ -399,73 +768,133 @@ namespace Lumina::Physics
         });
     }
 
-    TOptional<FRayResult> FJoltPhysicsScene::CastRay(const FRayCastSettings& Settings)
+    void FJoltPhysicsScene::CapturePreviousPoses()
     {
-        JPH::Vec3 JPHStart  = JoltUtils::ToJPHVec3(Settings.Start);
-        JPH::Vec3 JPHEnd    = JoltUtils::ToJPHVec3(Settings.End);
-        JPH::Vec3 Direction = JPHEnd - JPHStart;
+        LUMINA_PROFILE_SCOPE();
         
-        if (Direction.Length() < LE_SMALL_NUMBER)
+        PreviousPoses.clear();
+        if (!CVarPhysicsInterpolation.GetValue())
         {
-            return eastl::nullopt;
+            return;
         }
         
-        JPH::RRayCast Ray;
-        Ray.mOrigin = JPHStart;
-        Ray.mDirection = Direction;
+        const JPH::BodyLockInterfaceNoLock& LockInterface = JoltSystem->GetBodyLockInterfaceNoLock();
+        
+        const uint32 NumActiveBodies = JoltSystem->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+        const JPH::BodyID* ActiveBodies = JoltSystem->GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody);
+        PreviousPoses.reserve(NumActiveBodies);
         
-        class IgnoreFilter : public JPH::BodyFilter
+        for (uint32 i = 0; i < NumActiveBodies; ++i)
         {
-        public:
-            IgnoreFilter(TSpan<const int64> InIgnoreBodies)
+            if (const JPH::Body* Body = LockInterface.TryGetBody(ActiveBodies[i]))
             {
-                eastl::transform(
-                         InIgnoreBodies.begin(), 
-                         InIgnoreBodies.end(),
-                         eastl::insert_iterator(IgnoreBodies, IgnoreBodies.end()),
-                         [](const int64& Body) { return Body; }
-                     );
+                PreviousPoses[ActiveBodies[i].GetIndexAndSequenceNumber()] = FBodyPose
+                {
+                    .Location = JoltUtils::FromJPHRVec3(Body->GetPosition()),
+                    .Rotation = JoltUtils::FromJPHQuat(Body->GetRotation()),
+                };
             }
+        }
+    }
+
+    void FJoltPhysicsScene::RecordSnapshot()
+    {
+        const uint32 Capacity = static_cast<uint32>(eastl::max(CVarPhysicsSnapshotFrames.GetValue(), 0));
+        const uint32 KeyframeInterval = FJoltSnapshotHistory::ClampKeyframeInterval(Capacity, static_cast<uint32>(eastl::max(CVarPhysicsSnapshotKeyframeInterval.GetValue(), 1)));
+        if (Capacity != Snapshots.GetCapacity() || KeyframeInterval != Snapshots.GetKeyframeInterval())
+        {
+            Snapshots.Reset(Capacity, KeyframeInterval);
+        }
+        
+        if (Capacity == 0)
+        {
+            return;
+        }
         
-            bool ShouldCollide(const JPH::BodyID& inBodyID) const override
+        // Characters are not part of the physics system state, they follow it in view order.
+        entt::registry& Registry = World->GetEntityRegistry();
+        Snapshots.Record(SimulationFrame, Accumulator, [&](JPH::StateRecorder& Recorder)
+        {
+            JoltSystem->SaveState(Recorder);
+            
+            Registry.view<SCharacterPhysicsComponent>().each([&](const SCharacterPhysicsComponent& CharacterComponent)
             {
-                return IgnoreBodies.find(inBodyID.GetIndexAndSequenceNumber()) == IgnoreBodies.end();
-            }
+                if (CharacterComponent.Character)
+                {
+                    CharacterComponent.Character->SaveState(Recorder);
+                }
+            });
+        });
+    }
 
-            TFixedHashSet<int64, 4> IgnoreBodies;
-        };
+    bool FJoltPhysicsScene::RestoreSnapshot(uint64 Frame)
+    {
+        LUMINA_PROFILE_SCOPE();
         
-        IgnoreFilter IgnoreFilter{Settings.IgnoreBodies};
+        entt::registry& Registry = World->GetEntityRegistry();
         
+        const bool bRestored = Snapshots.Restore(Frame, [&](JPH::StateRecorder& Recorder)
+        {
+            if (!JoltSystem->RestoreState(Recorder))
+            {
+                return false;
+            }
+            
+            Registry.view<SCharacterPhysicsComponent>().each([&](SCharacterPhysicsComponent& CharacterComponent)
+            {
+                if (CharacterComponent.Character)
+                {
+                    CharacterComponent.Character->RestoreState(Recorder);
+                }
+            });
+            
+            return !Recorder.IsFailed();
+        });
         
-        JPH::RayCastResult Hit;
-        bool bHit = JoltSystem->GetNarrowPhaseQuery().CastRay(Ray, Hit, {}, {}, IgnoreFilter);
-        if (!bHit)
+        if (!bRestored)
         {
-            return eastl::nullopt;
+            LOG_WARN("Physics frame {} is not in the snapshot history, it holds {} frames up to {}", Frame, Snapshots.GetNumSnapshots(), SimulationFrame);
+            return false;
         }
         
+        SimulationFrame = Frame;
+        Accumulator = Snapshots.GetAccumulator(Frame).value_or(0.0);
+        InterpolationAlpha = std::clamp(Accumulator / FixedTimeStep, 0.0, 1.0);
+        PreviousPoses.clear();
+        RenderedPoses.clear();
+        
+        // Sleeping bodies may have been moved by the rewind too, so every body is written back instead of only the active ones.
         const JPH::BodyLockInterfaceNoLock& LockInterface = JoltSystem->GetBodyLockInterfaceNoLock();
+        auto View = Registry.view<SRigidBodyComponent, STransformComponent>();
+        View.each([&](entt::entity Entity, const SRigidBodyComponent& BodyComponent, STransformComponent& TransformComponent)
+        {
+            const JPH::Body* Body = LockInterface.TryGetBody(JPH::BodyID(BodyComponent.BodyID));
+            if (Body == nullptr)
+            {
+                return;
+            }
+            
+            TransformComponent.SetLocation(JoltUtils::FromJPHRVec3(Body->GetPosition()));
+            TransformComponent.SetRotation(JoltUtils::FromJPHQuat(Body->GetRotation()));
+            Registry.emplace_or_replace<FNeedsTransformUpdate>(Entity, FNeedsTransformUpdate{ .bFromPhysics = true });
+        });
         
-        JPH::Body* Body = LockInterface.TryGetBody(Hit.mBodyID);
-        if (!Body)
+        return true;
+    }
+
+    TOptional<uint64> FJoltPhysicsScene::GetSnapshotHash(uint64 Frame) const
+    {
+        return Snapshots.GetHash(Frame);
+    }
+
+    TOptional<FRayResult> FJoltPhysicsScene::CastRay(const FRayCastSettings& Settings)
+    {
+        FRayResult Result;
+        if (!CastSingleRay(JoltSystem->GetNarrowPhaseQuery(), JoltSystem->GetBodyLockInterfaceNoLock(), Settings, Result))
         {
             return eastl::nullopt;
         }
         
-        JPH::Vec3 SurfaceNormal = Body->GetWorldSpaceSurfaceNormal(Hit.mSubShapeID2, Ray.GetPointOnRay(Hit.mFraction));
-        
-        FRayResult Result
-        {
-            .BodyID     = Hit.mBodyID.GetIndexAndSequenceNumber(),
-            .Entity     = static_cast<uint32>(Body->GetUserData()),
-            .Start      = Settings.Start,
-            .End        = Settings.End,
-            .Location   = JoltUtils::FromJPHRVec3(Ray.GetPointOnRay(Hit.mFraction)),
-            .Normal     = glm::normalize(JoltUtils::FromJPHVec3(SurfaceNormal)),
-            .Fraction   = Hit.mFraction
-        };
-        
         return Result;
     }
 
@@ -475,33 +904,12 @@ namespace Lumina::Physics
         JPH::RVec3 JPHEnd    = JoltUtils::ToJPHRVec3(Settings.End);
         JPH::Vec3 Direction = (JPHEnd - JPHStart);
         
-        class IgnoreFilter : public JPH::BodyFilter
-        {
-        public:
-            IgnoreFilter(TSpan<const int64> InIgnoreBodies)
-            {
-                eastl::transform(
-                    InIgnoreBodies.begin(), 
-                    InIgnoreBodies.end(),
-                    eastl::insert_iterator(IgnoreBodies, IgnoreBodies.end()),
-                    [](const int64& Body) { return Body; }
-                );
-            }
-        
-            bool ShouldCollide(const JPH::BodyID& inBodyID) const override
-            {
-                return IgnoreBodies.find(inBodyID.GetIndexAndSequenceNumber()) == IgnoreBodies.end();
-            }
-    
-            TFixedHashSet<int64, 4> IgnoreBodies;
-        };
-        
-        IgnoreFilter Filter{Settings.IgnoreBodies};
+        FIgnoreBodiesFilter Filter{Settings.IgnoreBodies};
     
         class MyCollector : public JPH::CastShapeCollector
         {
         public:
-            TFixedVector<JPH::ShapeCastResult, 10> Results;
+            TVector<JPH::ShapeCastResult> Results;
             
             void AddHit(const JPH::ShapeCastResult& inResult) override
             {
@@ -608,6 +1016,55 @@ namespace Lumina::Physics
         return Results;
     }
 
+    void FJoltPhysicsScene::CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results)
+    {
+        LUMINA_PROFILE_SCOPE();
+        ASSERT(Results.size() >= Rays.size());
+        
+        if (Rays.empty())
+        {
+            return;
+        }
+        
+        const JPH::NarrowPhaseQuery& Query = JoltSystem->GetNarrowPhaseQueryNoLock();
+        const JPH::BodyLockInterface& LockInterface = JoltSystem->GetBodyLockInterfaceNoLock();
+        
+        ForEachIndex(static_cast<uint32>(Rays.size()), CVarPhysicsParallelQueries.GetValue(), [&](uint32 Index)
+        {
+            const FRayCastSettings& Ray = Rays[Index];
+            if (!CastSingleRay(Query, LockInterface, Ray, Results[Index]))
+            {
+                Results[Index] = FRayResult{ .Start = Ray.Start, .End = Ray.End, .Location = Ray.End, .Fraction = 1.0f };
+            }
+        });
+    }
+
+    void FJoltPhysicsScene::CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        const JPH::NarrowPhaseQuery& Query = JoltSystem->GetNarrowPhaseQueryNoLock();
+        const JPH::BodyLockInterface& LockInterface = JoltSystem->GetBodyLockInterfaceNoLock();
+        
+        RunMultiHitBatch(Sweeps, Hits, Ranges, [&](const FSphereCastSettings& Sweep, TVector<FRayResult>& OutHits)
+        {
+            SweepSingleSphere(Query, LockInterface, Sweep, OutHits);
+        });
+    }
+
+    void FJoltPhysicsScene::OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        const JPH::NarrowPhaseQuery& Query = JoltSystem->GetNarrowPhaseQueryNoLock();
+        const JPH::BodyLockInterface& LockInterface = JoltSystem->GetBodyLockInterfaceNoLock();
+        
+        RunMultiHitBatch(Overlaps, Hits, Ranges, [&](const FSphereOverlapSettings& Overlap, TVector<FRayResult>& OutHits)
+        {
+            OverlapSingleSphere(Query, LockInterface, Overlap, OutHits);
+        });
+    }
+
     void FJoltPhysicsScene::OnCharacterComponentConstructed(entt::registry& Registry, entt::entity Entity)
     {
         SCharacterPhysicsComponent& CharacterComponent = Registry.get<SCharacterPhysicsComponent>(Entity);
@@ -648,10 +1105,13 @@ namespace Lumina::Physics
         BodyInterface.SetUserData(Character->GetInnerBodyID(), entt::to_integral(Entity));
         
         CharacterComponent.Character = Move(Character);
+        
+        Snapshots.Clear();
     }
 
     void FJoltPhysicsScene::OnCharacterComponentDestroyed(entt::registry& Registry, entt::entity Entity)
     {
+        Snapshots.Clear();
     }
 
     void FJoltPhysicsScene::OnRigidBodyComponentUpdated(entt::registry& Registry, entt::entity Entity)
@@ -661,83 +1121,264 @@ namespace Lumina::Physics
 
     void FJoltPhysicsScene::OnRigidBodyComponentConstructed(entt::registry& Registry, entt::entity Entity)
     {
-        if (!Registry.any_of<SSphereColliderComponent, SBoxColliderComponent>(Entity))
+        CreateRigidBodies(Registry, TSpan<const entt::entity>(&Entity, 1));
+    }
+
+    void FJoltPhysicsScene::OnMeshColliderComponentUpdated(entt::registry& Registry, entt::entity Entity)
+    {
+        // Mesh colliders added at runtime usually get their mesh afterwards, and any new mesh needs a new shape.
+        SRigidBodyComponent* RigidBodyComponent = Registry.try_get<SRigidBodyComponent>(Entity);
+        if (RigidBodyComponent == nullptr)
         {
-            LOG_ERROR("Entity {} attempted to construct a rigid body without a collider!", entt::to_integral(Entity));
             return;
         }
+        
+        OnRigidBodyComponentDestroyed(Registry, Entity);
+        RigidBodyComponent->BodyID = JPH::BodyID::cInvalidBodyID;
+        
+        CreateRigidBodies(Registry, TSpan<const entt::entity>(&Entity, 1));
+    }
 
+    void FJoltPhysicsScene::OnRigidBodyComponentDestroyed(entt::registry& Registry, entt::entity Entity)
+    {
         SRigidBodyComponent& RigidBodyComponent = Registry.get<SRigidBodyComponent>(Entity);
-        STransformComponent& TransformComponent = Registry.get<STransformComponent>(Entity);
+        JPH::BodyInterface& BodyInterface = JoltSystem->GetBodyInterface();
+        JPH::BodyID BodyID(RigidBodyComponent.BodyID);
+        
+        if (BodyID.IsInvalid() || !BodyInterface.IsAdded(BodyID))
+        {
+            return;
+        }
+        
+        BodyInterface.RemoveBody(BodyID);
+        BodyInterface.DestroyBody(BodyID);
         
-        JPH::ShapeRefC Shape;
+        Snapshots.Clear();
+    }
 
-        if (Registry.all_of<SBoxColliderComponent>(Entity))
+    void FJoltPhysicsScene::CreateRigidBodies(entt::registry& Registry, TSpan<const entt::entity> Entities)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        const uint32 NumEntities = static_cast<uint32>(Entities.size());
+        if (NumEntities == 0)
+        {
+            return;
+        }
+        
+        // Workers only read through the const registry, which never creates storage behind their back.
+        const entt::registry& ReadRegistry = Registry;
+        const bool bParallel = CVarPhysicsParallelBodyCreation.GetValue() && NumEntities >= MinParallelBodies;
+        
+        TVector<FJoltShapeKey> Keys(NumEntities);
+        TVector<uint8> HasCollider(NumEntities, 0);
+        
+        ForEachIndex(NumEntities, bParallel, [&](uint32 Index)
         {
-            const SBoxColliderComponent& BC = Registry.get<SBoxColliderComponent>(Entity);
-            JPH::BoxShapeSettings Settings(JoltUtils::ToJPHVec3(BC.HalfExtent * TransformComponent.GetScale()));
-            Settings.SetEmbedded();
-            auto Result = Settings.Create();
-            if (Result.HasError())
+            entt::entity Entity = Entities[Index];
+            const STransformComponent& TransformComponent = ReadRegistry.get<STransformComponent>(Entity);
+            
+            if (const SBoxColliderComponent* BC = ReadRegistry.try_get<SBoxColliderComponent>(Entity))
+            {
+                Keys[Index] = FJoltShapeKey{ FJoltShapeKey::EType::Box, BC->HalfExtent * TransformComponent.GetScale() };
+                HasCollider[Index] = 1;
+            }
+            else if (const SSphereColliderComponent* SC = ReadRegistry.try_get<SSphereColliderComponent>(Entity))
+            {
+                Keys[Index] = FJoltShapeKey{ FJoltShapeKey::EType::Sphere, glm::vec3(SC->Radius * TransformComponent.MaxScale(), 0.0f, 0.0f) };
+                HasCollider[Index] = 1;
+            }
+            else if (const SMeshColliderComponent* MC = ReadRegistry.try_get<SMeshColliderComponent>(Entity); MC && MC->Mesh)
+            {
+                Keys[Index] = FJoltShapeKey{ FJoltShapeKey::EType::TriangleMesh, TransformComponent.GetScale(), MC->Mesh->GetGUID(), MC->Mesh->GetCollisionHash(), MC->Mesh.Get() };
+                HasCollider[Index] = 1;
+            }
+            else if (const SConvexHullColliderComponent* HC = ReadRegistry.try_get<SConvexHullColliderComponent>(Entity); HC && HC->Mesh)
             {
-                return LOG_ERROR("Failed to create BoxCollider Shape for Entity: {} - {}", entt::to_integral(Entity), Result.GetError());
+                Keys[Index] = FJoltShapeKey{ FJoltShapeKey::EType::ConvexHull, TransformComponent.GetScale(), HC->Mesh->GetGUID(), HC->Mesh->GetCollisionHash(), HC->Mesh.Get() };
+                HasCollider[Index] = 1;
+            }
+        });
+        
+        // Only keys the cache has not seen yet get a shape built, a level full of identical crates builds one.
+        TVector<FJoltShapeKey> NewKeys;
+        for (uint32 i = 0; i < NumEntities; ++i)
+        {
+            if (!HasCollider[i])
+            {
+                // Mesh colliders without a mesh yet get their body once it is assigned, see OnMeshColliderComponentUpdated.
+                if (!ReadRegistry.any_of<SMeshColliderComponent, SConvexHullColliderComponent>(Entities[i]))
+                {
+                    LOG_ERROR("Entity {} attempted to construct a rigid body without a collider!", entt::to_integral(Entities[i]));
+                }
+                continue;
             }
             
-            Shape = Result.Get();
+            if (ShapeCache.emplace(Keys[i], JPH::ShapeRefC()).second)
+            {
+                NewKeys.push_back(Keys[i]);
+            }
         }
-        else if (Registry.all_of<SSphereColliderComponent>(Entity))
+        
+        if (!NewKeys.empty())
         {
-            const SSphereColliderComponent& SC = Registry.get<SSphereColliderComponent>(Entity);
-            JPH::SphereShapeSettings Settings(SC.Radius * TransformComponent.MaxScale());
-            Settings.SetEmbedded();
-            auto Result = Settings.Create();
-            if (Result.HasError())
+            const uint32 NumNewKeys = static_cast<uint32>(NewKeys.size());
+            TVector<JPH::ShapeRefC> NewShapes(NumNewKeys);
+            ForEachIndex(NumNewKeys, NumNewKeys > 1 && bParallel, [&](uint32 Index)
             {
-                return LOG_ERROR("Failed to create SphereCollider Shape for Entity: {} - {}", entt::to_integral(Entity), Result.GetError());
+                NewShapes[Index] = CreateShape(NewKeys[Index]);
+            });
+        
+            // Failures stay out of the cache, the next body with that key tries again instead of silently getting nothing.
+            for (uint32 i = 0; i < NumNewKeys; ++i)
+            {
+                if (NewShapes[i] == nullptr)
+                {
+                    ShapeCache.erase(NewKeys[i]);
+                }
+                else
+                {
+                    ShapeCache[NewKeys[i]] = Move(NewShapes[i]);
+                }
             }
-            
-            Shape = Result.Get();      
         }
-
-        JPH::ObjectLayer Layer      = ToJoltObjectType(RigidBodyComponent.BodyType);
-        JPH::EMotionType MotionType = ToJoltMotionType(RigidBodyComponent.BodyType);
-
-        glm::quat Rotation      = TransformComponent.GetRotation();
-        glm::vec3 Position      = TransformComponent.GetLocation();
-
-        JPH::BodyCreationSettings Settings(
-            Shape,
-            JoltUtils::ToJPHRVec3(Position),
-            JoltUtils::ToJPHQuat(Rotation),
-            MotionType,
-            Layer);
-
-        Settings.mRestitution = 0.5f;
-        Settings.mFriction = 0.3f;
-        Settings.mAngularDamping = RigidBodyComponent.AngularDamping;
-        Settings.mLinearDamping = RigidBodyComponent.LinearDamping; 
-
+        
+        TVector<JPH::BodyCreationSettings> BodySettings(NumEntities);
+        ForEachIndex(NumEntities, bParallel, [&](uint32 Index)
+        {
+            if (!HasCollider[Index])
+            {
+                return;
+            }
+            
+            auto ShapeIt = ShapeCache.find(Keys[Index]);
+            if (ShapeIt == ShapeCache.end())
+            {
+                return;
+            }
+            
+            entt::entity Entity = Entities[Index];
+            const SRigidBodyComponent& RigidBodyComponent = ReadRegistry.get<SRigidBodyComponent>(Entity);
+            const STransformComponent& TransformComponent = ReadRegistry.get<STransformComponent>(Entity);
+            
+            const EBodyType BodyType = GetSupportedBodyType(RigidBodyComponent.BodyType, Keys[Index].Type == FJoltShapeKey::EType::TriangleMesh);
+            
+            JPH::BodyCreationSettings& Settings = BodySettings[Index];
+            Settings.SetShape(ShapeIt->second);
+            Settings.mPosition          = JoltUtils::ToJPHRVec3(TransformComponent.GetLocation());
+            Settings.mRotation          = JoltUtils::ToJPHQuat(TransformComponent.GetRotation());
+            Settings.mMotionType        = ToJoltMotionType(BodyType);
+            Settings.mObjectLayer       = ToJoltObjectType(BodyType);
+            Settings.mUserData          = static_cast<uint64>(Entity);
+            Settings.mRestitution       = 0.5f;
+            Settings.mFriction          = 0.3f;
+            Settings.mAngularDamping    = RigidBodyComponent.AngularDamping;
+            Settings.mLinearDamping     = RigidBodyComponent.LinearDamping;
+        });
+        
         JPH::BodyInterface& BodyInterface = JoltSystem->GetBodyInterface();
         
-        JPH::Body* Body = BodyInterface.CreateBody(Settings);
-        Body->SetUserData(static_cast<uint64>(Entity));
-        BodyInterface.AddBody(Body->GetID(), JPH::EActivation::Activate);
-        RigidBodyComponent.BodyID = Body->GetID().GetIndexAndSequenceNumber();
+        JPH::BodyIDVector LayerBodies[Layers::NUM_LAYERS];
+        for (uint32 i = 0; i < NumEntities; ++i)
+        {
+            const JPH::BodyCreationSettings& Settings = BodySettings[i];
+            if (Settings.GetShape() == nullptr)
+            {
+                if (HasCollider[i])
+                {
+                    LOG_ERROR("Entity {} has no usable collider shape, its rigid body was not created", entt::to_integral(Entities[i]));
+                }
+                continue;
+            }
+            
+            JPH::Body* Body = BodyInterface.CreateBody(Settings);
+            if (Body == nullptr)
+            {
+                LOG_ERROR("Ran out of physics bodies, {} rigid bodies were not created", NumEntities - i);
+                break;
+            }
+            
+            Registry.get<SRigidBodyComponent>(Entities[i]).BodyID = Body->GetID().GetIndexAndSequenceNumber();
+            LayerBodies[Settings.mObjectLayer].push_back(Body->GetID());
+        }
+        
+        // One broad phase insertion per layer instead of one per body. Preparing builds the layer's tree without touching
+        // the broad phase so the layers build side by side, a batch builds a tree as good as OptimizeBroadPhase would.
+        JPH::BodyInterface::AddState AddStates[Layers::NUM_LAYERS] = {};
+        ForEachIndex(Layers::NUM_LAYERS, bParallel, [&](uint32 Layer)
+        {
+            if (!LayerBodies[Layer].empty())
+            {
+                AddStates[Layer] = BodyInterface.AddBodiesPrepare(LayerBodies[Layer].data(), static_cast<int>(LayerBodies[Layer].size()));
+            }
+        });
+        
+        for (JPH::ObjectLayer Layer = 0; Layer < Layers::NUM_LAYERS; ++Layer)
+        {
+            JPH::BodyIDVector& BodyIDs = LayerBodies[Layer];
+            if (!BodyIDs.empty())
+            {
+                // Static bodies never need waking.
+                const JPH::EActivation Activation = Layer == Layers::MOVING ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
+                BodyInterface.AddBodiesFinalize(BodyIDs.data(), static_cast<int>(BodyIDs.size()), AddStates[Layer], Activation);
+            }
+        }
+        
+        Snapshots.Clear();
     }
 
-    void FJoltPhysicsScene::OnRigidBodyComponentDestroyed(entt::registry& Registry, entt::entity Entity)
+    JPH::ShapeRefC FJoltPhysicsScene::CreateShape(const FJoltShapeKey& Key) const
     {
-        SRigidBodyComponent& RigidBodyComponent = Registry.get<SRigidBodyComponent>(Entity);
-        JPH::BodyInterface& BodyInterface = JoltSystem->GetBodyInterface();
-        JPH::BodyID BodyID(RigidBodyComponent.BodyID);
+        JPH::ShapeSettings::ShapeResult Result;
+        switch (Key.Type)
+        {
+            case FJoltShapeKey::EType::Box:
+            {
+                JPH::BoxShapeSettings Settings(JoltUtils::ToJPHVec3(Key.Size));
+                Settings.SetEmbedded();
+                Result = Settings.Create();
+                break;
+            }
+            case FJoltShapeKey::EType::Sphere:
+            {
+                JPH::SphereShapeSettings Settings(Key.Size.x);
+                Settings.SetEmbedded();
+                Result = Settings.Create();
+                break;
+            }
+            case FJoltShapeKey::EType::TriangleMesh:
+            case FJoltShapeKey::EType::ConvexHull:
+            {
+                const ECollisionMeshType MeshType = Key.Type == FJoltShapeKey::EType::TriangleMesh ? ECollisionMeshType::TriangleMesh : ECollisionMeshType::ConvexHull;
+                const FMeshResource& Resource = Key.Mesh->GetMeshResource();
+                
+                JPH::ShapeRefC MeshShape = JoltCooking::RestoreShape(MeshType == ECollisionMeshType::TriangleMesh ? Resource.CookedTriangleMesh : Resource.CookedConvexHull);
+                if (MeshShape == nullptr)
+                {
+                    // Meshes saved before cooking, or cooked by a different Jolt build, pay for the build here.
+                    LOG_WARN("Mesh {} has no usable cooked collision, building it at runtime", Resource.Name.c_str());
+                    MeshShape = JoltCooking::CreateMeshShape(Resource, MeshType);
+                }
+                
+                if (MeshShape == nullptr || Key.Size == glm::vec3(1.0f))
+                {
+                    return MeshShape;
+                }
+                
+                JPH::ScaledShapeSettings Settings(MeshShape, JoltUtils::ToJPHVec3(Key.Size));
+                Settings.SetEmbedded();
+                Result = Settings.Create();
+                break;
+            }
+        }
         
-        if (BodyID.IsInvalid() || BodyInterface.IsAdded(BodyID))
+        if (Result.HasError())
         {
-            return;
+            LOG_ERROR("Failed to create collider shape - {}", Result.GetError());
+            return nullptr;
         }
         
-        BodyInterface.RemoveBody(BodyID);
-        BodyInterface.DestroyBody(BodyID);
+        return Result.Get();
     }
 
     void FJoltPhysicsScene::OnColliderComponentAdded(entt::registry& Registry, entt::entity Entity)
@@ -1,16 +1,21 @@
 ﻿#pragma once
 
 #include "entt/entt.hpp"
+#include "Core/Threading/Thread.h"
+#include "GUID/GUID.h"
 #include "Memory/SmartPtr.h"
+#include "JoltSnapshot.h"
 #include "Physics/PhysicsScene.h"
 #include "Jolt/Jolt.h"
 #include "Jolt/Physics/PhysicsSystem.h"
+#include "Jolt/Physics/Body/BodyActivationListener.h"
 #include "World/Entity/Events/ImpulseEvent.h"
 
 
 namespace Lumina
 {
 	struct SImpulseEvent;
+	class CMesh;
 	class CWorld;
 }
 
@@ -81,6 +86,73 @@ namespace Lumina::Physics
 		const JPH::BodyLockInterfaceNoLock* BodyLockInterface = nullptr;
 	};
     
+	/** Collects the bodies that fell asleep during an update, so their resting transform is synced one last time. */
+	class FJoltActivationListener final : public JPH::BodyActivationListener
+	{
+	public:
+		
+		void OnBodyActivated(const JPH::BodyID& inBodyID, JPH::uint64 inBodyUserData) override { }
+		
+		void OnBodyDeactivated(const JPH::BodyID& inBodyID, JPH::uint64 inBodyUserData) override
+		{
+			FScopeLock Lock(Mutex);
+			DeactivatedBodies.push_back(inBodyID);
+		}
+
+		/** Moves the bodies collected so far into OutBodies, call it while the physics system is not updating. */
+		void ConsumeDeactivatedBodies(JPH::BodyIDVector& OutBodies)
+		{
+			FScopeLock Lock(Mutex);
+			OutBodies.swap(DeactivatedBodies);
+			DeactivatedBodies.clear();
+		}
+
+	private:
+		
+		FMutex				Mutex;
+		JPH::BodyIDVector	DeactivatedBodies;
+	};
+	
+	/**
+	 * Kind and scaled size of a collider, bodies with equal keys share one shape. Mesh colliders store their scale as the size,
+	 * and are keyed on the asset and its collision hash so a reimported, recooked or reloaded mesh never reuses a stale shape.
+	 */
+	struct FJoltShapeKey
+	{
+		enum class EType : uint8
+		{
+			Box,
+			Sphere,
+			TriangleMesh,
+			ConvexHull,
+		};
+		
+		EType			Type;
+		glm::vec3		Size;
+		FGuid			MeshGUID;
+		uint64			MeshHash = 0;
+		
+		/** Only read to build the shape, two objects of one asset share it. */
+		const CMesh*	Mesh = nullptr;
+		
+		bool operator == (const FJoltShapeKey& Key) const
+		{
+			return Type == Key.Type && Size == Key.Size && MeshGUID == Key.MeshGUID && MeshHash == Key.MeshHash;
+		}
+	};
+	
+	inline uint64 GetTypeHash(const FJoltShapeKey& K)
+	{
+		size_t Seed = 0;
+		Hash::HashCombine(Seed, K.Type);
+		Hash::HashCombine(Seed, K.MeshGUID.Hash());
+		Hash::HashCombine(Seed, K.MeshHash);
+		Hash::HashCombine(Seed, K.Size.x);
+		Hash::HashCombine(Seed, K.Size.y);
+		Hash::HashCombine(Seed, K.Size.z);
+		return Seed;
+	}
+    
     class FLayerInterfaceImpl final : public JPH::BroadPhaseLayerInterface
     {
     public:
@@ -134,6 +206,12 @@ namespace Lumina::Physics
         void OnWorldSimulate() override;
         void OnWorldStopSimulate() override;
     	
+    	double GetInterpolationAlpha() const override { return InterpolationAlpha; }
+    	
+    	uint64 GetSimulationFrame() const override { return SimulationFrame; }
+    	bool RestoreSnapshot(uint64 Frame) override;
+    	TOptional<uint64> GetSnapshotHash(uint64 Frame) const override;
+    	
     	void ActivateBody(uint32 BodyID) override;
     	void DeactivateBody(uint32 BodyID) override;
     	void ChangeBodyMotionType(uint32 BodyID, EBodyType NewType) override;
@@ -143,6 +221,10 @@ namespace Lumina::Physics
     	TOptional<FRayResult> CastRay(const FRayCastSettings& Settings) override;
 		TVector<FRayResult> CastSphere(const FSphereCastSettings& Settings) override;
     	
+    	void CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results) override;
+    	void CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) override;
+    	void OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) override;
+    	
     	void OnCharacterComponentConstructed(entt::registry& Registry, entt::entity Entity);
     	void OnCharacterComponentDestroyed(entt::registry& Registry, entt::entity Entity);
     	
@@ -150,6 +232,7 @@ namespace Lumina::Physics
     	void OnRigidBodyComponentConstructed(entt::registry& Registry, entt::entity Entity);
     	void OnRigidBodyComponentDestroyed(entt::registry& Registry, entt::entity Entity);
     	void OnColliderComponentAdded(entt::registry& Registry, entt::entity Entity);
+    	void OnMeshColliderComponentUpdated(entt::registry& Registry, entt::entity Entity);
     	void OnColliderComponentRemoved(entt::registry& Registry, entt::entity Entity);
     	
     	void OnImpulseEvent(const SImpulseEvent& Impulse);
@@ -166,15 +249,50 @@ namespace Lumina::Physics
 
     private:
     	
+    	/** Creates and adds the bodies of Entities, shapes are built on the task system and bodies inserted per layer in bulk. */
+    	void CreateRigidBodies(entt::registry& Registry, TSpan<const entt::entity> Entities);
+    	
+    	JPH::ShapeRefC CreateShape(const FJoltShapeKey& Key) const;
+    	
+    	/** Records where every active body is before the last fixed step of the frame. */
+    	void CapturePreviousPoses();
+    	
+    	/** Adds the state after the latest fixed step to the snapshot history, resizing it first if its console variables changed. */
+    	void RecordSnapshot();
+    	
     	JPH::TempAllocatorImpl				Allocator;
     	TUniquePtr<FJoltContactListener>	ContactListener;
+    	TUniquePtr<FJoltActivationListener>	ActivationListener;
         TUniquePtr<JPH::PhysicsSystem>		JoltSystem;
         TUniquePtr<FLayerInterfaceImpl>		JoltInterfaceLayer;
         CWorld*								World = nullptr;
 
         double FixedTimeStep = 1.0 / 60.0;
         double Accumulator = 0.0;
+        double InterpolationAlpha = 1.0;
         int CollisionSteps = 1;
+    	uint64 SimulationFrame = 0;
+    	
+    	struct FBodyPose
+    	{
+    		glm::vec3 Location;
+    		glm::quat Rotation;
+    	};
+    	
+    	/** Active body poses one fixed step behind Jolt, keyed by body ID. Transforms are blended from these towards the latest step. */
+    	THashMap<uint32, FBodyPose> PreviousPoses;
+    	
+    	/** Blended poses the last sync wrote to transforms, keyed by body ID. PreUpdate re-bases gameplay writes from these onto the body. */
+    	THashMap<uint32, FBodyPose> RenderedPoses;
+    	
+    	/** Scratch list of the bodies that went to sleep since the last sync. */
+    	JPH::BodyIDVector DeactivatedBodies;
+    	
+    	/** Shapes are immutable once built, so every body with the same collider key reuses the cached one. */
+    	THashMap<FJoltShapeKey, JPH::ShapeRefC> ShapeCache;
+    	
+    	/** Bodies and characters after each recent update, for rewinding. Jolt restores onto the same bodies only. */
+    	FJoltSnapshotHistory Snapshots;
     
     };
 }
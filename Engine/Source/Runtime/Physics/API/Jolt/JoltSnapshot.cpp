@@ -0,0 +1,281 @@
+#include "pch.h"
+#include "JoltSnapshot.h"
+
+#include "JoltStreams.h"
+#include "Core/Math/Hash/Hash.h"
+#include "Core/Profiler/Profile.h"
+
+namespace Lumina::Physics
+{
+    namespace
+    {
+        /** Unchanged bytes shorter than this stay inside the literal around them, a new run costs two varints. */
+        constexpr size_t MinZeroRun = 8;
+
+        void WriteVarint(TVector<uint8>& Out, size_t Value)
+        {
+            while (Value >= 0x80)
+            {
+                Out.push_back(static_cast<uint8>(Value | 0x80));
+                Value >>= 7;
+            }
+            Out.push_back(static_cast<uint8>(Value));
+        }
+
+        size_t ReadVarint(const uint8*& Cursor, const uint8* End)
+        {
+            size_t Value = 0;
+            for (uint32 Shift = 0; Cursor < End; Shift += 7)
+            {
+                const uint8 Byte = *Cursor++;
+                Value |= static_cast<size_t>(Byte & 0x7F) << Shift;
+                if ((Byte & 0x80) == 0)
+                {
+                    break;
+                }
+            }
+            return Value;
+        }
+
+        size_t CountZeros(const uint8* Data, size_t Begin, size_t End)
+        {
+            size_t i = Begin;
+            for (; i + sizeof(uint64) <= End; i += sizeof(uint64))
+            {
+                uint64 Word;
+                Memory::Memcpy(&Word, Data + i, sizeof(uint64));
+                if (Word != 0)
+                {
+                    break;
+                }
+            }
+
+            while (i < End && Data[i] == 0)
+            {
+                ++i;
+            }
+            return i - Begin;
+        }
+
+        /**
+         * Encodes Current as its XOR with Previous, as pairs of (unchanged run, changed run) lengths each followed by the
+         * changed bytes. Bytes past the end of Previous are taken as zero, so a state that grew keeps its tail verbatim.
+         */
+        void EncodeDelta(const TVector<uint8>& Previous, const TVector<uint8>& Current, TVector<uint8>& Diff, TVector<uint8>& Out)
+        {
+            const size_t Size = Current.size();
+            const size_t Overlap = eastl::min(Size, Previous.size());
+
+            Diff.resize(Size);
+            for (size_t i = 0; i < Overlap; ++i)
+            {
+                Diff[i] = Current[i] ^ Previous[i];
+            }
+            Memory::Memcpy(Diff.data() + Overlap, Current.data() + Overlap, Size - Overlap);
+
+            Out.clear();
+            Out.reserve(Size / 4);
+            size_t i = 0;
+            while (i < Size)
+            {
+                const size_t ZeroRun = CountZeros(Diff.data(), i, Size);
+                const size_t LiteralStart = i + ZeroRun;
+
+                // The literal ends where the first long enough run of unchanged bytes starts, or at the end with any zeros trimmed.
+                size_t LiteralEnd = LiteralStart;
+                size_t Zeros = 0;
+                for (size_t j = LiteralStart; j < Size && Zeros < MinZeroRun; ++j)
+                {
+                    Zeros = Diff[j] == 0 ? Zeros + 1 : 0;
+                    LiteralEnd = Zeros == 0 ? j + 1 : LiteralEnd;
+                }
+
+                WriteVarint(Out, ZeroRun);
+                WriteVarint(Out, LiteralEnd - LiteralStart);
+                Out.insert(Out.end(), Diff.data() + LiteralStart, Diff.data() + LiteralEnd);
+
+                i = LiteralEnd;
+            }
+        }
+
+        void ApplyDelta(TVector<uint8>& State, uint32 RawSize, const TVector<uint8>& Delta)
+        {
+            State.resize(RawSize, 0);
+
+            const uint8* Cursor = Delta.data();
+            const uint8* End = Delta.data() + Delta.size();
+            size_t Offset = 0;
+            while (Cursor < End)
+            {
+                Offset += ReadVarint(Cursor, End);
+                const size_t Literal = ReadVarint(Cursor, End);
+                ASSERT(Offset + Literal <= State.size() && Cursor + Literal <= End);
+
+                for (size_t i = 0; i < Literal; ++i)
+                {
+                    State[Offset + i] ^= Cursor[i];
+                }
+
+                Cursor += Literal;
+                Offset += Literal;
+            }
+        }
+    }
+
+    void FJoltSnapshotHistory::Reset(uint32 InCapacity, uint32 InKeyframeInterval)
+    {
+        Capacity = InCapacity;
+        KeyframeInterval = ClampKeyframeInterval(InCapacity, InKeyframeInterval);
+
+        Snapshots.clear();
+        Snapshots.resize(Capacity);
+        Clear();
+    }
+
+    void FJoltSnapshotHistory::Clear()
+    {
+        NextSlot = 0;
+        NumSnapshots = 0;
+        FramesSinceKeyframe = 0;
+        LatestState.clear();
+    }
+
+    uint32 FJoltSnapshotHistory::ClampKeyframeInterval(uint32 Capacity, uint32 KeyframeInterval)
+    {
+        return eastl::clamp(KeyframeInterval, 1u, eastl::max(Capacity, 1u));
+    }
+
+    void FJoltSnapshotHistory::Record(uint64 Frame, double Accumulator, const FSaveStateFunc& SaveState)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        if (Capacity == 0)
+        {
+            return;
+        }
+
+        Scratch.clear();
+        FJoltStateRecorder Recorder(Scratch);
+        SaveState(Recorder);
+
+        // A ring that starts empty needs a keyframe first, any later one is only a matter of the interval.
+        const bool bKeyframe = NumSnapshots == 0 || ++FramesSinceKeyframe >= KeyframeInterval;
+        if (bKeyframe)
+        {
+            FramesSinceKeyframe = 0;
+        }
+
+        FSnapshot& Snapshot = Snapshots[NextSlot];
+        Snapshot.Frame          = Frame;
+        Snapshot.Hash           = Hash::XXHash::GetHash64(Scratch.data(), Scratch.size());
+        Snapshot.Accumulator    = Accumulator;
+        Snapshot.RawSize        = static_cast<uint32>(Scratch.size());
+        Snapshot.bKeyframe      = bKeyframe;
+
+        if (bKeyframe)
+        {
+            Snapshot.Data.assign(Scratch.begin(), Scratch.end());
+        }
+        else
+        {
+            EncodeDelta(LatestState, Scratch, Diff, Snapshot.Data);
+        }
+
+        LatestState.swap(Scratch);
+
+        NextSlot = (NextSlot + 1) % Capacity;
+        NumSnapshots = eastl::min(NumSnapshots + 1, Capacity);
+    }
+
+    bool FJoltSnapshotHistory::Restore(uint64 Frame, const FRestoreStateFunc& RestoreState)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const int64 FoundAge = FindAge(Frame);
+        if (FoundAge < 0)
+        {
+            return false;
+        }
+
+        const uint32 Age = static_cast<uint32>(FoundAge);
+        uint32 KeyframeAge = Age;
+        while (KeyframeAge < NumSnapshots && !Snapshots[GetSlot(KeyframeAge)].bKeyframe)
+        {
+            ++KeyframeAge;
+        }
+
+        if (KeyframeAge == NumSnapshots)
+        {
+            return false;
+        }
+
+        const FSnapshot& Keyframe = Snapshots[GetSlot(KeyframeAge)];
+        Scratch.assign(Keyframe.Data.begin(), Keyframe.Data.end());
+        for (uint32 DeltaAge = KeyframeAge; DeltaAge-- > Age;)
+        {
+            const FSnapshot& Delta = Snapshots[GetSlot(DeltaAge)];
+            ApplyDelta(Scratch, Delta.RawSize, Delta.Data);
+        }
+
+        ASSERT(Hash::XXHash::GetHash64(Scratch.data(), Scratch.size()) == Snapshots[GetSlot(Age)].Hash);
+
+        FJoltStateRecorder Recorder(Scratch);
+        if (!RestoreState(Recorder))
+        {
+            return false;
+        }
+
+        // The snapshots after Frame describe a future that was just undone.
+        NextSlot = (GetSlot(Age) + 1) % Capacity;
+        NumSnapshots -= Age;
+        FramesSinceKeyframe = KeyframeAge - Age;
+        LatestState.swap(Scratch);
+
+        return true;
+    }
+
+    TOptional<uint64> FJoltSnapshotHistory::GetHash(uint64 Frame) const
+    {
+        const int64 Age = FindAge(Frame);
+        if (Age < 0)
+        {
+            return eastl::nullopt;
+        }
+
+        return Snapshots[GetSlot(static_cast<uint32>(Age))].Hash;
+    }
+
+    TOptional<double> FJoltSnapshotHistory::GetAccumulator(uint64 Frame) const
+    {
+        const int64 Age = FindAge(Frame);
+        if (Age < 0)
+        {
+            return eastl::nullopt;
+        }
+
+        return Snapshots[GetSlot(static_cast<uint32>(Age))].Accumulator;
+    }
+
+    size_t FJoltSnapshotHistory::GetStoredSize() const
+    {
+        size_t Size = 0;
+        for (uint32 Age = 0; Age < NumSnapshots; ++Age)
+        {
+            Size += Snapshots[GetSlot(Age)].Data.size();
+        }
+        return Size;
+    }
+
+    int64 FJoltSnapshotHistory::FindAge(uint64 Frame) const
+    {
+        for (uint32 Age = 0; Age < NumSnapshots; ++Age)
+        {
+            if (Snapshots[GetSlot(Age)].Frame == Frame)
+            {
+                return Age;
+            }
+        }
+
+        return -1;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/StateRecorder.h>
+
+#include "Containers/Array.h"
+#include "Containers/Function.h"
+#include "Core/Templates/Optional.h"
+
+namespace Lumina::Physics
+{
+    /**
+     * Ring buffer holding the simulation state after each recorded frame. Every KeyframeInterval-th snapshot is stored whole,
+     * the ones between keep only the bytes that changed since the snapshot before them, run length encoded.
+     */
+    class FJoltSnapshotHistory
+    {
+    public:
+
+        using FSaveStateFunc    = TFunction<void(JPH::StateRecorder&)>;
+        using FRestoreStateFunc = TFunction<bool(JPH::StateRecorder&)>;
+
+        /**
+         * Drops every snapshot and resizes the ring, a capacity of zero disables recording. The keyframe interval is clamped
+         * to the capacity, a longer one would evict the only keyframe before the next is written.
+         */
+        void Reset(uint32 InCapacity, uint32 InKeyframeInterval);
+
+        static uint32 ClampKeyframeInterval(uint32 Capacity, uint32 KeyframeInterval);
+
+        /** Drops every snapshot, needed whenever bodies are added or removed since Jolt can only restore onto the same set. */
+        void Clear();
+
+        /** Accumulator is the simulation time the scene had left over after Frame, it is handed back with the frame. */
+        void Record(uint64 Frame, double Accumulator, const FSaveStateFunc& SaveState);
+
+        /**
+         * Decodes the state recorded for Frame and hands it to RestoreState. The snapshots after Frame are dropped, recording
+         * continues from it. Returns false when Frame, or the keyframe it was encoded against, has left the ring.
+         */
+        bool Restore(uint64 Frame, const FRestoreStateFunc& RestoreState);
+
+        /** Hash of the uncompressed state recorded for Frame. */
+        TOptional<uint64> GetHash(uint64 Frame) const;
+
+        TOptional<double> GetAccumulator(uint64 Frame) const;
+
+        uint32 GetCapacity() const { return Capacity; }
+        uint32 GetKeyframeInterval() const { return KeyframeInterval; }
+        uint32 GetNumSnapshots() const { return NumSnapshots; }
+
+        /** Bytes held by the stored snapshots. */
+        size_t GetStoredSize() const;
+
+    private:
+
+        struct FSnapshot
+        {
+            uint64          Frame = 0;
+            uint64          Hash = 0;
+            double          Accumulator = 0.0;
+            uint32          RawSize = 0;
+            bool            bKeyframe = false;
+            TVector<uint8>  Data;
+        };
+
+        /** Slot of the Age-th newest snapshot, zero is the latest. */
+        uint32 GetSlot(uint32 Age) const { return (NextSlot + Capacity - 1 - Age) % Capacity; }
+
+        int64 FindAge(uint64 Frame) const;
+
+        TVector<FSnapshot>  Snapshots;
+
+        /** Uncompressed state of the newest snapshot, the next delta is encoded against it. */
+        TVector<uint8>      LatestState;
+        TVector<uint8>      Scratch;
+        TVector<uint8>      Diff;
+
+        uint32              Capacity = 0;
+        uint32              KeyframeInterval = 1;
+        uint32              NextSlot = 0;
+        uint32              NumSnapshots = 0;
+        uint32              FramesSinceKeyframe = 0;
+    };
+}
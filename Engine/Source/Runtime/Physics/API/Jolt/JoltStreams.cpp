@@ -0,0 +1,37 @@
+#include "pch.h"
+#include "JoltStreams.h"
+
+namespace Lumina::Physics
+{
+    namespace
+    {
+        void AppendBytes(TVector<uint8>& Bytes, const void* Data, size_t NumBytes)
+        {
+            const uint8* Begin = static_cast<const uint8*>(Data);
+            Bytes.insert(Bytes.end(), Begin, Begin + NumBytes);
+        }
+    }
+
+    void FJoltByteReader::Read(TSpan<const uint8> Bytes, void* Data, size_t NumBytes)
+    {
+        if (bReadPastEnd || NumBytes > Bytes.size() - Offset)
+        {
+            bReadPastEnd = true;
+            Memory::Memzero(Data, NumBytes);
+            return;
+        }
+
+        Memory::Memcpy(Data, Bytes.data() + Offset, NumBytes);
+        Offset += NumBytes;
+    }
+
+    void FJoltVectorStreamOut::WriteBytes(const void* Data, size_t NumBytes)
+    {
+        AppendBytes(Bytes, Data, NumBytes);
+    }
+
+    void FJoltStateRecorder::WriteBytes(const void* Data, size_t NumBytes)
+    {
+        AppendBytes(Bytes, Data, NumBytes);
+    }
+}
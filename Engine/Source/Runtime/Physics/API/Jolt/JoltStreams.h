@@ -0,0 +1,82 @@
+#pragma once
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/StreamIn.h>
+#include <Jolt/Core/StreamOut.h>
+#include <Jolt/Physics/StateRecorder.h>
+
+#include "Containers/Array.h"
+
+namespace Lumina::Physics
+{
+    /** Read position in an engine byte array, shared by the Jolt streams below. */
+    class FJoltByteReader
+    {
+    public:
+
+        /** Reads past the end fill Data with zeros and fail every read after them. */
+        void Read(TSpan<const uint8> Bytes, void* Data, size_t NumBytes);
+
+        /** Like std::istream, end of file is only reported once a read went past it, Jolt checks it after every read. */
+        bool HasReadPastEnd() const { return bReadPastEnd; }
+
+    private:
+
+        size_t  Offset = 0;
+        bool    bReadPastEnd = false;
+    };
+
+    /** Appends to an engine byte array, Jolt's own streams go through the standard library. */
+    class FJoltVectorStreamOut final : public JPH::StreamOut
+    {
+    public:
+
+        explicit FJoltVectorStreamOut(TVector<uint8>& InBytes)
+            : Bytes(InBytes)
+        {}
+
+        void WriteBytes(const void* Data, size_t NumBytes) override;
+        bool IsFailed() const override { return false; }
+
+    private:
+
+        TVector<uint8>& Bytes;
+    };
+
+    class FJoltSpanStreamIn final : public JPH::StreamIn
+    {
+    public:
+
+        explicit FJoltSpanStreamIn(TSpan<const uint8> InBytes)
+            : Bytes(InBytes)
+        {}
+
+        void ReadBytes(void* Data, size_t NumBytes) override { Reader.Read(Bytes, Data, NumBytes); }
+        bool IsEOF() const override { return Reader.HasReadPastEnd(); }
+        bool IsFailed() const override { return Reader.HasReadPastEnd(); }
+
+    private:
+
+        TSpan<const uint8>  Bytes;
+        FJoltByteReader     Reader;
+    };
+
+    /** State recorder over an engine byte array, Jolt's own implementation goes through a std::stringstream. */
+    class FJoltStateRecorder final : public JPH::StateRecorder
+    {
+    public:
+
+        explicit FJoltStateRecorder(TVector<uint8>& InBytes)
+            : Bytes(InBytes)
+        {}
+
+        void WriteBytes(const void* Data, size_t NumBytes) override;
+        void ReadBytes(void* Data, size_t NumBytes) override { Reader.Read(Bytes, Data, NumBytes); }
+        bool IsEOF() const override { return Reader.HasReadPastEnd(); }
+        bool IsFailed() const override { return Reader.HasReadPastEnd(); }
+
+    private:
+
+        TVector<uint8>&     Bytes;
+        FJoltByteReader     Reader;
+    };
+}
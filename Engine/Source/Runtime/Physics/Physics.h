@@ -1,4 +1,5 @@
 #pragma once
+#include "Containers/Array.h"
 #include "Memory/SmartPtr.h"
 #include "Platform/GenericPlatform.h"
 
@@ -6,6 +7,7 @@
 namespace Lumina
 {
     class CWorld;
+    struct FMeshResource;
 }
 
 namespace Lumina::Physics
@@ -13,6 +15,12 @@ namespace Lumina::Physics
     static constexpr float GEarthGravity = -9.81f;
     
     class IPhysicsScene;
+    
+    enum class ECollisionMeshType : uint8
+    {
+        TriangleMesh,
+        ConvexHull,
+    };
 
     class IPhysicsContext
     {
@@ -21,6 +29,9 @@ namespace Lumina::Physics
         virtual void Initialize() = 0;
         virtual void Shutdown() = 0;
         virtual TUniquePtr<IPhysicsScene> CreatePhysicsScene(CWorld* World) = 0;
+        
+        /** Builds a collision shape from the mesh's full detail level and writes it in the backend's binary format. */
+        virtual bool CookMeshCollision(const FMeshResource& Mesh, ECollisionMeshType Type, TVector<uint8>& OutData) = 0;
     };
     
     enum class EPhysicsAPI : uint8
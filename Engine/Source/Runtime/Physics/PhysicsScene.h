@@ -17,11 +17,38 @@ namespace Lumina::Physics
         virtual void OnWorldSimulate() = 0;
         virtual void OnWorldStopSimulate() = 0;
         
+        /** How far the frame is between the last two fixed steps, 0 is the previous step and 1 the latest. */
+        virtual double GetInterpolationAlpha() const = 0;
+        
+        /** Fixed steps simulated since the world started simulating, every step is recorded under the value after it. */
+        virtual uint64 GetSimulationFrame() const = 0;
+        
+        /**
+         * Rewinds every body to the snapshot recorded after Frame and continues simulating from there, see Physics.Snapshot.Frames.
+         * Returns false when Frame is no longer in the history. Adding or removing bodies clears the history.
+         */
+        virtual bool RestoreSnapshot(uint64 Frame) = 0;
+        
+        /** Hash of the state recorded after Frame, peers running the same inputs agree on it until their simulations diverge. */
+        virtual TOptional<uint64> GetSnapshotHash(uint64 Frame) const = 0;
+        
         virtual void DeactivateBody(uint32 BodyID) = 0;
         virtual void ActivateBody(uint32 BodyID) = 0;
         virtual void ChangeBodyMotionType(uint32 BodyID, EBodyType NewType) = 0;
         
         virtual TOptional<FRayResult> CastRay(const FRayCastSettings& Settings) = 0;
         virtual TVector<FRayResult> CastSphere(const FSphereCastSettings& Settings) = 0;
+        
+        /**
+         * Casts every ray across the task system, Results[i] receives the closest hit of Rays[i] and a miss has a BodyID of -1.
+         * Batch queries read the narrow phase without taking body locks, so they must not overlap the physics update.
+         */
+        virtual void CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results) = 0;
+        
+        /** Hits receives every hit of every sweep sorted by fraction, Ranges[i] tells which of them belong to Sweeps[i]. */
+        virtual void CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) = 0;
+        
+        /** Hits receives every body touching each sphere, Ranges[i] tells which of them belong to Overlaps[i]. */
+        virtual void OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) = 0;
     };
 }
@@ -11,26 +11,27 @@ namespace Lumina
     {
         GENERATED_BODY()
         
+        /** -1 when the query hit nothing, Jolt never hands out that ID. */
         PROPERTY(Script)
-        int64 BodyID;
+        int64 BodyID = -1;
         
         PROPERTY(Script)
         uint32 Entity = entt::null;
         
         PROPERTY(Script)
-        glm::vec3 Start;
+        glm::vec3 Start = glm::vec3(0.0f);
         
         PROPERTY(Script)
-        glm::vec3 End;
+        glm::vec3 End = glm::vec3(0.0f);
         
         PROPERTY(Script)
-        glm::vec3 Location;
+        glm::vec3 Location = glm::vec3(0.0f);
         
         PROPERTY(Script)
-        glm::vec3 Normal;
+        glm::vec3 Normal = glm::vec3(0.0f);
         
         PROPERTY(Script)
-        float Fraction;
+        float Fraction = 1.0f;
     };
     
     REFLECT()
@@ -95,4 +96,35 @@ namespace Lumina
         PROPERTY(Script)
         TVector<int64> IgnoreBodies;
     };
+    
+    REFLECT()
+    struct FSphereOverlapSettings
+    {
+        GENERATED_BODY()
+        
+        PROPERTY(Script)
+        glm::vec3 Center = glm::vec3(0.0f);
+        
+        PROPERTY(Script)
+        float Radius = 0.0f;
+        
+        PROPERTY(Script)
+        uint32 LayerMask;
+        
+        PROPERTY(Script)
+        TVector<int64> IgnoreBodies;
+    };
+    
+    /** Where the hits of one query of a batch live in the shared hit array. */
+    REFLECT()
+    struct FQueryHitRange
+    {
+        GENERATED_BODY()
+        
+        PROPERTY(Script)
+        uint32 Offset = 0;
+        
+        PROPERTY(Script)
+        uint32 Count = 0;
+    };
 }
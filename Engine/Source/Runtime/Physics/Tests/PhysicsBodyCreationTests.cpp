@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Physics/API/Jolt/JoltPhysicsScene.h"
+#include "World/Entity/Components/PhysicsComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Identical dynamic crates on a grid, none of them touching. */
+        void SpawnCrates(FAutomationWorld& World, uint32 Num)
+        {
+            FEntityRegistry& Registry = World.GetRegistry();
+            for (uint32 i = 0; i < Num; ++i)
+            {
+                const glm::vec3 Location(static_cast<float>(i % 320) * 3.0f, 1.0f, static_cast<float>(i / 320) * 3.0f);
+                entt::entity Crate = World->ConstructEntity(FName("Crate"), FTransform(Location));
+                Registry.emplace<SBoxColliderComponent>(Crate);
+            }
+        }
+
+        struct FCreatedBodies
+        {
+            uint32  NumBodies = 0;
+            uint32  NumShapes = 0;
+        };
+
+        /** Bodies the scene made for the rigid body components, and how many distinct shapes they use between them. */
+        FCreatedBodies CountCreatedBodies(FAutomationWorld& World)
+        {
+            Physics::FJoltPhysicsScene* Scene = static_cast<Physics::FJoltPhysicsScene*>(World->GetPhysicsScene());
+            const JPH::BodyInterface& BodyInterface = Scene->GetPhysicsSystem()->GetBodyInterfaceNoLock();
+
+            FCreatedBodies Created;
+            THashSet<const JPH::Shape*> Shapes;
+            World.GetRegistry().view<SRigidBodyComponent>().each([&](const SRigidBodyComponent& BodyComponent)
+            {
+                const JPH::BodyID BodyID(BodyComponent.BodyID);
+                if (!BodyID.IsInvalid() && BodyInterface.IsAdded(BodyID))
+                {
+                    Created.NumBodies++;
+                    Shapes.insert(BodyInterface.GetShape(BodyID).GetPtr());
+                }
+            });
+
+            Created.NumShapes = static_cast<uint32>(Shapes.size());
+            return Created;
+        }
+    }
+
+    // Start-simulate cost of 10k to 100k identical crates, shapes and settings built on one thread against the task system.
+    LUMINA_AUTOMATION_TEST("Benchmark.Physics.CreateBodies")
+    {
+        for (const uint32 NumBodies : { 10'000u, 50'000u, 100'000u })
+        {
+            ForEachConsoleToggle("Physics.ParallelBodyCreation", [&](bool bParallel)
+            {
+                FAutomationWorld World;
+                SpawnCrates(World, NumBodies);
+
+                const auto Start = std::chrono::high_resolution_clock::now();
+                World->SimulateWorld();
+                const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+                // Every crate has the same key, so the cache hands all of them one shape.
+                const FCreatedBodies Created = CountCreatedBodies(World);
+                TEST_CHECK(Created.NumBodies == NumBodies);
+                TEST_CHECK(Created.NumShapes == 1);
+
+                LOG_INFO("[{}] {} bodies, {}: {:.3f} ms", Test.GetName(), NumBodies, bParallel ? "parallel" : "serial", Duration.count());
+
+                World->StopSimulation();
+            });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,368 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+
+#include "Assets/AssetTypes/Mesh/StaticMesh/StaticMesh.h"
+#include "Core/Object/Package/Package.h"
+#include "FileSystem/FileSystem.h"
+#include "Physics/API/Jolt/JoltCooking.h"
+#include "Physics/API/Jolt/JoltPhysicsScene.h"
+#include "Physics/API/Jolt/JoltUtils.h"
+#include "Renderer/MeshData.h"
+#include "Renderer/Vertex.h"
+#include "World/Entity/Components/PhysicsComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        float GetTerrainHeight(float X, float Z, float Amplitude)
+        {
+            return Amplitude * glm::sin(X * 0.7f) * glm::cos(Z * 0.5f);
+        }
+
+        /** Rolling terrain of Size by Size quads a unit apart, centered on the origin with every triangle facing up. */
+        TUniquePtr<FMeshResource> MakeTerrain(uint32 Size, float Amplitude)
+        {
+            TUniquePtr<FMeshResource> Resource = MakeUnique<FMeshResource>();
+            Resource->Name = FName("CookingTerrain");
+
+            const float Half = static_cast<float>(Size) * 0.5f;
+            TVector<FVertex> Vertices;
+            Vertices.reserve((Size + 1) * (Size + 1));
+            for (uint32 Z = 0; Z <= Size; ++Z)
+            {
+                for (uint32 X = 0; X <= Size; ++X)
+                {
+                    const float PX = static_cast<float>(X) - Half;
+                    const float PZ = static_cast<float>(Z) - Half;
+
+                    FVertex& Vertex = Vertices.emplace_back();
+                    Vertex.Position = glm::vec3(PX, GetTerrainHeight(PX, PZ, Amplitude), PZ);
+                    Vertex.Normal = PackNormal(glm::vec3(0.0f, 1.0f, 0.0f));
+                    Vertex.UV = glm::u16vec2(0);
+                    Vertex.Color = 0xFFFFFFFF;
+                }
+            }
+
+            TVector<uint32>& Indices = Resource->Indices;
+            Indices.reserve(Size * Size * 6);
+            for (uint32 Z = 0; Z < Size; ++Z)
+            {
+                for (uint32 X = 0; X < Size; ++X)
+                {
+                    const uint32 A = Z * (Size + 1) + X;
+                    const uint32 B = A + 1;
+                    const uint32 C = A + Size + 1;
+                    const uint32 D = C + 1;
+                    Indices.insert(Indices.end(), { A, C, B, B, C, D });
+                }
+            }
+
+            Resource->Vertices = Move(Vertices);
+
+            FGeometrySurface& Surface = Resource->GeometrySurfaces.emplace_back();
+            Surface.ID = FName("Terrain");
+            Surface.IndexCount = (uint32)Indices.size();
+            Surface.StartIndex = 0;
+            Surface.MaterialIndex = 0;
+
+            return Resource;
+        }
+
+        /** Nearest hit of a ray against the source triangles, Moller-Trumbore without culling. Returns 1 when it misses them all. */
+        float CastRayAgainstTriangles(const FMeshResource& Resource, const glm::vec3& Origin, const glm::vec3& Direction)
+        {
+            float Nearest = 1.0f;
+            for (size_t i = 0; i + 2 < Resource.Indices.size(); i += 3)
+            {
+                const glm::vec3 V0 = Resource.GetPositionAt(Resource.Indices[i]);
+                const glm::vec3 E1 = Resource.GetPositionAt(Resource.Indices[i + 1]) - V0;
+                const glm::vec3 E2 = Resource.GetPositionAt(Resource.Indices[i + 2]) - V0;
+
+                const glm::vec3 P = glm::cross(Direction, E2);
+                const float Det = glm::dot(E1, P);
+                if (glm::abs(Det) < 1e-8f)
+                {
+                    continue;
+                }
+
+                const float InvDet = 1.0f / Det;
+                const glm::vec3 T = Origin - V0;
+                const float U = glm::dot(T, P) * InvDet;
+                const glm::vec3 Q = glm::cross(T, E1);
+                const float V = glm::dot(Direction, Q) * InvDet;
+                if (U < 0.0f || V < 0.0f || U + V > 1.0f)
+                {
+                    continue;
+                }
+
+                const float Fraction = glm::dot(E2, Q) * InvDet;
+                if (Fraction >= 0.0f && Fraction < Nearest)
+                {
+                    Nearest = Fraction;
+                }
+            }
+            return Nearest;
+        }
+
+        bool SameBounds(const JPH::AABox& A, const JPH::AABox& B)
+        {
+            return A.mMin == B.mMin && A.mMax == B.mMax;
+        }
+
+        /** Reads a saved mesh back straight from the package loader, without the GPU buffers PostLoad would create. */
+        CStaticMesh* LoadMeshExport(CPackage* Package, const CStaticMesh* Saved)
+        {
+            for (const FObjectExport& Export : Package->ExportTable)
+            {
+                if (Export.ObjectGUID == Saved->GetGUID())
+                {
+                    CStaticMesh* Loaded = NewObject<CStaticMesh>(OF_Transient);
+                    Loaded->PreLoad();
+                    Package->GetLoader()->Seek(Export.Offset);
+                    Loaded->Serialize(*Package->GetLoader());
+                    return Loaded;
+                }
+            }
+            return nullptr;
+        }
+
+        const JPH::Shape* GetBodyShape(FAutomationWorld& World, entt::entity Entity)
+        {
+            Physics::FJoltPhysicsScene* Scene = static_cast<Physics::FJoltPhysicsScene*>(World->GetPhysicsScene());
+            const JPH::BodyID BodyID(World.GetRegistry().get<SRigidBodyComponent>(Entity).BodyID);
+            return BodyID.IsInvalid() ? nullptr : Scene->GetPhysicsSystem()->GetBodyInterfaceNoLock().GetShape(BodyID).GetPtr();
+        }
+    }
+
+    // Both collider kinds saved and restored, the restored shape has to be the one that was built and save back to the same bytes.
+    LUMINA_AUTOMATION_TEST("Physics.Cooking.RoundTrip")
+    {
+        const TUniquePtr<FMeshResource> Terrain = MakeTerrain(16, 1.0f);
+
+        for (const Physics::ECollisionMeshType Type : { Physics::ECollisionMeshType::TriangleMesh, Physics::ECollisionMeshType::ConvexHull })
+        {
+            const JPH::ShapeRefC Built = Physics::JoltCooking::CreateMeshShape(*Terrain, Type);
+            TEST_CHECK(Built != nullptr);
+            if (Built == nullptr)
+            {
+                continue;
+            }
+
+            TVector<uint8> Cooked;
+            TEST_CHECK(Physics::JoltCooking::SaveShape(Built, Cooked));
+
+            const JPH::ShapeRefC Restored = Physics::JoltCooking::RestoreShape(Cooked);
+            TEST_CHECK(Restored != nullptr);
+            if (Restored == nullptr)
+            {
+                continue;
+            }
+
+            TEST_CHECK(Restored->GetSubType() == Built->GetSubType());
+            TEST_CHECK(SameBounds(Restored->GetLocalBounds(), Built->GetLocalBounds()));
+            TEST_CHECK(Restored->GetCenterOfMass() == Built->GetCenterOfMass());
+            TEST_CHECK(Restored->GetStats().mNumTriangles == Built->GetStats().mNumTriangles);
+
+            TVector<uint8> Recooked;
+            TEST_CHECK(Physics::JoltCooking::SaveShape(Restored, Recooked));
+            TEST_CHECK(Recooked == Cooked);
+
+            // Data from another Jolt build starts with another format id, the loader has to build the shape instead.
+            TVector<uint8> ForeignBuild = Cooked;
+            ForeignBuild[0] ^= 0xFF;
+            TEST_CHECK(Physics::JoltCooking::RestoreShape(ForeignBuild) == nullptr);
+        }
+
+        TEST_CHECK(Physics::JoltCooking::RestoreShape(TSpan<const uint8>()) == nullptr);
+        TVector<uint8> NoShape;
+        TEST_CHECK(!Physics::JoltCooking::SaveShape(nullptr, NoShape));
+        TEST_CHECK(NoShape.empty());
+    }
+
+    // Rays dropped onto the restored triangle mesh land where they land on the source triangles, and the hull wraps every vertex.
+    LUMINA_AUTOMATION_TEST("Physics.Cooking.CollisionMatchesMesh")
+    {
+        constexpr uint32 Size = 16;
+        constexpr float Amplitude = 1.5f;
+        const TUniquePtr<FMeshResource> Terrain = MakeTerrain(Size, Amplitude);
+
+        TVector<uint8> CookedTriangles;
+        TVector<uint8> CookedHull;
+        Physics::JoltCooking::SaveShape(Physics::JoltCooking::CreateMeshShape(*Terrain, Physics::ECollisionMeshType::TriangleMesh), CookedTriangles);
+        Physics::JoltCooking::SaveShape(Physics::JoltCooking::CreateMeshShape(*Terrain, Physics::ECollisionMeshType::ConvexHull), CookedHull);
+
+        const JPH::ShapeRefC Triangles = Physics::JoltCooking::RestoreShape(CookedTriangles);
+        const JPH::ShapeRefC Hull = Physics::JoltCooking::RestoreShape(CookedHull);
+        TEST_CHECK(Triangles != nullptr && Hull != nullptr);
+        if (Triangles == nullptr || Hull == nullptr)
+        {
+            return;
+        }
+
+        const float Half = static_cast<float>(Size) * 0.5f - 0.01f;
+        const glm::vec3 Direction(0.0f, -4.0f * Amplitude, 0.0f);
+
+        uint32 State = 3;
+        auto Next = [&State]
+        {
+            State = State * 1664525u + 1013904223u;
+            return static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+        };
+
+        uint32 NumMissed = 0;
+        uint32 NumMismatched = 0;
+        for (uint32 i = 0; i < 1'024; ++i)
+        {
+            const glm::vec3 Origin(Next() * 2.0f * Half - Half, 2.0f * Amplitude, Next() * 2.0f * Half - Half);
+            const float Expected = CastRayAgainstTriangles(*Terrain, Origin, Direction);
+
+            JPH::RayCastResult Hit;
+            if (!Triangles->CastRay(JPH::RayCast(JoltUtils::ToJPHVec3(Origin), JoltUtils::ToJPHVec3(Direction)), JPH::SubShapeIDCreator(), Hit))
+            {
+                NumMissed++;
+                continue;
+            }
+
+            // Compared as heights, the cooked vertices are quantized against the mesh bounds.
+            NumMismatched += glm::abs((Hit.mFraction - Expected) * glm::length(Direction)) > 1e-3f ? 1 : 0;
+        }
+        TEST_CHECK(NumMissed == 0);
+        TEST_CHECK(NumMismatched == 0);
+
+        // The hull's bounds are stored around its center of mass.
+        const JPH::AABox HullBounds = Hull->GetLocalBounds();
+        const glm::vec3 HullMin = JoltUtils::FromJPHVec3(HullBounds.mMin + Hull->GetCenterOfMass());
+        const glm::vec3 HullMax = JoltUtils::FromJPHVec3(HullBounds.mMax + Hull->GetCenterOfMass());
+
+        uint32 NumOutside = 0;
+        for (size_t i = 0; i < Terrain->GetNumVertices(); ++i)
+        {
+            const glm::vec3 Position = Terrain->GetPositionAt(i);
+            NumOutside += glm::any(glm::lessThan(Position, HullMin - 1e-3f)) || glm::any(glm::greaterThan(Position, HullMax + 1e-3f)) ? 1 : 0;
+        }
+        TEST_CHECK(NumOutside == 0);
+    }
+
+    // Cooked collision saved into a package comes back byte for byte, ready to restore without a build.
+    LUMINA_AUTOMATION_TEST("Physics.Cooking.PackageRoundTrip")
+    {
+        const FFixedString Path = WriteScratchFile("CookedCollisionRoundTrip.lasset", "");
+        CPackage* Package = CPackage::CreatePackage(Path);
+
+        CStaticMesh* Mesh = NewObject<CStaticMesh>(Package, FName("CookedCollisionRoundTrip"));
+        Mesh->SetMeshResource(MakeTerrain(16, 1.0f));
+
+        const uint64 UncookedHash = Mesh->GetCollisionHash();
+        Mesh->CookCollision();
+        TEST_CHECK(Mesh->GetCollisionHash() != UncookedHash);
+        TEST_CHECK(!Mesh->GetMeshResource().CookedTriangleMesh.empty());
+        TEST_CHECK(!Mesh->GetMeshResource().CookedConvexHull.empty());
+
+        TEST_CHECK(CPackage::SavePackage(Package, Path));
+        TEST_CHECK(CPackage::LoadPackage(Path) == Package);
+
+        CStaticMesh* LoadedMesh = LoadMeshExport(Package, Mesh);
+        TEST_CHECK(LoadedMesh != nullptr);
+
+        if (LoadedMesh != nullptr)
+        {
+            const FMeshResource& Saved = Mesh->GetMeshResource();
+            const FMeshResource& Loaded = LoadedMesh->GetMeshResource();
+
+            TEST_CHECK(Loaded.CookedTriangleMesh == Saved.CookedTriangleMesh);
+            TEST_CHECK(Loaded.CookedConvexHull == Saved.CookedConvexHull);
+            TEST_CHECK(Physics::JoltCooking::RestoreShape(Loaded.CookedTriangleMesh) != nullptr);
+            TEST_CHECK(Physics::JoltCooking::RestoreShape(Loaded.CookedConvexHull) != nullptr);
+        }
+
+        for (CObject* Object : { static_cast<CObject*>(LoadedMesh), static_cast<CObject*>(Mesh) })
+        {
+            if (Object != nullptr)
+            {
+                Object->ForceDestroyNow();
+            }
+        }
+        Package->RemoveFromRoot();
+        Package->ForceDestroyNow();
+        VFS::Remove(Path);
+    }
+
+    // A mesh reimported mid-simulation gets a new shape, bodies still on the old key never see the new geometry or the other way round.
+    LUMINA_AUTOMATION_TEST("Physics.Cooking.ReimportedMeshGetsNewShape")
+    {
+        CStaticMesh* Mesh = NewObject<CStaticMesh>(OF_Transient);
+        Mesh->SetMeshResource(MakeTerrain(16, 1.0f));
+        Mesh->CookCollision();
+
+        FAutomationWorld World;
+        FEntityRegistry& Registry = World.GetRegistry();
+
+        entt::entity Entities[2];
+        for (entt::entity& Entity : Entities)
+        {
+            Entity = World->ConstructEntity(FName("Terrain"));
+            Registry.emplace<SMeshColliderComponent>(Entity).Mesh = Mesh;
+            Registry.get<SRigidBodyComponent>(Entity).BodyType = EBodyType::Static;
+        }
+        World->SimulateWorld();
+
+        const JPH::Shape* OldShape = GetBodyShape(World, Entities[0]);
+        TEST_CHECK(OldShape != nullptr);
+        TEST_CHECK(GetBodyShape(World, Entities[1]) == OldShape);
+
+        // Same object, same address, different geometry.
+        const uint64 OldHash = Mesh->GetCollisionHash();
+        Mesh->SetMeshResource(MakeTerrain(16, 3.0f));
+        Mesh->CookCollision();
+        TEST_CHECK(Mesh->GetCollisionHash() != OldHash);
+
+        Registry.patch<SMeshColliderComponent>(Entities[0]);
+
+        const JPH::Shape* NewShape = GetBodyShape(World, Entities[0]);
+        TEST_CHECK(NewShape != nullptr && NewShape != OldShape);
+        TEST_CHECK(GetBodyShape(World, Entities[1]) == OldShape);
+
+        if (NewShape != nullptr && OldShape != nullptr)
+        {
+            TEST_CHECK(NewShape->GetLocalBounds().mMax.GetY() > OldShape->GetLocalBounds().mMax.GetY() + 1.0f);
+        }
+
+        World->StopSimulation();
+        Mesh->ForceDestroyNow();
+    }
+
+    // Start-simulate cost of a large terrain collider, restored from its cooked data against built from its triangles.
+    LUMINA_AUTOMATION_TEST("Benchmark.Physics.CookedMeshLoad")
+    {
+        const TUniquePtr<FMeshResource> Terrain = MakeTerrain(256, 4.0f);
+
+        for (const Physics::ECollisionMeshType Type : { Physics::ECollisionMeshType::TriangleMesh, Physics::ECollisionMeshType::ConvexHull })
+        {
+            const auto BuildStart = std::chrono::high_resolution_clock::now();
+            const JPH::ShapeRefC Built = Physics::JoltCooking::CreateMeshShape(*Terrain, Type);
+            const std::chrono::duration<double, std::milli> BuildDuration = std::chrono::high_resolution_clock::now() - BuildStart;
+
+            TVector<uint8> Cooked;
+            TEST_CHECK(Physics::JoltCooking::SaveShape(Built, Cooked));
+
+            const auto RestoreStart = std::chrono::high_resolution_clock::now();
+            const JPH::ShapeRefC Restored = Physics::JoltCooking::RestoreShape(Cooked);
+            const std::chrono::duration<double, std::milli> RestoreDuration = std::chrono::high_resolution_clock::now() - RestoreStart;
+
+            TEST_CHECK(Restored != nullptr);
+            TEST_CHECK(Built != nullptr && Restored != nullptr && SameBounds(Restored->GetLocalBounds(), Built->GetLocalBounds()));
+
+            LOG_INFO("[{}] {} triangles, {}: built {:.3f} ms, restored {:.3f} ms ({} KB cooked)", Test.GetName(), Terrain->GetNumIndices() / 3,
+                Type == Physics::ECollisionMeshType::TriangleMesh ? "triangle mesh" : "convex hull", BuildDuration.count(), RestoreDuration.count(), Cooked.size() / 1024);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Physics/API/Jolt/JoltPhysicsScene.h"
+#include "Physics/API/Jolt/JoltUtils.h"
+#include "World/Entity/Components/DirtyComponent.h"
+#include "World/Entity/Components/PhysicsComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Matches the fixed step of FJoltPhysicsScene. */
+        constexpr double FixedTimeStep = 1.0 / 60.0;
+
+        constexpr float PoseTolerance = 1e-3f;
+
+        entt::entity SpawnFallingSphere(FAutomationWorld& World)
+        {
+            World->SimulateWorld();
+
+            entt::entity Entity = World->ConstructEntity(FName("Sphere"), FTransform(glm::vec3(0.0f, 100.0f, 0.0f)));
+            World.GetRegistry().emplace<SSphereColliderComponent>(Entity);
+            return Entity;
+        }
+
+        glm::vec3 GetBodyLocation(FAutomationWorld& World, entt::entity Entity)
+        {
+            Physics::FJoltPhysicsScene* Scene = static_cast<Physics::FJoltPhysicsScene*>(World->GetPhysicsScene());
+            const JPH::BodyID BodyID(World.GetRegistry().get<SRigidBodyComponent>(Entity).BodyID);
+            return JoltUtils::FromJPHRVec3(Scene->GetPhysicsSystem()->GetBodyInterface().GetPosition(BodyID));
+        }
+    }
+
+    // Gameplay flagging an interpolated transform, without changing it, must not pull its body back to the blended pose.
+    LUMINA_AUTOMATION_TEST("Physics.Interpolation.GameplayWritesKeepBodyPose")
+    {
+        constexpr double DeltaTime = 1.0 / 144.0;
+        constexpr uint32 NumFrames = 144;
+
+        TScopedConsoleVariable<bool> Interpolation("Physics.Interpolation", true);
+
+        FAutomationWorld Untouched;
+        FAutomationWorld Written;
+        const entt::entity UntouchedEntity = SpawnFallingSphere(Untouched);
+        const entt::entity WrittenEntity = SpawnFallingSphere(Written);
+
+        bool bBlended = false;
+        for (uint32 i = 0; i < NumFrames; ++i)
+        {
+            Written.GetRegistry().emplace_or_replace<FNeedsTransformUpdate>(WrittenEntity);
+
+            Untouched.Tick(DeltaTime);
+            Written.Tick(DeltaTime);
+
+            // The rendered sphere trails the falling body whenever the frame ends between two steps.
+            const float RenderedY = Untouched.GetRegistry().get<STransformComponent>(UntouchedEntity).GetLocation().y;
+            bBlended |= RenderedY > GetBodyLocation(Untouched, UntouchedEntity).y + PoseTolerance;
+        }
+
+        const glm::vec3 Expected = GetBodyLocation(Untouched, UntouchedEntity);
+        const glm::vec3 Actual = GetBodyLocation(Written, WrittenEntity);
+
+        TEST_CHECK(bBlended);
+        TEST_CHECK(Expected.y < 100.0f);
+        TEST_CHECK(glm::all(glm::lessThan(glm::abs(Expected - Actual), glm::vec3(PoseTolerance))));
+    }
+
+    // A teleport lands the body exactly where it was sent, not offset by how far the rendered transform trailed it.
+    LUMINA_AUTOMATION_TEST("Physics.Interpolation.TeleportIsAbsolute")
+    {
+        constexpr double DeltaTime = 1.0 / 144.0;
+        constexpr uint32 MaxFrames = 144;
+        const glm::vec3 Destination(0.0f, 50.0f, 0.0f);
+
+        // Interpolation only changes what is rendered, both worlds simulate the same bodies step for step.
+        TScopedConsoleVariable<bool> Interpolation("Physics.Interpolation", true);
+
+        FAutomationWorld Interpolated;
+        FAutomationWorld Reference;
+        const entt::entity InterpolatedEntity = SpawnFallingSphere(Interpolated);
+        const entt::entity ReferenceEntity = SpawnFallingSphere(Reference);
+
+        auto TickBoth = [&](double FrameTime)
+        {
+            Interpolation.Set(true);
+            Interpolated.Tick(FrameTime);
+            Interpolation.Set(false);
+            Reference.Tick(FrameTime);
+        };
+
+        // Waits for a frame ending between two steps, where the rendered sphere trails its body.
+        bool bBlended = false;
+        for (uint32 i = 0; i < MaxFrames && !bBlended; ++i)
+        {
+            TickBoth(DeltaTime);
+
+            const float RenderedY = Interpolated.GetRegistry().get<STransformComponent>(InterpolatedEntity).GetLocation().y;
+            bBlended = RenderedY > GetBodyLocation(Interpolated, InterpolatedEntity).y + PoseTolerance;
+        }
+        TEST_CHECK(bBlended);
+
+        auto Teleport = [&](FAutomationWorld& World, entt::entity Entity)
+        {
+            World.GetRegistry().get<STransformComponent>(Entity).SetLocation(Destination);
+            World.GetRegistry().emplace_or_replace<FNeedsTransformUpdate>(Entity, FNeedsTransformUpdate{ .MoveMode = EMoveMode::Teleport });
+        };
+        Teleport(Interpolated, InterpolatedEntity);
+        Teleport(Reference, ReferenceEntity);
+
+        // A full fixed step of frame time, so the teleport is applied before this frame's step.
+        TickBoth(FixedTimeStep);
+
+        const glm::vec3 Expected = GetBodyLocation(Reference, ReferenceEntity);
+        const glm::vec3 Actual = GetBodyLocation(Interpolated, InterpolatedEntity);
+
+        TEST_CHECK(glm::abs(Expected.y - Destination.y) < 1.0f);
+        TEST_CHECK(glm::all(glm::lessThan(glm::abs(Expected - Actual), glm::vec3(PoseTolerance))));
+    }
+
+    // A frame long enough for several fixed steps simulates as much time as that many short frames.
+    LUMINA_AUTOMATION_TEST("Physics.FixedStep.MultiStepFrames")
+    {
+        constexpr uint32 StepsPerFrame = 3;
+        constexpr uint32 NumFrames = 20;
+
+        TScopedConsoleVariable<bool> Interpolation("Physics.Interpolation", false);
+
+        FAutomationWorld SingleSteps;
+        FAutomationWorld MultiSteps;
+        const entt::entity SingleEntity = SpawnFallingSphere(SingleSteps);
+        const entt::entity MultiEntity = SpawnFallingSphere(MultiSteps);
+
+        SingleSteps.Tick(FixedTimeStep, NumFrames * StepsPerFrame);
+        MultiSteps.Tick(FixedTimeStep * StepsPerFrame, NumFrames);
+
+        TEST_CHECK(SingleSteps->GetPhysicsScene()->GetSimulationFrame() == NumFrames * StepsPerFrame);
+        TEST_CHECK(MultiSteps->GetPhysicsScene()->GetSimulationFrame() == NumFrames * StepsPerFrame);
+
+        const glm::vec3 Expected = GetBodyLocation(SingleSteps, SingleEntity);
+        const glm::vec3 Actual = GetBodyLocation(MultiSteps, MultiEntity);
+
+        // One simulated second of free fall from rest, half of g.
+        TEST_CHECK(glm::abs(100.0f - Expected.y - 0.5f * 9.81f) < 0.2f);
+        TEST_CHECK(glm::all(glm::lessThan(glm::abs(Expected - Actual), glm::vec3(PoseTolerance))));
+
+        // Without interpolation the transform is the body pose itself.
+        const glm::vec3 Rendered = MultiSteps.GetRegistry().get<STransformComponent>(MultiEntity).GetLocation();
+        TEST_CHECK(glm::all(glm::lessThan(glm::abs(Rendered - Actual), glm::vec3(PoseTolerance))));
+    }
+}
+
+#endif
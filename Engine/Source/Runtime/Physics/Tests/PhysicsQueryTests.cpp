@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Physics/PhysicsScene.h"
+#include "World/Entity/Components/PhysicsComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr uint32 NumQueries = 10'000;
+
+        /** A floor with a grid of crates on it, static so queries see the same scene on every run. */
+        void SpawnQueryScene(FAutomationWorld& World)
+        {
+            FEntityRegistry& Registry = World.GetRegistry();
+
+            entt::entity Floor = World->ConstructEntity(FName("Floor"));
+            Registry.emplace<SBoxColliderComponent>(Floor).HalfExtent = glm::vec3(100.0f, 0.5f, 100.0f);
+            Registry.get<SRigidBodyComponent>(Floor).BodyType = EBodyType::Static;
+
+            for (uint32 i = 0; i < 1'024; ++i)
+            {
+                const glm::vec3 Location(static_cast<float>(i % 32) * 6.0f - 96.0f, 1.5f, static_cast<float>(i / 32) * 6.0f - 96.0f);
+                entt::entity Crate = World->ConstructEntity(FName("Crate"), FTransform(Location));
+                Registry.emplace<SBoxColliderComponent>(Crate);
+                Registry.get<SRigidBodyComponent>(Crate).BodyType = EBodyType::Static;
+            }
+
+            World->SimulateWorld();
+        }
+
+        /** Points over the floor from a fixed seed. */
+        glm::vec3 RandomPoint(uint32& State, float Height)
+        {
+            auto Next = [&State]
+            {
+                State = State * 1664525u + 1013904223u;
+                return static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+            };
+
+            const float X = Next() * 200.0f - 100.0f;
+            const float Z = Next() * 200.0f - 100.0f;
+            return glm::vec3(X, Height, Z);
+        }
+
+        bool SameHit(const FRayResult& A, const FRayResult& B)
+        {
+            return A.BodyID == B.BodyID && A.Entity == B.Entity && A.Location == B.Location && A.Fraction == B.Fraction;
+        }
+
+        bool SameHits(const TVector<FRayResult>& A, const TVector<FQueryHitRange>& RangesA, const TVector<FRayResult>& B, const TVector<FQueryHitRange>& RangesB)
+        {
+            if (A.size() != B.size() || RangesA.size() != RangesB.size())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < RangesA.size(); ++i)
+            {
+                if (RangesA[i].Offset != RangesB[i].Offset || RangesA[i].Count != RangesB[i].Count)
+                {
+                    return false;
+                }
+            }
+
+            for (size_t i = 0; i < A.size(); ++i)
+            {
+                if (!SameHit(A[i], B[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Physics.Query.DefaultResultIsMiss")
+    {
+        const FRayResult Result;
+        TEST_CHECK(Result.BodyID == -1);
+        TEST_CHECK(Result.Entity == static_cast<uint32>(entt::null));
+        TEST_CHECK(Result.Fraction == 1.0f);
+    }
+
+    // 10k rays one call at a time against the batch, on one thread and on the task system. Every path has to agree.
+    LUMINA_AUTOMATION_TEST("Benchmark.Physics.CastRays10k")
+    {
+        FAutomationWorld World;
+        SpawnQueryScene(World);
+        Physics::IPhysicsScene* Scene = World->GetPhysicsScene();
+
+        uint32 State = 1;
+        TVector<FRayCastSettings> Rays(NumQueries);
+        for (FRayCastSettings& Ray : Rays)
+        {
+            Ray.Start = RandomPoint(State, 20.0f);
+            Ray.End = Ray.Start + glm::vec3(0.0f, -40.0f, 0.0f);
+        }
+
+        TVector<FRayResult> Single(NumQueries);
+        const auto Start = std::chrono::high_resolution_clock::now();
+        for (uint32 i = 0; i < NumQueries; ++i)
+        {
+            if (TOptional<FRayResult> Hit = Scene->CastRay(Rays[i]))
+            {
+                Single[i] = *Hit;
+            }
+        }
+        const std::chrono::duration<double, std::milli> SingleDuration = std::chrono::high_resolution_clock::now() - Start;
+        LOG_INFO("[{}] {} rays, one call each: {:.3f} ms", Test.GetName(), NumQueries, SingleDuration.count());
+
+        ForEachConsoleToggle("Physics.ParallelQueries", [&](bool bParallel)
+        {
+            TVector<FRayResult> Batched(NumQueries);
+
+            const auto BatchStart = std::chrono::high_resolution_clock::now();
+            Scene->CastRays(Rays, Batched);
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - BatchStart;
+
+            // Every ray starts above the floor and ends below it.
+            uint32 NumMismatched = 0;
+            uint32 NumMissed = 0;
+            for (uint32 i = 0; i < NumQueries; ++i)
+            {
+                NumMismatched += SameHit(Single[i], Batched[i]) ? 0 : 1;
+                NumMissed += Batched[i].BodyID == -1 ? 1 : 0;
+            }
+            TEST_CHECK(NumMismatched == 0);
+            TEST_CHECK(NumMissed == 0);
+
+            LOG_INFO("[{}] {} rays, batched {}: {:.3f} ms", Test.GetName(), NumQueries, bParallel ? "parallel" : "serial", Duration.count());
+        });
+    }
+
+    // 10k sphere sweeps and 10k overlaps batched on one thread and on the task system, both have to return the same hits in the same order.
+    LUMINA_AUTOMATION_TEST("Benchmark.Physics.SphereQueries10k")
+    {
+        FAutomationWorld World;
+        SpawnQueryScene(World);
+        Physics::IPhysicsScene* Scene = World->GetPhysicsScene();
+
+        uint32 State = 7;
+        TVector<FSphereCastSettings> Sweeps(NumQueries);
+        TVector<FSphereOverlapSettings> Overlaps(NumQueries);
+        for (uint32 i = 0; i < NumQueries; ++i)
+        {
+            Sweeps[i].Start = RandomPoint(State, 20.0f);
+            Sweeps[i].End = Sweeps[i].Start + glm::vec3(0.0f, -40.0f, 0.0f);
+            Sweeps[i].Radius = 0.5f;
+
+            Overlaps[i].Center = RandomPoint(State, 1.0f);
+            Overlaps[i].Radius = 2.0f;
+        }
+
+        TVector<FRayResult> SweepHits[2];
+        TVector<FQueryHitRange> SweepRanges[2];
+        TVector<FRayResult> OverlapHits[2];
+        TVector<FQueryHitRange> OverlapRanges[2];
+
+        ForEachConsoleToggle("Physics.ParallelQueries", [&](bool bParallel)
+        {
+            const uint32 Run = bParallel ? 1 : 0;
+            SweepRanges[Run].resize(NumQueries);
+            OverlapRanges[Run].resize(NumQueries);
+
+            const auto SweepStart = std::chrono::high_resolution_clock::now();
+            Scene->CastSpheres(Sweeps, SweepHits[Run], SweepRanges[Run]);
+            const std::chrono::duration<double, std::milli> SweepDuration = std::chrono::high_resolution_clock::now() - SweepStart;
+
+            const auto OverlapStart = std::chrono::high_resolution_clock::now();
+            Scene->OverlapSpheres(Overlaps, OverlapHits[Run], OverlapRanges[Run]);
+            const std::chrono::duration<double, std::milli> OverlapDuration = std::chrono::high_resolution_clock::now() - OverlapStart;
+
+            LOG_INFO("[{}] {} queries, {}: sweeps {:.3f} ms ({} hits), overlaps {:.3f} ms ({} hits)", Test.GetName(), NumQueries, bParallel ? "parallel" : "serial",
+                SweepDuration.count(), SweepHits[Run].size(), OverlapDuration.count(), OverlapHits[Run].size());
+        });
+
+        // Every sweep reaches the floor, and every overlap sits on it.
+        TEST_CHECK(SweepHits[0].size() >= NumQueries);
+        TEST_CHECK(OverlapHits[0].size() >= NumQueries);
+        TEST_CHECK(SameHits(SweepHits[0], SweepRanges[0], SweepHits[1], SweepRanges[1]));
+        TEST_CHECK(SameHits(OverlapHits[0], OverlapRanges[0], OverlapHits[1], OverlapRanges[1]));
+    }
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Physics/API/Jolt/JoltPhysicsScene.h"
+#include "World/Entity/Components/PhysicsComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Spheres dropped onto a static floor, most of them bounce and fall asleep on it within a few seconds. */
+        void SpawnFallingSpheres(FAutomationWorld& World)
+        {
+            FEntityRegistry& Registry = World.GetRegistry();
+
+            entt::entity Floor = World->ConstructEntity(FName("Floor"));
+            Registry.emplace<SBoxColliderComponent>(Floor).HalfExtent = glm::vec3(50.0f, 0.5f, 50.0f);
+            Registry.get<SRigidBodyComponent>(Floor).BodyType = EBodyType::Static;
+
+            for (uint32 i = 0; i < 16; ++i)
+            {
+                const glm::vec3 Location(static_cast<float>(i % 4) * 2.0f, 2.0f + static_cast<float>(i) * 0.25f, static_cast<float>(i / 4) * 2.0f);
+                entt::entity Sphere = World->ConstructEntity(FName("Sphere"), FTransform(Location));
+                Registry.emplace<SSphereColliderComponent>(Sphere);
+            }
+
+            // Bodies are created for every collider at once as simulation starts.
+            World->SimulateWorld();
+        }
+
+        /** Num spheres in a loose grid over a wide floor, all of them awake and falling. */
+        void SpawnSphereGrid(FAutomationWorld& World, uint32 Num)
+        {
+            FEntityRegistry& Registry = World.GetRegistry();
+
+            entt::entity Floor = World->ConstructEntity(FName("Floor"));
+            Registry.emplace<SBoxColliderComponent>(Floor).HalfExtent = glm::vec3(200.0f, 0.5f, 200.0f);
+            Registry.get<SRigidBodyComponent>(Floor).BodyType = EBodyType::Static;
+
+            for (uint32 i = 0; i < Num; ++i)
+            {
+                const glm::vec3 Location(static_cast<float>(i % 100) * 3.0f - 150.0f, 2.0f + static_cast<float>(i % 7), static_cast<float>(i / 100) * 3.0f - 150.0f);
+                entt::entity Sphere = World->ConstructEntity(FName("Sphere"), FTransform(Location));
+                Registry.emplace<SSphereColliderComponent>(Sphere);
+            }
+
+            World->SimulateWorld();
+        }
+    }
+
+    // Rewinding to a recorded frame and running the same frames again has to reach the same state, sub-steps included.
+    LUMINA_AUTOMATION_TEST("Physics.Snapshot.RestoreResimulates")
+    {
+        // Frames alternate between one and two fixed steps, so sub-steps and the accumulator both matter.
+        constexpr double DeltaTime = 1.0 / 45.0;
+        constexpr uint32 NumReplayedFrames = 45;
+
+        TScopedConsoleVariable<int32> SnapshotFrames("Physics.Snapshot.Frames", 1'000);
+
+        FAutomationWorld World;
+        SpawnFallingSpheres(World);
+        Physics::IPhysicsScene* Scene = World->GetPhysicsScene();
+
+        World.Tick(DeltaTime, 180);
+        const uint64 RestoreFrame = Scene->GetSimulationFrame();
+
+        World.Tick(DeltaTime, NumReplayedFrames);
+        const uint64 EndFrame = Scene->GetSimulationFrame();
+        const TOptional<uint64> EndHash = Scene->GetSnapshotHash(EndFrame);
+
+        uint32 NumMissing = 0;
+        for (uint64 Frame = RestoreFrame; Frame <= EndFrame; ++Frame)
+        {
+            NumMissing += !Scene->GetSnapshotHash(Frame).has_value();
+        }
+
+        TEST_CHECK(EndFrame > RestoreFrame + NumReplayedFrames);
+        TEST_CHECK(NumMissing == 0);
+        TEST_CHECK(EndHash.has_value());
+
+        // Restoring writes every transform, none of those writes may wake or move a body again.
+        TEST_CHECK(Scene->RestoreSnapshot(RestoreFrame));
+        World.Tick(DeltaTime, NumReplayedFrames);
+
+        TEST_CHECK(Scene->GetSimulationFrame() == EndFrame);
+        TEST_CHECK(EndHash.has_value() && Scene->GetSnapshotHash(EndFrame) == EndHash);
+    }
+
+    // A ring shorter than the keyframe interval still has to hold a keyframe to decode its frames against.
+    LUMINA_AUTOMATION_TEST("Physics.Snapshot.KeyframeIntervalPastCapacity")
+    {
+        TScopedConsoleVariable<int32> SnapshotFrames("Physics.Snapshot.Frames", 10);
+        TScopedConsoleVariable<int32> KeyframeInterval("Physics.Snapshot.KeyframeInterval", 30);
+
+        FAutomationWorld World;
+        SpawnFallingSpheres(World);
+        Physics::IPhysicsScene* Scene = World->GetPhysicsScene();
+
+        World.Tick(1.0 / 60.0, 40);
+
+        TEST_CHECK(Scene->RestoreSnapshot(Scene->GetSimulationFrame() - 5));
+    }
+
+    // Cost of recording 10k falling bodies every step, keyframes against deltas, and of restoring the latest one.
+    LUMINA_AUTOMATION_TEST("Benchmark.Physics.Snapshot10k")
+    {
+        constexpr uint32 NumBodies = 10'000;
+        constexpr uint32 NumFrames = 60;
+        constexpr uint32 KeyframeInterval = 30;
+
+        FAutomationWorld World;
+        SpawnSphereGrid(World, NumBodies);
+        Physics::FJoltPhysicsScene* Scene = static_cast<Physics::FJoltPhysicsScene*>(World->GetPhysicsScene());
+        JPH::PhysicsSystem* System = Scene->GetPhysicsSystem();
+
+        // Recorded here rather than by the scene, so only the snapshot itself is timed.
+        Physics::FJoltSnapshotHistory History;
+        History.Reset(NumFrames, KeyframeInterval);
+
+        double KeyframeMs = 0.0;
+        double DeltaMs = 0.0;
+        for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            World.Tick(1.0 / 60.0);
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            History.Record(Scene->GetSimulationFrame(), 0.0, [&](JPH::StateRecorder& Recorder)
+            {
+                System->SaveState(Recorder);
+            });
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            (Frame % KeyframeInterval == 0 ? KeyframeMs : DeltaMs) += Duration.count();
+        }
+
+        const uint32 NumKeyframes = (NumFrames + KeyframeInterval - 1) / KeyframeInterval;
+        TEST_CHECK(History.GetNumSnapshots() == NumFrames);
+
+        const uint64 LatestFrame = Scene->GetSimulationFrame();
+        const TOptional<uint64> LatestHash = History.GetHash(LatestFrame);
+
+        const auto Start = std::chrono::high_resolution_clock::now();
+        const bool bRestored = History.Restore(LatestFrame, [&](JPH::StateRecorder& Recorder)
+        {
+            return System->RestoreState(Recorder);
+        });
+        const std::chrono::duration<double, std::milli> RestoreDuration = std::chrono::high_resolution_clock::now() - Start;
+
+        TEST_CHECK(bRestored);
+        TEST_CHECK(LatestHash.has_value());
+
+        LOG_INFO("[{}] {} bodies: keyframe {:.3f} ms, delta {:.3f} ms, restore {:.3f} ms, {} KB for {} snapshots", Test.GetName(), NumBodies,
+            KeyframeMs / NumKeyframes, DeltaMs / (NumFrames - NumKeyframes), RestoreDuration.count(), History.GetStoredSize() / 1024, NumFrames);
+    }
+}
+
+#endif
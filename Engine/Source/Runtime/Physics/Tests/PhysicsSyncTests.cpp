@@ -0,0 +1,125 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Physics/API/Jolt/JoltPhysicsScene.h"
+#include "World/Entity/Components/DirtyComponent.h"
+#include "World/Entity/Components/PhysicsComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** One in every ActiveStride bodies keeps falling, the rest are put to sleep right after simulation starts. */
+        constexpr uint32 ActiveStride = 100;
+
+        /** Spheres on a grid far enough apart that the falling ones never wake a sleeping neighbour. */
+        TVector<entt::entity> SpawnMostlySleepingSpheres(FAutomationWorld& World, uint32 Num)
+        {
+            FEntityRegistry& Registry = World.GetRegistry();
+
+            TVector<entt::entity> Entities;
+            Entities.reserve(Num);
+            for (uint32 i = 0; i < Num; ++i)
+            {
+                const glm::vec3 Location(static_cast<float>(i % 250) * 4.0f, 10.0f, static_cast<float>(i / 250) * 4.0f);
+                entt::entity Sphere = World->ConstructEntity(FName("Sphere"), FTransform(Location));
+                Registry.emplace<SSphereColliderComponent>(Sphere);
+                Entities.push_back(Sphere);
+            }
+
+            World->SimulateWorld();
+
+            Physics::IPhysicsScene* Scene = World->GetPhysicsScene();
+            for (uint32 i = 0; i < Num; ++i)
+            {
+                if (i % ActiveStride != 0)
+                {
+                    Scene->DeactivateBody(Registry.get<SRigidBodyComponent>(Entities[i]).BodyID);
+                }
+            }
+
+            return Entities;
+        }
+
+        /** Transforms the last sync wrote, each sync flags the entities it moved. */
+        uint32 CountSyncedTransforms(FAutomationWorld& World)
+        {
+            uint32 NumSynced = 0;
+            World.GetRegistry().view<FNeedsTransformUpdate>().each([&](const FNeedsTransformUpdate& Update)
+            {
+                NumSynced += Update.bFromPhysics ? 1 : 0;
+            });
+            return NumSynced;
+        }
+    }
+
+    // Both sync paths move exactly the awake bodies, and a body falling asleep is synced once more at its resting pose.
+    LUMINA_AUTOMATION_TEST("Physics.Sync.OnlyActiveBodies")
+    {
+        constexpr uint32 NumBodies = 1'000;
+
+        FAutomationWorld World;
+        const TVector<entt::entity> Entities = SpawnMostlySleepingSpheres(World, NumBodies);
+        Physics::FJoltPhysicsScene* Scene = static_cast<Physics::FJoltPhysicsScene*>(World->GetPhysicsScene());
+
+        // The first frame also syncs every body that was just put to sleep.
+        World.Tick(1.0 / 60.0);
+
+        ForEachConsoleToggle("Physics.ActiveBodySync", [&](bool)
+        {
+            World.GetRegistry().clear<FNeedsTransformUpdate>();
+            Scene->SyncTransforms();
+            TEST_CHECK(CountSyncedTransforms(World) == NumBodies / ActiveStride);
+        });
+
+        const entt::entity Falling = Entities[0];
+        TEST_CHECK(World.GetRegistry().get<STransformComponent>(Falling).GetLocation().y < 10.0f);
+        TEST_CHECK(World.GetRegistry().get<STransformComponent>(Entities[1]).GetLocation().y == 10.0f);
+
+        // Put to sleep mid-fall, the next sync still writes where the body stopped.
+        World.Tick(1.0 / 60.0, 10);
+        Scene->DeactivateBody(World.GetRegistry().get<SRigidBodyComponent>(Falling).BodyID);
+        World.GetRegistry().clear<FNeedsTransformUpdate>();
+        Scene->SyncTransforms();
+
+        const JPH::BodyID FallingID(World.GetRegistry().get<SRigidBodyComponent>(Falling).BodyID);
+        const float BodyY = static_cast<float>(Scene->GetPhysicsSystem()->GetBodyInterface().GetPosition(FallingID).GetY());
+        TEST_CHECK(World.GetRegistry().any_of<FNeedsTransformUpdate>(Falling));
+        TEST_CHECK(World.GetRegistry().get<STransformComponent>(Falling).GetLocation().y == BodyY);
+        TEST_CHECK(CountSyncedTransforms(World) == NumBodies / ActiveStride);
+    }
+
+    // Sync cost of 50k bodies with 1% of them awake, every body checked against the active body list alone.
+    LUMINA_AUTOMATION_TEST("Benchmark.Physics.SyncActiveBodies50k")
+    {
+        constexpr uint32 NumBodies = 50'000;
+        constexpr uint32 NumSyncs = 100;
+
+        FAutomationWorld World;
+        SpawnMostlySleepingSpheres(World, NumBodies);
+        Physics::FJoltPhysicsScene* Scene = static_cast<Physics::FJoltPhysicsScene*>(World->GetPhysicsScene());
+        World.Tick(1.0 / 60.0, 2);
+
+        ForEachConsoleToggle("Physics.ActiveBodySync", [&](bool bActiveOnly)
+        {
+            World.GetRegistry().clear<FNeedsTransformUpdate>();
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            for (uint32 i = 0; i < NumSyncs; ++i)
+            {
+                Scene->SyncTransforms();
+            }
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            TEST_CHECK(CountSyncedTransforms(World) == NumBodies / ActiveStride);
+
+            LOG_INFO("[{}] {} bodies, {} awake, {}: {:.3f} ms per sync", Test.GetName(), NumBodies, NumBodies / ActiveStride,
+                bActiveOnly ? "active body list" : "every body", Duration.count() / NumSyncs);
+        });
+    }
+}
+
+#endif
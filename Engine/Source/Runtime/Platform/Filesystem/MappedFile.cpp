@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#if defined(LE_PLATFORM_WINDOWS)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Lumina
+{
+    FMappedFile::~FMappedFile()
+    {
+        Close();
+    }
+
+    bool FMappedFile::Open(FStringView Path)
+    {
+        Close();
+
+        FFixedString PathString(Path.begin(), Path.end());
+
+#if defined(LE_PLATFORM_WINDOWS)
+        HANDLE File = CreateFileA(PathString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (File == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER FileSize;
+        if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart == 0)
+        {
+            CloseHandle(File);
+            return false;
+        }
+
+        HANDLE Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (Mapping == nullptr)
+        {
+            CloseHandle(File);
+            return false;
+        }
+
+        void* View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (View == nullptr)
+        {
+            CloseHandle(Mapping);
+            CloseHandle(File);
+            return false;
+        }
+
+        FileHandle      = File;
+        MappingHandle   = Mapping;
+        Data            = static_cast<const uint8*>(View);
+        Size            = static_cast<uint64>(FileSize.QuadPart);
+#else
+        int File = open(PathString.c_str(), O_RDONLY);
+        if (File < 0)
+        {
+            return false;
+        }
+
+        struct stat Stat;
+        if (fstat(File, &Stat) != 0 || Stat.st_size == 0)
+        {
+            close(File);
+            return false;
+        }
+
+        void* View = mmap(nullptr, static_cast<size_t>(Stat.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+        close(File);
+        if (View == MAP_FAILED)
+        {
+            return false;
+        }
+
+        Data = static_cast<const uint8*>(View);
+        Size = static_cast<uint64>(Stat.st_size);
+#endif
+
+        return true;
+    }
+
+    void FMappedFile::Close()
+    {
+        if (Data == nullptr)
+        {
+            return;
+        }
+
+#if defined(LE_PLATFORM_WINDOWS)
+        UnmapViewOfFile(Data);
+        CloseHandle(static_cast<HANDLE>(MappingHandle));
+        CloseHandle(static_cast<HANDLE>(FileHandle));
+#else
+        munmap(const_cast<uint8*>(Data), static_cast<size_t>(Size));
+#endif
+
+        Data            = nullptr;
+        Size            = 0;
+        FileHandle      = nullptr;
+        MappingHandle   = nullptr;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Containers/String.h"
+#include "Platform/GenericPlatform.h"
+
+namespace Lumina
+{
+    /** Read only view of a whole file mapped into the address space, pages are faulted in as they are touched. */
+    class RUNTIME_API FMappedFile
+    {
+    public:
+
+        FMappedFile() = default;
+        ~FMappedFile();
+
+        FMappedFile(const FMappedFile&) = delete;
+        FMappedFile& operator=(const FMappedFile&) = delete;
+
+        bool Open(FStringView Path);
+        void Close();
+
+        bool IsOpen() const { return Data != nullptr; }
+        const uint8* GetData() const { return Data; }
+        uint64 GetSize() const { return Size; }
+
+    private:
+
+        const uint8*    Data = nullptr;
+        uint64          Size = 0;
+
+        void*           FileHandle = nullptr;
+        void*           MappingHandle = nullptr;
+    };
+}
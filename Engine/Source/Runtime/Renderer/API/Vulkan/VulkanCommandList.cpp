@@ -143,6 +143,38 @@ namespace Lumina
         
         FVulkanImage* VulkanImageSrc = (FVulkanImage*)Src;
         FVulkanImage* VulkanImageDst = (FVulkanImage*)Dst;
+
+        // An explicit size on both slices asks for a texel exact region copy, otherwise the whole image is blitted.
+        const bool bRegionCopy = SrcSlice.Width != uint32(-1) && DstSlice.Width != uint32(-1) && Src->GetFormat() == Dst->GetFormat();
+        if (bRegionCopy)
+        {
+            VkImageCopy2 CopyRegion                     = {};
+            CopyRegion.sType                            = VK_STRUCTURE_TYPE_IMAGE_COPY_2;
+            CopyRegion.srcSubresource.aspectMask        = VulkanImageSrc->GetFullAspectMask();
+            CopyRegion.srcSubresource.mipLevel          = SrcSlice.MipLevel;
+            CopyRegion.srcSubresource.baseArrayLayer    = SrcSlice.ArraySlice;
+            CopyRegion.srcSubresource.layerCount        = 1;
+            CopyRegion.srcOffset                        = { (int32)SrcSlice.X, (int32)SrcSlice.Y, (int32)SrcSlice.Z };
+            CopyRegion.dstSubresource.aspectMask        = VulkanImageDst->GetFullAspectMask();
+            CopyRegion.dstSubresource.mipLevel          = DstSlice.MipLevel;
+            CopyRegion.dstSubresource.baseArrayLayer    = DstSlice.ArraySlice;
+            CopyRegion.dstSubresource.layerCount        = 1;
+            CopyRegion.dstOffset                        = { (int32)DstSlice.X, (int32)DstSlice.Y, (int32)DstSlice.Z };
+            CopyRegion.extent                           = { SrcSlice.Width, SrcSlice.Height, SrcSlice.Depth == uint32(-1) ? 1u : SrcSlice.Depth };
+
+            VkCopyImageInfo2 CopyInfo                   = {};
+            CopyInfo.sType                              = VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2;
+            CopyInfo.srcImage                           = Src->GetAPI<VkImage>();
+            CopyInfo.srcImageLayout                     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            CopyInfo.dstImage                           = Dst->GetAPI<VkImage>();
+            CopyInfo.dstImageLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            CopyInfo.regionCount                        = 1;
+            CopyInfo.pRegions                           = &CopyRegion;
+
+            CommandListStats.NumCopies++;
+            vkCmdCopyImage2(CurrentCommandBuffer->CommandBuffer, &CopyInfo);
+            return;
+        }
         
         VkBlitImageInfo2 BlitInfo                   = {};
         BlitInfo.sType                              = VK_STRUCTURE_TYPE_BLIT_IMAGE_INFO_2;
@@ -1146,6 +1178,8 @@ namespace Lumina
         RenderInfo.colorAttachmentCount     = (uint32)ColorAttachments.size();
         RenderInfo.pColorAttachments        = ColorAttachments.data();
         RenderInfo.pDepthAttachment         = (DepthAttachment.imageView != VK_NULL_HANDLE) ? &DepthAttachment : nullptr;
+        RenderInfo.renderArea.offset.x      = (int32)PassInfo.RenderOffset.x;
+        RenderInfo.renderArea.offset.y      = (int32)PassInfo.RenderOffset.y;
         RenderInfo.renderArea.extent.width  = PassInfo.RenderArea.x;
         RenderInfo.renderArea.extent.height = PassInfo.RenderArea.y;
         RenderInfo.layerCount               = 1;//NumArraySlices;
@@ -1,100 +1,289 @@
 #include "pch.h"
 #include "VulkanPipelineCache.h"
 
+#include "VulkanDevice.h"
+#include "VulkanMacros.h"
+#include "VulkanRenderContext.h"
 #include "VulkanResources.h"
 #include "Core/Profiler/Profile.h"
+#include "Paths/Paths.h"
+#include "Platform/Filesystem/FileHelper.h"
+#include "TaskSystem/TaskSystem.h"
 
 namespace Lumina
 {
+    namespace
+    {
+        EFormat GetAttachmentFormat(const FRenderPassDesc::FAttachment& Attachment)
+        {
+            if (Attachment.Format == EFormat::UNKNOWN && Attachment.Image)
+            {
+                return Attachment.Image->GetDescription().Format;
+            }
 
-    FRHIGraphicsPipeline* FVulkanPipelineCache::GetOrCreateGraphicsPipeline(FVulkanDevice* Device, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc)
+            return Attachment.Format;
+        }
+
+        void AddRenderState(FPipelineKey& Key, const FRenderState& State)
+        {
+            const FBlendState& Blend = State.BlendState;
+            for (const FBlendState::RenderTarget& Target : Blend.Targets)
+            {
+                Key.Add(Target.bBlendEnable);
+                Key.Add(Target.SrcBlend);
+                Key.Add(Target.DestBlend);
+                Key.Add(Target.BlendOp);
+                Key.Add(Target.SrcBlendAlpha);
+                Key.Add(Target.DestBlendAlpha);
+                Key.Add(Target.BlendOpAlpha);
+                Key.Add(Target.ColorWriteMask);
+            }
+            Key.Add(Blend.AlphaToCoverageEnable);
+
+            const FDepthStencilState& DepthStencil = State.DepthStencilState;
+            Key.Add(DepthStencil.DepthTestEnable);
+            Key.Add(DepthStencil.DepthWriteEnable);
+            Key.Add(DepthStencil.DepthFunc);
+            Key.Add(DepthStencil.StencilEnable);
+            Key.Add(DepthStencil.StencilReadMask);
+            Key.Add(DepthStencil.StencilWriteMask);
+            Key.Add(DepthStencil.StencilRefValue);
+            Key.Add(DepthStencil.DynamicStencilRef);
+            for (const FDepthStencilState::StencilOpDesc& Face : { DepthStencil.FrontFaceStencil, DepthStencil.BackFaceStencil })
+            {
+                Key.Add(Face.FailOp);
+                Key.Add(Face.DepthFailOp);
+                Key.Add(Face.PassOp);
+                Key.Add(Face.StencilFunc);
+            }
+
+            const FRasterState& Raster = State.RasterState;
+            Key.Add(Raster.FillMode);
+            Key.Add(Raster.CullMode);
+            Key.Add(Raster.FrontCounterClockwise);
+            Key.Add(Raster.DepthClipEnable);
+            Key.Add(Raster.ScissorEnable);
+            Key.Add(Raster.MultisampleEnable);
+            Key.Add(Raster.AntialiasedLineEnable);
+            Key.Add(Raster.DepthBias);
+            Key.Add(Raster.DepthBiasClamp);
+            Key.Add(Raster.SlopeScaledDepthBias);
+            Key.Add(Raster.LineWidth);
+            Key.Add(Raster.ForcedSampleCount);
+            Key.Add(Raster.ProgrammableSamplePositionsEnable);
+            Key.Add(Raster.ConservativeRasterEnable);
+            Key.Add(Raster.QuadFillEnable);
+            for (uint32 i = 0; i < std::size(Raster.SamplePositionsX); ++i)
+            {
+                Key.Add(Raster.SamplePositionsX[i]);
+                Key.Add(Raster.SamplePositionsY[i]);
+            }
+
+            Key.Add(State.SinglePassStereo.bEnabled);
+            Key.Add(State.SinglePassStereo.bIndependentViewportMask);
+            Key.Add(State.SinglePassStereo.RenderTargetIndexOffset);
+        }
+    }
+
+    FPipelineKey FVulkanPipelineCache::MakeGraphicsKey(const FGraphicsPipelineDesc& Desc, const FRenderPassDesc& RenderPassDesc)
     {
-        LUMINA_PROFILE_SCOPE();
+        FPipelineKey Key;
+        AddRenderState(Key, Desc.RenderState);
+
+        Key.Add(Desc.PrimType);
+        Key.Add(Desc.ShadingRateState.bEnabled);
+        Key.Add(Desc.ShadingRateState.ShadingRate);
+        Key.Add(Desc.ShadingRateState.PipelinePrimitiveCombiner);
+        Key.Add(Desc.ShadingRateState.ImageCombiner);
+
+        Key.Add(Desc.VS.GetReference());
+        Key.Add(Desc.PS.GetReference());
+        Key.Add(Desc.GS.GetReference());
+        Key.Add(Desc.InputLayout.GetReference());
 
-        size_t Hash;
-        Hash::HashCombine(Hash, InDesc);
-        Hash::HashCombine(Hash, RenderPassDesc);
-        
-        if (GraphicsPipelines.find(Hash) != GraphicsPipelines.end())
+        Key.Add(static_cast<uint32>(Desc.BindingLayouts.size()));
+        for (const FRHIBindingLayoutRef& Layout : Desc.BindingLayouts)
         {
-            return GraphicsPipelines.at(Hash);
+            Key.Add(Layout.GetReference());
         }
-        
-        auto NewPipeline = TRefCountPtr<FVulkanGraphicsPipeline>::Create(Device, InDesc, RenderPassDesc);
-        
 
-        GraphicsPipelines.emplace(Hash, NewPipeline);
-        return NewPipeline;
+        // Only what pipeline creation actually reads from the pass, images and load ops are free to change.
+        Key.Add(static_cast<uint32>(RenderPassDesc.ColorAttachments.size()));
+        for (const FRenderPassDesc::FAttachment& Attachment : RenderPassDesc.ColorAttachments)
+        {
+            Key.Add(GetAttachmentFormat(Attachment));
+        }
+
+        Key.Add(RenderPassDesc.DepthAttachment.IsValid() ? GetAttachmentFormat(RenderPassDesc.DepthAttachment) : EFormat::UNKNOWN);
+        Key.Add(RenderPassDesc.SampleCount);
+        Key.Add(RenderPassDesc.ViewMask);
+
+        Key.Finalize();
+        return Key;
     }
 
-    FRHIComputePipeline* FVulkanPipelineCache::GetOrCreateComputePipeline(FVulkanDevice* Device, const FComputePipelineDesc& InDesc)
+    FPipelineKey FVulkanPipelineCache::MakeComputeKey(const FComputePipelineDesc& Desc)
     {
-        LUMINA_PROFILE_SCOPE();
+        FPipelineKey Key;
+        Key.Add(Desc.CS.GetReference());
 
-        size_t Hash = Hash::GetHash(InDesc);
-        if (ComputePipelines.find(Hash) != ComputePipelines.end())
+        Key.Add(static_cast<uint32>(Desc.BindingLayouts.size()));
+        for (const FRHIBindingLayoutRef& Layout : Desc.BindingLayouts)
         {
-            return ComputePipelines.at(Hash);
+            Key.Add(Layout.GetReference());
         }
-        
-        auto NewPipeline = MakeRefCount<FVulkanComputePipeline>(Device, InDesc);
 
-        FScopeLock Lock(ShaderMutex);
-        ComputePipelines.emplace(Hash, NewPipeline);
-        return NewPipeline;
+        Key.Finalize();
+        return Key;
     }
 
-    void FVulkanPipelineCache::PostShaderRecompiled(const FRHIShader* Shader)
+    void FVulkanPipelineCache::Initialize(FVulkanDevice* Device)
     {
-        FScopeLock Lock(ShaderMutex);
-        if (Shader)
+        LUMINA_PROFILE_SCOPE();
+
+        const VkPhysicalDeviceProperties Properties = Device->GetPhysicalDeviceProperties();
+        const FString CachePath = GetPipelineCachePath();
+
+        TVector<uint8> Data;
+        if (Paths::Exists(CachePath) && FileHelper::LoadFileToArray(Data, CachePath))
         {
-            const FString& ShaderName = Shader->GetShaderHeader().DebugName;
+            VkPipelineCacheHeaderVersionOne Header = {};
+            bool bValid = Data.size() >= sizeof(VkPipelineCacheHeaderVersionOne);
+            if (bValid)
+            {
+                Memory::Memcpy(&Header, Data.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+                bValid = Header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+                    && Header.vendorID == Properties.vendorID
+                    && Header.deviceID == Properties.deviceID
+                    && std::memcmp(Header.pipelineCacheUUID, Properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+            }
 
-            for (auto it = GraphicsPipelines.begin(); it != GraphicsPipelines.end(); )
+            if (!bValid)
             {
-                auto& Desc = it->second->GetDesc();
+                LOG_WARN("Discarding pipeline cache from a different device or driver: {}", CachePath);
+                Data.clear();
+            }
+        }
 
-                bool bMatches =
-                    (Desc.VS && Desc.VS->GetShaderHeader().DebugName == ShaderName) ||
-                    (Desc.PS && Desc.PS->GetShaderHeader().DebugName == ShaderName) ||
-                    (Desc.GS && Desc.GS->GetShaderHeader().DebugName == ShaderName);
+        VkPipelineCacheCreateInfo CreateInfo = {};
+        CreateInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        CreateInfo.initialDataSize  = Data.size();
+        CreateInfo.pInitialData     = Data.empty() ? nullptr : Data.data();
 
-                if (bMatches)
-                {
-                    it = GraphicsPipelines.erase(it);
-                }
-                else
-                {
-                    ++it;
-                }
-            }
+        VK_CHECK(vkCreatePipelineCache(Device->GetDevice(), &CreateInfo, VK_ALLOC_CALLBACK, &DriverCache));
+
+        LOG_INFO("Vulkan pipeline cache initialized ({} bytes loaded)", Data.size());
+    }
 
-            for (auto it = ComputePipelines.begin(); it != ComputePipelines.end(); )
+    void FVulkanPipelineCache::Shutdown(FVulkanDevice* Device)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        if (DriverCache == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        size_t Size = 0;
+        if (vkGetPipelineCacheData(Device->GetDevice(), DriverCache, &Size, nullptr) == VK_SUCCESS && Size > 0)
+        {
+            TVector<uint8> Data(Size);
+            if (vkGetPipelineCacheData(Device->GetDevice(), DriverCache, &Size, Data.data()) == VK_SUCCESS)
             {
-                auto& Pipeline = it->second;
-                if (Pipeline->GetDesc().CS && Pipeline->GetDesc().CS->GetShaderHeader().DebugName == ShaderName)
+                Data.resize(Size);
+
+                const FString& CacheDirectory = Paths::GetEngineCacheDirectory();
+                if (!Paths::Exists(CacheDirectory))
                 {
-                    it = ComputePipelines.erase(it);
+                    Paths::CreateDirectories(CacheDirectory);
                 }
-                else
+
+                if (!FileHelper::SaveArrayToFile(Data, GetPipelineCachePath()))
                 {
-                    ++it;
+                    LOG_WARN("Failed to write pipeline cache: {}", GetPipelineCachePath());
                 }
             }
         }
-        else
+
+        vkDestroyPipelineCache(Device->GetDevice(), DriverCache, VK_ALLOC_CALLBACK);
+        DriverCache = VK_NULL_HANDLE;
+    }
+
+    FRHIGraphicsPipeline* FVulkanPipelineCache::GetOrCreateGraphicsPipeline(FVulkanDevice* Device, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const FPipelineKey Key = MakeGraphicsKey(InDesc, RenderPassDesc);
+        return GraphicsPipelines.FindOrCreate(Key, [&]() -> FRHIGraphicsPipelineRef
         {
-            GraphicsPipelines.clear();
-            ComputePipelines.clear();
+            return TRefCountPtr<FVulkanGraphicsPipeline>::Create(Device, InDesc, RenderPassDesc, DriverCache);
+        });
+    }
+
+    FRHIComputePipeline* FVulkanPipelineCache::GetOrCreateComputePipeline(FVulkanDevice* Device, const FComputePipelineDesc& InDesc)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const FPipelineKey Key = MakeComputeKey(InDesc);
+        return ComputePipelines.FindOrCreate(Key, [&]() -> FRHIComputePipelineRef
+        {
+            return MakeRefCount<FVulkanComputePipeline>(Device, InDesc, DriverCache);
+        });
+    }
+
+    FTaskHandle FVulkanPipelineCache::PrecompileGraphicsPipelines(FVulkanDevice* Device, TVector<FGraphicsPipelineRequest>&& Requests)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const uint32 NumRequests = static_cast<uint32>(Requests.size());
+        TSharedPtr<TVector<FGraphicsPipelineRequest>> SharedRequests = MakeShared<TVector<FGraphicsPipelineRequest>>(Move(Requests));
+
+        return Task::AsyncTask(NumRequests, 1, [this, Device, SharedRequests](uint32 Start, uint32 End, uint32 Thread)
+        {
+            LUMINA_PROFILE_SECTION("Precompile Graphics Pipelines");
+
+            for (uint32 i = Start; i < End; ++i)
+            {
+                const FGraphicsPipelineRequest& Request = (*SharedRequests)[i];
+                GetOrCreateGraphicsPipeline(Device, Request.Desc, Request.RenderPass);
+            }
+        }, ETaskPriority::Low);
+    }
+
+    void FVulkanPipelineCache::PostShaderRecompiled(const FRHIShader* Shader)
+    {
+        if (Shader == nullptr)
+        {
+            ReleasePipelines();
+            return;
         }
+
+        const FString& ShaderName = Shader->GetShaderHeader().DebugName;
+        auto MatchesShader = [&](const FRHIShader* Other)
+        {
+            return Other && Other->GetShaderHeader().DebugName == ShaderName;
+        };
+
+        GraphicsPipelines.RemoveIf([&](const FRHIGraphicsPipelineRef& Pipeline)
+        {
+            const FGraphicsPipelineDesc& Desc = Pipeline->GetDesc();
+            return MatchesShader(Desc.VS) || MatchesShader(Desc.PS) || MatchesShader(Desc.GS);
+        });
+
+        ComputePipelines.RemoveIf([&](const FRHIComputePipelineRef& Pipeline)
+        {
+            return MatchesShader(Pipeline->GetDesc().CS);
+        });
     }
-    
+
     void FVulkanPipelineCache::ReleasePipelines()
     {
-        FScopeLock Lock(ShaderMutex);
+        GraphicsPipelines.Clear();
+        ComputePipelines.Clear();
+    }
 
-        GraphicsPipelines.clear();
-        ComputePipelines.clear();
+    FString FVulkanPipelineCache::GetPipelineCachePath() const
+    {
+        return Paths::GetEngineCacheDirectory() + "/VulkanPipelineCache.bin";
     }
 }
@@ -1,8 +1,10 @@
 ﻿#pragma once
+#include <volk/volk.h>
 #include "Containers/Array.h"
 #include "Containers/Name.h"
 #include "Core/Threading/Thread.h"
 #include "Renderer/RenderResource.h"
+#include "TaskSystem/TaskTypes.h"
 
 
 namespace Lumina
@@ -17,6 +19,138 @@ namespace Lumina
 
 namespace Lumina
 {
+    /**
+     * Every descriptor field a pipeline is built from, flattened field by field into bytes.
+     * Equality compares the bytes, so two descriptors only share a pipeline when they are identical, not when their hashes collide.
+     */
+    struct FPipelineKey
+    {
+        template<typename T>
+        requires (eastl::is_arithmetic_v<T> || eastl::is_enum_v<T> || eastl::is_pointer_v<T>)
+        void Add(T Value)
+        {
+            const uint8* Data = reinterpret_cast<const uint8*>(&Value);
+            Bytes.insert(Bytes.end(), Data, Data + sizeof(T));
+        }
+
+        void Finalize()
+        {
+            Hash = Hash::GetHash64(Bytes.data(), Bytes.size());
+        }
+
+        bool operator==(const FPipelineKey& Other) const
+        {
+            return Hash == Other.Hash && Bytes == Other.Bytes;
+        }
+
+        TFixedVector<uint8, 256>    Bytes;
+        uint64                      Hash = 0;
+    };
+}
+
+namespace eastl
+{
+    template<>
+    struct hash<Lumina::FPipelineKey>
+    {
+        size_t operator()(const Lumina::FPipelineKey& Key) const
+        {
+            return Key.Hash;
+        }
+    };
+}
+
+namespace Lumina
+{
+    /**
+     * Pipelines by key, split across shards guarded by shared mutexes so lookups of different pipelines never contend.
+     * A miss runs the creator outside the lock, if two threads race on the same key the first insert wins and both get it.
+     */
+    template<typename TPipelineRef>
+    class TPipelineMap
+    {
+    public:
+
+        static constexpr uint32 NumShards = 16;
+
+        template<typename TCreateFunc>
+        TPipelineRef FindOrCreate(const FPipelineKey& Key, TCreateFunc&& Create)
+        {
+            FShard& Shard = Shards[GetShardIndex(Key)];
+
+            {
+                FReadScopeLock Lock(Shard.Mutex);
+                auto It = Shard.Pipelines.find(Key);
+                if (It != Shard.Pipelines.end())
+                {
+                    return It->second;
+                }
+            }
+
+            // Built outside the lock so a slow driver compile never stalls lookups of other pipelines.
+            TPipelineRef NewPipeline = Create();
+
+            FWriteScopeLock Lock(Shard.Mutex);
+            auto [It, bInserted] = Shard.Pipelines.try_emplace(Key, NewPipeline);
+            return It->second;
+        }
+
+        template<typename TPredicate>
+        void RemoveIf(TPredicate&& Predicate)
+        {
+            for (FShard& Shard : Shards)
+            {
+                FWriteScopeLock Lock(Shard.Mutex);
+                for (auto It = Shard.Pipelines.begin(); It != Shard.Pipelines.end(); )
+                {
+                    if (Predicate(It->second))
+                    {
+                        It = Shard.Pipelines.erase(It);
+                    }
+                    else
+                    {
+                        ++It;
+                    }
+                }
+            }
+        }
+
+        void Clear()
+        {
+            for (FShard& Shard : Shards)
+            {
+                FWriteScopeLock Lock(Shard.Mutex);
+                Shard.Pipelines.clear();
+            }
+        }
+
+        uint32 Num() const
+        {
+            uint32 Total = 0;
+            for (const FShard& Shard : Shards)
+            {
+                FReadScopeLock Lock(Shard.Mutex);
+                Total += static_cast<uint32>(Shard.Pipelines.size());
+            }
+            return Total;
+        }
+
+        /** The high bits pick the shard, the low bits are left for the buckets inside it. */
+        static uint32 GetShardIndex(const FPipelineKey& Key)
+        {
+            return static_cast<uint32>(Key.Hash >> 60) % NumShards;
+        }
+
+    private:
+
+        struct FShard
+        {
+            mutable FSharedMutex                    Mutex;
+            THashMap<FPipelineKey, TPipelineRef>    Pipelines;
+        };
+
+        FShard Shards[NumShards];
+    };
 
     class FVulkanPipelineCache
     {
@@ -27,17 +161,31 @@ namespace Lumina
             TVector<FName> Shaders;
         };
 
+        /** Creates the driver pipeline cache, seeded from disk when the blob matches this device. */
+        void Initialize(FVulkanDevice* Device);
+
+        /** Writes the driver pipeline cache back to disk. */
+        void Shutdown(FVulkanDevice* Device);
+
         FRHIGraphicsPipeline* GetOrCreateGraphicsPipeline(FVulkanDevice* Device, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc);
         FRHIComputePipeline* GetOrCreateComputePipeline(FVulkanDevice* Device, const FComputePipelineDesc& InDesc);
 
+        /** Creates the requested pipelines on worker tasks, safe to call while the render thread keeps looking pipelines up. */
+        FTaskHandle PrecompileGraphicsPipelines(FVulkanDevice* Device, TVector<FGraphicsPipelineRequest>&& Requests);
+
         void PostShaderRecompiled(const FRHIShader* Shader);
         void ReleasePipelines();
-        
+
+        static FPipelineKey MakeGraphicsKey(const FGraphicsPipelineDesc& Desc, const FRenderPassDesc& RenderPassDesc);
+        static FPipelineKey MakeComputeKey(const FComputePipelineDesc& Desc);
+
     private:
 
-        FMutex ShaderMutex;
-        THashMap<size_t, FRHIGraphicsPipelineRef>   GraphicsPipelines;
-        THashMap<size_t, FRHIComputePipelineRef>    ComputePipelines;
-        
+        FString GetPipelineCachePath() const;
+
+        TPipelineMap<FRHIGraphicsPipelineRef>       GraphicsPipelines;
+        TPipelineMap<FRHIComputePipelineRef>        ComputePipelines;
+
+        VkPipelineCache                             DriverCache = VK_NULL_HANDLE;
     };
 }
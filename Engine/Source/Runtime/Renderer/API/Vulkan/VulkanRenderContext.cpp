@@ -538,6 +538,8 @@ namespace Lumina
         ShaderLibrary = MakeRefCount<FShaderLibrary>();
         ShaderCompiler = Memory::New<FSpirVShaderCompiler>();
         ShaderCompiler->Initialize();
+        
+        PipelineCache.Initialize(VulkanDevice);
             
         CompileEngineShaders();
         
@@ -558,6 +560,7 @@ namespace Lumina
         
         ShaderLibrary.SafeRelease();
         PipelineCache.ReleasePipelines();
+        PipelineCache.Shutdown(VulkanDevice);
         
         Memory::Delete(Swapchain);
         
@@ -1102,6 +1105,11 @@ namespace Lumina
         return PipelineCache.GetOrCreateGraphicsPipeline(VulkanDevice, Desc, RenderPassDesc);
     }
 
+    FTaskHandle FVulkanRenderContext::PrecompileGraphicsPipelines(TVector<FGraphicsPipelineRequest>&& Requests)
+    {
+        return PipelineCache.PrecompileGraphicsPipelines(VulkanDevice, Move(Requests));
+    }
+
     RHI::ICrashTracker& FVulkanRenderContext::GetCrashTracker() const
     {
         return *CrashTracker;
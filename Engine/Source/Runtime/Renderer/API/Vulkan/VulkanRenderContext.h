@@ -220,6 +220,7 @@ namespace Lumina
         void CreateBindingSetAndLayout(const TBitFlags<ERHIShaderType>& Visibility, uint16 Binding, const FBindingSetDesc& Desc, FRHIBindingLayoutRef& OutLayout, FRHIBindingSetRef& OutBindingSet) override;
         NODISCARD FRHIComputePipelineRef CreateComputePipeline(const FComputePipelineDesc& Desc) override;
         NODISCARD FRHIGraphicsPipelineRef CreateGraphicsPipeline(const FGraphicsPipelineDesc& Desc, const FRenderPassDesc& RenderPassDesc) override;
+        FTaskHandle PrecompileGraphicsPipelines(TVector<FGraphicsPipelineRequest>&& Requests) override;
 
         NODISCARD const FRenderContextDesc& GetRenderContextDescription() const override { return Description; }
 
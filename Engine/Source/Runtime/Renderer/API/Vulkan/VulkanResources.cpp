@@ -1552,7 +1552,7 @@ namespace Lumina
         static_cast<FVulkanRenderContext*>(GRenderContext)->SetVulkanObjectName(DebugName, VK_OBJECT_TYPE_PIPELINE_LAYOUT, (uintptr_t)PipelineLayout);
     }
 
-    FVulkanGraphicsPipeline::FVulkanGraphicsPipeline(FVulkanDevice* InDevice, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc)
+    FVulkanGraphicsPipeline::FVulkanGraphicsPipeline(FVulkanDevice* InDevice, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc, VkPipelineCache PipelineCache)
         :FVulkanPipeline(InDevice)
     {
         Desc = InDesc;
@@ -1714,7 +1714,7 @@ namespace Lumina
         CreateInfo.renderPass                   = VK_NULL_HANDLE;
         CreateInfo.subpass                      = 0;
         
-        VK_CHECK(vkCreateGraphicsPipelines(Device->GetDevice(), nullptr, 1, &CreateInfo, VK_ALLOC_CALLBACK, &Pipeline));
+        VK_CHECK(vkCreateGraphicsPipelines(Device->GetDevice(), PipelineCache, 1, &CreateInfo, VK_ALLOC_CALLBACK, &Pipeline));
         static_cast<FVulkanRenderContext*>(GRenderContext)->SetVulkanObjectName(Desc.DebugName, VK_OBJECT_TYPE_PIPELINE, (uintptr_t)Pipeline);
 
     }
@@ -1730,7 +1730,7 @@ namespace Lumina
         return Pipeline;
     }
 
-    FVulkanComputePipeline::FVulkanComputePipeline(FVulkanDevice* InDevice, const FComputePipelineDesc& InDesc)
+    FVulkanComputePipeline::FVulkanComputePipeline(FVulkanDevice* InDevice, const FComputePipelineDesc& InDesc, VkPipelineCache PipelineCache)
         :FVulkanPipeline(InDevice)
     {
         Desc = InDesc;
@@ -1748,7 +1748,7 @@ namespace Lumina
         CreateInfo.stage = StageInfo;
         CreateInfo.layout = PipelineLayout;
         
-        VK_CHECK(vkCreateComputePipelines(Device->GetDevice(), nullptr, 1, &CreateInfo, VK_ALLOC_CALLBACK, &Pipeline));
+        VK_CHECK(vkCreateComputePipelines(Device->GetDevice(), PipelineCache, 1, &CreateInfo, VK_ALLOC_CALLBACK, &Pipeline));
         static_cast<FVulkanRenderContext*>(GRenderContext)->SetVulkanObjectName(Desc.DebugName, VK_OBJECT_TYPE_PIPELINE, (uintptr_t)Pipeline);
     }
 
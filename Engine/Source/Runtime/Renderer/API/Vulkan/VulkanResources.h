@@ -626,7 +626,7 @@ namespace Lumina
 
         friend class FVulkanRenderContext;
 
-        FVulkanGraphicsPipeline(FVulkanDevice* InDevice, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc);
+        FVulkanGraphicsPipeline(FVulkanDevice* InDevice, const FGraphicsPipelineDesc& InDesc, const FRenderPassDesc& RenderPassDesc, VkPipelineCache PipelineCache = VK_NULL_HANDLE);
 
         const FGraphicsPipelineDesc& GetDesc() const override { return Desc; }
         void* GetAPIResourceImpl(EAPIResourceType InType) override;
@@ -643,7 +643,7 @@ namespace Lumina
 
         friend class FVulkanRenderContext;
 
-        FVulkanComputePipeline(FVulkanDevice* InDevice, const FComputePipelineDesc& InDesc);
+        FVulkanComputePipeline(FVulkanDevice* InDevice, const FComputePipelineDesc& InDesc, VkPipelineCache PipelineCache = VK_NULL_HANDLE);
 
         const FComputePipelineDesc& GetDesc() const override { return Desc; }
         void* GetAPIResourceImpl(EAPIResourceType InType) override;
@@ -105,7 +105,8 @@ namespace Lumina
         virtual void Executed(FQueue* Queue, uint64 SubmissionID) = 0;
     
         /**
-         * Copies a region from one GPU image to another
+         * Copies a region from one GPU image to another.
+         * Slices without a size blit the whole image, giving both a size copies exactly that texel region.
          * @param Src Source image to copy from
          * @param SrcSlice Region of the source image (array/mip levels)
          * @param Dst Destination image to copy to
@@ -8,12 +8,53 @@
 
 namespace Lumina
 {
+    /**
+     * A cluster of at most MaxTriangles triangles with the bounds used to cull it.
+     * Its triangles are a contiguous range of the index buffer, so a run of meshlets draws as one range.
+     * Laid out in 16 byte rows so the array can be uploaded to a storage buffer as is.
+     */
+    struct FMeshlet final
+    {
+        static constexpr uint32 MaxVertices     = 64;
+        static constexpr uint32 MaxTriangles    = 124;
+        
+        /** Object space bounding sphere. */
+        glm::vec3   Center = glm::vec3(0.0f);
+        float       Radius = 0.0f;
+
+        /** Object space normal cone, every triangle faces away from a viewer inside the cone behind the sphere. */
+        glm::vec3   ConeAxis = glm::vec3(0.0f);
+        float       ConeCutoff = 1.0f;
+
+        uint32      StartIndex = 0;
+        uint32      IndexCount = 0;
+        uint32      Padding[2] = {};
+
+        friend FArchive& operator << (FArchive& Ar, FMeshlet& Data)
+        {
+            Ar << Data.Center;
+            Ar << Data.Radius;
+            Ar << Data.ConeAxis;
+            Ar << Data.ConeCutoff;
+            Ar << Data.StartIndex;
+            Ar << Data.IndexCount;
+
+            return Ar;
+        }
+    };
+    
+    static_assert(sizeof(FMeshlet) % 16 == 0, "FMeshlet must keep a 16 byte stride for storage buffers");
+    
     struct FGeometrySurface final
     {
         FName   ID;
         uint32  IndexCount = 0;
         uint32  StartIndex = 0;
         int16   MaterialIndex = -1;
+        
+        /** Range into FMeshResource::Meshlets, the meshlets cover exactly this surface's indices. Empty on simplified levels. */
+        uint32  FirstMeshlet = 0;
+        uint32  NumMeshlets = 0;
 
         friend FArchive& operator << (FArchive& Ar, FGeometrySurface& Data)
         {
@@ -21,6 +62,29 @@ namespace Lumina
             Ar << Data.IndexCount;
             Ar << Data.StartIndex;
             Ar << Data.MaterialIndex;
+            
+            if (Ar.GetVersion() >= ELuminaEngineVersion::MESH_MESHLETS)
+            {
+                Ar << Data.FirstMeshlet;
+                Ar << Data.NumMeshlets;
+            }
+
+            return Ar;
+        }
+    };
+
+    /** A simplified copy of the mesh surfaces, its index ranges follow the full detail ones in the shared index buffer. */
+    struct FMeshLOD final
+    {
+        TVector<FGeometrySurface>   GeometrySurfaces;
+
+        /** Object space distance the simplified surface may deviate from the full detail one. */
+        float                       Error = 0.0f;
+
+        friend FArchive& operator << (FArchive& Ar, FMeshLOD& Data)
+        {
+            Ar << Data.GeometrySurfaces;
+            Ar << Data.Error;
 
             return Ar;
         }
@@ -42,10 +106,16 @@ namespace Lumina
         TVector<uint32>             Indices;
         TVector<uint32>             ShadowIndices;
         TVector<FGeometrySurface>   GeometrySurfaces;
+        TVector<FMeshLOD>           LODs;
+        TVector<FMeshlet>           Meshlets;
         FMeshBuffers                MeshBuffers;
         bool                        bSkinnedMesh = false;
         FRHIInputLayoutRef          VertexLayout;
         
+        /** Serialized Jolt shapes cooked from the full detail level, empty for skinned meshes and older packages. */
+        TVector<uint8>              CookedTriangleMesh;
+        TVector<uint8>              CookedConvexHull;
+        
         FORCEINLINE size_t GetNumSurfaces() const { return GeometrySurfaces.size(); }
         
         FORCEINLINE bool IsSurfaceIndexValid(size_t Slot) const
@@ -58,6 +128,29 @@ namespace Lumina
             return GeometrySurfaces[Slot];
         }
         
+        /** Level zero is the full detail mesh, LODs holds the simplified levels after it. */
+        FORCEINLINE uint32 GetNumLODs() const { return (uint32)LODs.size() + 1; }
+        
+        FORCEINLINE const TVector<FGeometrySurface>& GetLODSurfaces(uint32 LOD) const
+        {
+            return LOD == 0 ? GeometrySurfaces : LODs[LOD - 1].GeometrySurfaces;
+        }
+        
+        FORCEINLINE float GetLODError(uint32 LOD) const
+        {
+            return LOD == 0 ? 0.0f : LODs[LOD - 1].Error;
+        }
+        
+        FORCEINLINE size_t GetLODNumIndices(uint32 LOD) const
+        {
+            size_t NumIndices = 0;
+            for (const FGeometrySurface& Surface : GetLODSurfaces(LOD))
+            {
+                NumIndices += Surface.IndexCount;
+            }
+            return NumIndices;
+        }
+        
         template<typename T>
         NODISCARD TVector<T>& GetVertexDataAs() { return eastl::get<TVector<T>>(Vertices); }
         
@@ -229,6 +322,22 @@ namespace Lumina
             Ar << Data.Indices;
             Ar << Data.ShadowIndices;
             Ar << Data.GeometrySurfaces;
+            
+            if (Ar.GetVersion() >= ELuminaEngineVersion::MESH_LOD_CHAIN)
+            {
+                Ar << Data.LODs;
+            }
+            
+            if (Ar.GetVersion() >= ELuminaEngineVersion::MESH_MESHLETS)
+            {
+                Ar << Data.Meshlets;
+            }
+            
+            if (Ar.GetVersion() >= ELuminaEngineVersion::MESH_COOKED_COLLISION)
+            {
+                Ar << Data.CookedTriangleMesh;
+                Ar << Data.CookedConvexHull;
+            }
 
             return Ar;
         }
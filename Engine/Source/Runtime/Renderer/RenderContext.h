@@ -5,6 +5,7 @@
 #include "RHIFwd.h"
 #include "Types/BitFlags.h"
 #include "Core/UpdateContext.h"
+#include "TaskSystem/TaskTypes.h"
 #include "RenderGraph/RenderGraph.h"
 
 
@@ -114,6 +115,9 @@ namespace Lumina
         NODISCARD virtual FRHIComputePipelineRef CreateComputePipeline(const FComputePipelineDesc& Desc) = 0;
         NODISCARD virtual FRHIGraphicsPipelineRef CreateGraphicsPipeline(const FGraphicsPipelineDesc& Desc, const FRenderPassDesc& RenderPassDesc) = 0;
 
+        /** Creates the pipelines on worker tasks so they are already cached on first use, e.g. while a world loads. */
+        virtual FTaskHandle PrecompileGraphicsPipelines(TVector<FGraphicsPipelineRequest>&& Requests) = 0;
+
         
         NODISCARD virtual RHI::ICrashTracker& GetCrashTracker() const = 0;
         
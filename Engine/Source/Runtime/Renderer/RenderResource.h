@@ -577,6 +577,7 @@ namespace Lumina
 		NODISCARD RUNTIME_API FTextureSlice Resolve(const FRHIImageDesc& desc) const;
 
 		constexpr FTextureSlice& SetOrigin(uint32 vx = 0, uint32 vy = 0, uint32 vz = 0) { X = vx; Y = vy; Z = vz; return *this; }
+		constexpr FTextureSlice& SetSize(uint32 vx = uint32(-1), uint32 vy = uint32(-1), uint32 vz = uint32(-1)) { Width = vx; Height = vy; Depth = vz; return *this; }
 		constexpr FTextureSlice& SetMipLevel(uint32 level) { MipLevel = level; return *this; }
 		constexpr FTextureSlice& SetArraySlice(uint32 slice) { ArraySlice = slice; return *this; }
 	};
@@ -682,12 +683,14 @@ namespace Lumina
 		TFixedVector<FAttachment, 2>	ColorAttachments;
 		FAttachment						DepthAttachment;
 		glm::uvec2						RenderArea;
+		glm::uvec2						RenderOffset = glm::uvec2(0);
 		uint32							ViewMask = 0;
 		uint16							SampleCount = 1;
 
 		FORCEINLINE FRenderPassDesc& SetSampleCount(uint16 Count) { SampleCount = Count; return *this; }
 		FORCEINLINE FRenderPassDesc& SetViewMask(uint32 Mask) { ViewMask = Mask; return *this; }
 		FORCEINLINE FRenderPassDesc& SetRenderArea(const glm::uvec2& Area) { RenderArea = Area; return *this; }
+		FORCEINLINE FRenderPassDesc& SetRenderArea(const glm::uvec2& Offset, const glm::uvec2& Area) { RenderOffset = Offset; RenderArea = Area; return *this; }
 		FORCEINLINE FRenderPassDesc& AddColorAttachment(const FAttachment& a) { ColorAttachments.push_back(a); return *this; }
 		FORCEINLINE FRenderPassDesc& AddColorAttachment(FRHIImage* texture) { ColorAttachments.push_back(FAttachment().SetImage(texture)); return *this; }
 		FORCEINLINE FRenderPassDesc& AddColorAttachment(FRHIImage* texture, FTextureSubresourceSet subresources) { ColorAttachments.push_back(FAttachment().SetImage(texture).SetSubresources(subresources)); return *this; }
@@ -732,7 +735,7 @@ namespace Lumina
 			{
 				return false;
 			}
-			if (RenderArea != Other.RenderArea)
+			if (RenderArea != Other.RenderArea || RenderOffset != Other.RenderOffset)
 			{
 				return false;
 			}
@@ -1657,6 +1660,13 @@ namespace Lumina
         FORCEINLINE FGraphicsPipelineDesc& AddBindingLayout(FRHIBindingLayout* layout) { BindingLayouts.push_back(layout); return *this; }
     };
 
+	/** A pipeline to create ahead of its first use. Attachments should carry explicit formats, images may not outlive the request. */
+	struct FGraphicsPipelineRequest
+	{
+		FGraphicsPipelineDesc	Desc;
+		FRenderPassDesc			RenderPass;
+	};
+
 	struct RUNTIME_API FGraphicsState
 	{
 		FRHIGraphicsPipeline* Pipeline = nullptr;
@@ -1813,6 +1823,7 @@ namespace eastl
 			Hash::HashCombine(Hash, Item.ViewMask);
 			Hash::HashCombine(Hash, Item.SampleCount);
 			Hash::HashCombine(Hash, Item.RenderArea);
+			Hash::HashCombine(Hash, Item.RenderOffset);
 			for (const FRenderPassDesc::FAttachment& Attachment : Item.ColorAttachments)
 			{
 				Hash::HashCombine(Hash, Attachment);
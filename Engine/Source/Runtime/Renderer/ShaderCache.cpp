@@ -0,0 +1,161 @@
+#include "pch.h"
+#include "ShaderCache.h"
+
+#include "RenderResource.h"
+#include "Core/Math/Hash/Hash.h"
+#include "Core/Serialization/MemoryArchiver.h"
+#include "Paths/Paths.h"
+#include "Platform/Filesystem/FileHelper.h"
+
+namespace Lumina
+{
+    // Outside the anonymous namespace so FArchive's TVector serializer finds it through ADL.
+    static FArchive& operator<<(FArchive& Ar, FShaderBinding& Binding)
+    {
+        Ar << Binding.Name;
+        Ar << Binding.Set;
+        Ar << Binding.Binding;
+        Ar << Binding.Size;
+        Ar << Binding.Type;
+        return Ar;
+    }
+
+    namespace
+    {
+        constexpr uint32 ShaderCacheMagic   = 0x5650534C; // "LSPV"
+
+        /** Bump whenever the entry layout, the compiler, or its fixed options change. */
+        constexpr uint32 ShaderCacheVersion = 1;
+
+        /** The fixed options FSpirVShaderCompiler always compiles with. */
+        constexpr const char* CompilerFingerprint = "shaderc|vulkan_1_3|optimize_performance|debug_info";
+
+        struct FShaderCacheEntryHeader
+        {
+            uint32 Magic    = 0;
+            uint32 Version  = 0;
+            uint64 Key      = 0;
+            uint64 Size     = 0;
+            uint64 Checksum = 0;
+        };
+
+        void SerializeShader(FArchive& Ar, FShaderHeader& Shader)
+        {
+            Ar << Shader.DebugName;
+            Ar << Shader.Defines;
+            Ar << Shader.Binaries;
+            Ar << Shader.Hash;
+            Ar << Shader.Reflection.ShaderType;
+            Ar << Shader.Reflection.Bindings;
+        }
+    }
+
+    void FShaderCache::Initialize()
+    {
+        Initialize(Paths::GetEngineCacheDirectory() + "/Shaders");
+    }
+
+    void FShaderCache::Initialize(FStringView InCacheDirectory)
+    {
+        CacheDirectory.assign(InCacheDirectory.begin(), InCacheDirectory.end());
+        if (!Paths::Exists(CacheDirectory))
+        {
+            Paths::CreateDirectories(CacheDirectory);
+        }
+    }
+
+    uint64 FShaderCache::ComputeKey(FStringView PreprocessedSource, ERHIShaderType Stage, FStringView EntryPoint, bool bReflectFull)
+    {
+        size_t Key = Hash::GetHash64(PreprocessedSource.data(), PreprocessedSource.size());
+        Hash::HashCombine(Key, Hash::GetHash64(CompilerFingerprint));
+        Hash::HashCombine(Key, static_cast<uint8>(Stage));
+        Hash::HashCombine(Key, Hash::GetHash64(EntryPoint.data(), EntryPoint.size()));
+        Hash::HashCombine(Key, bReflectFull);
+        return Key;
+    }
+
+    bool FShaderCache::Load(uint64 Key, FShaderHeader& OutShader) const
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const FString EntryPath = GetEntryPath(Key);
+        if (!Paths::Exists(EntryPath))
+        {
+            NumMisses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        TVector<uint8> Bytes;
+        if (!FileHelper::LoadFileToArray(Bytes, EntryPath))
+        {
+            NumMisses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        FShaderCacheEntryHeader Header;
+        bool bValid = Bytes.size() >= sizeof(FShaderCacheEntryHeader);
+        if (bValid)
+        {
+            Memory::Memcpy(&Header, Bytes.data(), sizeof(FShaderCacheEntryHeader));
+
+            const uint8* Payload = Bytes.data() + sizeof(FShaderCacheEntryHeader);
+            bValid = Header.Magic == ShaderCacheMagic
+                && Header.Version == ShaderCacheVersion
+                && Header.Key == Key
+                && Header.Size == Bytes.size() - sizeof(FShaderCacheEntryHeader)
+                && Header.Checksum == Hash::GetHash64(Payload, Header.Size);
+        }
+
+        if (bValid)
+        {
+            FMemoryReader Reader(Bytes);
+            Reader.Seek(sizeof(FShaderCacheEntryHeader));
+            SerializeShader(Reader, OutShader);
+            bValid = !Reader.HasError() && !OutShader.Binaries.empty();
+        }
+
+        if (!bValid)
+        {
+            LOG_WARN("Discarding corrupt shader cache entry: {}", EntryPath);
+            std::error_code EC;
+            std::filesystem::remove(EntryPath.c_str(), EC);
+            OutShader = {};
+            NumMisses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        NumHits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void FShaderCache::Store(uint64 Key, const FShaderHeader& Shader) const
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        TVector<uint8> Bytes(sizeof(FShaderCacheEntryHeader), 0);
+
+        FShaderHeader Copy = Shader;
+        FMemoryWriter Writer(Bytes, sizeof(FShaderCacheEntryHeader));
+        SerializeShader(Writer, Copy);
+
+        FShaderCacheEntryHeader Header;
+        Header.Magic    = ShaderCacheMagic;
+        Header.Version  = ShaderCacheVersion;
+        Header.Key      = Key;
+        Header.Size     = Bytes.size() - sizeof(FShaderCacheEntryHeader);
+        Header.Checksum = Hash::GetHash64(Bytes.data() + sizeof(FShaderCacheEntryHeader), Header.Size);
+        Memory::Memcpy(Bytes.data(), &Header, sizeof(FShaderCacheEntryHeader));
+
+        if (!FileHelper::SaveArrayToFile(Bytes, GetEntryPath(Key)))
+        {
+            LOG_WARN("Failed to write shader cache entry for {}", Shader.DebugName);
+        }
+    }
+
+    FString FShaderCache::GetEntryPath(uint64 Key) const
+    {
+        FString EntryPath = CacheDirectory;
+        EntryPath.append_sprintf("/%016llx.spvc", (unsigned long long)Key);
+        return EntryPath;
+    }
+}
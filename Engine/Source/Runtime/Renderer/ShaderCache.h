@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Shader.h"
+#include "Containers/String.h"
+#include "Core/Threading/Atomic.h"
+#include "Platform/GenericPlatform.h"
+
+namespace Lumina
+{
+    /**
+     * Content-addressed on-disk cache of compiled SPIR-V and its reflection data.
+     * Entries are keyed by the preprocessed source, which already folds in the include closure and macro set,
+     * combined with the stage, entry point and compiler options. A stale or corrupt entry is simply a miss.
+     */
+    class FShaderCache
+    {
+    public:
+
+        void Initialize();
+        void Initialize(FStringView InCacheDirectory);
+
+        /** The same source compiled for another stage or entry point is different SPIR-V, so both are part of the key. */
+        static uint64 ComputeKey(FStringView PreprocessedSource, ERHIShaderType Stage, FStringView EntryPoint, bool bReflectFull);
+
+        /** Thread safe, entries are immutable once written. */
+        bool Load(uint64 Key, FShaderHeader& OutShader) const;
+        void Store(uint64 Key, const FShaderHeader& Shader) const;
+
+        FString GetEntryPath(uint64 Key) const;
+
+        uint32 GetNumHits() const { return NumHits.load(std::memory_order_relaxed); }
+        uint32 GetNumMisses() const { return NumMisses.load(std::memory_order_relaxed); }
+
+    private:
+
+        FString CacheDirectory;
+        mutable TAtomic<uint32> NumHits = 0;
+        mutable TAtomic<uint32> NumMisses = 0;
+    };
+}
@@ -2,6 +2,7 @@
 #include "ShaderCompiler.h"
 
 #include "RenderResource.h"
+#include "Core/Console/ConsoleVariable.h"
 #include "Core/Serialization/MemoryArchiver.h"
 #include "Core/Utils/Defer.h"
 #include "FileSystem/FileSystem.h"
@@ -14,6 +15,36 @@
 
 namespace Lumina
 {
+    static TConsoleVar CVarShaderCache("r.ShaderCache", true, "Loads compiled shaders from the on-disk cache instead of running shaderc when the preprocessed source is unchanged.");
+    
+    namespace
+    {
+        constexpr const char* ShaderEntryPoint = "main";
+        
+        /** The stage a shader file is compiled as, taken from its extension. */
+        ERHIShaderType GetShaderStage(FStringView Path)
+        {
+            const FStringView Extension = VFS::Extension(Path);
+            if (Extension == ".vert") { return ERHIShaderType::Vertex; }
+            if (Extension == ".frag") { return ERHIShaderType::Fragment; }
+            if (Extension == ".comp") { return ERHIShaderType::Compute; }
+            if (Extension == ".geom") { return ERHIShaderType::Geometry; }
+            return ERHIShaderType::None;
+        }
+        
+        /** A #pragma shader_stage in the source still takes precedence over these defaults. */
+        shaderc_shader_kind GetShaderKind(ERHIShaderType Stage)
+        {
+            switch (Stage)
+            {
+                case ERHIShaderType::Vertex:    return shaderc_glsl_default_vertex_shader;
+                case ERHIShaderType::Fragment:  return shaderc_glsl_default_fragment_shader;
+                case ERHIShaderType::Compute:   return shaderc_glsl_default_compute_shader;
+                case ERHIShaderType::Geometry:  return shaderc_glsl_default_geometry_shader;
+                default:                        return shaderc_glsl_infer_from_source;
+            }
+        }
+    }
     
     class FShaderCIncluder : public shaderc::CompileOptions::IncluderInterface
     {
@@ -214,6 +245,7 @@ namespace Lumina
                 const FString& Path = Paths[i];
                 FStringView Filename = VFS::FileName(Path);
                 const FShaderCompileOptions& Opt = Options[i];
+                const ERHIShaderType Stage = GetShaderStage(Path);
                 
                 for (const FString& Macro : Opt.MacroDefinitions)
                 {
@@ -234,7 +266,7 @@ namespace Lumina
                 shaderc::PreprocessedSourceCompilationResult Preprocessed;
                 {
                     LUMINA_PROFILE_SECTION("PreprocessGlsl");
-                    Preprocessed = Compiler.PreprocessGlsl(RawShaderString.c_str(), RawShaderString.size(), shaderc_glsl_infer_from_source, Path.c_str(), CompileOpts);
+                    Preprocessed = Compiler.PreprocessGlsl(RawShaderString.c_str(), RawShaderString.size(), GetShaderKind(Stage), Path.c_str(), CompileOpts);
                 }
     
                 if (Preprocessed.GetCompilationStatus() != shaderc_compilation_status_success)
@@ -245,10 +277,25 @@ namespace Lumina
     
                 FString PreprocessedShader(Preprocessed.begin(), Preprocessed.end());
 
+                const uint64 CacheKey = FShaderCache::ComputeKey(PreprocessedShader, Stage, ShaderEntryPoint, Opt.bGenerateReflectionData);
+                if (CVarShaderCache.GetValue())
+                {
+                    FShaderHeader CachedShader;
+                    if (Cache.Load(CacheKey, CachedShader))
+                    {
+                        CachedShader.DebugName = Filename;
+                        CachedShader.Defines = Opt.MacroDefinitions;
+                        
+                        LOG_TRACE("Loaded cached shader {0} (Thread {1})", Filename, Thread);
+                        Callback(Move(CachedShader));
+                        continue;
+                    }
+                }
+
                 shaderc::SpvCompilationResult CompileResult;
                 {
                     LUMINA_PROFILE_SECTION("CompileGlslToSpv");
-                    CompileResult = Compiler.CompileGlslToSpv(PreprocessedShader.c_str(), PreprocessedShader.size(), shaderc_glsl_infer_from_source, Path.c_str(), CompileOpts);
+                    CompileResult = Compiler.CompileGlslToSpv(PreprocessedShader.c_str(), PreprocessedShader.size(), GetShaderKind(Stage), Path.c_str(), ShaderEntryPoint, CompileOpts);
                 }
     
                 if (CompileResult.GetCompilationStatus() != shaderc_compilation_status_success)
@@ -273,6 +320,11 @@ namespace Lumina
 
                 ReflectSpirv(Shader.Binaries, Shader.Reflection, Options[i].bGenerateReflectionData);
 
+                if (CVarShaderCache.GetValue())
+                {
+                    Cache.Store(CacheKey, Shader);
+                }
+
                 auto CompileEnd = std::chrono::high_resolution_clock::now();
                 std::chrono::duration<double, std::milli> DurationMs = CompileEnd - CompileStart;
                 
@@ -293,7 +345,7 @@ namespace Lumina
 
     void FSpirVShaderCompiler::Initialize()
     {
-        
+        Cache.Initialize();
     }
 
     void FSpirVShaderCompiler::Shutdown()
@@ -328,6 +380,9 @@ namespace Lumina
             
             FString VertexPath = Paths::GetEngineResourceDirectory() + "/Shaders/GeometryPass.vert";
             
+            // Raw shaders are generated material fragment shaders.
+            constexpr ERHIShaderType Stage = ERHIShaderType::Fragment;
+            
             TVector<uint32> Binaries;
             for (const FString& Macro : CompileOptions.MacroDefinitions)
             {
@@ -336,7 +391,7 @@ namespace Lumina
              
             auto Preprocessed = Compiler.PreprocessGlsl(ShaderString.c_str(),
                                                         ShaderString.size(),
-                                                        shaderc_glsl_infer_from_source,
+                                                        GetShaderKind(Stage),
                                                         VertexPath.c_str(), Options);
     
             if (Preprocessed.GetCompilationStatus() != shaderc_compilation_status_success)
@@ -346,11 +401,25 @@ namespace Lumina
             }
     
             FString PreprocessedShader(Preprocessed.begin(), Preprocessed.end());
+
+            const uint64 CacheKey = FShaderCache::ComputeKey(PreprocessedShader, Stage, ShaderEntryPoint, true);
+            if (CVarShaderCache.GetValue())
+            {
+                FShaderHeader CachedShader;
+                if (Cache.Load(CacheKey, CachedShader))
+                {
+                    CachedShader.DebugName = "RawShader";
+                    CachedShader.Defines = CompileOptions.MacroDefinitions;
+                    
+                    Callback(Move(CachedShader));
+                    return;
+                }
+            }
     
             auto CompileResult = Compiler.CompileGlslToSpv(PreprocessedShader.c_str(),
                                                            PreprocessedShader.size(),
-                                                           shaderc_glsl_infer_from_source,
-                                                           VertexPath.c_str(), Options);
+                                                           GetShaderKind(Stage),
+                                                           VertexPath.c_str(), ShaderEntryPoint, Options);
     
             if (CompileResult.GetCompilationStatus() != shaderc_compilation_status_success)
             {
@@ -375,6 +444,11 @@ namespace Lumina
 
             ReflectSpirv(Shader.Binaries, Shader.Reflection, true);
 
+            if (CVarShaderCache.GetValue())
+            {
+                Cache.Store(CacheKey, Shader);
+            }
+
             auto CompileEnd = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double, std::milli> DurationMs = CompileEnd - CompileStart;
                 
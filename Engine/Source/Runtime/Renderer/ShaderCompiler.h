@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Shader.h"
+#include "ShaderCache.h"
 #include "Containers/Array.h"
 #include "Containers/String.h"
 #include "Containers/Function.h"
@@ -62,5 +63,6 @@ namespace Lumina
         
         FMutex                      RequestMutex;
         TAtomic<uint32>             PendingTasks;
+        FShaderCache                Cache;
     };
 }
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Renderer/API/Vulkan/VulkanPipelineCache.h"
+#include "TaskSystem/TaskSystem.h"
+
+namespace Lumina::Automation
+{
+    LUMINA_AUTOMATION_TEST("Renderer.PipelineCache.KeyCollision")
+    {
+        const FRenderPassDesc RenderPass;
+
+        FGraphicsPipelineDesc BackCulled;
+        FGraphicsPipelineDesc FrontCulled;
+        FrontCulled.RenderState.RasterState.SetCullFront();
+
+        const FPipelineKey BackKey = FVulkanPipelineCache::MakeGraphicsKey(BackCulled, RenderPass);
+        FPipelineKey FrontKey = FVulkanPipelineCache::MakeGraphicsKey(FrontCulled, RenderPass);
+
+        TEST_CHECK(BackKey == FVulkanPipelineCache::MakeGraphicsKey(BackCulled, RenderPass));
+        TEST_CHECK(!(BackKey == FrontKey));
+
+        // Force the worst case, same hash and so the same shard and bucket, the bytes still have to tell them apart.
+        FrontKey.Hash = BackKey.Hash;
+        TEST_CHECK(!(BackKey == FrontKey));
+
+        TPipelineMap<uint32> Map;
+        TEST_CHECK(Map.FindOrCreate(BackKey, [] { return 1u; }) == 1u);
+        TEST_CHECK(Map.FindOrCreate(FrontKey, [] { return 2u; }) == 2u);
+        TEST_CHECK(Map.FindOrCreate(BackKey, [] { return 3u; }) == 1u);
+        TEST_CHECK(Map.Num() == 2);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.PipelineCache.ConcurrentLookups")
+    {
+        constexpr uint32 NumKeys = 64;
+        constexpr uint32 NumLookupsPerKey = 256;
+        constexpr uint32 NumLookups = NumKeys * NumLookupsPerKey;
+
+        TVector<FPipelineKey> Keys(NumKeys);
+        for (uint32 i = 0; i < NumKeys; ++i)
+        {
+            Keys[i].Add(i);
+            Keys[i].Finalize();
+        }
+
+        // Every call of the mock creator hands out a new value, so a lookup that saw a losing racer's pipeline shows up as a mismatch.
+        TAtomic<uint32> NumCreated = 0;
+        auto MockCreate = [&NumCreated]
+        {
+            return NumCreated.fetch_add(1, std::memory_order_relaxed) + 1;
+        };
+
+        TPipelineMap<uint32> Map;
+        TVector<uint32> Results(NumLookups, 0);
+        Task::ParallelFor(NumLookups, [&](uint32 Index)
+        {
+            Results[Index] = Map.FindOrCreate(Keys[Index % NumKeys], MockCreate);
+        });
+
+        TEST_CHECK(Map.Num() == NumKeys);
+        TEST_CHECK(NumCreated.load() >= NumKeys);
+
+        uint32 NumMismatched = 0;
+        for (uint32 i = 0; i < NumLookups; ++i)
+        {
+            const uint32 Stored = Map.FindOrCreate(Keys[i % NumKeys], [] { return 0u; });
+            if (Stored == 0u || Results[i] != Stored)
+            {
+                ++NumMismatched;
+            }
+        }
+        TEST_CHECK(NumMismatched == 0);
+        TEST_CHECK(Map.Num() == NumKeys);
+    }
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "FileSystem/FileSystem.h"
+#include "Platform/Filesystem/FileHelper.h"
+#include "Renderer/RenderResource.h"
+#include "Renderer/ShaderCompiler.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr const char* CacheTestShader = R"(
+            #version 460
+            #include "ShaderCacheTest.glsl"
+
+            layout(local_size_x = 1) in;
+            layout(set = 0, binding = 0) buffer FOutput { uint Values[]; };
+
+            void main()
+            {
+                Values[0] = CACHE_TEST_VALUE;
+            }
+        )";
+
+        /** Valid as a vertex and as a fragment shader, only the file extension picks the stage. */
+        constexpr const char* StagelessShader = R"(
+            #version 460
+
+            void main()
+            {
+            }
+        )";
+
+        /** A compiler whose cache lives in an empty scratch directory, so the first compile is always a miss. */
+        struct FShaderCacheTestCompiler
+        {
+            FShaderCacheTestCompiler()
+            {
+                VFS::RemoveAll("/Engine/Cache/Automation/ShaderCache");
+                VFS::CreateDir("/Engine/Cache/Automation/ShaderCache");
+                CacheDirectory = VFS::ResolvePath("/Engine/Cache/Automation/ShaderCache");
+                Compiler.Cache.Initialize(FStringView(CacheDirectory.data(), CacheDirectory.size()));
+
+                WriteInclude(1);
+                const FFixedString ShaderPath = WriteScratchFile("ShaderCacheTest.comp", CacheTestShader);
+                ResolvedShaderPath = VFS::ResolvePath(ShaderPath);
+            }
+
+            void WriteInclude(uint32 Value)
+            {
+                FString Include;
+                Include.sprintf("#define CACHE_TEST_VALUE %uu\n", Value);
+                WriteScratchFile("ShaderCacheTest.glsl", Include);
+            }
+
+            FShaderHeader Compile()
+            {
+                return Compile(ResolvedShaderPath);
+            }
+
+            FShaderHeader Compile(FStringView ResolvedPath)
+            {
+                FShaderHeader Result;
+                Compiler.CompileShaderPath(FString(ResolvedPath.data(), ResolvedPath.size()), FShaderCompileOptions(), [&Result](FShaderHeader Shader)
+                {
+                    Result = Move(Shader);
+                });
+                Compiler.Flush();
+                return Result;
+            }
+
+            /** Flips a payload byte in every entry, leaving the header intact so only the checksum catches it. */
+            uint32 CorruptEntries()
+            {
+                uint32 NumCorrupted = 0;
+                for (const auto& Entry : std::filesystem::directory_iterator(CacheDirectory.c_str()))
+                {
+                    const FString EntryPath(Entry.path().generic_string().c_str());
+                    TVector<uint8> Bytes;
+                    if (FileHelper::LoadFileToArray(Bytes, EntryPath) && !Bytes.empty())
+                    {
+                        Bytes.back() ^= 0xFF;
+                        FileHelper::SaveArrayToFile(Bytes, EntryPath);
+                        ++NumCorrupted;
+                    }
+                }
+                return NumCorrupted;
+            }
+
+            /** Declared first, the cache stays enabled until the compiler is gone. */
+            TScopedConsoleVariable<bool> ShaderCacheEnabled{ "r.ShaderCache", true };
+
+            FSpirVShaderCompiler Compiler;
+            FFixedString CacheDirectory;
+            FFixedString ResolvedShaderPath;
+        };
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShaderCache.Hit")
+    {
+        FShaderCacheTestCompiler Harness;
+
+        const FShaderHeader Compiled = Harness.Compile();
+        TEST_CHECK(!Compiled.Binaries.empty());
+        TEST_CHECK(Harness.Compiler.Cache.GetNumMisses() == 1);
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 0);
+
+        const FShaderHeader Cached = Harness.Compile();
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 1);
+        TEST_CHECK(Cached.Hash == Compiled.Hash);
+        TEST_CHECK(Cached.Binaries == Compiled.Binaries);
+        TEST_CHECK(Cached.Reflection.Bindings.size() == Compiled.Reflection.Bindings.size());
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShaderCache.IncludeInvalidation")
+    {
+        FShaderCacheTestCompiler Harness;
+
+        const FShaderHeader Original = Harness.Compile();
+        TEST_CHECK(!Original.Binaries.empty());
+
+        // Only the include changes, the key has to follow it through the preprocessed source.
+        Harness.WriteInclude(2);
+        const FShaderHeader Edited = Harness.Compile();
+        TEST_CHECK(!Edited.Binaries.empty());
+        TEST_CHECK(Harness.Compiler.Cache.GetNumMisses() == 2);
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 0);
+        TEST_CHECK(Edited.Hash != Original.Hash);
+
+        Harness.WriteInclude(1);
+        const FShaderHeader Restored = Harness.Compile();
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 1);
+        TEST_CHECK(Restored.Hash == Original.Hash);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShaderCache.KeySeparatesStageAndEntryPoint")
+    {
+        constexpr FStringView Source = "void main() {}";
+
+        const uint64 Key = FShaderCache::ComputeKey(Source, ERHIShaderType::Vertex, "main", true);
+        TEST_CHECK(Key == FShaderCache::ComputeKey(Source, ERHIShaderType::Vertex, "main", true));
+        TEST_CHECK(Key != FShaderCache::ComputeKey(Source, ERHIShaderType::Fragment, "main", true));
+        TEST_CHECK(Key != FShaderCache::ComputeKey(Source, ERHIShaderType::Vertex, "VSMain", true));
+        TEST_CHECK(Key != FShaderCache::ComputeKey(Source, ERHIShaderType::Vertex, "main", false));
+
+        // Byte identical sources for two stages used to share an entry, the second compile loaded the first stage's SPIR-V.
+        FShaderCacheTestCompiler Harness;
+        const FFixedString VertexPath = VFS::ResolvePath(WriteScratchFile("ShaderCacheStage.vert", StagelessShader));
+        const FFixedString FragmentPath = VFS::ResolvePath(WriteScratchFile("ShaderCacheStage.frag", StagelessShader));
+
+        const FShaderHeader Vertex = Harness.Compile(VertexPath);
+        const FShaderHeader Fragment = Harness.Compile(FragmentPath);
+        TEST_CHECK(!Vertex.Binaries.empty());
+        TEST_CHECK(!Fragment.Binaries.empty());
+        TEST_CHECK(Harness.Compiler.Cache.GetNumMisses() == 2);
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 0);
+        TEST_CHECK(Vertex.Reflection.ShaderType == ERHIShaderType::Vertex);
+        TEST_CHECK(Fragment.Reflection.ShaderType == ERHIShaderType::Fragment);
+        TEST_CHECK(Vertex.Hash != Fragment.Hash);
+
+        const FShaderHeader CachedFragment = Harness.Compile(FragmentPath);
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 1);
+        TEST_CHECK(CachedFragment.Reflection.ShaderType == ERHIShaderType::Fragment);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShaderCache.CorruptEntryRecompiles")
+    {
+        FShaderCacheTestCompiler Harness;
+
+        const FShaderHeader Original = Harness.Compile();
+        TEST_CHECK(!Original.Binaries.empty());
+        TEST_CHECK(Harness.CorruptEntries() == 1);
+
+        const FShaderHeader Recompiled = Harness.Compile();
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 0);
+        TEST_CHECK(Harness.Compiler.Cache.GetNumMisses() == 2);
+        TEST_CHECK(!Recompiled.Binaries.empty());
+        TEST_CHECK(Recompiled.Binaries == Original.Binaries);
+
+        // The recompile replaced the discarded entry.
+        const FShaderHeader Cached = Harness.Compile();
+        TEST_CHECK(Harness.Compiler.Cache.GetNumHits() == 1);
+        TEST_CHECK(Cached.Hash == Original.Hash);
+    }
+}
+
+#endif
@@ -15,6 +15,13 @@ namespace Lumina
             uint32 RowPitch;
             uint32 SlicePitch;
             TVector<uint8> Pixels;
+
+            /** Where the pixels live in the package bulk data region, INDEX_NONE when they are serialized inline. */
+            int64 BulkOffset = INDEX_NONE;
+            int64 BulkSize = 0;
+
+            /** Pixels of streamed mips are only held while they are being uploaded. */
+            uint64 GetSizeBytes() const { return Pixels.empty() ? static_cast<uint64>(BulkSize) : Pixels.size(); }
         };
         
         FRHIImageDesc           ImageDescription;
@@ -23,12 +30,12 @@ namespace Lumina
 
         uint64 CalcTotalSizeBytes() const
         {
-            uint64 BytesPerBlock = RHI::Format::BytesPerBlock(ImageDescription.Format);
             uint64 TotalSize = 0;
             
+            // Block compressed rows cover several texel rows, the stored bytes are the only size that holds for every format.
             for (const FMip& Mip : Mips)
             {
-                TotalSize += (uint64)Mip.RowPitch * Mip.Height * Mip.Depth;
+                TotalSize += Mip.GetSizeBytes();
             }
 
             return TotalSize;
@@ -51,7 +58,42 @@ namespace Lumina
                 Ar << Mip.Depth;
                 Ar << Mip.RowPitch;
                 Ar << Mip.SlicePitch;
-                Ar << Mip.Pixels;
+
+                if (Ar.GetVersion() < ELuminaEngineVersion::PACKAGE_BULK_DATA)
+                {
+                    Ar << Mip.Pixels;
+                    continue;
+                }
+
+                if (Ar.IsWriting())
+                {
+                    // The in memory location only moves once the package saver has placed the mip in its bulk region.
+                    int64 BulkOffset = Ar.WriteBulkData(Mip.Pixels.data(), static_cast<int64>(Mip.Pixels.size()));
+                    int64 BulkSize = static_cast<int64>(Mip.Pixels.size());
+                    Ar << BulkOffset;
+                    Ar << BulkSize;
+
+                    if (BulkOffset == INDEX_NONE)
+                    {
+                        Ar << Mip.Pixels;
+                    }
+                    else
+                    {
+                        Mip.BulkOffset = BulkOffset;
+                        Mip.BulkSize = BulkSize;
+                    }
+                }
+                else
+                {
+                    Ar << Mip.BulkOffset;
+                    Ar << Mip.BulkSize;
+
+                    Mip.Pixels.clear();
+                    if (Mip.BulkOffset == INDEX_NONE)
+                    {
+                        Ar << Mip.Pixels;
+                    }
+                }
             }
             
             return Ar;
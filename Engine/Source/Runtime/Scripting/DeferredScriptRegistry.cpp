@@ -13,13 +13,11 @@ namespace Lumina::Scripting
 
     void FDeferredScriptRegistry::ProcessRegistrations(const sol::state_view& State)
     {
+        // Kept after running, every Lua state created later (the parallel update workers) needs the same bindings.
         for (auto Fn : PendingRegistrations)
         {
             Fn(State);
         }
-
-        PendingRegistrations.clear();
-        PendingRegistrations.shrink_to_fit();
     }
 
     void FDeferredScriptRegistry::AddPending(void(* Fn)(sol::state_view))
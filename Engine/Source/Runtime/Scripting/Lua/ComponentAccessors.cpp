@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "ComponentAccessors.h"
+#include "Core/Console/ConsoleVariable.h"
+
+namespace Lumina::Scripting
+{
+    static TConsoleVar CVarTypedComponentAccess("Script.TypedComponentAccess", true, "Resolves reflected components passed to Get, Has and View through their typed accessors rather than entt::meta.");
+    
+    namespace
+    {
+        /** Address used as the registry key of the accessor table, unique per process and never dereferenced. */
+        const char AccessorTableKey = 0;
+
+        /** Pushes the accessor table of L, creating it on first use. */
+        void PushAccessorTable(lua_State* L)
+        {
+            if (lua_rawgetp(L, LUA_REGISTRYINDEX, &AccessorTableKey) == LUA_TTABLE)
+            {
+                return;
+            }
+
+            lua_pop(L, 1);
+            lua_newtable(L);
+            lua_pushvalue(L, -1);
+            lua_rawsetp(L, LUA_REGISTRYINDEX, &AccessorTableKey);
+        }
+    }
+
+    void AddComponentAccessor(sol::state_view State, const char* Name, const FComponentAccessor* Accessor)
+    {
+        lua_State* L = State.lua_state();
+        PushAccessorTable(L);
+
+        lua_pushinteger(L, static_cast<lua_Integer>(Accessor->TypeID));
+        lua_pushlightuserdata(L, const_cast<FComponentAccessor*>(Accessor));
+        lua_rawset(L, -3);
+
+        lua_pushstring(L, Name);
+        lua_pushlightuserdata(L, const_cast<FComponentAccessor*>(Accessor));
+        lua_rawset(L, -3);
+
+        // The usertype table is what scripts pass around, e.g. Context:Get(Entity, STransformComponent).
+        if (lua_getglobal(L, Name) == LUA_TTABLE)
+        {
+            lua_pushlightuserdata(L, const_cast<FComponentAccessor*>(Accessor));
+            lua_rawset(L, -3);
+        }
+        else
+        {
+            lua_pop(L, 1);
+        }
+
+        lua_pop(L, 1);
+    }
+
+    const FComponentAccessor* FindComponentAccessor(const sol::object& Type)
+    {
+        lua_State* L = Type.lua_state();
+        if (L == nullptr || !Type.valid() || !CVarTypedComponentAccess.GetValue())
+        {
+            return nullptr;
+        }
+
+        PushAccessorTable(L);
+        Type.push(L);
+        lua_rawget(L, -2);
+
+        const FComponentAccessor* Accessor = static_cast<const FComponentAccessor*>(lua_touserdata(L, -1));
+        lua_pop(L, 2);
+
+        return Accessor;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <sol/sol.hpp>
+#include "World/Entity/Registry/EntityRegistry.h"
+
+namespace Lumina::Scripting
+{
+    /**
+     * Typed entry points of one reflected component. Generated Lua registration stores one per component in a
+     * table owned by the state, so Get, Has and View resolve their argument with a single raw table lookup
+     * instead of reading "__type", hashing it and invoking through entt::meta on every call.
+     */
+    struct FComponentAccessor
+    {
+        entt::id_type   TypeID = 0;
+        
+        /** Key the registry stores the component pool under, View looks the pool up by it without going through entt::meta. */
+        entt::id_type   StorageID = 0;
+        bool            (*Has)(entt::registry&, entt::entity) = nullptr;
+        sol::reference  (*Get)(entt::registry&, entt::entity, sol::state_view) = nullptr;
+        sol::object     (*TryGet)(entt::registry&, entt::entity, sol::state_view) = nullptr;
+    };
+
+    /** Makes Accessor reachable from the usertype table registered under Name, from Name itself and from its type ID. */
+    RUNTIME_API void AddComponentAccessor(sol::state_view State, const char* Name, const FComponentAccessor* Accessor);
+
+    /**
+     * The accessor of the component Type names, or nullptr when Type is not a component usertype, name or ID of this state.
+     * Always nullptr while Script.TypedComponentAccess is off, which sends every call down the entt::meta path.
+     */
+    RUNTIME_API const FComponentAccessor* FindComponentAccessor(const sol::object& Type);
+}
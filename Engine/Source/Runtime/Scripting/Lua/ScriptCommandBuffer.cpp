@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "ScriptCommandBuffer.h"
+
+#include "World/Entity/Systems/SystemContext.h"
+
+namespace Lumina::Scripting
+{
+    void FScriptCommandBuffer::RegisterWithLua(sol::state& Lua)
+    {
+        Lua.new_usertype<FScriptCommandBuffer>("ScriptCommandBuffer",
+            sol::no_constructor,
+            "Destroy",              &FScriptCommandBuffer::Destroy,
+            "Emplace",              &FScriptCommandBuffer::Emplace,
+            "Remove",               &FScriptCommandBuffer::Remove,
+            "DispatchEvent",        &FScriptCommandBuffer::DispatchEvent,
+            "TranslateEntity",      &FScriptCommandBuffer::TranslateEntity,
+            "SetEntityLocation",    &FScriptCommandBuffer::SetEntityLocation,
+            "SetEntityRotation",    &FScriptCommandBuffer::SetEntityRotation,
+            "SetEntityScale",       &FScriptCommandBuffer::SetEntityScale,
+            "DirtyTransform",       &FScriptCommandBuffer::MarkEntityTransformDirty);
+    }
+
+    void FScriptCommandBuffer::Apply(const FSystemContext& Context)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        for (const TFunction<void(const FSystemContext&)>& Command : Commands)
+        {
+            Command(Context);
+        }
+        
+        Commands.clear();
+    }
+
+    void FScriptCommandBuffer::Destroy(entt::entity Entity)
+    {
+        Commands.emplace_back([Entity](const FSystemContext& Context)
+        {
+            if (Context.IsValidEntity(Entity))
+            {
+                Context.Destroy(Entity);
+            }
+        });
+    }
+
+    void FScriptCommandBuffer::Emplace(entt::entity Entity, const sol::table& Component)
+    {
+        Commands.emplace_back([Entity, Component](const FSystemContext& Context)
+        {
+            Context.Lua_Emplace(Entity, Component);
+        });
+    }
+
+    void FScriptCommandBuffer::Remove(entt::entity Entity, const sol::object& Component)
+    {
+        Commands.emplace_back([Entity, Component](const FSystemContext& Context)
+        {
+            Context.Lua_Remove(Entity, Component);
+        });
+    }
+
+    void FScriptCommandBuffer::DispatchEvent(const sol::object& Event)
+    {
+        Commands.emplace_back([Event](const FSystemContext& Context)
+        {
+            Context.Lua_DispatchEvent(Event);
+        });
+    }
+
+    void FScriptCommandBuffer::TranslateEntity(entt::entity Entity, const glm::vec3& Translation)
+    {
+        Commands.emplace_back([Entity, Translation](const FSystemContext& Context)
+        {
+            Context.TranslateEntity(Entity, Translation);
+        });
+    }
+
+    void FScriptCommandBuffer::SetEntityLocation(entt::entity Entity, const glm::vec3& Location)
+    {
+        Commands.emplace_back([Entity, Location](const FSystemContext& Context)
+        {
+            Context.SetEntityLocation(Entity, Location);
+        });
+    }
+
+    void FScriptCommandBuffer::SetEntityRotation(entt::entity Entity, const glm::quat& Rotation)
+    {
+        Commands.emplace_back([Entity, Rotation](const FSystemContext& Context)
+        {
+            Context.SetEntityRotation(Entity, Rotation);
+        });
+    }
+
+    void FScriptCommandBuffer::SetEntityScale(entt::entity Entity, const glm::vec3& Scale)
+    {
+        Commands.emplace_back([Entity, Scale](const FSystemContext& Context)
+        {
+            Context.SetEntityScale(Entity, Scale);
+        });
+    }
+
+    void FScriptCommandBuffer::MarkEntityTransformDirty(entt::entity Entity)
+    {
+        Commands.emplace_back([Entity](const FSystemContext& Context)
+        {
+            Context.MarkEntityTransformDirty(Entity);
+        });
+    }
+}
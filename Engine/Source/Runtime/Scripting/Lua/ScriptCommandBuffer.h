@@ -0,0 +1,47 @@
+#pragma once
+#include <glm/gtc/quaternion.hpp>
+#include <sol/sol.hpp>
+#include "Containers/Array.h"
+#include "Containers/Function.h"
+#include "World/Entity/Registry/EntityRegistry.h"
+
+namespace Lumina
+{
+    struct FSystemContext;
+}
+
+namespace Lumina::Scripting
+{
+    /**
+     * Registry writes recorded by a script updating off the main thread. Workers only read the registry and write the
+     * components of the entity they update, everything else is recorded here and applied on the main thread once
+     * every worker is done.
+     */
+    class RUNTIME_API FScriptCommandBuffer
+    {
+    public:
+        
+        static void RegisterWithLua(sol::state& Lua);
+        
+        /** Runs the commands in the order they were recorded, then empties the buffer. */
+        void Apply(const FSystemContext& Context);
+        
+        bool IsEmpty() const { return Commands.empty(); }
+        
+        void Destroy(entt::entity Entity);
+        void Emplace(entt::entity Entity, const sol::table& Component);
+        void Remove(entt::entity Entity, const sol::object& Component);
+        void DispatchEvent(const sol::object& Event);
+        
+        void TranslateEntity(entt::entity Entity, const glm::vec3& Translation);
+        void SetEntityLocation(entt::entity Entity, const glm::vec3& Location);
+        void SetEntityRotation(entt::entity Entity, const glm::quat& Rotation);
+        void SetEntityScale(entt::entity Entity, const glm::vec3& Scale);
+        void MarkEntityTransformDirty(entt::entity Entity);
+        
+    private:
+        
+        /** Lua values captured here belong to the worker state, they are only touched again once it is idle. */
+        TVector<TFunction<void(const FSystemContext&)>> Commands;
+    };
+}
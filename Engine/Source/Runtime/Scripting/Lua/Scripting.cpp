@@ -3,22 +3,116 @@
 
 #include <glm/gtx/string_cast.hpp>
 #include "Containers/Name.h"
+#include "Core/Console/ConsoleVariable.h"
 #include "Core/Math/Color.h"
+#include "Core/Math/Hash/Hash.h"
 #include "Events/KeyCodes.h"
 #include "FileSystem/FileSystem.h"
 #include "GLFW/glfw3.h"
 #include "Input/InputProcessor.h"
 #include "Memory/SmartPtr.h"
+#include "Memory/Memcpy.h"
 #include "Paths/Paths.h"
+#include "Platform/Filesystem/FileHelper.h"
 #include "Scripting/DeferredScriptRegistry.h"
 #include "Scripting/ScriptTypes.h"
 #include "Scripting/EnttGlue/EnttGlue.h"
+#include "TaskSystem/TaskSystem.h"
 #include "World/Entity/Systems/SystemContext.h"
 
 namespace Lumina::Scripting
 {
     static TUniquePtr<FScriptingContext> GScriptingContext;
     
+    static TConsoleVar CVarScriptGCBudgetMs("Script.GCBudgetMs", 1.0f, "Milliseconds of incremental Lua garbage collection allowed per frame.");
+    static TConsoleVar CVarScriptMemorySoftLimitMB("Script.MemorySoftLimitMB", 64, "Lua memory a single script file may hold before it is reported and a collection is forced, 0 disables the limit.");
+    
+    namespace
+    {
+        /** Sits in front of every Lua block and remembers which script it is counted against. */
+        struct alignas(8) FLuaAllocHeader
+        {
+            uint32 Owner;
+            uint32 Padding;
+        };
+        
+        /** Owner new Lua blocks are counted against, per thread as worker states allocate from task threads. */
+        thread_local uint32 GActiveMemoryOwner = 0;
+        
+        void* LuaAlloc(void* UserData, void* Ptr, size_t OldSize, size_t NewSize)
+        {
+            FScriptHeap* Heap = static_cast<FScriptHeap*>(UserData);
+            
+            // Lua passes the object type in OldSize for new blocks, it is only a size when Ptr is set.
+            FLuaAllocHeader* Header = Ptr ? static_cast<FLuaAllocHeader*>(Ptr) - 1 : nullptr;
+            const size_t PreviousSize = Ptr ? OldSize : 0;
+            const uint32 Owner = Header ? Header->Owner : GActiveMemoryOwner;
+            
+            if (NewSize == 0)
+            {
+                if (Header != nullptr)
+                {
+                    void* Block = Header;
+                    Memory::Free(Block);
+                }
+            }
+            else
+            {
+                Header = static_cast<FLuaAllocHeader*>(Header ? Memory::Realloc(Header, NewSize + sizeof(FLuaAllocHeader)) : Memory::Malloc(NewSize + sizeof(FLuaAllocHeader)));
+                if (Header == nullptr)
+                {
+                    return nullptr;
+                }
+                
+                Header->Owner = Owner;
+            }
+            
+            if (Owner >= Heap->OwnerBytes.size())
+            {
+                Heap->OwnerBytes.resize(Owner + 1, 0);
+            }
+            
+            Heap->OwnerBytes[Owner] = Heap->OwnerBytes[Owner] - PreviousSize + NewSize;
+            Heap->TotalBytes        = Heap->TotalBytes - PreviousSize + NewSize;
+            
+            return NewSize != 0 ? Header + 1 : nullptr;
+        }
+        
+        /** A frame driven cycle starts once the heap grew this much over what the last cycle left alive. */
+        constexpr double FrameGCStartRatio = 1.5;
+        
+        /** Pause of Lua's own pacing, far above the frame driven one so it only steps in when a frame allocates a lot. */
+        constexpr int BackstopGCPause = 400;
+        
+        /**
+         * Prepended to every script so the compiled chunk takes its environment as an argument. Each call declares
+         * a fresh _ENV local, so closures of one instance never see the environment of another sharing the chunk.
+         * Kept on the first line so error line numbers still match the file.
+         */
+        constexpr const char* ChunkPrologue = "local _ENV = ...; ";
+        
+        constexpr uint32 BytecodeCacheMagic     = 0x43415542; // "BUAC"
+        
+        /** Bump whenever the prologue or the entry layout change. */
+        constexpr uint32 BytecodeCacheVersion   = 1;
+
+        struct FBytecodeCacheHeader
+        {
+            uint32 Magic    = 0;
+            uint32 Version  = 0;
+            uint64 Key      = 0;
+            uint64 Size     = 0;
+            uint64 Checksum = 0;
+        };
+        
+        FString GetBytecodeCachePath(uint64 Key)
+        {
+            FString EntryPath = Paths::GetEngineCacheDirectory() + "/Scripts";
+            EntryPath.append_sprintf("/%016llx.luac", (unsigned long long)Key);
+            return EntryPath;
+        }
+    }
+    
     static int SolExceptionHandler(lua_State* L, sol::optional<const std::exception&> MaybeException, sol::string_view Desc) 
     {
         // L is the lua state, which you can wrap in a state_view if necessary
@@ -67,6 +161,71 @@ namespace Lumina::Scripting
         GScriptingContext.reset();
     }
 
+    void CopyPlainValues(const sol::table& From, sol::table& To)
+    {
+        for (const auto& [Key, Value] : From)
+        {
+            if (Key.get_type() != sol::type::string)
+            {
+                continue;
+            }
+            
+            const std::string Name = Key.as<std::string>();
+            switch (Value.get_type())
+            {
+                case sol::type::boolean:
+                {
+                    To[Name] = Value.as<bool>();
+                }
+                break;
+                case sol::type::number:
+                {
+                    Value.push();
+                    const bool bInteger = lua_isinteger(Value.lua_state(), -1);
+                    lua_pop(Value.lua_state(), 1);
+                    
+                    if (bInteger)
+                    {
+                        To[Name] = Value.as<lua_Integer>();
+                    }
+                    else
+                    {
+                        To[Name] = Value.as<lua_Number>();
+                    }
+                }
+                break;
+                case sol::type::string:
+                {
+                    To[Name] = Value.as<std::string>();
+                }
+                break;
+                default: break;
+            }
+        }
+    }
+
+    FScriptMemoryScope::FScriptMemoryScope(uint32 Owner)
+        : PreviousOwner(GActiveMemoryOwner)
+    {
+        GActiveMemoryOwner = Owner;
+    }
+
+    FScriptMemoryScope::~FScriptMemoryScope()
+    {
+        GActiveMemoryOwner = PreviousOwner;
+    }
+
+    FScriptWorkerState::FScriptWorkerState()
+        : State(&sol::default_at_panic, &LuaAlloc, &Heap)
+    {
+    }
+
+    FScriptingContext::FScriptingContext()
+        : MemoryStats(1)
+        , State(&sol::default_at_panic, &LuaAlloc, &MainHeap)
+    {
+    }
+
     FScriptingContext& FScriptingContext::Get()
     {
         return *GScriptingContext.get();
@@ -74,9 +233,17 @@ namespace Lumina::Scripting
 
     void FScriptingContext::Initialize()
     {
-        State.set_exception_handler(&SolExceptionHandler);
-        State.set_panic(sol::c_call<decltype(&SolPanicHandler), &SolPanicHandler>);
-        State.open_libraries(
+        InitializeState(State);
+
+        // Frame steps do the regular collection work, Lua's own pacing is left as a backstop.
+        lua_gc(State.lua_state(), LUA_GCINC, BackstopGCPause, 0, 0);
+    }
+
+    void FScriptingContext::InitializeState(sol::state& Lua)
+    {
+        Lua.set_exception_handler(&SolExceptionHandler);
+        Lua.set_panic(sol::c_call<decltype(&SolPanicHandler), &SolPanicHandler>);
+        Lua.open_libraries(
             sol::lib::base,
             sol::lib::package,
             sol::lib::coroutine,
@@ -85,13 +252,14 @@ namespace Lumina::Scripting
             sol::lib::table,
             sol::lib::io);
 
-        FDeferredScriptRegistry::Get().ProcessRegistrations(sol::state_view(State));
-        RegisterCoreTypes();
-        SetupInput();
+        FDeferredScriptRegistry::Get().ProcessRegistrations(sol::state_view(Lua));
+        RegisterCoreTypes(Lua);
+        SetupInput(Lua);
     }
 
     void FScriptingContext::Shutdown()
     {
+        WorkerStates.clear();
         State.collect_gc();
     }
 
@@ -101,12 +269,13 @@ namespace Lumina::Scripting
         
         DeferredActions.ProcessAllOf<FScriptDelete>([&](const FScriptDelete& Delete)
         {
+            ForgetCompiledScript(FName(Delete.Path));
             OnScriptDeleted.Broadcast(Delete.Path);
         });
         
         DeferredActions.ProcessAllOf<FScriptRename>([&](const FScriptRename& Reload)
         {
-            
+            ForgetCompiledScript(FName(Reload.OldName));
         });
         
         DeferredActions.ProcessAllOf<FScriptLoad>([&](const FScriptLoad& Load)
@@ -149,63 +318,29 @@ namespace Lumina::Scripting
 
     TSharedPtr<FLuaScript> FScriptingContext::LoadUniqueScript(FStringView Path)
     {
-        State.collect_gc();
-
-        FString ScriptData;
-        if (!VFS::ReadFile(ScriptData, Path))
-        {
-            LOG_ERROR("Lua - Failed to read script file: {}", Path);
-            return {};
-        }
-        
-        if (ScriptData.empty())
-        {
-            LOG_WARN("Lua - Script file is empty: {}", Path);
-            return {};
-        }
-
-        sol::environment Environment(State, sol::create, State.globals());
+        LUMINA_PROFILE_SCOPE();
         
-        sol::protected_function_result Result = State.safe_script(ScriptData.c_str(), Environment);
+        const uint32 MemoryOwner = FindOrAddMemoryOwner(Path);
+        FScriptMemoryScope MemoryScope(MemoryOwner);
         
-        if (!Result.valid())
+        const FCompiledScript* Compiled = FindOrCompileScript(Path);
+        if (Compiled == nullptr)
         {
-            sol::error Error = Result;
-            LOG_ERROR("Lua - Failed to execute script '{}': {}", Path, Error.what());
             return {};
         }
-
-        if (Result.get_type() == sol::type::none || Result.get_type() == sol::type::lua_nil)
-        {
-            LOG_ERROR("Lua - Script '{}' did not return a value", Path);
-            return {};
-        }
-
-        sol::object ReturnedObject = Result;
         
-        if (!ReturnedObject.is<sol::table>())
+        auto NewScript = MakeShared<FLuaScript>();
+        NewScript->MemoryOwner = MemoryOwner;
+        if (!InstantiateScript(*Compiled, Path, NewScript->Environment, NewScript->ScriptTable))
         {
-            LOG_ERROR("Lua - Script '{}' must return a table, got: {}", Path, sol::type_name(ReturnedObject.lua_state(), ReturnedObject.get_type()));
             return {};
         }
-
-        sol::table ScriptTable = ReturnedObject.as<sol::table>();
         
-        if (ScriptTable.empty())
-        {
-            LOG_WARN("Lua - Script '{}' returned an empty table", Path);
-        }
-        
-        auto NewScript = MakeShared<FLuaScript>();
-        NewScript->Environment  = std::move(Environment);
-        NewScript->ScriptTable  = std::move(ScriptTable);
         NewScript->Name         = VFS::FileName(Path, true);
         NewScript->Path         = Path;
         
         RegisteredScripts[Path].emplace_back(NewScript);
         
-        LOG_INFO("Lua - Successfully loaded script: {}", Path);
-        
         return NewScript;
     }
 
@@ -230,11 +365,163 @@ namespace Lumina::Scripting
     void FScriptingContext::RunGC()
     {
         State.collect_garbage();
+        
+        bGCCycleInProgress  = false;
+        bForceGCCycle       = false;
+        BytesAfterLastCycle = MainHeap.TotalBytes;
     }
 
-    void FScriptingContext::RegisterCoreTypes()
+    void FScriptingContext::RefreshMemoryStats()
     {
-        State.set_function("print", [&](sol::this_state s, const sol::variadic_args& args)
+        for (size_t i = 0; i < MemoryStats.size(); ++i)
+        {
+            size_t Bytes = i < MainHeap.OwnerBytes.size() ? MainHeap.OwnerBytes[i] : 0;
+            for (const TUniquePtr<FScriptWorkerState>& Worker : WorkerStates)
+            {
+                Bytes += i < Worker->Heap.OwnerBytes.size() ? Worker->Heap.OwnerBytes[i] : 0;
+            }
+            
+            FScriptMemoryStats& Stats = MemoryStats[i];
+            Stats.Bytes     = Bytes;
+            Stats.PeakBytes = eastl::max(Stats.PeakBytes, Bytes);
+        }
+    }
+
+    void FScriptingContext::StepGC()
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        // Runs between frames, no worker state is in use while their heaps are read.
+        RefreshMemoryStats();
+        
+        const size_t SoftLimit = static_cast<size_t>(eastl::max(CVarScriptMemorySoftLimitMB.GetValue(), 0)) * 1024 * 1024;
+        for (size_t i = 1; i < MemoryStats.size(); ++i)
+        {
+            FScriptMemoryStats& Stats = MemoryStats[i];
+            const bool bOverSoftLimit = SoftLimit != 0 && Stats.Bytes > SoftLimit;
+            if (bOverSoftLimit && !Stats.bOverSoftLimit)
+            {
+                LOG_WARN("Lua - Script '{}' holds {} bytes, over the soft limit of {}", Stats.Path.c_str(), Stats.Bytes, SoftLimit);
+                bForceGCCycle = true;
+            }
+            
+            Stats.bOverSoftLimit = bOverSoftLimit;
+        }
+        
+        LastGCStepSeconds = 0.0;
+        LastGCNumSteps = 0;
+        if (!bGCCycleInProgress && !bForceGCCycle && static_cast<double>(MainHeap.TotalBytes) < static_cast<double>(BytesAfterLastCycle) * FrameGCStartRatio)
+        {
+            return;
+        }
+        
+        // Basic steps are small, so the budget is overshot by at most one of them or by the atomic phase of a cycle.
+        const double Budget = eastl::max(CVarScriptGCBudgetMs.GetValue(), 0.0f) / 1000.0;
+        const double StartTime = glfwGetTime();
+        bGCCycleInProgress = true;
+        
+        do
+        {
+            ++LastGCNumSteps;
+            if (lua_gc(State.lua_state(), LUA_GCSTEP, 0) != 0)
+            {
+                bGCCycleInProgress  = false;
+                bForceGCCycle       = false;
+                BytesAfterLastCycle = MainHeap.TotalBytes;
+                break;
+            }
+        }
+        while (glfwGetTime() - StartTime < Budget);
+        
+        LastGCStepSeconds = glfwGetTime() - StartTime;
+    }
+
+    uint32 FScriptingContext::GetNumWorkerStates()
+    {
+        if (WorkerStates.empty())
+        {
+            LUMINA_PROFILE_SCOPE();
+            
+            const uint32 NumStates = eastl::max(GTaskSystem->GetNumWorkers(), 1u);
+            for (uint32 i = 0; i < NumStates; ++i)
+            {
+                TUniquePtr<FScriptWorkerState>& Worker = WorkerStates.emplace_back(MakeUnique<FScriptWorkerState>());
+                InitializeState(Worker->State);
+            }
+            
+            LOG_INFO("Lua - Created {} worker states for parallel script updates", NumStates);
+        }
+        
+        return static_cast<uint32>(WorkerStates.size());
+    }
+
+    FScriptWorkerState& FScriptingContext::GetWorkerState(uint32 Index)
+    {
+        ASSERT(Index < GetNumWorkerStates());
+        return *WorkerStates[Index];
+    }
+
+    bool FScriptingContext::InstantiateWorkerScript(uint32 WorkerIndex, const FLuaScript& Script, sol::environment& OutEnvironment, sol::table& OutTable)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        FScriptWorkerState& Worker = GetWorkerState(WorkerIndex);
+        FScriptMemoryScope MemoryScope(Script.MemoryOwner);
+        
+        FName PathName(Script.Path);
+        auto It = Worker.Chunks.find(PathName);
+        if (It == Worker.Chunks.end())
+        {
+            const FCompiledScript* Compiled = FindOrCompileScript(Script.Path);
+            if (Compiled == nullptr)
+            {
+                return false;
+            }
+            
+            // Bytecode keeps the chunk name of the main state compile, so errors still point at the file.
+            sol::bytecode Bytecode = Compiled->Chunk.dump();
+            sol::load_result Loaded = Worker.State.load(Bytecode.as_string_view(), Script.Path.c_str(), sol::load_mode::binary);
+            if (!Loaded.valid())
+            {
+                sol::error Error = Loaded;
+                LOG_ERROR("Lua - Failed to load script '{}' into worker state {}: {}", Script.Path, WorkerIndex, Error.what());
+                return false;
+            }
+            
+            It = Worker.Chunks.emplace(PathName, Loaded.get<sol::protected_function>()).first;
+        }
+        
+        sol::environment Environment(Worker.State, sol::create, Worker.State.globals());
+        sol::protected_function_result Result = It->second(Environment);
+        if (!Result.valid() || Result.get_type() != sol::type::table)
+        {
+            LOG_ERROR("Lua - Script '{}' did not return a table in worker state {}", Script.Path, WorkerIndex);
+            return false;
+        }
+        
+        sol::table ScriptTable = Result;
+        
+        CopyPlainValues(Script.ScriptTable, ScriptTable);
+        
+        OutEnvironment  = std::move(Environment);
+        OutTable        = std::move(ScriptTable);
+        return true;
+    }
+
+    uint32 FScriptingContext::FindOrAddMemoryOwner(FStringView Path)
+    {
+        auto [It, bInserted] = MemoryOwners.try_emplace(FName(Path), (uint32)MemoryStats.size());
+        if (bInserted)
+        {
+            MemoryStats.emplace_back().Path = It->first;
+        }
+        
+        return It->second;
+    }
+
+    void FScriptingContext::RegisterCoreTypes(sol::state& Lua)
+    {
+        Lua.set_function("print", [&](sol::this_state s, const sol::variadic_args& args)
         {
             sol::state_view lua(s);
             sol::protected_function LuaStringFunc = lua["tostring"];
@@ -275,19 +562,19 @@ namespace Lumina::Scripting
     
             LOG_INFO("[Lua] {}", Output);
         });        
-        State.create_named_table("Logger")
+        Lua.create_named_table("Logger")
             .set_function("Info",       &FScriptingContext::Lua_Info)
             .set_function("Warning",    &FScriptingContext::Lua_Warning)
             .set_function("Error",      &FScriptingContext::Lua_Error);
         
-        State.set_function("LoadObject", [](const sol::object& Name)
+        Lua.set_function("LoadObject", [](const sol::object& Name)
         {
             const char* Char = Name.as<const char*>();
             CObject* Object = LoadObject<CObject>(Char);
             return Object ? Object->AsLua(Name.lua_state()) : sol::nil;
         });
         
-        State.new_usertype<FString>("FString",
+        Lua.new_usertype<FString>("FString",
 	        sol::constructors<sol::types<>, sol::types<const char*>>(),
 		    "size", [](const FString& Self) { return Self.size(); },
 		    "trim", [](FString& Self) { return Self.trim(); },
@@ -301,7 +588,7 @@ namespace Lumina::Scripting
 		    )
 	    );
         
-        State.new_usertype<FName>("FName",
+        Lua.new_usertype<FName>("FName",
 	        sol::constructors<sol::types<>, sol::types<const char*>>(),
 		    "Length",   [](const FName& Self) { return Self.Length(); },
 		    "IsNone",   [](const FName& Self) { return Self.IsNone(); },
@@ -310,12 +597,12 @@ namespace Lumina::Scripting
 	        sol::meta_function::index, [](const FName &s, size_t i) { return s.At(i - 1); }
 	    );
         
-        auto EnttModule = State["entt"].get_or_create<sol::table>();
+        auto EnttModule = Lua["entt"].get_or_create<sol::table>();
         
         Glue::RegisterRegistry(EnttModule);
         Glue::RegisterRuntimeView(EnttModule);
         
-        State.new_usertype<FGuid>("FGuid",
+        Lua.new_usertype<FGuid>("FGuid",
             sol::call_constructor,
             sol::constructors<FGuid()>(),
             "IsValid", &FGuid::IsValid,
@@ -327,7 +614,7 @@ namespace Lumina::Scripting
             );
 
         // vec2
-        State.new_usertype<glm::vec2>("vec2",
+        Lua.new_usertype<glm::vec2>("vec2",
             sol::call_constructor,
             sol::constructors<glm::vec2(), glm::vec2(float), glm::vec2(float, float)>(),
             "x", &glm::vec2::x,
@@ -364,7 +651,7 @@ namespace Lumina::Scripting
         );
         
         // vec3
-        State.new_usertype<glm::vec3>("vec3",
+        Lua.new_usertype<glm::vec3>("vec3",
             sol::call_constructor,
             sol::constructors<glm::vec3(), glm::vec3(float), glm::vec3(float, float, float)>(),
             "x", &glm::vec3::x,
@@ -405,7 +692,7 @@ namespace Lumina::Scripting
         );
         
         // vec4
-        State.new_usertype<glm::vec4>("vec4",
+        Lua.new_usertype<glm::vec4>("vec4",
             sol::call_constructor,
             sol::constructors<glm::vec4(), glm::vec4(float), glm::vec4(float, float, float, float), glm::vec4(const glm::vec3&, float)>(),
             "x", &glm::vec4::x,
@@ -444,7 +731,7 @@ namespace Lumina::Scripting
         );
         
         // quat
-        State.new_usertype<glm::quat>("quat",
+        Lua.new_usertype<glm::quat>("quat",
             sol::call_constructor,
             sol::constructors<
                 glm::quat(), 
@@ -480,11 +767,11 @@ namespace Lumina::Scripting
             "FromEuler", [](const glm::vec3& euler){ return glm::quat(euler); }
         );
         
-        State.new_enum("ScriptType",
+        Lua.new_enum("ScriptType",
             "WorldSystem",       EScriptType::WorldSystem,
             "EntitySystem",      EScriptType::EntitySystem);
         
-        State.new_enum("UpdateStage",
+        Lua.new_enum("UpdateStage",
             "FrameStart",       EUpdateStage::FrameStart,
             "PrePhysics",       EUpdateStage::PrePhysics,
             "DuringPhysics",    EUpdateStage::DuringPhysics,
@@ -492,7 +779,7 @@ namespace Lumina::Scripting
             "FrameEnd",         EUpdateStage::FrameEnd,
             "Paused",           EUpdateStage::Paused);
         
-        sol::table GLMTable = State.create_named_table("glm");
+        sol::table GLMTable = Lua.create_named_table("glm");
         
         // Vector operations
         GLMTable.set_function("Normalize", [](glm::vec3 Vec) { return glm::normalize(Vec); });
@@ -539,19 +826,21 @@ namespace Lumina::Scripting
         GLMTable.set_function("QuatSlerp", [](glm::quat A, glm::quat B, float t) { return glm::slerp(A, B, t); });
 
 
-        sol::table ColorTable = State.create_named_table("Color");
+        sol::table ColorTable = Lua.create_named_table("Color");
         ColorTable.set_function("RandomColor4", []() ->glm::vec4 { return FColor::MakeRandom(1); });
         ColorTable.set_function("RandomColor3", []() ->glm::vec3 { return FColor::MakeRandom(1); });
         
         
-        FSystemContext::RegisterWithLua(State);
+        FSystemContext::RegisterWithLua(Lua);
+        FSystemContext::RegisterWorkerContextWithLua(Lua);
+        FScriptCommandBuffer::RegisterWithLua(Lua);
         
     }
 
-    void FScriptingContext::SetupInput()
+    void FScriptingContext::SetupInput(sol::state& Lua)
     {
         
-        sol::table InputTable = State.create_named_table("Input");
+        sol::table InputTable = Lua.create_named_table("Input");
         InputTable.set_function("GetMouseX",            [] () { return FInputProcessor::Get().GetMouseX(); });
         InputTable.set_function("GetMouseY",            [] () { return FInputProcessor::Get().GetMouseY(); });
         InputTable.set_function("GetMouseZ",            [] () { return FInputProcessor::Get().GetMouseZ(); });
@@ -567,13 +856,13 @@ namespace Lumina::Scripting
         InputTable.set_function("IsMouseButtonDown",    [] (EMouseKey Key) { return FInputProcessor::Get().IsMouseButtonDown(Key); });
         InputTable.set_function("IsMouseButtonUp",      [] (EMouseKey Key) { return FInputProcessor::Get().IsMouseButtonUp(Key); });
         
-        State.new_enum("EMouseMode",
+        Lua.new_enum("EMouseMode",
             "Hidden",   EMouseMode::Hidden,
             "Normal",   EMouseMode::Normal,
             "Captured", EMouseMode::Captured
         );
         
-        State.new_enum("EMouseKey",
+        Lua.new_enum("EMouseKey",
             "Button0",      EMouseKey::Button0,
             "Button1",      EMouseKey::Button1,
             "Button2",      EMouseKey::Button2,
@@ -590,7 +879,7 @@ namespace Lumina::Scripting
             "ButtonMiddle", EMouseKey::ButtonMiddle
         );
         
-        State.new_enum("EKey",
+        Lua.new_enum("EKey",
             "Space",        EKey::Space,
             "Apostrophe",   EKey::Apostrophe,
             "Comma",        EKey::Comma,
@@ -725,72 +1014,240 @@ namespace Lumina::Scripting
 
     void FScriptingContext::ReloadScripts(FStringView Path)
     {
+        LUMINA_PROFILE_SCOPE();
+        
+        // The content changed on disk, compile it again once for every live instance.
+        ForgetCompiledScript(FName(Path));
+        
+        FScriptMemoryScope MemoryScope(FindOrAddMemoryOwner(Path));
+        
+        const FCompiledScript* Compiled = FindOrCompileScript(Path);
+        if (Compiled == nullptr)
+        {
+            return;
+        }
+        
         TVector<TWeakPtr<FLuaScript>>& ScriptVector = RegisteredScripts[Path];
         for (const TWeakPtr<FLuaScript>& WeakScript : ScriptVector)
         {
             if (TSharedPtr<FLuaScript> Script = WeakScript.lock())
             {
-                State.collect_gc();
-
-                FString ScriptData;
-                if (!VFS::ReadFile(ScriptData, Path))
+                sol::environment Environment;
+                sol::table ScriptTable;
+                if (!InstantiateScript(*Compiled, Path, Environment, ScriptTable))
                 {
-                    LOG_ERROR("Lua - Failed to read script file: {}", Path);
                     return;
                 }
         
-                if (ScriptData.empty())
-                {
-                    LOG_WARN("Lua - Script file is empty: {}", Path);
-                    return;
-                }
+                Script->Environment  = std::move(Environment);
+                Script->ScriptTable  = std::move(ScriptTable);
+                Script->Name         = VFS::FileName(Path, true);
+                Script->Path         = Path;
+                Script->Version++;
+            }
+        }
+        
+        LOG_INFO("Reloaded Scripts: {}", Path);
+    }
 
-                sol::environment Environment(State, sol::create, State.globals());
+    void FScriptingContext::ForgetCompiledScript(FName Path)
+    {
+        CompiledScripts.erase(Path);
         
-                sol::protected_function_result Result = State.safe_script(ScriptData.c_str(), Environment);
+        for (TUniquePtr<FScriptWorkerState>& Worker : WorkerStates)
+        {
+            Worker->Chunks.erase(Path);
+        }
+    }
+
+    const FScriptingContext::FCompiledScript* FScriptingContext::FindOrCompileScript(FStringView Path)
+    {
+        LUMINA_PROFILE_SCOPE();
         
-                if (!Result.valid())
-                {
-                    sol::error Error = Result;
-                    LOG_ERROR("Lua - Failed to execute script '{}': {}", Path, Error.what());
-                    return;
-                }
+        FName PathName(Path);
+        auto It = CompiledScripts.find(PathName);
+        if (It != CompiledScripts.end())
+        {
+            return &It->second;
+        }
+        
+        FString ScriptData;
+        if (!VFS::ReadFile(ScriptData, Path))
+        {
+            LOG_ERROR("Lua - Failed to read script file: {}", Path);
+            return nullptr;
+        }
+        
+        if (ScriptData.empty())
+        {
+            LOG_WARN("Lua - Script file is empty: {}", Path);
+            return nullptr;
+        }
+        
+        // The path is part of the key as the chunk name baked into the bytecode reports it in errors.
+        size_t Key = Hash::GetHash64(ScriptData.data(), ScriptData.size());
+        Hash::HashCombine(Key, Hash::GetHash64(Path.data(), Path.size()));
+        Hash::HashCombine(Key, Hash::GetHash64(ChunkPrologue));
+        Hash::HashCombine(Key, LUA_VERSION_NUM);
+        
+        FCompiledScript Compiled;
+        Compiled.Chunk = LoadCachedBytecode(Key, Path);
+        
+        if (Compiled.Chunk.valid())
+        {
+            NumBytecodeLoads++;
+        }
+        else
+        {
+            FString Source = ChunkPrologue;
+            Source.append(ScriptData);
+            
+            FString ChunkName = "@";
+            ChunkName.append(Path.data(), Path.size());
+            
+            sol::load_result Loaded = State.load(sol::string_view(Source.data(), Source.size()), ChunkName.c_str(), sol::load_mode::text);
+            if (!Loaded.valid())
+            {
+                sol::error Error = Loaded;
+                LOG_ERROR("Lua - Failed to compile script '{}': {}", Path, Error.what());
+                return nullptr;
+            }
+            
+            Compiled.Chunk = Loaded.get<sol::protected_function>();
+            StoreCachedBytecode(Key, Compiled.Chunk);
+            NumSourceCompiles++;
+        }
+        
+        LOG_INFO("Lua - Successfully loaded script: {}", Path);
+        
+        return &CompiledScripts.emplace(PathName, Move(Compiled)).first->second;
+    }
 
-                if (Result.get_type() == sol::type::none || Result.get_type() == sol::type::lua_nil)
-                {
-                    LOG_ERROR("Lua - Script '{}' did not return a value", Path);
-                    return;
-                }
+    bool FScriptingContext::InstantiateScript(const FCompiledScript& Compiled, FStringView Path, sol::environment& OutEnvironment, sol::table& OutTable)
+    {
+        sol::environment Environment(State, sol::create, State.globals());
+        
+        sol::protected_function_result Result = Compiled.Chunk(Environment);
+        
+        if (!Result.valid())
+        {
+            sol::error Error = Result;
+            LOG_ERROR("Lua - Failed to execute script '{}': {}", Path, Error.what());
+            return false;
+        }
 
-                sol::object ReturnedObject = Result;
+        if (Result.get_type() == sol::type::none || Result.get_type() == sol::type::lua_nil)
+        {
+            LOG_ERROR("Lua - Script '{}' did not return a value", Path);
+            return false;
+        }
+
+        sol::object ReturnedObject = Result;
         
-                if (!ReturnedObject.is<sol::table>())
-                {
-                    LOG_ERROR("Lua - Script '{}' must return a table, got: {}", Path, sol::type_name(ReturnedObject.lua_state(), ReturnedObject.get_type()));
-                    return;
-                }
+        if (!ReturnedObject.is<sol::table>())
+        {
+            LOG_ERROR("Lua - Script '{}' must return a table, got: {}", Path, sol::type_name(ReturnedObject.lua_state(), ReturnedObject.get_type()));
+            return false;
+        }
 
-                sol::table ScriptTable = ReturnedObject.as<sol::table>();
+        sol::table ScriptTable = ReturnedObject.as<sol::table>();
         
-                if (ScriptTable.empty())
-                {
-                    LOG_WARN("Lua - Script '{}' returned an empty table", Path);
-                    return;
-                }
+        if (ScriptTable.empty())
+        {
+            LOG_WARN("Lua - Script '{}' returned an empty table", Path);
+        }
         
-                Script->Environment  = std::move(Environment);
-                Script->ScriptTable  = std::move(ScriptTable);
-                Script->Name         = VFS::FileName(Path, true);
-                Script->Path         = Path;
+        OutEnvironment  = std::move(Environment);
+        OutTable        = std::move(ScriptTable);
+        return true;
+    }
+
+    sol::protected_function FScriptingContext::LoadCachedBytecode(uint64 Key, FStringView Path)
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        const FString EntryPath = GetBytecodeCachePath(Key);
+        if (!Paths::Exists(EntryPath))
+        {
+            return {};
+        }
+        
+        TVector<uint8> Bytes;
+        if (!FileHelper::LoadFileToArray(Bytes, EntryPath))
+        {
+            return {};
+        }
+        
+        // Lua trusts the bytecode it is handed, so the payload is checksummed before it gets near the undumper.
+        FBytecodeCacheHeader Header;
+        bool bValid = Bytes.size() > sizeof(FBytecodeCacheHeader);
+        if (bValid)
+        {
+            Memory::Memcpy(&Header, Bytes.data(), sizeof(FBytecodeCacheHeader));
+            
+            const uint8* Payload = Bytes.data() + sizeof(FBytecodeCacheHeader);
+            bValid = Header.Magic == BytecodeCacheMagic
+                && Header.Version == BytecodeCacheVersion
+                && Header.Key == Key
+                && Header.Size == Bytes.size() - sizeof(FBytecodeCacheHeader)
+                && Header.Checksum == Hash::GetHash64(Payload, Header.Size);
+        }
+        
+        sol::protected_function Chunk;
+        if (bValid)
+        {
+            const char* Payload = reinterpret_cast<const char*>(Bytes.data() + sizeof(FBytecodeCacheHeader));
+            sol::load_result Loaded = State.load(sol::string_view(Payload, Header.Size), std::string(Path.data(), Path.size()), sol::load_mode::binary);
+            bValid = Loaded.valid();
+            if (bValid)
+            {
+                Chunk = Loaded.get<sol::protected_function>();
             }
         }
         
-        LOG_INFO("Reloaded Scripts: {}", Path);
+        if (!bValid)
+        {
+            LOG_WARN("Discarding corrupt script bytecode cache entry: {}", EntryPath);
+            std::error_code EC;
+            std::filesystem::remove(EntryPath.c_str(), EC);
+        }
+        
+        return Chunk;
+    }
+
+    void FScriptingContext::StoreCachedBytecode(uint64 Key, const sol::protected_function& Chunk) const
+    {
+        LUMINA_PROFILE_SCOPE();
+        
+        const FString CacheDirectory = Paths::GetEngineCacheDirectory() + "/Scripts";
+        if (!Paths::Exists(CacheDirectory))
+        {
+            Paths::CreateDirectories(CacheDirectory);
+        }
+        
+        sol::bytecode Bytecode = Chunk.dump();
+        const sol::string_view Payload = Bytecode.as_string_view();
+        
+        TVector<uint8> Bytes(sizeof(FBytecodeCacheHeader) + Payload.size());
+        Memory::Memcpy(Bytes.data() + sizeof(FBytecodeCacheHeader), Payload.data(), Payload.size());
+        
+        FBytecodeCacheHeader Header;
+        Header.Magic    = BytecodeCacheMagic;
+        Header.Version  = BytecodeCacheVersion;
+        Header.Key      = Key;
+        Header.Size     = Payload.size();
+        Header.Checksum = Hash::GetHash64(Payload.data(), Payload.size());
+        Memory::Memcpy(Bytes.data(), &Header, sizeof(FBytecodeCacheHeader));
+        
+        if (!FileHelper::SaveArrayToFile(Bytes, GetBytecodeCachePath(Key)))
+        {
+            LOG_WARN("Failed to write script bytecode cache entry {:016x}", Key);
+        }
     }
 
     void FScriptingContext::Lua_Info(const sol::variadic_args& Args)
     {
-        sol::protected_function ToString = State[sol::meta_function::to_string];
+        sol::protected_function ToString = sol::state_view(Args.lua_state())[sol::meta_function::to_string];
         FFixedString Output;
         for (size_t i = 0; i < Args.size(); ++i)
         {
@@ -828,7 +1285,7 @@ namespace Lumina::Scripting
     
     void FScriptingContext::Lua_Warning(const sol::variadic_args& Args)
     {
-        sol::protected_function ToString = State[sol::meta_function::to_string];
+        sol::protected_function ToString = sol::state_view(Args.lua_state())[sol::meta_function::to_string];
         FFixedString Output;
         for (size_t i = 0; i < Args.size(); ++i)
         {
@@ -866,7 +1323,7 @@ namespace Lumina::Scripting
 
     void FScriptingContext::Lua_Error(const sol::variadic_args& Args)
     {
-        sol::protected_function ToString = State[sol::meta_function::to_string];
+        sol::protected_function ToString = sol::state_view(Args.lua_state())[sol::meta_function::to_string];
         FFixedString Output;
         for (size_t i = 0; i < Args.size(); ++i)
         {
@@ -5,6 +5,7 @@
 #include "Core/Reflection/Type/LuminaTypes.h"
 #include "Memory/SmartPtr.h"
 #include "Scripting/ScriptTypes.h"
+#include "Scripting/Lua/ScriptCommandBuffer.h"
 #include "sol/sol.hpp"
 #include "Tools/Actions/DeferredActions.h"
 #include "World/Entity/Components/Component.h"
@@ -24,9 +25,43 @@ namespace Lumina::Scripting
     
     
     struct FLuaScriptMetadata;
+    
+    struct FScriptMemoryStats
+    {
+        /** The script file, none for the slot holding everything allocated outside a script. */
+        FName   Path;
+        size_t  Bytes = 0;
+        size_t  PeakBytes = 0;
+        bool    bOverSoftLimit = false;
+    };
+    
+    /** Bytes a single Lua state holds per memory owner, only touched by the thread currently running that state. */
+    struct FScriptHeap
+    {
+        TVector<size_t> OwnerBytes;
+        size_t          TotalBytes = 0;
+    };
+    
+    /** A Lua state parallel script updates run on, never used by two tasks at once. */
+    struct FScriptWorkerState
+    {
+        FScriptWorkerState();
+        
+        /** Declared ahead of the state, its allocator counts into it until the state is closed. */
+        FScriptHeap                                 Heap;
+        sol::state                                  State;
+        FScriptCommandBuffer                        Commands;
+        
+        /** Loaded from the bytecode the main state compiled, evicted alongside it. */
+        THashMap<FName, sol::protected_function>    Chunks;
+    };
+    
     void Initialize();
     void Shutdown();
     
+    /** Copies the boolean, number and string fields of From into To, the only values that can move between two Lua states. */
+    RUNTIME_API void CopyPlainValues(const sol::table& From, sol::table& To);
+    
     class FScriptingContext
     {
         struct FScriptLoad
@@ -59,6 +94,8 @@ namespace Lumina::Scripting
         
     public:
 
+        FScriptingContext();
+        
         RUNTIME_API static FScriptingContext& Get();
 
         RUNTIME_API sol::state_view GetState() { return sol::state_view(State); }
@@ -77,9 +114,34 @@ namespace Lumina::Scripting
         RUNTIME_API TVector<TSharedPtr<FLuaScript>> GetAllRegisteredScripts();
         RUNTIME_API void RunGC();
         
+        /** Advances the incremental collector for at most the frame budget, called once per frame. */
+        RUNTIME_API void StepGC();
+        
+        RUNTIME_API uint32 FindOrAddMemoryOwner(FStringView Path);
+        
+        /** Gathered from the main and worker heaps once per frame in StepGC, peaks are only sampled at that point. */
+        RUNTIME_API const TVector<FScriptMemoryStats>& GetMemoryStats() const { return MemoryStats; }
+        RUNTIME_API double GetLastGCStepTime() const { return LastGCStepSeconds; }
+        
+        /** Basic collector steps the last StepGC ran, at least one whenever a cycle was in progress. */
+        RUNTIME_API uint32 GetLastGCNumSteps() const { return LastGCNumSteps; }
         
-        void RegisterCoreTypes();
-        void SetupInput();
+        /** How often a script chunk was parsed from source or loaded from the bytecode cache, instances reuse it otherwise. */
+        RUNTIME_API uint32 GetNumSourceCompiles() const { return NumSourceCompiles; }
+        RUNTIME_API uint32 GetNumBytecodeLoads() const { return NumBytecodeLoads; }
+        
+        /** One state per task worker, created on first use on the main thread with the same bindings as the main state. */
+        RUNTIME_API uint32 GetNumWorkerStates();
+        RUNTIME_API FScriptWorkerState& GetWorkerState(uint32 Index);
+        
+        /** Recorded by scripts on the main state, applied by the script system after its update just like the worker buffers. */
+        RUNTIME_API FScriptCommandBuffer& GetCommands() { return Commands; }
+        
+        /** Instances the script of Script in a worker state, starting from the plain values of the main state instance. */
+        RUNTIME_API bool InstantiateWorkerScript(uint32 WorkerIndex, const FLuaScript& Script, sol::environment& OutEnvironment, sol::table& OutTable);
+        
+        void RegisterCoreTypes(sol::state& Lua);
+        void SetupInput(sol::state& Lua);
         
         
         FScriptTransactionDelegate OnScriptLoaded;
@@ -87,8 +149,25 @@ namespace Lumina::Scripting
 
     private:
         
+        struct FCompiledScript
+        {
+            /** The script body compiled once as a function taking its environment, shared by every instance. */
+            sol::protected_function Chunk;
+        };
+        
+        void InitializeState(sol::state& Lua);
+        void RefreshMemoryStats();
         void ReloadScripts(FStringView Path);
         
+        /** Drops the compiled chunk of Path from the main state and every worker state. */
+        void ForgetCompiledScript(FName Path);
+        
+        const FCompiledScript* FindOrCompileScript(FStringView Path);
+        bool InstantiateScript(const FCompiledScript& Compiled, FStringView Path, sol::environment& OutEnvironment, sol::table& OutTable);
+        
+        sol::protected_function LoadCachedBytecode(uint64 Key, FStringView Path);
+        void StoreCachedBytecode(uint64 Key, const sol::protected_function& Chunk) const;
+        
         void Lua_Info(const sol::variadic_args& Args);
         void Lua_Warning(const sol::variadic_args& Args);
         void Lua_Error(const sol::variadic_args& Args);
@@ -96,10 +175,30 @@ namespace Lumina::Scripting
     private:
         
         FSharedMutex SharedMutex;
+        
+        TVector<FScriptMemoryStats> MemoryStats;
+        THashMap<FName, uint32> MemoryOwners;
+        
+        /** Declared ahead of the state, its allocator counts into it from the moment it is created until it is closed. */
+        FScriptHeap MainHeap;
+        
+        size_t BytesAfterLastCycle = 0;
+        double LastGCStepSeconds = 0.0;
+        uint32 LastGCNumSteps = 0;
+        bool bGCCycleInProgress = false;
+        bool bForceGCCycle = false;
+        
+        uint32 NumSourceCompiles = 0;
+        uint32 NumBytecodeLoads = 0;
+        
         sol::state State;
         FDeferredActionRegistry DeferredActions;
         
         THashMap<FName, TVector<TWeakPtr<FLuaScript>>> RegisteredScripts;
+        THashMap<FName, FCompiledScript> CompiledScripts;
+        
+        TVector<TUniquePtr<FScriptWorkerState>> WorkerStates;
+        FScriptCommandBuffer Commands;
     };
     
 }
@@ -154,5 +154,27 @@ namespace Lumina::Scripting
         FString             Path;
         sol::environment    Environment;
         sol::table          ScriptTable;
+        
+        /** Bumped on every reload, so anything caching the environment or table knows to resolve them again. */
+        uint32              Version = 0;
+        
+        /** Slot this script's Lua allocations are counted against, shared by every instance of the same file. */
+        uint32              MemoryOwner = 0;
+    };
+    
+    /** Counts the Lua allocations made on this thread while it is alive against Owner, calls into a script should be wrapped in one. */
+    class RUNTIME_API FScriptMemoryScope
+    {
+    public:
+        
+        explicit FScriptMemoryScope(uint32 Owner);
+        ~FScriptMemoryScope();
+        
+        FScriptMemoryScope(const FScriptMemoryScope&) = delete;
+        FScriptMemoryScope& operator=(const FScriptMemoryScope&) = delete;
+        
+    private:
+        
+        uint32 PreviousOwner;
     };
 }
@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Scripting/Lua/Scripting.h"
+#include "World/Entity/Components/ScriptComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr const char* GetScript = R"(
+            return {
+                GetTransforms = function(self, Iterations)
+                    local Found = 0
+                    for i = 1, Iterations do
+                        if Context:Get(Entity, STransformComponent) ~= nil then
+                            Found = Found + 1
+                        end
+                    end
+                    return Found
+                end,
+
+                CountView = function(self)
+                    local Count = 0
+                    Context:View(STransformComponent, SScriptComponent):Each(function(ViewEntity)
+                        Count = Count + 1
+                    end)
+                    return Count
+                end
+            }
+        )";
+
+        template<typename... TArgs>
+        int64 CallScript(const SScriptComponent& ScriptComponent, const char* Function, TArgs&&... Args)
+        {
+            sol::protected_function Func = ScriptComponent.Script->ScriptTable[Function];
+            sol::protected_function_result Result = Func(ScriptComponent.Script->ScriptTable, Forward<TArgs>(Args)...);
+            return Result.valid() ? Result.get<int64>() : -1;
+        }
+    }
+
+    // 100k Context:Get calls from one script, through the typed accessors and through entt::meta as before them.
+    LUMINA_AUTOMATION_TEST("Benchmark.Script.Get100k")
+    {
+        constexpr int64 NumCalls = 100'000;
+
+        const FFixedString ScriptPath = WriteScratchFile("BenchmarkGet.lua", GetScript);
+
+        // Game worlds bind Entity and Context into the environment as the component is emplaced.
+        FAutomationWorld World;
+        const entt::entity Entity = World.SpawnScriptedEntities(ScriptPath).front();
+
+        const SScriptComponent& Scripted = World.GetRegistry().get<SScriptComponent>(Entity);
+        TEST_CHECK(Scripted.Script != nullptr);
+        if (!Scripted.Script)
+        {
+            return;
+        }
+
+        ForEachConsoleToggle("Script.TypedComponentAccess", [&](bool bTyped)
+        {
+            // Both paths have to agree before their timings mean anything.
+            TEST_CHECK(CallScript(Scripted, "CountView") == 1);
+            TEST_CHECK(CallScript(Scripted, "GetTransforms", 1'000) == 1'000);
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            const int64 Found = CallScript(Scripted, "GetTransforms", NumCalls);
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            TEST_CHECK(Found == NumCalls);
+
+            LOG_INFO("[{}] {} calls, {}: {:.3f} ms, {:.1f} ns per call", Test.GetName(), NumCalls, bTyped ? "typed accessor" : "entt::meta", Duration.count(), Duration.count() * 1'000'000.0 / NumCalls);
+        });
+    }
+}
+
+#endif
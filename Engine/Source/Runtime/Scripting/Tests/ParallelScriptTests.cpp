@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Scripting/Lua/Scripting.h"
+#include "World/Entity/Components/ScriptComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Keeps per instance state and writes its own transform through Commands, the way a thread safe script has to. */
+        constexpr const char* DeterminismScript = R"(
+            return {
+                ThreadSafe = true,
+                Ticks = 0,
+                Value = 1.0,
+                Update = function(self, DeltaTime)
+                    self.Ticks = self.Ticks + 1
+                    self.Value = (self.Value * 1.37 + self.Ticks * DeltaTime) % 97.0
+                    local Location = Context:GetTransform(Entity):GetLocation()
+                    Commands:SetEntityLocation(Entity, vec3(Location.x + self.Value, self.Ticks, 0.0))
+                end
+            }
+        )";
+
+        constexpr const char* WorkloadScript = R"(
+            return {
+                ThreadSafe = true,
+                Value = 0.0,
+                Update = function(self, DeltaTime)
+                    local Sum = self.Value
+                    for i = 1, 200 do
+                        Sum = (Sum + math.sin(i * DeltaTime)) * 0.5
+                    end
+                    self.Value = Sum
+                end
+            }
+        )";
+
+        struct FScriptResult
+        {
+            uint32      Entity;
+            int64       Ticks;
+            double      Value;
+            glm::vec3   Location;
+
+            bool operator == (const FScriptResult& Other) const
+            {
+                return Entity == Other.Entity && Ticks == Other.Ticks && Value == Other.Value && Location == Other.Location;
+            }
+        };
+
+        TVector<FScriptResult> RunDeterminismScript(FStringView ScriptPath, bool bParallel)
+        {
+            constexpr uint32 NumEntities = 1'000;
+
+            TScopedConsoleVariable<bool> ParallelUpdate("Script.ParallelUpdate", bParallel);
+
+            FAutomationWorld World;
+            World.SpawnScriptedEntities(ScriptPath, NumEntities);
+            World.Tick(1.0 / 60.0, 4);
+
+            // Stands in for a callback or the editor writing the main instance between updates, the worker instance has to see it.
+            World.GetRegistry().view<SScriptComponent>().each([](const SScriptComponent& ScriptComponent)
+            {
+                if (ScriptComponent.Script)
+                {
+                    ScriptComponent.Script->ScriptTable["Value"] = 5.0;
+                }
+            });
+            World.Tick(1.0 / 60.0, 4);
+
+            TVector<FScriptResult> Results;
+            World.GetRegistry().view<SScriptComponent, STransformComponent>().each([&](entt::entity Entity, const SScriptComponent& ScriptComponent, const STransformComponent& Transform)
+            {
+                const sol::table& Table = ScriptComponent.Script->ScriptTable;
+                Results.push_back(FScriptResult{ entt::to_integral(Entity), Table.get_or<int64>("Ticks", -1), Table.get_or<double>("Value", -1.0), Transform.GetLocation() });
+            });
+
+            eastl::sort(Results.begin(), Results.end(), [](const FScriptResult& A, const FScriptResult& B)
+            {
+                return A.Entity < B.Entity;
+            });
+
+            return Results;
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Scripting.Parallel.MatchesSerial")
+    {
+        const FFixedString ScriptPath = WriteScratchFile("ParallelDeterminism.lua", DeterminismScript);
+
+        const TVector<FScriptResult> Serial = RunDeterminismScript(ScriptPath, false);
+        const TVector<FScriptResult> Parallel = RunDeterminismScript(ScriptPath, true);
+
+        TEST_CHECK(!Serial.empty());
+        TEST_CHECK(Serial.size() == Parallel.size());
+        TEST_CHECK(Serial == Parallel);
+
+        // Every stage but Paused updates scripts, 8 frames of 5 stages.
+        TEST_CHECK(!Serial.empty() && Serial.front().Ticks == 40);
+    }
+
+    // Per frame cost of 10k thread safe scripts on the main state against the worker states.
+    LUMINA_AUTOMATION_TEST("Benchmark.Script.ParallelUpdate10k")
+    {
+        constexpr uint32 NumEntities = 10'000;
+        constexpr uint32 NumFrames = 30;
+
+        const FFixedString ScriptPath = WriteScratchFile("BenchmarkParallel.lua", WorkloadScript);
+
+        ForEachConsoleToggle("Script.ParallelUpdate", [&](bool bParallel)
+        {
+            FAutomationWorld World;
+            World.SpawnScriptedEntities(ScriptPath, NumEntities);
+            World.Tick(1.0 / 60.0, 2);
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            World.Tick(1.0 / 60.0, NumFrames);
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            LOG_INFO("[{}] {} entities, {} ({} worker states): {:.3f} ms per frame", Test.GetName(), NumEntities, bParallel ? "parallel" : "serial",
+                Scripting::FScriptingContext::Get().GetNumWorkerStates(), Duration.count() / NumFrames);
+        });
+    }
+}
+
+#endif
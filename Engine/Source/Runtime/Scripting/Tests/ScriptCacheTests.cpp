@@ -0,0 +1,108 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Scripting/Lua/Scripting.h"
+#include "World/Entity/Components/ScriptComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr const char* SpawnScript = R"(
+            local Spawned = 0
+            return {
+                Value = 1,
+                OnAttach = function(self)
+                    Spawned = Spawned + 1
+                    self.Spawned = Spawned
+                end
+            }
+        )";
+
+        constexpr const char* ReloadScriptA = "return { Value = 1 }";
+        constexpr const char* ReloadScriptB = "return { Value = 2 }";
+
+        uint32 GetNumChunkLoads()
+        {
+            const Scripting::FScriptingContext& Context = Scripting::FScriptingContext::Get();
+            return Context.GetNumSourceCompiles() + Context.GetNumBytecodeLoads();
+        }
+    }
+
+    // Spawn cost of 2k entities sharing one script, the chunk is compiled once and every entity only runs it in a new environment.
+    LUMINA_AUTOMATION_TEST("Benchmark.Script.Spawn2k")
+    {
+        constexpr uint32 NumEntities = 2'000;
+
+        const FFixedString ScriptPath = WriteScratchFile("BenchmarkSpawn.lua", SpawnScript);
+        const uint32 NumChunkLoadsBefore = GetNumChunkLoads();
+
+        FAutomationWorld World;
+
+        const auto Start = std::chrono::high_resolution_clock::now();
+        World.SpawnScriptedEntities(ScriptPath, NumEntities);
+        const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+        TEST_CHECK(GetNumChunkLoads() - NumChunkLoadsBefore <= 1);
+
+        // Locals of the chunk belong to the call that instanced it, so no two entities may see the same counter.
+        uint32 NumWrong = 0;
+        World.GetRegistry().view<SScriptComponent>().each([&](const SScriptComponent& ScriptComponent)
+        {
+            NumWrong += !ScriptComponent.Script || ScriptComponent.Script->ScriptTable.get_or<int64>("Spawned", 0) != 1;
+        });
+        TEST_CHECK(NumWrong == 0);
+
+        LOG_INFO("[{}] {} entities: {:.3f} ms, {:.3f} us per entity", Test.GetName(), NumEntities, Duration.count(), Duration.count() * 1000.0 / NumEntities);
+    }
+
+    LUMINA_AUTOMATION_TEST("Scripting.Cache.HotReloadInvalidates")
+    {
+        Scripting::FScriptingContext& Context = Scripting::FScriptingContext::Get();
+
+        const FFixedString ScriptPath = WriteScratchFile("HotReload.lua", ReloadScriptA);
+
+        // Drop whatever a previous run left compiled for this path, the first load has to read the file written above.
+        Context.ScriptDeleted(ScriptPath);
+        Context.ProcessDeferredActions();
+
+        TSharedPtr<Scripting::FLuaScript> First = Context.LoadUniqueScript(ScriptPath);
+        TSharedPtr<Scripting::FLuaScript> Second = Context.LoadUniqueScript(ScriptPath);
+        TEST_CHECK(First && Second);
+        if (!First || !Second)
+        {
+            return;
+        }
+
+        TEST_CHECK(First->ScriptTable.get_or<int64>("Value", 0) == 1);
+        TEST_CHECK(First->ScriptTable != Second->ScriptTable);
+
+        // A reload compiles the new content once and re-instances every live script.
+        const uint32 NumSourceCompiles = Context.GetNumSourceCompiles();
+        const uint32 NumBytecodeLoads = Context.GetNumBytecodeLoads();
+        WriteScratchFile("HotReload.lua", ReloadScriptB);
+        Context.ScriptReloaded(ScriptPath);
+        Context.ProcessDeferredActions();
+
+        TEST_CHECK(GetNumChunkLoads() == NumSourceCompiles + NumBytecodeLoads + 1);
+        TEST_CHECK(First->Version == 1 && Second->Version == 1);
+        TEST_CHECK(First->ScriptTable.get_or<int64>("Value", 0) == 2);
+        TEST_CHECK(Second->ScriptTable.get_or<int64>("Value", 0) == 2);
+
+        TSharedPtr<Scripting::FLuaScript> Third = Context.LoadUniqueScript(ScriptPath);
+        TEST_CHECK(Third && Third->ScriptTable.get_or<int64>("Value", 0) == 2);
+
+        // The disk cache is keyed by content, going back to the first version finds the bytecode stored for it.
+        WriteScratchFile("HotReload.lua", ReloadScriptA);
+        Context.ScriptReloaded(ScriptPath);
+        Context.ProcessDeferredActions();
+
+        TEST_CHECK(Context.GetNumBytecodeLoads() > NumBytecodeLoads);
+        TEST_CHECK(First->Version == 2);
+        TEST_CHECK(First->ScriptTable.get_or<int64>("Value", 0) == 1);
+    }
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Scripting/Lua/Scripting.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        // Roughly 2.5 MB of short lived tables and strings per call.
+        constexpr const char* ChurnScript = R"(
+            return {
+                Churn = function(self)
+                    for i = 1, 20000 do
+                        local Garbage = { i, tostring(i) }
+                    end
+                end
+            }
+        )";
+
+        constexpr const char* WorkerScript = R"(
+            return {
+                Values = { 1, 2, 3, "Worker" }
+            }
+        )";
+    }
+
+    // A script allocating garbage every frame stays bounded by the frame steps alone, and an exhausted budget stops the collector after a single step.
+    LUMINA_AUTOMATION_TEST("Scripting.Memory.GCStepBudget")
+    {
+        constexpr uint32 NumFrames = 200;
+
+        // Without collection the frames below would leave hundreds of megabytes behind.
+        constexpr size_t MaxOwnerBytes = 32 * 1024 * 1024;
+
+        Scripting::FScriptingContext& Context = Scripting::FScriptingContext::Get();
+        TScopedConsoleVariable<float> GCBudget("Script.GCBudgetMs", 1.0f);
+
+        const FFixedString ScriptPath = WriteScratchFile("GCChurn.lua", ChurnScript);
+        TSharedPtr<Scripting::FLuaScript> Script = Context.LoadUniqueScript(ScriptPath);
+        TEST_CHECK(Script != nullptr);
+        if (Script == nullptr)
+        {
+            return;
+        }
+
+        sol::protected_function Churn = Script->ScriptTable["Churn"];
+        double MaxStepSeconds = 0.0;
+        size_t MaxBytes = 0;
+
+        for (uint32 i = 0; i < NumFrames; ++i)
+        {
+            {
+                Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
+                TEST_CHECK(Churn(Script->ScriptTable).valid());
+            }
+
+            Context.StepGC();
+
+            MaxStepSeconds = eastl::max(MaxStepSeconds, Context.GetLastGCStepTime());
+            MaxBytes = eastl::max(MaxBytes, Context.GetMemoryStats()[Script->MemoryOwner].Bytes);
+        }
+
+        TEST_CHECK(MaxBytes < MaxOwnerBytes);
+
+        // Wall clock step times depend on the machine, they are reported rather than checked.
+        LOG_INFO("[{}] peak {} KB for the script, longest step {:.3f} ms", Test.GetName(), MaxBytes / 1024, MaxStepSeconds * 1000.0);
+
+        // With no budget left every frame still advances a running cycle, but by one basic step only.
+        GCBudget.Set(0.0f);
+
+        uint32 NumSteppedFrames = 0;
+        uint32 NumOverBudgetFrames = 0;
+        for (uint32 i = 0; i < NumFrames; ++i)
+        {
+            {
+                Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
+                TEST_CHECK(Churn(Script->ScriptTable).valid());
+            }
+
+            Context.StepGC();
+
+            NumSteppedFrames += Context.GetLastGCNumSteps() > 0 ? 1 : 0;
+            NumOverBudgetFrames += Context.GetLastGCNumSteps() > 1 ? 1 : 0;
+        }
+
+        TEST_CHECK(NumSteppedFrames > 0);
+        TEST_CHECK(NumOverBudgetFrames == 0);
+    }
+
+    // Allocations a worker state makes for a script are charged to that script's owner, and the per-owner stats include them.
+    LUMINA_AUTOMATION_TEST("Scripting.Memory.WorkerStatesAreCounted")
+    {
+        Scripting::FScriptingContext& Context = Scripting::FScriptingContext::Get();
+
+        const FFixedString ScriptPath = WriteScratchFile("WorkerOwner.lua", WorkerScript);
+        TSharedPtr<Scripting::FLuaScript> Script = Context.LoadUniqueScript(ScriptPath);
+        TEST_CHECK(Script != nullptr && Script->MemoryOwner != 0);
+        if (Script == nullptr)
+        {
+            return;
+        }
+
+        const uint32 Owner = Script->MemoryOwner;
+        auto GetOwnerBytes = [Owner](const Scripting::FScriptHeap& Heap)
+        {
+            return Owner < Heap.OwnerBytes.size() ? Heap.OwnerBytes[Owner] : 0;
+        };
+
+        const uint32 NumWorkers = Context.GetNumWorkerStates();
+        const size_t BytesBefore = GetOwnerBytes(Context.GetWorkerState(0).Heap);
+
+        sol::environment Environment;
+        sol::table Table;
+        TEST_CHECK(Context.InstantiateWorkerScript(0, *Script, Environment, Table));
+        TEST_CHECK(GetOwnerBytes(Context.GetWorkerState(0).Heap) > BytesBefore);
+
+        size_t WorkerOwnerBytes = 0;
+        for (uint32 i = 0; i < NumWorkers; ++i)
+        {
+            const Scripting::FScriptWorkerState& Worker = Context.GetWorkerState(i);
+            TEST_CHECK(Worker.Heap.TotalBytes > 0);
+            TEST_CHECK(Worker.Heap.TotalBytes == static_cast<size_t>(Worker.State.memory_used()));
+
+            // Every byte of a state belongs to exactly one owner.
+            size_t AttributedBytes = 0;
+            for (size_t Bytes : Worker.Heap.OwnerBytes)
+            {
+                AttributedBytes += Bytes;
+            }
+            TEST_CHECK(AttributedBytes == Worker.Heap.TotalBytes);
+
+            WorkerOwnerBytes += GetOwnerBytes(Worker.Heap);
+        }
+
+        // Only the main state is collected here, the worker bytes it gathers stay as they are.
+        Context.StepGC();
+        TEST_CHECK(Owner < Context.GetMemoryStats().size());
+        if (Owner < Context.GetMemoryStats().size())
+        {
+            TEST_CHECK(Context.GetMemoryStats()[Owner].Bytes >= WorkerOwnerBytes);
+        }
+    }
+}
+
+#endif
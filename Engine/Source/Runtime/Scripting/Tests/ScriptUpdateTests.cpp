@@ -0,0 +1,56 @@
+#include "pch.h"
+#include "World/Tests/AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Scripting/Lua/Scripting.h"
+#include "World/Entity/Components/ScriptComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr const char* CounterScript = R"(
+            return {
+                Ticks = 0,
+                Update = function(self, DeltaTime)
+                    self.Ticks = self.Ticks + 1
+                end
+            }
+        )";
+    }
+
+    // Per frame cost of 10k entities running one script, one Lua call per entity against one per script group.
+    LUMINA_AUTOMATION_TEST("Benchmark.Script.Update10k")
+    {
+        constexpr uint32 NumEntities = 10'000;
+        constexpr uint32 NumFrames = 60;
+        constexpr uint32 NumWarmupFrames = 2;
+
+        const FFixedString ScriptPath = WriteScratchFile("BenchmarkCounter.lua", CounterScript);
+
+        ForEachConsoleToggle("Script.BatchedUpdate", [&](bool bBatched)
+        {
+            FAutomationWorld World;
+            World.SpawnScriptedEntities(ScriptPath, NumEntities);
+            World.Tick(1.0 / 60.0, NumWarmupFrames);
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            World.Tick(1.0 / 60.0, NumFrames);
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            // The script system runs in every stage but Paused, each of them updates every instance once.
+            const int64 ExpectedTicks = (NumWarmupFrames + NumFrames) * 5;
+            uint32 NumWrong = 0;
+            World.GetRegistry().view<SScriptComponent>().each([&](const SScriptComponent& ScriptComponent)
+            {
+                NumWrong += !ScriptComponent.Script || ScriptComponent.Script->ScriptTable.get_or<int64>("Ticks", 0) != ExpectedTicks;
+            });
+            TEST_CHECK(NumWrong == 0);
+
+            LOG_INFO("[{}] {} entities, {}: {:.3f} ms per frame", Test.GetName(), NumEntities, bBatched ? "batched" : "per entity", Duration.count() / NumFrames);
+        });
+    }
+}
+
+#endif
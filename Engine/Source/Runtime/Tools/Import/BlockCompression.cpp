@@ -0,0 +1,803 @@
+#include "pch.h"
+#include "BlockCompression.h"
+
+#include "Core/Profiler/Profile.h"
+#include "Renderer/RenderResource.h"
+#include "TaskSystem/TaskSystem.h"
+
+namespace Lumina::Import::Textures::BlockCompression
+{
+    namespace
+    {
+        constexpr uint32 NumBlockTexels = BlockDim * BlockDim;
+
+        /** BC7 interpolation weights for 4 bit indices, out of 64. */
+        constexpr uint32 BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        class FBitWriter
+        {
+        public:
+
+            explicit FBitWriter(uint8* InData, uint32 NumBytes)
+                : Data(InData)
+            {
+                Memory::Memzero(Data, NumBytes);
+            }
+
+            void Write(uint32 Value, uint32 NumBits)
+            {
+                for (uint32 i = 0; i < NumBits; ++i, ++Offset)
+                {
+                    Data[Offset >> 3] |= (uint8)(((Value >> i) & 1u) << (Offset & 7u));
+                }
+            }
+
+        private:
+
+            uint8*  Data;
+            uint32  Offset = 0;
+        };
+
+        class FBitReader
+        {
+        public:
+
+            explicit FBitReader(const uint8* InData)
+                : Data(InData)
+            {
+            }
+
+            uint32 Read(uint32 NumBits)
+            {
+                uint32 Value = 0;
+                for (uint32 i = 0; i < NumBits; ++i, ++Offset)
+                {
+                    Value |= (uint32)((Data[Offset >> 3] >> (Offset & 7u)) & 1u) << i;
+                }
+                return Value;
+            }
+
+        private:
+
+            const uint8*    Data;
+            uint32          Offset = 0;
+        };
+
+        template<glm::length_t N>
+        using TPoint = glm::vec<N, float>;
+
+        /** Dominant direction of the block around its mean, found by power iteration on the covariance. */
+        template<glm::length_t N>
+        TPoint<N> PrincipalAxis(const TPoint<N>* Points, const TPoint<N>& Mean)
+        {
+            glm::mat<N, N, float> Covariance(0.0f);
+            TPoint<N> Axis(0.0f);
+            float FarthestSq = 0.0f;
+
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                const TPoint<N> Delta = Points[i] - Mean;
+                Covariance += glm::outerProduct(Delta, Delta);
+
+                const float DistanceSq = glm::dot(Delta, Delta);
+                if (DistanceSq > FarthestSq)
+                {
+                    FarthestSq = DistanceSq;
+                    Axis = Delta;
+                }
+            }
+
+            if (FarthestSq <= 0.0f)
+            {
+                return TPoint<N>(0.0f);
+            }
+
+            Axis = glm::normalize(Axis);
+            for (int Iteration = 0; Iteration < 8; ++Iteration)
+            {
+                const TPoint<N> Next = Covariance * Axis;
+                const float Length = glm::length(Next);
+                if (Length <= 1e-6f)
+                {
+                    break;
+                }
+                Axis = Next / Length;
+            }
+
+            return Axis;
+        }
+
+        /** Extremes of the block along Axis, the starting endpoints before any refinement. */
+        template<glm::length_t N>
+        void BoundEndpoints(const TPoint<N>* Points, const TPoint<N>& Mean, const TPoint<N>& Axis, TPoint<N>& OutLow, TPoint<N>& OutHigh)
+        {
+            float MinT = eastl::numeric_limits<float>::max();
+            float MaxT = eastl::numeric_limits<float>::lowest();
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                const float T = glm::dot(Points[i] - Mean, Axis);
+                MinT = glm::min(MinT, T);
+                MaxT = glm::max(MaxT, T);
+            }
+
+            OutLow  = Mean + Axis * MinT;
+            OutHigh = Mean + Axis * MaxT;
+        }
+
+        /** Least squares endpoints for texels reconstructed as mix(Low, High, Weights[i]), false when the weights are degenerate. */
+        template<glm::length_t N>
+        bool SolveEndpoints(const TPoint<N>* Points, const float* Weights, TPoint<N>& OutLow, TPoint<N>& OutHigh)
+        {
+            float AA = 0.0f, AB = 0.0f, BB = 0.0f;
+            TPoint<N> AX(0.0f), BX(0.0f);
+
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                const float A = 1.0f - Weights[i];
+                const float B = Weights[i];
+                AA += A * A;
+                AB += A * B;
+                BB += B * B;
+                AX += Points[i] * A;
+                BX += Points[i] * B;
+            }
+
+            const float Determinant = AA * BB - AB * AB;
+            if (glm::abs(Determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            OutLow  = (AX * BB - BX * AB) / Determinant;
+            OutHigh = (BX * AA - AX * AB) / Determinant;
+            return true;
+        }
+
+        //~ BC1
+
+        uint16 PackRGB565(const glm::vec3& Color)
+        {
+            const glm::vec3 Clamped = glm::clamp(Color, 0.0f, 255.0f);
+            const uint32 R = (uint32)(Clamped.r * (31.0f / 255.0f) + 0.5f);
+            const uint32 G = (uint32)(Clamped.g * (63.0f / 255.0f) + 0.5f);
+            const uint32 B = (uint32)(Clamped.b * (31.0f / 255.0f) + 0.5f);
+            return (uint16)((R << 11) | (G << 5) | B);
+        }
+
+        glm::vec3 UnpackRGB565(uint16 Color)
+        {
+            const uint32 R = (Color >> 11) & 31u;
+            const uint32 G = (Color >> 5) & 63u;
+            const uint32 B = Color & 31u;
+            return glm::vec3((float)((R << 3) | (R >> 2)), (float)((G << 2) | (G >> 4)), (float)((B << 3) | (B >> 2)));
+        }
+
+        /** Color0 > Color1 selects four colors, otherwise three colors and transparent black. */
+        void BuildBC1Palette(uint16 Color0, uint16 Color1, glm::vec3* OutPalette)
+        {
+            OutPalette[0] = UnpackRGB565(Color0);
+            OutPalette[1] = UnpackRGB565(Color1);
+
+            if (Color0 > Color1)
+            {
+                OutPalette[2] = (OutPalette[0] * 2.0f + OutPalette[1]) / 3.0f;
+                OutPalette[3] = (OutPalette[0] + OutPalette[1] * 2.0f) / 3.0f;
+            }
+            else
+            {
+                OutPalette[2] = (OutPalette[0] + OutPalette[1]) * 0.5f;
+                OutPalette[3] = glm::vec3(0.0f);
+            }
+        }
+
+        /** Orders the endpoints for four color mode and picks the nearest color per texel, returns the squared error. */
+        float FitBC1(const glm::vec3* Points, uint16& Color0, uint16& Color1, uint32& OutIndices)
+        {
+            if (Color0 < Color1)
+            {
+                eastl::swap(Color0, Color1);
+            }
+
+            glm::vec3 Palette[4];
+            BuildBC1Palette(Color0, Color1, Palette);
+
+            // Equal endpoints fall into three color mode, index 0 is the only safe choice there.
+            const uint32 NumColors = Color0 > Color1 ? 4 : 1;
+
+            OutIndices = 0;
+            float Error = 0.0f;
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                uint32 BestIndex = 0;
+                float BestDistance = eastl::numeric_limits<float>::max();
+                for (uint32 Index = 0; Index < NumColors; ++Index)
+                {
+                    const glm::vec3 Delta = Points[i] - Palette[Index];
+                    const float Distance = glm::dot(Delta, Delta);
+                    if (Distance < BestDistance)
+                    {
+                        BestDistance = Distance;
+                        BestIndex = Index;
+                    }
+                }
+
+                Error += BestDistance;
+                OutIndices |= BestIndex << (i * 2);
+            }
+
+            return Error;
+        }
+
+        void EncodeBC1(const uint8* Texels, uint8* OutBlock)
+        {
+            glm::vec3 Points[NumBlockTexels];
+            glm::vec3 Mean(0.0f);
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                Points[i] = glm::vec3(Texels[i * 4 + 0], Texels[i * 4 + 1], Texels[i * 4 + 2]);
+                Mean += Points[i];
+            }
+            Mean /= (float)NumBlockTexels;
+
+            glm::vec3 Low, High;
+            BoundEndpoints<3>(Points, Mean, PrincipalAxis<3>(Points, Mean), Low, High);
+
+            uint16 Color0 = PackRGB565(High);
+            uint16 Color1 = PackRGB565(Low);
+            uint32 Indices = 0;
+            float Error = FitBC1(Points, Color0, Color1, Indices);
+
+            // The box along the axis overshoots on skewed blocks, refitting to the chosen indices pulls the endpoints in.
+            constexpr float IndexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            for (int Iteration = 0; Iteration < 2 && Error > 0.0f; ++Iteration)
+            {
+                float Weights[NumBlockTexels];
+                for (uint32 i = 0; i < NumBlockTexels; ++i)
+                {
+                    Weights[i] = IndexWeights[(Indices >> (i * 2)) & 3u];
+                }
+
+                glm::vec3 Start, End;
+                if (!SolveEndpoints<3>(Points, Weights, Start, End))
+                {
+                    break;
+                }
+
+                uint16 NewColor0 = PackRGB565(Start);
+                uint16 NewColor1 = PackRGB565(End);
+                uint32 NewIndices = 0;
+                const float NewError = FitBC1(Points, NewColor0, NewColor1, NewIndices);
+                if (NewError >= Error)
+                {
+                    break;
+                }
+
+                Color0  = NewColor0;
+                Color1  = NewColor1;
+                Indices = NewIndices;
+                Error   = NewError;
+            }
+
+            OutBlock[0] = (uint8)(Color0 & 0xFF);
+            OutBlock[1] = (uint8)(Color0 >> 8);
+            OutBlock[2] = (uint8)(Color1 & 0xFF);
+            OutBlock[3] = (uint8)(Color1 >> 8);
+            for (uint32 i = 0; i < 4; ++i)
+            {
+                OutBlock[4 + i] = (uint8)(Indices >> (i * 8));
+            }
+        }
+
+        void DecodeBC1(const uint8* Block, uint8* OutTexels)
+        {
+            const uint16 Color0 = (uint16)(Block[0] | (Block[1] << 8));
+            const uint16 Color1 = (uint16)(Block[2] | (Block[3] << 8));
+            const uint32 Indices = (uint32)Block[4] | ((uint32)Block[5] << 8) | ((uint32)Block[6] << 16) | ((uint32)Block[7] << 24);
+
+            glm::vec3 Palette[4];
+            BuildBC1Palette(Color0, Color1, Palette);
+
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                const uint32 Index = (Indices >> (i * 2)) & 3u;
+                for (uint32 Channel = 0; Channel < 3; ++Channel)
+                {
+                    OutTexels[i * 4 + Channel] = (uint8)(Palette[Index][Channel] + 0.5f);
+                }
+                OutTexels[i * 4 + 3] = (Color0 <= Color1 && Index == 3) ? 0 : 255;
+            }
+        }
+
+        //~ BC4 / BC5
+
+        /** Endpoint0 > Endpoint1 selects eight interpolated levels, otherwise six levels plus exact 0 and 255. */
+        void BuildBC4Palette(uint8 Endpoint0, uint8 Endpoint1, uint8* OutPalette)
+        {
+            OutPalette[0] = Endpoint0;
+            OutPalette[1] = Endpoint1;
+
+            if (Endpoint0 > Endpoint1)
+            {
+                for (uint32 i = 1; i < 7; ++i)
+                {
+                    OutPalette[i + 1] = (uint8)(((7 - i) * Endpoint0 + i * Endpoint1 + 3) / 7);
+                }
+            }
+            else
+            {
+                for (uint32 i = 1; i < 5; ++i)
+                {
+                    OutPalette[i + 1] = (uint8)(((5 - i) * Endpoint0 + i * Endpoint1 + 2) / 5);
+                }
+                OutPalette[6] = 0;
+                OutPalette[7] = 255;
+            }
+        }
+
+        void EncodeBC4(const uint8* Texels, uint32 Channel, uint8* OutBlock)
+        {
+            uint8 Values[NumBlockTexels];
+            uint8 Min = 255, Max = 0;
+            uint8 InnerMin = 255, InnerMax = 0;
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                const uint8 Value = Texels[i * 4 + Channel];
+                Values[i] = Value;
+                Min = glm::min(Min, Value);
+                Max = glm::max(Max, Value);
+
+                if (Value != 0 && Value != 255)
+                {
+                    InnerMin = glm::min(InnerMin, Value);
+                    InnerMax = glm::max(InnerMax, Value);
+                }
+            }
+
+            uint8 BestEndpoints[2] = {};
+            uint64 BestIndices = 0;
+            uint32 BestError = eastl::numeric_limits<uint32>::max();
+
+            auto TryEndpoints = [&](uint8 Endpoint0, uint8 Endpoint1)
+            {
+                uint8 Palette[8];
+                BuildBC4Palette(Endpoint0, Endpoint1, Palette);
+
+                uint64 Indices = 0;
+                uint32 Error = 0;
+                for (uint32 i = 0; i < NumBlockTexels; ++i)
+                {
+                    uint32 BestIndex = 0;
+                    uint32 BestDistance = eastl::numeric_limits<uint32>::max();
+                    for (uint32 Index = 0; Index < 8; ++Index)
+                    {
+                        const int32 Delta = (int32)Values[i] - (int32)Palette[Index];
+                        const uint32 Distance = (uint32)(Delta * Delta);
+                        if (Distance < BestDistance)
+                        {
+                            BestDistance = Distance;
+                            BestIndex = Index;
+                        }
+                    }
+
+                    Error += BestDistance;
+                    Indices |= (uint64)BestIndex << (i * 3);
+                }
+
+                if (Error < BestError)
+                {
+                    BestError = Error;
+                    BestIndices = Indices;
+                    BestEndpoints[0] = Endpoint0;
+                    BestEndpoints[1] = Endpoint1;
+                }
+            };
+
+            TryEndpoints(Max, Min);
+
+            // Blocks mixing saturated texels with a narrow range in between do better spending the levels on that range.
+            if (InnerMin <= InnerMax)
+            {
+                TryEndpoints(InnerMin, InnerMax);
+            }
+
+            OutBlock[0] = BestEndpoints[0];
+            OutBlock[1] = BestEndpoints[1];
+            for (uint32 i = 0; i < 6; ++i)
+            {
+                OutBlock[2 + i] = (uint8)(BestIndices >> (i * 8));
+            }
+        }
+
+        void DecodeBC4(const uint8* Block, uint32 Channel, uint8* OutTexels)
+        {
+            uint8 Palette[8];
+            BuildBC4Palette(Block[0], Block[1], Palette);
+
+            uint64 Indices = 0;
+            for (uint32 i = 0; i < 6; ++i)
+            {
+                Indices |= (uint64)Block[2 + i] << (i * 8);
+            }
+
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                OutTexels[i * 4 + Channel] = Palette[(Indices >> (i * 3)) & 7u];
+            }
+        }
+
+        //~ BC7
+
+        /** A mode 6 block: one RGBA subset, 7 bit endpoints with a p-bit each and 4 bit indices. */
+        struct FBC7Mode6Block
+        {
+            uint32 Endpoints[2][4];
+            uint32 PBits[2];
+            uint32 Indices[NumBlockTexels];
+        };
+
+        glm::vec4 DequantizeBC7(const FBC7Mode6Block& Block, uint32 Endpoint)
+        {
+            glm::vec4 Result;
+            for (uint32 Channel = 0; Channel < 4; ++Channel)
+            {
+                Result[Channel] = (float)((Block.Endpoints[Endpoint][Channel] << 1) | Block.PBits[Endpoint]);
+            }
+            return Result;
+        }
+
+        glm::vec4 InterpolateBC7(const glm::vec4& Endpoint0, const glm::vec4& Endpoint1, uint32 Index)
+        {
+            const uint32 Weight = BC7Weights[Index];
+            glm::vec4 Result;
+            for (uint32 Channel = 0; Channel < 4; ++Channel)
+            {
+                Result[Channel] = (float)(((64 - Weight) * (uint32)Endpoint0[Channel] + Weight * (uint32)Endpoint1[Channel] + 32) >> 6);
+            }
+            return Result;
+        }
+
+        /** Quantizes the endpoints under each of the four p-bit pairs and keeps the pair with the lowest squared error. */
+        float FitBC7(const glm::vec4* Points, const glm::vec4& Low, const glm::vec4& High, FBC7Mode6Block& OutBlock)
+        {
+            float BestError = eastl::numeric_limits<float>::max();
+
+            for (uint32 PBitPair = 0; PBitPair < 4; ++PBitPair)
+            {
+                FBC7Mode6Block Candidate;
+                Candidate.PBits[0] = PBitPair & 1u;
+                Candidate.PBits[1] = PBitPair >> 1;
+
+                for (uint32 Channel = 0; Channel < 4; ++Channel)
+                {
+                    Candidate.Endpoints[0][Channel] = (uint32)glm::clamp((Low[Channel] - (float)Candidate.PBits[0]) * 0.5f + 0.5f, 0.0f, 127.0f);
+                    Candidate.Endpoints[1][Channel] = (uint32)glm::clamp((High[Channel] - (float)Candidate.PBits[1]) * 0.5f + 0.5f, 0.0f, 127.0f);
+                }
+
+                const glm::vec4 Endpoint0 = DequantizeBC7(Candidate, 0);
+                const glm::vec4 Endpoint1 = DequantizeBC7(Candidate, 1);
+
+                glm::vec4 Palette[16];
+                for (uint32 Index = 0; Index < 16; ++Index)
+                {
+                    Palette[Index] = InterpolateBC7(Endpoint0, Endpoint1, Index);
+                }
+
+                const glm::vec4 Direction = Endpoint1 - Endpoint0;
+                const float LengthSq = glm::dot(Direction, Direction);
+
+                float Error = 0.0f;
+                for (uint32 i = 0; i < NumBlockTexels; ++i)
+                {
+                    // Project onto the segment for a first guess, then settle between its neighbours on the real palette.
+                    uint32 Guess = 0;
+                    if (LengthSq > 0.0f)
+                    {
+                        const float Weight = glm::clamp(glm::dot(Points[i] - Endpoint0, Direction) / LengthSq, 0.0f, 1.0f) * 64.0f;
+                        while (Guess < 15 && (float)(BC7Weights[Guess] + BC7Weights[Guess + 1]) * 0.5f < Weight)
+                        {
+                            ++Guess;
+                        }
+                    }
+
+                    uint32 BestIndex = Guess;
+                    float BestDistance = eastl::numeric_limits<float>::max();
+                    for (uint32 Index = Guess > 0 ? Guess - 1 : 0; Index <= glm::min(Guess + 1, 15u); ++Index)
+                    {
+                        const glm::vec4 Delta = Points[i] - Palette[Index];
+                        const float Distance = glm::dot(Delta, Delta);
+                        if (Distance < BestDistance)
+                        {
+                            BestDistance = Distance;
+                            BestIndex = Index;
+                        }
+                    }
+
+                    Candidate.Indices[i] = BestIndex;
+                    Error += BestDistance;
+                }
+
+                if (Error < BestError)
+                {
+                    BestError = Error;
+                    OutBlock = Candidate;
+                }
+            }
+
+            return BestError;
+        }
+
+        void EncodeBC7(const uint8* Texels, uint8* OutBlock)
+        {
+            glm::vec4 Points[NumBlockTexels];
+            glm::vec4 Mean(0.0f);
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                Points[i] = glm::vec4(Texels[i * 4 + 0], Texels[i * 4 + 1], Texels[i * 4 + 2], Texels[i * 4 + 3]);
+                Mean += Points[i];
+            }
+            Mean /= (float)NumBlockTexels;
+
+            glm::vec4 Low, High;
+            BoundEndpoints<4>(Points, Mean, PrincipalAxis<4>(Points, Mean), Low, High);
+
+            FBC7Mode6Block Block;
+            float Error = FitBC7(Points, Low, High, Block);
+
+            for (int Iteration = 0; Iteration < 2 && Error > 0.0f; ++Iteration)
+            {
+                float Weights[NumBlockTexels];
+                for (uint32 i = 0; i < NumBlockTexels; ++i)
+                {
+                    Weights[i] = (float)BC7Weights[Block.Indices[i]] / 64.0f;
+                }
+
+                glm::vec4 Start, End;
+                if (!SolveEndpoints<4>(Points, Weights, Start, End))
+                {
+                    break;
+                }
+
+                FBC7Mode6Block Refined;
+                const float RefinedError = FitBC7(Points, Start, End, Refined);
+                if (RefinedError >= Error)
+                {
+                    break;
+                }
+
+                Block = Refined;
+                Error = RefinedError;
+            }
+
+            // The first texel's index is stored without its top bit, swapping the endpoints mirrors every index below 8.
+            if (Block.Indices[0] >= 8)
+            {
+                for (uint32 Channel = 0; Channel < 4; ++Channel)
+                {
+                    eastl::swap(Block.Endpoints[0][Channel], Block.Endpoints[1][Channel]);
+                }
+                eastl::swap(Block.PBits[0], Block.PBits[1]);
+
+                for (uint32& Index : Block.Indices)
+                {
+                    Index = 15 - Index;
+                }
+            }
+
+            FBitWriter Writer(OutBlock, 16);
+            Writer.Write(1u << 6, 7);
+            for (uint32 Channel = 0; Channel < 4; ++Channel)
+            {
+                Writer.Write(Block.Endpoints[0][Channel], 7);
+                Writer.Write(Block.Endpoints[1][Channel], 7);
+            }
+            Writer.Write(Block.PBits[0], 1);
+            Writer.Write(Block.PBits[1], 1);
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                Writer.Write(Block.Indices[i], i == 0 ? 3 : 4);
+            }
+        }
+
+        void DecodeBC7(const uint8* Block, uint8* OutTexels)
+        {
+            FBitReader Reader(Block);
+
+            uint32 Mode = 0;
+            while (Mode < 8 && Reader.Read(1) == 0)
+            {
+                ++Mode;
+            }
+
+            if (Mode != 6)
+            {
+                Memory::Memzero(OutTexels, NumBlockTexels * 4);
+                return;
+            }
+
+            FBC7Mode6Block Decoded;
+            for (uint32 Channel = 0; Channel < 4; ++Channel)
+            {
+                Decoded.Endpoints[0][Channel] = Reader.Read(7);
+                Decoded.Endpoints[1][Channel] = Reader.Read(7);
+            }
+            Decoded.PBits[0] = Reader.Read(1);
+            Decoded.PBits[1] = Reader.Read(1);
+
+            const glm::vec4 Endpoint0 = DequantizeBC7(Decoded, 0);
+            const glm::vec4 Endpoint1 = DequantizeBC7(Decoded, 1);
+
+            for (uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                const glm::vec4 Texel = InterpolateBC7(Endpoint0, Endpoint1, Reader.Read(i == 0 ? 3 : 4));
+                for (uint32 Channel = 0; Channel < 4; ++Channel)
+                {
+                    OutTexels[i * 4 + Channel] = (uint8)Texel[Channel];
+                }
+            }
+        }
+
+        /** Channels a format actually encodes, the rest are constants that would only inflate the PSNR. */
+        uint32 GetNumEncodedChannels(EFormat Format)
+        {
+            switch (Format)
+            {
+                case EFormat::BC1_UNORM:
+                case EFormat::BC1_UNORM_SRGB:   return 3;
+                case EFormat::BC4_UNORM:        return 1;
+                case EFormat::BC5_UNORM:        return 2;
+                default:                        return 4;
+            }
+        }
+    }
+
+    bool IsSupported(EFormat Format)
+    {
+        switch (Format)
+        {
+            case EFormat::BC1_UNORM:
+            case EFormat::BC1_UNORM_SRGB:
+            case EFormat::BC4_UNORM:
+            case EFormat::BC5_UNORM:
+            case EFormat::BC7_UNORM:
+            case EFormat::BC7_UNORM_SRGB:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void EncodeBlock(EFormat Format, const uint8* Texels, uint8* OutBlock)
+    {
+        switch (Format)
+        {
+            case EFormat::BC1_UNORM:
+            case EFormat::BC1_UNORM_SRGB:
+                EncodeBC1(Texels, OutBlock);
+                break;
+            case EFormat::BC4_UNORM:
+                EncodeBC4(Texels, 0, OutBlock);
+                break;
+            case EFormat::BC5_UNORM:
+                EncodeBC4(Texels, 0, OutBlock);
+                EncodeBC4(Texels, 1, OutBlock + 8);
+                break;
+            case EFormat::BC7_UNORM:
+            case EFormat::BC7_UNORM_SRGB:
+                EncodeBC7(Texels, OutBlock);
+                break;
+            default:
+                UNREACHABLE();
+        }
+    }
+
+    void DecodeBlock(EFormat Format, const uint8* Block, uint8* OutTexels)
+    {
+        switch (Format)
+        {
+            case EFormat::BC1_UNORM:
+            case EFormat::BC1_UNORM_SRGB:
+                DecodeBC1(Block, OutTexels);
+                break;
+            case EFormat::BC4_UNORM:
+            case EFormat::BC5_UNORM:
+                for (uint32 i = 0; i < NumBlockTexels; ++i)
+                {
+                    OutTexels[i * 4 + 1] = 0;
+                    OutTexels[i * 4 + 2] = 0;
+                    OutTexels[i * 4 + 3] = 255;
+                }
+                DecodeBC4(Block, 0, OutTexels);
+                if (Format == EFormat::BC5_UNORM)
+                {
+                    DecodeBC4(Block + 8, 1, OutTexels);
+                }
+                break;
+            case EFormat::BC7_UNORM:
+            case EFormat::BC7_UNORM_SRGB:
+                DecodeBC7(Block, OutTexels);
+                break;
+            default:
+                UNREACHABLE();
+        }
+    }
+
+    void CompressImage(EFormat Format, const uint8* Pixels, uint32 Width, uint32 Height, TVector<uint8>& OutBlocks)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const uint32 BlockBytes = RHI::Format::BytesPerBlock(Format);
+        const uint32 NumBlocksX = (Width + BlockDim - 1) / BlockDim;
+        const uint32 NumBlocksY = (Height + BlockDim - 1) / BlockDim;
+        OutBlocks.resize((size_t)NumBlocksX * NumBlocksY * BlockBytes);
+
+        Task::ParallelFor(NumBlocksY, [&](uint32 BlockY)
+        {
+            uint8 Texels[NumBlockTexels * 4];
+            for (uint32 BlockX = 0; BlockX < NumBlocksX; ++BlockX)
+            {
+                for (uint32 Y = 0; Y < BlockDim; ++Y)
+                {
+                    const uint32 SourceY = glm::min(BlockY * BlockDim + Y, Height - 1);
+                    for (uint32 X = 0; X < BlockDim; ++X)
+                    {
+                        const uint32 SourceX = glm::min(BlockX * BlockDim + X, Width - 1);
+                        Memory::Memcpy(&Texels[(Y * BlockDim + X) * 4], &Pixels[((size_t)SourceY * Width + SourceX) * 4], 4);
+                    }
+                }
+
+                EncodeBlock(Format, Texels, &OutBlocks[((size_t)BlockY * NumBlocksX + BlockX) * BlockBytes]);
+            }
+        });
+    }
+
+    void DecompressImage(EFormat Format, const uint8* Blocks, uint32 Width, uint32 Height, TVector<uint8>& OutPixels)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const uint32 BlockBytes = RHI::Format::BytesPerBlock(Format);
+        const uint32 NumBlocksX = (Width + BlockDim - 1) / BlockDim;
+        const uint32 NumBlocksY = (Height + BlockDim - 1) / BlockDim;
+        OutPixels.resize((size_t)Width * Height * 4);
+
+        Task::ParallelFor(NumBlocksY, [&](uint32 BlockY)
+        {
+            uint8 Texels[NumBlockTexels * 4];
+            for (uint32 BlockX = 0; BlockX < NumBlocksX; ++BlockX)
+            {
+                DecodeBlock(Format, &Blocks[((size_t)BlockY * NumBlocksX + BlockX) * BlockBytes], Texels);
+
+                for (uint32 Y = 0; Y < BlockDim && BlockY * BlockDim + Y < Height; ++Y)
+                {
+                    for (uint32 X = 0; X < BlockDim && BlockX * BlockDim + X < Width; ++X)
+                    {
+                        const size_t Destination = ((size_t)(BlockY * BlockDim + Y) * Width + BlockX * BlockDim + X) * 4;
+                        Memory::Memcpy(&OutPixels[Destination], &Texels[(Y * BlockDim + X) * 4], 4);
+                    }
+                }
+            }
+        });
+    }
+
+    double ComputePSNR(EFormat Format, const uint8* Reference, const uint8* Test, uint32 NumPixels)
+    {
+        const uint32 NumChannels = GetNumEncodedChannels(Format);
+
+        double SquaredError = 0.0;
+        for (uint32 Pixel = 0; Pixel < NumPixels; ++Pixel)
+        {
+            for (uint32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const double Delta = (double)Reference[Pixel * 4 + Channel] - (double)Test[Pixel * 4 + Channel];
+                SquaredError += Delta * Delta;
+            }
+        }
+
+        if (SquaredError == 0.0 || NumPixels == 0)
+        {
+            return eastl::numeric_limits<double>::infinity();
+        }
+
+        const double MeanSquaredError = SquaredError / ((double)NumPixels * NumChannels);
+        return 10.0 * std::log10(255.0 * 255.0 / MeanSquaredError);
+    }
+}
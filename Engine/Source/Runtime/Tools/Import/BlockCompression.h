@@ -0,0 +1,28 @@
+﻿#pragma once
+
+#include "Containers/Array.h"
+#include "Platform/GenericPlatform.h"
+#include "Renderer/Format.h"
+
+namespace Lumina::Import::Textures::BlockCompression
+{
+    /** Texel width and height of one compressed block. */
+    constexpr uint32 BlockDim = 4;
+
+    /** True for the formats this encoder writes: BC1, BC4, BC5 and BC7 (mode 6 only). */
+    bool IsSupported(EFormat Format);
+
+    /** Encodes 16 row major RGBA8 texels into one block of Format. */
+    void EncodeBlock(EFormat Format, const uint8* Texels, uint8* OutBlock);
+
+    /** Decodes a block written by EncodeBlock to 16 RGBA8 texels, missing channels read as 0 and missing alpha as 255. */
+    void DecodeBlock(EFormat Format, const uint8* Block, uint8* OutTexels);
+
+    /** Encodes a tightly packed RGBA8 image one block row per task, blocks hanging over the edge repeat the last column and row. */
+    void CompressImage(EFormat Format, const uint8* Pixels, uint32 Width, uint32 Height, TVector<uint8>& OutBlocks);
+
+    void DecompressImage(EFormat Format, const uint8* Blocks, uint32 Width, uint32 Height, TVector<uint8>& OutPixels);
+
+    /** PSNR in dB between two RGBA8 images over the channels Format stores, infinite when they match. */
+    double ComputePSNR(EFormat Format, const uint8* Reference, const uint8* Test, uint32 NumPixels);
+}
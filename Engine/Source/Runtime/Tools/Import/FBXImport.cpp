@@ -652,6 +652,16 @@ namespace Lumina::Import::Mesh::FBX
                 OptimizeNewlyImportedMesh(*Resource);
             }
         
+            if (ImportOptions.bBuildMeshlets && !Resource->IsSkinnedMesh())
+            {
+                BuildMeshlets(*Resource);
+            }
+
+            if (ImportOptions.bGenerateLODs)
+            {
+                GenerateMeshLODs(*Resource);
+            }
+
             GenerateShadowBuffers(*Resource);
             AnalyzeMeshStatistics(*Resource, ImportData.MeshStatistics);
             
@@ -426,6 +426,16 @@ namespace Lumina::Import::Mesh::GLTF
                 OptimizeNewlyImportedMesh(*NewResource);
             }
         
+            if (ImportOptions.bBuildMeshlets && !NewResource->IsSkinnedMesh())
+            {
+                BuildMeshlets(*NewResource);
+            }
+
+            if (ImportOptions.bGenerateLODs)
+            {
+                GenerateMeshLODs(*NewResource);
+            }
+
             GenerateShadowBuffers(*NewResource);
             AnalyzeMeshStatistics(*NewResource, ImportData.MeshStatistics);
             
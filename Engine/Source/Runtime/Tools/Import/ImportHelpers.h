@@ -16,6 +16,7 @@ namespace Lumina
     struct FAnimationResource;
     struct FMeshResource;
     struct FSkeletonResource;
+    struct FTextureResource;
     class IRenderContext;
     struct FVertex;
 }
@@ -36,6 +37,44 @@ namespace Lumina::Import
     
         /** Creates a raw RHI Image */
         NODISCARD RUNTIME_API FRHIImageRef CreateTextureFromImport(FStringView RawFilePath, bool bFlipVerticalOnLoad = true);
+
+        enum class ETextureImportType : uint8
+        {
+            /** Picked from the channel count and the file name. */
+            Auto,
+            /** sRGB encoded color, mips are averaged in linear space. */
+            Color,
+            /** Masks and packed data, filtered as stored. */
+            Linear,
+            /** Tangent space normals, mips are renormalized and only X and Y survive compression. */
+            NormalMap,
+            /** One channel, read from red. */
+            Grayscale,
+        };
+
+        struct FTextureImportOptions
+        {
+            ETextureImportType Type     = ETextureImportType::Auto;
+            bool bGenerateMips          = true;
+            bool bCompress              = true;
+
+            /** Normal maps keep only X and Y in BC5, materials rebuild Z with a Derive Normal Z node. Off stores all three channels in BC7. */
+            bool bTwoChannelNormals     = true;
+
+            /** A compressed top mip below this quality is stored uncompressed instead. */
+            float MinCompressedPSNR     = 30.0f;
+        };
+
+        ETextureImportType ResolveTextureType(FStringView RawFilePath, const FTextureImportResult& Image, ETextureImportType Requested);
+
+        /**
+         * Filters the mip chain on the CPU and stores every level in OutResource, block compressed when the type has a format for it.
+         * Fills the format, extent and mip count of the image description, the creation flags are left to the caller.
+         */
+        bool BuildTextureMips(const FTextureImportResult& Image, ETextureImportType Type, const FTextureImportOptions& Options, FTextureResource& OutResource);
+
+        /** Expands any imported image to tightly packed RGBA8, for thumbnails and previews. */
+        void ConvertToRGBA8(const FTextureImportResult& Image, TVector<uint8>& OutPixels);
     }
 
     namespace Mesh
@@ -43,6 +82,8 @@ namespace Lumina::Import
         struct FMeshImportOptions
         {
             bool bOptimize          = true;
+            bool bGenerateLODs      = true;
+            bool bBuildMeshlets     = true;
             bool bImportMaterials   = true;
             bool bImportTextures    = true;
             bool bImportMeshes      = true;
@@ -102,6 +143,9 @@ namespace Lumina::Import
         };
         
         void OptimizeNewlyImportedMesh(FMeshResource& MeshResource);
+        /** Reorders the full detail indices into meshlets, run it before GenerateMeshLODs so the levels are not clustered. */
+        void BuildMeshlets(FMeshResource& MeshResource);
+        void GenerateMeshLODs(FMeshResource& MeshResource);
         void GenerateShadowBuffers(FMeshResource& MeshResource);
         void AnalyzeMeshStatistics(FMeshResource& MeshResource, FMeshStatistics& OutMeshStats);
         
@@ -22,6 +22,163 @@ namespace Lumina::Import::Mesh
         meshopt_optimizeVertexFetch(MeshResource.GetVertexData(), MeshResource.Indices.data(), MeshResource.Indices.size(), MeshResource.GetVertexData(), NumVertices, MeshResource.GetVertexTypeSize());
     }
 
+    void BuildMeshlets(FMeshResource& MeshResource)
+    {
+        // Weighs triangle orientation into clustering so meshlets get tighter normal cones for backface culling.
+        constexpr float ConeWeight = 0.25f;
+
+        MeshResource.Meshlets.clear();
+        
+        const size_t NumVertices    = MeshResource.GetNumVertices();
+        const size_t VertexStride   = MeshResource.GetVertexTypeSize();
+        const float* Positions      = static_cast<const float*>(MeshResource.GetVertexData());
+        
+        for (FGeometrySurface& Surface : MeshResource.GeometrySurfaces)
+        {
+            Surface.FirstMeshlet    = (uint32)MeshResource.Meshlets.size();
+            Surface.NumMeshlets     = 0;
+            
+            uint32* SurfaceIndices = &MeshResource.Indices[Surface.StartIndex];
+            
+            const size_t MaxMeshlets = meshopt_buildMeshletsBound(Surface.IndexCount, FMeshlet::MaxVertices, FMeshlet::MaxTriangles);
+            TVector<meshopt_Meshlet> Meshlets(MaxMeshlets);
+            TVector<uint32> MeshletVertices(MaxMeshlets * FMeshlet::MaxVertices);
+            TVector<uint8> MeshletTriangles(MaxMeshlets * FMeshlet::MaxTriangles * 3);
+            
+            const size_t NumMeshlets = meshopt_buildMeshlets(Meshlets.data(), MeshletVertices.data(), MeshletTriangles.data(), SurfaceIndices, Surface.IndexCount,
+                Positions, NumVertices, VertexStride, FMeshlet::MaxVertices, FMeshlet::MaxTriangles, ConeWeight);
+            
+            // The surface's indices are rewritten in meshlet order, each meshlet becomes a contiguous range of its own triangles.
+            TVector<uint32> Reordered;
+            Reordered.reserve(Surface.IndexCount);
+            
+            for (size_t i = 0; i < NumMeshlets; ++i)
+            {
+                const meshopt_Meshlet& Meshlet = Meshlets[i];
+                meshopt_optimizeMeshlet(&MeshletVertices[Meshlet.vertex_offset], &MeshletTriangles[Meshlet.triangle_offset], Meshlet.triangle_count, Meshlet.vertex_count);
+                
+                const meshopt_Bounds Bounds = meshopt_computeMeshletBounds(&MeshletVertices[Meshlet.vertex_offset], &MeshletTriangles[Meshlet.triangle_offset],
+                    Meshlet.triangle_count, Positions, NumVertices, VertexStride);
+                
+                FMeshlet& NewMeshlet    = MeshResource.Meshlets.emplace_back();
+                NewMeshlet.Center       = glm::vec3(Bounds.center[0], Bounds.center[1], Bounds.center[2]);
+                NewMeshlet.Radius       = Bounds.radius;
+                NewMeshlet.ConeAxis     = glm::vec3(Bounds.cone_axis[0], Bounds.cone_axis[1], Bounds.cone_axis[2]);
+                NewMeshlet.ConeCutoff   = Bounds.cone_cutoff;
+                NewMeshlet.StartIndex   = Surface.StartIndex + (uint32)Reordered.size();
+                NewMeshlet.IndexCount   = Meshlet.triangle_count * 3;
+                
+                for (uint32 Index = 0; Index < Meshlet.triangle_count * 3; ++Index)
+                {
+                    Reordered.push_back(MeshletVertices[Meshlet.vertex_offset + MeshletTriangles[Meshlet.triangle_offset + Index]]);
+                }
+            }
+            
+            // Every triangle lands in exactly one meshlet, anything else leaves the surface without meshlets.
+            if (Reordered.size() != Surface.IndexCount)
+            {
+                MeshResource.Meshlets.resize(Surface.FirstMeshlet);
+                continue;
+            }
+            
+            eastl::copy(Reordered.begin(), Reordered.end(), SurfaceIndices);
+            Surface.NumMeshlets = (uint32)NumMeshlets;
+        }
+    }
+
+    void GenerateMeshLODs(FMeshResource& MeshResource)
+    {
+        // Each level halves the triangle count of the one before it, within a growing error budget relative to the mesh extents.
+        constexpr float LODTargetErrors[]   = { 0.01f, 0.02f, 0.04f, 0.08f };
+        constexpr float LODTriangleRatio    = 0.5f;
+        
+        // Levels that save less than this are not worth the extra indices.
+        constexpr float MinLODReduction     = 0.85f;
+        constexpr size_t MinLODTriangles    = 32;
+
+        MeshResource.LODs.clear();
+        
+        const size_t NumVertices    = MeshResource.GetNumVertices();
+        const size_t VertexStride   = MeshResource.GetVertexTypeSize();
+        const float* Positions      = static_cast<const float*>(MeshResource.GetVertexData());
+        const float MeshScale       = meshopt_simplifyScale(Positions, NumVertices, VertexStride);
+        
+        float ChainError = 0.0f;
+        for (float TargetError : LODTargetErrors)
+        {
+            const uint32 SourceLOD = MeshResource.GetNumLODs() - 1;
+            const size_t SourceIndexCount = MeshResource.GetLODNumIndices(SourceLOD);
+            if (SourceIndexCount / 3 < MinLODTriangles)
+            {
+                break;
+            }
+            
+            // Surfaces are copied, the index buffer below may reallocate while they are simplified.
+            const TVector<FGeometrySurface> SourceSurfaces = MeshResource.GetLODSurfaces(SourceLOD);
+
+            FMeshLOD LOD;
+            TVector<uint32> LODIndices;
+            float LevelError = 0.0f;
+            
+            for (const FGeometrySurface& Surface : SourceSurfaces)
+            {
+                const uint32* SourceIndices = &MeshResource.Indices[Surface.StartIndex];
+                const size_t TargetIndexCount = glm::max<size_t>((size_t)(Surface.IndexCount * LODTriangleRatio) / 3 * 3, 3);
+                
+                TVector<uint32> Simplified(Surface.IndexCount);
+                float SurfaceError = 0.0f;
+                size_t NumSimplified = meshopt_simplify(Simplified.data(), SourceIndices, Surface.IndexCount, Positions, NumVertices, VertexStride, TargetIndexCount, TargetError, 0, &SurfaceError);
+                
+                // Topology can stall the edge collapser well above the target, drop topology and cluster instead.
+                if (NumSimplified > Surface.IndexCount * MinLODReduction)
+                {
+                    float SloppyError = 0.0f;
+                    TVector<uint32> Sloppy(Surface.IndexCount);
+                    const size_t NumSloppy = meshopt_simplifySloppy(Sloppy.data(), SourceIndices, Surface.IndexCount, Positions, NumVertices, VertexStride, TargetIndexCount, TargetError, &SloppyError);
+                    if (NumSloppy > 0 && NumSloppy < NumSimplified)
+                    {
+                        Simplified = Move(Sloppy);
+                        NumSimplified = NumSloppy;
+                        SurfaceError = SloppyError;
+                    }
+                }
+                
+                // A surface simplified away entirely keeps its previous level rather than disappearing.
+                if (NumSimplified == 0)
+                {
+                    NumSimplified = Surface.IndexCount;
+                    eastl::copy(SourceIndices, SourceIndices + Surface.IndexCount, Simplified.begin());
+                    SurfaceError = 0.0f;
+                }
+                
+                meshopt_optimizeVertexCache(Simplified.data(), Simplified.data(), NumSimplified, NumVertices);
+                
+                FGeometrySurface& LODSurface = LOD.GeometrySurfaces.emplace_back(Surface);
+                LODSurface.StartIndex   = (uint32)(MeshResource.Indices.size() + LODIndices.size());
+                LODSurface.IndexCount   = (uint32)NumSimplified;
+                LODSurface.FirstMeshlet = 0;
+                LODSurface.NumMeshlets  = 0;
+                
+                LODIndices.insert(LODIndices.end(), Simplified.begin(), Simplified.begin() + NumSimplified);
+                LevelError = glm::max(LevelError, SurfaceError);
+            }
+            
+            if (LODIndices.size() > SourceIndexCount * MinLODReduction)
+            {
+                break;
+            }
+            
+            // Levels simplify the previous one, so their errors accumulate along the chain.
+            ChainError += LevelError;
+            LOD.Error = ChainError * MeshScale;
+            
+            LOG_INFO("Mesh {} LOD{}: {} -> {} triangles, error {:.4f}", MeshResource.Name.c_str(), MeshResource.GetNumLODs(), SourceIndexCount / 3, LODIndices.size() / 3, LOD.Error);
+            
+            MeshResource.Indices.insert(MeshResource.Indices.end(), LODIndices.begin(), LODIndices.end());
+            MeshResource.LODs.push_back(Move(LOD));
+        }
+    }
+
     void GenerateShadowBuffers(FMeshResource& MeshResource)
     {
         MeshResource.ShadowIndices = TVector<uint32>(MeshResource.Indices.size());
@@ -31,7 +188,9 @@ namespace Lumina::Import::Mesh
 
     void AnalyzeMeshStatistics(FMeshResource& MeshResource, FMeshStatistics& OutMeshStats)
     {
-        OutMeshStats.VertexFetchStatics.emplace_back(meshopt_analyzeVertexFetch(MeshResource.Indices.data(), MeshResource.Indices.size(), MeshResource.GetNumVertices(), MeshResource.GetVertexTypeSize()));
-        OutMeshStats.OverdrawStatics.emplace_back(meshopt_analyzeOverdraw(MeshResource.Indices.data(), MeshResource.Indices.size(), static_cast<float*>(MeshResource.GetVertexData()), MeshResource.GetNumVertices(), MeshResource.GetVertexTypeSize()));
+        // Only the full detail level, simplified levels follow it in the index buffer.
+        const size_t NumIndices = MeshResource.GetLODNumIndices(0);
+        OutMeshStats.VertexFetchStatics.emplace_back(meshopt_analyzeVertexFetch(MeshResource.Indices.data(), NumIndices, MeshResource.GetNumVertices(), MeshResource.GetVertexTypeSize()));
+        OutMeshStats.OverdrawStatics.emplace_back(meshopt_analyzeOverdraw(MeshResource.Indices.data(), NumIndices, static_cast<float*>(MeshResource.GetVertexData()), MeshResource.GetNumVertices(), MeshResource.GetVertexTypeSize()));
     }
 }
@@ -189,6 +189,16 @@ namespace Lumina::Import::Mesh::OBJ
             OptimizeNewlyImportedMesh(*MeshResource);
         }
         
+        if (ImportOptions.bBuildMeshlets && !MeshResource->IsSkinnedMesh())
+        {
+            BuildMeshlets(*MeshResource);
+        }
+
+        if (ImportOptions.bGenerateLODs)
+        {
+            GenerateMeshLODs(*MeshResource);
+        }
+
         GenerateShadowBuffers(*MeshResource);
         AnalyzeMeshStatistics(*MeshResource, ImportData.MeshStatistics);
         
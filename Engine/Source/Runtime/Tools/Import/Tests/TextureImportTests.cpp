@@ -0,0 +1,306 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Renderer/RendererUtils.h"
+#include "Renderer/RenderResource.h"
+#include "Renderer/TextureData.h"
+#include "Tools/Import/BlockCompression.h"
+#include "Tools/Import/ImportHelpers.h"
+
+namespace Lumina::Automation
+{
+    using namespace Import::Textures;
+
+    namespace
+    {
+        /** Tightly packed RGBA8 image filled by Func(X, Y). */
+        template<typename TFunc>
+        FTextureImportResult MakeImage(uint32 Width, uint32 Height, EFormat Format, TFunc&& Func)
+        {
+            FTextureImportResult Image;
+            Image.Dimensions = glm::uvec2(Width, Height);
+            Image.Format = Format;
+            Image.Pixels.resize((size_t)Width * Height * 4);
+            for (uint32 Y = 0; Y < Height; ++Y)
+            {
+                for (uint32 X = 0; X < Width; ++X)
+                {
+                    const glm::u8vec4 Texel = Func(X, Y);
+                    Memory::Memcpy(&Image.Pixels[((size_t)Y * Width + X) * 4], &Texel, 4);
+                }
+            }
+            return Image;
+        }
+
+        /** Smooth diagonal ramps in every channel, the kind of content block compression is built for. */
+        FTextureImportResult MakeGradient(uint32 Width, uint32 Height, EFormat Format = EFormat::RGBA8_UNORM)
+        {
+            return MakeImage(Width, Height, Format, [&](uint32 X, uint32 Y)
+            {
+                const float U = (float)X / (float)glm::max(Width - 1, 1u);
+                const float V = (float)Y / (float)glm::max(Height - 1, 1u);
+                return glm::u8vec4(glm::vec4(U, V, 1.0f - 0.5f * (U + V), 1.0f) * 255.0f + 0.5f);
+            });
+        }
+
+        /** White noise, no 4 x 4 block of it fits on a line through color space. */
+        FTextureImportResult MakeNoise(uint32 Width, uint32 Height, EFormat Format = EFormat::RGBA8_UNORM)
+        {
+            uint32 State = 0x3C6EF372u;
+            return MakeImage(Width, Height, Format, [&](uint32, uint32)
+            {
+                State = State * 1664525u + 1013904223u;
+                return glm::u8vec4(State >> 24, State >> 16, State >> 8, 255);
+            });
+        }
+
+        FTextureImportOptions MakeOptions(ETextureImportType Type, bool bCompress)
+        {
+            FTextureImportOptions Options;
+            Options.Type = Type;
+            Options.bCompress = bCompress;
+            return Options;
+        }
+
+        glm::u8vec4 GetTexel(const FTextureResource::FMip& Mip, uint32 X, uint32 Y)
+        {
+            glm::u8vec4 Texel;
+            Memory::Memcpy(&Texel, &Mip.Pixels[((size_t)Y * Mip.Width + X) * 4], 4);
+            return Texel;
+        }
+
+        bool IsNear(const glm::u8vec4& Texel, const glm::u8vec4& Expected, int Tolerance)
+        {
+            return glm::all(glm::lessThanEqual(glm::abs(glm::ivec4(Texel) - glm::ivec4(Expected)), glm::ivec4(Tolerance)));
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Import.Texture.CompressedPSNRThresholds")
+    {
+        using namespace Import::Textures::BlockCompression;
+
+        struct FThreshold
+        {
+            EFormat Format;
+            double  MinPSNR;
+        };
+
+        // Smooth content has to stay well above the importer's 30 dB fallback in every format it picks.
+        const FThreshold Thresholds[] =
+        {
+            { EFormat::BC1_UNORM, 32.0 },
+            { EFormat::BC4_UNORM, 40.0 },
+            { EFormat::BC5_UNORM, 40.0 },
+            { EFormat::BC7_UNORM, 38.0 },
+        };
+
+        // A size off the block grid runs the edge repeat as well.
+        for (const glm::uvec2 Size : { glm::uvec2(128, 128), glm::uvec2(130, 126) })
+        {
+            const FTextureImportResult Image = MakeGradient(Size.x, Size.y);
+            const uint32 NumPixels = Size.x * Size.y;
+
+            for (const FThreshold& Threshold : Thresholds)
+            {
+                TEST_CHECK(IsSupported(Threshold.Format));
+
+                TVector<uint8> Blocks, Decompressed;
+                CompressImage(Threshold.Format, Image.Pixels.data(), Size.x, Size.y, Blocks);
+                DecompressImage(Threshold.Format, Blocks.data(), Size.x, Size.y, Decompressed);
+
+                const uint32 NumBlocks = ((Size.x + BlockDim - 1) / BlockDim) * ((Size.y + BlockDim - 1) / BlockDim);
+                TEST_CHECK(Blocks.size() == (size_t)NumBlocks * RHI::Format::BytesPerBlock(Threshold.Format));
+                TEST_CHECK(Decompressed.size() == Image.Pixels.size());
+                TEST_CHECK(ComputePSNR(Threshold.Format, Image.Pixels.data(), Decompressed.data(), NumPixels) >= Threshold.MinPSNR);
+            }
+
+            TEST_CHECK(ComputePSNR(EFormat::BC7_UNORM, Image.Pixels.data(), Image.Pixels.data(), NumPixels) == eastl::numeric_limits<double>::infinity());
+        }
+
+        // Noise is what the threshold exists for, it must land below it.
+        const FTextureImportResult Noise = MakeNoise(64, 64);
+        TVector<uint8> Blocks, Decompressed;
+        CompressImage(EFormat::BC1_UNORM, Noise.Pixels.data(), 64, 64, Blocks);
+        DecompressImage(EFormat::BC1_UNORM, Blocks.data(), 64, 64, Decompressed);
+        TEST_CHECK(ComputePSNR(EFormat::BC1_UNORM, Noise.Pixels.data(), Decompressed.data(), 64 * 64) < FTextureImportOptions().MinCompressedPSNR);
+    }
+
+    LUMINA_AUTOMATION_TEST("Import.Texture.FallsBackBelowMinPSNR")
+    {
+        FTextureResource Resource;
+
+        const FTextureImportResult Gradient = MakeGradient(64, 64, EFormat::SRGBA8_UNORM);
+        TEST_CHECK(BuildTextureMips(Gradient, ETextureImportType::Color, MakeOptions(ETextureImportType::Color, true), Resource));
+        TEST_CHECK(Resource.ImageDescription.Format == EFormat::BC1_UNORM_SRGB);
+
+        const FTextureImportResult Noise = MakeNoise(64, 64, EFormat::SRGBA8_UNORM);
+        TEST_CHECK(BuildTextureMips(Noise, ETextureImportType::Color, MakeOptions(ETextureImportType::Color, true), Resource));
+        TEST_CHECK(Resource.ImageDescription.Format == EFormat::SRGBA8_UNORM);
+        TEST_CHECK(Resource.Mips[0].Pixels == Noise.Pixels);
+
+        // The threshold is the caller's, a strict one rejects even the gradient.
+        FTextureImportOptions Strict = MakeOptions(ETextureImportType::Color, true);
+        Strict.MinCompressedPSNR = 100.0f;
+        TEST_CHECK(BuildTextureMips(Gradient, ETextureImportType::Color, Strict, Resource));
+        TEST_CHECK(Resource.ImageDescription.Format == EFormat::SRGBA8_UNORM);
+        TEST_CHECK(Resource.ImageDescription.NumMips == RenderUtils::CalculateMipCount(64, 64));
+        TEST_CHECK(Resource.Mips.back().Pixels.size() == 4);
+    }
+
+    LUMINA_AUTOMATION_TEST("Import.Texture.MipChainLayout")
+    {
+        const glm::uvec2 Sizes[] = { { 1, 1 }, { 4, 4 }, { 64, 64 }, { 100, 37 }, { 5, 3 }, { 256, 1 } };
+
+        uint32 NumMismatched = 0;
+        for (const glm::uvec2 Size : Sizes)
+        {
+            // Flat so the tiny sizes compress too, a couple of blocks of gradient would fall back and change the format under test.
+            const FTextureImportResult Image = MakeImage(Size.x, Size.y, EFormat::RGBA8_UNORM, [](uint32, uint32) { return glm::u8vec4(90, 160, 40, 255); });
+            for (const bool bCompress : { false, true })
+            {
+                FTextureResource Resource;
+                TEST_CHECK(BuildTextureMips(Image, ETextureImportType::Linear, MakeOptions(ETextureImportType::Linear, bCompress), Resource));
+
+                const FRHIImageDesc& Description = Resource.ImageDescription;
+                const EFormat Expected = bCompress ? EFormat::BC7_UNORM : EFormat::RGBA8_UNORM;
+                NumMismatched += Description.Format != Expected;
+                NumMismatched += Description.Extent != Size;
+                NumMismatched += Description.NumMips != RenderUtils::CalculateMipCount(Size.x, Size.y);
+                NumMismatched += Resource.Mips.size() != Description.NumMips;
+
+                glm::uvec2 MipSize = Size;
+                for (const FTextureResource::FMip& Mip : Resource.Mips)
+                {
+                    const uint32 BlockDim = bCompress ? Import::Textures::BlockCompression::BlockDim : 1;
+                    const uint32 BlocksX = (MipSize.x + BlockDim - 1) / BlockDim;
+                    const uint32 BlocksY = (MipSize.y + BlockDim - 1) / BlockDim;
+
+                    NumMismatched += Mip.Width != MipSize.x || Mip.Height != MipSize.y || Mip.Depth != 1;
+                    NumMismatched += Mip.RowPitch != BlocksX * RHI::Format::BytesPerBlock(Expected);
+                    NumMismatched += Mip.Pixels.size() != (size_t)Mip.RowPitch * BlocksY;
+                    NumMismatched += Mip.SlicePitch != Mip.Pixels.size();
+
+                    MipSize = glm::max(MipSize >> 1u, glm::uvec2(1u));
+                }
+                NumMismatched += Resource.Mips.back().Width != 1 || Resource.Mips.back().Height != 1;
+            }
+        }
+        TEST_CHECK(NumMismatched == 0);
+
+        // Without mips only the top level is stored.
+        FTextureImportOptions NoMips = MakeOptions(ETextureImportType::Linear, false);
+        NoMips.bGenerateMips = false;
+        FTextureResource Resource;
+        TEST_CHECK(BuildTextureMips(MakeGradient(64, 64), ETextureImportType::Linear, NoMips, Resource));
+        TEST_CHECK(Resource.Mips.size() == 1 && Resource.ImageDescription.NumMips == 1);
+    }
+
+    LUMINA_AUTOMATION_TEST("Import.Texture.MipFiltering")
+    {
+        FTextureResource Resource;
+        uint32 NumMismatched = 0;
+
+        // A flat color survives every level, odd sizes included.
+        const glm::u8vec4 Flat(200, 100, 50, 255);
+        TEST_CHECK(BuildTextureMips(MakeImage(37, 23, EFormat::SRGBA8_UNORM, [&](uint32, uint32) { return Flat; }), ETextureImportType::Color, MakeOptions(ETextureImportType::Color, false), Resource));
+        for (const FTextureResource::FMip& Mip : Resource.Mips)
+        {
+            for (uint32 Y = 0; Y < Mip.Height; ++Y)
+            {
+                for (uint32 X = 0; X < Mip.Width; ++X)
+                {
+                    NumMismatched += !IsNear(GetTexel(Mip, X, Y), Flat, 1);
+                }
+            }
+        }
+        TEST_CHECK(NumMismatched == 0);
+
+        // A black and white checker averages to half intensity, in linear space for color and as stored for data.
+        const FTextureImportResult Checker = MakeImage(16, 16, EFormat::RGBA8_UNORM, [](uint32 X, uint32 Y)
+        {
+            return ((X ^ Y) & 1) ? glm::u8vec4(255) : glm::u8vec4(0, 0, 0, 255);
+        });
+
+        struct FExpectedGray
+        {
+            ETextureImportType  Type;
+            uint8               Gray;
+        };
+
+        for (const FExpectedGray& Expected : { FExpectedGray{ ETextureImportType::Color, 188 }, FExpectedGray{ ETextureImportType::Linear, 128 } })
+        {
+            const uint8 Gray = Expected.Gray;
+            TEST_CHECK(BuildTextureMips(Checker, Expected.Type, MakeOptions(Expected.Type, false), Resource));
+            for (uint32 MipIndex = 1; MipIndex < (uint32)Resource.Mips.size(); ++MipIndex)
+            {
+                const FTextureResource::FMip& Mip = Resource.Mips[MipIndex];
+                for (uint32 Y = 0; Y < Mip.Height; ++Y)
+                {
+                    for (uint32 X = 0; X < Mip.Width; ++X)
+                    {
+                        NumMismatched += !IsNear(GetTexel(Mip, X, Y), glm::u8vec4(Gray, Gray, Gray, 255), 1);
+                    }
+                }
+            }
+        }
+        TEST_CHECK(NumMismatched == 0);
+
+        // An odd level weighs all three source texels instead of dropping the last one.
+        const FTextureImportResult Dot = MakeImage(3, 3, EFormat::RGBA8_UNORM, [](uint32 X, uint32 Y)
+        {
+            return (X == 1 && Y == 1) ? glm::u8vec4(255) : glm::u8vec4(0, 0, 0, 255);
+        });
+        TEST_CHECK(BuildTextureMips(Dot, ETextureImportType::Linear, MakeOptions(ETextureImportType::Linear, false), Resource));
+        TEST_CHECK(Resource.Mips.size() == 2);
+        TEST_CHECK(IsNear(GetTexel(Resource.Mips[1], 0, 0), glm::u8vec4(28, 28, 28, 255), 1));
+    }
+
+    LUMINA_AUTOMATION_TEST("Import.Texture.NormalMipsStayUnitLength")
+    {
+        uint32 State = 0x1B873593u;
+        auto Random = [&State](float Min, float Max)
+        {
+            State = State * 1664525u + 1013904223u;
+            return Min + (Max - Min) * static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+        };
+
+        const FTextureImportResult Normals = MakeImage(32, 32, EFormat::RGBA8_UNORM, [&](uint32, uint32)
+        {
+            const glm::vec3 Normal = glm::normalize(glm::vec3(Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(0.2f, 1.0f)));
+            return glm::u8vec4(glm::vec4(Normal * 0.5f + 0.5f, 1.0f) * 255.0f + 0.5f);
+        });
+
+        FTextureResource Resource;
+        TEST_CHECK(BuildTextureMips(Normals, ETextureImportType::NormalMap, MakeOptions(ETextureImportType::NormalMap, false), Resource));
+        TEST_CHECK(Resource.Mips.size() == 6);
+
+        // Averaging random directions alone would shrink them towards zero, renormalized they only carry 8 bit rounding.
+        uint32 NumShortened = 0;
+        for (uint32 MipIndex = 1; MipIndex < (uint32)Resource.Mips.size(); ++MipIndex)
+        {
+            const FTextureResource::FMip& Mip = Resource.Mips[MipIndex];
+            for (uint32 Y = 0; Y < Mip.Height; ++Y)
+            {
+                for (uint32 X = 0; X < Mip.Width; ++X)
+                {
+                    const glm::vec3 Normal = glm::vec3(GetTexel(Mip, X, Y)) / 255.0f * 2.0f - 1.0f;
+                    NumShortened += glm::abs(glm::length(Normal) - 1.0f) > 0.02f;
+                }
+            }
+        }
+        TEST_CHECK(NumShortened == 0);
+
+        // Smoothly bending normals keep X and Y in BC5, the blue channel BC5 drops does not count against them.
+        const FTextureImportResult Bent = MakeImage(64, 64, EFormat::RGBA8_UNORM, [](uint32 X, uint32 Y)
+        {
+            const glm::vec3 Normal = glm::normalize(glm::vec3((float)X / 63.0f - 0.5f, (float)Y / 63.0f - 0.5f, 1.0f));
+            return glm::u8vec4(glm::vec4(Normal * 0.5f + 0.5f, 1.0f) * 255.0f + 0.5f);
+        });
+        TEST_CHECK(BuildTextureMips(Bent, ETextureImportType::NormalMap, MakeOptions(ETextureImportType::NormalMap, true), Resource));
+        TEST_CHECK(Resource.ImageDescription.Format == EFormat::BC5_UNORM);
+    }
+}
+
+#endif
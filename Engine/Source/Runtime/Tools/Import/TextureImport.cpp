@@ -1,9 +1,13 @@
 #include "pch.h"
 
+#include "BlockCompression.h"
 #include "ImportHelpers.h"
 #include "Paths/Paths.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RendererUtils.h"
 #include "Renderer/RenderResource.h"
+#include "Renderer/TextureData.h"
+#include "TaskSystem/TaskSystem.h"
 
 #define STBI_MALLOC(Sz) Lumina::Memory::Malloc(Sz)
 #define STBI_REALLOC(p, newsz) Lumina::Memory::Realloc(p, newsz)
@@ -184,4 +188,395 @@ namespace Lumina::Import::Textures
 
         return ReturnImage;
     }
+
+    namespace
+    {
+        struct FPixelLayout
+        {
+            uint32  NumChannels     = 0;
+            uint32  ComponentBytes  = 0;
+        };
+
+        constexpr FPixelLayout RGBA8Layout = { 4, 1 };
+
+        /** The formats ImportTexture produces, 32 bit components are floats, narrower ones are normalized. */
+        bool GetPixelLayout(EFormat Format, FPixelLayout& OutLayout)
+        {
+            switch (Format)
+            {
+                case EFormat::R8_UNORM:         OutLayout = { 1, 1 }; return true;
+                case EFormat::RG8_UNORM:        OutLayout = { 2, 1 }; return true;
+                case EFormat::RGBA8_UNORM:
+                case EFormat::SRGBA8_UNORM:     OutLayout = { 4, 1 }; return true;
+                case EFormat::R16_UNORM:        OutLayout = { 1, 2 }; return true;
+                case EFormat::RG16_UNORM:       OutLayout = { 2, 2 }; return true;
+                case EFormat::RGBA16_UNORM:     OutLayout = { 4, 2 }; return true;
+                case EFormat::R32_FLOAT:        OutLayout = { 1, 4 }; return true;
+                case EFormat::RG32_FLOAT:       OutLayout = { 2, 4 }; return true;
+                case EFormat::RGB32_FLOAT:      OutLayout = { 3, 4 }; return true;
+                case EFormat::RGBA32_FLOAT:     OutLayout = { 4, 4 }; return true;
+                default:                        return false;
+            }
+        }
+
+        float SRGBToLinear(float Value)
+        {
+            return Value <= 0.04045f ? Value / 12.92f : glm::pow((Value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float LinearToSRGB(float Value)
+        {
+            return Value <= 0.0031308f ? Value * 12.92f : 1.055f * glm::pow(Value, 1.0f / 2.4f) - 0.055f;
+        }
+
+        /** Unpacks stored texels to floats, color moves to linear space and normals to [-1, 1] so the filter averages what they mean. */
+        void DecodeTexels(const uint8* Pixels, glm::uvec2 Size, const FPixelLayout& Layout, ETextureImportType Type, TVector<glm::vec4>& OutTexels)
+        {
+            OutTexels.resize((size_t)Size.x * Size.y);
+
+            Task::ParallelFor(Size.y, [&](uint32 Y)
+            {
+                for (uint32 X = 0; X < Size.x; ++X)
+                {
+                    const size_t Texel = (size_t)Y * Size.x + X;
+                    const uint8* Source = Pixels + Texel * Layout.NumChannels * Layout.ComponentBytes;
+
+                    glm::vec4 Value(0.0f, 0.0f, 0.0f, 1.0f);
+                    for (uint32 Channel = 0; Channel < Layout.NumChannels; ++Channel)
+                    {
+                        const uint8* Component = Source + Channel * Layout.ComponentBytes;
+                        if (Layout.ComponentBytes == 1)
+                        {
+                            Value[Channel] = (float)Component[0] / 255.0f;
+                        }
+                        else if (Layout.ComponentBytes == 2)
+                        {
+                            uint16 Stored;
+                            Memory::Memcpy(&Stored, Component, sizeof(uint16));
+                            Value[Channel] = (float)Stored / 65535.0f;
+                        }
+                        else
+                        {
+                            Memory::Memcpy(&Value[Channel], Component, sizeof(float));
+                        }
+                    }
+
+                    if (Layout.NumChannels >= 3)
+                    {
+                        if (Type == ETextureImportType::Color)
+                        {
+                            Value.r = SRGBToLinear(Value.r);
+                            Value.g = SRGBToLinear(Value.g);
+                            Value.b = SRGBToLinear(Value.b);
+                        }
+                        else if (Type == ETextureImportType::NormalMap)
+                        {
+                            Value = glm::vec4(glm::vec3(Value) * 2.0f - 1.0f, Value.a);
+                        }
+                    }
+
+                    OutTexels[Texel] = Value;
+                }
+            });
+        }
+
+        void EncodeTexels(const TVector<glm::vec4>& Texels, glm::uvec2 Size, const FPixelLayout& Layout, ETextureImportType Type, TVector<uint8>& OutPixels)
+        {
+            OutPixels.resize((size_t)Size.x * Size.y * Layout.NumChannels * Layout.ComponentBytes);
+
+            Task::ParallelFor(Size.y, [&](uint32 Y)
+            {
+                for (uint32 X = 0; X < Size.x; ++X)
+                {
+                    const size_t Texel = (size_t)Y * Size.x + X;
+                    uint8* Destination = OutPixels.data() + Texel * Layout.NumChannels * Layout.ComponentBytes;
+
+                    glm::vec4 Value = Texels[Texel];
+                    if (Layout.NumChannels >= 3)
+                    {
+                        if (Type == ETextureImportType::Color)
+                        {
+                            Value.r = LinearToSRGB(glm::max(Value.r, 0.0f));
+                            Value.g = LinearToSRGB(glm::max(Value.g, 0.0f));
+                            Value.b = LinearToSRGB(glm::max(Value.b, 0.0f));
+                        }
+                        else if (Type == ETextureImportType::NormalMap)
+                        {
+                            Value = glm::vec4(glm::vec3(Value) * 0.5f + 0.5f, Value.a);
+                        }
+                    }
+
+                    for (uint32 Channel = 0; Channel < Layout.NumChannels; ++Channel)
+                    {
+                        uint8* Component = Destination + Channel * Layout.ComponentBytes;
+                        if (Layout.ComponentBytes == 1)
+                        {
+                            Component[0] = (uint8)(glm::clamp(Value[Channel], 0.0f, 1.0f) * 255.0f + 0.5f);
+                        }
+                        else if (Layout.ComponentBytes == 2)
+                        {
+                            const uint16 Stored = (uint16)(glm::clamp(Value[Channel], 0.0f, 1.0f) * 65535.0f + 0.5f);
+                            Memory::Memcpy(Component, &Stored, sizeof(uint16));
+                        }
+                        else
+                        {
+                            Memory::Memcpy(Component, &Value[Channel], sizeof(float));
+                        }
+                    }
+                }
+            });
+        }
+
+        struct FFilterTap
+        {
+            uint32  Index;
+            float   Weight;
+        };
+
+        /**
+         * Source texels each destination texel covers along one axis, weighted by how much of them it covers.
+         * Even sizes reduce to a plain 2 tap box, odd sizes get 3 taps instead of dropping or shifting the last texel.
+         */
+        void BuildFilterTaps(uint32 SourceSize, uint32 DestSize, TVector<uint32>& OutOffsets, TVector<FFilterTap>& OutTaps)
+        {
+            const float Scale = (float)SourceSize / (float)DestSize;
+
+            OutOffsets.resize(DestSize + 1);
+            OutTaps.clear();
+            for (uint32 Dest = 0; Dest < DestSize; ++Dest)
+            {
+                OutOffsets[Dest] = (uint32)OutTaps.size();
+
+                const float Start = (float)Dest * Scale;
+                const float End = (float)(Dest + 1) * Scale;
+                for (uint32 Source = (uint32)Start; Source < SourceSize && (float)Source < End; ++Source)
+                {
+                    const float Coverage = glm::min(End, (float)(Source + 1)) - glm::max(Start, (float)Source);
+                    if (Coverage > 0.0f)
+                    {
+                        OutTaps.push_back({ Source, Coverage / Scale });
+                    }
+                }
+            }
+            OutOffsets[DestSize] = (uint32)OutTaps.size();
+        }
+
+        void Downsample(const TVector<glm::vec4>& Source, glm::uvec2 SourceSize, glm::uvec2 DestSize, ETextureImportType Type, TVector<glm::vec4>& OutDest)
+        {
+            TVector<uint32> OffsetsX, OffsetsY;
+            TVector<FFilterTap> TapsX, TapsY;
+            BuildFilterTaps(SourceSize.x, DestSize.x, OffsetsX, TapsX);
+            BuildFilterTaps(SourceSize.y, DestSize.y, OffsetsY, TapsY);
+
+            OutDest.resize((size_t)DestSize.x * DestSize.y);
+
+            Task::ParallelFor(DestSize.y, [&](uint32 Y)
+            {
+                for (uint32 X = 0; X < DestSize.x; ++X)
+                {
+                    glm::vec4 Sum(0.0f);
+                    for (uint32 TapY = OffsetsY[Y]; TapY < OffsetsY[Y + 1]; ++TapY)
+                    {
+                        const glm::vec4* Row = &Source[(size_t)TapsY[TapY].Index * SourceSize.x];
+                        for (uint32 TapX = OffsetsX[X]; TapX < OffsetsX[X + 1]; ++TapX)
+                        {
+                            Sum += Row[TapsX[TapX].Index] * (TapsX[TapX].Weight * TapsY[TapY].Weight);
+                        }
+                    }
+
+                    // Averaged normals shorten where the surface bends, keep them unit length so lighting does not darken with distance.
+                    if (Type == ETextureImportType::NormalMap)
+                    {
+                        const float Length = glm::length(glm::vec3(Sum));
+                        const glm::vec3 Normal = Length > 1e-6f ? glm::vec3(Sum) / Length : glm::vec3(0.0f, 0.0f, 1.0f);
+                        Sum = glm::vec4(Normal, Sum.a);
+                    }
+
+                    OutDest[(size_t)Y * DestSize.x + X] = Sum;
+                }
+            });
+        }
+
+        bool HasTranslucentTexels(const FTextureImportResult& Image)
+        {
+            for (size_t i = 3; i < Image.Pixels.size(); i += 4)
+            {
+                if (Image.Pixels[i] != 255)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Opaque color fits BC1 at half the size of BC7, packed masks go to BC7 so their channels do not bleed into each other.
+         * Two channel images stay uncompressed, BC5 is kept for normal maps whose blue the material rebuilds.
+         */
+        EFormat SelectCompressedFormat(const FTextureImportResult& Image, ETextureImportType Type, const FTextureImportOptions& Options)
+        {
+            if (Image.Format == EFormat::R8_UNORM)
+            {
+                return EFormat::BC4_UNORM;
+            }
+
+            if (Image.Format != EFormat::RGBA8_UNORM && Image.Format != EFormat::SRGBA8_UNORM)
+            {
+                return Image.Format;
+            }
+
+            const bool bSRGB = RHI::Format::Info(Image.Format).bIsSRGB;
+            switch (Type)
+            {
+                case ETextureImportType::NormalMap:     return Options.bTwoChannelNormals ? EFormat::BC5_UNORM : EFormat::BC7_UNORM;
+                case ETextureImportType::Grayscale:     return EFormat::BC4_UNORM;
+                case ETextureImportType::Linear:        return EFormat::BC7_UNORM;
+                default:
+                    if (HasTranslucentTexels(Image))
+                    {
+                        return bSRGB ? EFormat::BC7_UNORM_SRGB : EFormat::BC7_UNORM;
+                    }
+                    return bSRGB ? EFormat::BC1_UNORM_SRGB : EFormat::BC1_UNORM;
+            }
+        }
+    }
+
+    ETextureImportType ResolveTextureType(FStringView RawFilePath, const FTextureImportResult& Image, ETextureImportType Requested)
+    {
+        if (Requested != ETextureImportType::Auto)
+        {
+            return Requested;
+        }
+
+        FPixelLayout Layout;
+        if (GetPixelLayout(Image.Format, Layout) && Layout.NumChannels == 1)
+        {
+            return ETextureImportType::Grayscale;
+        }
+
+        FString Name(VFS::FileName(RawFilePath, true));
+        Name.make_lower();
+
+        auto Contains = [&](const char* Token) { return Name.find(Token) != FString::npos; };
+        auto EndsWith = [&](const char* Token)
+        {
+            const size_t Length = strlen(Token);
+            return Name.length() >= Length && Name.compare(Name.length() - Length, Length, Token) == 0;
+        };
+
+        if (Contains("normal") || Contains("_nrm") || EndsWith("_n"))
+        {
+            return ETextureImportType::NormalMap;
+        }
+
+        if (Contains("rough") || Contains("metal") || Contains("occlusion") || Contains("_orm") || Contains("_ao") || Contains("mask") || Contains("height"))
+        {
+            return ETextureImportType::Linear;
+        }
+
+        return ETextureImportType::Color;
+    }
+
+    bool BuildTextureMips(const FTextureImportResult& Image, ETextureImportType Type, const FTextureImportOptions& Options, FTextureResource& OutResource)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        FPixelLayout Layout;
+        if (!GetPixelLayout(Image.Format, Layout))
+        {
+            LOG_WARN("Unsupported texture format for mip generation: {0}", RHI::Format::Info(Image.Format).Name);
+            return false;
+        }
+
+        // Normals need all three components to decode, anything narrower is filtered as plain data.
+        if (Type == ETextureImportType::NormalMap && Layout.NumChannels < 3)
+        {
+            Type = ETextureImportType::Linear;
+        }
+
+        const uint32 NumMips = Options.bGenerateMips ? RenderUtils::CalculateMipCount(Image.Dimensions.x, Image.Dimensions.y) : 1;
+        EFormat Format = Options.bCompress ? SelectCompressedFormat(Image, Type, Options) : Image.Format;
+
+        OutResource.Mips.clear();
+        OutResource.Mips.resize(NumMips);
+
+        TVector<glm::vec4> Level, NextLevel;
+        DecodeTexels(Image.Pixels.data(), Image.Dimensions, Layout, Type, Level);
+
+        TVector<uint8> Uncompressed, Decompressed;
+        double WorstPSNR = eastl::numeric_limits<double>::infinity();
+        glm::uvec2 Size = Image.Dimensions;
+
+        for (uint32 MipIndex = 0; MipIndex < NumMips; ++MipIndex)
+        {
+            LUMINA_PROFILE_SECTION("Process Mip");
+
+            if (MipIndex > 0)
+            {
+                const glm::uvec2 NextSize = glm::max(Size >> 1u, glm::uvec2(1u));
+                Downsample(Level, Size, NextSize, Type, NextLevel);
+                eastl::swap(Level, NextLevel);
+                Size = NextSize;
+            }
+
+            FTextureResource::FMip& Mip = OutResource.Mips[MipIndex];
+            Mip.Width   = Size.x;
+            Mip.Height  = Size.y;
+            Mip.Depth   = 1;
+
+            bool bCompressed = false;
+            if (Format != Image.Format)
+            {
+                EncodeTexels(Level, Size, RGBA8Layout, Type, Uncompressed);
+                BlockCompression::CompressImage(Format, Uncompressed.data(), Size.x, Size.y, Mip.Pixels);
+                BlockCompression::DecompressImage(Format, Mip.Pixels.data(), Size.x, Size.y, Decompressed);
+
+                const double PSNR = BlockCompression::ComputePSNR(Format, Uncompressed.data(), Decompressed.data(), Size.x * Size.y);
+                if (MipIndex == 0 && PSNR < Options.MinCompressedPSNR)
+                {
+                    LOG_WARN("{0} loses too much detail ({1:.2f} dB), storing the texture uncompressed", RHI::Format::Info(Format).Name, PSNR);
+                    Format = Image.Format;
+                }
+                else
+                {
+                    WorstPSNR = glm::min(WorstPSNR, PSNR);
+                    Mip.RowPitch = ((Size.x + BlockCompression::BlockDim - 1) / BlockCompression::BlockDim) * RHI::Format::BytesPerBlock(Format);
+                    bCompressed = true;
+                }
+            }
+
+            if (!bCompressed)
+            {
+                EncodeTexels(Level, Size, Layout, Type, Mip.Pixels);
+                Mip.RowPitch = Size.x * RHI::Format::BytesPerBlock(Format);
+            }
+
+            Mip.SlicePitch = (uint32)Mip.Pixels.size();
+        }
+
+        OutResource.ImageDescription.Format     = Format;
+        OutResource.ImageDescription.Extent     = Image.Dimensions;
+        OutResource.ImageDescription.NumMips    = (uint8)NumMips;
+
+        if (Format != Image.Format)
+        {
+            LOG_INFO("Texture {0}x{1}: {2} mips as {3}, worst mip PSNR {4:.2f} dB", Image.Dimensions.x, Image.Dimensions.y, NumMips, RHI::Format::Info(Format).Name, WorstPSNR);
+        }
+
+        return true;
+    }
+
+    void ConvertToRGBA8(const FTextureImportResult& Image, TVector<uint8>& OutPixels)
+    {
+        FPixelLayout Layout;
+        if (!GetPixelLayout(Image.Format, Layout))
+        {
+            OutPixels.assign((size_t)Image.Dimensions.x * Image.Dimensions.y * 4, 0);
+            return;
+        }
+
+        TVector<glm::vec4> Texels;
+        DecodeTexels(Image.Pixels.data(), Image.Dimensions, Layout, ETextureImportType::Linear, Texels);
+        EncodeTexels(Texels, Image.Dimensions, RGBA8Layout, ETextureImportType::Linear, OutPixels);
+    }
 }
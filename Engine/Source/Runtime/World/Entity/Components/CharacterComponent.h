@@ -8,7 +8,7 @@
 
 namespace Lumina
 {
-    REFLECT(Component)
+    REFLECT(Component, NonCloneable)
     struct RUNTIME_API SCharacterPhysicsComponent
     {
         GENERATED_BODY()
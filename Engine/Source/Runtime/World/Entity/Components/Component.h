@@ -4,8 +4,10 @@
 #include "Core/Engine/Engine.h"
 #include "Core/Object/Class.h"
 #include "Core/Serialization/Archiver.h"
+#include "Scripting/Lua/ComponentAccessors.h"
 #include "Traits/ComponentTraits.h"
 #include "World/Entity/Traits.h"
+#include "World/Entity/Registry/EntityRegistry.h"
 
 namespace Lumina
 {
@@ -58,6 +60,33 @@ namespace Lumina
             Struct->SerializeTaggedProperties(Ar, &Instance);
         }
         
+        /** Copies an entire storage into another registry, keeping named storages (tags) under their original ID. */
+        template<typename TComponent>
+        void CloneStorage(entt::registry& Registry, entt::sparse_set& Source, entt::id_type StorageID, const FEntityRemap& Remap)
+        {
+            auto& SourceStorage = static_cast<entt::storage_for_t<TComponent>&>(Source);
+            auto& Storage = Registry.storage<TComponent>(StorageID);
+            Storage.reserve(Storage.size() + SourceStorage.size());
+            
+            for (entt::entity Entity : static_cast<entt::sparse_set&>(SourceStorage))
+            {
+                entt::entity To = Remap(Entity);
+                if (To == entt::null || Storage.contains(To))
+                {
+                    continue;
+                }
+                
+                if constexpr (entt::component_traits<TComponent>::page_size == 0u)
+                {
+                    Storage.emplace(To);
+                }
+                else
+                {
+                    Storage.emplace(To, SourceStorage.get(Entity));
+                }
+            }
+        }
+        
         template<typename TComponent>
         CStruct* GetStructType()
         {
@@ -215,6 +244,22 @@ namespace Lumina
             Dispatcher.enqueue(Event.as<TEvent>());
         }
         
+        /** Publishes the typed accessors of TComponent to State, the generated Lua registration calls this after new_usertype. */
+        template<typename TComponent>
+        void RegisterComponentAccessorsLua(sol::state_view State)
+        {
+            static const Scripting::FComponentAccessor Accessor
+            {
+                entt::hashed_string(TComponent::StaticStruct()->GetName().c_str()),
+                entt::type_hash<TComponent>::value(),
+                &HasComponent<TComponent>,
+                &GetComponentLua<TComponent>,
+                &TryGetComponentLua<TComponent>,
+            };
+            
+            Scripting::AddComponentAccessor(State, TComponent::StaticStruct()->GetName().c_str(), &Accessor);
+        }
+        
         // End lua variants
         
         template<typename TComponent>
@@ -232,7 +277,8 @@ namespace Lumina
             .template func<&ClearComponent<TComponent>>("clear"_hs)
             .template func<&EmplaceComponent<TComponent>>("emplace"_hs)
             .template func<&PatchComponent<TComponent>>("patch"_hs)
-            .template func<&Serialize<TComponent>>("serialize"_hs);
+            .template func<&Serialize<TComponent>>("serialize"_hs)
+            .template func<&CloneStorage<TComponent>>("clone_storage"_hs);
             
             Meta.template func<&PatchComponentLua<TComponent>>("patch_lua"_hs)
             .template func<&EmplaceComponentLua<TComponent>>("emplace_lua"_hs)
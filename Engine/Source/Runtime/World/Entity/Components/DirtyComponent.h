@@ -10,6 +10,9 @@ namespace Lumina
     {
         EMoveMode MoveMode = EMoveMode::Teleport;
         bool bActivate = true;
+        
+        /** Set when physics wrote the transform from its own body, pushing it back would wake or stop the body for nothing. */
+        bool bFromPhysics = false;
     };
     
     struct RUNTIME_API FNeedsPhysicsBodyUpdate
@@ -1,11 +1,14 @@
 ﻿#pragma once
 
+#include "Core/Object/ObjectHandleTyped.h"
 #include "Core/Object/ObjectMacros.h"
 #include "Physics/PhysicsTypes.h"
 #include "PhysicsComponent.generated.h"
 
 namespace Lumina
 {
+    class CStaticMesh;
+    
     REFLECT(Component)
     struct RUNTIME_API SRigidBodyComponent
     {
@@ -53,5 +56,25 @@ namespace Lumina
         PROPERTY(Editable)
         glm::vec3 Offset;
     };
+
+    /** Collides against the mesh's triangles. Triangle meshes cannot simulate, dynamic bodies are made kinematic. */
+    REFLECT(Component)
+    struct RUNTIME_API SMeshColliderComponent
+    {
+        GENERATED_BODY()
+
+        PROPERTY(Editable)
+        TObjectPtr<CStaticMesh> Mesh;
+    };
+
+    /** Collides against the convex hull of the mesh's vertices. */
+    REFLECT(Component)
+    struct RUNTIME_API SConvexHullColliderComponent
+    {
+        GENERATED_BODY()
+
+        PROPERTY(Editable)
+        TObjectPtr<CStaticMesh> Mesh;
+    };
     
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ namespace Lumina
         {
             if (Script && Script->ScriptTable.valid())
             {
+                Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
                 if (sol::optional<sol::function> ScriptFunc = Script->ScriptTable[Name.data()])
                 {
                     sol::protected_function_result Result = (*ScriptFunc)(Script->ScriptTable, Forward<TArgs>(Args)...);
@@ -33,5 +33,9 @@ namespace Lumina
 
         PROPERTY(Editable, Category = "Shadow")
         bool bReceiveShadow = true;
+
+        /** Always rasterized into the software occlusion buffer, regardless of its screen size or triangle count. */
+        PROPERTY(Editable, Category = "Culling")
+        bool bOccluder = false;
     };
 }
@@ -9,6 +9,8 @@
 #include "components/tagcomponent.h"
 #include "Components/TransformComponent.h"
 #include "Core/Object/Class.h"
+#include "Core/Serialization/MemoryArchiver.h"
+#include "Core/Serialization/ObjectArchiver.h"
 
 using namespace entt::literals; 
 
@@ -249,6 +251,91 @@ namespace Lumina::ECS::Utils
         return !Ar.HasError();
     }
     
+    bool CloneRegistry(FEntityRegistry& Source, FEntityRegistry& Destination)
+    {
+        LUMINA_PROFILE_SCOPE();
+        using namespace entt::literals;
+
+        FEntityRemap Remap;
+        
+        auto View = Source.view<entt::entity>(entt::exclude<FEditorComponent, FSingletonEntityTag>);
+        View.each([&](entt::entity Entity)
+        {
+            // Keep the original identifier when it's free, so handles held by scripts and systems remain meaningful.
+            Remap.Add(Entity, Destination.create(Entity));
+        });
+
+        for (auto&& [ID, Storage] : Source.storage())
+        {
+            entt::meta_type MetaType = entt::resolve(Storage.info());
+            if (!MetaType)
+            {
+                continue;
+            }
+            
+            entt::meta_any ReturnValue = InvokeMetaFunc(MetaType, "static_struct"_hs);
+            if (!ReturnValue)
+            {
+                continue;
+            }
+            
+            CStruct* StructType = ReturnValue.cast<CStruct*>();
+            ASSERT(StructType);
+            
+            if (!StructType->HasMeta("NonCloneable"))
+            {
+                InvokeMetaFunc(MetaType, "clone_storage"_hs, entt::forward_as_meta(Destination), entt::forward_as_meta(Storage), ID, entt::forward_as_meta(Remap));
+                continue;
+            }
+            
+            for (entt::entity Entity : Storage)
+            {
+                entt::entity To = Remap(Entity);
+                if (To == entt::null)
+                {
+                    continue;
+                }
+                
+                TVector<uint8> Data;
+                FMemoryWriter Writer(Data);
+                FObjectProxyArchiver WriterProxy(Writer, true);
+                StructType->SerializeTaggedProperties(WriterProxy, Storage.value(Entity));
+                
+                FMemoryReader Reader(Data);
+                FObjectProxyArchiver ReaderProxy(Reader, true);
+                FArchive& ReaderAr = ReaderProxy;
+                
+                entt::meta_any Any = MetaType.construct();
+                InvokeMetaFunc(MetaType, "serialize"_hs, entt::forward_as_meta(ReaderAr), entt::forward_as_meta(Any));
+                InvokeMetaFunc(MetaType, "emplace"_hs, entt::forward_as_meta(Destination), To, entt::forward_as_meta(Any));
+            }
+        }
+        
+        auto RelationshipView = Source.view<FRelationshipComponent>(entt::exclude<FEditorComponent, FSingletonEntityTag>);
+        RelationshipView.each([&](entt::entity Entity, const FRelationshipComponent& Relationship)
+        {
+            FRelationshipComponent& NewRelationship = Destination.emplace<FRelationshipComponent>(Remap(Entity));
+            NewRelationship.Children    = Relationship.Children;
+            NewRelationship.First       = Remap(Relationship.First);
+            NewRelationship.Prev        = Remap(Relationship.Prev);
+            NewRelationship.Next        = Remap(Relationship.Next);
+            NewRelationship.Parent      = Remap(Relationship.Parent);
+        });
+        
+        // Script instances belong to the source world, the destination loads its own when initialized.
+        Destination.view<SScriptComponent>().each([](SScriptComponent& ScriptComponent)
+        {
+            ScriptComponent.Script.reset();
+        });
+        
+        Destination.view<entt::entity>().each([&](entt::entity Entity)
+        {
+            Destination.emplace_or_replace<FNeedsTransformUpdate>(Entity);
+        });
+        
+        return true;
+    }
+    
     bool EntityHasTag(const FName& Tag, FEntityRegistry& Registry, entt::entity Entity)
     {
         return Registry.storage<STagComponent>(entt::hashed_string(Tag.c_str())).contains(Entity);
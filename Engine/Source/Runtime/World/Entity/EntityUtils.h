@@ -12,6 +12,14 @@ namespace Lumina::ECS::Utils
 {
     RUNTIME_API bool SerializeEntity(FArchive& Ar, FEntityRegistry& Registry, entt::entity& Entity);
     RUNTIME_API bool SerializeRegistry(FArchive& Ar, FEntityRegistry& Registry);
+    
+    /**
+     * Copies every serializable entity of Source into Destination by cloning component storages directly.
+     * Editor and singleton entities are skipped, relationships are remapped, and components marked NonCloneable
+     * fall back to a tagged property round trip.
+     */
+    RUNTIME_API bool CloneRegistry(FEntityRegistry& Source, FEntityRegistry& Destination);
+    
     RUNTIME_API bool EntityHasTag(const FName& Tag, FEntityRegistry& Registry, entt::entity Entity);
     RUNTIME_API void ReparentEntity(FEntityRegistry& Registry, entt::entity Child, entt::entity Parent);
     RUNTIME_API void DestroyEntityHierarchy(FEntityRegistry& Registry, entt::entity Entity);
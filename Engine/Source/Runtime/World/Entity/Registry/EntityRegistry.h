@@ -1,8 +1,37 @@
 ﻿#pragma once
 
 #include <entt/entt.hpp>
+#include "Containers/Array.h"
 
 namespace Lumina
 {
     using FEntityRegistry = entt::registry;
+
+    /** Maps entities of a source registry to their counterparts in a cloned registry, indexed by entity slot. */
+    struct FEntityRemap
+    {
+        void Add(entt::entity From, entt::entity To)
+        {
+            const auto Index = entt::to_entity(From);
+            if (Index >= Table.size())
+            {
+                Table.resize(Index + 1, entt::null);
+            }
+
+            Table[Index] = To;
+        }
+
+        entt::entity operator()(entt::entity From) const
+        {
+            if (From == entt::null)
+            {
+                return entt::null;
+            }
+
+            const auto Index = entt::to_entity(From);
+            return Index < Table.size() ? Table[Index] : entt::null;
+        }
+
+        TVector<entt::entity> Table;
+    };
 }
@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "EntitySystem.h"
+#include "World/Entity/Components/CameraComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
 #include "CameraSystem.generated.h"
 
 namespace Lumina
@@ -9,6 +11,7 @@ namespace Lumina
     {
         GENERATED_BODY()
         ENTITY_SYSTEM(RequiresUpdate(EUpdateStage::PostPhysics), RequiresUpdate(EUpdateStage::Paused))
+        SYSTEM_ACCESS(Reads<STransformComponent>{}, Writes<SCameraComponent>{})
 
         static void Startup(const FSystemContext& Context) noexcept;
         static void Update(const FSystemContext& Context) noexcept;
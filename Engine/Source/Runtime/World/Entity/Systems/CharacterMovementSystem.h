@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include "EntitySystem.h"
+#include "World/Entity/Components/CharacterComponent.h"
+#include "World/Entity/Components/CharacterControllerComponent.h"
 #include "CharacterMovementSystem.generated.h"
 
 namespace Lumina
@@ -10,6 +12,7 @@ namespace Lumina
     {
         GENERATED_BODY()
         ENTITY_SYSTEM(RequiresUpdate(EUpdateStage::PrePhysics, EUpdatePriority::Highest))
+        SYSTEM_ACCESS(Reads<SCharacterPhysicsComponent>{}, Writes<SCharacterControllerComponent, SCharacterMovementComponent>{})
         
     public:
         
@@ -7,11 +7,63 @@ namespace Lumina
 {
     using namespace entt::literals;
 
+    namespace
+    {
+        const FSystemAccess GExclusiveSystemAccess;
+
+        bool Overlaps(const TVector<entt::id_type>& A, const TVector<entt::id_type>& B)
+        {
+            for (entt::id_type ID : A)
+            {
+                if (eastl::find(B.begin(), B.end(), ID) != B.end())
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    bool FSystemAccess::ConflictsWith(const FSystemAccess& Other) const
+    {
+        if (bExclusive || Other.bExclusive)
+        {
+            return true;
+        }
+
+        return Overlaps(WriteSet, Other.WriteSet) || Overlaps(WriteSet, Other.ReadSet) || Overlaps(ReadSet, Other.WriteSet);
+    }
+
+    void FSystemAccess::AssureStorages(entt::registry& Registry) const
+    {
+        for (FAssureStorageFunc Func : AssureFuncs)
+        {
+            Func(Registry);
+        }
+    }
+
     const FUpdatePriorityList& FEntitySystemWrapper::GetUpdatePriorityList() const
     {
         return Underlying.data("PriorityList"_hs).get(Instance).cast<const FUpdatePriorityList&>();
     }
 
+    const FSystemAccess& FEntitySystemWrapper::GetSystemAccess() const
+    {
+        entt::meta_data Data = Underlying.data("Access"_hs);
+        if (!Data)
+        {
+            return GExclusiveSystemAccess;
+        }
+        
+        return Data.get(Instance).cast<const FSystemAccess&>();
+    }
+
+    const char* FEntitySystemWrapper::GetName() const
+    {
+        return Underlying.name() ? Underlying.name() : "Unknown";
+    }
+
     void FEntitySystemWrapper::Startup(const FSystemContext& SystemContext) const noexcept
     {
         ECS::Utils::InvokeMetaFunc(Underlying, "Startup"_hs, entt::forward_as_meta(SystemContext));
@@ -42,6 +94,17 @@ namespace Lumina
         return (uint64)WeakScript.lock().get();
     }
 
+    const FSystemAccess& FEntityScriptSystem::GetSystemAccess() const
+    {
+        // Scripts can reach any component through the context, so they never share a wave.
+        return GExclusiveSystemAccess;
+    }
+
+    const char* FEntityScriptSystem::GetName() const
+    {
+        return "Script System";
+    }
+
     FUpdatePriorityList FEntityScriptSystem::GetUpdatePriorityList() const
     {
         if (const TSharedPtr<Scripting::FLuaScript>& Script = WeakScript.lock())
@@ -58,6 +121,7 @@ namespace Lumina
     {
         if (const TSharedPtr<Scripting::FLuaScript>& Script = WeakScript.lock())
         {
+            Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
             Script->ScriptTable["Startup"](std::ref(SystemContext));
         }
     }
@@ -68,6 +132,7 @@ namespace Lumina
         
         if (const TSharedPtr<Scripting::FLuaScript>& Script = WeakScript.lock())
         {
+            Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
             Script->ScriptTable["Update"](std::ref(SystemContext));
         }
     }
@@ -76,6 +141,7 @@ namespace Lumina
     {
         if (const TSharedPtr<Scripting::FLuaScript>& Script = WeakScript.lock())
         {
+            Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
             Script->ScriptTable["Teardown"](std::ref(SystemContext));
         }
     }
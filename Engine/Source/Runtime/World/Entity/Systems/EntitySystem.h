@@ -12,6 +12,69 @@ namespace Lumina
 #define ENTITY_SYSTEM( ... )\
 FUpdatePriorityList PriorityList = FUpdatePriorityList(__VA_ARGS__);
 
+/** Declares the component storages a system touches in Update, e.g. SYSTEM_ACCESS(Reads<A>{}, Writes<B, C>{}). */
+#define SYSTEM_ACCESS( ... )\
+FSystemAccess Access = FSystemAccess(__VA_ARGS__);
+
+    template<typename... TComponents>
+    struct Reads {};
+
+    template<typename... TComponents>
+    struct Writes {};
+
+    /**
+     * The component storages a system reads and writes during Update. Systems of the same stage whose
+     * accesses don't overlap are run concurrently, a system without a declaration is exclusive.
+     */
+    struct RUNTIME_API FSystemAccess
+    {
+        using FAssureStorageFunc = void(*)(entt::registry&);
+
+        FSystemAccess() = default;
+
+        template<typename... TReads, typename... TWrites>
+        FSystemAccess(Reads<TReads...>, Writes<TWrites...> = {})
+            : bExclusive(false)
+        {
+            (AddRead<TReads>(), ...);
+            (AddWrite<TWrites>(), ...);
+        }
+
+        template<typename... TWrites>
+        FSystemAccess(Writes<TWrites...>)
+            : bExclusive(false)
+        {
+            (AddWrite<TWrites>(), ...);
+        }
+
+        /** Read/write or write/write overlap, systems that conflict keep their priority order. */
+        bool ConflictsWith(const FSystemAccess& Other) const;
+
+        /** Creates every declared storage up front, views created concurrently must never grow the registry. */
+        void AssureStorages(entt::registry& Registry) const;
+        
+        TVector<entt::id_type>      ReadSet;
+        TVector<entt::id_type>      WriteSet;
+        TVector<FAssureStorageFunc> AssureFuncs;
+        bool                        bExclusive = true;
+
+    private:
+
+        template<typename T>
+        void AddRead()
+        {
+            ReadSet.push_back(entt::type_hash<T>::value());
+            AssureFuncs.push_back([](entt::registry& Registry) { (void)Registry.storage<T>(); });
+        }
+
+        template<typename T>
+        void AddWrite()
+        {
+            WriteSet.push_back(entt::type_hash<T>::value());
+            AssureFuncs.push_back([](entt::registry& Registry) { (void)Registry.storage<T>(); });
+        }
+    };
+
     namespace Meta
     {
         template<typename TSystem>
@@ -44,6 +107,12 @@ FUpdatePriorityList PriorityList = FUpdatePriorityList(__VA_ARGS__);
             { Sys.Teardown(Context) } noexcept -> std::same_as<void>;
         };
     
+        template<typename TSystem>
+        concept HasSystemAccess = requires(TSystem Sys)
+        {
+            { Sys.Access } -> std::convertible_to<const FSystemAccess&>;
+        };
+    
         template<typename TSystem>
         concept IsSystem = HasStartup<TSystem> || HasUpdate<TSystem> || HasTeardown<TSystem> || HasBeginPlay<TSystem> || HasEndPlay<TSystem>;
     
@@ -55,6 +124,11 @@ FUpdatePriorityList PriorityList = FUpdatePriorityList(__VA_ARGS__);
                 .type(TSystem::StaticStruct()->GetName().c_str())
                 .traits(ECS::ETraits::System)
                 .template data<&TSystem::PriorityList, entt::as_is_t>("PriorityList"_hs);
+
+            if constexpr (HasSystemAccess<TSystem>)
+            {
+                Meta.template data<&TSystem::Access, entt::as_is_t>("Access"_hs);
+            }
         
             if constexpr (HasStartup<TSystem>)
             {
@@ -88,6 +162,8 @@ FUpdatePriorityList PriorityList = FUpdatePriorityList(__VA_ARGS__);
         friend class CWorld;
         
         const FUpdatePriorityList& GetUpdatePriorityList() const;
+        const FSystemAccess& GetSystemAccess() const;
+        const char* GetName() const;
         void Startup(const FSystemContext& SystemContext) const noexcept;
         void Update(const FSystemContext& SystemContext) const noexcept;
         void Teardown(const FSystemContext& SystemContext) const noexcept;
@@ -103,6 +179,8 @@ FUpdatePriorityList PriorityList = FUpdatePriorityList(__VA_ARGS__);
         friend class CWorld;
         
         FUpdatePriorityList GetUpdatePriorityList() const;
+        const FSystemAccess& GetSystemAccess() const;
+        const char* GetName() const;
         void Startup(const FSystemContext& SystemContext) const noexcept;
         void Update(const FSystemContext& SystemContext) const noexcept;
         void Teardown(const FSystemContext& SystemContext) const noexcept;
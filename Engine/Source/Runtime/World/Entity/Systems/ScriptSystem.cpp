@@ -1,6 +1,8 @@
 ﻿#include "pch.h"
 #include "ScriptSystem.h"
 
+#include "Core/Console/ConsoleVariable.h"
+#include "Scripting/Lua/Scripting.h"
 #include "World/World.h"
 #include "World/Entity/Components/ScriptComponent.h"
 #include "World/Entity/Events/WorldEvents.h"
@@ -8,33 +10,348 @@
 
 namespace Lumina
 {
-    void SScriptSystem::Update(const FSystemContext& Context) noexcept
+    static TConsoleVar CVarBatchedScriptUpdate("Script.BatchedUpdate", true, "Updates scripts grouped by source file with one Lua call per group, instead of one call per entity.");
+    static TConsoleVar CVarParallelScriptUpdate("Script.ParallelUpdate", false, "Runs Update of scripts returning ThreadSafe = true on a pool of Lua states, one per task worker. Requires Script.BatchedUpdate.");
+
+    namespace
     {
-        LUMINA_PROFILE_SCOPE(); 
+        /** Walks a whole group on the Lua side, the only C++ to Lua transition is once per group. */
+        constexpr const char* BatchUpdateChunk = R"(
+            local pcall = pcall
+            return function(Functions, Tables, Count, DeltaTime, Errors)
+                local NumErrors = 0
+                for i = 1, Count do
+                    local Ok, Error = pcall(Functions[i], Tables[i], DeltaTime)
+                    if not Ok then
+                        NumErrors = NumErrors + 1
+                        Errors[NumErrors] = Error
+                    end
+                end
+                return NumErrors
+            end
+        )";
+
+        struct FScriptUpdateGroup
+        {
+            FString     Path;
+            uint32      MemoryOwner = 0;
+            sol::table  Functions;
+            sol::table  Tables;
+            uint32      Num = 0;
+        };
+
+        /**
+         * The instance of a thread safe script one worker state updates. Only Update runs there, everything else keeps using
+         * the main state instance, which stays authoritative: its plain values are copied in before every parallel update and
+         * copied back once it is done. Tables, functions and userdata cannot cross states, a thread safe script should keep
+         * such fields constant or confined to Update.
+         */
+        struct FWorkerScriptInstance
+        {
+            const Scripting::FLuaScript*    Script = nullptr;
+            uint32                          Version = 0;
+            sol::table                      MainTable;
+            sol::environment                Environment;
+            sol::table                      ScriptTable;
+        };
+
+        /** Everything one worker state runs, an entity always lands in the same partition so its instance stays put. */
+        struct FScriptPartition
+        {
+            sol::protected_function         Dispatch;
+            sol::table                      Errors;
+            TVector<FScriptUpdateGroup>     Groups;
+        };
+
+        /** Per world, stored in the registry context. Rebuilt only when a script is added, removed or reloaded. */
+        struct FScriptUpdateBatch
+        {
+            sol::protected_function                 Dispatch;
+            sol::table                              Errors;
+            TVector<FScriptUpdateGroup>             Groups;
+            TVector<const Scripting::FLuaScript*>   Scripts;
+            TVector<uint32>                         Versions;
+            
+            bool                                            bParallel = false;
+            TVector<FScriptPartition>                       Partitions;
+            THashMap<entt::entity, FWorkerScriptInstance>   WorkerInstances;
+        };
         
-        auto View = Context.CreateView<SScriptComponent>();
-        View.each([&](entt::entity Entity, const SScriptComponent& ScriptComponent)
+        void DispatchGroup(const sol::protected_function& Dispatch, sol::table& Errors, const FScriptUpdateGroup& Group, double DeltaTime)
         {
-            if (const TSharedPtr<Scripting::FLuaScript>& Script = ScriptComponent.Script)
+            sol::protected_function_result Result = Dispatch(Group.Functions, Group.Tables, Group.Num, DeltaTime, Errors);
+            if (!Result.valid())
+            {
+                sol::error Error = Result;
+                LOG_ERROR("Script Error: {} - {}", Group.Path, Error.what());
+                return;
+            }
+
+            const uint32 NumErrors = Result.get<uint32>();
+            for (uint32 i = 1; i <= NumErrors; ++i)
+            {
+                LOG_ERROR("Script Error: {} - {}", Group.Path, Errors.get_or<std::string>(i, "Unknown"));
+                Errors.raw_set(i, sol::lua_nil);
+            }
+        }
+        
+        void AddToGroup(TVector<FScriptUpdateGroup>& Groups, THashMap<FString, uint32>& GroupIndices, sol::state_view State,
+            const Scripting::FLuaScript& Script, const sol::object& UpdateFunc, const sol::table& ScriptTable)
+        {
+            auto [It, bInserted] = GroupIndices.try_emplace(Script.Path, (uint32)Groups.size());
+            if (bInserted)
+            {
+                FScriptUpdateGroup& NewGroup = Groups.emplace_back();
+                NewGroup.Path           = Script.Path;
+                NewGroup.MemoryOwner    = Script.MemoryOwner;
+                NewGroup.Functions      = State.create_table();
+                NewGroup.Tables         = State.create_table();
+            }
+
+            FScriptUpdateGroup& Group = Groups[It->second];
+            Group.Num++;
+            Group.Functions.raw_set(Group.Num, UpdateFunc);
+            Group.Tables.raw_set(Group.Num, ScriptTable);
+        }
+        
+        /** Finds or creates the worker instance of Entity, returns nullptr when the script cannot run in a worker state. */
+        FWorkerScriptInstance* FindOrCreateWorkerInstance(FScriptUpdateBatch& Batch, THashMap<entt::entity, FWorkerScriptInstance>& OldInstances,
+            const FSystemContext& Context, entt::entity Entity, const Scripting::FLuaScript& Script, uint32 Partition)
+        {
+            auto It = OldInstances.find(Entity);
+            if (It != OldInstances.end() && It->second.Script == &Script && It->second.Version == Script.Version)
+            {
+                return &Batch.WorkerInstances.emplace(Entity, Move(It->second)).first->second;
+            }
+            
+            FWorkerScriptInstance Instance;
+            if (!Scripting::FScriptingContext::Get().InstantiateWorkerScript(Partition, Script, Instance.Environment, Instance.ScriptTable))
             {
-                if (!Script->ScriptTable.valid())
+                return nullptr;
+            }
+            
+            Instance.Script     = &Script;
+            Instance.Version    = Script.Version;
+            Instance.MainTable  = Script.ScriptTable;
+            
+            // Worker states only get the read only context, anything that writes the registry has to be recorded in Commands.
+            Instance.Environment["Entity"]      = Entity;
+            Instance.Environment["Context"]     = FScriptWorkerContext{ &Context };
+            Instance.Environment["Commands"]    = std::ref(Scripting::FScriptingContext::Get().GetWorkerState(Partition).Commands);
+            
+            return &Batch.WorkerInstances.emplace(Entity, Move(Instance)).first->second;
+        }
+
+        template<typename TView>
+        bool IsBatchStale(const FScriptUpdateBatch& Batch, const TView& View)
+        {
+            if (Batch.Scripts.size() != View.size())
+            {
+                return true;
+            }
+
+            uint32 Index = 0;
+            for (auto [Entity, ScriptComponent] : View.each())
+            {
+                const Scripting::FLuaScript* Script = ScriptComponent.Script.get();
+                if (Batch.Scripts[Index] != Script || (Script && Batch.Versions[Index] != Script->Version))
                 {
-                    return;
+                    return true;
                 }
+
+                ++Index;
+            }
+
+            return false;
+        }
+
+        template<typename TView>
+        void RebuildBatch(FScriptUpdateBatch& Batch, const FSystemContext& Context, const TView& View)
+        {
+            LUMINA_PROFILE_SCOPE();
+
+            sol::state_view State = Scripting::FScriptingContext::Get().GetState();
+
+            if (!Batch.Dispatch.valid())
+            {
+                sol::protected_function_result Result = State.safe_script(BatchUpdateChunk);
+                Batch.Dispatch  = Result.get<sol::protected_function>();
+                Batch.Errors    = State.create_table();
+            }
+
+            Batch.Groups.clear();
+            Batch.Scripts.clear();
+            Batch.Versions.clear();
+            Batch.bParallel = CVarParallelScriptUpdate.GetValue();
             
+            THashMap<entt::entity, FWorkerScriptInstance> OldInstances = Move(Batch.WorkerInstances);
+            Batch.WorkerInstances.clear();
+            
+            const uint32 NumPartitions = Batch.bParallel ? Scripting::FScriptingContext::Get().GetNumWorkerStates() : 0;
+            Batch.Partitions.resize(NumPartitions);
+            TVector<THashMap<FString, uint32>> PartitionGroupIndices(NumPartitions);
+            
+            for (uint32 i = 0; i < NumPartitions; ++i)
+            {
+                FScriptPartition& Partition = Batch.Partitions[i];
+                Partition.Groups.clear();
+                
+                if (!Partition.Dispatch.valid())
+                {
+                    sol::state_view WorkerState = Scripting::FScriptingContext::Get().GetWorkerState(i).State;
+                    sol::protected_function_result Result = WorkerState.safe_script(BatchUpdateChunk);
+                    Partition.Dispatch  = Result.get<sol::protected_function>();
+                    Partition.Errors    = WorkerState.create_table();
+                }
+            }
+
+            THashMap<FString, uint32> GroupIndices;
+            for (auto [Entity, ScriptComponent] : View.each())
+            {
+                const TSharedPtr<Scripting::FLuaScript>& Script = ScriptComponent.Script;
+                Batch.Scripts.push_back(Script.get());
+                Batch.Versions.push_back(Script ? Script->Version : 0);
+
+                if (!Script || !Script->ScriptTable.valid())
+                {
+                    continue;
+                }
+
+                // Bound once here rather than every frame, a reload bumps the version and lands back here.
                 Script->Environment["Entity"] = Entity;
                 Script->Environment["Context"] = std::ref(Context);
+                Script->Environment["Commands"] = std::ref(Scripting::FScriptingContext::Get().GetCommands());
+
+                sol::object UpdateFunc = Script->ScriptTable["Update"];
+                if (UpdateFunc.get_type() != sol::type::function)
+                {
+                    continue;
+                }
                 
-                if (sol::optional<sol::function> BeginPlayFunc = Script->ScriptTable["Update"])
+                // Partitioned by entity index rather than view order, so an entity keeps its worker as others come and go.
+                if (NumPartitions != 0 && Script->ScriptTable.get_or("ThreadSafe", false))
                 {
-                    sol::protected_function_result Result = (*BeginPlayFunc)(Script->ScriptTable, Context.GetDeltaTime());
-                    if (!Result.valid())
+                    const uint32 PartitionIndex = entt::to_entity(Entity) % NumPartitions;
+                    if (FWorkerScriptInstance* Instance = FindOrCreateWorkerInstance(Batch, OldInstances, Context, Entity, *Script, PartitionIndex))
                     {
-                        sol::error Error = Result;
-                        LOG_ERROR("Script Error: {} - {}", Script->Path, Error.what());
+                        sol::object WorkerUpdateFunc = Instance->ScriptTable["Update"];
+                        if (WorkerUpdateFunc.get_type() == sol::type::function)
+                        {
+                            sol::state_view WorkerState = Scripting::FScriptingContext::Get().GetWorkerState(PartitionIndex).State;
+                            AddToGroup(Batch.Partitions[PartitionIndex].Groups, PartitionGroupIndices[PartitionIndex], WorkerState, *Script, WorkerUpdateFunc, Instance->ScriptTable);
+                        }
+                        
+                        continue;
                     }
                 }
+
+                AddToGroup(Batch.Groups, GroupIndices, State, *Script, UpdateFunc, Script->ScriptTable);
             }
-        });
+        }
+
+        template<typename TView>
+        void UpdateScriptsPerEntity(const FSystemContext& Context, const TView& View)
+        {
+            View.each([&](entt::entity Entity, const SScriptComponent& ScriptComponent)
+            {
+                if (const TSharedPtr<Scripting::FLuaScript>& Script = ScriptComponent.Script)
+                {
+                    if (!Script->ScriptTable.valid())
+                    {
+                        return;
+                    }
+
+                    Script->Environment["Entity"] = Entity;
+                    Script->Environment["Context"] = std::ref(Context);
+                    Script->Environment["Commands"] = std::ref(Scripting::FScriptingContext::Get().GetCommands());
+
+                    Scripting::FScriptMemoryScope MemoryScope(Script->MemoryOwner);
+                    if (sol::optional<sol::function> BeginPlayFunc = Script->ScriptTable["Update"])
+                    {
+                        sol::protected_function_result Result = (*BeginPlayFunc)(Script->ScriptTable, Context.GetDeltaTime());
+                        if (!Result.valid())
+                        {
+                            sol::error Error = Result;
+                            LOG_ERROR("Script Error: {} - {}", Script->Path, Error.what());
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    void SScriptSystem::Update(const FSystemContext& Context) noexcept
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        auto View = Context.CreateView<SScriptComponent>();
+
+        auto& RegistryContext = Context.GetRegistry().ctx();
+        Scripting::FScriptCommandBuffer& Commands = Scripting::FScriptingContext::Get().GetCommands();
+        if (!CVarBatchedScriptUpdate.GetValue())
+        {
+            UpdateScriptsPerEntity(Context, View);
+            Commands.Apply(Context);
+            return;
+        }
+
+        FScriptUpdateBatch* Batch = RegistryContext.find<FScriptUpdateBatch>();
+        if (Batch == nullptr)
+        {
+            Batch = &RegistryContext.emplace<FScriptUpdateBatch>();
+        }
+
+        if (Batch->bParallel != CVarParallelScriptUpdate.GetValue() || IsBatchStale(*Batch, View))
+        {
+            RebuildBatch(*Batch, Context, View);
+        }
+
+        if (!Batch->Dispatch.valid())
+        {
+            return;
+        }
+        
+        if (!Batch->Partitions.empty())
+        {
+            LUMINA_PROFILE_SECTION("Parallel Script Update");
+            
+            // Both states are idle here, the main instance may have changed since the last update through callbacks or the editor.
+            for (auto& [Entity, Instance] : Batch->WorkerInstances)
+            {
+                Scripting::FScriptMemoryScope MemoryScope(Instance.Script->MemoryOwner);
+                Scripting::CopyPlainValues(Instance.MainTable, Instance.ScriptTable);
+            }
+            
+            // Every partition owns its state for the duration, the registry is only read until the commands are applied.
+            Task::ParallelFor(Batch->Partitions.size(), [&](uint32 Index)
+            {
+                FScriptPartition& Partition = Batch->Partitions[Index];
+                for (const FScriptUpdateGroup& Group : Partition.Groups)
+                {
+                    Scripting::FScriptMemoryScope MemoryScope(Group.MemoryOwner);
+                    DispatchGroup(Partition.Dispatch, Partition.Errors, Group, Context.GetDeltaTime());
+                }
+            });
+            
+            for (auto& [Entity, Instance] : Batch->WorkerInstances)
+            {
+                Scripting::FScriptMemoryScope MemoryScope(Instance.Script->MemoryOwner);
+                Scripting::CopyPlainValues(Instance.ScriptTable, Instance.MainTable);
+            }
+        }
+
+        for (const FScriptUpdateGroup& Group : Batch->Groups)
+        {
+            Scripting::FScriptMemoryScope MemoryScope(Group.MemoryOwner);
+            DispatchGroup(Batch->Dispatch, Batch->Errors, Group, Context.GetDeltaTime());
+        }
+        
+        // Applied once every script updated, so serial and parallel updates both read the registry as it was before the first one ran.
+        for (uint32 i = 0; i < Batch->Partitions.size(); ++i)
+        {
+            Scripting::FScriptingContext::Get().GetWorkerState(i).Commands.Apply(Context);
+        }
+        
+        Commands.Apply(Context);
     }
 }
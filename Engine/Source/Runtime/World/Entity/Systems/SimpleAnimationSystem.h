@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "EntitySystem.h"
 #include "Core/Object/ObjectMacros.h"
+#include "World/Entity/Components/SimpleAnimationComponent.h"
+#include "World/Entity/Components/SkeletalMeshComponent.h"
 #include "SimpleAnimationSystem.generated.h"
 
 namespace Lumina
@@ -10,6 +12,7 @@ namespace Lumina
     {
         GENERATED_BODY()
         ENTITY_SYSTEM(RequiresUpdate(EUpdateStage::PrePhysics), RequiresUpdate(EUpdateStage::Paused))
+        SYSTEM_ACCESS(Writes<SSimpleAnimationComponent, SSkeletalMeshComponent>{})
 
     public:
 
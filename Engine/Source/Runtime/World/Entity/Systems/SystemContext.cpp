@@ -4,10 +4,50 @@
 #include "World/World.h"
 #include "World/Entity/EntityUtils.h"
 #include "World/Entity/Components/DirtyComponent.h"
+#include "Scripting/Lua/ComponentAccessors.h"
 #include "world/entity/components/namecomponent.h"
 
 namespace Lumina
 {
+    namespace
+    {
+        /** Copies the query descriptors of a Lua array. */
+        template<typename T>
+        TVector<T> Lua_ReadQueries(const sol::table& Table)
+        {
+            const size_t NumQueries = Table.size();
+            
+            TVector<T> Queries;
+            Queries.reserve(NumQueries);
+            for (size_t i = 1; i <= NumQueries; ++i)
+            {
+                Queries.push_back(Table.get<T>(i));
+            }
+            
+            return Queries;
+        }
+
+        /** Splits the hits of a batch into one array per query. */
+        sol::table Lua_GroupHits(sol::this_state State, const TVector<FRayResult>& Hits, const TVector<FQueryHitRange>& Ranges)
+        {
+            sol::state_view Lua(State);
+            
+            sol::table Result = Lua.create_table(static_cast<int>(Ranges.size()), 0);
+            for (size_t i = 0; i < Ranges.size(); ++i)
+            {
+                sol::table QueryHits = Lua.create_table(static_cast<int>(Ranges[i].Count), 0);
+                for (uint32 j = 0; j < Ranges[i].Count; ++j)
+                {
+                    QueryHits[j + 1] = Hits[Ranges[i].Offset + j];
+                }
+                
+                Result[i + 1] = QueryHits;
+            }
+            
+            return Result;
+        }
+    }
+    
     FSystemContext::FSystemContext(CWorld* InWorld)
         : World(InWorld)
         , Registry(InWorld->EntityRegistry)
@@ -32,6 +72,8 @@ namespace Lumina
             "ActivateBody",         &FSystemContext::ActivateBody,
             "DeactivateBody",       &FSystemContext::DeactivateBody,
             "ChangeBodyMotionType", &FSystemContext::ChangeBodyMotionType,
+            "GetPhysicsFrame",      &FSystemContext::GetPhysicsFrame,
+            "RestorePhysicsSnapshot", &FSystemContext::RestorePhysicsSnapshot,
 
             "GetRegistry",          &FSystemContext::GetRegistry,
             "GetNumEntities",       &FSystemContext::GetNumEntities,
@@ -95,7 +137,100 @@ namespace Lumina
                 }),
 
                 
-            "CastSphere",           &FSystemContext::CastSphere);
+            "CastSphere",           &FSystemContext::CastSphere,
+            
+            "CastRays",             [](const FSystemContext& Self, const sol::table& Rays)
+            {
+                TVector<FRayCastSettings> Queries = Lua_ReadQueries<FRayCastSettings>(Rays);
+                TVector<FRayResult> Results(Queries.size());
+                Self.CastRays(Queries, Results);
+                return Results;
+            },
+            
+            "CastSpheres",          [](const FSystemContext& Self, const sol::table& Sweeps, sol::this_state State)
+            {
+                TVector<FSphereCastSettings> Queries = Lua_ReadQueries<FSphereCastSettings>(Sweeps);
+                TVector<FQueryHitRange> Ranges(Queries.size());
+                TVector<FRayResult> Hits;
+                Self.CastSpheres(Queries, Hits, Ranges);
+                return Lua_GroupHits(State, Hits, Ranges);
+            },
+            
+            "OverlapSpheres",       [](const FSystemContext& Self, const sol::table& Overlaps, sol::this_state State)
+            {
+                TVector<FSphereOverlapSettings> Queries = Lua_ReadQueries<FSphereOverlapSettings>(Overlaps);
+                TVector<FQueryHitRange> Ranges(Queries.size());
+                TVector<FRayResult> Hits;
+                Self.OverlapSpheres(Queries, Hits, Ranges);
+                return Lua_GroupHits(State, Hits, Ranges);
+            });
+    }
+    
+    void FSystemContext::RegisterWorkerContextWithLua(sol::state& Lua)
+    {
+        // Lookups that create storage (GetByTag, GetByName) and debug drawing are left out along with every write.
+        Lua.new_usertype<FScriptWorkerContext>("WorkerSystemContext",
+            sol::no_constructor,
+            "GetDeltaTime",         [](const FScriptWorkerContext& Self) { return Self.Context->GetDeltaTime(); },
+            "GetTime",              [](const FScriptWorkerContext& Self) { return Self.Context->GetTime(); },
+            "GetUpdateStage",       [](const FScriptWorkerContext& Self) { return Self.Context->GetUpdateStage(); },
+            "GetPhysicsFrame",      [](const FScriptWorkerContext& Self) { return Self.Context->GetPhysicsFrame(); },
+            
+            "GetNumEntities",       [](const FScriptWorkerContext& Self) { return Self.Context->GetNumEntities(); },
+            "IsValidEntity",        [](const FScriptWorkerContext& Self, entt::entity Entity) { return Self.Context->IsValidEntity(Entity); },
+            "GetTransform",         [](const FScriptWorkerContext& Self, entt::entity Entity) -> STransformComponent& { return Self.Context->GetEntityTransform(Entity); },
+            "View",                 [](const FScriptWorkerContext& Self, const sol::variadic_args& Args) { return Self.Context->Lua_View(Args); },
+            "AllOf",                [](const FScriptWorkerContext& Self, entt::entity Entity, const sol::variadic_args& Args) { return Self.Context->Lua_HasAllOf(Entity, Args); },
+            "AnyOf",                [](const FScriptWorkerContext& Self, entt::entity Entity, const sol::variadic_args& Args) { return Self.Context->Lua_HasAnyOf(Entity, Args); },
+            "GetUnsafe",            [](const FScriptWorkerContext& Self, entt::entity Entity, const sol::variadic_args& Args) { return Self.Context->Lua_GetUnsafe(Entity, Args); },
+            "Get",                  [](const FScriptWorkerContext& Self, entt::entity Entity, const sol::variadic_args& Args) { return Self.Context->Lua_Get(Entity, Args); },
+            "GetFirstWith",         [](const FScriptWorkerContext& Self, const sol::object& Component) { return Self.Context->Lua_GetFirstEntityWith(Component); },
+            
+            // Same signatures as the main context so scripts run unchanged, the debug arguments are ignored off the main state.
+            "CastRay",              sol::overload(
+                [](const FScriptWorkerContext& Self, const glm::vec3& Start, const glm::vec3& End, bool, float)
+                {
+                    TOptional<FRayResult> Result = Self.Context->CastRay(Start, End);
+                    return Result.has_value() ? sol::make_optional(Result.value()) : sol::nullopt;
+                },
+                [](const FScriptWorkerContext& Self, const glm::vec3& Start, const glm::vec3& End, bool, float, uint32 LayerMask)
+                {
+                    TOptional<FRayResult> Result = Self.Context->CastRay(Start, End, false, 0.0f, LayerMask);
+                    return Result.has_value() ? sol::make_optional(Result.value()) : sol::nullopt;
+                },
+                [](const FScriptWorkerContext& Self, const glm::vec3& Start, const glm::vec3& End, bool, float, uint32 LayerMask, uint32 IgnoreBody)
+                {
+                    TOptional<FRayResult> Result = Self.Context->CastRay(Start, End, false, 0.0f, LayerMask, IgnoreBody);
+                    return Result.has_value() ? sol::make_optional(Result.value()) : sol::nullopt;
+                }),
+            
+            "CastSphere",           [](const FScriptWorkerContext& Self, const FSphereCastSettings& Settings) { return Self.Context->CastSphere(Settings); },
+            
+            "CastRays",             [](const FScriptWorkerContext& Self, const sol::table& Rays)
+            {
+                TVector<FRayCastSettings> Queries = Lua_ReadQueries<FRayCastSettings>(Rays);
+                TVector<FRayResult> Results(Queries.size());
+                Self.Context->CastRays(Queries, Results);
+                return Results;
+            },
+            
+            "CastSpheres",          [](const FScriptWorkerContext& Self, const sol::table& Sweeps, sol::this_state State)
+            {
+                TVector<FSphereCastSettings> Queries = Lua_ReadQueries<FSphereCastSettings>(Sweeps);
+                TVector<FQueryHitRange> Ranges(Queries.size());
+                TVector<FRayResult> Hits;
+                Self.Context->CastSpheres(Queries, Hits, Ranges);
+                return Lua_GroupHits(State, Hits, Ranges);
+            },
+            
+            "OverlapSpheres",       [](const FScriptWorkerContext& Self, const sol::table& Overlaps, sol::this_state State)
+            {
+                TVector<FSphereOverlapSettings> Queries = Lua_ReadQueries<FSphereOverlapSettings>(Overlaps);
+                TVector<FQueryHitRange> Ranges(Queries.size());
+                TVector<FRayResult> Hits;
+                Self.Context->OverlapSpheres(Queries, Hits, Ranges);
+                return Lua_GroupHits(State, Hits, Ranges);
+            });
     }
     
     entt::runtime_view FSystemContext::CreateRuntimeView(const THashSet<entt::id_type>& Components) const
@@ -136,6 +271,16 @@ namespace Lumina
         World->PhysicsScene->ChangeBodyMotionType(BodyID, NewType);
     }
 
+    uint64 FSystemContext::GetPhysicsFrame() const
+    {
+        return World->PhysicsScene->GetSimulationFrame();
+    }
+
+    bool FSystemContext::RestorePhysicsSnapshot(uint64 Frame)
+    {
+        return World->PhysicsScene->RestoreSnapshot(Frame);
+    }
+
     TOptional<FRayResult> FSystemContext::CastRay(const glm::vec3& Start, const glm::vec3& End, bool bDrawDebug, float DebugDuration, uint32 LayerMask, int64 IgnoreBody) const
     {
         return World->CastRay(Start, End, bDrawDebug, DebugDuration, LayerMask, IgnoreBody);
@@ -146,37 +291,52 @@ namespace Lumina
         return World->CastSphere(Settings);
     }
 
+    void FSystemContext::CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results) const
+    {
+        World->CastRays(Rays, Results);
+    }
+
+    void FSystemContext::CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) const
+    {
+        World->CastSpheres(Sweeps, Hits, Ranges);
+    }
+
+    void FSystemContext::OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) const
+    {
+        World->OverlapSpheres(Overlaps, Hits, Ranges);
+    }
+
     STransformComponent& FSystemContext::GetEntityTransform(entt::entity Entity) const
     {
         return Get<STransformComponent>(Entity);
     }
 
-    glm::vec3 FSystemContext::TranslateEntity(entt::entity Entity, const glm::vec3& Translation)
+    glm::vec3 FSystemContext::TranslateEntity(entt::entity Entity, const glm::vec3& Translation) const
     {
         glm::vec3 NewLocation = Registry.get<STransformComponent>(Entity).Translate(Translation);
         MarkEntityTransformDirty(Entity);
         return NewLocation;
     }
 
-    void FSystemContext::SetEntityLocation(entt::entity Entity, const glm::vec3& Location)
+    void FSystemContext::SetEntityLocation(entt::entity Entity, const glm::vec3& Location) const
     {
         Registry.get<STransformComponent>(Entity).SetLocation(Location);
         MarkEntityTransformDirty(Entity);
     }
 
-    void FSystemContext::SetEntityRotation(entt::entity Entity, const glm::quat& Rotation)
+    void FSystemContext::SetEntityRotation(entt::entity Entity, const glm::quat& Rotation) const
     {
         Registry.get<STransformComponent>(Entity).SetRotation(Rotation);
         MarkEntityTransformDirty(Entity);
     }
 
-    void FSystemContext::SetEntityScale(entt::entity Entity, const glm::vec3& Scale)
+    void FSystemContext::SetEntityScale(entt::entity Entity, const glm::vec3& Scale) const
     {
         Registry.get<STransformComponent>(Entity).SetScale(Scale);
         MarkEntityTransformDirty(Entity);
     }
 
-    void FSystemContext::MarkEntityTransformDirty(entt::entity Entity, EMoveMode MoveMode, bool bActivate)
+    void FSystemContext::MarkEntityTransformDirty(entt::entity Entity, EMoveMode MoveMode, bool bActivate) const
     {
         EmplaceOrReplace<FNeedsTransformUpdate>(Entity, FNeedsTransformUpdate{MoveMode, bActivate});  
     }
@@ -302,14 +462,49 @@ namespace Lumina
     bool FSystemContext::Lua_Has(entt::entity Entity, const sol::object& Type) const
     {
         using namespace entt::literals;
+
+        if (const Scripting::FComponentAccessor* Accessor = Scripting::FindComponentAccessor(Type))
+        {
+            return Accessor->Has(Registry, Entity);
+        }
+        
         entt::meta_any Any = ECS::Utils::InvokeMetaFunc(ECS::Utils::DeduceType(Type), "has"_hs, entt::forward_as_meta(Registry), Entity);
         return Any ? Any.cast<bool>() : false;
     }
 
     entt::runtime_view FSystemContext::Lua_View(const sol::variadic_args& Args) const
     {
-        const THashSet<entt::id_type>& Types = ECS::Utils::CollectTypes(Args);
-        return CreateRuntimeView(Types);
+        // The component set is only known at runtime, so this stays a runtime_view, but reflected components
+        // hand over their pool key directly and only unknown types resolve it through entt::meta.
+        entt::runtime_view RuntimeView;
+        THashSet<entt::id_type> StorageIDs;
+        
+        for (const sol::object Proxy : Args)
+        {
+            entt::id_type StorageID;
+            if (const Scripting::FComponentAccessor* Accessor = Scripting::FindComponentAccessor(Proxy))
+            {
+                StorageID = Accessor->StorageID;
+            }
+            else
+            {
+                const entt::id_type Type = ECS::Utils::DeduceType(Proxy);
+                entt::meta_type Meta = entt::resolve(Type);
+                StorageID = Meta ? Meta.info().hash() : Type;
+            }
+            
+            if (!StorageIDs.insert(StorageID).second)
+            {
+                continue;
+            }
+            
+            if (entt::basic_sparse_set<>* Storage = Registry.storage(StorageID))
+            {
+                RuntimeView.iterate(*Storage);
+            }
+        }
+        
+        return RuntimeView;
     }
 
     void FSystemContext::Lua_SetActiveCamera(uint32 Entity) const
@@ -354,6 +549,12 @@ namespace Lumina
         
         for (const sol::object Proxy : Args)
         {
+            if (const Scripting::FComponentAccessor* Accessor = Scripting::FindComponentAccessor(Proxy))
+            {
+                Results.emplace_back(Accessor->Get(Registry, Entity, LuaState));
+                continue;
+            }
+            
             entt::id_type TypeID = ECS::Utils::DeduceType(Proxy);
             if (const entt::meta_any& MaybeAny = ECS::Utils::InvokeMetaFunc(TypeID, FunctionID, entt::forward_as_meta(Registry), Entity, LuaState))
             {
@@ -382,6 +583,13 @@ namespace Lumina
         
         for (const sol::object Proxy : Args)
         {
+            // Reflected components resolve through the accessor table of the state, anything else takes the meta path.
+            if (const Scripting::FComponentAccessor* Accessor = Scripting::FindComponentAccessor(Proxy))
+            {
+                Results.emplace_back(Accessor->TryGet(Registry, Entity, LuaState));
+                continue;
+            }
+            
             entt::id_type TypeID = ECS::Utils::DeduceType(Proxy);
             if (const entt::meta_any& MaybeAny = ECS::Utils::InvokeMetaFunc(TypeID, FunctionID, entt::forward_as_meta(Registry), Entity, LuaState))
             {
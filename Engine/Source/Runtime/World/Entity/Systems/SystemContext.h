@@ -14,16 +14,23 @@ namespace Lumina
     {
         class IPhysicsScene;
     }
+    
+    namespace Scripting
+    {
+        class FScriptCommandBuffer;
+    }
 
     struct FSystemContext : INonCopyable
     {
         friend class CWorld;
         friend struct SScriptSystem;
+        friend class Scripting::FScriptCommandBuffer;
         
         FSystemContext(CWorld* InWorld);
         ~FSystemContext() = default;
         
         static void RegisterWithLua(sol::state& Lua);
+        static void RegisterWorkerContextWithLua(sol::state& Lua);
 
         RUNTIME_API FORCEINLINE double GetDeltaTime() const { return DeltaTime; }
         RUNTIME_API FORCEINLINE double GetTime() const { return Time; }
@@ -134,18 +141,25 @@ namespace Lumina
         RUNTIME_API void DeactivateBody(uint32 BodyID);
         RUNTIME_API void ChangeBodyMotionType(uint32 BodyID, EBodyType NewType);
         
+        /** See IPhysicsScene::RestoreSnapshot, must not be called from systems that run alongside other physics access. */
+        RUNTIME_API uint64 GetPhysicsFrame() const;
+        RUNTIME_API bool RestorePhysicsSnapshot(uint64 Frame);
+        
         RUNTIME_API TOptional<FRayResult> CastRay(const glm::vec3& Start, const glm::vec3& End, bool bDrawDebug = false, float DebugDuration = 0.0f, uint32 LayerMask = 0xFFFFFFFF, int64 IgnoreBody = -1) const;
         RUNTIME_API TVector<FRayResult> CastSphere(const FSphereCastSettings& Settings) const;
+        RUNTIME_API void CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results) const;
+        RUNTIME_API void CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) const;
+        RUNTIME_API void OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges) const;
 
         
         RUNTIME_API STransformComponent& GetEntityTransform(entt::entity Entity) const;
         
-        RUNTIME_API glm::vec3 TranslateEntity(entt::entity Entity, const glm::vec3& Translation);
-        RUNTIME_API void SetEntityLocation(entt::entity Entity, const glm::vec3& Location);
-        RUNTIME_API void SetEntityRotation(entt::entity Entity, const glm::quat& Rotation);
-        RUNTIME_API void SetEntityScale(entt::entity Entity, const glm::vec3& Scale);
+        RUNTIME_API glm::vec3 TranslateEntity(entt::entity Entity, const glm::vec3& Translation) const;
+        RUNTIME_API void SetEntityLocation(entt::entity Entity, const glm::vec3& Location) const;
+        RUNTIME_API void SetEntityRotation(entt::entity Entity, const glm::quat& Rotation) const;
+        RUNTIME_API void SetEntityScale(entt::entity Entity, const glm::vec3& Scale) const;
         
-        RUNTIME_API void MarkEntityTransformDirty(entt::entity Entity, EMoveMode MoveMode = EMoveMode::Teleport, bool bActivate = true);
+        RUNTIME_API void MarkEntityTransformDirty(entt::entity Entity, EMoveMode MoveMode = EMoveMode::Teleport, bool bActivate = true) const;
         
         //~ Begin Debug Drawing
         RUNTIME_API void DrawDebugLine(const glm::vec3& Start, const glm::vec3& End, const glm::vec4& Color, float Thickness = 1.0f, float Duration = 1.0f);
@@ -196,5 +210,14 @@ namespace Lumina
         EUpdateStage            UpdateStage = EUpdateStage::FrameStart;
     };
     
+    /**
+     * The Context scripts see while they update on a worker state. Only the queries of FSystemContext that leave the registry,
+     * the world and the physics scene untouched are bound, every write goes through the command buffer bound as Commands.
+     */
+    struct FScriptWorkerContext
+    {
+        const FSystemContext* Context = nullptr;
+    };
+    
     
 }
@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "UpdateTransformEntitySystem.h"
 #include "glm/gtx/string_cast.hpp"
+#include "Core/Console/ConsoleVariable.h"
+#include "Core/Math/TransformBatch.h"
 #include "TaskSystem/TaskSystem.h"
 #include "World/Entity/EntityUtils.h"
 #include "World/Entity/Components/DirtyComponent.h"
@@ -9,33 +11,106 @@
 
 namespace Lumina
 {
-    void SUpdateTransformEntitySystem::Update(const FSystemContext& SystemContext) noexcept
+    static TConsoleVar CVarLevelOrderTransforms("World.LevelOrderTransforms", true, "Updates transform hierarchies one depth level at a time, disable to fall back to the recursive per dirty entity update for comparison.");
+    
+    namespace
     {
-        LUMINA_PROFILE_SCOPE();
+        constexpr uint32 TransformBatchSize = 64;
+        constexpr uint32 ParallelTransformThreshold = 1000;
+        
+        /** Composes local transforms and multiplies them onto their parent's cached matrix in SIMD batches. */
+        void UpdateHierarchyTransforms(const FSystemContext& SystemContext, const entt::entity* Entities, uint32 Num)
+        {
+            glm::vec3 Locations[TransformBatchSize];
+            glm::quat Rotations[TransformBatchSize];
+            glm::vec3 Scales[TransformBatchSize];
+            glm::mat4 Parents[TransformBatchSize];
+            glm::mat4 Matrices[TransformBatchSize];
+            bool bHasParent[TransformBatchSize];
 
-        auto SingleView = SystemContext.CreateView<FNeedsTransformUpdate, STransformComponent>(entt::exclude<FRelationshipComponent>);
-        auto RelationshipGroup = SystemContext.CreateGroup<FNeedsTransformUpdate, FRelationshipComponent>(entt::get<STransformComponent>);
+            for (uint32 Start = 0; Start < Num; Start += TransformBatchSize)
+            {
+                const uint32 Count = eastl::min(TransformBatchSize, Num - Start);
+                
+                for (uint32 i = 0; i < Count; ++i)
+                {
+                    entt::entity Entity = Entities[Start + i];
+                    const auto& Transform = SystemContext.Get<STransformComponent>(Entity);
+                    const auto& Relationship = SystemContext.Get<FRelationshipComponent>(Entity);
+                    
+                    Locations[i]    = Transform.Transform.Location;
+                    Rotations[i]    = Transform.Transform.Rotation;
+                    Scales[i]       = Transform.Transform.Scale;
+                    
+                    // The parent is either on the previous level, or clean, so its cached matrix is up to date.
+                    bHasParent[i]   = Relationship.Parent != entt::null && SystemContext.IsValidEntity(Relationship.Parent);
+                    Parents[i]      = bHasParent[i] ? SystemContext.Get<STransformComponent>(Relationship.Parent).CachedMatrix : glm::mat4(1.0f);
+                }
+                
+                Math::ComposeTransforms(Locations, Rotations, Scales, Matrices, Count);
+                Math::MultiplyMatrices(Parents, Matrices, Matrices, Count);
+                
+                for (uint32 i = 0; i < Count; ++i)
+                {
+                    auto& Transform = SystemContext.Get<STransformComponent>(Entities[Start + i]);
+                    Transform.WorldTransform    = bHasParent[i] ? FTransform(Matrices[i]) : Transform.Transform;
+                    Transform.CachedMatrix      = Matrices[i];
+                }
+            }
+        }
         
-        if (!RelationshipGroup.empty())
+        /** Entities without a hierarchy only need their local transform composed. */
+        void UpdateRootTransforms(const FSystemContext& SystemContext, const entt::entity* Entities, uint32 Num)
+        {
+            glm::vec3 Locations[TransformBatchSize];
+            glm::quat Rotations[TransformBatchSize];
+            glm::vec3 Scales[TransformBatchSize];
+            glm::mat4 Matrices[TransformBatchSize];
+
+            for (uint32 Start = 0; Start < Num; Start += TransformBatchSize)
+            {
+                const uint32 Count = eastl::min(TransformBatchSize, Num - Start);
+                
+                for (uint32 i = 0; i < Count; ++i)
+                {
+                    const auto& Transform = SystemContext.Get<STransformComponent>(Entities[Start + i]);
+                    Locations[i]    = Transform.Transform.Location;
+                    Rotations[i]    = Transform.Transform.Rotation;
+                    Scales[i]       = Transform.Transform.Scale;
+                }
+                
+                Math::ComposeTransforms(Locations, Rotations, Scales, Matrices, Count);
+                
+                for (uint32 i = 0; i < Count; ++i)
+                {
+                    auto& Transform = SystemContext.Get<STransformComponent>(Entities[Start + i]);
+                    Transform.WorldTransform    = Transform.Transform;
+                    Transform.CachedMatrix      = Matrices[i];
+                }
+            }
+        }
+        
+        /** The update level order replaced, every dirty entity expands its own subtree, so nested dirty entities are computed more than once. */
+        template<typename TGroup>
+        void UpdateHierarchyRecursive(const FSystemContext& SystemContext, TGroup& RelationshipGroup)
         {
             TVector<entt::entity> DirtyEntities;
-            for (auto entity : RelationshipGroup)
+            for (entt::entity Entity : RelationshipGroup)
             {
-                DirtyEntities.push_back(entity);
+                DirtyEntities.push_back(Entity);
             }
             
             auto RelationshipTransformCallable = [&](uint32 Index)
             {
                 entt::entity DirtyEntity = DirtyEntities[Index];
                 
-                auto& DirtyTransform = RelationshipGroup.get<STransformComponent>(DirtyEntity);
-                auto& DirtyRelationship = RelationshipGroup.get<FRelationshipComponent>(DirtyEntity);
+                auto& DirtyTransform = RelationshipGroup.template get<STransformComponent>(DirtyEntity);
+                auto& DirtyRelationship = RelationshipGroup.template get<FRelationshipComponent>(DirtyEntity);
                 
                 if (DirtyRelationship.Parent != entt::null && SystemContext.IsValidEntity(DirtyRelationship.Parent))
                 {
-                    glm::mat4 ParentWorldTransform         = SystemContext.Get<STransformComponent>(DirtyRelationship.Parent).WorldTransform.GetMatrix();
-                    glm::mat4 LocalTransform               = DirtyTransform.Transform.GetMatrix();
-                    DirtyTransform.WorldTransform          = FTransform(ParentWorldTransform * LocalTransform);
+                    glm::mat4 ParentWorldTransform      = SystemContext.Get<STransformComponent>(DirtyRelationship.Parent).WorldTransform.GetMatrix();
+                    DirtyTransform.WorldTransform       = FTransform(ParentWorldTransform * DirtyTransform.Transform.GetMatrix());
                 }
                 else
                 {
@@ -51,11 +126,8 @@ namespace Lumina
                     {
                         auto& ParentTransform = SystemContext.Get<STransformComponent>(ParentEntity);
                         auto& ChildTransform = SystemContext.Get<STransformComponent>(Child);
-
-                        glm::mat4 ParentWorldTransform = ParentTransform.WorldTransform.GetMatrix();
-                        glm::mat4 ChildLocalTransform = ChildTransform.Transform.GetMatrix();
                         
-                        ChildTransform.WorldTransform = FTransform(ParentWorldTransform * ChildLocalTransform);
+                        ChildTransform.WorldTransform = FTransform(ParentTransform.WorldTransform.GetMatrix() * ChildTransform.Transform.GetMatrix());
                         ChildTransform.CachedMatrix = ChildTransform.WorldTransform.GetMatrix();
                         
                         UpdateChildrenRecursive(Child);
@@ -65,7 +137,7 @@ namespace Lumina
                 UpdateChildrenRecursive(DirtyEntity);
             };
             
-            if (DirtyEntities.size() > 1000)
+            if (DirtyEntities.size() > ParallelTransformThreshold)
             {
                 Task::ParallelFor((uint32)DirtyEntities.size(), RelationshipTransformCallable);
             }
@@ -77,33 +149,112 @@ namespace Lumina
                 }
             }
         }
-
-        if (SingleView.size_hint() < 1000)
+        
+        template<typename TFunc>
+        void DispatchTransformBatches(const FSystemContext& SystemContext, const TVector<entt::entity>& Entities, TFunc&& Func)
         {
-            SingleView.each([&](FNeedsTransformUpdate&, STransformComponent& TransformComponent)
+            if (Entities.size() > ParallelTransformThreshold)
             {
-                TransformComponent.WorldTransform = TransformComponent.Transform;
-                TransformComponent.CachedMatrix = TransformComponent.WorldTransform.GetMatrix();  
-            });
+                Task::ParallelFor(Entities.size(), [&](const Task::FParallelRange& Range)
+                {
+                    Func(SystemContext, Entities.data() + Range.Start, Range.End - Range.Start);
+                });
+            }
+            else
+            {
+                Func(SystemContext, Entities.data(), (uint32)Entities.size());
+            }
+        }
+    }
+    
+    void SUpdateTransformEntitySystem::Update(const FSystemContext& SystemContext) noexcept
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        auto SingleView = SystemContext.CreateView<FNeedsTransformUpdate, STransformComponent>(entt::exclude<FRelationshipComponent>);
+        auto RelationshipGroup = SystemContext.CreateGroup<FNeedsTransformUpdate, FRelationshipComponent>(entt::get<STransformComponent>);
+        
+        if (!RelationshipGroup.empty() && !CVarLevelOrderTransforms.GetValue())
+        {
+            UpdateHierarchyRecursive(SystemContext, RelationshipGroup);
         }
-        else
+        else if (!RelationshipGroup.empty())
         {
-            auto WorkFunctor = [&](FNeedsTransformUpdate&, STransformComponent& Transform)
+            // Dirty roots are bucketed by their depth in the hierarchy. Any dirty entity with a dirty ancestor is dropped,
+            // it is reached when its ancestor's subtree is expanded, so every entity is computed exactly once.
+            TVector<TVector<entt::entity>> Levels;
+            for (entt::entity DirtyEntity : RelationshipGroup)
             {
-                Transform.WorldTransform = Transform.Transform;
-                Transform.CachedMatrix = Transform.Transform.GetMatrix();
-            };
+                bool bHasDirtyAncestor = false;
+                size_t Depth = 0;
+                
+                entt::entity Ancestor = RelationshipGroup.get<FRelationshipComponent>(DirtyEntity).Parent;
+                while (Ancestor != entt::null && SystemContext.IsValidEntity(Ancestor))
+                {
+                    if (RelationshipGroup.contains(Ancestor))
+                    {
+                        bHasDirtyAncestor = true;
+                        break;
+                    }
+                    
+                    const FRelationshipComponent* AncestorRelationship = SystemContext.TryGet<FRelationshipComponent>(Ancestor);
+                    Ancestor = AncestorRelationship ? AncestorRelationship->Parent : entt::null;
+                    ++Depth;
+                }
 
-            auto Handle = SingleView.handle();
-            Task::ParallelFor(Handle->size(), [&](uint32 Index)
+                if (bHasDirtyAncestor)
+                {
+                    continue;
+                }
+                
+                if (Depth >= Levels.size())
+                {
+                    Levels.resize(Depth + 1);
+                }
+                
+                Levels[Depth].push_back(DirtyEntity);
+            }
+            
+            for (size_t Depth = 0; Depth < Levels.size(); ++Depth)
             {
-                entt::entity Entity = (*Handle)[Index];
+                const TVector<entt::entity>& Level = Levels[Depth];
+                
+                DispatchTransformBatches(SystemContext, Level, UpdateHierarchyTransforms);
+
+                // Children of this level make up the rest of the next one.
+                TVector<entt::entity> Children;
+                for (entt::entity Entity : Level)
+                {
+                    ECS::Utils::ForEachChild(SystemContext.GetRegistry(), Entity, [&](entt::entity Child)
+                    {
+                        Children.push_back(Child);
+                    });
+                }
+
+                if (Children.empty())
+                {
+                    continue;
+                }
                 
-                if (SingleView.contains(Entity))
+                if (Depth + 1 >= Levels.size())
                 {
-                    std::apply(WorkFunctor, SingleView.get(Entity));
+                    Levels.resize(Depth + 2);
                 }
-            });
+                
+                Levels[Depth + 1].insert(Levels[Depth + 1].end(), Children.begin(), Children.end());
+            }
+        }
+
+        if (SingleView.size_hint() != 0)
+        {
+            TVector<entt::entity> DirtyEntities;
+            DirtyEntities.reserve(SingleView.size_hint());
+            for (entt::entity Entity : SingleView)
+            {
+                DirtyEntities.push_back(Entity);
+            }
+            
+            DispatchTransformBatches(SystemContext, DirtyEntities, UpdateRootTransforms);
         }
         
         SystemContext.Clear<FNeedsTransformUpdate>();
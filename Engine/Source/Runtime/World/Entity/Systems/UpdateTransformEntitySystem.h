@@ -1,6 +1,9 @@
 ﻿#pragma once
 #include "Core/Object/ObjectMacros.h"
 #include "EntitySystem.h"
+#include "World/Entity/Components/DirtyComponent.h"
+#include "World/Entity/Components/RelationshipComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
 #include "UpdateTransformEntitySystem.generated.h"
 
 namespace Lumina
@@ -10,6 +13,8 @@ namespace Lumina
     {
         GENERATED_BODY()
         ENTITY_SYSTEM(RequiresUpdate(EUpdateStage::PostPhysics, EUpdatePriority::Highest), RequiresUpdate(EUpdateStage::Paused))
+        // The relationship group owns and reorders both of its storages, so they count as writes.
+        SYSTEM_ACCESS(Writes<STransformComponent, FNeedsTransformUpdate, FRelationshipComponent>{})
     public:
 
         
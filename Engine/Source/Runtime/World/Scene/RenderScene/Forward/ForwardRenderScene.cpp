@@ -2,6 +2,8 @@
 #include "ForwardRenderScene.h"
 #include "Assets/AssetTypes/Material/Material.h"
 #include "Core/Console/ConsoleVariable.h"
+#include "Core/Math/TransformBatch.h"
+#include "Core/Math/Hash/Hash.h"
 #include "Core/Templates/AsBytes.h"
 #include "Core/Windows/Window.h"
 #include "Assets/AssetTypes/Mesh/SkeletalMesh/SkeletalMesh.h"
@@ -12,6 +14,7 @@
 #include "Renderer/RHIStaticStates.h"
 #include "Renderer/ShaderCompiler.h"
 #include "Renderer/RenderGraph/RenderGraphDescriptor.h"
+#include "TaskSystem/TaskSystem.h"
 #include "Tools/Import/ImportHelpers.h"
 #include "World/World.h"
 #include "World/Entity/Components/BillboardComponent.h"
@@ -21,16 +24,29 @@
 #include "World/Entity/Components/SkeletalMeshComponent.h"
 #include "world/entity/components/staticmeshcomponent.h"
 #include "World/Scene/RenderScene/MeshDrawCommand.h"
+#include "World/Scene/RenderScene/MeshletCulling.h"
 
 namespace Lumina
 {
     static TConsoleVar CVarSelectionThickness("r.SelectionThickness", 5, "Changes thickness of entity selection.");
+    static TConsoleVar CVarShadowCasterCulling("r.ShadowCasterCulling", true, "Culls shadow casters against each light's sphere or frustum before drawing its shadow map.");
+    static TConsoleVar CVarSoftwareOcclusion("r.SoftwareOcclusion", true, "Rasterizes large static meshes into a CPU depth buffer and skips camera draws of primitives hidden behind them.");
+    static TConsoleVar CVarSoftwareOcclusionMaxOccluders("r.SoftwareOcclusion.MaxOccluders", 64, "Most meshes rasterized as occluders per frame, flagged occluders are picked first.");
+    static TConsoleVar CVarSoftwareOcclusionMinScreenSize("r.SoftwareOcclusion.MinScreenSize", 0.25f, "Bounding radius over view distance a mesh needs to become an occluder without being flagged.");
+    static TConsoleVar CVarMeshLOD("r.MeshLOD", true, "Draws meshes at the coarsest generated level of detail whose projected error stays under r.MeshLOD.PixelError.");
+    static TConsoleVar CVarMeshLODPixelError("r.MeshLOD.PixelError", 1.0f, "Most pixels a simplified level may deviate from the full detail mesh on screen.");
+    static TConsoleVar CVarMeshLODHysteresis("r.MeshLOD.Hysteresis", 0.25f, "Fraction below the pixel error a coarser level needs before a primitive switches to it, stops flicker at level boundaries.");
+    static TConsoleVar CVarMeshLODForce("r.MeshLOD.Force", -1, "Draws every mesh at this level of detail when zero or above, clamped to the levels each mesh has.");
+    static TConsoleVar CVarMeshletCulling("r.MeshletCulling", true, "Culls the meshlets of full detail static meshes against the view frustum and their normal cones, drawing only the surviving index ranges.");
+    static TConsoleVar CVarMeshletCullingMinMeshlets("r.MeshletCulling.MinMeshlets", 8, "Surfaces with fewer meshlets are drawn whole, splitting them costs more instances than it saves.");
+    static TConsoleVar CVarShadowCache("r.ShadowCache", true, "Caches the depth of static shadow casters per point and spot light, re-rendering it only when the light or a static caster in range changes.");
 
     FForwardRenderScene::FForwardRenderScene(CWorld* InWorld)
         : World(InWorld)
         , LightData()
         , SceneGlobalData()
         , ShadowAtlas(FShadowAtlasConfig())
+        , ShadowMapCache(FShadowAtlasConfig())
         , DepthMeshPass()
         , OpaqueMeshPass()
         , TranslucentMeshPass()
@@ -159,9 +175,63 @@ namespace Lumina
             
             TFixedHashMap<CMaterial*, uint64, 4> BatchedDraws;
             
+            // World bounds for every valid primitive are resolved up front in one SIMD batch, in view order.
+            TVector<FAABB> StaticBounds;
+            TVector<glm::mat4> StaticMatrices;
+            TVector<const SStaticMeshComponent*> StaticComponents;
+            TVector<FAABB> SkeletalBounds;
+            TVector<glm::mat4> SkeletalMatrices;
+            
+            {
+                LUMINA_PROFILE_SECTION("Transform Primitive Bounds");
+                
+                StaticBounds.reserve(StaticView.size_hint());
+                StaticMatrices.reserve(StaticView.size_hint());
+                StaticComponents.reserve(StaticView.size_hint());
+                StaticView.each([&](const SStaticMeshComponent& MeshComponent, const STransformComponent& TransformComponent)
+                {
+                    if (IsValid(MeshComponent.StaticMesh))
+                    {
+                        StaticBounds.push_back(MeshComponent.StaticMesh->GetAABB());
+                        StaticMatrices.push_back(TransformComponent.GetMatrix());
+                        StaticComponents.push_back(&MeshComponent);
+                    }
+                });
+                
+                SkeletalBounds.reserve(SkeletalView.size_hint());
+                SkeletalMatrices.reserve(SkeletalView.size_hint());
+                SkeletalView.each([&](const SSkeletalMeshComponent& MeshComponent, const STransformComponent& TransformComponent)
+                {
+                    if (IsValid(MeshComponent.SkeletalMesh))
+                    {
+                        SkeletalBounds.push_back(MeshComponent.SkeletalMesh->GetAABB());
+                        SkeletalMatrices.push_back(TransformComponent.GetMatrix());
+                    }
+                });
+                
+                Math::TransformAABBs(StaticBounds.data(), StaticMatrices.data(), StaticBounds.data(), StaticBounds.size());
+                Math::TransformAABBs(SkeletalBounds.data(), SkeletalMatrices.data(), SkeletalBounds.data(), SkeletalBounds.size());
+            }
+
+            eastl::swap(MeshLODs, PreviousMeshLODs);
+            MeshLODs.clear();
+
+            TVector<uint8> StaticVisible(StaticBounds.size(), 1);
+            TVector<uint8> SkeletalVisible(SkeletalBounds.size(), 1);
+            if (CVarSoftwareOcclusion.GetValue())
+            {
+                CullOccludedPrimitives(StaticBounds, StaticMatrices, StaticComponents, SkeletalBounds, StaticVisible, SkeletalVisible);
+            }
+            
             {
                 LUMINA_PROFILE_SECTION("Process Static Mesh Primitives");
 
+                const bool bMeshletCulling      = CVarMeshletCulling.GetValue();
+                const uint32 MinCulledMeshlets  = (uint32)glm::max(CVarMeshletCullingMinMeshlets.GetValue(), 1);
+                const glm::vec3 ViewPosition    = glm::vec3(SceneGlobalData.CameraData.Location);
+                TVector<FStaticSurfaceDraw> SurfaceDraws;
+                
+                size_t StaticIndex = 0;
                 StaticView.each([&](entt::entity Entity, const SStaticMeshComponent& MeshComponent, const STransformComponent& TransformComponent)
                 {
                     CMesh* Mesh = MeshComponent.StaticMesh;
@@ -174,17 +244,32 @@ namespace Lumina
                     
                     
                     RenderStats.NumVertices += Resource.GetNumVertices();
-                    RenderStats.NumTriangles += Resource.GetNumTriangles();
                     
                     
-                    glm::mat4 TransformMatrix = TransformComponent.GetMatrix();
+                    const glm::mat4& TransformMatrix    = StaticMatrices[StaticIndex];
+                    const bool bVisible                 = StaticVisible[StaticIndex];
+                    const FAABB& BoundingBox            = StaticBounds[StaticIndex++];
+                    
+                    const uint32 LOD                            = SelectMeshLOD(Entity, Resource, BoundingBox, TransformMatrix);
+                    const TVector<FGeometrySurface>& Surfaces   = Resource.GetLODSurfaces(LOD);
+                    
+                    RenderStats.NumTriangles += Resource.GetLODNumIndices(LOD) / 3;
+                    RenderStats.NumReducedLODs += LOD != 0;
                     
-                    FAABB BoundingBox       = Mesh->GetAABB().ToWorld(TransformMatrix);
                     glm::vec3 Center        = (BoundingBox.Min + BoundingBox.Max) * 0.5f;
                     glm::vec3 Extents       = BoundingBox.Max - Center;
                     float Radius            = glm::length(Extents);
                     glm::vec4 SphereBounds  = glm::vec4(Center, Radius);
                     
+                    if (bVisible && SceneGlobalData.CullData.Frustum.IsInside(BoundingBox))
+                    {
+                        const float ProjectedPixels = 2.0f * Radius * GetPixelsPerUnit(BoundingBox);
+                        for (const FGeometrySurface& Surface : Surfaces)
+                        {
+                            GetDrawnMaterial(MeshComponent.GetMaterialForSlot(Surface.MaterialIndex))->RequestTextureScreenSize(ProjectedPixels);
+                        }
+                    }
+                    
                     EInstanceFlags Flags = EInstanceFlags::None;
                     if (World->IsSelected(Entity))
                     {
@@ -198,15 +283,23 @@ namespace Lumina
                     {
                         Flags |= EInstanceFlags::ReceiveShadow;
                     }
+                    if (!bVisible)
+                    {
+                        Flags |= EInstanceFlags::Occluded;
+                    }
                     
-                    for (const FGeometrySurface& Surface : Resource.GeometrySurfaces)
+                    if (MeshComponent.bCastShadow && !Surfaces.empty())
                     {
-                        CMaterialInterface* Material = MeshComponent.GetMaterialForSlot(Surface.MaterialIndex);
+                        ShadowCasterEntities.push_back(Entity);
+                        ShadowCasterBounds.push_back(BoundingBox);
+                        // Filled by the leading full surface draws of GatherStaticSurfaceDraws below.
+                        ShadowCasterInstances.emplace_back((uint32)InstanceData.size(), (uint32)Surfaces.size());
+                        ShadowCasterDynamic.push_back(0);
+                    }
                     
-                        if (!IsValid(Material) || !IsValid(Material->GetMaterial()) || !Material->IsReadyForRender())
-                        {
-                            Material = CMaterial::GetDefaultMaterial();
-                        }
+                    auto AddSurfaceDraw = [&](const FGeometrySurface& Surface, uint32 StartIndex, uint32 IndexCount, EInstanceFlags InstanceFlags)
+                    {
+                        CMaterialInterface* Material = GetDrawnMaterial(MeshComponent.GetMaterialForSlot(Surface.MaterialIndex));
                         
                         auto [BatchIt, bBatchInserted] = BatchedDraws.try_emplace(Material->GetMaterial(), DrawCommands.size());
                         uint64 DrawID = BatchIt->second;
@@ -217,6 +310,7 @@ namespace Lumina
                             {
                                 .VertexShader           = Material->GetVertexShader(EVertexFormat::Static),
                                 .PixelShader            = Material->GetPixelShader(),
+                                .Material               = Material->GetMaterial(),
                                 .IndirectDrawOffset     = 0,
                                 .DrawArgumentIndexMap   = {},
                                 .DrawCount              = 0,
@@ -225,15 +319,15 @@ namespace Lumina
                         
                         auto& DrawArguments = DrawCommands[DrawID].DrawArgumentIndexMap;
                         
-                        auto [DrawIt, bDrawInserted] = DrawArguments.try_emplace(FDrawKey{Surface.StartIndex, Surface.IndexCount}, IndirectDrawArguments.size());
+                        auto [DrawIt, bDrawInserted] = DrawArguments.try_emplace(FDrawKey{StartIndex, IndexCount}, IndirectDrawArguments.size());
                         
                         if (bDrawInserted)
                         {
                             IndirectDrawArguments.emplace_back(FDrawIndirectArguments
                             {
-                                .VertexCount            = (uint32)Surface.IndexCount,
+                                .VertexCount            = IndexCount,
                                 .InstanceCount          = 0,
-                                .StartVertexLocation    = Surface.StartIndex,
+                                .StartVertexLocation    = StartIndex,
                                 .StartInstanceLocation  = 0,
                             });
                         }
@@ -246,18 +340,40 @@ namespace Lumina
                             .SphereBounds           = SphereBounds,
                             .EntityID               = entt::to_integral(Entity),
                             .BatchedDrawID          = DrawIt->second,
-                            .Flags                  = Flags,
+                            .Flags                  = InstanceFlags,
                             .BoneOffset             = 0,
                             .VertexBufferAddress    = RenderUtils::SplitAddress(Mesh->GetVertexBuffer()->GetAddress()),
                             .IndexBufferAddress     = RenderUtils::SplitAddress(Mesh->GetIndexBuffer()->GetAddress()),
                         });
+                    };
+                    
+                    TOptional<FMeshletCuller> MeshletCuller;
+                    if (bMeshletCulling && LOD == 0 && bVisible && !Resource.Meshlets.empty())
+                    {
+                        MeshletCuller.emplace(TransformMatrix, ViewPosition, SceneGlobalData.CullData.Frustum);
                     }
+                    
+                    SurfaceDraws.clear();
+                    const FMeshletCullResult Result = GatherStaticSurfaceDraws(MeshComponent, Resource, Surfaces, Flags, MeshletCuller ? &MeshletCuller.value() : nullptr, MinCulledMeshlets, SurfaceDraws);
+                    
+                    RenderStats.NumMeshlets += Result.NumTested;
+                    RenderStats.NumMeshletsCulled += Result.NumCulled;
+                    RenderStats.NumTriangles -= Result.NumTrianglesCulled;
+                    
+                    for (const FStaticSurfaceDraw& Draw : SurfaceDraws)
+                    {
+                        AddSurfaceDraw(*Draw.Surface, Draw.StartIndex, Draw.IndexCount, Draw.Flags);
+                    }
+                    
+                    // The shadow range recorded above is the first Surfaces.size() instances, the leading full surface draws.
+                    ASSERT(!MeshComponent.bCastShadow || SurfaceDraws.size() >= Surfaces.size());
                 });
             }
             
             {
                 LUMINA_PROFILE_SECTION("Process Skeletal Mesh Primitives");
 
+                size_t SkeletalIndex = 0;
                 SkeletalView.each([&](entt::entity Entity, const SSkeletalMeshComponent& MeshComponent, const STransformComponent& TransformComponent)
                 {
                     CMesh* Mesh = MeshComponent.SkeletalMesh;
@@ -272,16 +388,31 @@ namespace Lumina
                     BonesData.insert(BonesData.end(), MeshComponent.BoneTransforms.begin(), MeshComponent.BoneTransforms.end());
                     
                     RenderStats.NumVertices += Resource.GetNumVertices();
-                    RenderStats.NumTriangles += Resource.GetNumTriangles();
 
-                    glm::mat4 TransformMatrix = TransformComponent.GetMatrix();
+                    const glm::mat4& TransformMatrix    = SkeletalMatrices[SkeletalIndex];
+                    const bool bVisible                 = SkeletalVisible[SkeletalIndex];
+                    const FAABB& BoundingBox            = SkeletalBounds[SkeletalIndex++];
+                    
+                    const uint32 LOD                            = SelectMeshLOD(Entity, Resource, BoundingBox, TransformMatrix);
+                    const TVector<FGeometrySurface>& Surfaces   = Resource.GetLODSurfaces(LOD);
+                    
+                    RenderStats.NumTriangles += Resource.GetLODNumIndices(LOD) / 3;
+                    RenderStats.NumReducedLODs += LOD != 0;
                     
-                    FAABB BoundingBox       = Mesh->GetAABB().ToWorld(TransformMatrix);
                     glm::vec3 Center        = (BoundingBox.Min + BoundingBox.Max) * 0.5f;
                     glm::vec3 Extents       = BoundingBox.Max - Center;
                     float Radius            = glm::length(Extents);
                     glm::vec4 SphereBounds  = glm::vec4(Center, Radius);
                     
+                    if (bVisible && SceneGlobalData.CullData.Frustum.IsInside(BoundingBox))
+                    {
+                        const float ProjectedPixels = 2.0f * Radius * GetPixelsPerUnit(BoundingBox);
+                        for (const FGeometrySurface& Surface : Surfaces)
+                        {
+                            GetDrawnMaterial(MeshComponent.GetMaterialForSlot(Surface.MaterialIndex))->RequestTextureScreenSize(ProjectedPixels);
+                        }
+                    }
+                    
                     EInstanceFlags Flags = EInstanceFlags::Skinned;
                     if (World->IsSelected(Entity))
                     {
@@ -295,15 +426,23 @@ namespace Lumina
                     {
                         Flags |= EInstanceFlags::ReceiveShadow;
                     }
+                    if (!bVisible)
+                    {
+                        Flags |= EInstanceFlags::Occluded;
+                    }
                     
-                    for (const FGeometrySurface& Surface : Resource.GeometrySurfaces)
+                    if (MeshComponent.bCastShadow && !Surfaces.empty())
                     {
-                        CMaterialInterface* Material = MeshComponent.GetMaterialForSlot(Surface.MaterialIndex);
+                        ShadowCasterEntities.push_back(Entity);
+                        ShadowCasterBounds.push_back(BoundingBox);
+                        // Skinned meshes draw each surface whole, once, right below.
+                        ShadowCasterInstances.emplace_back((uint32)InstanceData.size(), (uint32)Surfaces.size());
+                        ShadowCasterDynamic.push_back(1);
+                    }
                     
-                        if (!IsValid(Material) || !IsValid(Material->GetMaterial()) || !Material->IsReadyForRender())
-                        {
-                            Material = CMaterial::GetDefaultMaterial();
-                        }
+                    for (const FGeometrySurface& Surface : Surfaces)
+                    {
+                        CMaterialInterface* Material = GetDrawnMaterial(MeshComponent.GetMaterialForSlot(Surface.MaterialIndex));
                         
                         auto [BatchIt, bBatchInserted] = BatchedDraws.try_emplace(Material->GetMaterial(), DrawCommands.size());
                         uint64 DrawID = BatchIt->second;
@@ -314,6 +453,7 @@ namespace Lumina
                             {
                                 .VertexShader           = Material->GetVertexShader(EVertexFormat::Skinned),
                                 .PixelShader            = Material->GetPixelShader(),
+                                .Material               = Material->GetMaterial(),
                                 .IndirectDrawOffset     = 0,
                                 .DrawArgumentIndexMap   = {},
                                 .DrawCount              = 0,
@@ -509,7 +649,7 @@ namespace Lumina
             LUMINA_PROFILE_SECTION("Point Light Processing");
 
             auto View = World->GetEntityRegistry().view<SPointLightComponent, STransformComponent>();
-            View.each([&] (const SPointLightComponent& PointLightComponent, const STransformComponent& TransformComponent)
+            View.each([&] (entt::entity Entity, const SPointLightComponent& PointLightComponent, const STransformComponent& TransformComponent)
             {
                 FLight Light;
                 Light.Flags                 = LIGHT_TYPE_POINT;
@@ -576,6 +716,7 @@ namespace Lumina
                         }
                         
                         PackedShadows[(uint32)ELightType::Point].push_back(Light.Shadow[0]);
+                        PackedShadowLights[(uint32)ELightType::Point].push_back(Entity);
                     }
                 }
                 else
@@ -595,7 +736,7 @@ namespace Lumina
             LUMINA_PROFILE_SECTION("Spot Light Processing");
 
             auto View = World->GetEntityRegistry().view<SSpotLightComponent, STransformComponent>();
-            View.each([&] (SSpotLightComponent& SpotLightComponent, STransformComponent& TransformComponent)
+            View.each([&] (entt::entity Entity, SSpotLightComponent& SpotLightComponent, STransformComponent& TransformComponent)
             {
                 const FTransform& Transform = TransformComponent.WorldTransform;
                 
@@ -641,9 +782,9 @@ namespace Lumina
                         Light.Shadow[0].AtlasUVScale        = Tile.UVScale;
                         Light.Shadow[0].LightIndex          = (int32)LightData.NumLights;
 
+                        PackedShadows[(uint32)ELightType::Spot].push_back(Light.Shadow[0]);
+                        PackedShadowLights[(uint32)ELightType::Spot].push_back(Entity);
                     }
-                    
-                    PackedShadows[(uint32)ELightType::Spot].push_back(Light.Shadow[0]);
                 }
                 else
                 {
@@ -660,6 +801,10 @@ namespace Lumina
             });
         }
         
+        //========================================================================================================================
+        
+        BuildShadowDrawLists();
+        
         //========================================================================================================================
         {
             LUMINA_PROFILE_SECTION("Batched Line Processing");
@@ -801,6 +946,7 @@ namespace Lumina
                 
                 const SIZE_T SimpleVertexSize   = SimpleVertices.size() * sizeof(FSimpleElementVertex);
                 const SIZE_T InstanceDataSize   = InstanceData.size() * sizeof(FInstanceData);
+                const SIZE_T ShadowMappingSize  = ShadowInstanceMapping.size() * sizeof(uint32);
                 const SIZE_T BoneDataSize       = BonesData.size() * sizeof(glm::mat4);
                 const SIZE_T IndirectArgsSize   = IndirectDrawArguments.size() * sizeof(FDrawIndirectArguments);
                 const SIZE_T ActiveLightsSize   = LightData.NumLights * sizeof(FLight);
@@ -813,7 +959,7 @@ namespace Lumina
                     bAnyBufferResized = true;
                 }
                 
-                if (RenderUtils::ResizeBufferIfNeeded(NamedBuffers[(int)ENamedBuffer::InstanceMapping], sizeof(uint32) * InstanceData.size(), 2))
+                if (RenderUtils::ResizeBufferIfNeeded(NamedBuffers[(int)ENamedBuffer::InstanceMapping], sizeof(uint32) * InstanceData.size() + ShadowMappingSize, 2))
                 {
                     bAnyBufferResized = true;
                 }
@@ -845,6 +991,7 @@ namespace Lumina
                 
                 CmdList.SetBufferState(GetNamedBuffer(ENamedBuffer::Scene), EResourceStates::CopyDest);
                 CmdList.SetBufferState(GetNamedBuffer(ENamedBuffer::Instance), EResourceStates::CopyDest);
+                CmdList.SetBufferState(GetNamedBuffer(ENamedBuffer::InstanceMapping), EResourceStates::CopyDest);
                 CmdList.SetBufferState(GetNamedBuffer(ENamedBuffer::Bone), EResourceStates::CopyDest);
                 CmdList.SetBufferState(GetNamedBuffer(ENamedBuffer::Indirect), EResourceStates::CopyDest);
                 CmdList.SetBufferState(GetNamedBuffer(ENamedBuffer::SimpleVertex), EResourceStates::CopyDest);
@@ -854,6 +1001,11 @@ namespace Lumina
                 CmdList.DisableAutomaticBarriers();
                 CmdList.WriteBuffer(GetNamedBuffer(ENamedBuffer::Scene), &SceneGlobalData, sizeof(FSceneGlobalData));
                 CmdList.WriteBuffer(GetNamedBuffer(ENamedBuffer::Instance), InstanceData.data(), InstanceDataSize);
+                if (ShadowMappingSize > 0)
+                {
+                    // The cull pass owns the first InstanceData.size() entries, the shadow draws read the tail.
+                    CmdList.WriteBuffer(GetNamedBuffer(ENamedBuffer::InstanceMapping), ShadowInstanceMapping.data(), ShadowMappingSize, InstanceData.size() * sizeof(uint32));
+                }
                 CmdList.WriteBuffer(GetNamedBuffer(ENamedBuffer::Bone), BonesData.data(),  BoneDataSize);
                 CmdList.WriteBuffer(GetNamedBuffer(ENamedBuffer::Indirect), IndirectDrawArguments.data(), IndirectArgsSize);
                 CmdList.WriteBuffer(GetNamedBuffer(ENamedBuffer::SimpleVertex), SimpleVertices.data(), SimpleVertexSize);
@@ -863,6 +1015,458 @@ namespace Lumina
         }
     }
 
+    void FForwardRenderScene::BuildShadowDrawLists()
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        {
+            LUMINA_PROFILE_SECTION("Update Shadow Caster BVH");
+            ShadowCasterBVH.Update(ShadowCasterEntities, ShadowCasterBounds);
+        }
+
+        struct FShadowView
+        {
+            ELightType          Type;
+            uint32              LightIndex;
+            FShadowCacheSlot    Cache;
+        };
+
+        // The sun's cascades first, then every packed point and spot shadow in order.
+        TVector<FShadowView> ShadowViews;
+        if (LightData.bHasSun)
+        {
+            ShadowViews.push_back({ ELightType::Directional, 0 });
+        }
+        for (ELightType Type : { ELightType::Point, ELightType::Spot })
+        {
+            for (const FLightShadow& Shadow : PackedShadows[(uint32)Type])
+            {
+                ShadowViews.push_back({ Type, (uint32)Shadow.LightIndex });
+            }
+        }
+
+        // Nothing gets drawn without draw commands, the cache must not believe its tiles were rendered.
+        if (ShadowViews.empty() || DrawCommands.empty())
+        {
+            return;
+        }
+
+        if (!CVarShadowCache.GetValue())
+        {
+            ShadowMapCache.Reset();
+        }
+        else
+        {
+            LUMINA_PROFILE_SECTION("Update Shadow Cache");
+
+            ShadowMapCache.UpdateCasters(ShadowCasterEntities, ShadowCasterBounds, ShadowCasterDynamic);
+
+            // The sun's cascades follow the camera every frame, only point and spot views are cached.
+            const uint32 FirstCachedView = LightData.bHasSun ? 1 : 0;
+
+            TVector<FShadowCacheLight> CacheLights;
+            CacheLights.reserve(ShadowViews.size() - FirstCachedView);
+            for (ELightType Type : { ELightType::Point, ELightType::Spot })
+            {
+                for (entt::entity LightEntity : PackedShadowLights[(uint32)Type])
+                {
+                    const FLight& Light = LightData.Lights[ShadowViews[FirstCachedView + CacheLights.size()].LightIndex];
+
+                    FShadowCacheLight& CacheLight = CacheLights.emplace_back();
+                    CacheLight.Key      = ((uint64)Type << 32) | (uint64)entt::to_integral(LightEntity);
+                    CacheLight.Center   = Light.Position;
+                    CacheLight.Radius   = Light.Radius;
+
+                    if (Type == ELightType::Point)
+                    {
+                        const glm::vec4 Sphere = glm::vec4(Light.Position, Light.Radius);
+                        CacheLight.ViewHash = Hash::GetHash64(&Sphere, sizeof(glm::vec4));
+                    }
+                    else
+                    {
+                        CacheLight.ViewHash = Hash::GetHash64(&Light.ViewProjection[0], sizeof(glm::mat4));
+                    }
+                }
+            }
+
+            TVector<FShadowCacheSlot> Slots;
+            ShadowMapCache.UpdateLights(CacheLights, Slots);
+            for (uint32 i = 0; i < (uint32)Slots.size(); ++i)
+            {
+                ShadowViews[FirstCachedView + i].Cache = Slots[i];
+            }
+        }
+
+        struct FShadowDrawList
+        {
+            TVector<FDrawIndirectArguments> Draws;
+            TVector<uint32>                 Instances;
+        };
+
+        // Two lists per view, the static casters rendered into its cache tile and the casters drawn into the atlas.
+        TVector<FShadowDrawList> DrawLists(ShadowViews.size() * 2);
+        const bool bCullCasters = CVarShadowCasterCulling.GetValue();
+
+        auto CompactDrawList = [&](FShadowDrawList& DrawList)
+        {
+            // Grouping by the camera draw each instance came from turns every group into a single indirect draw.
+            eastl::sort(DrawList.Instances.begin(), DrawList.Instances.end(), [&](uint32 A, uint32 B)
+            {
+                return InstanceData[A].BatchedDrawID != InstanceData[B].BatchedDrawID ? InstanceData[A].BatchedDrawID < InstanceData[B].BatchedDrawID : A < B;
+            });
+
+            for (uint32 i = 0; i < (uint32)DrawList.Instances.size(); ++i)
+            {
+                const uint32 DrawID = InstanceData[DrawList.Instances[i]].BatchedDrawID;
+                if (i == 0 || InstanceData[DrawList.Instances[i - 1]].BatchedDrawID != DrawID)
+                {
+                    FDrawIndirectArguments Args     = IndirectDrawArguments[DrawID];
+                    Args.InstanceCount              = 0;
+                    Args.StartInstanceLocation      = i;
+                    DrawList.Draws.push_back(Args);
+                }
+
+                DrawList.Draws.back().InstanceCount++;
+            }
+        };
+
+        Task::ParallelFor(ShadowViews.size(), [&](uint32 ViewIndex)
+        {
+            LUMINA_PROFILE_SECTION("Cull Shadow View");
+
+            const FShadowView& View = ShadowViews[ViewIndex];
+            const FLight& Light = LightData.Lights[View.LightIndex];
+
+            TVector<uint32> Casters;
+            if (!bCullCasters)
+            {
+                Casters.resize(ShadowCasterInstances.size());
+                for (uint32 i = 0; i < (uint32)Casters.size(); ++i)
+                {
+                    Casters[i] = i;
+                }
+            }
+            else if (View.Type == ELightType::Point)
+            {
+                ShadowCasterBVH.QuerySphere(Light.Position, Light.Radius, Casters);
+            }
+            else
+            {
+                FFrustum Frustums[NumCascades];
+                const uint32 NumFrustums = View.Type == ELightType::Directional ? NumCascades : 1;
+                for (uint32 i = 0; i < NumFrustums; ++i)
+                {
+                    Frustums[i] = FFrustum::FromViewProjection(Light.ViewProjection[i]);
+                }
+
+                ShadowCasterBVH.QueryFrustums(Frustums, NumFrustums, Casters);
+            }
+
+            const bool bCached = View.Cache.CacheTile != INDEX_NONE;
+
+            FShadowDrawList& StaticList     = DrawLists[ViewIndex * 2];
+            FShadowDrawList& DynamicList    = DrawLists[ViewIndex * 2 + 1];
+            for (uint32 Caster : Casters)
+            {
+                FShadowDrawList* DrawList = &DynamicList;
+                if (bCached && ShadowMapCache.IsCasterStatic(Caster))
+                {
+                    // A clean cache tile already holds this caster's depth.
+                    if (!View.Cache.bDirty)
+                    {
+                        continue;
+                    }
+                    DrawList = &StaticList;
+                }
+
+                // Exactly the caster's full surface instances, the meshlet ranges drawn for the camera follow outside it.
+                const glm::uvec2& Range = ShadowCasterInstances[Caster];
+                for (uint32 Instance = Range.x; Instance < Range.x + Range.y; ++Instance)
+                {
+                    DrawList->Instances.push_back(Instance);
+                }
+            }
+
+            CompactDrawList(StaticList);
+            CompactDrawList(DynamicList);
+        });
+
+        {
+            LUMINA_PROFILE_SECTION("Compact Shadow Draws");
+
+            const uint32 MappingBase = (uint32)InstanceData.size();
+            auto AppendDrawList = [&](const FShadowDrawList& DrawList) -> FShadowDrawRange
+            {
+                FShadowDrawRange Range;
+                Range.IndirectDrawOffset    = (uint32)IndirectDrawArguments.size();
+                Range.DrawCount             = (uint32)DrawList.Draws.size();
+
+                const uint32 FirstInstance = MappingBase + (uint32)ShadowInstanceMapping.size();
+                for (FDrawIndirectArguments Args : DrawList.Draws)
+                {
+                    Args.StartInstanceLocation += FirstInstance;
+                    IndirectDrawArguments.push_back(Args);
+                }
+
+                ShadowInstanceMapping.insert(ShadowInstanceMapping.end(), DrawList.Instances.begin(), DrawList.Instances.end());
+                RenderStats.NumShadowDraws += Range.DrawCount;
+                return Range;
+            };
+
+            for (uint32 ViewIndex = 0; ViewIndex < (uint32)ShadowViews.size(); ++ViewIndex)
+            {
+                const FShadowView& View = ShadowViews[ViewIndex];
+
+                FShadowViewDraws Draws;
+                Draws.Static        = AppendDrawList(DrawLists[ViewIndex * 2]);
+                Draws.Dynamic       = AppendDrawList(DrawLists[ViewIndex * 2 + 1]);
+                Draws.CacheTile     = View.Cache.CacheTile;
+                Draws.bCacheDirty   = View.Cache.bDirty;
+                ShadowDrawRanges[(uint32)View.Type].push_back(Draws);
+
+                if (Draws.CacheTile != INDEX_NONE)
+                {
+                    RenderStats.NumShadowCacheHits      += !Draws.bCacheDirty;
+                    RenderStats.NumShadowCacheMisses    += Draws.bCacheDirty;
+                }
+            }
+        }
+    }
+
+    void FForwardRenderScene::CullOccludedPrimitives(const TVector<FAABB>& StaticBounds, const TVector<glm::mat4>& StaticMatrices, const TVector<const SStaticMeshComponent*>& StaticComponents,
+        const TVector<FAABB>& SkeletalBounds, TVector<uint8>& OutStaticVisible, TVector<uint8>& OutSkeletalVisible)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        struct FOccluderCandidate
+        {
+            uint32  StaticIndex;
+            float   ScreenSize;
+            bool    bFlagged;
+        };
+
+        const glm::vec3 ViewPosition    = glm::vec3(SceneGlobalData.CameraData.Location);
+        const float MinScreenSize       = CVarSoftwareOcclusionMinScreenSize.GetValue();
+
+        TVector<FOccluderCandidate> Candidates;
+        {
+            LUMINA_PROFILE_SECTION("Select Occluders");
+
+            for (uint32 i = 0; i < (uint32)StaticBounds.size(); ++i)
+            {
+                const FAABB& Bounds     = StaticBounds[i];
+                const float Radius      = glm::length(Bounds.GetSize()) * 0.5f;
+                const float Distance    = glm::max(glm::distance(Bounds.GetCenter(), ViewPosition), 0.001f);
+                const float ScreenSize  = Radius / Distance;
+
+                const SStaticMeshComponent* Component = StaticComponents[i];
+                const bool bHasOccluderSurface = eastl::any_of(Component->StaticMesh->GetMeshResource().GeometrySurfaces.begin(), Component->StaticMesh->GetMeshResource().GeometrySurfaces.end(), [&](const FGeometrySurface& Surface)
+                {
+                    return IsOccluderMaterial(Component->GetMaterialForSlot(Surface.MaterialIndex));
+                });
+                if (!bHasOccluderSurface)
+                {
+                    continue;
+                }
+
+                const bool bFlagged = StaticComponents[i]->bOccluder;
+                const bool bLargeEnough = ScreenSize >= MinScreenSize && StaticComponents[i]->StaticMesh->GetMeshResource().GetLODNumIndices(0) / 3 <= MaxAutoOccluderTriangles;
+                if (bFlagged || bLargeEnough)
+                {
+                    Candidates.push_back({ i, ScreenSize, bFlagged });
+                }
+            }
+
+            eastl::sort(Candidates.begin(), Candidates.end(), [](const FOccluderCandidate& A, const FOccluderCandidate& B)
+            {
+                return A.bFlagged != B.bFlagged ? A.bFlagged : A.ScreenSize > B.ScreenSize;
+            });
+
+            const uint32 MaxOccluders = (uint32)glm::max(CVarSoftwareOcclusionMaxOccluders.GetValue(), 0);
+            if (Candidates.size() > MaxOccluders)
+            {
+                Candidates.resize(MaxOccluders);
+            }
+        }
+
+        if (Candidates.empty())
+        {
+            return;
+        }
+
+        {
+            LUMINA_PROFILE_SECTION("Rasterize Occluders");
+
+            OcclusionBuffer.Begin(SceneGlobalData.CameraData.Projection * SceneGlobalData.CameraData.View);
+            for (const FOccluderCandidate& Candidate : Candidates)
+            {
+                // Full detail only, simplified levels can bulge past the real silhouette and hide visible primitives.
+                const SStaticMeshComponent* Component = StaticComponents[Candidate.StaticIndex];
+                const FMeshResource& Resource = Component->StaticMesh->GetMeshResource();
+                eastl::visit([&]<typename T0>(const T0& Vertices)
+                {
+                    for (const FGeometrySurface& Surface : Resource.GeometrySurfaces)
+                    {
+                        if (!IsOccluderMaterial(Component->GetMaterialForSlot(Surface.MaterialIndex)))
+                        {
+                            continue;
+                        }
+                        
+                        OcclusionBuffer.AddOccluder(&Vertices.data()->Position, sizeof(typename T0::value_type), (uint32)Vertices.size(),
+                            Resource.Indices.data() + Surface.StartIndex, Surface.IndexCount, StaticMatrices[Candidate.StaticIndex]);
+                    }
+                }, Resource.Vertices);
+            }
+            OcclusionBuffer.Rasterize();
+        }
+
+        {
+            LUMINA_PROFILE_SECTION("Test Primitive Occlusion");
+
+            Task::ParallelFor((uint32)StaticBounds.size(), [&](uint32 Index)
+            {
+                OutStaticVisible[Index] = OcclusionBuffer.IsVisible(StaticBounds[Index]);
+            });
+
+            if (!SkeletalBounds.empty())
+            {
+                Task::ParallelFor((uint32)SkeletalBounds.size(), [&](uint32 Index)
+                {
+                    OutSkeletalVisible[Index] = OcclusionBuffer.IsVisible(SkeletalBounds[Index]);
+                });
+            }
+        }
+
+        RenderStats.NumOccluders = Candidates.size();
+        RenderStats.NumOcclusionCulled = eastl::count(OutStaticVisible.begin(), OutStaticVisible.end(), 0) + eastl::count(OutSkeletalVisible.begin(), OutSkeletalVisible.end(), 0);
+    }
+
+    uint32 FForwardRenderScene::SelectMeshLOD(entt::entity Entity, const FMeshResource& Resource, const FAABB& Bounds, const glm::mat4& Transform)
+    {
+        const uint32 NumLODs = Resource.GetNumLODs();
+        if (NumLODs == 1 || !CVarMeshLOD.GetValue())
+        {
+            return 0;
+        }
+
+        const int32 ForcedLOD = CVarMeshLODForce.GetValue();
+        if (ForcedLOD >= 0)
+        {
+            return glm::min((uint32)ForcedLOD, NumLODs - 1);
+        }
+
+        // Object space errors grow with the largest axis scale and are projected at the nearest point of the bounds.
+        const float MaxScale            = glm::max(glm::length(glm::vec3(Transform[0])), glm::max(glm::length(glm::vec3(Transform[1])), glm::length(glm::vec3(Transform[2]))));
+        const float PixelsPerUnit       = GetPixelsPerUnit(Bounds);
+        
+        const float MaxPixelError       = CVarMeshLODPixelError.GetValue();
+        const float Hysteresis          = glm::clamp(CVarMeshLODHysteresis.GetValue(), 0.0f, 1.0f);
+
+        // Primitives seen for the first time have nothing to hold on to and take the plain threshold.
+        auto It = PreviousMeshLODs.find(Entity);
+        const uint32 PreviousLOD = It != PreviousMeshLODs.end() ? It->second : NumLODs;
+
+        const uint32 LOD = PickMeshLOD(Resource, MaxScale * PixelsPerUnit, PreviousLOD, MaxPixelError, Hysteresis);
+
+        MeshLODs[Entity] = (uint8)LOD;
+        return LOD;
+    }
+
+    uint32 FForwardRenderScene::PickMeshLOD(const FMeshResource& Resource, float PixelsPerObjectUnit, uint32 PreviousLOD, float MaxPixelError, float Hysteresis)
+    {
+        for (uint32 Level = Resource.GetNumLODs() - 1; Level > 0; --Level)
+        {
+            const float Limit = Level > PreviousLOD ? MaxPixelError * (1.0f - Hysteresis) : MaxPixelError;
+            if (Resource.GetLODError(Level) * PixelsPerObjectUnit <= Limit)
+            {
+                return Level;
+            }
+        }
+
+        return 0;
+    }
+
+    FMeshletCullResult FForwardRenderScene::GatherStaticSurfaceDraws(const SStaticMeshComponent& MeshComponent, const FMeshResource& Resource, const TVector<FGeometrySurface>& Surfaces,
+        EInstanceFlags Flags, const FMeshletCuller* MeshletCuller, uint32 MinCulledMeshlets, TVector<FStaticSurfaceDraw>& OutDraws)
+    {
+        FMeshletCullResult Result;
+        
+        if (MeshletCuller == nullptr)
+        {
+            for (const FGeometrySurface& Surface : Surfaces)
+            {
+                OutDraws.push_back({ &Surface, Surface.StartIndex, Surface.IndexCount, Flags });
+            }
+            return Result;
+        }
+        
+        // Faces turned away from the camera still cast shadows, so casters keep their full surfaces as shadow only instances.
+        // Surfaces drawn whole are emitted here too, the leading run then holds one draw per surface either way.
+        for (const FGeometrySurface& Surface : Surfaces)
+        {
+            const bool bCullSurface = Surface.NumMeshlets >= MinCulledMeshlets;
+            if (!bCullSurface || MeshComponent.bCastShadow)
+            {
+                OutDraws.push_back({ &Surface, Surface.StartIndex, Surface.IndexCount, bCullSurface ? Flags | EInstanceFlags::ShadowOnly : Flags });
+            }
+        }
+        
+        // Reused across primitives, the render scene gathers them on a single thread.
+        static thread_local TVector<glm::uvec2> MeshletRanges;
+        
+        for (const FGeometrySurface& Surface : Surfaces)
+        {
+            if (Surface.NumMeshlets < MinCulledMeshlets)
+            {
+                continue;
+            }
+            
+            CMaterialInterface* Material = MeshComponent.GetMaterialForSlot(Surface.MaterialIndex);
+            const bool bConeCull = !IsValid(Material) || !Material->IsTwoSided();
+            
+            MeshletRanges.clear();
+            const FMeshletCullResult SurfaceResult = MeshletCuller->CullSurface(Resource, Surface, bConeCull, MeshletRanges);
+            
+            Result.NumTested            += SurfaceResult.NumTested;
+            Result.NumCulled            += SurfaceResult.NumCulled;
+            Result.NumTrianglesCulled   += SurfaceResult.NumTrianglesCulled;
+            
+            for (const glm::uvec2& Range : MeshletRanges)
+            {
+                OutDraws.push_back({ &Surface, Range.x, Range.y, Flags });
+            }
+        }
+        
+        return Result;
+    }
+
+    float FForwardRenderScene::GetPixelsPerUnit(const FAABB& Bounds) const
+    {
+        const glm::vec3 ViewPosition    = glm::vec3(SceneGlobalData.CameraData.Location);
+        const float Radius              = glm::length(Bounds.GetSize()) * 0.5f;
+        const float Distance            = glm::max(glm::distance(Bounds.GetCenter(), ViewPosition) - Radius, SceneGlobalData.NearPlane);
+        
+        return glm::abs(SceneGlobalData.CameraData.Projection[1][1]) * 0.5f * SceneGlobalData.ScreenSize.y / Distance;
+    }
+
+    CMaterialInterface* FForwardRenderScene::GetDrawnMaterial(CMaterialInterface* Material)
+    {
+        if (!IsValid(Material) || !IsValid(Material->GetMaterial()) || !Material->IsReadyForRender())
+        {
+            return CMaterial::GetDefaultMaterial();
+        }
+
+        return Material;
+    }
+
+    bool FForwardRenderScene::IsOccluderMaterial(CMaterialInterface* Material)
+    {
+        // Instances inherit how they blend from their parent material.
+        CMaterialInterface* Drawn = GetDrawnMaterial(Material);
+        CMaterial* Parent = IsValid(Drawn) ? Drawn->GetMaterial() : nullptr;
+        return IsValid(Parent) && Parent->GetMaterialType() == EMaterialType::PBR && !Parent->IsTranslucent() && !Parent->IsTwoSided();
+    }
+
     void FForwardRenderScene::DrawBillboard(FRHIImage* Image, const glm::vec3& Location, float Scale)
     {
         FBillboardInstance& Billboard = BillboardInstances.emplace_back();
@@ -883,9 +1487,17 @@ namespace Lumina
         BillboardInstances.clear();
         RenderStats = {};
 
+        ShadowCasterEntities.clear();
+        ShadowCasterBounds.clear();
+        ShadowCasterInstances.clear();
+        ShadowCasterDynamic.clear();
+        ShadowInstanceMapping.clear();
+
         for (int i = 0; i < (int)ELightType::Num; ++i)
         {
             PackedShadows[i].clear();
+            PackedShadowLights[i].clear();
+            ShadowDrawRanges[i].clear();
         }
     }
 
@@ -1164,69 +1776,19 @@ namespace Lumina
                 .SetViewMask(RenderUtils::CreateViewMask<0u, 1u, 2u, 3u, 4u, 5u>())
                 .SetRenderArea(glm::uvec2(GShadowAtlasResolution, GShadowAtlasResolution));
             
-            FGraphicsState GraphicsState; GraphicsState
-                .SetRenderPass(Move(RenderPass))
-                .AddBindingSet(SceneBindingSet)
-                .AddBindingSet(SceneDescriptorTable)
-                .SetIndirectParams(GetNamedBuffer(ENamedBuffer::Indirect));
-                    
-            
-            const TVector<FLightShadow>& PointShadows = PackedShadows[(uint32)ELightType::Point];
-            
             FRHIVertexShaderRef VertexShader = FShaderLibrary::GetVertexShader("ShadowMapping.vert");
             
-            for (const FLightShadow& LightShadow : PointShadows)
-            {
-                LUMINA_PROFILE_SECTION_COLORED("Process Point Light", tracy::Color::DeepPink2);
-                
-                const FShadowTile& Tile = ShadowAtlas.GetTile(LightShadow.ShadowMapIndex);
-                uint32 TilePixelX       = static_cast<uint32>(Tile.UVOffset.x * GShadowAtlasResolution);
-                uint32 TilePixelY       = static_cast<uint32>(Tile.UVOffset.y * GShadowAtlasResolution);
-                uint32 TileSize         = static_cast<uint32>(Tile.UVScale.x * GShadowAtlasResolution);
-                
-                FViewport Viewport
-                (
-                    (float)TilePixelX,
-                    (float)TilePixelX + TileSize,
-                    (float)TilePixelY,
-                    (float)TilePixelY + TileSize,
-                    0.0f,
-                    1.0f 
-                );
-                
-                // FRect(minX, maxX, minY, maxY)
-                FRect Scissor
-                (
-                    (int)TilePixelX,
-                    (int)TilePixelX + TileSize,
-                    (int)TilePixelY,
-                    (int)TilePixelY + TileSize
-                );
-                
-                GraphicsState.SetViewportState(FViewportState(Viewport, Scissor));
-                
-                for (const FMeshDrawCommand& Batch : DrawCommands)
-                {
-                    FGraphicsPipelineDesc Desc; Desc
-                        .SetDebugName("Point Light Shadow Pass")
-                        .SetRenderState(RenderState)
-                        .AddBindingLayout(SceneBindingLayout)
-                        .AddBindingLayout(SceneBindlessLayout)
-                        .SetVertexShader(VertexShader)
-                        .SetPixelShader(PixelShader);
-                    
-                    FRHIGraphicsPipelineRef Pipeline = GRenderContext->CreateGraphicsPipeline(Desc, RenderPass);
-                    
-                    GraphicsState.SetPipeline(Pipeline);
-                    
-                    CmdList.SetGraphicsState(GraphicsState);
-                    
-                    CmdList.SetPushConstants(&LightShadow.LightIndex, sizeof(uint32));
-                    CmdList.DrawIndirect(Batch.DrawCount, Batch.IndirectDrawOffset * sizeof(FDrawIndirectArguments));
-                }
-            }
+            FGraphicsPipelineDesc Desc; Desc
+                .SetDebugName("Point Light Shadow Pass")
+                .SetRenderState(RenderState)
+                .AddBindingLayout(SceneBindingLayout)
+                .AddBindingLayout(SceneBindlessLayout)
+                .SetVertexShader(VertexShader)
+                .SetPixelShader(PixelShader);
+            
+            FRHIGraphicsPipelineRef Pipeline = GRenderContext->CreateGraphicsPipeline(Desc, RenderPass);
 
-            CmdList.EndRenderPass();
+            RenderShadowTiles(CmdList, ELightType::Point, RenderPass, Pipeline);
         });
     }
 
@@ -1253,79 +1815,160 @@ namespace Lumina
                         .SetCullFront());
             
             
-            const TVector<FLightShadow>& SpotShadows = PackedShadows[(uint32)ELightType::Spot];
-            
             FRHIVertexShaderRef VertexShader = FShaderLibrary::GetVertexShader("ShadowMapping.vert");
+            
+            FRenderPassDesc::FAttachment Depth; Depth
+                .SetLoadOp(ERenderLoadOp::Clear)
+                .SetDepthClearValue(1.0f)
+                .SetImage(ShadowAtlas.GetImage())
+                    .SetArraySlice(6);
+            
+            FRenderPassDesc RenderPass; RenderPass
+                .SetDepthAttachment(Depth)
+                .SetRenderArea(glm::uvec2(GShadowAtlasResolution, GShadowAtlasResolution));
+            
+            FGraphicsPipelineDesc Desc; Desc
+                .SetDebugName("Spot Shadow Pass")
+                .SetRenderState(RenderState)
+                .AddBindingLayout(SceneBindingLayout)
+                .AddBindingLayout(SceneBindlessLayout)
+                .SetVertexShader(VertexShader)
+                .SetPixelShader(PixelShader);
+            
+            FRHIGraphicsPipelineRef Pipeline = GRenderContext->CreateGraphicsPipeline(Desc, RenderPass);
+
+            RenderShadowTiles(CmdList, ELightType::Spot, RenderPass, Pipeline);
+        });
+    }
+
+    void FForwardRenderScene::RenderShadowTiles(ICommandList& CmdList, ELightType Type, const FRenderPassDesc& RenderPass, FRHIGraphicsPipeline* Pipeline)
+    {
+        const TVector<FLightShadow>& Shadows        = PackedShadows[(uint32)Type];
+        const TVector<FShadowViewDraws>& ViewDraws  = ShadowDrawRanges[(uint32)Type];
+
+        // Point lights render all six faces at once through multiview, spot lights own the last layer.
+        const uint32 FirstLayer = Type == ELightType::Point ? 0 : 6;
+        const uint32 NumLayers  = Type == ELightType::Point ? 6 : 1;
+
+        auto GetTileRect = [&](int32 TileIndex, glm::uvec2& OutOffset, uint32& OutSize)
+        {
+            const FShadowTile& Tile = ShadowAtlas.GetTile(TileIndex);
+            OutOffset   = glm::uvec2(Tile.UVOffset * (float)GShadowAtlasResolution);
+            OutSize     = static_cast<uint32>(Tile.UVScale.x * GShadowAtlasResolution);
+        };
+
+        auto DrawTile = [&](FRHIImage* Target, int32 TileIndex, ERenderLoadOp LoadOp, const FShadowDrawRange& DrawRange, int32 LightIndex)
+        {
+            glm::uvec2 TileOffset;
+            uint32 TileSize;
+            GetTileRect(TileIndex, TileOffset, TileSize);
+
+            // The render area is the tile alone, so a clear only touches this light's tile.
+            FRenderPassDesc TilePass = RenderPass;
+            TilePass.DepthAttachment.SetImage(Target).SetLoadOp(LoadOp);
+            TilePass.SetRenderArea(TileOffset, glm::uvec2(TileSize));
+
+            FViewport Viewport
+            (
+                (float)TileOffset.x,
+                (float)TileOffset.x + TileSize,
+                (float)TileOffset.y,
+                (float)TileOffset.y + TileSize,
+                0.0f,
+                1.0f 
+            );
+            
+            // FRect(minX, maxX, minY, maxY)
+            FRect Scissor
+            (
+                (int)TileOffset.x,
+                (int)TileOffset.x + TileSize,
+                (int)TileOffset.y,
+                (int)TileOffset.y + TileSize
+            );
+
+            FGraphicsState GraphicsState; GraphicsState
+                .SetRenderPass(Move(TilePass))
+                .SetViewportState(FViewportState(Viewport, Scissor))
+                .SetPipeline(Pipeline)
+                .AddBindingSet(SceneBindingSet)
+                .AddBindingSet(SceneDescriptorTable)
+                .SetIndirectParams(GetNamedBuffer(ENamedBuffer::Indirect));
 
-            for (const FLightShadow& Shadow : SpotShadows)
+            // Still bound with nothing to draw, beginning the pass is what clears the tile.
+            CmdList.SetGraphicsState(GraphicsState);
+            if (DrawRange.DrawCount == 0)
             {
-                LUMINA_PROFILE_SECTION_COLORED("Process Spot Light", tracy::Color::DeepPink);
-
-                const FShadowTile& Tile = ShadowAtlas.GetTile(Shadow.ShadowMapIndex);
-                uint32 TilePixelX = static_cast<uint32>(Tile.UVOffset.x * GShadowAtlasResolution);
-                uint32 TilePixelY = static_cast<uint32>(Tile.UVOffset.y * GShadowAtlasResolution);
-                uint32 TileSize = static_cast<uint32>(Tile.UVScale.x * GShadowAtlasResolution);
-                
-                FRenderPassDesc::FAttachment Depth; Depth
-                    .SetLoadOp(ERenderLoadOp::Clear)
-                    .SetDepthClearValue(1.0f)
-                    .SetImage(ShadowAtlas.GetImage())
-                        .SetArraySlice(6);
-                
-                FRenderPassDesc RenderPass; RenderPass
-                    .SetDepthAttachment(Depth)
-                    .SetRenderArea(glm::uvec2(GShadowAtlasResolution, GShadowAtlasResolution));
-                
-                FViewportState ViewportState;
-                ViewportState.SetViewport((FViewport
-                (
-                    (float)TilePixelX,
-                    (float)TilePixelX + TileSize,
-                    (float)TilePixelY,
-                    (float)TilePixelY + TileSize,
-                    0.0f,
-                    1.0f 
-                )));
-                
-                ViewportState.SetScissorRect(FRect
-                (
-                    (int)TilePixelX,
-                    (int)TilePixelX + TileSize,
-                    (int)TilePixelY,
-                    (int)TilePixelY + TileSize
-                ));
-                
-                FGraphicsState GraphicsState; GraphicsState
-                    .SetRenderPass(RenderPass)
-                    .SetViewportState(ViewportState)
-                    .AddBindingSet(SceneBindingSet)
-                    .AddBindingSet(SceneDescriptorTable)
-                    .SetIndirectParams(GetNamedBuffer(ENamedBuffer::Indirect));                    
-                
-                
-                for (const FMeshDrawCommand& Batch : DrawCommands)
+                return;
+            }
+
+            CmdList.SetPushConstants(&LightIndex, sizeof(uint32));
+            CmdList.DrawIndirect(DrawRange.DrawCount, DrawRange.IndirectDrawOffset * sizeof(FDrawIndirectArguments));
+        };
+
+        FRHIImage* AtlasImage = ShadowAtlas.GetImage();
+        FRHIImage* CacheImage = nullptr;
+
+        {
+            LUMINA_PROFILE_SECTION("Render Shadow Cache");
+
+            for (size_t ShadowIndex = 0; ShadowIndex < Shadows.size(); ++ShadowIndex)
+            {
+                const FShadowViewDraws& Draws = ViewDraws[ShadowIndex];
+                if (Draws.CacheTile == INDEX_NONE)
                 {
-                    FGraphicsPipelineDesc Desc; Desc
-                        .SetDebugName("Spot Shadow Pass")
-                        .SetRenderState(RenderState)
-                        .AddBindingLayout(SceneBindingLayout)
-                        .AddBindingLayout(SceneBindlessLayout)
-                        .SetVertexShader(VertexShader)
-                        .SetPixelShader(PixelShader);
-                    
-                    FRHIGraphicsPipelineRef Pipeline = GRenderContext->CreateGraphicsPipeline(Desc, RenderPass);
-                    
-                    GraphicsState.SetPipeline(Pipeline);
-                    CmdList.SetGraphicsState(GraphicsState);
-                    
-                    CmdList.SetPushConstants(&Shadow.LightIndex, sizeof(uint32));
-                    CmdList.DrawIndirect(Batch.DrawCount, Batch.IndirectDrawOffset * sizeof(FDrawIndirectArguments));
+                    continue;
+                }
+
+                CacheImage = ShadowMapCache.GetImage();
+                if (Draws.bCacheDirty)
+                {
+                    DrawTile(CacheImage, Draws.CacheTile, ERenderLoadOp::Clear, Draws.Static, Shadows[ShadowIndex].LightIndex);
                 }
             }
 
             CmdList.EndRenderPass();
+        }
 
-        });
+        if (CacheImage != nullptr)
+        {
+            LUMINA_PROFILE_SECTION("Copy Shadow Cache");
+
+            for (size_t ShadowIndex = 0; ShadowIndex < Shadows.size(); ++ShadowIndex)
+            {
+                const FShadowViewDraws& Draws = ViewDraws[ShadowIndex];
+                if (Draws.CacheTile == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                glm::uvec2 CacheOffset, AtlasOffset;
+                uint32 TileSize;
+                GetTileRect(Draws.CacheTile, CacheOffset, TileSize);
+                GetTileRect(Shadows[ShadowIndex].ShadowMapIndex, AtlasOffset, TileSize);
+
+                for (uint32 Layer = FirstLayer; Layer < FirstLayer + NumLayers; ++Layer)
+                {
+                    CmdList.CopyImage(
+                        CacheImage, FTextureSlice().SetOrigin(CacheOffset.x, CacheOffset.y).SetSize(TileSize, TileSize, 1).SetArraySlice(Layer),
+                        AtlasImage, FTextureSlice().SetOrigin(AtlasOffset.x, AtlasOffset.y).SetSize(TileSize, TileSize, 1).SetArraySlice(Layer));
+                }
+            }
+        }
+
+        for (size_t ShadowIndex = 0; ShadowIndex < Shadows.size(); ++ShadowIndex)
+        {
+            LUMINA_PROFILE_SECTION_COLORED("Process Shadow Light", tracy::Color::DeepPink2);
+
+            const FLightShadow& Shadow      = Shadows[ShadowIndex];
+            const FShadowViewDraws& Draws   = ViewDraws[ShadowIndex];
+
+            // A cached light's tile already holds its static depth, only its dynamic casters go on top.
+            const ERenderLoadOp LoadOp = Draws.CacheTile != INDEX_NONE ? ERenderLoadOp::Load : ERenderLoadOp::Clear;
+            DrawTile(AtlasImage, Shadow.ShadowMapIndex, LoadOp, Draws.Dynamic, Shadow.LightIndex);
+        }
+
+        CmdList.EndRenderPass();
     }
 
     void FForwardRenderScene::CascadedShowPass(FRenderGraph& RenderGraph)
@@ -1360,30 +2003,31 @@ namespace Lumina
             
             FRHIVertexShaderRef VertexShader = FShaderLibrary::GetVertexShader("ShadowMapping.vert");
             
-            for (const FMeshDrawCommand& Batch : DrawCommands)
-            {
-                FGraphicsPipelineDesc Desc; Desc
-                    .SetDebugName("Cascaded Shadow Maps")
-                    .SetRenderState(RenderState)
-                    .AddBindingLayout(SceneBindingLayout)
-                    .AddBindingLayout(SceneBindlessLayout)
-                    .SetVertexShader(VertexShader);
-                
-                FRHIGraphicsPipelineRef Pipeline = GRenderContext->CreateGraphicsPipeline(Desc, RenderPass);
+            FGraphicsPipelineDesc Desc; Desc
+                .SetDebugName("Cascaded Shadow Maps")
+                .SetRenderState(RenderState)
+                .AddBindingLayout(SceneBindingLayout)
+                .AddBindingLayout(SceneBindlessLayout)
+                .SetVertexShader(VertexShader);
+            
+            FRHIGraphicsPipelineRef Pipeline = GRenderContext->CreateGraphicsPipeline(Desc, RenderPass);
 
-                FGraphicsState GraphicsState; GraphicsState
-                    .SetRenderPass(RenderPass)
-                    .SetViewportState(MakeViewportStateFromImage(GetNamedImage(ENamedImage::Cascade)))
-                    .SetPipeline(Pipeline)
-                    .AddBindingSet(SceneBindingSet)
-                    .AddBindingSet(SceneDescriptorTable)
-                    .SetIndirectParams(GetNamedBuffer(ENamedBuffer::Indirect));
-                
-                CmdList.SetGraphicsState(GraphicsState);
-        
+            FGraphicsState GraphicsState; GraphicsState
+                .SetRenderPass(RenderPass)
+                .SetViewportState(MakeViewportStateFromImage(GetNamedImage(ENamedImage::Cascade)))
+                .SetPipeline(Pipeline)
+                .AddBindingSet(SceneBindingSet)
+                .AddBindingSet(SceneDescriptorTable)
+                .SetIndirectParams(GetNamedBuffer(ENamedBuffer::Indirect));
+            
+            CmdList.SetGraphicsState(GraphicsState);
+            
+            const FShadowDrawRange& DrawRange = ShadowDrawRanges[(uint32)ELightType::Directional][0].Dynamic;
+            if (DrawRange.DrawCount > 0)
+            {
                 uint32 LightIndex = 0;
                 CmdList.SetPushConstants(&LightIndex, sizeof(uint32));
-                CmdList.DrawIndirect(Batch.DrawCount, Batch.IndirectDrawOffset * sizeof(FDrawIndirectArguments));
+                CmdList.DrawIndirect(DrawRange.DrawCount, DrawRange.IndirectDrawOffset * sizeof(FDrawIndirectArguments));
             }
         });
     }
@@ -1446,11 +2090,19 @@ namespace Lumina
                 FGraphicsState GraphicsState; GraphicsState
                     .SetRenderPass(RenderPass)
                     .SetViewportState(SceneViewportState)
-                    .SetPipeline(GRenderContext->CreateGraphicsPipeline(Desc, RenderPass))
                     .SetIndirectParams(GetNamedBuffer(ENamedBuffer::Indirect))
                     .AddBindingSet(SceneBindingSet)
                     .AddBindingSet(SceneDescriptorTable);
                 
+                // Set 2 holds the material's texture samplers. GetBindingSet rebuilds it when streaming swaps an image.
+                if (FRHIBindingLayout* MaterialLayout = Batch.Material ? Batch.Material->GetBindingLayout() : nullptr)
+                {
+                    Desc.AddBindingLayout(MaterialLayout);
+                    GraphicsState.AddBindingSet(Batch.Material->GetBindingSet());
+                }
+                
+                GraphicsState.SetPipeline(GRenderContext->CreateGraphicsPipeline(Desc, RenderPass));
+                
                 CmdList.SetGraphicsState(GraphicsState);
                 CmdList.DrawIndirect(Batch.DrawCount, Batch.IndirectDrawOffset * sizeof(FDrawIndirectArguments));
             }
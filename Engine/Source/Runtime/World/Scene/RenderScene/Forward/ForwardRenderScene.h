@@ -4,11 +4,20 @@
 #include "Renderer/Vertex.h"
 #include "World/Scene/RenderScene/MeshDrawCommand.h"
 #include "World/Scene/RenderScene/RenderScene.h"
+#include "World/Scene/RenderScene/ShadowCasterBVH.h"
+#include "World/Scene/RenderScene/ShadowMapCache.h"
+#include "World/Scene/RenderScene/SoftwareOcclusion.h"
 
 
 namespace Lumina
 {
     class CWorld;
+    class CMaterialInterface;
+    class FMeshletCuller;
+    struct FGeometrySurface;
+    struct FMeshletCullResult;
+    struct FMeshResource;
+    struct SStaticMeshComponent;
 
     /**
      * Scene rendering via Clustered Forward Rendering.
@@ -57,6 +66,59 @@ namespace Lumina
         void SwapchainResized(glm::vec2 NewSize);
         
         void CompileDrawCommands(FRenderGraph& RenderGraph) override;
+
+        /** Culls shadow casters per shadow view and appends the compacted draws after the camera's. */
+        void BuildShadowDrawLists();
+
+        /** Rasterizes the chosen occluders on the CPU and clears the visibility of every primitive hidden behind them. */
+        void CullOccludedPrimitives(const TVector<FAABB>& StaticBounds, const TVector<glm::mat4>& StaticMatrices, const TVector<const SStaticMeshComponent*>& StaticComponents,
+            const TVector<FAABB>& SkeletalBounds, TVector<uint8>& OutStaticVisible, TVector<uint8>& OutSkeletalVisible);
+
+        /** Picks the coarsest level of detail whose projected error stays under the pixel limit, with hysteresis against last frame's pick. */
+        uint32 SelectMeshLOD(entt::entity Entity, const FMeshResource& Resource, const FAABB& Bounds, const glm::mat4& Transform);
+
+        /**
+         * The threshold test behind SelectMeshLOD. PixelsPerObjectUnit projects an object space error to screen pixels,
+         * levels coarser than PreviousLOD have to beat the limit shrunk by Hysteresis.
+         */
+        static uint32 PickMeshLOD(const FMeshResource& Resource, float PixelsPerObjectUnit, uint32 PreviousLOD, float MaxPixelError, float Hysteresis);
+
+        /** One instance of a static mesh surface, drawing IndexCount of its indices from StartIndex. */
+        struct FStaticSurfaceDraw
+        {
+            const FGeometrySurface* Surface;
+            uint32                  StartIndex;
+            uint32                  IndexCount;
+            EInstanceFlags          Flags;
+        };
+
+        /**
+         * Appends the draws of a static mesh primitive in the order their instances are emitted. A shadow caster leads with
+         * exactly one full surface draw per surface, in surface order: that run is the instance range ShadowCasterInstances
+         * records and every shadow view draws whole. The camera's meshlet ranges follow it and never cast shadows.
+         * MeshletCuller is null when the primitive is drawn without meshlet culling.
+         */
+        static FMeshletCullResult GatherStaticSurfaceDraws(const SStaticMeshComponent& MeshComponent, const FMeshResource& Resource, const TVector<FGeometrySurface>& Surfaces,
+            EInstanceFlags Flags, const FMeshletCuller* MeshletCuller, uint32 MinCulledMeshlets, TVector<FStaticSurfaceDraw>& OutDraws);
+
+        /** Screen pixels covered by one world unit at the point of the bounds nearest to the camera. */
+        float GetPixelsPerUnit(const FAABB& Bounds) const;
+
+        /** The material a surface is drawn with, the default one stands in until the assigned material is ready. */
+        static CMaterialInterface* GetDrawnMaterial(CMaterialInterface* Material);
+
+        /**
+         * Only opaque, single sided surfaces are rasterized as occluders. Translucent surfaces let what is behind them
+         * show through, and so do cutouts, which are drawn through the translucent path. Two sided surfaces are cards
+         * and foliage that rarely cover what their bounds suggest.
+         */
+        static bool IsOccluderMaterial(CMaterialInterface* Material);
+
+        /**
+         * Renders the point or spot shadow tiles of this frame. Dirty cache tiles get their static casters first,
+         * clean ones are copied into the atlas, then every light draws its remaining casters into its atlas tile.
+         */
+        void RenderShadowTiles(ICommandList& CmdList, ELightType Type, const FRenderPassDesc& RenderPass, FRHIGraphicsPipeline* Pipeline);
                 
         void DrawBillboard(FRHIImage* Image, const glm::vec3& Location, float Scale) override;
         void DrawLine(const glm::vec3& Start, const glm::vec3& End, const glm::vec4& Color, float Thickness, bool bDepthTest, float Duration) override { }
@@ -107,6 +169,9 @@ namespace Lumina
 
         /** Packed array of all light shadows in the scene */
         TArray<TVector<FLightShadow>, (uint32)ELightType::Num>    PackedShadows;
+
+        /** Light entity of each packed shadow, keys the shadow cache across frames. */
+        TArray<TVector<entt::entity>, (uint32)ELightType::Num>    PackedShadowLights;
         
 
         FBindingCache                       BindingCache;
@@ -136,6 +201,7 @@ namespace Lumina
         TVector<glm::mat4>                      BonesData;
         
         FShadowAtlas                            ShadowAtlas;
+        FShadowMapCache                         ShadowMapCache;
         
         FMeshPass DepthMeshPass;
         FMeshPass OpaqueMeshPass;
@@ -147,5 +213,33 @@ namespace Lumina
 
         /** Packed indirect draw arguments, gets sent directly to the GPU */
         TVector<FDrawIndirectArguments>         IndirectDrawArguments;
+
+        /** Meshes above this are only rasterized as occluders when flagged, the CPU rasterizer wants simple shapes. */
+        static constexpr uint32 MaxAutoOccluderTriangles = 4096;
+
+        FSoftwareOcclusionBuffer                OcclusionBuffer;
+
+        FShadowCasterBVH                        ShadowCasterBVH;
+
+        /** Level of detail each primitive was drawn at, this frame's and last frame's. */
+        THashMap<entt::entity, uint8>           MeshLODs;
+        THashMap<entt::entity, uint8>           PreviousMeshLODs;
+
+        /**
+         * Shadow casting primitives gathered this frame, index aligned. Instances are (First, Num) into InstanceData and hold
+         * one full surface instance per surface of the drawn level, see GatherStaticSurfaceDraws.
+         */
+        TVector<entt::entity>                   ShadowCasterEntities;
+        TVector<FAABB>                          ShadowCasterBounds;
+        TVector<glm::uvec2>                     ShadowCasterInstances;
+
+        /** Skinned casters, never baked into the shadow cache. */
+        TVector<uint8>                          ShadowCasterDynamic;
+
+        /** Per shadow view draws, index aligned with PackedShadows. The sun has a single entry for all cascades and is never cached. */
+        TArray<TVector<FShadowViewDraws>, (uint32)ELightType::Num>    ShadowDrawRanges;
+
+        /** Instance indices read by the shadow draws, uploaded to the instance mapping buffer after the camera's. */
+        TVector<uint32>                         ShadowInstanceMapping;
     };
 }
@@ -37,6 +37,9 @@ namespace Lumina
     {
         FRHIVertexShader*                          VertexShader = nullptr;
         FRHIPixelShader*                           PixelShader = nullptr;
+
+        /** Batches are keyed on the parent material, its binding set holds the textures the pixel shader samples. */
+        CMaterialInterface*                        Material = nullptr;
         uint32                                     IndirectDrawOffset = 0;
         THashMap<FDrawKey, uint32>                 DrawArgumentIndexMap;
         uint32                                     DrawCount = 0;
@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "MeshletCulling.h"
+
+#include "Core/Math/Frustum.h"
+#include "Renderer/MeshData.h"
+
+namespace Lumina
+{
+    FMeshletCuller::FMeshletCuller(const glm::mat4& InLocalToWorld, const glm::vec3& ViewPosition, const FFrustum& InFrustum)
+        : LocalToWorld(InLocalToWorld)
+    {
+        eastl::copy(InFrustum.Planes.begin(), InFrustum.Planes.end(), Planes);
+
+        // Facing is invariant under affine transforms, so cones are tested in object space against the viewer moved there.
+        LocalViewPosition   = glm::vec3(glm::inverse(LocalToWorld) * glm::vec4(ViewPosition, 1.0f));
+        MaxScale            = glm::max(glm::length(glm::vec3(LocalToWorld[0])), glm::max(glm::length(glm::vec3(LocalToWorld[1])), glm::length(glm::vec3(LocalToWorld[2]))));
+        bMirrored           = glm::determinant(glm::mat3(LocalToWorld)) < 0.0f;
+    }
+
+    FMeshletCullResult FMeshletCuller::CullSurface(const FMeshResource& Resource, const FGeometrySurface& Surface, bool bConeCull, TVector<glm::uvec2>& OutRanges) const
+    {
+        FMeshletCullResult Result;
+        Result.NumTested = Surface.NumMeshlets;
+
+        const bool bTestCones = bConeCull && !bMirrored;
+        const size_t FirstRange = OutRanges.size();
+
+        for (uint32 i = Surface.FirstMeshlet; i < Surface.FirstMeshlet + Surface.NumMeshlets; ++i)
+        {
+            const FMeshlet& Meshlet = Resource.Meshlets[i];
+
+            bool bVisible = true;
+            if (bTestCones)
+            {
+                const glm::vec3 ToCenter = Meshlet.Center - LocalViewPosition;
+                bVisible = glm::dot(ToCenter, Meshlet.ConeAxis) < Meshlet.ConeCutoff * glm::length(ToCenter) + Meshlet.Radius;
+            }
+
+            if (bVisible)
+            {
+                const glm::vec3 Center  = glm::vec3(LocalToWorld * glm::vec4(Meshlet.Center, 1.0f));
+                const float Radius      = Meshlet.Radius * MaxScale;
+                for (const glm::vec4& Plane : Planes)
+                {
+                    if (glm::dot(glm::vec3(Plane), Center) + Plane.w < -Radius)
+                    {
+                        bVisible = false;
+                        break;
+                    }
+                }
+            }
+
+            if (!bVisible)
+            {
+                Result.NumCulled++;
+                Result.NumTrianglesCulled += Meshlet.IndexCount / 3;
+                continue;
+            }
+
+            // Meshlets of a surface are laid out back to back, a survivor following another extends its range.
+            if (OutRanges.size() > FirstRange && OutRanges.back().x + OutRanges.back().y == Meshlet.StartIndex)
+            {
+                OutRanges.back().y += Meshlet.IndexCount;
+            }
+            else
+            {
+                OutRanges.emplace_back(Meshlet.StartIndex, Meshlet.IndexCount);
+            }
+        }
+
+        return Result;
+    }
+}
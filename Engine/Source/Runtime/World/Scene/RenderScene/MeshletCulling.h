@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include <glm/glm.hpp>
+#include "Containers/Array.h"
+#include "Platform/GenericPlatform.h"
+
+
+namespace Lumina
+{
+    struct FFrustum;
+    struct FGeometrySurface;
+    struct FMeshResource;
+
+    struct FMeshletCullResult
+    {
+        uint32 NumTested            = 0;
+        uint32 NumCulled            = 0;
+        uint32 NumTrianglesCulled   = 0;
+    };
+
+    /**
+     * CPU meshlet culling for a single instance. Meshlets are rejected when their bounding sphere is outside
+     * the view frustum or when their normal cone faces away from the viewer, so a rejected meshlet never has
+     * a triangle the rasterizer would have kept. Surviving meshlets are emitted as index ranges, adjacent ones merged.
+     */
+    class FMeshletCuller
+    {
+    public:
+
+        /** LocalToWorld must be affine, ViewPosition and Frustum are in world space. */
+        FMeshletCuller(const glm::mat4& LocalToWorld, const glm::vec3& ViewPosition, const FFrustum& Frustum);
+
+        /**
+         * Appends the (StartIndex, IndexCount) ranges of the surface's visible meshlets.
+         * Cone culling is skipped for two sided surfaces and mirrored transforms, whose back faces are drawn.
+         */
+        FMeshletCullResult CullSurface(const FMeshResource& Resource, const FGeometrySurface& Surface, bool bConeCull, TVector<glm::uvec2>& OutRanges) const;
+
+    private:
+
+        glm::mat4           LocalToWorld;
+        glm::vec4           Planes[6];
+        glm::vec3           LocalViewPosition;
+        float               MaxScale;
+        bool                bMirrored;
+    };
+}
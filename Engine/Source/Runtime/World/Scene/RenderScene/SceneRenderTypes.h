@@ -105,6 +105,8 @@ namespace Lumina
         Selected        = BIT(2),
         CastShadow      = BIT(3),
         ReceiveShadow   = BIT(4),
+        Occluded        = BIT(5),
+        ShadowOnly      = BIT(6),
     };
     
     ENUM_CLASS_FLAGS(EInstanceFlags);
@@ -383,6 +385,25 @@ namespace Lumina
         uint32 MeshDrawSize;
         uint32 IndirectDrawOffset;
     };
+
+    /** A shadow view's compacted indirect draws, stored after the camera's draws in the indirect buffer. */
+    struct FShadowDrawRange
+    {
+        uint32 IndirectDrawOffset = 0;
+        uint32 DrawCount = 0;
+    };
+
+    /**
+     * Draws of one shadow view. Lights with a cache tile draw Static into it only when the tile is dirty,
+     * then copy the tile into the atlas and draw Dynamic on top. Without a cache tile Dynamic holds every caster.
+     */
+    struct FShadowViewDraws
+    {
+        FShadowDrawRange    Static;
+        FShadowDrawRange    Dynamic;
+        int32               CacheTile = INDEX_NONE;
+        bool                bCacheDirty = false;
+    };
     
     struct FSceneRenderStats
     {
@@ -390,12 +411,19 @@ namespace Lumina
         uint64 NumBatches = 0;
         uint64 NumDraws = 0;
         uint64 NumTriangles = 0;          // Total triangles submitted
+        uint64 NumReducedLODs = 0;        // Primitives drawn below their full level of detail
         uint64 NumInstances = 0;          // Total instances rendered
         uint64 NumMeshes = 0;             // Unique meshes
         uint64 NumMaterials = 0;          // Unique materials used
         uint64 NumDrawCallsCulled = 0;    // Draws culled by frustum/occlusion
         uint64 NumInstancesCulled = 0;    // Instances culled
         uint64 NumShadowDraws = 0;        // Shadow pass draws
+        uint64 NumShadowCacheHits = 0;    // Shadow views that reused their cached static depth
+        uint64 NumShadowCacheMisses = 0;  // Shadow views whose static depth was re-rendered
+        uint64 NumOccluders = 0;          // Meshes rasterized into the software occlusion buffer
+        uint64 NumOcclusionCulled = 0;    // Primitives hidden behind them
+        uint64 NumMeshlets = 0;           // Meshlets tested on the CPU
+        uint64 NumMeshletsCulled = 0;     // Meshlets outside the frustum or facing away
         uint64 NumSkinnedMeshes = 0;      // Skinned vs static count
         uint64 NumStaticMeshes = 0;
     };
@@ -0,0 +1,283 @@
+#include "pch.h"
+#include "ShadowCasterBVH.h"
+
+#include "Core/Math/Frustum.h"
+#include "Core/Profiler/Profile.h"
+
+namespace Lumina
+{
+    namespace
+    {
+        constexpr uint32 MaxLeafCasters = 4;
+
+        FAABB EmptyBounds()
+        {
+            return FAABB(glm::vec3(eastl::numeric_limits<float>::max()), glm::vec3(eastl::numeric_limits<float>::lowest()));
+        }
+
+        void Grow(FAABB& Bounds, const FAABB& Other)
+        {
+            Bounds.Min = glm::min(Bounds.Min, Other.Min);
+            Bounds.Max = glm::max(Bounds.Max, Other.Max);
+        }
+
+        bool SphereOverlaps(const FAABB& Bounds, const glm::vec3& Center, float RadiusSq)
+        {
+            const glm::vec3 Delta = glm::clamp(Center, Bounds.Min, Bounds.Max) - Center;
+            return glm::dot(Delta, Delta) <= RadiusSq;
+        }
+
+        /** Same test as FFrustum::IsInside, without the profiler scope, this runs once per visited node. */
+        bool FrustumOverlaps(const FAABB& Bounds, const FFrustum& Frustum)
+        {
+            for (const glm::vec4& Plane : Frustum.Planes)
+            {
+                const glm::vec3 Positive = glm::vec3(
+                    Plane.x >= 0.0f ? Bounds.Max.x : Bounds.Min.x,
+                    Plane.y >= 0.0f ? Bounds.Max.y : Bounds.Min.y,
+                    Plane.z >= 0.0f ? Bounds.Max.z : Bounds.Min.z);
+
+                if (glm::dot(glm::vec3(Plane), Positive) + Plane.w < 0.0f)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    void FShadowCasterBVH::Update(const TVector<entt::entity>& InEntities, const TVector<FAABB>& Bounds)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        NumRefitted = 0;
+
+        if (Entities != InEntities)
+        {
+            Entities        = InEntities;
+            CasterBounds    = Bounds;
+            Build();
+            return;
+        }
+
+        TVector<uint32> MovedCasters;
+        for (uint32 i = 0; i < (uint32)Bounds.size(); ++i)
+        {
+            if (Bounds[i].Min != CasterBounds[i].Min || Bounds[i].Max != CasterBounds[i].Max)
+            {
+                CasterBounds[i] = Bounds[i];
+                MovedCasters.push_back(i);
+            }
+        }
+
+        if (MovedCasters.empty())
+        {
+            return;
+        }
+
+        if ((float)MovedCasters.size() > (float)CasterBounds.size() * RebuildMovedFraction)
+        {
+            Build();
+            return;
+        }
+
+        Refit(MovedCasters);
+    }
+
+    void FShadowCasterBVH::QuerySphere(const glm::vec3& Center, float Radius, TVector<uint32>& OutCasters) const
+    {
+        const float RadiusSq = Radius * Radius;
+        Query([&](const FAABB& Bounds)
+        {
+            return SphereOverlaps(Bounds, Center, RadiusSq);
+        }, OutCasters);
+    }
+
+    void FShadowCasterBVH::QueryFrustums(const FFrustum* Frustums, uint32 NumFrustums, TVector<uint32>& OutCasters) const
+    {
+        Query([&](const FAABB& Bounds)
+        {
+            for (uint32 i = 0; i < NumFrustums; ++i)
+            {
+                if (FrustumOverlaps(Bounds, Frustums[i]))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }, OutCasters);
+    }
+
+    void FShadowCasterBVH::Reset()
+    {
+        Nodes.clear();
+        Parents.clear();
+        CasterOrder.clear();
+        CasterLeaves.clear();
+        Entities.clear();
+        CasterBounds.clear();
+    }
+
+    void FShadowCasterBVH::Build()
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        const uint32 NumCasters = (uint32)CasterBounds.size();
+
+        Nodes.clear();
+        Parents.clear();
+        CasterOrder.resize(NumCasters);
+        CasterLeaves.resize(NumCasters);
+        NumRebuilds++;
+
+        if (NumCasters == 0)
+        {
+            return;
+        }
+
+        for (uint32 i = 0; i < NumCasters; ++i)
+        {
+            CasterOrder[i] = i;
+        }
+
+        Nodes.reserve(NumCasters * 2);
+        Parents.reserve(NumCasters * 2);
+        Nodes.emplace_back();
+        Parents.push_back(INDEX_NONE);
+
+        BuildNode(0, 0, NumCasters);
+    }
+
+    void FShadowCasterBVH::BuildNode(uint32 NodeIndex, uint32 Begin, uint32 End)
+    {
+        FAABB Bounds = EmptyBounds();
+        FAABB CentroidBounds = EmptyBounds();
+        for (uint32 i = Begin; i < End; ++i)
+        {
+            const FAABB& CasterBox = CasterBounds[CasterOrder[i]];
+            Grow(Bounds, CasterBox);
+
+            const glm::vec3 Centroid = CasterBox.GetCenter();
+            Grow(CentroidBounds, FAABB(Centroid, Centroid));
+        }
+
+        Nodes[NodeIndex].Bounds = Bounds;
+
+        const uint32 Count = End - Begin;
+        const glm::vec3 Extent = CentroidBounds.GetSize();
+        if (Count <= MaxLeafCasters || glm::max(Extent.x, glm::max(Extent.y, Extent.z)) <= 0.0f)
+        {
+            Nodes[NodeIndex].First = Begin;
+            Nodes[NodeIndex].Count = Count;
+            for (uint32 i = Begin; i < End; ++i)
+            {
+                CasterLeaves[CasterOrder[i]] = NodeIndex;
+            }
+            return;
+        }
+
+        // Median split along the widest centroid axis, keeps the tree balanced so queries stay logarithmic.
+        const int Axis = (Extent.x > Extent.y && Extent.x > Extent.z) ? 0 : (Extent.y > Extent.z ? 1 : 2);
+        const uint32 Mid = Begin + Count / 2;
+        eastl::nth_element(CasterOrder.begin() + Begin, CasterOrder.begin() + Mid, CasterOrder.begin() + End, [&](uint32 A, uint32 B)
+        {
+            return CasterBounds[A].GetCenter()[Axis] < CasterBounds[B].GetCenter()[Axis];
+        });
+
+        const uint32 FirstChild = (uint32)Nodes.size();
+        Nodes[NodeIndex].First = FirstChild;
+        Nodes[NodeIndex].Count = 0;
+
+        Nodes.emplace_back();
+        Nodes.emplace_back();
+        Parents.push_back(NodeIndex);
+        Parents.push_back(NodeIndex);
+
+        BuildNode(FirstChild, Begin, Mid);
+        BuildNode(FirstChild + 1, Mid, End);
+    }
+
+    void FShadowCasterBVH::Refit(const TVector<uint32>& MovedCasters)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        NumRefitted = (uint32)MovedCasters.size();
+
+        TVector<uint8> Dirty(Nodes.size(), 0);
+        for (uint32 Caster : MovedCasters)
+        {
+            uint32 Node = CasterLeaves[Caster];
+            while (Node != (uint32)INDEX_NONE && !Dirty[Node])
+            {
+                Dirty[Node] = 1;
+                Node = Parents[Node];
+            }
+        }
+
+        // Children are always allocated after their parent, so a reverse sweep visits them first.
+        for (int64 NodeIndex = (int64)Nodes.size() - 1; NodeIndex >= 0; --NodeIndex)
+        {
+            if (!Dirty[NodeIndex])
+            {
+                continue;
+            }
+
+            FNode& Node = Nodes[NodeIndex];
+            FAABB Bounds = EmptyBounds();
+            if (Node.IsLeaf())
+            {
+                for (uint32 i = Node.First; i < Node.First + Node.Count; ++i)
+                {
+                    Grow(Bounds, CasterBounds[CasterOrder[i]]);
+                }
+            }
+            else
+            {
+                Grow(Bounds, Nodes[Node.First].Bounds);
+                Grow(Bounds, Nodes[Node.First + 1].Bounds);
+            }
+
+            Node.Bounds = Bounds;
+        }
+    }
+
+    template<typename TOverlapFunc>
+    void FShadowCasterBVH::Query(TOverlapFunc&& Overlaps, TVector<uint32>& OutCasters) const
+    {
+        if (Nodes.empty())
+        {
+            return;
+        }
+
+        TFixedVector<uint32, 64> Stack;
+        Stack.push_back(0);
+
+        while (!Stack.empty())
+        {
+            const FNode& Node = Nodes[Stack.back()];
+            Stack.pop_back();
+
+            if (!Overlaps(Node.Bounds))
+            {
+                continue;
+            }
+
+            if (Node.IsLeaf())
+            {
+                for (uint32 i = Node.First; i < Node.First + Node.Count; ++i)
+                {
+                    if (Overlaps(CasterBounds[CasterOrder[i]]))
+                    {
+                        OutCasters.push_back(CasterOrder[i]);
+                    }
+                }
+            }
+            else
+            {
+                Stack.push_back(Node.First);
+                Stack.push_back(Node.First + 1);
+            }
+        }
+    }
+}
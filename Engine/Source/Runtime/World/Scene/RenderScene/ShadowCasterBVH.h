@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "Containers/Array.h"
+#include "Core/Math/AABB.h"
+#include "Platform/GenericPlatform.h"
+#include <entt/entt.hpp>
+
+
+namespace Lumina
+{
+    struct FFrustum;
+
+    /**
+     * CPU bounding volume hierarchy over the shadow casting primitives of a scene.
+     * The tree persists across frames: when the caster set is unchanged only the boxes of moved casters
+     * and their ancestors are refitted, it is only rebuilt when casters are added, removed or reordered.
+     */
+    class FShadowCasterBVH
+    {
+    public:
+
+        /** Rebuilds past this fraction of moved casters, refitting would leave the tree too loose. */
+        static constexpr float RebuildMovedFraction = 0.5f;
+
+        /**
+         * Synchronizes the tree with this frame's casters, Entities and Bounds are index aligned.
+         * Query results index into these arrays.
+         */
+        void Update(const TVector<entt::entity>& Entities, const TVector<FAABB>& Bounds);
+
+        /** Appends the indices of every caster whose box touches the sphere. */
+        void QuerySphere(const glm::vec3& Center, float Radius, TVector<uint32>& OutCasters) const;
+
+        /** Appends the indices of every caster whose box touches any of the frustums. */
+        void QueryFrustums(const FFrustum* Frustums, uint32 NumFrustums, TVector<uint32>& OutCasters) const;
+
+        void Reset();
+
+        uint32 GetNumCasters() const { return (uint32)Entities.size(); }
+        uint32 GetNumNodes() const { return (uint32)Nodes.size(); }
+        uint32 GetNumRebuilds() const { return NumRebuilds; }
+        uint32 GetNumRefitted() const { return NumRefitted; }
+
+    private:
+
+        struct FNode
+        {
+            FAABB   Bounds;
+
+            /** Leaves index into CasterOrder, interior nodes store their first child, the second child follows it. */
+            uint32  First = 0;
+            uint32  Count = 0;
+
+            bool IsLeaf() const { return Count != 0; }
+        };
+
+        void Build();
+        void BuildNode(uint32 NodeIndex, uint32 Begin, uint32 End);
+        void Refit(const TVector<uint32>& MovedCasters);
+
+        template<typename TOverlapFunc>
+        void Query(TOverlapFunc&& Overlaps, TVector<uint32>& OutCasters) const;
+
+        TVector<FNode>          Nodes;
+        TVector<uint32>         Parents;
+        TVector<uint32>         CasterOrder;
+        TVector<uint32>         CasterLeaves;
+        TVector<entt::entity>   Entities;
+        TVector<FAABB>          CasterBounds;
+
+        uint32                  NumRebuilds = 0;
+        uint32                  NumRefitted = 0;
+    };
+}
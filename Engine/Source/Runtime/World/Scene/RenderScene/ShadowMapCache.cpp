@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "ShadowMapCache.h"
+
+#include "Core/Profiler/Profile.h"
+
+namespace Lumina
+{
+    namespace
+    {
+        bool SphereOverlaps(const FAABB& Bounds, const glm::vec3& Center, float Radius)
+        {
+            const glm::vec3 Delta = glm::clamp(Center, Bounds.Min, Bounds.Max) - Center;
+            return glm::dot(Delta, Delta) <= Radius * Radius;
+        }
+    }
+
+    FShadowMapCache::FShadowMapCache(const FShadowAtlasConfig& InConfig)
+        : Config(InConfig)
+    {
+        Reset();
+    }
+
+    void FShadowMapCache::UpdateCasters(const TVector<entt::entity>& Entities, const TVector<FAABB>& Bounds, const TVector<uint8>& AlwaysDynamic)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        FrameIndex++;
+        ChangedRegions.clear();
+        CasterStatic.assign(Entities.size(), 0);
+
+        for (uint32 i = 0; i < (uint32)Entities.size(); ++i)
+        {
+            auto [It, bNew] = Casters.try_emplace(Entities[i]);
+            FCasterState& State = It->second;
+            State.LastSeenFrame = FrameIndex;
+
+            const bool bMoved = !bNew && (State.Bounds.Min != Bounds[i].Min || State.Bounds.Max != Bounds[i].Max);
+            if (bNew || bMoved || AlwaysDynamic[i])
+            {
+                // Its old depth is still baked into the lights around where it used to be.
+                if (State.bBaked)
+                {
+                    ChangedRegions.push_back(State.Bounds);
+                    State.bBaked = false;
+                }
+
+                State.Bounds        = Bounds[i];
+                State.StillFrames   = 0;
+            }
+            else if (!State.bBaked && ++State.StillFrames >= SettleFrames)
+            {
+                State.bBaked = true;
+                ChangedRegions.push_back(State.Bounds);
+            }
+
+            CasterStatic[i] = State.bBaked;
+        }
+
+        for (auto It = Casters.begin(); It != Casters.end();)
+        {
+            if (It->second.LastSeenFrame != FrameIndex)
+            {
+                if (It->second.bBaked)
+                {
+                    ChangedRegions.push_back(It->second.Bounds);
+                }
+                It = Casters.erase(It);
+            }
+            else
+            {
+                ++It;
+            }
+        }
+    }
+
+    void FShadowMapCache::UpdateLights(const TVector<FShadowCacheLight>& InLights, TVector<FShadowCacheSlot>& OutSlots)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        NumInvalidated = 0;
+        OutSlots.resize(InLights.size());
+
+        for (uint32 i = 0; i < (uint32)InLights.size(); ++i)
+        {
+            const FShadowCacheLight& Light = InLights[i];
+
+            auto [It, bNew] = Lights.try_emplace(Light.Key);
+            FLightState& State = It->second;
+            State.LastSeenFrame = FrameIndex;
+
+            bool bDirty = bNew || State.ViewHash != Light.ViewHash;
+            if (State.CacheTile == INDEX_NONE && !FreeTiles.empty())
+            {
+                State.CacheTile = FreeTiles.back();
+                FreeTiles.pop_back();
+                bDirty = true;
+            }
+
+            for (uint32 Region = 0; Region < (uint32)ChangedRegions.size() && !bDirty; ++Region)
+            {
+                bDirty = SphereOverlaps(ChangedRegions[Region], Light.Center, Light.Radius);
+            }
+
+            State.ViewHash = Light.ViewHash;
+
+            OutSlots[i].CacheTile   = State.CacheTile;
+            OutSlots[i].bDirty      = bDirty && State.CacheTile != INDEX_NONE;
+            NumInvalidated += OutSlots[i].bDirty;
+        }
+
+        for (auto It = Lights.begin(); It != Lights.end();)
+        {
+            if (It->second.LastSeenFrame != FrameIndex)
+            {
+                if (It->second.CacheTile != INDEX_NONE)
+                {
+                    FreeTiles.push_back(It->second.CacheTile);
+                }
+                It = Lights.erase(It);
+            }
+            else
+            {
+                ++It;
+            }
+        }
+    }
+
+    void FShadowMapCache::Reset()
+    {
+        Casters.clear();
+        Lights.clear();
+        CasterStatic.clear();
+        ChangedRegions.clear();
+        NumInvalidated = 0;
+
+        // Popped from the back, so lights are handed tiles in ascending order.
+        FreeTiles.clear();
+        for (int32 Tile = (int32)Config.MaxTiles() - 1; Tile >= 0; --Tile)
+        {
+            FreeTiles.push_back(Tile);
+        }
+    }
+
+    FRHIImage* FShadowMapCache::GetImage()
+    {
+        if (!Image)
+        {
+            FRHIImageDesc ImageDesc;
+            ImageDesc.Extent            = glm::uvec2(Config.AtlasResolution);
+            ImageDesc.Format            = EFormat::D32;
+            ImageDesc.bKeepInitialState = true;
+            ImageDesc.InitialState      = EResourceStates::DepthWrite;
+            ImageDesc.Dimension         = EImageDimension::Texture2DArray;
+            ImageDesc.ArraySize         = (uint16)Config.NumLayers;
+            ImageDesc.Flags.SetFlag(EImageCreateFlags::DepthAttachment);
+            ImageDesc.DebugName         = "Shadow Cache";
+
+            Image = GRenderContext->CreateImage(ImageDesc);
+        }
+
+        return Image;
+    }
+}
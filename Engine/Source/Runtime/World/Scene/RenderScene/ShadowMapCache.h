@@ -0,0 +1,100 @@
+﻿#pragma once
+
+#include "Containers/Array.h"
+#include "Core/Math/AABB.h"
+#include "Platform/GenericPlatform.h"
+#include "SceneRenderTypes.h"
+#include <entt/entt.hpp>
+
+
+namespace Lumina
+{
+    /** A shadowed light as seen by the cache, Key identifies the light across frames. */
+    struct FShadowCacheLight
+    {
+        uint64      Key = 0;
+
+        /** Hash of everything the light's shadow views are built from, a change re-renders its cached depth. */
+        uint64      ViewHash = 0;
+
+        /** Bounding sphere of the light's influence, casters changing inside it invalidate the cached depth. */
+        glm::vec3   Center = glm::vec3(0.0f);
+        float       Radius = 0.0f;
+    };
+
+    struct FShadowCacheSlot
+    {
+        /** Tile of the cache image owned by the light, INDEX_NONE when the cache is full and the light renders uncached. */
+        int32       CacheTile = INDEX_NONE;
+
+        /** The static casters must be rendered into the cache tile again this frame. */
+        bool        bDirty = false;
+    };
+
+    /**
+     * Keeps the depth of static shadow casters per light in a second atlas, so lights whose static casters
+     * did not change only composite their dynamic casters on top of a copy of the cached tile.
+     *
+     * There is no authored mobility, a caster counts as static once its bounds stayed put for SettleFrames frames.
+     * Casters moving out of the static set, settling into it, or disappearing invalidate every light they overlap.
+     */
+    class FShadowMapCache
+    {
+    public:
+
+        /** Frames a caster must stay still before it is baked into the cached depth of the lights around it. */
+        static constexpr uint32 SettleFrames = 30;
+
+        FShadowMapCache(const FShadowAtlasConfig& InConfig);
+
+        /**
+         * Tracks this frame's casters, index aligned with the arrays handed to FShadowCasterBVH.
+         * Casters flagged in AlwaysDynamic (skinned meshes) are never baked.
+         */
+        void UpdateCasters(const TVector<entt::entity>& Entities, const TVector<FAABB>& Bounds, const TVector<uint8>& AlwaysDynamic);
+
+        /** Assigns each light its persistent cache tile and decides whether it must be re-rendered, OutSlots is index aligned with Lights. */
+        void UpdateLights(const TVector<FShadowCacheLight>& Lights, TVector<FShadowCacheSlot>& OutSlots);
+
+        /** Forgets every caster and light, the next update re-renders all of them. */
+        void Reset();
+
+        bool IsCasterStatic(uint32 CasterIndex) const { return CasterStatic[CasterIndex] != 0; }
+
+        /** Created on first use, the cache costs nothing while r.ShadowCache is off. */
+        FRHIImage* GetImage();
+
+        uint32 GetNumInvalidated() const { return NumInvalidated; }
+
+    private:
+
+        struct FCasterState
+        {
+            FAABB   Bounds;
+            uint64  LastSeenFrame = 0;
+            uint32  StillFrames = 0;
+            bool    bBaked = false;
+        };
+
+        struct FLightState
+        {
+            uint64  ViewHash = 0;
+            uint64  LastSeenFrame = 0;
+            int32   CacheTile = INDEX_NONE;
+        };
+
+        FShadowAtlasConfig                      Config;
+        FRHIImageRef                            Image;
+
+        THashMap<entt::entity, FCasterState>    Casters;
+        THashMap<uint64, FLightState>           Lights;
+        TVector<uint8>                          CasterStatic;
+        TVector<int32>                          FreeTiles;
+
+        /** Bounds whose baked depth changed this frame, in world space. */
+        TVector<FAABB>                          ChangedRegions;
+
+        uint64                                  FrameIndex = 0;
+        uint32                                  NumInvalidated = 0;
+    };
+}
@@ -0,0 +1,348 @@
+#include "pch.h"
+#include "SoftwareOcclusion.h"
+
+#include "Core/Profiler/Profile.h"
+#include "TaskSystem/TaskSystem.h"
+
+#if defined(LUMINA_PLATFORM_CPU_X86_64)
+    #include <immintrin.h>
+#endif
+
+namespace Lumina
+{
+    namespace
+    {
+        /** Clip space w below which a vertex counts as behind the camera. */
+        constexpr float MinClipW = 1e-4f;
+
+        /** Edge function coefficients, E(x, y) = A * x + B * y + C is positive inside the triangle. */
+        struct FEdge
+        {
+            float A, B, C;
+
+            FEdge(const glm::vec2& From, const glm::vec2& To)
+                : A(From.y - To.y)
+                , B(To.x - From.x)
+                , C(-(A * From.x + B * From.y))
+            {}
+
+            void Flip() { A = -A; B = -B; C = -C; }
+        };
+    }
+
+    FSoftwareOcclusionBuffer::FSoftwareOcclusionBuffer(uint32 InWidth, uint32 InHeight)
+        : Width((glm::max(InWidth, 4u) + 3u) & ~3u)
+        , Height(glm::max(InHeight, 1u))
+    {
+        glm::uvec2 Size = glm::uvec2(Width, Height);
+        while (true)
+        {
+            LevelSizes.push_back(Size);
+            Levels.emplace_back(Size.x * Size.y, 0.0f);
+
+            if (Size.x == 1 && Size.y == 1)
+            {
+                break;
+            }
+            Size = glm::max((Size + 1u) / 2u, glm::uvec2(1));
+        }
+    }
+
+    void FSoftwareOcclusionBuffer::Begin(const glm::mat4& InViewProjection)
+    {
+        ViewProjection = InViewProjection;
+        Triangles.clear();
+    }
+
+    void FSoftwareOcclusionBuffer::AddOccluder(const void* Positions, uint32 PositionStride, uint32 NumVertices, const uint32* Indices, uint32 NumIndices, const glm::mat4& LocalToWorld)
+    {
+        const glm::mat4 LocalToClip = ViewProjection * LocalToWorld;
+        const glm::vec2 ScreenScale = glm::vec2((float)Width, (float)Height) * 0.5f;
+
+        ClipScratch.resize(NumVertices);
+        const uint8* PositionBytes = static_cast<const uint8*>(Positions);
+        for (uint32 i = 0; i < NumVertices; ++i)
+        {
+            const glm::vec3& Position = *reinterpret_cast<const glm::vec3*>(PositionBytes + (SIZE_T)i * PositionStride);
+            ClipScratch[i] = LocalToClip * glm::vec4(Position, 1.0f);
+        }
+
+        for (uint32 i = 0; i + 2 < NumIndices; i += 3)
+        {
+            const glm::vec4& V0 = ClipScratch[Indices[i]];
+            const glm::vec4& V1 = ClipScratch[Indices[i + 1]];
+            const glm::vec4& V2 = ClipScratch[Indices[i + 2]];
+
+            if (V0.w < MinClipW || V1.w < MinClipW || V2.w < MinClipW)
+            {
+                continue;
+            }
+
+            FScreenTriangle Triangle;
+            Triangle.InvW = glm::vec3(1.0f / V0.w, 1.0f / V1.w, 1.0f / V2.w);
+
+            const glm::vec4* Vertices[3] = { &V0, &V1, &V2 };
+            for (int Corner = 0; Corner < 3; ++Corner)
+            {
+                const glm::vec2 NDC = glm::vec2(*Vertices[Corner]) * Triangle.InvW[Corner];
+                Triangle.Positions[Corner] = (NDC + 1.0f) * ScreenScale;
+            }
+
+            const glm::vec2 Min = glm::min(Triangle.Positions[0], glm::min(Triangle.Positions[1], Triangle.Positions[2]));
+            const glm::vec2 Max = glm::max(Triangle.Positions[0], glm::max(Triangle.Positions[1], Triangle.Positions[2]));
+            if (Max.x < 0.0f || Max.y < 0.0f || Min.x >= (float)Width || Min.y >= (float)Height)
+            {
+                continue;
+            }
+
+            Triangles.push_back(Triangle);
+        }
+    }
+
+    void FSoftwareOcclusionBuffer::AddOccluderBox(const FAABB& Box)
+    {
+        const glm::vec3 Corners[8] =
+        {
+            { Box.Min.x, Box.Min.y, Box.Min.z }, { Box.Max.x, Box.Min.y, Box.Min.z },
+            { Box.Min.x, Box.Max.y, Box.Min.z }, { Box.Max.x, Box.Max.y, Box.Min.z },
+            { Box.Min.x, Box.Min.y, Box.Max.z }, { Box.Max.x, Box.Min.y, Box.Max.z },
+            { Box.Min.x, Box.Max.y, Box.Max.z }, { Box.Max.x, Box.Max.y, Box.Max.z },
+        };
+
+        static constexpr uint32 BoxIndices[36] =
+        {
+            0, 2, 1,  1, 2, 3,      // -Z
+            4, 5, 6,  5, 7, 6,      // +Z
+            0, 1, 4,  1, 5, 4,      // -Y
+            2, 6, 3,  3, 6, 7,      // +Y
+            0, 4, 2,  2, 4, 6,      // -X
+            1, 3, 5,  3, 7, 5,      // +X
+        };
+
+        AddOccluder(Corners, sizeof(glm::vec3), 8, BoxIndices, 36, glm::mat4(1.0f));
+    }
+
+    void FSoftwareOcclusionBuffer::Rasterize()
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        eastl::fill(Levels[0].begin(), Levels[0].end(), 0.0f);
+
+        // Bands own disjoint rows, so every task writes its own part of the buffer without synchronization.
+        const uint32 NumBands = (Height + BandHeight - 1) / BandHeight;
+        Task::ParallelFor(NumBands, [&](uint32 Band)
+        {
+            RasterizeBand(Band * BandHeight, glm::min((Band + 1) * BandHeight, Height));
+        });
+
+        BuildHierarchy();
+    }
+
+    void FSoftwareOcclusionBuffer::RasterizeBand(uint32 FirstRow, uint32 EndRow)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        for (const FScreenTriangle& Triangle : Triangles)
+        {
+            RasterizeTriangle(Triangle, FirstRow, EndRow);
+        }
+    }
+
+    void FSoftwareOcclusionBuffer::RasterizeTriangle(const FScreenTriangle& Triangle, uint32 FirstRow, uint32 EndRow)
+    {
+        const glm::vec2& P0 = Triangle.Positions[0];
+        const glm::vec2& P1 = Triangle.Positions[1];
+        const glm::vec2& P2 = Triangle.Positions[2];
+
+        const glm::vec2 Min = glm::min(P0, glm::min(P1, P2));
+        const glm::vec2 Max = glm::max(P0, glm::max(P1, P2));
+
+        // Pixel centers sit at +0.5, only rows and columns whose center can be covered are walked.
+        const int32 MinY = glm::max((int32)FirstRow, (int32)glm::ceil(Min.y - 0.5f));
+        const int32 MaxY = glm::min((int32)EndRow - 1, (int32)glm::floor(Max.y - 0.5f));
+        const int32 MinX = glm::max(0, (int32)glm::ceil(Min.x - 0.5f)) & ~3;
+        const int32 MaxX = glm::min((int32)Width - 1, (int32)glm::floor(Max.x - 0.5f));
+        if (MinY > MaxY || MinX > MaxX)
+        {
+            return;
+        }
+
+        FEdge E12(P1, P2), E20(P2, P0), E01(P0, P1);
+        float Area = E01.A * P2.x + E01.B * P2.y + E01.C;
+        if (glm::abs(Area) < 1e-8f)
+        {
+            return;
+        }
+
+        // Occluders are drawn double sided, flipping makes the inside positive whatever the winding.
+        if (Area < 0.0f)
+        {
+            E12.Flip();
+            E20.Flip();
+            E01.Flip();
+            Area = -Area;
+        }
+
+        // 1/w is affine in screen space, fold the barycentric weights into a single plane.
+        const float InvArea = 1.0f / Area;
+        const float ZA = (E12.A * Triangle.InvW[0] + E20.A * Triangle.InvW[1] + E01.A * Triangle.InvW[2]) * InvArea;
+        const float ZB = (E12.B * Triangle.InvW[0] + E20.B * Triangle.InvW[1] + E01.B * Triangle.InvW[2]) * InvArea;
+        const float ZC = (E12.C * Triangle.InvW[0] + E20.C * Triangle.InvW[1] + E01.C * Triangle.InvW[2]) * InvArea;
+
+        float* Depth = Levels[0].data();
+
+        #if defined(LUMINA_PLATFORM_CPU_X86_64)
+
+        const __m128 LaneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 A0 = _mm_set1_ps(E12.A), A1 = _mm_set1_ps(E20.A), A2 = _mm_set1_ps(E01.A), AZ = _mm_set1_ps(ZA);
+        const __m128 Zero = _mm_setzero_ps();
+
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            const float PY = (float)Y + 0.5f;
+            const __m128 Row0 = _mm_set1_ps(E12.B * PY + E12.C);
+            const __m128 Row1 = _mm_set1_ps(E20.B * PY + E20.C);
+            const __m128 Row2 = _mm_set1_ps(E01.B * PY + E01.C);
+            const __m128 RowZ = _mm_set1_ps(ZB * PY + ZC);
+
+            float* DepthRow = Depth + (SIZE_T)Y * Width;
+            for (int32 X = MinX; X <= MaxX; X += 4)
+            {
+                const __m128 PX = _mm_add_ps(_mm_set1_ps((float)X), LaneOffsets);
+
+                const __m128 W0 = _mm_add_ps(_mm_mul_ps(A0, PX), Row0);
+                const __m128 W1 = _mm_add_ps(_mm_mul_ps(A1, PX), Row1);
+                const __m128 W2 = _mm_add_ps(_mm_mul_ps(A2, PX), Row2);
+
+                const __m128 Inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(W0, Zero), _mm_cmpge_ps(W1, Zero)), _mm_cmpge_ps(W2, Zero));
+                if (_mm_movemask_ps(Inside) == 0)
+                {
+                    continue;
+                }
+
+                const __m128 Z = _mm_add_ps(_mm_mul_ps(AZ, PX), RowZ);
+                const __m128 Old = _mm_loadu_ps(DepthRow + X);
+                const __m128 New = _mm_max_ps(Old, Z);
+                _mm_storeu_ps(DepthRow + X, _mm_or_ps(_mm_and_ps(Inside, New), _mm_andnot_ps(Inside, Old)));
+            }
+        }
+
+        #else
+
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            const float PY = (float)Y + 0.5f;
+            float* DepthRow = Depth + (SIZE_T)Y * Width;
+            for (int32 X = MinX; X <= MaxX; ++X)
+            {
+                const float PX = (float)X + 0.5f;
+                if (E12.A * PX + E12.B * PY + E12.C >= 0.0f && E20.A * PX + E20.B * PY + E20.C >= 0.0f && E01.A * PX + E01.B * PY + E01.C >= 0.0f)
+                {
+                    DepthRow[X] = glm::max(DepthRow[X], ZA * PX + ZB * PY + ZC);
+                }
+            }
+        }
+
+        #endif
+    }
+
+    void FSoftwareOcclusionBuffer::BuildHierarchy()
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        for (uint32 Level = 1; Level < (uint32)Levels.size(); ++Level)
+        {
+            const glm::uvec2 ParentSize = LevelSizes[Level - 1];
+            const glm::uvec2 Size       = LevelSizes[Level];
+            const TVector<float>& Parent = Levels[Level - 1];
+            TVector<float>& Current = Levels[Level];
+
+            for (uint32 Y = 0; Y < Size.y; ++Y)
+            {
+                const uint32 Y0 = Y * 2;
+                const uint32 Y1 = glm::min(Y0 + 1, ParentSize.y - 1);
+                for (uint32 X = 0; X < Size.x; ++X)
+                {
+                    const uint32 X0 = X * 2;
+                    const uint32 X1 = glm::min(X0 + 1, ParentSize.x - 1);
+
+                    // The farthest occluder of the four, a box nearer than that is in front of all of them.
+                    Current[Y * Size.x + X] = glm::min(
+                        glm::min(Parent[Y0 * ParentSize.x + X0], Parent[Y0 * ParentSize.x + X1]),
+                        glm::min(Parent[Y1 * ParentSize.x + X0], Parent[Y1 * ParentSize.x + X1]));
+                }
+            }
+        }
+    }
+
+    bool FSoftwareOcclusionBuffer::IsVisible(const FAABB& Bounds) const
+    {
+        const glm::vec2 ScreenScale = glm::vec2((float)Width, (float)Height) * 0.5f;
+
+        glm::vec2 Min = glm::vec2(eastl::numeric_limits<float>::max());
+        glm::vec2 Max = glm::vec2(eastl::numeric_limits<float>::lowest());
+        float NearestInvW = 0.0f;
+
+        for (uint32 Corner = 0; Corner < 8; ++Corner)
+        {
+            const glm::vec3 Position = glm::vec3(
+                (Corner & 1) ? Bounds.Max.x : Bounds.Min.x,
+                (Corner & 2) ? Bounds.Max.y : Bounds.Min.y,
+                (Corner & 4) ? Bounds.Max.z : Bounds.Min.z);
+
+            const glm::vec4 Clip = ViewProjection * glm::vec4(Position, 1.0f);
+
+            // w is affine, so the nearest point of the box is one of its corners. Boxes reaching behind the camera are never culled.
+            if (Clip.w < MinClipW)
+            {
+                return true;
+            }
+
+            const float InvW = 1.0f / Clip.w;
+            const glm::vec2 Screen = (glm::vec2(Clip) * InvW + 1.0f) * ScreenScale;
+            Min = glm::min(Min, Screen);
+            Max = glm::max(Max, Screen);
+            NearestInvW = glm::max(NearestInvW, InvW);
+        }
+
+        // Off screen boxes are left to frustum culling.
+        if (Max.x < 0.0f || Max.y < 0.0f || Min.x >= (float)Width || Min.y >= (float)Height)
+        {
+            return true;
+        }
+
+        // One texel of margin absorbs the coverage the rasterizer decides at pixel centers.
+        int32 X0 = glm::max(0, (int32)glm::floor(Min.x) - 1);
+        int32 Y0 = glm::max(0, (int32)glm::floor(Min.y) - 1);
+        int32 X1 = glm::min((int32)Width - 1, (int32)glm::floor(Max.x) + 1);
+        int32 Y1 = glm::min((int32)Height - 1, (int32)glm::floor(Max.y) + 1);
+
+        // The finest level where the rect spans at most four texels a side.
+        uint32 Level = 0;
+        while (Level + 1 < (uint32)Levels.size() && ((X1 - X0) > 3 || (Y1 - Y0) > 3))
+        {
+            X0 >>= 1; Y0 >>= 1; X1 >>= 1; Y1 >>= 1;
+            ++Level;
+        }
+
+        const TVector<float>& Depth = Levels[Level];
+        const uint32 LevelWidth = LevelSizes[Level].x;
+        for (int32 Y = Y0; Y <= Y1; ++Y)
+        {
+            for (int32 X = X0; X <= X1; ++X)
+            {
+                if (Depth[Y * LevelWidth + X] <= NearestInvW)
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    float FSoftwareOcclusionBuffer::GetDepth(uint32 X, uint32 Y, uint32 Level) const
+    {
+        return Levels[Level][Y * LevelSizes[Level].x + X];
+    }
+}
@@ -0,0 +1,78 @@
+﻿#pragma once
+
+#include <glm/glm.hpp>
+#include "Containers/Array.h"
+#include "Core/Math/AABB.h"
+#include "Platform/GenericPlatform.h"
+
+
+namespace Lumina
+{
+    /**
+     * Low resolution depth buffer the CPU rasterizes occluder meshes into, with a min depth hierarchy on top
+     * so boxes can be tested against it before anything is submitted. It stores 1/w, so it works with any
+     * perspective projection, reversed or not, and touches no RHI state so it runs headless.
+     */
+    class FSoftwareOcclusionBuffer
+    {
+    public:
+
+        static constexpr uint32 DefaultWidth    = 256;
+        static constexpr uint32 DefaultHeight   = 128;
+
+        /** Rows rasterized by one worker task. */
+        static constexpr uint32 BandHeight      = 16;
+
+        /** The width is rounded up to a multiple of four, the rasterizer shades four pixels at a time. */
+        FSoftwareOcclusionBuffer(uint32 InWidth = DefaultWidth, uint32 InHeight = DefaultHeight);
+
+        /** Starts a frame seen through ViewProjection, dropping the previous frame's occluders. */
+        void Begin(const glm::mat4& ViewProjection);
+
+        /**
+         * Queues the triangles of an occluder mesh, positions are read with PositionStride bytes between them.
+         * Triangles crossing the near plane are dropped, occluding less is always safe.
+         */
+        void AddOccluder(const void* Positions, uint32 PositionStride, uint32 NumVertices, const uint32* Indices, uint32 NumIndices, const glm::mat4& LocalToWorld);
+
+        /** Queues the twelve triangles of a solid world space box. */
+        void AddOccluderBox(const FAABB& Box);
+
+        /** Rasterizes every queued triangle, rows split across worker tasks, then builds the depth hierarchy. */
+        void Rasterize();
+
+        /** Conservative, false only when every texel under the box's screen rect holds an occluder nearer than the box. */
+        bool IsVisible(const FAABB& Bounds) const;
+
+        /** 1/w of the farthest occluder in the texel, 0 where nothing was drawn. */
+        float GetDepth(uint32 X, uint32 Y, uint32 Level = 0) const;
+
+        uint32 GetWidth() const { return Width; }
+        uint32 GetHeight() const { return Height; }
+        uint32 GetNumLevels() const { return (uint32)Levels.size(); }
+        uint32 GetNumTriangles() const { return (uint32)Triangles.size(); }
+
+    private:
+
+        struct FScreenTriangle
+        {
+            glm::vec2   Positions[3];
+            glm::vec3   InvW;
+        };
+
+        void RasterizeBand(uint32 FirstRow, uint32 EndRow);
+        void RasterizeTriangle(const FScreenTriangle& Triangle, uint32 FirstRow, uint32 EndRow);
+        void BuildHierarchy();
+
+        glm::mat4                   ViewProjection = glm::mat4(1.0f);
+        uint32                      Width = 0;
+        uint32                      Height = 0;
+
+        TVector<FScreenTriangle>    Triangles;
+        TVector<glm::vec4>          ClipScratch;
+
+        /** Level 0 is full resolution, every next level halves it and keeps the farthest of its four texels. */
+        TVector<TVector<float>>     Levels;
+        TVector<glm::uvec2>         LevelSizes;
+    };
+}
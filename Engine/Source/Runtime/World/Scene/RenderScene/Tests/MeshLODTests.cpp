@@ -0,0 +1,295 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Assets/AssetTypes/Mesh/StaticMesh/StaticMesh.h"
+#include "Assets/AssetTypes/Textures/Texture.h"
+#include "Core/Object/Package/Package.h"
+#include "FileSystem/FileSystem.h"
+#include "Renderer/MeshData.h"
+#include "Renderer/TextureData.h"
+#include "Tools/Import/ImportHelpers.h"
+#include "World/Scene/RenderScene/Forward/ForwardRenderScene.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** A closed unit sphere with shared vertices and a single surface, simplifying it has no seams or borders to respect. */
+        TUniquePtr<FMeshResource> MakeSphere(uint32 Rings, uint32 Segments)
+        {
+            TUniquePtr<FMeshResource> Resource = MakeUnique<FMeshResource>();
+            Resource->Name = FName("LODSphere");
+
+            TVector<FVertex> Vertices;
+            auto AddVertex = [&](const glm::vec3& Position)
+            {
+                FVertex& Vertex = Vertices.emplace_back();
+                Vertex.Position = Position;
+                Vertex.Normal = PackNormal(Position);
+                Vertex.UV = glm::u16vec2(0);
+                Vertex.Color = 0xFFFFFFFF;
+            };
+
+            AddVertex(glm::vec3(0.0f, 1.0f, 0.0f));
+            for (uint32 Ring = 1; Ring < Rings; ++Ring)
+            {
+                const float Theta = glm::pi<float>() * static_cast<float>(Ring) / static_cast<float>(Rings);
+                for (uint32 Segment = 0; Segment < Segments; ++Segment)
+                {
+                    const float Phi = glm::two_pi<float>() * static_cast<float>(Segment) / static_cast<float>(Segments);
+                    AddVertex(glm::vec3(glm::sin(Theta) * glm::cos(Phi), glm::cos(Theta), glm::sin(Theta) * glm::sin(Phi)));
+                }
+            }
+            AddVertex(glm::vec3(0.0f, -1.0f, 0.0f));
+
+            const uint32 Bottom = (uint32)Vertices.size() - 1;
+            auto RingVertex = [&](uint32 Ring, uint32 Segment)
+            {
+                return 1 + (Ring - 1) * Segments + Segment % Segments;
+            };
+
+            TVector<uint32>& Indices = Resource->Indices;
+            for (uint32 Segment = 0; Segment < Segments; ++Segment)
+            {
+                Indices.insert(Indices.end(), { 0, RingVertex(1, Segment + 1), RingVertex(1, Segment) });
+                Indices.insert(Indices.end(), { Bottom, RingVertex(Rings - 1, Segment), RingVertex(Rings - 1, Segment + 1) });
+
+                for (uint32 Ring = 1; Ring < Rings - 1; ++Ring)
+                {
+                    const uint32 A = RingVertex(Ring, Segment);
+                    const uint32 B = RingVertex(Ring, Segment + 1);
+                    const uint32 C = RingVertex(Ring + 1, Segment);
+                    const uint32 D = RingVertex(Ring + 1, Segment + 1);
+                    Indices.insert(Indices.end(), { A, B, C, B, D, C });
+                }
+            }
+
+            Resource->Vertices = Move(Vertices);
+
+            FGeometrySurface& Surface = Resource->GeometrySurfaces.emplace_back();
+            Surface.ID = FName("Sphere");
+            Surface.IndexCount = (uint32)Indices.size();
+            Surface.StartIndex = 0;
+            Surface.MaterialIndex = 0;
+
+            return Resource;
+        }
+
+        /** How far the level's triangles sag away from the unit sphere, measured at their centroids. */
+        float GetMaxDeviation(const FMeshResource& Resource, uint32 LOD)
+        {
+            float MaxDeviation = 0.0f;
+            for (const FGeometrySurface& Surface : Resource.GetLODSurfaces(LOD))
+            {
+                for (uint32 i = Surface.StartIndex; i + 2 < Surface.StartIndex + Surface.IndexCount; i += 3)
+                {
+                    const glm::vec3 Centroid = (Resource.GetPositionAt(Resource.Indices[i]) + Resource.GetPositionAt(Resource.Indices[i + 1]) + Resource.GetPositionAt(Resource.Indices[i + 2])) / 3.0f;
+                    MaxDeviation = glm::max(MaxDeviation, glm::abs(1.0f - glm::length(Centroid)));
+                }
+            }
+            return MaxDeviation;
+        }
+
+        /** Deserializes a saved object into a fresh one straight from the package loader, PostLoad would create GPU resources the tests have no use for. */
+        template<typename T>
+        T* LoadExport(CPackage* Package, const CObject* Saved)
+        {
+            for (const FObjectExport& Export : Package->ExportTable)
+            {
+                if (Export.ObjectGUID == Saved->GetGUID())
+                {
+                    T* Loaded = NewObject<T>(OF_Transient);
+                    Loaded->PreLoad();
+                    Package->GetLoader()->Seek(Export.Offset);
+                    Loaded->Serialize(*Package->GetLoader());
+                    return Loaded;
+                }
+            }
+            return nullptr;
+        }
+
+        /** Level errors of 0.01, 0.02 and 0.04 object space units behind a full detail level. */
+        TUniquePtr<FMeshResource> MakeLODChain()
+        {
+            TUniquePtr<FMeshResource> Resource = MakeUnique<FMeshResource>();
+            for (float Error : { 0.01f, 0.02f, 0.04f })
+            {
+                Resource->LODs.emplace_back().Error = Error;
+            }
+            return Resource;
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.MeshLOD.ChainHalvesWithinError")
+    {
+        TUniquePtr<FMeshResource> Sphere = MakeSphere(48, 96);
+        const size_t NumFullDetailIndices = Sphere->GetNumIndices();
+
+        Import::Mesh::GenerateMeshLODs(*Sphere);
+
+        TEST_CHECK(Sphere->GetNumLODs() > 2);
+        TEST_CHECK(Sphere->GetLODNumIndices(0) == NumFullDetailIndices);
+
+        const float BaseDeviation = GetMaxDeviation(*Sphere, 0);
+
+        uint32 NumOutOfRange = 0;
+        for (uint32 LOD = 1; LOD < Sphere->GetNumLODs(); ++LOD)
+        {
+            TEST_CHECK(Sphere->GetLODNumIndices(LOD) <= Sphere->GetLODNumIndices(LOD - 1) * 0.85f);
+            TEST_CHECK(Sphere->GetLODNumIndices(LOD) % 3 == 0);
+            TEST_CHECK(Sphere->GetLODError(LOD) > 0.0f);
+            TEST_CHECK(Sphere->GetLODError(LOD) >= Sphere->GetLODError(LOD - 1));
+
+            // Simplified levels only ever append to the index buffer and reference the shared vertices.
+            for (const FGeometrySurface& Surface : Sphere->GetLODSurfaces(LOD))
+            {
+                TEST_CHECK(Surface.StartIndex >= NumFullDetailIndices);
+                TEST_CHECK(Surface.StartIndex + Surface.IndexCount <= Sphere->GetNumIndices());
+                TEST_CHECK(Surface.NumMeshlets == 0);
+
+                for (uint32 i = Surface.StartIndex; i < Surface.StartIndex + Surface.IndexCount && i < Sphere->GetNumIndices(); ++i)
+                {
+                    NumOutOfRange += Sphere->Indices[i] >= Sphere->GetNumVertices();
+                }
+            }
+
+            // The reported error is what the renderer trusts to hide the swap, the surface may not stray further than it.
+            TEST_CHECK(GetMaxDeviation(*Sphere, LOD) <= BaseDeviation + Sphere->GetLODError(LOD) * 1.5f + 1e-4f);
+        }
+        TEST_CHECK(NumOutOfRange == 0);
+
+        // Too small to be worth simplifying, the mesh keeps its single level.
+        TUniquePtr<FMeshResource> Small = MakeSphere(3, 4);
+        Import::Mesh::GenerateMeshLODs(*Small);
+        TEST_CHECK(Small->GetNumLODs() == 1);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.MeshLOD.ErrorThresholds")
+    {
+        const TUniquePtr<FMeshResource> Chain = MakeLODChain();
+        const FMeshResource& Resource = *Chain;
+        const uint32 FirstSeen = Resource.GetNumLODs();
+
+        // The coarsest level whose projected error stays within one pixel.
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 200.0f, FirstSeen, 1.0f, 0.0f) == 0);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 90.0f, FirstSeen, 1.0f, 0.0f) == 1);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 30.0f, FirstSeen, 1.0f, 0.0f) == 2);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 10.0f, FirstSeen, 1.0f, 0.0f) == 3);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 30.0f, FirstSeen, 2.0f, 0.0f) == 3);
+
+        // Coarsening past last frame's level has to beat the limit shrunk by the hysteresis.
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 40.0f, FirstSeen, 1.0f, 0.25f) == 2);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 40.0f, 1, 1.0f, 0.25f) == 1);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 35.0f, 1, 1.0f, 0.25f) == 2);
+
+        // Refining takes the plain limit, a level that no longer holds is dropped at once.
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 30.0f, 3, 1.0f, 0.25f) == 2);
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(Resource, 20.0f, 3, 1.0f, 0.25f) == 3);
+
+        FMeshResource SingleLevel;
+        TEST_CHECK(FForwardRenderScene::PickMeshLOD(SingleLevel, 0.0f, 1, 1.0f, 0.0f) == 0);
+    }
+
+    // The LOD chain saved into a package and loaded back, with the texture mips stored in the bulk data region.
+    LUMINA_AUTOMATION_TEST("Renderer.MeshLOD.PackageRoundTrip")
+    {
+        const FFixedString Path = WriteScratchFile("MeshLODRoundTrip.lasset", "");
+        CPackage* Package = CPackage::CreatePackage(Path);
+
+        TUniquePtr<FMeshResource> Sphere = MakeSphere(24, 48);
+        Import::Mesh::GenerateMeshLODs(*Sphere);
+
+        CStaticMesh* Mesh = NewObject<CStaticMesh>(Package, FName("MeshLODRoundTrip"));
+        Mesh->SetMeshResource(Move(Sphere));
+
+        CTexture* Texture = NewObject<CTexture>(Package, FName("MeshLODRoundTripTexture"));
+        Texture->TextureResource = MakeUnique<FTextureResource>();
+        FTextureResource& TextureResource = *Texture->TextureResource;
+        TextureResource.ImageDescription.Format = EFormat::RGBA8_UNORM;
+        TextureResource.ImageDescription.Extent = glm::uvec2(16);
+        TextureResource.ImageDescription.NumMips = 3;
+
+        TVector<TVector<uint8>> MipPixels;
+        int64 NumBulkBytes = 0;
+        for (uint32 Mip = 0; Mip < 3; ++Mip)
+        {
+            const uint32 Size = 16u >> Mip;
+            FTextureResource::FMip& NewMip = TextureResource.Mips.emplace_back();
+            NewMip.Width = Size;
+            NewMip.Height = Size;
+            NewMip.Depth = 1;
+            NewMip.RowPitch = Size * 4;
+            NewMip.SlicePitch = Size * Size * 4;
+            NewMip.Pixels.resize(NewMip.SlicePitch);
+            for (size_t i = 0; i < NewMip.Pixels.size(); ++i)
+            {
+                NewMip.Pixels[i] = static_cast<uint8>(i * 7 + Mip * 31);
+            }
+
+            MipPixels.push_back(NewMip.Pixels);
+            NumBulkBytes += static_cast<int64>(NewMip.Pixels.size());
+        }
+
+        TEST_CHECK(CPackage::SavePackage(Package, Path));
+
+        // The bulk data region closes the file and is left out of the loader.
+        TEST_CHECK(Package->BulkDataOffset != INDEX_NONE);
+        TEST_CHECK(static_cast<int64>(VFS::Size(Path)) == Package->BulkDataOffset + NumBulkBytes);
+
+        TEST_CHECK(CPackage::LoadPackage(Path) == Package);
+        TEST_CHECK(Package->GetLoader() != nullptr && Package->GetLoader()->TotalSize() == Package->BulkDataOffset);
+
+        CStaticMesh* LoadedMesh = LoadExport<CStaticMesh>(Package, Mesh);
+        CTexture* LoadedTexture = LoadExport<CTexture>(Package, Texture);
+        TEST_CHECK(LoadedMesh != nullptr && LoadedTexture != nullptr);
+
+        if (LoadedMesh != nullptr)
+        {
+            const FMeshResource& Saved = Mesh->GetMeshResource();
+            const FMeshResource& Loaded = LoadedMesh->GetMeshResource();
+
+            TEST_CHECK(Saved.GetNumLODs() > 1);
+            TEST_CHECK(Loaded.GetNumLODs() == Saved.GetNumLODs());
+            TEST_CHECK(Loaded.Indices == Saved.Indices);
+            for (uint32 LOD = 0; LOD < Loaded.GetNumLODs() && LOD < Saved.GetNumLODs(); ++LOD)
+            {
+                TEST_CHECK(Loaded.GetLODError(LOD) == Saved.GetLODError(LOD));
+                TEST_CHECK(Loaded.GetLODSurfaces(LOD).size() == Saved.GetLODSurfaces(LOD).size());
+                TEST_CHECK(Loaded.GetLODNumIndices(LOD) == Saved.GetLODNumIndices(LOD));
+            }
+        }
+
+        if (LoadedTexture != nullptr)
+        {
+            const FTextureResource& Loaded = *LoadedTexture->GetTextureResource();
+            TEST_CHECK(Loaded.Mips.size() == MipPixels.size());
+
+            for (size_t Mip = 0; Mip < Loaded.Mips.size() && Mip < MipPixels.size(); ++Mip)
+            {
+                const FTextureResource::FMip& LoadedMip = Loaded.Mips[Mip];
+                TEST_CHECK(LoadedMip.Pixels.empty());
+                TEST_CHECK(LoadedMip.BulkOffset != INDEX_NONE);
+                TEST_CHECK(LoadedMip.BulkSize == static_cast<int64>(MipPixels[Mip].size()));
+
+                TVector<uint8> Pixels;
+                TEST_CHECK(Package->ReadBulkData(LoadedMip.BulkOffset, LoadedMip.BulkSize, Pixels));
+                TEST_CHECK(Pixels == MipPixels[Mip]);
+            }
+        }
+
+        for (CObject* Object : { static_cast<CObject*>(LoadedMesh), static_cast<CObject*>(LoadedTexture), static_cast<CObject*>(Mesh), static_cast<CObject*>(Texture) })
+        {
+            if (Object != nullptr)
+            {
+                Object->ForceDestroyNow();
+            }
+        }
+        Package->RemoveFromRoot();
+        Package->ForceDestroyNow();
+        VFS::Remove(Path);
+    }
+}
+
+#endif
@@ -0,0 +1,354 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Core/Math/Frustum.h"
+#include "Core/Math/Transform.h"
+#include "Renderer/MeshData.h"
+#include "Tools/Import/ImportHelpers.h"
+#include "World/Entity/Components/StaticMeshComponent.h"
+#include "World/Scene/RenderScene/MeshletCulling.h"
+#include "World/Scene/RenderScene/Forward/ForwardRenderScene.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr uint32 SmallSurfaceTriangles = 96;
+
+        /**
+         * A torus clustered into meshlets, its faces wound counter clockwise seen from outside. The last SmallSurfaceTriangles
+         * triangles form a second surface, too small to be worth culling by meshlet.
+         */
+        TUniquePtr<FMeshResource> MakeTorus(uint32 Rings, uint32 Sides)
+        {
+            constexpr float MajorRadius = 1.0f;
+            constexpr float MinorRadius = 0.3f;
+
+            TUniquePtr<FMeshResource> Resource = MakeUnique<FMeshResource>();
+            Resource->Name = FName("MeshletTorus");
+
+            TVector<FVertex> Vertices;
+            for (uint32 Ring = 0; Ring < Rings; ++Ring)
+            {
+                const float U = glm::two_pi<float>() * static_cast<float>(Ring) / static_cast<float>(Rings);
+                for (uint32 Side = 0; Side < Sides; ++Side)
+                {
+                    const float V = glm::two_pi<float>() * static_cast<float>(Side) / static_cast<float>(Sides);
+                    const glm::vec3 Normal(glm::cos(V) * glm::cos(U), glm::sin(V), glm::cos(V) * glm::sin(U));
+
+                    FVertex& Vertex = Vertices.emplace_back();
+                    Vertex.Position = glm::vec3(glm::cos(U), 0.0f, glm::sin(U)) * MajorRadius + Normal * MinorRadius;
+                    Vertex.Normal = PackNormal(Normal);
+                    Vertex.UV = glm::u16vec2(0);
+                    Vertex.Color = 0xFFFFFFFF;
+                }
+            }
+
+            auto VertexAt = [&](uint32 Ring, uint32 Side)
+            {
+                return (Ring % Rings) * Sides + Side % Sides;
+            };
+
+            TVector<uint32>& Indices = Resource->Indices;
+            for (uint32 Ring = 0; Ring < Rings; ++Ring)
+            {
+                for (uint32 Side = 0; Side < Sides; ++Side)
+                {
+                    const uint32 A = VertexAt(Ring, Side);
+                    const uint32 B = VertexAt(Ring + 1, Side);
+                    const uint32 C = VertexAt(Ring, Side + 1);
+                    const uint32 D = VertexAt(Ring + 1, Side + 1);
+                    Indices.insert(Indices.end(), { A, C, B, B, C, D });
+                }
+            }
+
+            Resource->Vertices = Move(Vertices);
+
+            const uint32 SmallStart = (uint32)Indices.size() - SmallSurfaceTriangles * 3;
+
+            FGeometrySurface& Large = Resource->GeometrySurfaces.emplace_back();
+            Large.ID = FName("Large");
+            Large.StartIndex = 0;
+            Large.IndexCount = SmallStart;
+            Large.MaterialIndex = 0;
+
+            FGeometrySurface& Small = Resource->GeometrySurfaces.emplace_back();
+            Small.ID = FName("Small");
+            Small.StartIndex = SmallStart;
+            Small.IndexCount = SmallSurfaceTriangles * 3;
+            Small.MaterialIndex = 1;
+
+            Import::Mesh::BuildMeshlets(*Resource);
+            return Resource;
+        }
+
+        struct FRandomStream
+        {
+            uint32 State = 0x1B873593u;
+
+            float Range(float Min, float Max)
+            {
+                State = State * 1664525u + 1013904223u;
+                return Min + (Max - Min) * static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+            }
+
+            glm::vec3 Vector(float Min, float Max)
+            {
+                return glm::vec3(Range(Min, Max), Range(Min, Max), Range(Min, Max));
+            }
+        };
+
+        FFrustum MakeFrustum(const glm::vec3& Eye, const glm::vec3& Target)
+        {
+            const glm::mat4 View = glm::lookAt(Eye, Target, glm::vec3(0.0f, 1.0f, 0.0f));
+            return FFrustum::FromViewProjection(glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 100.0f) * View);
+        }
+
+        bool IsFullSurface(const FForwardRenderScene::FStaticSurfaceDraw& Draw, const FGeometrySurface& Surface)
+        {
+            return Draw.Surface == &Surface && Draw.StartIndex == Surface.StartIndex && Draw.IndexCount == Surface.IndexCount;
+        }
+    }
+
+    // A culled triangle has to be outside the frustum or facing away from the viewer, over random views and transforms.
+    LUMINA_AUTOMATION_TEST("Renderer.MeshletCulling.NeverCullsVisibleTriangles")
+    {
+        TUniquePtr<FMeshResource> Torus = MakeTorus(64, 32);
+        const FMeshResource& Resource = *Torus;
+        TEST_CHECK(Resource.Meshlets.size() > 8);
+
+        FRandomStream Random;
+        uint64 NumCulledTriangles = 0;
+        uint64 NumKeptTriangles = 0;
+        uint32 NumFalselyCulled = 0;
+        uint32 NumBadRanges = 0;
+
+        TVector<glm::uvec2> Ranges;
+        TVector<uint8> Kept(Resource.GetNumIndices() / 3);
+        for (uint32 Iteration = 0; Iteration < 2'000; ++Iteration)
+        {
+            FTransform Transform(Random.Vector(-2.0f, 2.0f));
+            Transform.Rotation = glm::normalize(glm::quat(Random.Range(-1.0f, 1.0f), Random.Vector(-1.0f, 1.0f)));
+            Transform.Scale = Random.Vector(0.3f, 3.0f);
+            if (Iteration % 4 == 3)
+            {
+                Transform.Scale.x = -Transform.Scale.x;
+            }
+
+            const glm::mat4 LocalToWorld = Transform.GetMatrix();
+            const glm::vec3 Eye = glm::normalize(Random.Vector(-1.0f, 1.0f) + glm::vec3(0.0f, 0.0f, 1e-3f)) * Random.Range(2.0f, 12.0f);
+            const FFrustum Frustum = MakeFrustum(Eye, Random.Vector(-1.5f, 1.5f));
+            const bool bConeCull = Iteration % 2 == 0;
+            const bool bMirrored = glm::determinant(glm::mat3(LocalToWorld)) < 0.0f;
+            const glm::vec3 LocalEye = glm::vec3(glm::inverse(LocalToWorld) * glm::vec4(Eye, 1.0f));
+
+            const FMeshletCuller Culler(LocalToWorld, Eye, Frustum);
+            for (const FGeometrySurface& Surface : Resource.GeometrySurfaces)
+            {
+                Ranges.clear();
+                const FMeshletCullResult Result = Culler.CullSurface(Resource, Surface, bConeCull, Ranges);
+                NumCulledTriangles += Result.NumTrianglesCulled;
+                TEST_CHECK(Result.NumTested == Surface.NumMeshlets);
+
+                eastl::fill(Kept.begin(), Kept.end(), 0);
+                uint32 NumKept = 0;
+                uint32 PreviousEnd = Surface.StartIndex;
+                for (const glm::uvec2& Range : Ranges)
+                {
+                    // Sorted, disjoint, inside the surface, and adjacent ones merged.
+                    NumBadRanges += Range.x < PreviousEnd || (Range.x == PreviousEnd && Range.x != Surface.StartIndex) || Range.y == 0 || Range.y % 3 != 0;
+                    NumBadRanges += Range.x + Range.y > Surface.StartIndex + Surface.IndexCount;
+                    PreviousEnd = Range.x + Range.y;
+
+                    for (uint32 Index = Range.x; Index < Range.x + Range.y && Index < Resource.GetNumIndices(); Index += 3)
+                    {
+                        Kept[Index / 3] = 1;
+                        ++NumKept;
+                    }
+                }
+                NumKeptTriangles += NumKept;
+                NumBadRanges += NumKept + Result.NumTrianglesCulled != Surface.IndexCount / 3;
+
+                for (uint32 Index = Surface.StartIndex; Index < Surface.StartIndex + Surface.IndexCount; Index += 3)
+                {
+                    if (Kept[Index / 3])
+                    {
+                        continue;
+                    }
+
+                    const glm::vec3 P0 = Resource.GetPositionAt(Resource.Indices[Index]);
+                    const glm::vec3 P1 = Resource.GetPositionAt(Resource.Indices[Index + 1]);
+                    const glm::vec3 P2 = Resource.GetPositionAt(Resource.Indices[Index + 2]);
+
+                    bool bOutside = false;
+                    for (const glm::vec4& Plane : Frustum.Planes)
+                    {
+                        auto Distance = [&](const glm::vec3& P) { return glm::dot(glm::vec3(Plane), glm::vec3(LocalToWorld * glm::vec4(P, 1.0f))) + Plane.w; };
+                        bOutside |= Distance(P0) < 0.0f && Distance(P1) < 0.0f && Distance(P2) < 0.0f;
+                    }
+
+                    // Facing survives affine transforms, so it is judged in object space against the viewer moved there.
+                    const glm::vec3 Normal = glm::cross(P1 - P0, P2 - P0);
+                    const glm::vec3 ToTriangle = P0 - LocalEye;
+                    const bool bBackFacing = bConeCull && !bMirrored && glm::dot(Normal, ToTriangle) >= -1e-4f * glm::length(Normal) * glm::length(ToTriangle);
+
+                    NumFalselyCulled += !bOutside && !bBackFacing;
+                }
+            }
+        }
+
+        TEST_CHECK(NumFalselyCulled == 0);
+        TEST_CHECK(NumBadRanges == 0);
+        TEST_CHECK(NumCulledTriangles > 0);
+        TEST_CHECK(NumKeptTriangles > 0);
+    }
+
+    // Shadow views draw a caster's (First, Surfaces.size()) instance range whole, it must hold each full surface exactly once.
+    LUMINA_AUTOMATION_TEST("Renderer.MeshletCulling.ShadowCasterRange")
+    {
+        TUniquePtr<FMeshResource> Torus = MakeTorus(64, 32);
+        const FMeshResource& Resource = *Torus;
+        const TVector<FGeometrySurface>& Surfaces = Resource.GeometrySurfaces;
+        const uint32 MinCulledMeshlets = 8;
+        TEST_CHECK(Surfaces[0].NumMeshlets >= MinCulledMeshlets);
+        TEST_CHECK(Surfaces[1].NumMeshlets < MinCulledMeshlets);
+
+        // Looking at the torus from the side, about half of it faces away.
+        const glm::vec3 Eye(0.0f, 0.5f, 4.0f);
+        const FMeshletCuller Culler(glm::mat4(1.0f), Eye, MakeFrustum(Eye, glm::vec3(0.0f)));
+        const EInstanceFlags Flags = EInstanceFlags::CastShadow | EInstanceFlags::ReceiveShadow;
+
+        SStaticMeshComponent MeshComponent;
+        TVector<FForwardRenderScene::FStaticSurfaceDraw> Draws;
+
+        for (const bool bCastShadow : { true, false })
+        {
+            MeshComponent.bCastShadow = bCastShadow;
+
+            Draws.clear();
+            const FMeshletCullResult Result = FForwardRenderScene::GatherStaticSurfaceDraws(MeshComponent, Resource, Surfaces, Flags, &Culler, MinCulledMeshlets, Draws);
+            TEST_CHECK(Result.NumTested == Surfaces[0].NumMeshlets);
+            TEST_CHECK(Result.NumCulled > 0);
+
+            const size_t NumLeading = bCastShadow ? Surfaces.size() : 1;
+            TEST_CHECK(Draws.size() > NumLeading);
+            if (Draws.size() <= NumLeading)
+            {
+                continue;
+            }
+
+            if (bCastShadow)
+            {
+                // The leading run is every surface whole and in order, only the meshlet culled one is hidden from the camera.
+                for (size_t i = 0; i < Surfaces.size(); ++i)
+                {
+                    TEST_CHECK(IsFullSurface(Draws[i], Surfaces[i]));
+                    TEST_CHECK(EnumHasAnyFlags(Draws[i].Flags, EInstanceFlags::ShadowOnly) == (i == 0));
+                }
+            }
+            else
+            {
+                TEST_CHECK(IsFullSurface(Draws[0], Surfaces[1]));
+            }
+
+            // What follows are the camera's meshlet ranges of the large surface, outside any shadow range.
+            uint32 NumBadDraws = 0;
+            uint32 NumCameraTriangles = 0;
+            for (size_t i = 0; i < Draws.size(); ++i)
+            {
+                NumBadDraws += !bCastShadow && EnumHasAnyFlags(Draws[i].Flags, EInstanceFlags::ShadowOnly);
+                if (i < NumLeading)
+                {
+                    continue;
+                }
+
+                const FGeometrySurface& Large = Surfaces[0];
+                NumBadDraws += Draws[i].Surface != &Large || EnumHasAnyFlags(Draws[i].Flags, EInstanceFlags::ShadowOnly);
+                NumBadDraws += Draws[i].StartIndex < Large.StartIndex || Draws[i].StartIndex + Draws[i].IndexCount > Large.StartIndex + Large.IndexCount;
+                NumCameraTriangles += Draws[i].IndexCount / 3;
+            }
+            TEST_CHECK(NumBadDraws == 0);
+            TEST_CHECK(NumCameraTriangles + Result.NumTrianglesCulled == Surfaces[0].IndexCount / 3);
+        }
+
+        // Without meshlet culling every surface is a single full draw with the primitive's flags.
+        Draws.clear();
+        MeshComponent.bCastShadow = true;
+        const FMeshletCullResult Whole = FForwardRenderScene::GatherStaticSurfaceDraws(MeshComponent, Resource, Surfaces, Flags, nullptr, MinCulledMeshlets, Draws);
+        TEST_CHECK(Whole.NumTested == 0);
+        TEST_CHECK(Draws.size() == Surfaces.size());
+        for (size_t i = 0; i < Draws.size() && i < Surfaces.size(); ++i)
+        {
+            TEST_CHECK(IsFullSurface(Draws[i], Surfaces[i]));
+            TEST_CHECK(Draws[i].Flags == Flags);
+        }
+    }
+
+    // 10k tori spread in front of the camera: the per instance cost of meshlet culling and the camera triangles it saves.
+    LUMINA_AUTOMATION_TEST("Benchmark.Renderer.MeshletCulling")
+    {
+        constexpr uint32 GridSize = 100;
+        constexpr uint32 NumFrames = 10;
+        constexpr uint32 MinCulledMeshlets = 8;
+
+        TUniquePtr<FMeshResource> Torus = MakeTorus(64, 32);
+        const FMeshResource& Resource = *Torus;
+
+        FRandomStream Random;
+        TVector<glm::mat4> Transforms;
+        for (uint32 X = 0; X < GridSize; ++X)
+        {
+            for (uint32 Z = 0; Z < GridSize; ++Z)
+            {
+                FTransform Transform(glm::vec3(static_cast<float>(X) * 4.0f - 200.0f, 0.0f, -static_cast<float>(Z) * 4.0f - 5.0f));
+                Transform.Rotation = glm::normalize(glm::quat(Random.Range(-1.0f, 1.0f), Random.Vector(-1.0f, 1.0f)));
+                Transforms.push_back(Transform.GetMatrix());
+            }
+        }
+
+        const glm::vec3 Eye(0.0f, 6.0f, 0.0f);
+        const FFrustum Frustum = MakeFrustum(Eye, glm::vec3(0.0f, 0.0f, -100.0f));
+        const EInstanceFlags Flags = EInstanceFlags::CastShadow | EInstanceFlags::ReceiveShadow;
+
+        SStaticMeshComponent MeshComponent;
+        TVector<FForwardRenderScene::FStaticSurfaceDraw> Draws;
+
+        for (const bool bMeshletCulling : { false, true })
+        {
+            uint64 NumCameraTriangles = 0;
+            uint64 NumDraws = 0;
+
+            const auto Start = std::chrono::high_resolution_clock::now();
+            for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+            {
+                NumCameraTriangles = 0;
+                NumDraws = 0;
+                for (const glm::mat4& Transform : Transforms)
+                {
+                    TOptional<FMeshletCuller> Culler;
+                    if (bMeshletCulling)
+                    {
+                        Culler.emplace(Transform, Eye, Frustum);
+                    }
+
+                    Draws.clear();
+                    FForwardRenderScene::GatherStaticSurfaceDraws(MeshComponent, Resource, Resource.GeometrySurfaces, Flags, Culler ? &Culler.value() : nullptr, MinCulledMeshlets, Draws);
+
+                    NumDraws += Draws.size();
+                    for (const FForwardRenderScene::FStaticSurfaceDraw& Draw : Draws)
+                    {
+                        NumCameraTriangles += EnumHasAnyFlags(Draw.Flags, EInstanceFlags::ShadowOnly) ? 0 : Draw.IndexCount / 3;
+                    }
+                }
+            }
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+
+            LOG_INFO("[{}] {} instances of {} triangles, {}: {:.3f} ms per frame, {} draws, {} camera triangles",
+                Test.GetName(), Transforms.size(), Resource.GetNumTriangles(), bMeshletCulling ? "meshlet culled" : "whole", Duration.count() / NumFrames, NumDraws, NumCameraTriangles);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,211 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Core/Math/Frustum.h"
+#include "TaskSystem/TaskSystem.h"
+#include "World/Scene/RenderScene/ShadowCasterBVH.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Casters scattered over a square of the given size, a few units tall, like props across a city block. */
+        struct FCasterScene
+        {
+            FCasterScene(uint32 NumCasters, float Size)
+            {
+                uint32 State = 0x2545F491u;
+                auto Random = [&State](float Min, float Max)
+                {
+                    State = State * 1664525u + 1013904223u;
+                    return Min + (Max - Min) * static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+                };
+
+                for (uint32 i = 0; i < NumCasters; ++i)
+                {
+                    const glm::vec3 Min(Random(0.0f, Size), 0.0f, Random(0.0f, Size));
+                    Entities.push_back(static_cast<entt::entity>(i));
+                    Bounds.emplace_back(Min, Min + glm::vec3(Random(0.5f, 4.0f), Random(1.0f, 10.0f), Random(0.5f, 4.0f)));
+                }
+            }
+
+            TVector<uint32> BruteForceSphere(const glm::vec3& Center, float Radius) const
+            {
+                TVector<uint32> Casters;
+                for (uint32 i = 0; i < (uint32)Bounds.size(); ++i)
+                {
+                    const glm::vec3 Delta = glm::clamp(Center, Bounds[i].Min, Bounds[i].Max) - Center;
+                    if (glm::dot(Delta, Delta) <= Radius * Radius)
+                    {
+                        Casters.push_back(i);
+                    }
+                }
+                return Casters;
+            }
+
+            TVector<uint32> BruteForceFrustum(const FFrustum& Frustum) const
+            {
+                TVector<uint32> Casters;
+                for (uint32 i = 0; i < (uint32)Bounds.size(); ++i)
+                {
+                    if (Frustum.IsInside(Bounds[i]))
+                    {
+                        Casters.push_back(i);
+                    }
+                }
+                return Casters;
+            }
+
+            TVector<entt::entity>   Entities;
+            TVector<FAABB>          Bounds;
+        };
+
+        TVector<uint32> Sorted(TVector<uint32> Casters)
+        {
+            eastl::sort(Casters.begin(), Casters.end());
+            return Casters;
+        }
+
+        FFrustum MakeSpotFrustum(const glm::vec3& Position, const glm::vec3& Target, float Range)
+        {
+            const glm::mat4 View = glm::lookAt(Position, Target, glm::vec3(0.0f, 0.0f, 1.0f));
+            const glm::mat4 Projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, Range);
+            return FFrustum::FromViewProjection(Projection * View);
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShadowCasterBVH.MatchesBruteForce")
+    {
+        FCasterScene Scene(5'000, 500.0f);
+
+        FShadowCasterBVH BVH;
+        BVH.Update(Scene.Entities, Scene.Bounds);
+        TEST_CHECK(BVH.GetNumCasters() == 5'000);
+        TEST_CHECK(BVH.GetNumRebuilds() == 1);
+
+        auto CheckQueries = [&]
+        {
+            uint32 NumMismatched = 0;
+            for (uint32 i = 0; i < 20; ++i)
+            {
+                const glm::vec3 Center(25.0f * i, 2.0f, 480.0f - 20.0f * i);
+
+                TVector<uint32> Casters;
+                BVH.QuerySphere(Center, 30.0f, Casters);
+                NumMismatched += Sorted(Casters) != Scene.BruteForceSphere(Center, 30.0f);
+
+                const FFrustum Frustum = MakeSpotFrustum(Center + glm::vec3(0.0f, 20.0f, 0.0f), Center, 60.0f);
+                Casters.clear();
+                BVH.QueryFrustums(&Frustum, 1, Casters);
+                NumMismatched += Sorted(Casters) != Scene.BruteForceFrustum(Frustum);
+            }
+            return NumMismatched;
+        };
+
+        TEST_CHECK(CheckQueries() == 0);
+
+        // A few movers only refit the tree, the queries still have to see them at their new place.
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            Scene.Bounds[i * 7].Min += glm::vec3(40.0f, 0.0f, -25.0f);
+            Scene.Bounds[i * 7].Max += glm::vec3(40.0f, 0.0f, -25.0f);
+        }
+        BVH.Update(Scene.Entities, Scene.Bounds);
+        TEST_CHECK(BVH.GetNumRebuilds() == 1);
+        TEST_CHECK(BVH.GetNumRefitted() == 100);
+        TEST_CHECK(CheckQueries() == 0);
+
+        // Most casters moving rebuilds instead, refitting would leave the boxes too loose.
+        for (FAABB& Box : Scene.Bounds)
+        {
+            Box.Min.y += 1.0f;
+            Box.Max.y += 1.0f;
+        }
+        BVH.Update(Scene.Entities, Scene.Bounds);
+        TEST_CHECK(BVH.GetNumRebuilds() == 2);
+        TEST_CHECK(CheckQueries() == 0);
+
+        // A different caster set always rebuilds.
+        Scene.Entities.pop_back();
+        Scene.Bounds.pop_back();
+        BVH.Update(Scene.Entities, Scene.Bounds);
+        TEST_CHECK(BVH.GetNumRebuilds() == 3);
+        TEST_CHECK(BVH.GetNumCasters() == 4'999);
+        TEST_CHECK(CheckQueries() == 0);
+    }
+
+    // 200 point lights over 50k instances: tree build, refit of moving instances and the parallel per light queries,
+    // against testing every instance per light, which is what drawing every batch into every shadow map amounts to.
+    LUMINA_AUTOMATION_TEST("Benchmark.Renderer.ShadowCasterCulling")
+    {
+        constexpr uint32 NumInstances = 50'000;
+        constexpr uint32 NumLights = 200;
+        constexpr uint32 NumMoving = 1'000;
+        constexpr float LightRadius = 20.0f;
+        constexpr float SceneSize = 1'000.0f;
+
+        FCasterScene Scene(NumInstances, SceneSize);
+
+        TVector<glm::vec3> Lights;
+        for (uint32 i = 0; i < NumLights; ++i)
+        {
+            Lights.emplace_back(static_cast<float>(i % 20) * SceneSize / 20.0f + 25.0f, 5.0f, static_cast<float>(i / 20) * SceneSize / 10.0f + 50.0f);
+        }
+
+        auto Time = [&](auto&& Func)
+        {
+            const auto Start = std::chrono::high_resolution_clock::now();
+            Func();
+            const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+            return Duration.count();
+        };
+
+        FShadowCasterBVH BVH;
+        const double BuildMs = Time([&] { BVH.Update(Scene.Entities, Scene.Bounds); });
+
+        for (uint32 i = 0; i < NumMoving; ++i)
+        {
+            FAABB& Box = Scene.Bounds[(i * 48'271u) % NumInstances];
+            Box.Min.x += 1.0f;
+            Box.Max.x += 1.0f;
+        }
+        const double RefitMs = Time([&] { BVH.Update(Scene.Entities, Scene.Bounds); });
+        TEST_CHECK(BVH.GetNumRefitted() == NumMoving);
+
+        TVector<TVector<uint32>> DrawLists(NumLights);
+        const double QueryMs = Time([&]
+        {
+            Task::ParallelFor(NumLights, [&](uint32 Light)
+            {
+                DrawLists[Light].clear();
+                BVH.QuerySphere(Lights[Light], LightRadius, DrawLists[Light]);
+            });
+        });
+
+        uint64 NumCulledDraws = 0;
+        for (const TVector<uint32>& DrawList : DrawLists)
+        {
+            NumCulledDraws += DrawList.size();
+        }
+
+        uint64 NumBruteForceDraws = 0;
+        const double BruteForceMs = Time([&]
+        {
+            for (const glm::vec3& Light : Lights)
+            {
+                NumBruteForceDraws += Scene.BruteForceSphere(Light, LightRadius).size();
+            }
+        });
+
+        TEST_CHECK(NumCulledDraws == NumBruteForceDraws);
+        TEST_CHECK(NumCulledDraws < static_cast<uint64>(NumInstances) * NumLights);
+
+        LOG_INFO("[{}] {} instances, {} lights: build {:.3f} ms, refit of {} {:.3f} ms, parallel queries {:.3f} ms, brute force {:.3f} ms",
+            Test.GetName(), NumInstances, NumLights, BuildMs, NumMoving, RefitMs, QueryMs, BruteForceMs);
+        LOG_INFO("[{}] shadow instances drawn: {} culled, {} unculled", Test.GetName(), NumCulledDraws, static_cast<uint64>(NumInstances) * NumLights);
+    }
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "World/Scene/RenderScene/ShadowMapCache.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Two lights far apart, each with one caster inside its range. */
+        struct FShadowCacheScene
+        {
+            FShadowCacheScene()
+                : Cache(FShadowAtlasConfig())
+            {
+                Entities    = { static_cast<entt::entity>(1), static_cast<entt::entity>(2) };
+                Bounds      = { FAABB(glm::vec3(1.0f), glm::vec3(2.0f)), FAABB(glm::vec3(101.0f, 1.0f, 1.0f), glm::vec3(102.0f, 2.0f, 2.0f)) };
+                Dynamic     = { 0, 0 };
+
+                Lights.resize(2);
+                Lights[0].Key       = 1;
+                Lights[0].ViewHash  = 10;
+                Lights[0].Center    = glm::vec3(0.0f);
+                Lights[0].Radius    = 10.0f;
+                Lights[1].Key       = 2;
+                Lights[1].ViewHash  = 20;
+                Lights[1].Center    = glm::vec3(100.0f, 0.0f, 0.0f);
+                Lights[1].Radius    = 10.0f;
+            }
+
+            const TVector<FShadowCacheSlot>& Step()
+            {
+                Cache.UpdateCasters(Entities, Bounds, Dynamic);
+                Cache.UpdateLights(Lights, Slots);
+                return Slots;
+            }
+
+            void Settle()
+            {
+                for (uint32 Frame = 0; Frame <= FShadowMapCache::SettleFrames; ++Frame)
+                {
+                    Step();
+                }
+            }
+
+            FShadowMapCache             Cache;
+            TVector<entt::entity>       Entities;
+            TVector<FAABB>              Bounds;
+            TVector<uint8>              Dynamic;
+            TVector<FShadowCacheLight>  Lights;
+            TVector<FShadowCacheSlot>   Slots;
+        };
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShadowCache.Invalidation")
+    {
+        FShadowCacheScene Scene;
+
+        // New lights always render their static depth.
+        const TVector<FShadowCacheSlot>& Slots = Scene.Step();
+        TEST_CHECK(Slots[0].bDirty && Slots[1].bDirty);
+        TEST_CHECK(Slots[0].CacheTile != INDEX_NONE && Slots[0].CacheTile != Slots[1].CacheTile);
+
+        Scene.Settle();
+        TEST_CHECK(Scene.Cache.IsCasterStatic(0) && Scene.Cache.IsCasterStatic(1));
+
+        Scene.Step();
+        TEST_CHECK(!Slots[0].bDirty && !Slots[1].bDirty);
+        TEST_CHECK(Scene.Cache.GetNumInvalidated() == 0);
+
+        // A baked caster starting to move only invalidates the light it was baked into.
+        Scene.Bounds[0] = FAABB(glm::vec3(3.0f), glm::vec3(4.0f));
+        Scene.Step();
+        TEST_CHECK(Slots[0].bDirty && !Slots[1].bDirty);
+        TEST_CHECK(!Scene.Cache.IsCasterStatic(0) && Scene.Cache.IsCasterStatic(1));
+
+        // While it is still unbaked its position is irrelevant to the cached depth.
+        Scene.Step();
+        TEST_CHECK(!Slots[0].bDirty && !Slots[1].bDirty);
+
+        Scene.Lights[1].ViewHash = 21;
+        Scene.Step();
+        TEST_CHECK(!Slots[0].bDirty && Slots[1].bDirty);
+
+        // A baked caster disappearing leaves its depth behind in the light around it.
+        Scene.Entities.pop_back();
+        Scene.Bounds.pop_back();
+        Scene.Dynamic.pop_back();
+        Scene.Step();
+        TEST_CHECK(!Slots[0].bDirty && Slots[1].bDirty);
+        TEST_CHECK(Scene.Cache.GetNumInvalidated() == 1);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShadowCache.AlwaysDynamicNeverBakes")
+    {
+        FShadowCacheScene Scene;
+        Scene.Dynamic[0] = 1;
+
+        Scene.Settle();
+        Scene.Settle();
+        TEST_CHECK(!Scene.Cache.IsCasterStatic(0));
+        TEST_CHECK(Scene.Cache.IsCasterStatic(1));
+
+        const TVector<FShadowCacheSlot>& Slots = Scene.Step();
+        TEST_CHECK(!Slots[0].bDirty && !Slots[1].bDirty);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.ShadowCache.ResetRerendersEverything")
+    {
+        FShadowCacheScene Scene;
+        Scene.Settle();
+        Scene.Step();
+        TEST_CHECK(Scene.Cache.GetNumInvalidated() == 0);
+
+        Scene.Cache.Reset();
+        const TVector<FShadowCacheSlot>& Slots = Scene.Step();
+        TEST_CHECK(Slots[0].bDirty && Slots[1].bDirty);
+        TEST_CHECK(!Scene.Cache.IsCasterStatic(0) && !Scene.Cache.IsCasterStatic(1));
+    }
+}
+
+#endif
@@ -0,0 +1,208 @@
+#include "pch.h"
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Assets/AssetTypes/Material/Material.h"
+#include "TaskSystem/TaskSystem.h"
+#include "World/Scene/RenderScene/SoftwareOcclusion.h"
+#include "World/Scene/RenderScene/Forward/ForwardRenderScene.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        /** Camera at the origin looking down -Z, 2:1 like the default buffer. */
+        glm::mat4 MakeViewProjection(const glm::vec3& Eye = glm::vec3(0.0f), const glm::vec3& Target = glm::vec3(0.0f, 0.0f, -1.0f))
+        {
+            const glm::mat4 View = glm::lookAt(Eye, Target, glm::vec3(0.0f, 1.0f, 0.0f));
+            return glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 2000.0f) * View;
+        }
+
+        /** A 20 x 20 wall facing the camera, its front face 20 units away. */
+        const FAABB Wall(glm::vec3(-10.0f, -10.0f, -21.0f), glm::vec3(10.0f, 10.0f, -20.0f));
+
+        FAABB MakeBox(const glm::vec3& Center, const glm::vec3& HalfExtent)
+        {
+            return FAABB(Center - HalfExtent, Center + HalfExtent);
+        }
+
+        /** The wall hides a box only when the box is behind its back face and every corner projects inside its front face. */
+        bool IsHiddenByWall(const FAABB& Box)
+        {
+            if (Box.Max.z >= Wall.Min.z)
+            {
+                return false;
+            }
+
+            for (uint32 Corner = 0; Corner < 8; ++Corner)
+            {
+                const glm::vec3 Position = glm::vec3((Corner & 1) ? Box.Max.x : Box.Min.x, (Corner & 2) ? Box.Max.y : Box.Min.y, (Corner & 4) ? Box.Max.z : Box.Min.z);
+                const glm::vec2 Projected = glm::vec2(Position) / -Position.z;
+                if (glm::abs(Projected.x) > 10.0f / 20.0f || glm::abs(Projected.y) > 10.0f / 20.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.SoftwareOcclusion.WallHidesBoxesBehindIt")
+    {
+        FSoftwareOcclusionBuffer Buffer;
+        Buffer.Begin(MakeViewProjection());
+        Buffer.AddOccluderBox(Wall);
+        Buffer.Rasterize();
+
+        TEST_CHECK(Buffer.GetNumTriangles() > 0);
+        TEST_CHECK(Buffer.GetDepth(Buffer.GetWidth() / 2, Buffer.GetHeight() / 2) > 0.0f);
+        TEST_CHECK(Buffer.GetDepth(0, 0) == 0.0f);
+
+        TEST_CHECK(!Buffer.IsVisible(MakeBox(glm::vec3(0.0f, 0.0f, -30.0f), glm::vec3(1.0f))));
+        TEST_CHECK(!Buffer.IsVisible(MakeBox(glm::vec3(3.0f, -2.0f, -200.0f), glm::vec3(5.0f))));
+        TEST_CHECK(Buffer.IsVisible(MakeBox(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(1.0f))));
+        TEST_CHECK(Buffer.IsVisible(MakeBox(glm::vec3(25.0f, 0.0f, -30.0f), glm::vec3(1.0f))));
+
+        // Wider than the wall's silhouette, it peeks out at both sides.
+        TEST_CHECK(Buffer.IsVisible(MakeBox(glm::vec3(0.0f, 0.0f, -40.0f), glm::vec3(30.0f, 1.0f, 1.0f))));
+
+        // Reaching behind the camera is never culled.
+        TEST_CHECK(Buffer.IsVisible(FAABB(glm::vec3(-1.0f, -1.0f, -30.0f), glm::vec3(1.0f, 1.0f, 1.0f))));
+
+        // A new frame forgets the previous frame's occluders.
+        Buffer.Begin(MakeViewProjection());
+        Buffer.Rasterize();
+        TEST_CHECK(Buffer.IsVisible(MakeBox(glm::vec3(0.0f, 0.0f, -30.0f), glm::vec3(1.0f))));
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.SoftwareOcclusion.NoFalseOcclusion")
+    {
+        FSoftwareOcclusionBuffer Buffer;
+        Buffer.Begin(MakeViewProjection());
+        Buffer.AddOccluderBox(Wall);
+        Buffer.Rasterize();
+
+        uint32 State = 0x68E31DA4u;
+        auto Random = [&State](float Min, float Max)
+        {
+            State = State * 1664525u + 1013904223u;
+            return Min + (Max - Min) * static_cast<float>(State >> 8) / static_cast<float>(1u << 24);
+        };
+
+        uint32 NumCulled = 0;
+        uint32 NumFalselyCulled = 0;
+        for (uint32 i = 0; i < 10'000; ++i)
+        {
+            const float Z = Random(-150.0f, -5.0f);
+            const FAABB Box = MakeBox(glm::vec3(Random(-0.6f, 0.6f) * -Z, Random(-0.4f, 0.4f) * -Z, Z), glm::vec3(Random(0.1f, 4.0f)));
+            if (!Buffer.IsVisible(Box))
+            {
+                ++NumCulled;
+                NumFalselyCulled += !IsHiddenByWall(Box);
+            }
+        }
+
+        TEST_CHECK(NumFalselyCulled == 0);
+        TEST_CHECK(NumCulled > 0);
+    }
+
+    LUMINA_AUTOMATION_TEST("Renderer.SoftwareOcclusion.OnlyOpaqueMaterialsOcclude")
+    {
+        auto MakeMaterial = [](bool bTranslucent, bool bTwoSided)
+        {
+            CMaterial* Material = NewObject<CMaterial>(OF_Transient);
+            Material->bTranslucent = bTranslucent;
+            Material->bTwoSided = bTwoSided;
+            Material->SetReadyForRender(true);
+            return Material;
+        };
+
+        CMaterial* Opaque = MakeMaterial(false, false);
+        CMaterial* Translucent = MakeMaterial(true, false);
+        CMaterial* TwoSided = MakeMaterial(false, true);
+
+        TEST_CHECK(FForwardRenderScene::IsOccluderMaterial(Opaque));
+        TEST_CHECK(!FForwardRenderScene::IsOccluderMaterial(Translucent));
+        TEST_CHECK(!FForwardRenderScene::IsOccluderMaterial(TwoSided));
+
+        // Surfaces without a material are drawn opaque with the default one.
+        TEST_CHECK(FForwardRenderScene::IsOccluderMaterial(nullptr) == IsValid(CMaterial::GetDefaultMaterial()));
+
+        Opaque->MaterialType = EMaterialType::PostProcess;
+        TEST_CHECK(!FForwardRenderScene::IsOccluderMaterial(Opaque));
+
+        for (CMaterial* Material : { Opaque, Translucent, TwoSided })
+        {
+            Material->ForceDestroyNow();
+        }
+    }
+
+    // A street level view down a grid of city blocks: building occluders rasterized, then every prop on the streets tested.
+    LUMINA_AUTOMATION_TEST("Benchmark.Renderer.SoftwareOcclusionCity")
+    {
+        constexpr uint32 BlocksX = 20;
+        constexpr uint32 BlocksZ = 19;
+        constexpr float BlockSize = 40.0f;
+        constexpr float StreetWidth = 12.0f;
+        constexpr uint32 PropsPerBlock = 100;
+        constexpr uint32 NumFrames = 30;
+
+        TVector<FAABB> Buildings;
+        TVector<FAABB> Props;
+        for (uint32 X = 0; X < BlocksX; ++X)
+        {
+            for (uint32 Z = 0; Z < BlocksZ; ++Z)
+            {
+                const glm::vec3 Corner(static_cast<float>(X) * (BlockSize + StreetWidth) - 500.0f, 0.0f, -static_cast<float>(Z) * (BlockSize + StreetWidth) - 30.0f);
+                const float Height = 20.0f + static_cast<float>((X * 7 + Z * 13) % 5) * 10.0f;
+                Buildings.emplace_back(Corner - glm::vec3(0.0f, 0.0f, BlockSize), Corner + glm::vec3(BlockSize, Height, 0.0f));
+
+                for (uint32 i = 0; i < PropsPerBlock; ++i)
+                {
+                    const glm::vec3 Position = Corner + glm::vec3(BlockSize + StreetWidth * 0.5f, 0.5f, -static_cast<float>(i) * BlockSize / PropsPerBlock);
+                    Props.push_back(MakeBox(Position, glm::vec3(0.5f)));
+                }
+            }
+        }
+
+        const glm::vec3 Eye(14.0f, 2.0f, 0.0f);
+        const glm::mat4 ViewProjection = MakeViewProjection(Eye, Eye + glm::vec3(0.1f, 0.0f, -1.0f));
+
+        FSoftwareOcclusionBuffer Buffer;
+        TVector<uint8> Visible(Props.size());
+
+        double RasterizeMs = 0.0;
+        double TestMs = 0.0;
+        for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            const auto Start = std::chrono::high_resolution_clock::now();
+
+            Buffer.Begin(ViewProjection);
+            for (const FAABB& Building : Buildings)
+            {
+                Buffer.AddOccluderBox(Building);
+            }
+            Buffer.Rasterize();
+
+            const auto Rasterized = std::chrono::high_resolution_clock::now();
+
+            Task::ParallelFor((uint32)Props.size(), [&](uint32 Index)
+            {
+                Visible[Index] = Buffer.IsVisible(Props[Index]);
+            });
+
+            const auto End = std::chrono::high_resolution_clock::now();
+            RasterizeMs += std::chrono::duration<double, std::milli>(Rasterized - Start).count();
+            TestMs += std::chrono::duration<double, std::milli>(End - Rasterized).count();
+        }
+
+        const size_t NumCulled = eastl::count(Visible.begin(), Visible.end(), 0);
+        TEST_CHECK(NumCulled > 0);
+
+        LOG_INFO("[{}] {} buildings, {} props: rasterize {:.3f} ms, test {:.3f} ms per frame, {} of {} props culled",
+            Test.GetName(), Buildings.size(), Props.size(), RasterizeMs / NumFrames, TestMs / NumFrames, NumCulled, Props.size());
+    }
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "pch.h"
+#include "AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "World/Entity/Components/ScriptComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        class FAutomationUpdateContext : public FUpdateContext
+        {
+        public:
+
+            void BeginStage(EUpdateStage Stage, double InDeltaTime)
+            {
+                UpdateStage = Stage;
+                DeltaTime = InDeltaTime;
+            }
+
+            void EndFrame()
+            {
+                Time += DeltaTime;
+                Frame++;
+            }
+        };
+    }
+
+    FAutomationWorld::FAutomationWorld(EWorldType Type, CWorld* InWorld)
+        : World(InWorld ? InWorld : NewObject<CWorld>(OF_Transient))
+    {
+        World->InitializeWorld(Type);
+    }
+
+    FAutomationWorld::~FAutomationWorld()
+    {
+        World->TeardownWorld();
+        World->ForceDestroyNow();
+    }
+
+    void FAutomationWorld::Tick(double DeltaTime, uint32 NumFrames)
+    {
+        constexpr EUpdateStage Stages[] = { US_FrameStart, US_PrePhysics, US_DuringPhysics, US_PostPhysics, US_FrameEnd };
+
+        FAutomationUpdateContext Context;
+        for (uint32 i = 0; i < NumFrames; ++i)
+        {
+            for (EUpdateStage Stage : Stages)
+            {
+                Context.BeginStage(Stage, DeltaTime);
+                World->Update(Context);
+            }
+            Context.EndFrame();
+        }
+    }
+
+    TVector<entt::entity> FAutomationWorld::SpawnScriptedEntities(FStringView ScriptPath, uint32 Num)
+    {
+        TVector<entt::entity> Entities;
+        Entities.reserve(Num);
+        for (uint32 i = 0; i < Num; ++i)
+        {
+            entt::entity Entity = World->ConstructEntity(FName("Scripted"));
+
+            SScriptComponent ScriptComponent;
+            ScriptComponent.ScriptPath.Path = FString(ScriptPath.data(), ScriptPath.size());
+            GetRegistry().emplace<SScriptComponent>(Entity, Move(ScriptComponent));
+
+            Entities.push_back(Entity);
+        }
+        return Entities;
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Core/Automation/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "World/World.h"
+
+namespace Lumina::Automation
+{
+    /**
+     * Owns a transient world for the length of a test and tears it down afterwards. Tests run before the engine loop starts,
+     * so the world is only ever updated through Tick.
+     */
+    class RUNTIME_API FAutomationWorld
+    {
+    public:
+
+        /** Initializes InWorld as Type, or a new empty world when it is null. */
+        explicit FAutomationWorld(EWorldType Type = EWorldType::Game, CWorld* InWorld = nullptr);
+        ~FAutomationWorld();
+
+        LE_NO_COPYMOVE(FAutomationWorld);
+
+        CWorld* Get() const { return World; }
+        CWorld* operator -> () const { return World; }
+        FEntityRegistry& GetRegistry() const { return World->GetEntityRegistry(); }
+
+        /** Runs every update stage except Paused, in engine order, NumFrames times with a fixed delta time. */
+        void Tick(double DeltaTime, uint32 NumFrames = 1);
+
+        /** Constructs Num entities running the script at ScriptPath, game worlds instance it as the component is emplaced. */
+        TVector<entt::entity> SpawnScriptedEntities(FStringView ScriptPath, uint32 Num = 1);
+
+    private:
+
+        CWorld* World = nullptr;
+    };
+
+    /**
+     * Runs Func on the old path and then on the new one by flipping the bool console variable Name, which gets its previous
+     * value back afterwards. Func is passed the value the variable holds for that run.
+     */
+    template<typename TFunc>
+    void ForEachConsoleToggle(FStringView Name, TFunc&& Func, bool bOldValue = false)
+    {
+        TScopedConsoleVariable<bool> Toggle(Name, bOldValue);
+        for (const bool bValue : { bOldValue, !bOldValue })
+        {
+            Toggle.Set(bValue);
+            Func(bValue);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "World/Entity/EntityUtils.h"
+#include "World/Entity/Components/DirtyComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        constexpr uint32 ForestDepth = 8;
+        constexpr uint32 ForestFanOut = 2;
+
+        /** Binary trees of ForestDepth levels until NumNodes is reached, returned in construction order. */
+        TVector<entt::entity> BuildForest(FAutomationWorld& World, uint32 NumNodes)
+        {
+            constexpr uint32 NodesPerTree = (1u << ForestDepth) - 1;
+
+            TVector<entt::entity> Entities;
+            Entities.reserve(NumNodes);
+
+            for (uint32 Tree = 0; Tree < NumNodes / NodesPerTree; ++Tree)
+            {
+                const size_t First = Entities.size();
+                for (uint32 Node = 0; Node < NodesPerTree; ++Node)
+                {
+                    FTransform Transform(glm::vec3(static_cast<float>(Node % 7), 1.0f, static_cast<float>(Tree)));
+                    Transform.Rotation = glm::angleAxis(0.1f * static_cast<float>(Node % 5), glm::vec3(0.0f, 1.0f, 0.0f));
+                    Transform.Scale = glm::vec3(1.0f + 0.01f * static_cast<float>(Node % 3));
+
+                    entt::entity Entity = World->ConstructEntity(FName("Node"), Transform);
+                    if (Node != 0)
+                    {
+                        ECS::Utils::ReparentEntity(World.GetRegistry(), Entity, Entities[First + (Node - 1) / ForestFanOut]);
+                    }
+                    Entities.push_back(Entity);
+                }
+            }
+
+            return Entities;
+        }
+
+        /** Every node moved this frame, the case where the recursive update recomputes nested subtrees once per dirty ancestor. */
+        void DirtyForest(FAutomationWorld& World, const TVector<entt::entity>& Entities)
+        {
+            for (entt::entity Entity : Entities)
+            {
+                World.GetRegistry().emplace_or_replace<FNeedsTransformUpdate>(Entity);
+            }
+        }
+
+        TVector<glm::mat4> GatherMatrices(FAutomationWorld& World, const TVector<entt::entity>& Entities)
+        {
+            TVector<glm::mat4> Matrices;
+            Matrices.reserve(Entities.size());
+            for (entt::entity Entity : Entities)
+            {
+                Matrices.push_back(World.GetRegistry().get<STransformComponent>(Entity).CachedMatrix);
+            }
+            return Matrices;
+        }
+    }
+
+    LUMINA_AUTOMATION_TEST("World.Transforms.LevelOrderMatchesRecursive")
+    {
+        constexpr uint32 NumNodes = 2'000;
+
+        FAutomationWorld World;
+        const TVector<entt::entity> Entities = BuildForest(World, NumNodes);
+
+        TScopedConsoleVariable<bool> LevelOrder("World.LevelOrderTransforms", false);
+        DirtyForest(World, Entities);
+        World.Tick(1.0 / 60.0);
+        const TVector<glm::mat4> Recursive = GatherMatrices(World, Entities);
+
+        LevelOrder.Set(true);
+        for (entt::entity Entity : Entities)
+        {
+            World.GetRegistry().get<STransformComponent>(Entity).CachedMatrix = glm::mat4(0.0f);
+        }
+        DirtyForest(World, Entities);
+        World.Tick(1.0 / 60.0);
+        const TVector<glm::mat4> Leveled = GatherMatrices(World, Entities);
+
+        TEST_CHECK(Recursive.size() == Leveled.size());
+
+        uint32 NumMismatched = 0;
+        for (size_t i = 0; i < Recursive.size() && i < Leveled.size(); ++i)
+        {
+            for (glm::length_t Column = 0; Column < 4; ++Column)
+            {
+                NumMismatched += !glm::all(glm::lessThan(glm::abs(Recursive[i][Column] - Leveled[i][Column]), glm::vec4(1e-3f)));
+            }
+        }
+        TEST_CHECK(NumMismatched == 0);
+
+        // The deepest node sits ForestDepth - 1 levels under its root, about one unit up per level.
+        TEST_CHECK(glm::abs(Leveled[(1u << (ForestDepth - 1)) - 1][3].y - static_cast<float>(ForestDepth)) < 0.5f);
+    }
+
+    // Per frame cost of the 100k node, 8 level forest with every node dirty, recursive against level order.
+    LUMINA_AUTOMATION_TEST("Benchmark.World.TransformForest100k")
+    {
+        constexpr uint32 NumNodes = 100'000;
+        constexpr uint32 NumFrames = 30;
+
+        FAutomationWorld World;
+        const TVector<entt::entity> Entities = BuildForest(World, NumNodes);
+
+        ForEachConsoleToggle("World.LevelOrderTransforms", [&](bool bLevelOrder)
+        {
+            double TotalMs = 0.0;
+            for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+            {
+                DirtyForest(World, Entities);
+
+                const auto Start = std::chrono::high_resolution_clock::now();
+                World.Tick(1.0 / 60.0);
+                const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+                TotalMs += Duration.count();
+            }
+
+            LOG_INFO("[{}] {} nodes, {} levels, {}: {:.3f} ms per frame", Test.GetName(), Entities.size(), ForestDepth, bLevelOrder ? "level order" : "recursive", TotalMs / NumFrames);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "AutomationWorld.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "World/Entity/EntityUtils.h"
+#include "World/Entity/Components/CharacterComponent.h"
+#include "World/Entity/Components/EditorComponent.h"
+#include "World/Entity/Components/NameComponent.h"
+#include "World/Entity/Components/RelationshipComponent.h"
+#include "World/Entity/Components/SingletonEntityComponent.h"
+#include "World/Entity/Components/TransformComponent.h"
+
+namespace Lumina::Automation
+{
+    namespace
+    {
+        entt::entity FindByName(FEntityRegistry& Registry, const FName& Name)
+        {
+            for (auto&& [Entity, NameComponent] : Registry.view<SNameComponent>().each())
+            {
+                if (NameComponent.Name == Name)
+                {
+                    return Entity;
+                }
+            }
+            return entt::null;
+        }
+
+        FName GetName(FEntityRegistry& Registry, entt::entity Entity)
+        {
+            const SNameComponent* NameComponent = Registry.valid(Entity) ? Registry.try_get<SNameComponent>(Entity) : nullptr;
+            return NameComponent ? NameComponent->Name : NAME_None;
+        }
+
+        size_t CountEntities(FEntityRegistry& Registry)
+        {
+            size_t Count = 0;
+            for ([[maybe_unused]] entt::entity Entity : Registry.view<entt::entity>())
+            {
+                ++Count;
+            }
+            return Count;
+        }
+
+        TVector<FName> GetChildNames(FEntityRegistry& Registry, entt::entity Parent)
+        {
+            TVector<FName> Names;
+            ECS::Utils::ForEachChild(Registry, Parent, [&](entt::entity Child)
+            {
+                Names.push_back(GetName(Registry, Child));
+            });
+            return Names;
+        }
+    }
+
+    // Children and siblings have to point at the copies of their relatives, even when the copies got different identifiers.
+    LUMINA_AUTOMATION_TEST("World.Duplicate.RemapsHierarchy")
+    {
+        FAutomationWorld Source(EWorldType::Editor);
+        FEntityRegistry& SourceRegistry = Source.GetRegistry();
+
+        entt::entity Root = Source->ConstructEntity(FName("Root"));
+        entt::entity ChildA = Source->ConstructEntity(FName("ChildA"));
+        entt::entity ChildB = Source->ConstructEntity(FName("ChildB"));
+        entt::entity Grandchild = Source->ConstructEntity(FName("Grandchild"));
+        ECS::Utils::ReparentEntity(SourceRegistry, ChildA, Root);
+        ECS::Utils::ReparentEntity(SourceRegistry, ChildB, Root);
+        ECS::Utils::ReparentEntity(SourceRegistry, Grandchild, ChildA);
+
+        // Taking the source identifiers first forces every copy onto a new one.
+        FEntityRegistry Destination;
+        for (entt::entity Entity : SourceRegistry.view<entt::entity>())
+        {
+            Destination.create(Entity);
+        }
+        const size_t NumOccupied = CountEntities(Destination);
+
+        TEST_CHECK(ECS::Utils::CloneRegistry(SourceRegistry, Destination));
+
+        entt::entity NewRoot = FindByName(Destination, FName("Root"));
+        entt::entity NewChildA = FindByName(Destination, FName("ChildA"));
+        entt::entity NewGrandchild = FindByName(Destination, FName("Grandchild"));
+        TEST_CHECK(NewRoot != entt::null && NewRoot != Root);
+        TEST_CHECK(NewChildA != entt::null && NewChildA != ChildA);
+        TEST_CHECK(NewGrandchild != entt::null && NewGrandchild != Grandchild);
+        if (NewRoot == entt::null || NewChildA == entt::null || NewGrandchild == entt::null)
+        {
+            return;
+        }
+
+        TEST_CHECK(GetChildNames(Destination, NewRoot) == GetChildNames(SourceRegistry, Root));
+        TEST_CHECK(GetChildNames(Destination, NewRoot).size() == 2);
+        TEST_CHECK(GetName(Destination, Destination.get<FRelationshipComponent>(NewChildA).Parent) == FName("Root"));
+        TEST_CHECK(GetName(Destination, Destination.get<FRelationshipComponent>(NewGrandchild).Parent) == FName("ChildA"));
+        TEST_CHECK(Destination.get<FRelationshipComponent>(NewRoot).Parent == entt::null);
+
+        // Nothing in the copy may still point at the occupied source identifiers.
+        uint32 NumStale = 0;
+        Destination.view<FRelationshipComponent>().each([&](const FRelationshipComponent& Relationship)
+        {
+            for (entt::entity Linked : { Relationship.First, Relationship.Prev, Relationship.Next, Relationship.Parent })
+            {
+                NumStale += Linked != entt::null && !Destination.all_of<SNameComponent>(Linked);
+            }
+        });
+        TEST_CHECK(NumStale == 0);
+        TEST_CHECK(CountEntities(Destination) == NumOccupied + 4);
+    }
+
+    LUMINA_AUTOMATION_TEST("World.Duplicate.SkipsEditorAndSingletonEntities")
+    {
+        FAutomationWorld Source(EWorldType::Editor);
+        FEntityRegistry& SourceRegistry = Source.GetRegistry();
+
+        Source->ConstructEntity(FName("Gameplay"));
+        entt::entity EditorOnly = Source->ConstructEntity(FName("EditorOnly"));
+        SourceRegistry.emplace<FEditorComponent>(EditorOnly);
+
+        TEST_CHECK(!SourceRegistry.view<FSingletonEntityTag>().empty());
+
+        FEntityRegistry Destination;
+        TEST_CHECK(ECS::Utils::CloneRegistry(SourceRegistry, Destination));
+
+        TEST_CHECK(FindByName(Destination, FName("Gameplay")) != entt::null);
+        TEST_CHECK(FindByName(Destination, FName("EditorOnly")) == entt::null);
+        TEST_CHECK(Destination.view<FEditorComponent>().empty());
+        TEST_CHECK(Destination.view<FSingletonEntityTag>().empty());
+        TEST_CHECK(CountEntities(Destination) == 1);
+    }
+
+    // Components marked NonCloneable hold runtime state, only their properties are copied through serialization.
+    LUMINA_AUTOMATION_TEST("World.Duplicate.NonCloneableFallsBackToSerialization")
+    {
+        FAutomationWorld Source(EWorldType::Editor);
+        FEntityRegistry& SourceRegistry = Source.GetRegistry();
+
+        entt::entity Character = Source->ConstructEntity(FName("Character"));
+        SCharacterPhysicsComponent& CharacterComponent = SourceRegistry.emplace<SCharacterPhysicsComponent>(Character);
+        CharacterComponent.HalfHeight = 2.5f;
+        CharacterComponent.Mass = 90.0f;
+
+        FEntityRegistry Destination;
+        TEST_CHECK(ECS::Utils::CloneRegistry(SourceRegistry, Destination));
+
+        entt::entity NewCharacter = FindByName(Destination, FName("Character"));
+        const SCharacterPhysicsComponent* NewComponent = NewCharacter != entt::null ? Destination.try_get<SCharacterPhysicsComponent>(NewCharacter) : nullptr;
+        TEST_CHECK(NewComponent != nullptr);
+        if (NewComponent == nullptr)
+        {
+            return;
+        }
+
+        TEST_CHECK(NewComponent->HalfHeight == 2.5f);
+        TEST_CHECK(NewComponent->Mass == 90.0f);
+        TEST_CHECK(NewComponent->Character == nullptr);
+    }
+
+    // Play in editor start latency, cloned storages against the serialization round trip it replaced.
+    LUMINA_AUTOMATION_TEST("Benchmark.World.PlayInEditorStart")
+    {
+        constexpr uint32 NumEntities = 10'000;
+        constexpr uint32 NumRuns = 3;
+
+        FAutomationWorld Source(EWorldType::Editor);
+        for (uint32 i = 0; i < NumEntities; ++i)
+        {
+            const glm::vec3 Location(static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f);
+            Source->ConstructEntity(FName("Entity"), FTransform(Location));
+        }
+
+        const uint32 NumSourceTransforms = static_cast<uint32>(Source.GetRegistry().view<STransformComponent>().size());
+
+        // Serializing the world is the old path, cloning the storages the new one.
+        ForEachConsoleToggle("World.DuplicateBySerialization", [&](bool bSerialize)
+        {
+            double TotalMs = 0.0;
+            for (uint32 Run = 0; Run < NumRuns; ++Run)
+            {
+                const auto Start = std::chrono::high_resolution_clock::now();
+
+                FAutomationWorld Duplicate(EWorldType::Game, CWorld::DuplicateWorld(Source.Get()));
+                Duplicate->SimulateWorld();
+
+                const std::chrono::duration<double, std::milli> Duration = std::chrono::high_resolution_clock::now() - Start;
+                TotalMs += Duration.count();
+
+                TEST_CHECK(Duplicate.GetRegistry().view<STransformComponent>().size() == NumSourceTransforms);
+
+                Duplicate->StopSimulation();
+            }
+
+            LOG_INFO("[{}] {} entities, {}: {:.3f} ms per start", Test.GetName(), NumEntities, bSerialize ? "serialized" : "cloned", TotalMs / NumRuns);
+        }, true);
+    }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "World.h"
 #include "WorldManager.h"
+#include "Core/Console/ConsoleVariable.h"
 #include "Core/Delegates/CoreDelegates.h"
 #include "Core/Engine/Engine.h"
 #include "Core/Object/Class.h"
@@ -28,6 +29,9 @@
 
 namespace Lumina
 {
+    static TConsoleVar CVarParallelSystems("World.ParallelSystems", true, "Runs non-conflicting entity systems of an update stage concurrently.");
+    static TConsoleVar CVarDuplicateBySerialization("World.DuplicateBySerialization", false, "Duplicates worlds for play in editor through a full serialization round trip instead of cloning component storages, for comparing the two.");
+    
     CWorld::CWorld()
         : SingletonEntity(entt::null)
         , SystemContext(this)
@@ -246,11 +250,47 @@ namespace Lumina
             };
 
             eastl::sort(SystemUpdateList[i].begin(), SystemUpdateList[i].end(), Predicate);
+            BuildSystemSchedule((EUpdateStage)i);
         }
 
+        const FSystemAccess& Access = eastl::visit([&](const auto& System) -> const FSystemAccess& { return System.GetSystemAccess(); }, NewSystem);
+        Access.AssureStorages(EntityRegistry);
+
         return true;
     }
 
+    void CWorld::BuildSystemSchedule(EUpdateStage Stage)
+    {
+        const TVector<FSystemVariant>& Systems = SystemUpdateList[(uint32)Stage];
+        TVector<TVector<uint32>>& Schedule = SystemSchedule[(uint32)Stage];
+        Schedule.clear();
+
+        // Each system depends on every earlier system it conflicts with, so it lands one wave after the latest of them.
+        TVector<uint32> WaveOf(Systems.size(), 0);
+        for (uint32 i = 0; i < Systems.size(); ++i)
+        {
+            const FSystemAccess& Access = eastl::visit([&](const auto& System) -> const FSystemAccess& { return System.GetSystemAccess(); }, Systems[i]);
+            
+            uint32 Wave = 0;
+            for (uint32 j = 0; j < i; ++j)
+            {
+                const FSystemAccess& Other = eastl::visit([&](const auto& System) -> const FSystemAccess& { return System.GetSystemAccess(); }, Systems[j]);
+                if (Access.ConflictsWith(Other))
+                {
+                    Wave = eastl::max(Wave, WaveOf[j] + 1);
+                }
+            }
+
+            WaveOf[i] = Wave;
+            if (Wave >= Schedule.size())
+            {
+                Schedule.resize(Wave + 1);
+            }
+            
+            Schedule[Wave].push_back(i);
+        }
+    }
+
     entt::entity CWorld::ConstructEntity(const FName& Name, const FTransform& Transform)
     {
         entt::entity NewEntity = GetEntityRegistry().create();
@@ -378,25 +418,41 @@ namespace Lumina
     CWorld* CWorld::DuplicateWorld(CWorld* OwningWorld)
     {
         CPackage* OuterPackage = OwningWorld->GetPackage();
-        if (OuterPackage == nullptr)
+        if (OuterPackage == nullptr && !OwningWorld->HasAnyFlag(OF_Transient))
         {
             return nullptr;
         }
 
-        TVector<uint8> Data;
-        FMemoryWriter Writer(Data);
-        FObjectProxyArchiver WriterProxy(Writer, true);
-        OwningWorld->Serialize(WriterProxy);
-        
-        FMemoryReader Reader(Data);
-        FObjectProxyArchiver ReaderProxy(Reader, true);
+        auto Start = std::chrono::high_resolution_clock::now();
         
         CWorld* PIEWorld = NewObject<CWorld>(OF_Transient);
         
+        const bool bSerialize = CVarDuplicateBySerialization.GetValue();
         PIEWorld->PreLoad();
-        PIEWorld->Serialize(ReaderProxy);
+        if (bSerialize)
+        {
+            TVector<uint8> Data;
+            FMemoryWriter Writer(Data);
+            FObjectProxyArchiver WriterProxy(Writer, true);
+            OwningWorld->Serialize(WriterProxy);
+        
+            FMemoryReader Reader(Data);
+            FObjectProxyArchiver ReaderProxy(Reader, true);
+            PIEWorld->Serialize(ReaderProxy);
+        }
+        else
+        {
+            // Components are copied storage by storage, only types marked NonCloneable take the serialization route.
+            ECS::Utils::CloneRegistry(OwningWorld->EntityRegistry, PIEWorld->RegistryPending);
+        }
         PIEWorld->PostLoad();
         
+        auto End = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> DurationMs = End - Start;
+        
+        LOG_INFO("Duplicated World: \"{}\" - ( [{}] Entities | [{:.3f}] ms | {})", OuterPackage ? OuterPackage->GetName() : OwningWorld->GetName(),
+            PIEWorld->RegistryPending.view<entt::entity>().size(), DurationMs.count(), bSerialize ? "Serialized" : "Cloned");
+        
         return PIEWorld;
     }
 
@@ -485,6 +541,7 @@ namespace Lumina
         for (int i = 0; i < (int)EUpdateStage::Max; ++i)
         {
             SystemUpdateList[i].clear();
+            SystemSchedule[i].clear();
         }
         
         for (auto&& [_, Meta] : entt::resolve())
@@ -513,6 +570,21 @@ namespace Lumina
         //    FSystemVariant Variant = Move(ScriptSystem);
         //    RegisterSystem(Variant);
         //});
+
+        for (uint32 Stage = 0; Stage < (uint32)EUpdateStage::Max; ++Stage)
+        {
+            for (uint32 Wave = 0; Wave < SystemSchedule[Stage].size(); ++Wave)
+            {
+                FFixedString Names;
+                for (uint32 Index : SystemSchedule[Stage][Wave])
+                {
+                    const char* Name = eastl::visit([&](const auto& System) { return System.GetName(); }, SystemUpdateList[Stage][Index]);
+                    Names.append(Names.empty() ? "" : ", ").append(Name);
+                }
+            
+                LOG_DEBUG("System Schedule [{}] Wave {}: {}", GUpdateStageNames[Stage], Wave, Names.c_str());
+            }
+        }
     }
 
     void CWorld::DrawBillboard(FRHIImage* Image, const glm::vec3& Location, float Scale)
@@ -588,6 +660,50 @@ namespace Lumina
         
     }
 
+    void CWorld::CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        if (PhysicsScene == nullptr)
+        {
+            for (size_t i = 0; i < Rays.size(); ++i)
+            {
+                Results[i] = FRayResult{ .Start = Rays[i].Start, .End = Rays[i].End, .Location = Rays[i].End, .Fraction = 1.0f };
+            }
+            return;
+        }
+        
+        PhysicsScene->CastRays(Rays, Results);
+    }
+
+    void CWorld::CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        if (PhysicsScene == nullptr)
+        {
+            Hits.clear();
+            eastl::fill(Ranges.begin(), Ranges.end(), FQueryHitRange{});
+            return;
+        }
+        
+        PhysicsScene->CastSpheres(Sweeps, Hits, Ranges);
+    }
+
+    void CWorld::OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges)
+    {
+        LUMINA_PROFILE_SCOPE();
+
+        if (PhysicsScene == nullptr)
+        {
+            Hits.clear();
+            eastl::fill(Ranges.begin(), Ranges.end(), FQueryHitRange{});
+            return;
+        }
+        
+        PhysicsScene->OverlapSpheres(Overlaps, Hits, Ranges);
+    }
+
     entt::entity CWorld::GetEntityByTag(const FName& Tag)
     {
         auto& Storage = EntityRegistry.storage<STagComponent>(entt::hashed_string(Tag.c_str()));
@@ -659,10 +775,37 @@ namespace Lumina
 
     void CWorld::TickSystems(FSystemContext& Context)
     {
-        auto& SystemVector = SystemUpdateList[(uint32)Context.GetUpdateStage()];
-        for(FSystemVariant& SystemVariant : SystemVector)
+        const uint32 StageIndex = (uint32)Context.GetUpdateStage();
+        auto& SystemVector = SystemUpdateList[StageIndex];
+        
+        if (!CVarParallelSystems.GetValue())
+        {
+            for(FSystemVariant& SystemVariant : SystemVector)
+            {
+                eastl::visit([&](auto& System) { System.Update(Context); }, SystemVariant);
+            }
+            
+            return;
+        }
+        
+        for (const TVector<uint32>& Wave : SystemSchedule[StageIndex])
         {
-            eastl::visit([&](auto& System) { System.Update(Context); }, SystemVariant);
+            if (Wave.size() == 1)
+            {
+                eastl::visit([&](auto& System) { System.Update(Context); }, SystemVector[Wave[0]]);
+                continue;
+            }
+            
+            LUMINA_PROFILE_SECTION("System Wave");
+            Task::ParallelFor(Wave.size(), [&](uint32 Index)
+            {
+                FSystemVariant& SystemVariant = SystemVector[Wave[Index]];
+                const char* Name = eastl::visit([&](const auto& System) { return System.GetName(); }, SystemVariant);
+                
+                LUMINA_PROFILE_SECTION("Parallel System");
+                LUMINA_PROFILE_TAG(Name);
+                eastl::visit([&](auto& System) { System.Update(Context); }, SystemVariant);
+            }, 1);
         }
     }
 
@@ -119,6 +119,11 @@ namespace Lumina
         TOptional<FRayResult> CastRay(const FRayCastSettings& Settings);
         TOptional<FRayResult> CastRay(const glm::vec3& Start, const glm::vec3& End, bool bDrawDebug = false, float DebugDuration = 0.0f, uint32 LayerMask = 0xFFFFFFFF, int64 IgnoreBody = -1);
         TVector<FRayResult> CastSphere(const FSphereCastSettings& Settings);
+        
+        /** Batched queries, see IPhysicsScene. They skip debug drawing, which would serialize them again. */
+        void CastRays(TSpan<const FRayCastSettings> Rays, TSpan<FRayResult> Results);
+        void CastSpheres(TSpan<const FSphereCastSettings> Sweeps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges);
+        void OverlapSpheres(TSpan<const FSphereOverlapSettings> Overlaps, TVector<FRayResult>& Hits, TSpan<FQueryHitRange> Ranges);
 
         FORCEINLINE bool IsGameWorld() const { return WorldType == EWorldType::Game; }
 
@@ -139,6 +144,7 @@ namespace Lumina
     private:
         
         bool RegisterSystem(const FSystemVariant& NewSystem);
+        void BuildSystemSchedule(EUpdateStage Stage);
         void TickSystems(FSystemContext& Context);
         FLineBatcherComponent& GetOrCreateLineBatcher();
     
@@ -157,6 +163,9 @@ namespace Lumina
         
         TVector<FSystemVariant>                             SystemUpdateList[(int32)EUpdateStage::Max];
         
+        /** Per stage, waves of indices into SystemUpdateList. Systems within a wave don't conflict and run concurrently. */
+        TVector<TVector<uint32>>                            SystemSchedule[(int32)EUpdateStage::Max];
+        
         EWorldType                                          WorldType = EWorldType::None;
         
         int64                                               WorldIndex = -1;
@@ -0,0 +1,21 @@
+project "Zstd"
+	kind "StaticLib"
+	language "C"
+	warnings "off"
+
+	defines
+	{
+		"ZSTD_DISABLE_ASM",
+	}
+
+	files
+	{
+		"lib/**.h",
+		"lib/**.c",
+		"**.lua",
+	}
+
+	includedirs
+	{
+		"lib/",
+	}
@@ -107,7 +107,7 @@ workspace "Lumina"
         symbols "On"
         runtime "Debug"
         editandcontinue "On"
-        defines { "LE_DEBUG", "LUMINA_DEBUG", "_DEBUG", "DEBUG", }
+        defines { "LE_DEBUG", "LUMINA_DEBUG", "_DEBUG", "DEBUG", "WITH_AUTOMATION_TESTS=1", }
 
     filter "configurations:Development"
         targetsuffix "-Development"
@@ -115,14 +115,14 @@ workspace "Lumina"
         symbols "On"
         runtime "Release"
         linktimeoptimization "On"
-        defines { "NDEBUG", "LE_DEVELOPMENT", "LUMINA_DEVELOPMENT", }
+        defines { "NDEBUG", "LE_DEVELOPMENT", "LUMINA_DEVELOPMENT", "WITH_AUTOMATION_TESTS=1", }
 
     filter "configurations:Shipping"
         linktimeoptimization "On"
         optimize "Full"
         symbols "Off"
         runtime "Release"
-        defines { "NDEBUG", "LE_SHIPPING", "LUMINA_SHIPPING" }
+        defines { "NDEBUG", "LE_SHIPPING", "LUMINA_SHIPPING", "WITH_AUTOMATION_TESTS=0" }
         removedefines { "TRACY_ENABLE" }
     
     filter {}
@@ -164,6 +164,7 @@ workspace "Lumina"
         include "Engine/Source/ThirdParty/json"
         include "Engine/Source/ThirdParty/fastgltf"
         include "Engine/Source/ThirdParty/OpenFBX"
+        include "Engine/Source/ThirdParty/Zstd"
 	group ""
 
     group "Build"